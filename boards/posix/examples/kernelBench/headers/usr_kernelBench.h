@@ -0,0 +1,61 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : usr_kernelBench.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for timing the kernel primitives
+ *               on the POSIX host.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef usr_kernelBench_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define usr_kernelBench_h
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+   #include "arb_error.h"
+
+   /*------------------------------------------------------------------------*
+    * Global typedefs
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+   t_error usr_kernelBenchInit( void);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef usr_kernelBench_h*/
@@ -0,0 +1,100 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : usr_appInit.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for initializing the arbitros
+ *               scheduler, device drivers, and all user-space threads of the
+ *               host kernel benchmark.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "arb_scheduler.h"
+#include "arb_printf.h"
+#include "drv_console.h"
+#include "usr_kernelBench.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void usr_driverRegistration( void)
+{
+   t_consoleSetup t_conSetup;
+
+   /*------------------------------------------------------------------------*
+    * Register the console driver with the kernel, the POSIX HAL maps the
+    * uart onto stdin and stdout.
+    *------------------------------------------------------------------------*/
+   t_conSetup.c_uartId   = UART_1;
+   t_conSetup.i_baudRate = 115200;
+   t_conSetup.c_majorNum = 1;
+
+   if( drv_consoleInit( t_conSetup) < 0)
+      exit(0);
+
+}/*End usr_driverRegistration*/
+
+static void usr_platformInit( void)
+{
+
+   /*------------------------------------------------------------------------*
+    * Register drivers with the kernel here...
+    *------------------------------------------------------------------------*/
+   usr_driverRegistration();
+
+   /*------------------------------------------------------------------------*
+    * Initialize the debug interface, there is no card to log to. The
+    * interactive console is left out so it doesn't interleave its prompt
+    * with the results.
+    *------------------------------------------------------------------------*/
+   if( arb_printfInit( "consoleDevice0",
+                       512,
+                       NULL) < 0)
+   {
+      exit(0);
+   }
+
+   /*------------------------------------------------------------------------*
+    * Initialize the scheduler specifically for this application.
+    *------------------------------------------------------------------------*/
+   if( arb_schedulerInit( PRIORITY,
+                          ARB_STACK_512B,
+                          TIMER_7) < 0)
+   {
+      exit(0);
+   }
+
+}/*End usr_platformInit*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+void usr_appInit( void)
+{
+   usr_platformInit();
+
+   if( usr_kernelBenchInit() < 0)
+      exit(1);
+
+}/*End usr_appInit*/
@@ -0,0 +1,163 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : usr_kernelBench.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for running the standard kernel
+ *               benchmark suites (see arb_bench.h) and the math suites (see
+ *               utl_mathBench.h) on the host and writing the CSV report to
+ *               the console. The process exits once every suite has run.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include "arb_error.h"
+#include "arb_thread.h"
+#include "arb_device.h"
+#include "arb_bench.h"
+#include "utl_mathBench.h"
+#include "hal_pmic.h"
+#include "usr_kernelBench.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Highest priority given to the partner threads, the bench thread runs
+ * below all of them.
+ *---------------------------------------------------------------------------*/
+#define BENCH_PARTNER_PRIO (1)
+
+/*---------------------------------------------------------------------------*
+ * Private Typedefs
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   /*------------------------------------------------------------------------*
+    * Runs the suites and reports the results.
+    *------------------------------------------------------------------------*/
+   t_THRDHANDLE t_benchThread;
+
+   /*------------------------------------------------------------------------*
+    * Handle to the console driver the results are written to.
+    *------------------------------------------------------------------------*/
+   t_DEVHANDLE t_consoleHndl;
+
+}t_benchObjct;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void usr_kernelBench( t_parameters t_param,
+                             t_arguments t_args);
+static t_error usr_mathBench( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static t_benchObjct gt_benchObjct;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The utl_mathBench suites, reported under the header 'arb_benchRun' has
+ * already written.
+ *---------------------------------------------------------------------------*/
+static t_error usr_mathBench( void)
+{
+   char ac_line[UTL_BENCH_LINE_BYTES];
+   int16_t s_size;
+   uint8_t c_suite = 0;
+
+   while( (s_size = utl_mathBenchRun( c_suite,
+                                      ac_line,
+                                      sizeof( ac_line))) > 0)
+   {
+      arb_write( gt_benchObjct.t_consoleHndl,
+                 (int8_t *)ac_line,
+                 (uint16_t)s_size);
+      c_suite++;
+   }
+
+   if( s_size < 0)
+      return ARB_HAL_ERROR;
+
+   return ARB_PASSED;
+
+}/*End usr_mathBench*/
+
+static void usr_kernelBench( t_parameters t_param,
+                             t_arguments t_args)
+{
+   t_error t_err;
+
+   t_err = arb_benchRun( gt_benchObjct.t_consoleHndl);
+   if( t_err == ARB_PASSED)
+      t_err = usr_mathBench();
+
+   /*------------------------------------------------------------------------*
+    * Leave with interrupts off so nothing gets switched in while libc is
+    * tearing the process down.
+    *------------------------------------------------------------------------*/
+   HAL_CLI();
+   exit( (t_err == ARB_PASSED) ? 0 : 1);
+
+}/*End usr_kernelBench*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_error usr_kernelBenchInit( void)
+{
+   t_error t_err;
+
+   memset( (void *)&gt_benchObjct, 0, sizeof( t_benchObjct));
+
+   gt_benchObjct.t_consoleHndl = arb_open( "consoleDevice0",
+                                           ARB_O_READ |
+                                           ARB_O_WRITE);
+   if( gt_benchObjct.t_consoleHndl < 0)
+      return (t_error)gt_benchObjct.t_consoleHndl;
+
+   t_err = arb_benchInit( BENCH_PARTNER_PRIO);
+   if( t_err < 0)
+      return t_err;
+
+   if( utl_mathBenchInit() < 0)
+      return ARB_HAL_ERROR;
+
+   gt_benchObjct.t_benchThread = arb_threadCreate( usr_kernelBench,
+                                                   1,
+                                                   0,
+                                                   ARB_STACK_512B,
+                                                   BENCH_PARTNER_PRIO +
+                                                   ARB_BENCH_NUM_PARTNERS);
+   if( gt_benchObjct.t_benchThread < 0)
+      return (t_error)gt_benchObjct.t_benchThread;
+
+   return ARB_PASSED;
+
+}/*End usr_kernelBenchInit*/
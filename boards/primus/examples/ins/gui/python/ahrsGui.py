@@ -6,6 +6,7 @@ import numpy
 import serial
 import time
 import os
+import struct
 
 from PyQt4.Qwt5.anynumpy import *
 from PyQt4 import QtGui, QtCore
@@ -27,6 +28,45 @@ NAV_DCM_INIT      = 5
 NAV_ACTIVE        = 6
 NAV_ERROR         = 7
 
+#Binary telemetry, see usr_telemetry.h and utl_frame.h
+FRAME_DELIM         = 0x00
+FRAME_HDR_SIZE      = 3
+FRAME_CRC_SIZE      = 2
+TLM_MSG_STATE_EST   = 0x01
+TLM_MSG_DCM         = 0x02
+TLM_MSG_CAL_COLLECT = 0x03
+TLM_MSG_CAL_POINT   = 0x04
+TLM_MSG_CAL_RESULT  = 0x05
+
+#(version, struct format) for each message id
+tlmFormats = {TLM_MSG_STATE_EST   : (1, '<10fB'),
+              TLM_MSG_DCM         : (1, '<9h'),
+              TLM_MSG_CAL_COLLECT : (1, ''),
+              TLM_MSG_CAL_POINT   : (1, '<3fBB'),
+              TLM_MSG_CAL_RESULT  : (1, '<B15f')}
+
+def crc16( data, crc = 0xFFFF):
+    #CRC-16/CCITT (poly 0x1021), matches utl_crc16
+    for byte in data:
+        x = ((crc >> 8) ^ byte) & 0xFF
+        x ^= x >> 4
+        crc = ((crc << 8) ^ (x << 12) ^ (x << 5) ^ x) & 0xFFFF
+    return crc
+
+def cobsDecode( data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if( (code == 0) or (i + code - 1 > len(data))):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if( (code < 0xFF) and (i < len(data))):
+            out.append(0)
+    return out
+
 TEST_MAG_DATA = 0
 magTestData = [[ 0.27, -0.66,  0.91],
                [ 0.33, -0.85, -0.76],
@@ -156,9 +196,35 @@ class SerialReader(QtCore.QThread):
         self.signal = QtCore.SIGNAL("signal")
         
     def run(self):
+        #Frames and text share the link, frames are delimited by 0x00 and
+        #text never contains a 0x00. Anything between two delimiters that
+        #fails to decode is treated as text and the closing delimiter is taken
+        #as the start of the next frame, so the reader resyncs on its own.
+        inFrame = False
+        segment = bytearray()
+        self.dcm = numpy.eye(3)
         while( True):
-            buffer = self.serialPort.readline().decode("utf-8")
-            mess = buffer.split()
+            data = self.serialPort.read(max(1, self.serialPort.inWaiting()))
+            for byte in data:
+                if( byte == FRAME_DELIM):
+                    if( inFrame == True):
+                        if( self.handleFrame(segment) == True):
+                            inFrame = False
+                        else:
+                            self.handleText(segment)
+                    else:
+                        self.handleText(segment)
+                        inFrame = True
+                    segment = bytearray()
+                else:
+                    segment.append(byte)
+                    if( (inFrame == False) and (byte == ord('\n'))):
+                        self.handleText(segment)
+                        segment = bytearray()
+
+    def handleText(self, segment):
+        for line in segment.decode("utf-8", "ignore").splitlines():
+            mess = line.split()
             if( len(mess) > 1):           
                 if( mess[0] == '#csd'):
                     mess = mess[1:len(mess)]
@@ -166,7 +232,43 @@ class SerialReader(QtCore.QThread):
                 elif( mess[0] == '#calmsg'):
                     mess = mess[1:len(mess)]
                     self.emit(self.signal, mess)
-                    
+
+    def handleFrame(self, segment):
+        frame = cobsDecode(segment)
+        if( (frame == None) or (len(frame) < FRAME_HDR_SIZE + FRAME_CRC_SIZE)):
+            return False
+        crc = frame[-2] | (frame[-1] << 8)
+        if( crc16(frame[0:-2]) != crc):
+            return False
+        msgId   = frame[0]
+        version = frame[1]
+        payload = bytes(frame[FRAME_HDR_SIZE:-2])
+        if( (msgId not in tlmFormats) or (tlmFormats[msgId][0] != version)):
+            return True #Valid frame we don't understand, drop it
+        fmt = tlmFormats[msgId][1]
+        if( struct.calcsize(fmt) != len(payload)):
+            return True
+        fields = struct.unpack(fmt, payload) if fmt != '' else ()
+        
+        #Translate into the same messages the text protocol produces
+        if( msgId == TLM_MSG_STATE_EST):
+            self.emit(self.signal, list(fields))
+        elif( msgId == TLM_MSG_DCM):
+            self.dcm = numpy.array(fields).reshape(3, 3) / 32768.0
+        elif( msgId == TLM_MSG_CAL_COLLECT):
+            self.emit(self.signal, ['#collect'])
+        elif( msgId == TLM_MSG_CAL_POINT):
+            self.emit(self.signal, ['#cal3dpoint'] + list(fields))
+        elif( msgId == TLM_MSG_CAL_RESULT):
+            if( fields[0] != 0):
+                self.emit(self.signal, ['#calrotmatrix'] + list(fields[1:10]))
+                self.emit(self.signal, ['#axisscale'] + list(fields[10:13]))
+                self.emit(self.signal, ['#axisbias'] + list(fields[13:16]))
+                self.emit(self.signal, ['#result', 'passed'])
+            else:
+                self.emit(self.signal, ['#result', 'failed'])
+        return True
+
 class AHRSPlot(Qwt.QwtPlot):
 
     def __init__(self, *args, plotName, yName):
@@ -1623,6 +1725,9 @@ class ahrsMain(QtGui.QMainWindow):
             self.serialPort.flushInput() #flush input buffer, discarding all its contents
             self.serialPort.flushOutput() #flush output buffer, aborting current output          
             self.thread.start()
+            #Switch the console over to binary telemetry
+            byteMsg = bytes("stm 1\r", 'UTF-8')
+            self.serialPort.write(byteMsg)            
             #Make sure the device is in the idle state
             byteMsg = bytes("sas\r", 'UTF-8')
             self.serialPort.write(byteMsg)            
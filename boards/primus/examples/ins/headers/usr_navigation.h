@@ -99,6 +99,11 @@
     *------------------------------------------------------------------------*/
    void usr_navGetStateEst( t_currentMeas *pt_currentMeas);
 
+   /*------------------------------------------------------------------------*
+    * Returns the current 3x3 DCM (row major, Q15).
+    *------------------------------------------------------------------------*/
+   void usr_navGetDcm( int16_t *ps_dcm);
+
    /*------------------------------------------------------------------------*
     * Transitions the thread into one of 5 possible states as defined by
     * t_navState.
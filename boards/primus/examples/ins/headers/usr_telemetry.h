@@ -0,0 +1,111 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : usr_telemetry.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Binary telemetry messages exchanged with the AHRS GUI
+ *               (gui/python/ahrsGui.py). Each message is sent as a
+ *               utl_frame.h frame over the console UART and is identified
+ *               by a message id and a version number. The structs are
+ *               packed (-fpack-struct), little endian, and floats are IEEE
+ *               754 single precision. If a struct changes, bump its version
+ *               so the GUI can tell the layouts apart.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef usr_telemetry_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define usr_telemetry_h
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+      TLM_MSG_STATE_EST   = 0x01, /*t_tlmStateEst*/
+      TLM_MSG_DCM         = 0x02, /*t_tlmDcm*/
+      TLM_MSG_CAL_COLLECT = 0x03, /*No payload, ready for the next point*/
+      TLM_MSG_CAL_POINT   = 0x04, /*t_tlmCalPoint*/
+      TLM_MSG_CAL_RESULT  = 0x05  /*t_tlmCalResult*/
+   }t_tlmMsgId;
+
+   #define TLM_STATE_EST_VERSION   (1)
+   #define TLM_DCM_VERSION         (1)
+   #define TLM_CAL_COLLECT_VERSION (1)
+   #define TLM_CAL_POINT_VERSION   (1)
+   #define TLM_CAL_RESULT_VERSION  (1)
+
+   typedef struct
+   {
+      float f_corrRoll;        /*Degrees*/
+      float f_rawRoll;
+      float f_corrPitch;
+      float f_rawPitch;
+      float f_corrYaw;
+      float f_rawYaw;
+      float f_platMovingCount;
+      float af_avrResMag[3];   /*Average Kalman residual, degrees*/
+      uint8_t c_navState;      /*t_navState*/
+   }t_tlmStateEst;
+
+   typedef struct
+   {
+      int16_t as_dcm[9];       /*Row major, Q15*/
+   }t_tlmDcm;
+
+   typedef struct
+   {
+      float af_point[3];       /*Normalized to the calibration envelope*/
+      uint8_t c_index;
+      uint8_t c_numPoints;
+   }t_tlmCalPoint;
+
+   typedef struct
+   {
+      uint8_t c_passed;
+      float af_R[9];           /*Principle axis rotation, row major*/
+      float af_scale[3];
+      float af_bias[3];
+   }t_tlmCalResult;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef usr_telemetry_h*/
@@ -40,9 +40,13 @@
 #include "arb_device.h"
 #include "arb_sysTimer.h"
 #include "drv_console.h"
+#include "arb_console.h"
+#include "usr_console.h"
 #include "usr_navigation.h"
+#include "usr_telemetry.h"
 #include "arb_printf.h"
 #include "drv_ins.h"
+#include "utl_frame.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
@@ -55,301 +59,524 @@
 /*---------------------------------------------------------------------------*
  * Private Function Prototypes
  *---------------------------------------------------------------------------*/
+static void usr_sendTelemetry( t_DEVHANDLE t_consoleHndl,
+                               uint8_t c_msgId,
+                               uint8_t c_version,
+                               const void *pv_msg,
+                               uint16_t s_size,
+                               int8_t *pc_buff);
+
+static void usr_sendCalCollect( t_DEVHANDLE t_consoleHndl,
+                                int8_t *pc_buff);
+
+static void usr_sendCalPoint( t_DEVHANDLE t_consoleHndl,
+                              t_tlmCalPoint *pt_point,
+                              int8_t *pc_buff);
+
+static void usr_sendCalResult( t_DEVHANDLE t_consoleHndl,
+                               t_tlmCalResult *pt_result,
+                               int8_t *pc_buff);
+
 static void usr_sensorCal( t_DEVHANDLE t_consoleHndl,
                            t_navState t_calState,
                            int8_t *pc_buff);
 
+static bool usr_setActiveState( t_DEVHANDLE t_consoleHndl,
+                               int8_t *pc_buff,
+                               t_consoleTokHndl *pt_tokHndl);
+
+static bool usr_setIdleState( t_DEVHANDLE t_consoleHndl,
+                             int8_t *pc_buff,
+                             t_consoleTokHndl *pt_tokHndl);
+
+static bool usr_setDcmInit( t_DEVHANDLE t_consoleHndl,
+                            int8_t *pc_buff,
+                            t_consoleTokHndl *pt_tokHndl);
+
+static bool usr_magCal( t_DEVHANDLE t_consoleHndl,
+                        int8_t *pc_buff,
+                        t_consoleTokHndl *pt_tokHndl);
+
+static bool usr_accelCal( t_DEVHANDLE t_consoleHndl,
+                          int8_t *pc_buff,
+                          t_consoleTokHndl *pt_tokHndl);
+
+static bool usr_getStateData( t_DEVHANDLE t_consoleHndl,
+                              int8_t *pc_buff,
+                              t_consoleTokHndl *pt_tokHndl);
+
+static bool usr_setTelemetryMode( t_DEVHANDLE t_consoleHndl,
+                                  int8_t *pc_buff,
+                                  t_consoleTokHndl *pt_tokHndl);
+
 /*---------------------------------------------------------------------------*
  * Private Global Variables
  *---------------------------------------------------------------------------*/
 
+/*---------------------------------------------------------------------------*
+ * If true, state and calibration data is sent as binary frames (see
+ * usr_telemetry.h), otherwise as text.
+ *---------------------------------------------------------------------------*/
+static bool gb_binaryTlm = false;
+
+/*---------------------------------------------------------------------------*
+ * Sequence number of the next telemetry frame.
+ *---------------------------------------------------------------------------*/
+static uint8_t gc_tlmSeq = 0;
+
 /*---------------------------------------------------------------------------*
  * Private Function Definitions
  *---------------------------------------------------------------------------*/
-static void usr_sensorCal( t_DEVHANDLE t_consoleHndl,
-                           t_navState t_calState,
-                           int8_t *pc_buff)
+static void usr_sendTelemetry( t_DEVHANDLE t_consoleHndl,
+                               uint8_t c_msgId,
+                               uint8_t c_version,
+                               const void *pv_msg,
+                               uint16_t s_size,
+                               int8_t *pc_buff)
 {
-   int16_t as_xyz[3];
-   uint16_t s_size;
-   int8_t c_index = 0;
-   float af_R[3][3];
-   float af_scale[3];
-   float af_bias[3];
+   int16_t s_frameSize;
 
    /*------------------------------------------------------------------------*
-    * Make sure the navigation thread is in the IDLE state.
+    * The whole frame is sent with a single write so that it can't be split
+    * by text written to the console from another thread.
     *------------------------------------------------------------------------*/
-   while( usr_navGetState() != NAV_IDLE)
+   s_frameSize = utl_frameEncode( c_msgId,
+                                  c_version,
+                                  gc_tlmSeq,
+                                  pv_msg,
+                                  s_size,
+                                  (uint8_t *)pc_buff,
+                                  MAX_CONSOLE_BUFF_SIZE);
+
+   if( s_frameSize > 0)
    {
-      usr_navSetState( NAV_IDLE);
-      arb_sleep( ARB_TICKS_PER_SECOND >> 1); /*.5sec update rate*/
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 (uint16_t)s_frameSize);
+
+      gc_tlmSeq++;
+   }
+
+}/*End usr_sendTelemetry*/
+
+static void usr_sendCalCollect( t_DEVHANDLE t_consoleHndl,
+                                int8_t *pc_buff)
+{
+   uint16_t s_size;
+
+   if( gb_binaryTlm == true)
+   {
+      usr_sendTelemetry( t_consoleHndl,
+                         TLM_MSG_CAL_COLLECT,
+                         TLM_CAL_COLLECT_VERSION,
+                         NULL,
+                         0,
+                         pc_buff);
+   }
+   else
+   {
+      s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #collect Rotate device to a new location, press enter when ready\r\n"));
+
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 s_size);
+   }
+
+}/*End usr_sendCalCollect*/
+
+static void usr_sendCalPoint( t_DEVHANDLE t_consoleHndl,
+                              t_tlmCalPoint *pt_point,
+                              int8_t *pc_buff)
+{
+   uint16_t s_size;
+
+   if( gb_binaryTlm == true)
+   {
+      usr_sendTelemetry( t_consoleHndl,
+                         TLM_MSG_CAL_POINT,
+                         TLM_CAL_POINT_VERSION,
+                         pt_point,
+                         sizeof( t_tlmCalPoint),
+                         pc_buff);
+   }
+   else
+   {
+      s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #cal3dpoint %f %f %f %f %f\r\n"),
+                          pt_point->af_point[0],
+                          pt_point->af_point[1],
+                          pt_point->af_point[2],
+                          (float)pt_point->c_index,
+                          (float)pt_point->c_numPoints);
+
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 s_size);
    }
 
-   switch( t_calState)
+}/*End usr_sendCalPoint*/
+
+static void usr_sendCalResult( t_DEVHANDLE t_consoleHndl,
+                               t_tlmCalResult *pt_result,
+                               int8_t *pc_buff)
+{
+   uint16_t s_size;
+   float *pf_R = pt_result->af_R;
+
+   if( gb_binaryTlm == true)
+   {
+      usr_sendTelemetry( t_consoleHndl,
+                         TLM_MSG_CAL_RESULT,
+                         TLM_CAL_RESULT_VERSION,
+                         pt_result,
+                         sizeof( t_tlmCalResult),
+                         pc_buff);
+   }
+   else if( pt_result->c_passed)
    {
-      case NAV_MAG_CAL:
-
-         do
-      	{
-
-            s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #collect Rotate device to a new location, press enter when ready\r\n"));
-
-            arb_write( t_consoleHndl,
-                       pc_buff,
-                       s_size);
-
-            /*---------------------------------------------------------------*
-             * Wait here until enter has been pressed...
-             *---------------------------------------------------------------*/
-            s_size = arb_read( t_consoleHndl,
-                               pc_buff,
-                               (int16_t)sizeof(pc_buff));
-
-            /*---------------------------------------------------------------*
-             * Does the user want to cancel the calibration?
-             *---------------------------------------------------------------*/
-            if( pc_buff[0] == 'q')
-            {
-               usr_navSetState( NAV_IDLE);
-               break;
-            }/*End if( pc_buff[0] == 'q')*/
+      s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #calrotmatrix %.4f %.4f %.4f %.4f %.4f %.4f %.4f %.4f %.4f\r\n"),
+      pf_R[0], pf_R[1], pf_R[2], pf_R[3], pf_R[4], pf_R[5], pf_R[6], pf_R[7], pf_R[8]);
+
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 s_size);
 
-            /*---------------------------------------------------------------*
-             * Tell the INS driver to acquire the first measurement...
-             *---------------------------------------------------------------*/
-            usr_navSetState( NAV_MAG_CAL);
+      arb_sleep( 10);
+
+      s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #axisscale %.4f %.4f %.4f\r\n"),
+      pt_result->af_scale[0], pt_result->af_scale[1], pt_result->af_scale[2]);
+
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 s_size);
 
-            /*---------------------------------------------------------------*
-             * Wait until a new sample is acquired...
-             *---------------------------------------------------------------*/
-            usr_navWaitCalSample();
+      arb_sleep( 10);
 
-            /*---------------------------------------------------------------*
-             * Read back the sample that was just gathered.
-             *---------------------------------------------------------------*/
-            usr_navGetCalSample( as_xyz);
+      s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #axisbias %.4f %.4f %.4f\r\n"),
+      pt_result->af_bias[0], pt_result->af_bias[1], pt_result->af_bias[2]);
 
-            s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #cal3dpoint %f %f %f %f %f\r\n"),
-                                (float)as_xyz[0]/INS_MAX_CAL_MAG_ENV,
-                                (float)as_xyz[1]/INS_MAX_CAL_MAG_ENV,
-                                (float)as_xyz[2]/INS_MAX_CAL_MAG_ENV,
-                                (float)c_index,
-                                (float)INS_MAX_CAL_SAMPLES);
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 s_size);
 
-            arb_write( t_consoleHndl,
-                       pc_buff,
-                       s_size);
+      arb_sleep( 10);
 
-            arb_sleep( 10);
+      s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #result passed\r\n"));
 
-            c_index++;
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 s_size);
+   }
+   else
+   {
+      s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #result failed\r\n"));
 
-         }while( usr_navGetState() == NAV_CAL_SAMP_COMP);
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 s_size);
+   }
 
-      break;/*End case NAV_MAG_CAL:*/
+}/*End usr_sendCalResult*/
 
-      case NAV_ACCEL_CAL:
+static void usr_sensorCal( t_DEVHANDLE t_consoleHndl,
+                           t_navState t_calState,
+                           int8_t *pc_buff)
+{
+   int16_t as_xyz[3];
+   float f_env;
+   t_tlmCalPoint t_point;
+   t_tlmCalResult t_result;
 
-         do
-      	{
+   if( (t_calState != NAV_MAG_CAL) && (t_calState != NAV_ACCEL_CAL))
+      return;
 
-            s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #collect Rotate device to a new location, press enter when ready\r\n"));
+   if( t_calState == NAV_MAG_CAL)
+      f_env = (float)INS_MAX_CAL_MAG_ENV;
+   else
+      f_env = (float)INS_MAX_CAL_GRAV_ENV;
 
-            arb_write( t_consoleHndl,
-                       pc_buff,
-                       s_size);
+   /*------------------------------------------------------------------------*
+    * Make sure the navigation thread is in the IDLE state.
+    *------------------------------------------------------------------------*/
+   while( usr_navGetState() != NAV_IDLE)
+   {
+      usr_navSetState( NAV_IDLE);
+      arb_sleep( ARB_TICKS_PER_SECOND >> 1); /*.5sec update rate*/
+   }
 
-            /*---------------------------------------------------------------*
-             * Wait here until enter has been pressed...
-             *---------------------------------------------------------------*/
-            s_size = arb_read( t_consoleHndl,
-                               pc_buff,
-                               (int16_t)sizeof(pc_buff));
+   t_point.c_index     = 0;
+   t_point.c_numPoints = INS_MAX_CAL_SAMPLES;
 
-            /*---------------------------------------------------------------*
-             * Does the user want to cancel the calibration?
-             *---------------------------------------------------------------*/
-            if( pc_buff[0] == 'q')
-            {
-               usr_navSetState( NAV_IDLE);
-               break;
-            }/*End if( pc_buff[0] == 'q')*/
+   do
+   {
 
-            /*---------------------------------------------------------------*
-             * Tell the INS driver to acquire the first measurement...
-             *---------------------------------------------------------------*/
-            usr_navSetState( NAV_ACCEL_CAL);
+      usr_sendCalCollect( t_consoleHndl,
+                          pc_buff);
 
-            /*---------------------------------------------------------------*
-             * Wait until a new sample is acquired...
-             *---------------------------------------------------------------*/
-            usr_navWaitCalSample();
+      /*---------------------------------------------------------------------*
+       * Wait here until enter has been pressed...
+       *---------------------------------------------------------------------*/
+      arb_read( t_consoleHndl,
+                pc_buff,
+                MAX_CONSOLE_BUFF_SIZE);
 
-            /*---------------------------------------------------------------*
-             * Read back the sample that was just gathered.
-             *---------------------------------------------------------------*/
-            usr_navGetCalSample( as_xyz);
+      /*---------------------------------------------------------------------*
+       * Does the user want to cancel the calibration?
+       *---------------------------------------------------------------------*/
+      if( pc_buff[0] == 'q')
+      {
+         usr_navSetState( NAV_IDLE);
+         break;
+      }/*End if( pc_buff[0] == 'q')*/
 
-            s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #cal3dpoint %f %f %f %f %f\r\n"),
-                                (float)as_xyz[0]/INS_MAX_CAL_GRAV_ENV,
-                                (float)as_xyz[1]/INS_MAX_CAL_GRAV_ENV,
-                                (float)as_xyz[2]/INS_MAX_CAL_GRAV_ENV,
-                                (float)c_index,
-                                (float)INS_MAX_CAL_SAMPLES);
+      /*---------------------------------------------------------------------*
+       * Tell the INS driver to acquire the next measurement...
+       *---------------------------------------------------------------------*/
+      usr_navSetState( t_calState);
 
-            arb_write( t_consoleHndl,
-                       pc_buff,
-                       s_size);
+      /*---------------------------------------------------------------------*
+       * Wait until a new sample is acquired...
+       *---------------------------------------------------------------------*/
+      usr_navWaitCalSample();
 
-            arb_sleep( 10);
+      /*---------------------------------------------------------------------*
+       * Read back the sample that was just gathered.
+       *---------------------------------------------------------------------*/
+      usr_navGetCalSample( as_xyz);
 
-            c_index++;
+      t_point.af_point[0] = (float)as_xyz[0] / f_env;
+      t_point.af_point[1] = (float)as_xyz[1] / f_env;
+      t_point.af_point[2] = (float)as_xyz[2] / f_env;
 
-         }while( usr_navGetState() == NAV_CAL_SAMP_COMP);
+      usr_sendCalPoint( t_consoleHndl,
+                        &t_point,
+                        pc_buff);
 
-      break;/*End case NAV_ACCEL_CAL:*/
+      arb_sleep( 10);
 
-      default:
+      t_point.c_index++;
 
-      break;
+   }while( usr_navGetState() == NAV_CAL_SAMP_COMP);
 
-   }/*End switch( t_calState)*/
+   memset( (void *)&t_result, 0, sizeof( t_result));
 
-	if( usr_navGetCalStatus() == INS_CAL_COMPLETE)
-	{
+   if( usr_navGetCalStatus() == INS_CAL_COMPLETE)
+   {
+      /*---------------------------------------------------------------------*
+       * Get the current calibration parameters...
+       *---------------------------------------------------------------------*/
       if( t_calState == NAV_MAG_CAL)
       {
-         /*------------------------------------------------------------------*
-          * Get the current calibration parameters...
-          *------------------------------------------------------------------*/
-         usr_navGetMagCal( &af_R[0][0],
-                           af_scale,
-					            af_bias);
-
-		}/*End if( t_calState == NAV_MAG_CAL)*/
-      else if( t_calState == NAV_ACCEL_CAL)
+         usr_navGetMagCal( t_result.af_R,
+                           t_result.af_scale,
+                           t_result.af_bias);
+      }
+      else
       {
-         usr_navGetAccelCal( &af_R[0][0],
-                             af_scale,
-					              af_bias);
+         usr_navGetAccelCal( t_result.af_R,
+                             t_result.af_scale,
+                             t_result.af_bias);
+      }
 
-      }/*End else if( t_calState == NAV_ACCEL_CAL)*/
+      t_result.c_passed = 1;
 
-		s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #calrotmatrix %.4f %.4f %.4f %.4f %.4f %.4f %.4f %.4f %.4f\r\n"),
-		af_R[0][0], af_R[0][1], af_R[0][2], af_R[1][0], af_R[1][1], af_R[1][2], af_R[2][0], af_R[2][1], af_R[2][2]);
+   }/*End if( usr_navGetCalStatus() == INS_CAL_COMPLETE)*/
 
-      arb_write( t_consoleHndl,
-                 pc_buff,
-                 s_size);
+   usr_sendCalResult( t_consoleHndl,
+                      &t_result,
+                      pc_buff);
 
-      arb_sleep( 10);
+}/*End usr_sensorCal*/
 
-		s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #axisscale %.4f %.4f %.4f\r\n"),
-		af_scale[0], af_scale[1], af_scale[2]);
+static bool usr_setActiveState( t_DEVHANDLE t_consoleHndl,
+                               int8_t *pc_buff,
+                               t_consoleTokHndl *pt_tokHndl)
+{
+   usr_navSetState( NAV_ACTIVE);
 
-      arb_write( t_consoleHndl,
-                 pc_buff,
-                 s_size);
+   return true;
 
-      arb_sleep( 10);
+}/*End usr_setActiveState*/
 
-		s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #axisbias %.4f %.4f %.4f\r\n"),
-		af_bias[0], af_bias[1], af_bias[2]);
+static bool usr_setIdleState( t_DEVHANDLE t_consoleHndl,
+                             int8_t *pc_buff,
+                             t_consoleTokHndl *pt_tokHndl)
+{
+   usr_navSetState( NAV_ACCEL_CAL);
 
-      arb_write( t_consoleHndl,
-                 pc_buff,
-                 s_size);
+   return true;
 
-      arb_sleep( 10);
+}/*End usr_setIdleState*/
 
-      s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #result passed\r\n"));
+static bool usr_setDcmInit( t_DEVHANDLE t_consoleHndl,
+                            int8_t *pc_buff,
+                            t_consoleTokHndl *pt_tokHndl)
+{
+   usr_navSetState( NAV_DCM_INIT);
 
-      arb_write( t_consoleHndl,
-                 pc_buff,
-                 s_size);
+   return true;
 
+}/*End usr_setDcmInit*/
 
-	}/*End if( usr_navGetCalStatus() == INS_CAL_COMPLETE)*/
-	else
-	{
-		s_size = sprintf_P( (char *)pc_buff, PSTR("#calmsg #result failed\r\n"));
+static bool usr_magCal( t_DEVHANDLE t_consoleHndl,
+                        int8_t *pc_buff,
+                        t_consoleTokHndl *pt_tokHndl)
+{
+   usr_sensorCal( t_consoleHndl,
+                  NAV_MAG_CAL,
+                  pc_buff);
 
-      arb_write( t_consoleHndl,
-                 pc_buff,
-                 s_size);
-	}
+   return true;
 
-}/*End usr_sensorCal*/
+}/*End usr_magCal*/
 
-bool usr_console( t_DEVHANDLE t_consoleHndl,
-                  int8_t *pc_buff,
-                  t_consoleTokHndl *pt_tokHndl)
+static bool usr_accelCal( t_DEVHANDLE t_consoleHndl,
+                          int8_t *pc_buff,
+                          t_consoleTokHndl *pt_tokHndl)
 {
+   usr_sensorCal( t_consoleHndl,
+                  NAV_ACCEL_CAL,
+                  pc_buff);
 
-   bool b_success = true; /*A valid command was found...*/
+   return true;
 
-   if( strcmp( (char *)pt_tokHndl->ac_tok[0], "sas") == 0) /*Set active state*/
-   {
-      usr_navSetState( NAV_ACTIVE);
-   }/*End if( strcmp( (char *)pt_tokHndl->ac_tok[0], "sam") == 0)*/
-   else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "sis") == 0) /*Set idle state*/
-   {
-      usr_navSetState( NAV_ACCEL_CAL);
-   }/*End else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "sim") == 0)*/
-   else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "sdi") == 0) /*Set DCM init*/
-   {
-      usr_navSetState( NAV_DCM_INIT);
-   }/*End else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "sim") == 0)*/
-   else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "pmc") == 0) /*Perform mag cal*/
-   {
-      usr_sensorCal( t_consoleHndl,
-                     NAV_MAG_CAL,
-                     pc_buff);
-   }/*Emd if( strcmp( (char *)pt_tokHndl->ac_tok[0], "pmc") == 0)*/
-   else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "pac") == 0) /*Perform accel cal*/
-   {
-      usr_sensorCal( t_consoleHndl,
-                     NAV_ACCEL_CAL,
-                     pc_buff);
-   }/*End else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "pac") == 0)*/
-   else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "gsd") == 0) /*Get state data*/
-   {
-      t_currentMeas t_meas;
-      uint16_t s_size;
-      t_navState t_state = usr_navGetState();
+}/*End usr_accelCal*/
 
-      usr_navGetStateEst( &t_meas);
+static bool usr_getStateData( t_DEVHANDLE t_consoleHndl,
+                              int8_t *pc_buff,
+                              t_consoleTokHndl *pt_tokHndl)
+{
+   t_currentMeas t_meas;
+   uint16_t s_size;
+   t_navState t_state = usr_navGetState();
+   t_tlmStateEst t_est;
+   t_tlmDcm t_dcm;
 
-      /*---------------------------------------------------------------------*
-       * Return "Current State Data"
-       *---------------------------------------------------------------------*/
-		s_size = sprintf_P( (char *)pc_buff,
-                          PSTR("#csd %f %f %f %f %f %f %f %f %f %f %f\r\n"),
-                          t_meas.f_corrRoll,
-                          t_meas.f_rawRoll,
-                          t_meas.f_corrPitch,
-                          t_meas.f_rawPitch,
-                          t_meas.f_corrYaw,
-                          t_meas.f_rawYaw,
-                          t_meas.f_platMovingCount,
-                          t_meas.af_avrResMag[0],
-                          t_meas.af_avrResMag[1],
-                          t_meas.af_avrResMag[2],
-                          (float)t_state);
-
-		arb_write( t_consoleHndl,
-		           pc_buff,
-		           s_size);
-   }
-   else /*Unrecognized message*/
+   usr_navGetStateEst( &t_meas);
+
+   if( gb_binaryTlm == true)
    {
-      b_success = false;
-   }
+      t_est.f_corrRoll        = t_meas.f_corrRoll;
+      t_est.f_rawRoll         = t_meas.f_rawRoll;
+      t_est.f_corrPitch       = t_meas.f_corrPitch;
+      t_est.f_rawPitch        = t_meas.f_rawPitch;
+      t_est.f_corrYaw         = t_meas.f_corrYaw;
+      t_est.f_rawYaw          = t_meas.f_rawYaw;
+      t_est.f_platMovingCount = t_meas.f_platMovingCount;
+      t_est.af_avrResMag[0]   = t_meas.af_avrResMag[0];
+      t_est.af_avrResMag[1]   = t_meas.af_avrResMag[1];
+      t_est.af_avrResMag[2]   = t_meas.af_avrResMag[2];
+      t_est.c_navState        = (uint8_t)t_state;
+
+      usr_sendTelemetry( t_consoleHndl,
+                         TLM_MSG_STATE_EST,
+                         TLM_STATE_EST_VERSION,
+                         &t_est,
+                         sizeof( t_est),
+                         pc_buff);
+
+      usr_navGetDcm( t_dcm.as_dcm);
+
+      usr_sendTelemetry( t_consoleHndl,
+                         TLM_MSG_DCM,
+                         TLM_DCM_VERSION,
+                         &t_dcm,
+                         sizeof( t_dcm),
+                         pc_buff);
+
+      return true;
+
+   }/*End if( gb_binaryTlm == true)*/
 
    /*------------------------------------------------------------------------*
-    * Return control over the console to the kernel...
+    * Return "Current State Data"
     *------------------------------------------------------------------------*/
-   return b_success;
+   s_size = sprintf_P( (char *)pc_buff,
+                       PSTR("#csd %f %f %f %f %f %f %f %f %f %f %f\r\n"),
+                       t_meas.f_corrRoll,
+                       t_meas.f_rawRoll,
+                       t_meas.f_corrPitch,
+                       t_meas.f_rawPitch,
+                       t_meas.f_corrYaw,
+                       t_meas.f_rawYaw,
+                       t_meas.f_platMovingCount,
+                       t_meas.af_avrResMag[0],
+                       t_meas.af_avrResMag[1],
+                       t_meas.af_avrResMag[2],
+                       (float)t_state);
+
+   arb_write( t_consoleHndl,
+              pc_buff,
+              s_size);
+
+   return true;
+
+}/*End usr_getStateData*/
+
+static bool usr_setTelemetryMode( t_DEVHANDLE t_consoleHndl,
+                                  int8_t *pc_buff,
+                                  t_consoleTokHndl *pt_tokHndl)
+{
+   if( pt_tokHndl->c_numTokens != 2)
+      return false;
+
+   if( pt_tokHndl->ac_tok[1][0] == '1')
+      gb_binaryTlm = true;
+   else if( pt_tokHndl->ac_tok[1][0] == '0')
+      gb_binaryTlm = false;
+   else
+      return false;
 
-}/*End arb_console*/
+   return true;
+
+}/*End usr_setTelemetryMode*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_error usr_consoleInit( void)
+{
+   t_error t_err;
+
+   t_err = arb_consoleRegisterCmd( PSTR("sas"),
+                                   usr_setActiveState,
+                                   PSTR("Set the navigation state to active."));
+   if( t_err < 0)
+      return t_err;
+
+   t_err = arb_consoleRegisterCmd( PSTR("sis"),
+                                   usr_setIdleState,
+                                   PSTR("Set the navigation state to idle."));
+   if( t_err < 0)
+      return t_err;
+
+   t_err = arb_consoleRegisterCmd( PSTR("sdi"),
+                                   usr_setDcmInit,
+                                   PSTR("Re-initialize the DCM."));
+   if( t_err < 0)
+      return t_err;
+
+   t_err = arb_consoleRegisterCmd( PSTR("pmc"),
+                                   usr_magCal,
+                                   PSTR("Perform a magnetometer calibration."));
+   if( t_err < 0)
+      return t_err;
+
+   t_err = arb_consoleRegisterCmd( PSTR("pac"),
+                                   usr_accelCal,
+                                   PSTR("Perform an accelerometer calibration."));
+   if( t_err < 0)
+      return t_err;
+
+   t_err = arb_consoleRegisterCmd( PSTR("gsd"),
+                                   usr_getStateData,
+                                   PSTR("Get the current state data."));
+   if( t_err < 0)
+      return t_err;
+
+   t_err = arb_consoleRegisterCmd( PSTR("stm"),
+                                   usr_setTelemetryMode,
+                                   PSTR("<0|1> Send telemetry as text (0) or binary frames (1)."));
+
+   return t_err;
+
+}/*End usr_consoleInit*/
@@ -65,10 +65,10 @@
 typedef struct
 {
    /*------------------------------------------------------------------------*
-    * Handle to the state-machine object that defines how the navigation
-    * thread transitions between states.
+    * The state-machine object that defines how the navigation thread
+    * transitions between states.
     *------------------------------------------------------------------------*/
-   t_STMNHNDL t_stateMn;
+   t_stateMachine t_stateMn;
 
    /*------------------------------------------------------------------------*
     * During a state transition this variable keeps track of where it last
@@ -158,6 +158,89 @@ static void usr_navCalComplete( int32_t i_stateData,
  *---------------------------------------------------------------------------*/
 static t_navStruct gt_navStruct;
 
+/*---------------------------------------------------------------------------*
+ * The call-back function and all possible transitions for each navigation
+ * state.
+ *---------------------------------------------------------------------------*/
+UTL_STMN_CREATE_TABLE( gat_navStates, NAV_NUM_STATES) =
+{
+   [NAV_IDLE] = UTL_STMN_STATE( &usr_navIdle,
+                                NULL,
+                                NULL,
+                                UTL_STMN_NO_STATE,
+                                UTL_STMN_TRANS( NAV_IDLE) |
+                                UTL_STMN_TRANS( NAV_MAG_CAL) |
+                                UTL_STMN_TRANS( NAV_ACCEL_CAL) |
+                                UTL_STMN_TRANS( NAV_DCM_INIT) |
+                                UTL_STMN_TRANS( NAV_ACTIVE)),
+
+   [NAV_CAL_COMPLETE] = UTL_STMN_STATE( &usr_navCalComplete,
+                                        NULL,
+                                        NULL,
+                                        UTL_STMN_NO_STATE,
+                                        UTL_STMN_TRANS( NAV_CAL_COMPLETE) |
+                                        UTL_STMN_TRANS( NAV_DCM_INIT) |
+                                        UTL_STMN_TRANS( NAV_ACTIVE) |
+                                        UTL_STMN_TRANS( NAV_IDLE)),
+
+   [NAV_CAL_SAMP_COMP] = UTL_STMN_STATE( &usr_navCalSampComp,
+                                         NULL,
+                                         NULL,
+                                         UTL_STMN_NO_STATE,
+                                         UTL_STMN_TRANS( NAV_CAL_SAMP_COMP) |
+                                         UTL_STMN_TRANS( NAV_MAG_CAL) |
+                                         UTL_STMN_TRANS( NAV_ACCEL_CAL) |
+                                         UTL_STMN_TRANS( NAV_IDLE)),
+
+   [NAV_MAG_CAL] = UTL_STMN_STATE( &usr_navMagCal,
+                                   NULL,
+                                   NULL,
+                                   UTL_STMN_NO_STATE,
+                                   UTL_STMN_TRANS( NAV_MAG_CAL) |
+                                   UTL_STMN_TRANS( NAV_IDLE) |
+                                   UTL_STMN_TRANS( NAV_ERROR) |
+                                   UTL_STMN_TRANS( NAV_CAL_SAMP_COMP) |
+                                   UTL_STMN_TRANS( NAV_CAL_COMPLETE)),
+
+   [NAV_ACCEL_CAL] = UTL_STMN_STATE( &usr_navAccelCal,
+                                     NULL,
+                                     NULL,
+                                     UTL_STMN_NO_STATE,
+                                     UTL_STMN_TRANS( NAV_ACCEL_CAL) |
+                                     UTL_STMN_TRANS( NAV_IDLE) |
+                                     UTL_STMN_TRANS( NAV_ERROR) |
+                                     UTL_STMN_TRANS( NAV_CAL_SAMP_COMP) |
+                                     UTL_STMN_TRANS( NAV_CAL_COMPLETE)),
+
+   [NAV_DCM_INIT] = UTL_STMN_STATE( &usr_navDcmInit,
+                                    NULL,
+                                    NULL,
+                                    UTL_STMN_NO_STATE,
+                                    UTL_STMN_TRANS( NAV_DCM_INIT) |
+                                    UTL_STMN_TRANS( NAV_ACTIVE) |
+                                    UTL_STMN_TRANS( NAV_ERROR) |
+                                    UTL_STMN_TRANS( NAV_IDLE)),
+
+   [NAV_ACTIVE] = UTL_STMN_STATE( &usr_navActive,
+                                  NULL,
+                                  NULL,
+                                  UTL_STMN_NO_STATE,
+                                  UTL_STMN_TRANS( NAV_ACTIVE) |
+                                  UTL_STMN_TRANS( NAV_IDLE) |
+                                  UTL_STMN_TRANS( NAV_ERROR)),
+
+   [NAV_ERROR] = UTL_STMN_STATE( &usr_navError,
+                                 NULL,
+                                 NULL,
+                                 UTL_STMN_NO_STATE,
+                                 UTL_STMN_TRANS( NAV_ERROR) |
+                                 UTL_STMN_TRANS( NAV_MAG_CAL) |
+                                 UTL_STMN_TRANS( NAV_ACCEL_CAL) |
+                                 UTL_STMN_TRANS( NAV_DCM_INIT) |
+                                 UTL_STMN_TRANS( NAV_ACTIVE) |
+                                 UTL_STMN_TRANS( NAV_IDLE))
+};
+
 /*---------------------------------------------------------------------------*
  * Global Variables
  *---------------------------------------------------------------------------*/
@@ -280,13 +363,13 @@ static void usr_navMagCal( int32_t i_stateData,
     *------------------------------------------------------------------------*/
    if( gt_navStruct.t_calStatus == INS_CAL_IN_PROGRESS)
    {
-      t_err = utl_stMnChangeState( gt_navStruct.t_stateMn,
+      t_err = utl_stMnChangeState( &gt_navStruct.t_stateMn,
                                     (uint8_t)NAV_CAL_SAMP_COMP,
                                     0);
    }/*End if( t_calStatus == INS_CAL_COMPLETE)*/
    else
    {
-      utl_stMnChangeState( gt_navStruct.t_stateMn,
+      utl_stMnChangeState( &gt_navStruct.t_stateMn,
                            (uint8_t)NAV_CAL_COMPLETE,
                            0);
    }
@@ -333,13 +416,13 @@ static void usr_navAccelCal( int32_t i_stateData,
     *------------------------------------------------------------------------*/
    if( gt_navStruct.t_calStatus == INS_CAL_IN_PROGRESS)
    {
-      utl_stMnChangeState( gt_navStruct.t_stateMn,
+      utl_stMnChangeState( &gt_navStruct.t_stateMn,
                            (uint8_t)NAV_CAL_SAMP_COMP,
                            0);
    }/*End if( t_calStatus == INS_CAL_COMPLETE)*/
    else
    {
-      utl_stMnChangeState( gt_navStruct.t_stateMn,
+      utl_stMnChangeState( &gt_navStruct.t_stateMn,
                            (uint8_t)NAV_CAL_COMPLETE,
                            0);
    }
@@ -364,7 +447,7 @@ static void usr_navDcmInit( int32_t i_stateData,
                   INS_DCM_INIT,
                   0) == INS_CAL_COMPLETE)
    {
-      utl_stMnChangeState( gt_navStruct.t_stateMn,
+      utl_stMnChangeState( &gt_navStruct.t_stateMn,
                            (uint8_t)NAV_ACTIVE,
                            0);
    }
@@ -433,7 +516,7 @@ static void usr_navigation( t_parameters t_param,
       /*---------------------------------------------------------------------*
        * Transition to the next state...
        *---------------------------------------------------------------------*/
-      t_stErr = utl_stMnEngine( gt_navStruct.t_stateMn);
+      t_stErr = utl_stMnEngine( &gt_navStruct.t_stateMn);
 
       /*---------------------------------------------------------------------*
        * unlock...
@@ -462,7 +545,7 @@ bool usr_navSetState( t_navState t_nxtState)
     *------------------------------------------------------------------------*/
    arb_wait( gt_navStruct.t_mutex, 0);
 
-   t_err = utl_stMnChangeState( gt_navStruct.t_stateMn,
+   t_err = utl_stMnChangeState( &gt_navStruct.t_stateMn,
                                 (uint8_t)t_nxtState,
                                 0);
    if( t_err != STMN_PASSED)
@@ -599,132 +682,36 @@ void usr_navGetStateEst( t_currentMeas *pt_currentMeas)
 
 }/*End usr_navGetStateEst*/
 
-static void usr_navStateMachineInit( void)
+void usr_navGetDcm( int16_t *ps_dcm)
 {
-   uint8_t ac_transMap[NAV_NUM_STATES][NAV_NUM_STATES];
-
-   /*------------------------------------------------------------------------*
-    * Request access to a new state-machine object.
-    *------------------------------------------------------------------------*/
-   gt_navStruct.t_stateMn = utl_requestStMnObject( NAV_NUM_STATES,
-                                                   NAV_DCM_INIT);
-   if( gt_navStruct.t_stateMn < 0)
-      exit(0);
+   int32_t i_result;
 
    /*------------------------------------------------------------------------*
-    * Store the call-back function for each possible state transition.
+    * Global data is being accessed, apply lock...
     *------------------------------------------------------------------------*/
-   if( utl_stMnPopFunMap( gt_navStruct.t_stateMn,
-                          &usr_navIdle,
-                          (uint8_t)NAV_IDLE) < 0)
-   {
-      exit(0);
-   }
-
-   if( utl_stMnPopFunMap( gt_navStruct.t_stateMn,
-                          &usr_navMagCal,
-                          (uint8_t)NAV_MAG_CAL) < 0)
-   {
-      exit(0);
-   }
-
-   if( utl_stMnPopFunMap( gt_navStruct.t_stateMn,
-                          &usr_navAccelCal,
-                          (uint8_t)NAV_ACCEL_CAL) < 0)
-   {
-      exit(0);
-   }
-
-   if( utl_stMnPopFunMap( gt_navStruct.t_stateMn,
-                          &usr_navDcmInit,
-                          (uint8_t)NAV_DCM_INIT) < 0)
-   {
-      exit(0);
-   }
+   arb_wait( gt_navStruct.t_mutex, 0);
 
-   if( utl_stMnPopFunMap( gt_navStruct.t_stateMn,
-                          &usr_navActive,
-                          (uint8_t)NAV_ACTIVE) < 0)
-   {
-      exit(0);
-   }
+   i_result = arb_ioctl( gt_navStruct.t_insHndl,
+                         INS_GET_DCM,
+                         (int32_t)(int16_t)ps_dcm);
 
-   if( utl_stMnPopFunMap( gt_navStruct.t_stateMn,
-                          &usr_navError,
-                          (uint8_t)NAV_ERROR) < 0)
-   {
-      exit(0);
-   }
+   arb_signal( gt_navStruct.t_mutex);
 
-   if( utl_stMnPopFunMap( gt_navStruct.t_stateMn,
-                          &usr_navCalSampComp,
-                          (uint8_t)NAV_CAL_SAMP_COMP) < 0)
-   {
-      exit(0);
-   }
+}/*End usr_navGetDcm*/
 
-   if( utl_stMnPopFunMap( gt_navStruct.t_stateMn,
-                          &usr_navCalComplete,
-                          (uint8_t)NAV_CAL_COMPLETE) < 0)
+static void usr_navStateMachineInit( void)
+{
+   /*------------------------------------------------------------------------*
+    * Attach the state table to the navigation state-machine object.
+    *------------------------------------------------------------------------*/
+   if( utl_stMnInit( &gt_navStruct.t_stateMn,
+                     gat_navStates,
+                     NAV_NUM_STATES,
+                     NAV_DCM_INIT) < 0)
    {
       exit(0);
    }
 
-   memset( (void *)ac_transMap, 0, sizeof( ac_transMap));
-
-   /*------------------------------------------------------------------------*
-    * Define all possible state transitions...
-    *------------------------------------------------------------------------*/
-   ac_transMap[NAV_IDLE][NAV_IDLE]      = 1;
-   ac_transMap[NAV_IDLE][NAV_MAG_CAL]   = 1;
-   ac_transMap[NAV_IDLE][NAV_ACCEL_CAL] = 1;
-   ac_transMap[NAV_IDLE][NAV_DCM_INIT]  = 1;
-   ac_transMap[NAV_IDLE][NAV_ACTIVE]    = 1;
-
-   ac_transMap[NAV_MAG_CAL][NAV_MAG_CAL]       = 1;
-   ac_transMap[NAV_MAG_CAL][NAV_IDLE]          = 1;
-   ac_transMap[NAV_MAG_CAL][NAV_ERROR]         = 1;
-   ac_transMap[NAV_MAG_CAL][NAV_CAL_SAMP_COMP] = 1;
-   ac_transMap[NAV_MAG_CAL][NAV_CAL_COMPLETE]  = 1;
-
-   ac_transMap[NAV_ACCEL_CAL][NAV_ACCEL_CAL]     = 1;
-   ac_transMap[NAV_ACCEL_CAL][NAV_IDLE]          = 1;
-   ac_transMap[NAV_ACCEL_CAL][NAV_ERROR]         = 1;
-   ac_transMap[NAV_ACCEL_CAL][NAV_CAL_SAMP_COMP] = 1;
-   ac_transMap[NAV_ACCEL_CAL][NAV_CAL_COMPLETE]  = 1;
-
-   ac_transMap[NAV_DCM_INIT][NAV_DCM_INIT] = 1;
-   ac_transMap[NAV_DCM_INIT][NAV_ACTIVE]   = 1;
-   ac_transMap[NAV_DCM_INIT][NAV_ERROR]    = 1;
-   ac_transMap[NAV_DCM_INIT][NAV_IDLE]     = 1;
-
-   ac_transMap[NAV_ERROR][NAV_ERROR]     = 1;
-   ac_transMap[NAV_ERROR][NAV_MAG_CAL]   = 1;
-   ac_transMap[NAV_ERROR][NAV_ACCEL_CAL] = 1;
-   ac_transMap[NAV_ERROR][NAV_DCM_INIT]  = 1;
-   ac_transMap[NAV_ERROR][NAV_ACTIVE]    = 1;
-   ac_transMap[NAV_ERROR][NAV_IDLE]      = 1;
-
-   ac_transMap[NAV_ACTIVE][NAV_ACTIVE] = 1;
-   ac_transMap[NAV_ACTIVE][NAV_IDLE]   = 1;
-   ac_transMap[NAV_ACTIVE][NAV_ERROR]  = 1;
-
-   ac_transMap[NAV_CAL_COMPLETE][NAV_CAL_COMPLETE] = 1;
-   ac_transMap[NAV_CAL_COMPLETE][NAV_DCM_INIT]     = 1;
-   ac_transMap[NAV_CAL_COMPLETE][NAV_ACTIVE]       = 1;
-   ac_transMap[NAV_CAL_COMPLETE][NAV_IDLE]         = 1;
-
-   ac_transMap[NAV_CAL_SAMP_COMP][NAV_CAL_SAMP_COMP] = 1;
-   ac_transMap[NAV_CAL_SAMP_COMP][NAV_MAG_CAL]       = 1;
-   ac_transMap[NAV_CAL_SAMP_COMP][NAV_ACCEL_CAL]     = 1;
-   ac_transMap[NAV_CAL_SAMP_COMP][NAV_IDLE]          = 1;
-
-   /*------------------------------------------------------------------------*
-    * Store the state transition map.
-    *------------------------------------------------------------------------*/
-   utl_stMnPopTransMap( gt_navStruct.t_stateMn,
-                        &ac_transMap[0][0]);
-
 }/*End usr_navStateMachineInit*/
 
 void usr_navigationInit( void)
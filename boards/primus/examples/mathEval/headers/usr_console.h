@@ -41,6 +41,7 @@
     * Include Files
     *------------------------------------------------------------------------*/
    #include "avr_compiler.h"
+   #include "arb_error.h"
    #include "arb_device.h"
    #include "drv_console.h"
 
@@ -51,9 +52,7 @@
    /*------------------------------------------------------------------------*
     * Global Function Prototypes
     *------------------------------------------------------------------------*/
-   bool usr_console( t_DEVHANDLE t_consoleHndl,
-                     int8_t *pc_buff,
-                     t_consoleTokHndl *pt_tokHndl);
+   t_error usr_consoleInit( void);
 
    #ifdef __cplusplus
    }/*End extern "C"*/
@@ -150,8 +150,8 @@ static void usr_mathTest( t_parameters t_param,
       i_loading2 = i_loading2 - s_callLoad;
 
       s_size = sprintf( ( char *)ac_buff, "fixed atan2=%d ansii atan2=%d err=%.2f%% speed=%dx\r",
-                        s_cos,
-                        (int16_t)(f_cos*32767.0f),
+                        s_angle,
+                        (int16_t)(f_phase*32767.0f/3.14159f),
                         (double)f_error,
                         (int)i_loading2/i_loading1);
       arb_printf( PRINTF_DBG_MED |PRINTF_DBG_SHOW_TIME, 
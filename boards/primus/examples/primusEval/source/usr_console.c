@@ -40,6 +40,7 @@
 #include "arb_mailbox.h"
 #include "arb_console.h"
 #include "drv_console.h"
+#include "usr_console.h"
 #include "usr_platformTest.h"
 
 /*---------------------------------------------------------------------------*
@@ -437,119 +438,107 @@ static void usr_timerGpioTest( t_DEVHANDLE t_consoleHndl,
 
 }/*End usr_timerGpioTest*/
 
-static void usr_displayUserHelp( t_DEVHANDLE t_consoleHndl,
-                                 int8_t *pc_buff)
+static bool usr_uartLoopback( t_DEVHANDLE t_consoleHndl,
+                              int8_t *pc_buff,
+                              t_consoleTokHndl *pt_tokHndl)
 {
-   uint16_t s_size;
+   if( pt_tokHndl->c_numTokens != 1)
+      return false;
 
    /*------------------------------------------------------------------------*
-    * Display a list of all the possible console commands specific
-    * to a user-space application.
+    * Perform a loopback test using UART6, a DMA, and two mailbox modules.
     *------------------------------------------------------------------------*/
-   s_size = sprintf_P( (char *)pc_buff, PSTR(".------------------------------------------------------------------------.\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| Command |     Arguments     |              Description                 |\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("|---------|-------------------|------------------------------------------|\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| ult     |                   | Performs a UART loopback test.           |\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| tlt     |                   | Performs a TWI loopback test.            |\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| tgt     |                   | Performs a test using a timer and 2 gpios|\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| slt     |                   | Performs a SPI loopback test.            |\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("'---------'-------------------'------------------------------------------'\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-}/*End usr_displayUserHelp*/
+   usr_loopbackTest( t_consoleHndl,
+                     pc_buff,
+                     UART_LOOPBACK_TEST);
+
+   return true;
+
+}/*End usr_uartLoopback*/
+
+static bool usr_twiLoopback( t_DEVHANDLE t_consoleHndl,
+                             int8_t *pc_buff,
+                             t_consoleTokHndl *pt_tokHndl)
+{
+   if( pt_tokHndl->c_numTokens != 1)
+      return false;
+
+   /*------------------------------------------------------------------------*
+    * Perform a loopback test using TWI2, TWI3, and two mailbox modules.
+    *------------------------------------------------------------------------*/
+   usr_loopbackTest( t_consoleHndl,
+                     pc_buff,
+                     TWI_LOOPBACK_TEST);
+
+   return true;
+
+}/*End usr_twiLoopback*/
+
+static bool usr_spiLoopback( t_DEVHANDLE t_consoleHndl,
+                             int8_t *pc_buff,
+                             t_consoleTokHndl *pt_tokHndl)
+{
+   if( pt_tokHndl->c_numTokens != 1)
+      return false;
+
+   /*------------------------------------------------------------------------*
+    * Perform a loopback test using SPI2 and two mailbox modules.
+    *------------------------------------------------------------------------*/
+   usr_loopbackTest( t_consoleHndl,
+                     pc_buff,
+                     SPI_LOOPBACK_TEST);
+
+   return true;
+
+}/*End usr_spiLoopback*/
+
+static bool usr_timerGpio( t_DEVHANDLE t_consoleHndl,
+                           int8_t *pc_buff,
+                           t_consoleTokHndl *pt_tokHndl)
+{
+   if( pt_tokHndl->c_numTokens != 1)
+      return false;
+
+   /*------------------------------------------------------------------------*
+    * Perform a loopback test using TIMER_1, GPIO_1, GPIO_2, and one
+    * mailbox module.
+    *------------------------------------------------------------------------*/
+   usr_timerGpioTest( t_consoleHndl,
+                      pc_buff);
+
+   return true;
+
+}/*End usr_timerGpio*/
 
 /*---------------------------------------------------------------------------*
  * Public Function Definitions
  *---------------------------------------------------------------------------*/
-bool usr_console( t_DEVHANDLE t_consoleHndl,
-                  int8_t *pc_buff,
-                  t_consoleTokHndl *pt_tokHndl)
+t_error usr_consoleInit( void)
 {
+   t_error t_err;
 
-   bool b_success = true; /*A valid command was found...*/
+   t_err = arb_consoleRegisterCmd( PSTR("ult"),
+                                   usr_uartLoopback,
+                                   PSTR("Performs a UART loopback test."));
+   if( t_err < 0)
+      return t_err;
 
-   if( strcmp( (char *)pt_tokHndl->ac_tok[0], "hlpu") == 0)
-   {
-      /*---------------------------------------------------------------------*
-       * Display a list of all the possible user-space specific commands.
-       *---------------------------------------------------------------------*/
-      usr_displayUserHelp( t_consoleHndl,
-                           pc_buff);
+   t_err = arb_consoleRegisterCmd( PSTR("tlt"),
+                                   usr_twiLoopback,
+                                   PSTR("Performs a TWI loopback test."));
+   if( t_err < 0)
+      return t_err;
 
-   }/*End else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "hlpu") == 0)*/
-   else if( (strcmp( (char *)pt_tokHndl->ac_tok[0], "ult") == 0)
-   && (pt_tokHndl->c_numTokens == 1))
-   {
-      /*---------------------------------------------------------------------*
-       * Perform a loopback test using UART6, a DMA, and two mailbox modules.
-       *---------------------------------------------------------------------*/
-      usr_loopbackTest( t_consoleHndl,
-                        pc_buff,
-                        UART_LOOPBACK_TEST);
-   }
-   else if( (strcmp( (char *)pt_tokHndl->ac_tok[0], "tlt") == 0)
-   && (pt_tokHndl->c_numTokens == 1))
-   {
-      /*---------------------------------------------------------------------*
-       * Perform a loopback test using TWI2, TWI3, and two mailbox modules.
-       *---------------------------------------------------------------------*/
-      usr_loopbackTest( t_consoleHndl,
-                        pc_buff,
-                        TWI_LOOPBACK_TEST);
-   }
-   else if( (strcmp( (char *)pt_tokHndl->ac_tok[0], "slt") == 0)
-   && (pt_tokHndl->c_numTokens == 1))
-   {
-      /*---------------------------------------------------------------------*
-       * Perform a loopback test using SPI2 and two mailbox modules.
-       *---------------------------------------------------------------------*/
-      usr_loopbackTest( t_consoleHndl,
-                        pc_buff,
-                        SPI_LOOPBACK_TEST);
-   }
-   else if( (strcmp( (char *)pt_tokHndl->ac_tok[0], "tgt") == 0)
-   && (pt_tokHndl->c_numTokens == 1))
-   {
-      /*---------------------------------------------------------------------*
-       * Perform a loopback test using TIMER_1, GPIO_1, GPIO_2, and one
-       * mailbox module.
-       *---------------------------------------------------------------------*/
-      usr_timerGpioTest( t_consoleHndl,
-                         pc_buff);
-   }
-   else /*Unrecognized message*/
-   {
-      /*---------------------------------------------------------------------*
-       * Let 'arb_console' know the command wasn't found.
-       *---------------------------------------------------------------------*/
-      b_success = false;
-   }
+   t_err = arb_consoleRegisterCmd( PSTR("tgt"),
+                                   usr_timerGpio,
+                                   PSTR("Performs a test using a timer and 2 gpios."));
+   if( t_err < 0)
+      return t_err;
 
-   /*------------------------------------------------------------------------*
-    * Return control over the console to the kernel...
-    *------------------------------------------------------------------------*/
-   return b_success;
+   t_err = arb_consoleRegisterCmd( PSTR("slt"),
+                                   usr_spiLoopback,
+                                   PSTR("Performs a SPI loopback test."));
+
+   return t_err;
 
-}/*End usr_console*/
+}/*End usr_consoleInit*/
@@ -0,0 +1,75 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : usr_simConsole.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : A write-only device that prints through the simavr console
+ *               register.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef usr_simConsole_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define usr_simConsole_h
+
+   /*------------------------------------------------------------------------*
+    * Register simavr watches, every byte written to it is added to a line
+    * which is printed (prefixed with "O:") when a '\r' arrives. simavr only
+    * hooks writes from data address 0x20 up (below that its mega style
+    * cores map r0-r31), so this uses a reserved address just above the
+    * xmega's virtual ports rather than one of the GPIO registers. Must not
+    * overlap the HAL_SIM_CYCLE_* registers in hal_clocks.h.
+    *------------------------------------------------------------------------*/
+   #define USR_SIM_CONSOLE_REG (*(volatile uint8_t *)0x0025)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+   #include "arb_error.h"
+
+   /*------------------------------------------------------------------------*
+    * Global typedefs
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Registers "simConsoleDevice0" with the kernel.
+    *------------------------------------------------------------------------*/
+   t_error usr_simConsoleInit( uint8_t c_majorNum);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef usr_simConsole_h*/
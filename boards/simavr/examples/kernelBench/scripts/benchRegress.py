@@ -0,0 +1,194 @@
+#-------------------------------------------------------------------------------
+# Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+#
+# Runs a kernel benchmark image and checks its report against a baseline.
+#
+#   python benchRegress.py [options] -- <command that runs the image>
+#
+# The command is normally simavr with kernelBench.elf, but anything that
+# prints the arb_bench CSV report works (e.g. the host build's kernelBench).
+# simavr prefixes console lines with "O:", which is stripped.
+#
+# A suite regresses when its median is more than --threshold percent above
+# the baseline median. The exit status is 0 when nothing regressed, 1 when
+# something did, and 2 when the image failed or there was no baseline to
+# compare against.
+#-------------------------------------------------------------------------------
+import argparse
+import subprocess
+import sys
+import threading
+
+REPORT_END = '#end'
+REPORT_ERROR = '#error'
+
+#-------------------------------------------------------------------------------
+# Columns of a report line, see utl_benchFormatResult.
+#-------------------------------------------------------------------------------
+COLUMNS = ('name', 'iterations', 'samples', 'min', 'median', 'max')
+
+def parseReport( lines):
+   hz = None
+   results = {}
+   order = []
+   status = None
+
+   for line in lines:
+      line = line.strip()
+      if line.startswith( 'O:'):
+         line = line[2:]
+      if not line:
+         continue
+
+      if line.startswith( '#hz,'):
+         hz = int( line.split( ',')[1])
+      elif line.startswith( REPORT_END):
+         status = REPORT_END
+      elif line.startswith( REPORT_ERROR):
+         status = line
+      elif not line.startswith( '#'):
+         fields = line.split( ',')
+         if len( fields) != len( COLUMNS):
+            continue
+         try:
+            entry = dict( zip( COLUMNS[1:], [float( f) for f in fields[1:]]))
+         except ValueError:
+            continue
+         if fields[0] not in results:
+            order.append( fields[0])
+         results[fields[0]] = entry
+
+   return hz, results, order, status
+
+def runImage( command, timeout):
+   proc = subprocess.Popen( command,
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+
+   #----------------------------------------------------------------------------
+   # The image may never stop on its own (e.g. it hit 'exit' on the target),
+   # so give up after 'timeout' seconds.
+   #----------------------------------------------------------------------------
+   timer = threading.Timer( timeout, proc.kill)
+   timer.start()
+   try:
+      output = proc.communicate()[0]
+   finally:
+      timer.cancel()
+
+   return proc.returncode, output.replace( '\r', '\n').split( '\n')
+
+def readBaseline( path):
+   try:
+      with open( path) as f:
+         return parseReport( f.readlines())
+   except IOError:
+      return None
+
+def writeBaseline( path, hz, results, order):
+   with open( path, 'w') as f:
+      f.write( '#hz,%d\n' % hz)
+      f.write( '#' + ','.join( COLUMNS) + '\n')
+      for name in order:
+         r = results[name]
+         f.write( '%s,%d,%d,%.1f,%.1f,%.1f\n' % (name, r['iterations'],
+                  r['samples'], r['min'], r['median'], r['max']))
+
+def main():
+   parser = argparse.ArgumentParser(
+            description='Run the kernel benchmark and check for regressions.')
+   parser.add_argument( '--baseline', default='baseline.csv',
+                        help='report to compare against')
+   parser.add_argument( '--threshold', type=float, default=5.0,
+                        help='allowed increase of a median, in percent')
+   parser.add_argument( '--timeout', type=float, default=600.0,
+                        help='seconds the image is allowed to run')
+   parser.add_argument( '--update', action='store_true',
+                        help='store this run as the new baseline')
+   parser.add_argument( '--report-only', action='store_true',
+                        help='print the results without comparing them')
+   parser.add_argument( 'command', nargs=argparse.REMAINDER,
+                        help='command that runs the image')
+   args = parser.parse_args()
+
+   command = args.command
+   if command and command[0] == '--':
+      command = command[1:]
+   if not command:
+      parser.error( 'no command given')
+
+   returnCode, lines = runImage( command, args.timeout)
+   hz, results, order, status = parseReport( lines)
+
+   #----------------------------------------------------------------------------
+   # Images that can exit (the host build) report success through their exit
+   # status instead of '#end'.
+   #----------------------------------------------------------------------------
+   complete = (status == REPORT_END) or (status is None and returnCode == 0)
+
+   if not complete or hz is None or not results:
+      sys.stdout.write( '\n'.join( lines) + '\n')
+      sys.stderr.write( 'benchmark did not complete (%s, exit %s)\n' %
+                        (status, returnCode))
+      return 2
+
+   if args.update:
+      writeBaseline( args.baseline, hz, results, order)
+      sys.stdout.write( 'baseline written to %s\n' % args.baseline)
+
+   baseline = None
+   if not args.update and not args.report_only:
+      baseline = readBaseline( args.baseline)
+      if baseline is None:
+         sys.stderr.write( 'no baseline at %s, run with --update first\n' %
+                           args.baseline)
+         return 2
+
+   baseResults = baseline[1] if baseline else {}
+   limit = 1.0 + args.threshold/100.0
+   failed = []
+
+   sys.stdout.write( '%-16s %10s %10s %10s %8s\n' % ('suite', 'min', 'median',
+                     'baseline', 'change'))
+
+   for name in order:
+      median = results[name]['median']
+      base = baseResults.get( name)
+      if base is None:
+         sys.stdout.write( '%-16s %10.1f %10.1f %10s %8s\n' % (name,
+                           results[name]['min'], median, '-', '-'))
+         continue
+
+      change = 0.0
+      if base['median'] > 0:
+         change = (median/base['median'] - 1.0)*100.0
+      mark = ''
+      if median > base['median']*limit:
+         mark = '  REGRESSED'
+         failed.append( name)
+
+      sys.stdout.write( '%-16s %10.1f %10.1f %10.1f %+7.1f%%%s\n' % (name,
+                        results[name]['min'], median, base['median'], change,
+                        mark))
+
+   #----------------------------------------------------------------------------
+   # A suite that disappeared is treated as a regression.
+   #----------------------------------------------------------------------------
+   for name in baseline[2] if baseline else []:
+      if name not in results:
+         sys.stdout.write( '%-16s %10s %10s %10.1f %8s  MISSING\n' % (name,
+                           '-', '-', baseResults[name]['median'], '-'))
+         failed.append( name)
+
+   sys.stdout.write( 'counter rate %d Hz, cycles per iteration\n' % hz)
+
+   if failed:
+      sys.stderr.write( '%d suite(s) regressed more than %.1f%%: %s\n' %
+                        (len( failed), args.threshold, ', '.join( failed)))
+      return 1
+
+   return 0
+
+if __name__ == '__main__':
+   sys.exit( main())
@@ -0,0 +1,105 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : usr_appInit.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for initializing the arbitros
+ *               scheduler, device drivers, and all user-space threads of the
+ *               simavr kernel benchmark.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "avr_mcu_section.h"
+#include "arb_scheduler.h"
+#include "arb_printf.h"
+#include "usr_simConsole.h"
+#include "usr_kernelBench.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Tells simavr which core and clock to run the image with, and which
+ * register to print as the console.
+ *---------------------------------------------------------------------------*/
+AVR_MCU( F_CPU, "atxmega128a1");
+AVR_MCU_SIMAVR_CONSOLE( &USR_SIM_CONSOLE_REG);
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void usr_driverRegistration( void)
+{
+   /*------------------------------------------------------------------------*
+    * The simulator console stands in for the uart console driver.
+    *------------------------------------------------------------------------*/
+   if( usr_simConsoleInit( 1) < 0)
+      exit(0);
+
+}/*End usr_driverRegistration*/
+
+static void usr_platformInit( void)
+{
+
+   /*------------------------------------------------------------------------*
+    * Register drivers with the kernel here...
+    *------------------------------------------------------------------------*/
+   usr_driverRegistration();
+
+   /*------------------------------------------------------------------------*
+    * Initialize the debug interface, there is no card to log to. The
+    * interactive console is left out so it doesn't interleave its prompt
+    * with the results.
+    *------------------------------------------------------------------------*/
+   if( arb_printfInit( "simConsoleDevice0",
+                       256,
+                       NULL) < 0)
+   {
+      exit(0);
+   }
+
+   /*------------------------------------------------------------------------*
+    * Initialize the scheduler specifically for this application.
+    *------------------------------------------------------------------------*/
+   if( arb_schedulerInit( PRIORITY,
+                          ARB_STACK_512B,
+                          TIMER_7) < 0)
+   {
+      exit(0);
+   }
+
+}/*End usr_platformInit*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+void usr_appInit( void)
+{
+   usr_platformInit();
+
+   if( usr_kernelBenchInit() < 0)
+      exit(1);
+
+}/*End usr_appInit*/
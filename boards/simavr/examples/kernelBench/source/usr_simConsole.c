@@ -0,0 +1,139 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : usr_simConsole.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for the simulator console device.
+ *               simavr doesn't model the xmega USARTs, so the benchmark
+ *               report is written one byte at a time to a general purpose
+ *               register the simulator has been told to watch (see the
+ *               '.mmcu' section in usr_appInit.c).
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "arb_device.h"
+#include "hal_pmic.h"
+#include "usr_simConsole.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static t_error simConsoleOpen( t_DEVHANDLE t_handle);
+
+static int16_t simConsoleRead( t_DEVHANDLE t_handle,
+                               int8_t *pc_buff,
+                               uint16_t s_size);
+
+static int16_t simConsoleWrite( t_DEVHANDLE t_handle,
+                                int8_t *pc_buff,
+                                uint16_t s_size);
+
+static int32_t simConsoleIoctl( t_DEVHANDLE t_handle,
+                                uint16_t s_command,
+                                int32_t  i_arguments);
+
+static t_error simConsoleClose( t_DEVHANDLE t_handle);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static t_deviceOperations gt_simConsoleDevOps =
+{
+    simConsoleOpen,
+    simConsoleRead,
+    simConsoleWrite,
+    simConsoleIoctl,
+    simConsoleClose
+
+};
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static t_error simConsoleOpen( t_DEVHANDLE t_handle)
+{
+   return ARB_PASSED;
+
+}/*End simConsoleOpen*/
+
+static int16_t simConsoleRead( t_DEVHANDLE t_handle,
+                               int8_t *pc_buff,
+                               uint16_t s_size)
+{
+   return 0;
+
+}/*End simConsoleRead*/
+
+static int16_t simConsoleWrite( t_DEVHANDLE t_handle,
+                                int8_t *pc_buff,
+                                uint16_t s_size)
+{
+   uint16_t s_index;
+
+   /*------------------------------------------------------------------------*
+    * simavr builds the line up across writes, so a line from one thread
+    * must not be split by another.
+    *------------------------------------------------------------------------*/
+   HAL_BEGIN_CRITICAL();
+
+   for( s_index = 0; s_index < s_size; s_index++)
+      USR_SIM_CONSOLE_REG = (uint8_t)pc_buff[s_index];
+
+   HAL_END_CRITICAL();
+
+   return (int16_t)s_size;
+
+}/*End simConsoleWrite*/
+
+static int32_t simConsoleIoctl( t_DEVHANDLE t_handle,
+                                uint16_t s_command,
+                                int32_t  i_arguments)
+{
+   return (int32_t)ARB_INVALID_CMD;
+
+}/*End simConsoleIoctl*/
+
+static t_error simConsoleClose( t_DEVHANDLE t_handle)
+{
+   return ARB_PASSED;
+
+}/*End simConsoleClose*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_error usr_simConsoleInit( uint8_t c_majorNum)
+{
+   return arb_registerDevice( "simConsoleDevice0",
+                              arb_createDevId( c_majorNum, 0),
+                              &gt_simConsoleDevOps);
+
+}/*End usr_simConsoleInit*/
@@ -0,0 +1,207 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : simRunner.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : EXPERIMENTAL, this has only been compiled against the
+ *               simavr headers, never run against a simavr core for the
+ *               ATxmega128A1 (mainline simavr doesn't have one).
+ *
+ *               Host program that runs the kernel benchmark image on
+ *               libsimavr in place of the simavr command line tool. It also
+ *               serves the image's cycle counter from the simulator's own
+ *               count, so the report doesn't depend on how well simavr
+ *               emulates the xmega's timers and event system. The image has
+ *               to be built with HAL_SIM_CYCLE_COUNTER (see hal_clocks.h):
+ *               each write to the latch register copies the cycle count,
+ *               low byte first, into the four registers after it.
+ *
+ *                  simRunner [-m mcu] [-f freq] kernelBench.elf
+ *
+ *               The core and clock default to the ones in the image's
+ *               .mmcu section. The console register from the same section
+ *               is printed as usual, and the run ends when the image
+ *               sleeps with interrupts off.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Data addresses of HAL_SIM_CYCLE_LATCH (GPIO_GPIO8) and
+ * HAL_SIM_CYCLE_COUNT (GPIO_GPIO9 to GPIO_GPIOC) on the ATxmega128A1.
+ *---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*
+ * Must match HAL_SIM_CYCLE_LATCH and HAL_SIM_CYCLE_COUNT in hal_clocks.h.
+ * 'avr_register_io_write' only takes data addresses from 0x20 up, on the
+ * mega style cores anything lower is r0-r31 and never reaches a hook.
+ *---------------------------------------------------------------------------*/
+#define SIM_CYCLE_LATCH_ADDR (0x0020)
+#define SIM_CYCLE_COUNT_ADDR (0x0021)
+#define SIM_CYCLE_COUNT_SIZE (4)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void simCycleLatch( struct avr_t *pt_avr,
+                           avr_io_addr_t t_addr,
+                           uint8_t c_value,
+                           void *pv_param);
+static void simUsage( const char *pc_name);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void simCycleLatch( struct avr_t *pt_avr,
+                           avr_io_addr_t t_addr,
+                           uint8_t c_value,
+                           void *pv_param)
+{
+   uint8_t c_byte;
+
+   /*------------------------------------------------------------------------*
+    * The count wraps every 2^32 cycles, the same as the timers do.
+    *------------------------------------------------------------------------*/
+   for( c_byte = 0; c_byte < SIM_CYCLE_COUNT_SIZE; c_byte++)
+   {
+      pt_avr->data[SIM_CYCLE_COUNT_ADDR + c_byte] =
+      (uint8_t)(pt_avr->cycle >> (8*c_byte));
+   }
+
+}/*End simCycleLatch*/
+
+static void simUsage( const char *pc_name)
+{
+   fprintf( stderr, "usage: %s [-m mcu] [-f freq] image.elf\n", pc_name);
+
+}/*End simUsage*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( int argc,
+          char *argv[])
+{
+   elf_firmware_t t_firmware;
+   avr_t *pt_avr;
+   const char *pc_image = NULL;
+   const char *pc_mcu   = NULL;
+   uint32_t i_freq      = 0;
+   int i_arg;
+   int i_state;
+
+   memset( (void *)&t_firmware, 0, sizeof( t_firmware));
+
+   for( i_arg = 1; i_arg < argc; i_arg++)
+   {
+      if( (strcmp( argv[i_arg], "-m") == 0) && (i_arg + 1 < argc))
+      {
+         i_arg++;
+         pc_mcu = argv[i_arg];
+      }
+      else if( (strcmp( argv[i_arg], "-f") == 0) && (i_arg + 1 < argc))
+      {
+         i_arg++;
+         i_freq = (uint32_t)strtoul( argv[i_arg], NULL, 0);
+      }
+      else if( argv[i_arg][0] != '-')
+         pc_image = argv[i_arg];
+      else
+      {
+         simUsage( argv[0]);
+         return 2;
+      }
+
+   }/*End for( i_arg = 1; i_arg < argc; i_arg++)*/
+
+   if( pc_image == NULL)
+   {
+      simUsage( argv[0]);
+      return 2;
+   }
+
+   if( elf_read_firmware( pc_image, &t_firmware) != 0)
+   {
+      fprintf( stderr, "%s: can't read %s\n", argv[0], pc_image);
+      return 2;
+   }
+
+   /*------------------------------------------------------------------------*
+    * The options override what the image's .mmcu section asked for.
+    *------------------------------------------------------------------------*/
+   if( pc_mcu != NULL)
+   {
+      strncpy( t_firmware.mmcu,
+               pc_mcu,
+               sizeof( t_firmware.mmcu) - 1);
+      t_firmware.mmcu[sizeof( t_firmware.mmcu) - 1] = 0;
+   }
+
+   if( i_freq != 0)
+      t_firmware.frequency = i_freq;
+
+   pt_avr = avr_make_mcu_by_name( t_firmware.mmcu);
+   if( pt_avr == NULL)
+   {
+      fprintf( stderr, "%s: simavr doesn't know the core '%s'\n", argv[0],
+      t_firmware.mmcu);
+      return 2;
+   }
+
+   avr_init( pt_avr);
+   avr_load_firmware( pt_avr, &t_firmware);
+
+   avr_register_io_write( pt_avr,
+                          SIM_CYCLE_LATCH_ADDR,
+                          &simCycleLatch,
+                          NULL);
+
+   do
+   {
+      i_state = avr_run( pt_avr);
+
+   }while( (i_state != cpu_Done) && (i_state != cpu_Crashed));
+
+   avr_terminate( pt_avr);
+
+   return (i_state == cpu_Done) ? 0 : 1;
+
+}/*End main*/
@@ -68,6 +68,9 @@
    typedef struct
    {
 
+      /*---------------------------------------------------------------------*
+       * Size of the RX buffer in bytes, rounded up to a power of two.
+       *---------------------------------------------------------------------*/
       uint16_t s_rxBuffSize;
 
       /*---------------------------------------------------------------------*
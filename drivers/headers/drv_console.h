@@ -73,9 +73,20 @@
       CONSOLE_RESET_TERMINAL,
       CONSOLE_SET_BG_COLOR,
       CONSOLE_SET_PROMPT_COLOR,
-      CONSOLE_SET_FG_COLOR
+      CONSOLE_SET_FG_COLOR,
+      CONSOLE_SET_TAB_HANDLER
    }t_consoleCmd;
 
+   /*------------------------------------------------------------------------*
+    * Tab completion callback registered via 'CONSOLE_SET_TAB_HANDLER'. Given
+    * the first 'c_len' characters of the command line, it returns a pointer
+    * to the unique matching command name--stored in program memory--or NULL
+    * if there isn't exactly one match. The callback is executed from the RX
+    * interrupt and therefore must not block.
+    *------------------------------------------------------------------------*/
+   typedef const char *(*t_consoleTabHndlr)( const int8_t *pc_line,
+                                             uint8_t c_len);
+
    typedef enum
    {
       CONSOLE_BLACK   = '0',
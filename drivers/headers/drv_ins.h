@@ -33,7 +33,7 @@
  *                and Paul Bizard
  *             5. Matlab program 'Ellipsoid fit' by Yury Petrov
  *
- * Last Update : September 26, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 #ifndef drv_ins_h
 
@@ -47,8 +47,10 @@
    #define drv_ins_h
 
    /*------------------------------------------------------------------------*
-    * The maximum number of samples gathered during calibration of the
-    * accelerometer and magnetometer.
+    * The number of samples gathered during calibration of the accelerometer
+    * and magnetometer. Each sample is folded into the fit as it arrives so
+    * the RAM used doesn't depend on this value, it must be at least
+    * INS_EF_NUM_COEF.
     *------------------------------------------------------------------------*/
    #define INS_MAX_CAL_SAMPLES (16)
 
@@ -72,7 +72,10 @@
       SD_RMDIR,     /*Remove a directory*/
       SD_RM,        /*Remove a file*/
       SD_CD,        /*Change working directory*/
-      SD_GET_SIZE   /*Get the size of a file*/
+      SD_GET_SIZE,  /*Get the size of a file*/
+      SD_PREALLOC,  /*Allocate contiguous clusters for an empty file*/
+      SD_SYNC,      /*Write cached data and the directory entry to the card*/
+      SD_SEEK       /*Set the file position (in bytes)*/
    }t_sdCmd;
 
    typedef struct
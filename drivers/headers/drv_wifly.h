@@ -22,7 +22,7 @@
  * Description : This driver is responsible for providing a standard API to
  *               the Roving Networks Wifly module.
  *
- * Last Update : July 8, 2013
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 #ifndef drv_wifly_h
 
@@ -100,6 +100,13 @@
        *---------------------------------------------------------------------*/
       uint8_t c_majorNum;
 
+      /*---------------------------------------------------------------------*
+       * The priority of the driver's state machine on the dispatcher thread
+       * (see arb_dispatcher.h), 'arb_dispatcherInit' has to be called before
+       * the driver is loaded.
+       *---------------------------------------------------------------------*/
+      uint8_t c_dspPrio;
+
    }t_wiflySetup;
 
    typedef struct
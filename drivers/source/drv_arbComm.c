@@ -34,7 +34,7 @@
 #include "arb_semaphore.h"
 #include "drv_arbComm.h"
 #include "hal_uart.h"
-#include "utl_buffer.h"
+#include "utl_ring.h"
 #include "hal_pmic.h"
 
 /*---------------------------------------------------------------------------*
@@ -60,9 +60,10 @@ typedef struct
    t_SEMHANDLE t_txMutex;
 
    /*------------------------------------------------------------------------*
-    * Handle to the particular RX buffer this arbComm driver is using.
+    * Ring holding the bytes received by the UART. Filled one byte at a time
+    * from the RX interrupt and drained by 'arbCommRead'.
     *------------------------------------------------------------------------*/
-   t_BUFFHANDLE t_rxBuffer;
+   t_ring t_rxRing;
 
    /*------------------------------------------------------------------------*
     * We are going to want to know how many 'handles' or users are attached to
@@ -126,19 +127,11 @@ static t_arbCommDev gt_arbCommDev;
  *---------------------------------------------------------------------------*/
 static void rxComplete( uint16_t s_byte)
 {
-   uint16_t s_bufferLevel = utl_getBufferFullLevel( gt_arbCommDev.t_rxBuffer);
-   uint16_t s_bufferSize  = utl_getBufferSize( gt_arbCommDev.t_rxBuffer);
-
    /*------------------------------------------------------------------------*
-    * Fill buffer till full...
+    * Fill buffer till full, anything after that is dropped...
     *------------------------------------------------------------------------*/
-   if( s_bufferLevel <= s_bufferSize)
-   {
-
-      utl_writeByte( gt_arbCommDev.t_rxBuffer,
-                     s_byte);
-
-   }/*End if( s_bufferLevel <= s_bufferSize)*/
+   utl_ringWriteByte( &gt_arbCommDev.t_rxRing,
+                      (int8_t)s_byte);
 
 }/*End rxComplete*/
 
@@ -194,7 +187,7 @@ static int16_t arbCommRead( t_DEVHANDLE t_handle,
    arb_wait( gt_arbCommDev.t_rxMutex,
              0);
 
-   s_bufferLevel = utl_getBufferFullLevel( gt_arbCommDev.t_rxBuffer);
+   s_bufferLevel = (int16_t)utl_ringGetFullLevel( &gt_arbCommDev.t_rxRing);
 
    /*------------------------------------------------------------------------*
     * Is there enough data in the buffer?
@@ -209,9 +202,9 @@ static int16_t arbCommRead( t_DEVHANDLE t_handle,
 
    }/*End if( s_size > s_bufferLevel)*/
    
-   utl_readBlock( gt_arbCommDev.t_rxBuffer,
-                  pc_buff,
-                  s_size);
+   utl_ringReadBlock( &gt_arbCommDev.t_rxRing,
+                      pc_buff,
+                      s_size);
 
    /*------------------------------------------------------------------------*
     * Release the lock
@@ -267,7 +260,7 @@ static int32_t arbCommIoctl( t_DEVHANDLE t_handle,
    {
       case ARBCOMM_GET_RX_BUFFER_LEVEL:
 
-         i_return = (int32_t)utl_getBufferFullLevel( gt_arbCommDev.t_rxBuffer);
+         i_return = (int32_t)utl_ringGetFullLevel( &gt_arbCommDev.t_rxRing);
 
       break; /*End case ARBCOMM_GET_RX_BUFFER_LEVEL:*/
 
@@ -329,6 +322,7 @@ t_error drv_arbCommInit( t_arbCommSetup t_setup)
 {
    t_error t_err = ARB_PASSED;
    t_uartConfig t_uConf;
+   uint16_t s_ringSize;
 
    /*------------------------------------------------------------------------*
     * Make sure the kernel is aware that a new device has been loaded.
@@ -390,16 +384,22 @@ t_error drv_arbCommInit( t_arbCommSetup t_setup)
    }
 
    /*------------------------------------------------------------------------*
-    * Allocate RX buffer of size = A*B1, where A = the max number of
-    * possible tokens, B = the size of each token including a terminating
-    * character, and 1 byte for the character that ends the string.
+    * Allocate the RX ring, rounding the requested size up to the next power
+    * of two.
     *------------------------------------------------------------------------*/
-   gt_arbCommDev.t_rxBuffer = utl_createBuffer( t_setup.s_rxBuffSize);
-   if( gt_arbCommDev.t_rxBuffer < 0)
+   s_ringSize = 1;
+   while( (s_ringSize < t_setup.s_rxBuffSize) && (s_ringSize <
+   UTL_RING_MAX_SIZE))
+   {
+      s_ringSize <<= 1;
+   }
+
+   if( utl_createRing( &gt_arbCommDev.t_rxRing,
+                       s_ringSize) < 0)
    {
       t_err = ARB_OUT_OF_HEAP;
       goto failed4;
-   }/*End if( gt_arbCommDev.t_txBuffer < 0)*/
+   }/*End if( utl_createRing( &gt_arbCommDev.t_rxRing,*/
 
    /*------------------------------------------------------------------------*
     * Request a semaphore from the kernel. Since the signal port is a shared
@@ -423,7 +423,7 @@ t_error drv_arbCommInit( t_arbCommSetup t_setup)
 
 failed5:
 
-   utl_destroyBuffer( gt_arbCommDev.t_rxBuffer);
+   utl_destroyRing( &gt_arbCommDev.t_rxRing);
 
 failed4:
 
@@ -452,7 +452,7 @@ void drv_arbCommExit( void)
    if( gt_arbCommDev.t_rxMutex != 0) /*If created... destroy*/
    {
 
-      utl_destroyBuffer( gt_arbCommDev.t_rxBuffer);
+      utl_destroyRing( &gt_arbCommDev.t_rxRing);
       hal_releaseUartChannel( gt_arbCommDev.t_uHandle);
       arb_semaphoreDestroy( gt_arbCommDev.t_rxMutex);
       arb_semaphoreDestroy( gt_arbCommDev.t_txMutex);
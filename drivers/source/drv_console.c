@@ -23,7 +23,7 @@
  *               specific uart designated for use as a console interface. The
  *               function defined herein are callable from 'thread' space.
  *
- * Last Update : Nov 11, 2011
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------*
@@ -43,6 +43,14 @@
  *---------------------------------------------------------------------------*/
 #define CONSOLE_BACKSPACE_CHAR (127)
 #define CONSOLE_RETURN_CHAR    (13)
+#define CONSOLE_TAB_CHAR       (9)
+
+/*---------------------------------------------------------------------------*
+ * RX buffer size = A*B + 1, where A = the max number of possible tokens,
+ * B = the size of each token including a terminating character, and 1 byte
+ * for the character that ends the string.
+ *---------------------------------------------------------------------------*/
+#define CONSOLE_RX_BUFF_SIZE   (CONSOLE_MAX_TOKENS*CONSOLE_MAX_TOKEN_SIZE + 1)
 
 /*---------------------------------------------------------------------------*
  * Private Data Types
@@ -69,9 +77,10 @@ typedef struct
    t_SEMHANDLE t_rxBlockingSem;
 
    /*------------------------------------------------------------------------*
-    * Handle to the particular RX buffer this console driver is using.
+    * The RX buffer this console driver is using, and its storage.
     *------------------------------------------------------------------------*/
-   t_BUFFHANDLE t_rxBuffer;
+   t_buffer t_rxBuffer;
+   int8_t ac_rxStorage[CONSOLE_RX_BUFF_SIZE];
 
    /*------------------------------------------------------------------------*
     * We are going to want to know how many 'handles' or users are attached to
@@ -105,6 +114,12 @@ typedef struct
     *------------------------------------------------------------------------*/
    char ac_dirName[CONSOLE_MAX_TOKEN_SIZE];
 
+   /*------------------------------------------------------------------------*
+    * Callback used for completing the first token on the command line when
+    * the tab key is pressed.
+    *------------------------------------------------------------------------*/
+   t_consoleTabHndlr pf_tabHndlr;
+
 }t_consoleDev;
 
 /*---------------------------------------------------------------------------*
@@ -128,6 +143,9 @@ static t_error consoleClose( t_DEVHANDLE t_handle);
 
 static void rxComplete( uint16_t s_byte);
 
+static void drv_completeCmd( uint16_t s_bufferLevel,
+                             uint16_t s_bufferSize);
+
 static int8_t *drv_strTok( int8_t *pc_in,
                            int8_t *pc_out,
                            int8_t c_delim,
@@ -236,7 +254,7 @@ static t_consoleError drv_parseMessage( int8_t *pc_cbuff,
                                         uint8_t *pc_tokenCount)
 {
    int8_t *pc_nextLoc      = NULL;
-   int8_t c_bytesRemaining = utl_getBufferSize( gt_consoleDev.t_rxBuffer);
+   int8_t c_bytesRemaining = utl_getBufferSize( &gt_consoleDev.t_rxBuffer);
    int8_t c_tokenSize      = 0;
    t_consoleError t_err    = CONSOLE_PASSED;
 
@@ -293,10 +311,75 @@ static t_consoleError drv_parseMessage( int8_t *pc_cbuff,
 
 }/*End usr_parseMessage*/
 
+static void drv_completeCmd( uint16_t s_bufferLevel,
+                             uint16_t s_bufferSize)
+{
+   int8_t *pc_line;
+   const char *pc_name;
+   uint16_t s_index;
+   char c_char;
+
+   if( (gt_consoleDev.pf_tabHndlr == NULL) || (s_bufferLevel == 0) ||
+   (s_bufferLevel >= CONSOLE_MAX_TOKEN_SIZE))
+   {
+      return;
+   }
+
+   /*------------------------------------------------------------------------*
+    * The line being entered must be contiguous in order to be matched
+    * against the command names.
+    *------------------------------------------------------------------------*/
+   if( utl_getBufferReadSpan( &gt_consoleDev.t_rxBuffer,
+                              &pc_line) != s_bufferLevel)
+   {
+      return;
+   }
+
+   /*------------------------------------------------------------------------*
+    * Only the command itself (first token) is completed.
+    *------------------------------------------------------------------------*/
+   for( s_index = 0; s_index < s_bufferLevel; s_index++)
+   {
+      if( pc_line[s_index] == ' ')
+         return;
+   }
+
+   pc_name = gt_consoleDev.pf_tabHndlr( pc_line,
+                                        (uint8_t)s_bufferLevel);
+
+   if( pc_name == NULL)
+      return;
+
+   /*------------------------------------------------------------------------*
+    * Echo and store the remainder of the command name followed by a space,
+    * leaving room for the NULL character.
+    *------------------------------------------------------------------------*/
+   c_char = (char)pgm_read_byte( &pc_name[s_index]);
+   while( (c_char != '\0') && (s_bufferLevel < (s_bufferSize - 2)))
+   {
+      hal_uartWriteByte( gt_consoleDev.t_uHandle,
+                         c_char);
+      utl_writeByte( &gt_consoleDev.t_rxBuffer,
+                     c_char);
+      s_bufferLevel++;
+      s_index++;
+      c_char = (char)pgm_read_byte( &pc_name[s_index]);
+   }
+
+   if( s_bufferLevel < (s_bufferSize - 2))
+   {
+      hal_uartWriteByte( gt_consoleDev.t_uHandle,
+                         ' ');
+      utl_writeByte( &gt_consoleDev.t_rxBuffer,
+                     ' ');
+   }
+
+}/*End drv_completeCmd*/
+
 static void rxComplete( uint16_t s_byte)
 {
-   uint16_t s_bufferLevel = utl_getBufferFullLevel( gt_consoleDev.t_rxBuffer);
-   uint16_t s_bufferSize  = utl_getBufferSize( gt_consoleDev.t_rxBuffer);
+   uint16_t s_bufferLevel = utl_getBufferFullLevel( &gt_consoleDev.t_rxBuffer);
+   uint16_t s_bufferSize  = utl_getBufferSize( &gt_consoleDev.t_rxBuffer);
 
    gt_consoleDev.b_rxActive = true;
 
@@ -315,7 +398,7 @@ static void rxComplete( uint16_t s_byte)
       /*---------------------------------------------------------------------*
        * Remove the last byte in the buffer...
        *---------------------------------------------------------------------*/
-      utl_buffEraseTailByte( gt_consoleDev.t_rxBuffer);
+      utl_buffEraseTailByte( &gt_consoleDev.t_rxBuffer);
 
    }/*End if( (s_byte == CONSOLE_BACKSPACE_CHAR) && (s_bufferLevel > 0))*/
    else if( s_byte == CONSOLE_RETURN_CHAR)
@@ -344,7 +427,7 @@ static void rxComplete( uint16_t s_byte)
        * Add a the NULL character to the end of the buffer - this is for
        * data parsing purposes only.
        *------------------------------------------------------------------*/
-      utl_writeByte( gt_consoleDev.t_rxBuffer,
+      utl_writeByte( &gt_consoleDev.t_rxBuffer,
                      '\0');
 
       /*------------------------------------------------------------------*
@@ -355,6 +438,11 @@ static void rxComplete( uint16_t s_byte)
 
 
    }/*End else if( c_byte == CONSOLE_BACKSPACE_CHAR)*/
+   else if( s_byte == CONSOLE_TAB_CHAR)
+   {
+      drv_completeCmd( s_bufferLevel,
+                       s_bufferSize);
+   }/*End else if( s_byte == CONSOLE_TAB_CHAR)*/
    else if( (s_bufferLevel < (s_bufferSize - 1)) && (s_byte !=
    CONSOLE_BACKSPACE_CHAR) && (s_byte != 27)) /*Leave room for NULL char*/
    {
@@ -369,7 +457,7 @@ static void rxComplete( uint16_t s_byte)
        * Fill RX buffer with received bytes until the buffer is full
        * leaving room for the insertion of the NULL character.
        *---------------------------------------------------------------------*/
-      utl_writeByte( gt_consoleDev.t_rxBuffer,
+      utl_writeByte( &gt_consoleDev.t_rxBuffer,
                      s_byte);
 
    }
@@ -437,14 +525,14 @@ static int16_t consoleRead( t_DEVHANDLE t_handle,
    /*------------------------------------------------------------------------*
     * Level plus an extra NULL character.
     *------------------------------------------------------------------------*/
-   s_bufferLevel = utl_getBufferFullLevel( gt_consoleDev.t_rxBuffer);
+   s_bufferLevel = utl_getBufferFullLevel( &gt_consoleDev.t_rxBuffer);
 
    /*------------------------------------------------------------------------*
     * Can the user-space buffer hold all the data plus the NULL character?
     *------------------------------------------------------------------------*/
    if( s_bufferLevel > s_size)
    {
-      ult_resetBuffer( gt_consoleDev.t_rxBuffer);
+      utl_resetBuffer( &gt_consoleDev.t_rxBuffer);
 
       hal_enableUartRxInt( gt_consoleDev.t_uHandle);
 
@@ -456,7 +544,7 @@ static int16_t consoleRead( t_DEVHANDLE t_handle,
 
    }/*End if( s_bufferLevel > s_size)*/
 
-   utl_readBlock( gt_consoleDev.t_rxBuffer,
+   utl_readBlock( &gt_consoleDev.t_rxBuffer,
                   pc_buff,
                   s_bufferLevel);
 
@@ -465,7 +553,7 @@ static int16_t consoleRead( t_DEVHANDLE t_handle,
     * command 'CONSOLE_PARSE_CMD_LINE') we need to reset the pointers each
     * time we read its contents.
     *------------------------------------------------------------------------*/
-   ult_resetBuffer( gt_consoleDev.t_rxBuffer);
+   utl_resetBuffer( &gt_consoleDev.t_rxBuffer);
 
    hal_enableUartRxInt( gt_consoleDev.t_uHandle);
 
@@ -519,7 +607,7 @@ static int32_t consoleIoctl( t_DEVHANDLE t_handle,
    {
       case CONSOLE_GET_RX_BUFFER_SIZE:
 
-         i_return = (int32_t)utl_getBufferSize( gt_consoleDev.t_rxBuffer);
+         i_return = (int32_t)utl_getBufferSize( &gt_consoleDev.t_rxBuffer);
 
       break;/*End case CONSOLE_GET_RX_BUFFER_SIZE:*/
 
@@ -544,7 +632,7 @@ static int32_t consoleIoctl( t_DEVHANDLE t_handle,
          /*------------------------------------------------------------------*
           * Grab pointer to the user-space token variable...
           *------------------------------------------------------------------*/
-         pt_tokens = (t_consoleTokHndl *)((uint16_t)i_arguments);
+         pt_tokens = (t_consoleTokHndl *)((uintptr_t)i_arguments);
 
          /*------------------------------------------------------------------*
           * Wait for data to be available in the RX buffer.
@@ -553,9 +641,10 @@ static int32_t consoleIoctl( t_DEVHANDLE t_handle,
                    0);
 
          /*------------------------------------------------------------------*
-          * Get the head location of the RX buffer...
+          * Get the location of the received line...
           *------------------------------------------------------------------*/
-         pc_rxBuffPtr = utl_getBufferPtr( gt_consoleDev.t_rxBuffer);
+         utl_getBufferReadSpan( &gt_consoleDev.t_rxBuffer,
+                                &pc_rxBuffPtr);
 
          /*------------------------------------------------------------------*
           * Parse the string into tokens represented by...
@@ -571,7 +660,7 @@ static int32_t consoleIoctl( t_DEVHANDLE t_handle,
           * command 'CONSOLE_PARSE_CMD_LINE') we need to reset the pointers
           * each time we read its contents.
           *------------------------------------------------------------------*/
-         ult_resetBuffer( gt_consoleDev.t_rxBuffer);
+         utl_resetBuffer( &gt_consoleDev.t_rxBuffer);
 
          hal_enableUartRxInt( gt_consoleDev.t_uHandle);
 
@@ -618,7 +707,7 @@ static int32_t consoleIoctl( t_DEVHANDLE t_handle,
          arb_wait( gt_consoleDev.t_txMutex,
                    0);
 
-         char *pc_name = (char *)((uint16_t)i_arguments);
+         char *pc_name = (char *)((uintptr_t)i_arguments);
          sprintf( gt_consoleDev.ac_dirName, "%s", pc_name);
 
          /*------------------------------------------------------------------*
@@ -734,6 +823,20 @@ static int32_t consoleIoctl( t_DEVHANDLE t_handle,
 
       break;/*End case CONSOLE_SET_FG_COLOR:*/
 
+      case CONSOLE_SET_TAB_HANDLER:
+
+      {
+         /*------------------------------------------------------------------*
+          * The handler is called from the RX interrupt, so update it
+          * atomically.
+          *------------------------------------------------------------------*/
+         HAL_BEGIN_CRITICAL();
+         gt_consoleDev.pf_tabHndlr = (t_consoleTabHndlr)((uintptr_t)i_arguments);
+         HAL_END_CRITICAL();
+      }
+
+      break;/*End case CONSOLE_SET_TAB_HANDLER:*/
+
       default:
 
          i_return = (int32_t)CONSOLE_INVALID_CMD;
@@ -866,17 +969,15 @@ t_error drv_consoleInit( t_consoleSetup t_setup)
    }
 
    /*------------------------------------------------------------------------*
-    * Allocate RX buffer of size = A*B1, where A = the max number of
-    * possible tokens, B = the size of each token including a terminating
-    * character, and 1 byte for the character that ends the string.
+    * Attach the RX buffer to its storage.
     *------------------------------------------------------------------------*/
-   gt_consoleDev.t_rxBuffer = utl_createBuffer( CONSOLE_MAX_TOKENS*
-   CONSOLE_MAX_TOKEN_SIZE + 1);
-   if( gt_consoleDev.t_rxBuffer < 0)
+   if( utl_initBuffer( &gt_consoleDev.t_rxBuffer,
+                       gt_consoleDev.ac_rxStorage,
+                       CONSOLE_RX_BUFF_SIZE) < 0)
    {
-      t_err = ARB_OUT_OF_HEAP;
+      t_err = ARB_NULL_PTR;
       goto failed5;
-   }/*End if( gt_consoleDev.t_txBuffer < 0)*/
+   }
 
    /*------------------------------------------------------------------------*
     * Request a semaphore from the kernel. Since the signal port is a shared
@@ -914,11 +1015,13 @@ t_error drv_consoleInit( t_consoleSetup t_setup)
     *------------------------------------------------------------------------*/
    sprintf( gt_consoleDev.ac_dirName, "/");
 
+   gt_consoleDev.pf_tabHndlr = NULL;
+
    return ARB_PASSED;
 
 failed6:
 
-   utl_destroyBuffer( gt_consoleDev.t_rxBuffer);
+   utl_destroyBuffer( &gt_consoleDev.t_rxBuffer);
 
 failed5:
 
@@ -951,7 +1054,7 @@ void drv_consoleExit( void)
    if( gt_consoleDev.t_rxMutex != 0) /*If created... destroy*/
    {
 
-      utl_destroyBuffer( gt_consoleDev.t_rxBuffer);
+      utl_destroyBuffer( &gt_consoleDev.t_rxBuffer);
       hal_releaseUartChannel( gt_consoleDev.t_uHandle);
       arb_semaphoreDestroy( gt_consoleDev.t_rxBlockingSem);
       arb_semaphoreDestroy( gt_consoleDev.t_rxMutex);
@@ -33,7 +33,7 @@
  *                and Paul Bizard
  *             5. Matlab program 'Ellipsoid fit' by Yury Petrov
  *
- * Last Update : September 26, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------*
@@ -51,6 +51,7 @@
 #include "arb_printf.h"
 #include "arb_sysTimer.h"
 #include "utl_math.h"
+#include "utl_fxdMat.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
@@ -145,6 +146,24 @@
  *---------------------------------------------------------------------------*/
 #define INS_KALMAN_LOSS_LOCK_COUNT (64)
 
+/*---------------------------------------------------------------------------*
+ * Layout of the ellipsoid fit scratch buffer. D'*D (packed) and D'*Y are
+ * accumulated one sample at a time while calibrating and are solved in place
+ * for v. The rest of the fit reuses the buffer from the start once v has
+ * been read, INS_EF_FIT_SIZE covers its intermediate matrices.
+ *---------------------------------------------------------------------------*/
+#define INS_EF_DTD_OFFSET (0)
+#define INS_EF_DTY_OFFSET (INS_EF_DTD_OFFSET + \
+                           UTL_MATH_PACKED_SIZE( INS_EF_NUM_COEF))
+#define INS_EF_ACCUM_SIZE (INS_EF_DTY_OFFSET + INS_EF_NUM_COEF)
+#define INS_EF_FIT_SIZE   (16+3+9+9+9+16+16+16+16)
+#define INS_EF_SCRATCH_SIZE ((INS_EF_ACCUM_SIZE > INS_EF_FIT_SIZE) ? \
+                             INS_EF_ACCUM_SIZE : INS_EF_FIT_SIZE)
+
+#if (INS_MAX_CAL_SAMPLES < INS_EF_NUM_COEF)
+   #error "INS_MAX_CAL_SAMPLES too small for the ellipsoid fit."
+#endif
+
 /*---------------------------------------------------------------------------*
  * Private Data types
  *---------------------------------------------------------------------------*/
@@ -328,13 +347,12 @@ typedef struct
     * Area of memory needed in order to perform the ellipsoid fitting routine
     * during calibration.
     *------------------------------------------------------------------------*/
-   float gaf_scratchBuf[(INS_MAX_CAL_SAMPLES*INS_EF_NUM_COEF*2) + \
-   (INS_EF_NUM_COEF*INS_EF_NUM_COEF)];
+   float gaf_scratchBuf[INS_EF_SCRATCH_SIZE];
 
    /*------------------------------------------------------------------------*
-    * Variable that keeps track of the current location in gas_H.
+    * Number of samples folded into the ellipsoid fit so far.
     *------------------------------------------------------------------------*/
-   int8_t c_HWrtPtr;
+   uint16_t s_calSamples;
 
    /*------------------------------------------------------------------------*
     * The error-state Kalman Filter error covariance matrix.
@@ -416,6 +434,10 @@ static int32_t insIoctl( t_DEVHANDLE t_handle,
 
 static t_error insClose( t_DEVHANDLE t_handle);
 
+static void ellipsoidFitReset( void);
+
+static void ellipsoidFitAccum( int16_t *ps_xyz);
+
 static bool ellipsoidFit( int16_t *ps_R,
                           int16_t *ps_bias,
                           int16_t *ps_scale,
@@ -455,13 +477,25 @@ static uint8_t gc_debugUpdateCount = 0;
 static t_insDev gt_insDev;
 
 /*---------------------------------------------------------------------------*
- * Storage location for the samples gathered during calibration.
+ * Inline Function Definitions
  *---------------------------------------------------------------------------*/
-static int16_t gas_H[INS_MAX_CAL_SAMPLES][3];
 
 /*---------------------------------------------------------------------------*
- * Inline Function Definitions
+ * Fixed-point matrix kernels used by the Kalman filter and the DCM updates,
+ * see utl_fxdMat.h. Arguments are the rows, inner and column dimensions, the
+ * Q format of each input and the result, and the overflow headroom.
  *---------------------------------------------------------------------------*/
+UTL_FXD_MAT_MULT( insMatMultPhiP, 9, 9, 9, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT_TRANS_B( insMatMultPhiPPhiT, 9, 9, 9, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT_TRANS_B( insMatMultPHT, 9, 3, 3, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT( insMatMultHPHT, 3, 3, 3, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT( insMatMultK, 9, 3, 3, 15, 10, 15, 0)
+UTL_FXD_MAT_MULT( insMatMultAttCorr, 3, 3, 1, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT( insMatMultGyroCorr, 3, 3, 1, 15, 15, 15, 0)
+UTL_FXD_MAT_MULT( insMatMultKH, 9, 3, 3, 15, 15, 15, 0)
+UTL_FXD_MAT_MULT( insMatMultEyeMinusKHP, 9, 9, 9, 15, 15, 15, 2)
+UTL_FXD_MAT_MULT( insMatMultDcm, 3, 3, 3, 14, 14, 14, 0)
+
 
 /*---------------------------------------------------------------------------*
  * Private Function Definitions
@@ -580,6 +614,57 @@ static inline void getAccelMeas( int16_t *ps_xyz)
 
 }/*End getAccelMeas*/
 
+static void ellipsoidFitReset( void)
+{
+   memset( (void *)&gt_insDev.gaf_scratchBuf[INS_EF_DTD_OFFSET],
+           0,
+           sizeof( float)*INS_EF_ACCUM_SIZE);
+
+   gt_insDev.s_calSamples = 0;
+
+}/*End ellipsoidFitReset*/
+
+static void ellipsoidFitAccum( int16_t *ps_xyz)
+{
+   float af_d[INS_EF_NUM_COEF];
+   float *pf_DTY;
+   float f_x = (float)ps_xyz[0];
+   float f_y = (float)ps_xyz[1];
+   float f_z = (float)ps_xyz[2];
+   int32_t i_c;
+
+   /*------------------------------------------------------------------------*
+    * One row of the design matrix D according to the general form Ax^2 +
+    * By^2 + Cz^2 + 2Dxy + 2Exz + 2Fyz + 2Gx + 2Hy + 2Iz = Y. See line 61 in
+    * the matlab function ellipsoid_fit for further details. Where the
+    * D = [x^2 y^2 z^2 2xy 2xz 2yz 2x 2y 2z] and the 9 coefficients V = [A B C
+    * D E F G H I].
+    *------------------------------------------------------------------------*/
+   af_d[0] = f_x*f_x;   /*x*x*/
+   af_d[1] = f_y*f_y;   /*y*y*/
+   af_d[2] = f_z*f_z;   /*z*z*/
+   af_d[3] = 2*f_x*f_y; /*2*x*y*/
+   af_d[4] = 2*f_x*f_z; /*2*x*z*/
+   af_d[5] = 2*f_y*f_z; /*2*y*z*/
+   af_d[6] = 2*f_x;     /*2*x*/
+   af_d[7] = 2*f_y;     /*2*y*/
+   af_d[8] = 2*f_z;     /*2*z*/
+
+   /*------------------------------------------------------------------------*
+    * D'*D += d'*d (packed) and D'*Y += d' since Y is all ones.
+    *------------------------------------------------------------------------*/
+   utl_matSprF( af_d,
+                INS_EF_NUM_COEF,
+                &gt_insDev.gaf_scratchBuf[INS_EF_DTD_OFFSET]);
+
+   pf_DTY = &gt_insDev.gaf_scratchBuf[INS_EF_DTY_OFFSET];
+   for( i_c = 0; i_c < INS_EF_NUM_COEF; i_c++)
+      pf_DTY[i_c] += af_d[i_c];
+
+   gt_insDev.s_calSamples++;
+
+}/*End ellipsoidFitAccum*/
+
 static bool ellipsoidFit( int16_t *ps_R,
                           int16_t *ps_bias,
                           int16_t *ps_scale,
@@ -588,11 +673,8 @@ static bool ellipsoidFit( int16_t *ps_R,
    int32_t i_r = 0;
    int32_t i_c = 0;
    bool b_passed = false;
-   float f_sum      = 0.0;
    float *pf_A      = NULL;
    float *pf_v      = NULL;
-   float *pf_D      = NULL;
-   float *pf_DTrans = NULL;
    float *pf_temp1  = NULL;
    float *pf_temp2  = NULL;
    float *pf_temp3  = NULL;
@@ -619,84 +701,27 @@ static bool ellipsoidFit( int16_t *ps_R,
     * further details...
     *------------------------------------------------------------------------*/
 
-   /*------------------------------------------------------------------------*
-    * Form the design matrix D according to the general form Ax^2 + By^2 +
-    * Cz^2 + 2Dxy + 2Exz + 2Fyz + 2Gx + 2Hy + 2Iz = Y. See line 61 in the
-    * matlab function ellipsoid_fit for further details. Where the
-    * D = [x^2 y^2 z^2 2xy 2xz 2yz 2x 2y 2z] and the 9 coefficients V = [A B C
-    * D E F G H I].
-    *------------------------------------------------------------------------*/
-   pf_D = &gt_insDev.gaf_scratchBuf[0];
-   for( i_r = 0; i_r < INS_MAX_CAL_SAMPLES; i_r++)
-   {
-      (*(pf_D + i_r*9 + 0)) = (float)gas_H[i_r][0]*
-      (float)gas_H[i_r][0]; /*x*x*/
-      (*(pf_D + i_r*9 + 1)) = (float)gas_H[i_r][1]*
-      (float)gas_H[i_r][1]; /*y*y*/
-      (*(pf_D + i_r*9 + 2)) = (float)gas_H[i_r][2]*
-      (float)gas_H[i_r][2]; /*z*z*/
-      (*(pf_D + i_r*9 + 3)) = 2*(float)gas_H[i_r][0]*
-      (float)gas_H[i_r][1]; /*2*x*y*/
-      (*(pf_D + i_r*9 + 4)) = 2*(float)gas_H[i_r][0]*
-      (float)gas_H[i_r][2]; /*2*x*z*/
-      (*(pf_D + i_r*9 + 5)) = 2*(float)gas_H[i_r][1]*
-      (float)gas_H[i_r][2]; /*2*y*z*/
-      (*(pf_D + i_r*9 + 6)) = 2*(float)gas_H[i_r][0]; /*2*x*/
-      (*(pf_D + i_r*9 + 7)) = 2*(float)gas_H[i_r][1]; /*2*y*/
-      (*(pf_D + i_r*9 + 8)) = 2*(float)gas_H[i_r][2]; /*2*z*/
-
-   }/*End for( i_r = 0; i_r < INS_MAX_CAL_SAMPLES; i_r++)*/
+   if( gt_insDev.s_calSamples < INS_EF_NUM_COEF)
+      return false;
 
    /*------------------------------------------------------------------------*
     * The ellipse can be represented by the equation DV = Y where Y represents
     * the magnitude we want the ellipse to have. Solving for v =
     * (( D' * D )^-1)*( D' * ones( INS_MAX_CAL_SAMPLES, 1 ) )...line 109 in the
-    * matlab function ellipsoid_fit.
-    *------------------------------------------------------------------------*/
-   pf_DTrans = &gt_insDev.gaf_scratchBuf[INS_MAX_CAL_SAMPLES*9]; /*D' - 9 x INS_MAX_CAL_SAMPLES matrix*/
-   utl_matTransF( pf_D,
-                  pf_DTrans,
-                  INS_MAX_CAL_SAMPLES,
-                  9);
-
-   pf_temp1  = &gt_insDev.gaf_scratchBuf[(INS_MAX_CAL_SAMPLES*9)*2]; /*(D'*D) - 9 x 9 matrix*/
-   utl_matMultF( pf_DTrans,
-                 9,
-                 INS_MAX_CAL_SAMPLES,
-                 pf_D,
-                 INS_MAX_CAL_SAMPLES,
-                 9,
-                 pf_temp1);
-
-   pf_temp2 = &gt_insDev.gaf_scratchBuf[0]; /*D'*Y - 9 x 1 matrix*/
-   for( i_r = 0; i_r < 9; i_r++)
-   {
-      f_sum = 0;
-      for( i_c = 0; i_c < INS_MAX_CAL_SAMPLES; i_c++)
-      {
-         f_sum += (*(pf_DTrans + i_r*INS_MAX_CAL_SAMPLES + i_c));
-
-      }/*End for( i_c = 0; i_c < INS_MAX_CAL_SAMPLES; i_c++)*/
-
-     pf_temp2[i_r] = f_sum;
-
-   }/*End for( i_r = 0; i_r < 9; i_r++)*/
-
-   pf_temp3 = &gt_insDev.gaf_scratchBuf[9]; /*(D'*D)^-1 - 9 x 9 matrix*/
-   b_passed = utl_matInvF( pf_temp1,
-                           pf_temp3,
-                           9);
+    * matlab function ellipsoid_fit. D'*D and D'*Y have been accumulated by
+    * 'ellipsoidFitAccum', D'*D is symmetric positive definite so rather than
+    * inverting it, factor it and solve for v in place of D'*Y.
+    *------------------------------------------------------------------------*/
+   pf_temp1 = &gt_insDev.gaf_scratchBuf[INS_EF_DTD_OFFSET]; /*(D'*D) - packed 9 x 9 matrix*/
+   b_passed = utl_matCholF( pf_temp1,
+                            9);
 
-   if( b_passed == true)/*Is the matrix invertible?*/
+   if( b_passed == true)/*Is the matrix positive definite?*/
    {
-      pf_v = &gt_insDev.gaf_scratchBuf[9 + 9*9]; /* (D'*D)^-1*D'*Y - 9 x 1 matrix*/
-      utl_matMultF( pf_temp3,
-                    9,
-                    9,
-                    pf_temp2,
-                    9,
-                    1,
-                    pf_v);
+      pf_v = &gt_insDev.gaf_scratchBuf[INS_EF_DTY_OFFSET]; /* (D'*D)^-1*D'*Y - 9 x 1 matrix*/
+      utl_matCholSolveF( pf_temp1,
+                         9,
+                         pf_v);
 
       /*---------------------------------------------------------------------*
        * Form the algebraic form of the ellipsoid... line 114 in the matlab
@@ -739,43 +764,39 @@ static bool ellipsoidFit( int16_t *ps_R,
          for( i_c = 0; i_c < 3; i_c++)
             (*(pf_temp2 + i_r*3 + i_c)) = -(*(pf_A + i_r*4 + i_c));
 
-      pf_temp3 = &gt_insDev.gaf_scratchBuf[16+3+9]; /* -A( 1:3, 1:3 )' - 3 x 3 matrix*/
-      utl_matTransF( pf_temp2,
-                     pf_temp3,
-                     3,
-                     3);
+      pf_temp3 = &gt_insDev.gaf_scratchBuf[16+3+9]; /* -A( 1:3, 1:3 )'*v( 7:9 ) - 3 x 1 matrix*/
+      utl_matMultTransAF( pf_temp2,
+                          3,
+                          3,
+                          pf_temp1,
+                          3,
+                          1,
+                          pf_temp3);
 
       pf_temp4 = &gt_insDev.gaf_scratchBuf[16+3+9+9]; /* -A( 1:3, 1:3 )'*-A( 1:3, 1:3 ) -
                                             3 x 3 matrix*/
-      utl_matMultF( pf_temp3,
-                    3,
+      utl_matSyrkF( pf_temp2,
                     3,
-                    pf_temp2,
                     3,
+                    pf_temp4,
+                    true);
+
+      utl_matPackF( pf_temp4,
                     3,
                     pf_temp4);
 
-      b_passed = utl_matInvF( pf_temp4,
-                              pf_temp2,
-                              3);
+      b_passed = utl_matCholF( pf_temp4,
+                               3);
 
       if( b_passed == true)
       {
-         utl_matMultF( pf_temp3,
-                       3,
-                       3,
-                       pf_temp1,
-                       3,
-                       1,
-                       pf_temp4);
-
-         utl_matMultF( pf_temp2,
-                       3,
-                       3,
-                       pf_temp4,
-                       3,
-                       1,
-                       af_bias);
+         utl_matCholSolveF( pf_temp4,
+                            3,
+                            pf_temp3);
+
+         af_bias[0] = pf_temp3[0];
+         af_bias[1] = pf_temp3[1];
+         af_bias[2] = pf_temp3[2];
 
          /*------------------------------------------------------------------*
           * End find ellipsoid center.
@@ -1035,7 +1056,6 @@ static inline void eSKalmanFilterPredict( int32_t *pi_gyr,
    int16_t as_Q[9]; /*attitude, gyro bias, gyro scale*/
    int16_t as_phi[9][9];
    int16_t as_tmp[9][9];
-   int16_t as_tmp2[9][9];
    int8_t c_index;
    int32_t i_temp;
 
@@ -1092,33 +1112,16 @@ static inline void eSKalmanFilterPredict( int32_t *pi_gyr,
    /*------------------------------------------------------------------------*
     * phi*P
     *------------------------------------------------------------------------*/
-   utl_matMult16x16_16( &as_phi[0][0],
-                        9,
-                        9,
-                        &gt_insDev.as_P[0][0],
-                        9,
-                        9,
-                        &as_tmp[0][0],
-                        1,
-                        15);
-
-   utl_matTrans16( &as_phi[0][0],
-                   &as_tmp2[0][0],
-                   9,
-                   9);
+   insMatMultPhiP( &as_phi[0][0],
+                   &gt_insDev.as_P[0][0],
+                   &as_tmp[0][0]);
 
    /*------------------------------------------------------------------------*
-    * phi*P*phi'
+    * phi*P*phi', phi is stored by rows so the transpose is never formed
     *------------------------------------------------------------------------*/
-   utl_matMult16x16_16( &as_tmp[0][0],
-                        9,
-                        9,
-                        &as_tmp2[0][0],
-                        9,
-                        9,
-                        &gt_insDev.as_P[0][0],
-                        1,
-                        15);
+   insMatMultPhiPPhiT( &as_tmp[0][0],
+                       &as_phi[0][0],
+                       &gt_insDev.as_P[0][0]);
 
    /*------------------------------------------------------------------------*
     * P = phi*P*phi' + Q
@@ -1148,14 +1151,11 @@ static inline void eSKalmanFilterCorrect( int16_t *ps_deltaZ,
    int32_t ai_R[3]; /*Measurement noise where as_R[0] = gravity x noise,
                       R[1] = gravity y noise, and R[2] = mag y noise*/
    int16_t as_H00[3][3];
-   int16_t as_H00T[3][3];
    int16_t as_tmp[3][3];
-   int16_t as_tmp1[3][3];
-   int16_t as_tmp2[3][3];
-   int16_t as_tmp3[3][3];
-   int16_t as_K00[3][3];
-   int16_t as_K10[3][3];
-   int16_t as_K20[3][3];
+   int16_t as_P0[9][3];  /*P( :, 1:3 )*/
+   int16_t as_PHT[9][3]; /*| PHT00; PHT10; PHT20 |*/
+   int16_t as_K[9][3];   /*| K00; K10; K20 |*/
+   int16_t as_KH[9][3];  /*| K00*H00; K10*H00; K20*H00 |*/
    int16_t as_eyeMinusKH[9][9];
    int16_t as_tmpP[9][9];
    int32_t ai_T[3];
@@ -1215,102 +1215,30 @@ static inline void eSKalmanFilterCorrect( int16_t *ps_deltaZ,
    as_H00[2][1] = 0;
    as_H00[2][2] = -32768;
 
-   /*------------------------------------------------------------------------*
-    * Compute H'
-    *------------------------------------------------------------------------*/
-   as_H00T[0][0] = 0;
-   as_H00T[0][1] = 32767;
-   as_H00T[0][2] = 0;
-   as_H00T[1][0] = -32768;
-   as_H00T[1][1] = 0;
-   as_H00T[1][2] = 0;
-   as_H00T[2][0] = 0;
-   as_H00T[2][1] = 0;
-   as_H00T[2][2] = -32768;
-
-   utl_matTrans16( &as_H00[0][0],
-                   &as_H00T[0][0],
-                   3,
-                   3);
-
-   as_tmp[0][0] = gt_insDev.as_P[0][0];
-   as_tmp[0][1] = gt_insDev.as_P[0][1];
-   as_tmp[0][2] = gt_insDev.as_P[0][2];
-   as_tmp[1][0] = gt_insDev.as_P[1][0];
-   as_tmp[1][1] = gt_insDev.as_P[1][1];
-   as_tmp[1][2] = gt_insDev.as_P[1][2];
-   as_tmp[2][0] = gt_insDev.as_P[2][0];
-   as_tmp[2][1] = gt_insDev.as_P[2][1];
-   as_tmp[2][2] = gt_insDev.as_P[2][2];
-
    /*------------------------------------------------------------------------*
     *                | PHT00 |
     * Perform P*H' = | PHT10 |  where PHT00 through PHT20 are 3x3 matrix'
     *                | PHT20 |  this operation is simplified due to the fact
-    * that the first 3x3 matrix of H' is the only non-zero matrix.
-    *------------------------------------------------------------------------*/
-   utl_matMult16x16_16( &as_tmp[0][0],
-                        3,
-                        3,
-                        &as_H00T[0][0],
-                        3,
-                        3,
-                        &as_tmp1[0][0],
-                        1,
-                        15);
-
-   as_tmp[0][0] = gt_insDev.as_P[3][0];
-   as_tmp[0][1] = gt_insDev.as_P[3][1];
-   as_tmp[0][2] = gt_insDev.as_P[3][2];
-   as_tmp[1][0] = gt_insDev.as_P[4][0];
-   as_tmp[1][1] = gt_insDev.as_P[4][1];
-   as_tmp[1][2] = gt_insDev.as_P[4][2];
-   as_tmp[2][0] = gt_insDev.as_P[5][0];
-   as_tmp[2][1] = gt_insDev.as_P[5][1];
-   as_tmp[2][2] = gt_insDev.as_P[5][2];
-
-   utl_matMult16x16_16( &as_tmp[0][0],
-                        3,
-                        3,
-                        &as_H00T[0][0],
-                        3,
-                        3,
-                        &as_tmp2[0][0],
-                        1,
-                        15);
-
-   as_tmp[0][0] = gt_insDev.as_P[6][0];
-   as_tmp[0][1] = gt_insDev.as_P[6][1];
-   as_tmp[0][2] = gt_insDev.as_P[6][2];
-   as_tmp[1][0] = gt_insDev.as_P[7][0];
-   as_tmp[1][1] = gt_insDev.as_P[7][1];
-   as_tmp[1][2] = gt_insDev.as_P[7][2];
-   as_tmp[2][0] = gt_insDev.as_P[8][0];
-   as_tmp[2][1] = gt_insDev.as_P[8][1];
-   as_tmp[2][2] = gt_insDev.as_P[8][2];
-
-   utl_matMult16x16_16( &as_tmp[0][0],
-                        3,
-                        3,
-                        &as_H00T[0][0],
-                        3,
-                        3,
-                        &as_tmp3[0][0],
-                        1,
-                        15);
+    * that the first 3x3 matrix of H' is the only non-zero matrix. H00 is
+    * stored by rows so H00' is never formed.
+    *------------------------------------------------------------------------*/
+   for( c_index = 0; c_index < 9; c_index++)
+   {
+      as_P0[c_index][0] = gt_insDev.as_P[c_index][0];
+      as_P0[c_index][1] = gt_insDev.as_P[c_index][1];
+      as_P0[c_index][2] = gt_insDev.as_P[c_index][2];
+   }
+
+   insMatMultPHT( &as_P0[0][0],
+                  &as_H00[0][0],
+                  &as_PHT[0][0]);
 
    /*------------------------------------------------------------------------*
     * Compute H*P*H'
     *------------------------------------------------------------------------*/
-   utl_matMult16x16_16( &as_H00[0][0],
-                        3,
-                        3,
-                        &as_tmp1[0][0],
-                        3,
-                        3,
-                        &as_tmp[0][0],
-                        1,
-                        15);
+   insMatMultHPHT( &as_H00[0][0],
+                   &as_PHT[0][0],
+                   &as_tmp[0][0]);
 
    /*------------------------------------------------------------------------*
     * Compute H*P*H' + R
@@ -1349,168 +1277,51 @@ static inline void eSKalmanFilterCorrect( int16_t *ps_deltaZ,
     * K = (P*H')/(H*P*H'+ R)
     * [1] eq 3.15
     *------------------------------------------------------------------------*/
-   utl_matMult16x16_16( &as_tmp1[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_tmp[0][0],  /*Q10*/
-                        3,
-                        3,
-                        &as_K00[0][0],  /*Q15*/
-                        0,
-                        10);
-
-   utl_matMult16x16_16( &as_tmp2[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_tmp[0][0],  /*Q10*/
-                        3,
-                        3,
-                        &as_K10[0][0],  /*Q15*/
-                        0,
-                        10);
-
-   utl_matMult16x16_16( &as_tmp3[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_tmp[0][0],  /*Q10*/
-                        3,
-                        3,
-                        &as_K20[0][0],  /*Q15*/
-                        0,
-                        10);
+   insMatMultK( &as_PHT[0][0], /*Q15*/
+                &as_tmp[0][0], /*Q10*/
+                &as_K[0][0]);  /*Q15*/
 
    /*------------------------------------------------------------------------*
     * Update the state vector estimate ignoring the previous xk term
     * since this is an error-state Kalman filter
     * [1] eq 3.16 and section 3.2.6
     *------------------------------------------------------------------------*/
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K00[0][0], ps_deltaZ[0], i_tmp, 1);
-   i_tmp = utl_mac16x16_32( as_K00[0][1], ps_deltaZ[1], i_tmp, 1);
-   i_tmp = utl_mac16x16_32( as_K00[0][2], ps_deltaZ[2], i_tmp, 1);
-   ps_deltaAtt[0] = utl_rShft32_16( i_tmp, 14); /*Q15*/
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K00[1][0], ps_deltaZ[0], i_tmp, 1);
-   i_tmp = utl_mac16x16_32( as_K00[1][1], ps_deltaZ[1], i_tmp, 1);
-   i_tmp = utl_mac16x16_32( as_K00[1][2], ps_deltaZ[2], i_tmp, 1);
-   ps_deltaAtt[1] = utl_rShft32_16( i_tmp, 14); /*Q15*/
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K00[2][0], ps_deltaZ[0], i_tmp, 1);
-   i_tmp = utl_mac16x16_32( as_K00[2][1], ps_deltaZ[1], i_tmp, 1);
-   i_tmp = utl_mac16x16_32( as_K00[2][2], ps_deltaZ[2], i_tmp, 1);
-   ps_deltaAtt[2] = utl_rShft32_16( i_tmp, 14); /*Q15*/
+   insMatMultAttCorr( &as_K[0][0],
+                      ps_deltaZ,
+                      ps_deltaAtt);    /*Q15*/
 
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K10[0][0], ps_deltaZ[0], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K10[0][1], ps_deltaZ[1], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K10[0][2], ps_deltaZ[2], i_tmp, 0);
-   ps_deltaGBias[0] = utl_rShft32_16( i_tmp, 15); /*Q15*/
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K10[1][0], ps_deltaZ[0], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K10[1][1], ps_deltaZ[1], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K10[1][2], ps_deltaZ[2], i_tmp, 0);
-   ps_deltaGBias[1] = utl_rShft32_16( i_tmp, 15); /*Q15*/
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K10[2][0], ps_deltaZ[0], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K10[2][1], ps_deltaZ[1], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K10[2][2], ps_deltaZ[2], i_tmp, 0);
-   ps_deltaGBias[2] = utl_rShft32_16( i_tmp, 15); /*Q15*/
+   insMatMultGyroCorr( &as_K[3][0],
+                       ps_deltaZ,
+                       ps_deltaGBias);  /*Q15*/
 
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K20[0][0], ps_deltaZ[0], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K20[0][1], ps_deltaZ[1], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K20[0][2], ps_deltaZ[2], i_tmp, 0);
-   ps_deltaGScale[0] = utl_rShft32_16( i_tmp, 15); /*Q15*/
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K20[1][0], ps_deltaZ[0], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K20[1][1], ps_deltaZ[1], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K20[1][2], ps_deltaZ[2], i_tmp, 0);
-   ps_deltaGScale[1] = utl_rShft32_16( i_tmp, 15); /*Q15*/
-   i_tmp = 0;
-   i_tmp = utl_mac16x16_32( as_K20[2][0], ps_deltaZ[0], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K20[2][1], ps_deltaZ[1], i_tmp, 0);
-   i_tmp = utl_mac16x16_32( as_K20[2][2], ps_deltaZ[2], i_tmp, 0);
-   ps_deltaGScale[2] = utl_rShft32_16( i_tmp, 15); /*Q15*/
+   insMatMultGyroCorr( &as_K[6][0],
+                       ps_deltaZ,
+                       ps_deltaGScale); /*Q15*/
 
    /*------------------------------------------------------------------------*
     * Correct the error covariance matrix
     * P = (eye(9)-K*H)*P;
     * [1] eq 3.17
     *------------------------------------------------------------------------*/
-   utl_matMult16x16_16( &as_K00[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_H00[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_tmp1[0][0],/*Q15*/
-                        0,
-                        15);
-
-   utl_matMult16x16_16( &as_K10[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_H00[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_tmp2[0][0],/*Q15*/
-                        0,
-                        15);
-
-   utl_matMult16x16_16( &as_K20[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_H00[0][0], /*Q15*/
-                        3,
-                        3,
-                        &as_tmp3[0][0],/*Q15*/
-                        0,
-                        15);
+   insMatMultKH( &as_K[0][0],   /*Q15*/
+                 &as_H00[0][0], /*Q15*/
+                 &as_KH[0][0]); /*Q15*/
 
    memset( (void *)as_eyeMinusKH, 0, sizeof( as_eyeMinusKH));
    for( c_count = 0; c_count < 9; c_count++)
       as_eyeMinusKH[c_count][c_count] = 32767;
 
-   as_eyeMinusKH[0][0] -= as_tmp1[0][0];
-   as_eyeMinusKH[0][1] -= as_tmp1[0][1];
-   as_eyeMinusKH[0][2] -= as_tmp1[0][2];
-   as_eyeMinusKH[1][0] -= as_tmp1[1][0];
-   as_eyeMinusKH[1][1] -= as_tmp1[1][1];
-   as_eyeMinusKH[1][2] -= as_tmp1[1][2];
-   as_eyeMinusKH[2][0] -= as_tmp1[2][0];
-   as_eyeMinusKH[2][1] -= as_tmp1[2][1];
-   as_eyeMinusKH[2][2] -= as_tmp1[2][2];
-
-   as_eyeMinusKH[3][0] -= as_tmp2[0][0];
-   as_eyeMinusKH[3][1] -= as_tmp2[0][1];
-   as_eyeMinusKH[3][2] -= as_tmp2[0][2];
-   as_eyeMinusKH[4][0] -= as_tmp2[1][0];
-   as_eyeMinusKH[4][1] -= as_tmp2[1][1];
-   as_eyeMinusKH[4][2] -= as_tmp2[1][2];
-   as_eyeMinusKH[5][0] -= as_tmp2[2][0];
-   as_eyeMinusKH[5][1] -= as_tmp2[2][1];
-   as_eyeMinusKH[5][2] -= as_tmp2[2][2];
-
-   as_eyeMinusKH[6][0] -= as_tmp3[0][0];
-   as_eyeMinusKH[6][1] -= as_tmp3[0][1];
-   as_eyeMinusKH[6][2] -= as_tmp3[0][2];
-   as_eyeMinusKH[7][0] -= as_tmp3[1][0];
-   as_eyeMinusKH[7][1] -= as_tmp3[1][1];
-   as_eyeMinusKH[7][2] -= as_tmp3[1][2];
-   as_eyeMinusKH[8][0] -= as_tmp3[2][0];
-   as_eyeMinusKH[8][1] -= as_tmp3[2][1];
-   as_eyeMinusKH[8][2] -= as_tmp3[2][2];
+   for( c_index = 0; c_index < 9; c_index++)
+   {
+      as_eyeMinusKH[c_index][0] -= as_KH[c_index][0];
+      as_eyeMinusKH[c_index][1] -= as_KH[c_index][1];
+      as_eyeMinusKH[c_index][2] -= as_KH[c_index][2];
+   }
 
    memcpy( (void *)as_tmpP, (void *)gt_insDev.as_P, sizeof( as_tmpP));
-   utl_matMult16x16_16( &as_eyeMinusKH[0][0],  /*Q15*/
-                        9,
-                        9,
-                        &as_tmpP[0][0],        /*Q15*/
-                        9,
-                        9,
-                        &gt_insDev.as_P[0][0], /*Q15*/
-                        2,
-                        15);
+   insMatMultEyeMinusKHP( &as_eyeMinusKH[0][0],   /*Q15*/
+                          &as_tmpP[0][0],         /*Q15*/
+                          &gt_insDev.as_P[0][0]); /*Q15*/
 
    for( c_index = 0; c_index < 9; c_index++)
    {
@@ -1750,15 +1561,9 @@ static inline void dcmIntegration( int32_t *pi_gyr,
    as_tempDcm[2][1] = gt_insDev.as_dcm[2][1] >> 1;
    as_tempDcm[2][2] = gt_insDev.as_dcm[2][2] >> 1;
 
-   utl_matMult16x16_16( &as_tempDcm[0][0],
-                        3,
-                        3,
-                        &as_skew[0][0],
-                        3,
-                        3,
-                        &gt_insDev.as_dcm[0][0],
-                        0,
-                        14);
+   insMatMultDcm( &as_tempDcm[0][0],
+                  &as_skew[0][0],
+                  &gt_insDev.as_dcm[0][0]);
 
    /*------------------------------------------------------------------------*
     * Hard limit and scale the DCM back to a Q15 number...
@@ -1813,15 +1618,9 @@ static inline void dcmCorrect( int16_t *ps_err)
    as_tempDcm[2][1] = gt_insDev.as_dcm[2][1] >> 1;
    as_tempDcm[2][2] = gt_insDev.as_dcm[2][2] >> 1;
 
-   utl_matMult16x16_16( &as_skew[0][0],
-                        3,
-                        3,
-                        &as_tempDcm[0][0],
-                        3,
-                        3,
-                        &gt_insDev.as_dcm[0][0],
-                        0,
-                        14);
+   insMatMultDcm( &as_skew[0][0],
+                  &as_tempDcm[0][0],
+                  &gt_insDev.as_dcm[0][0]);
 
    /*------------------------------------------------------------------------*
     * Hard limit and scale the DCM back to a Q15 number...
@@ -1846,47 +1645,44 @@ static inline void dcmCorrect( int16_t *ps_err)
  *---------------------------------------------------------------------------*/
 static void dcmInit( int16_t *ps_att)
 {
-   int16_t s_roll  = ps_att[0];
-   int16_t s_pitch = ps_att[1];
-   int16_t s_yaw   = ps_att[2];
+   int16_t as_sin[3]; /*sin of roll, pitch, and yaw*/
+   int16_t as_cos[3]; /*cos of roll, pitch, and yaw*/
    int16_t s_temp;
    int32_t i_temp2;
 
-   gt_insDev.as_dcm[0][0] = utl_mult16x16_16( utl_cos16_16(s_pitch),
-   utl_cos16_16(s_yaw), 15);
+   utl_vSincos16_16( (uint16_t *)ps_att, as_sin, as_cos, 3);
 
-   s_temp = utl_mult16x16_16( utl_sin16_16(s_roll), utl_sin16_16(s_pitch), 15);
+   gt_insDev.as_dcm[0][0] = utl_mult16x16_16( as_cos[1], as_cos[2], 15);
+
+   s_temp = utl_mult16x16_16( as_sin[0], as_sin[1], 15);
    i_temp2 = 0;
-   i_temp2 = -utl_mac16x16_32( utl_cos16_16(s_roll), utl_sin16_16(s_yaw), i_temp2, 1);
-   i_temp2 = utl_mac16x16_32( s_temp, utl_cos16_16(s_yaw), i_temp2, 1);
+   i_temp2 = -utl_mac16x16_32( as_cos[0], as_sin[2], i_temp2, 1);
+   i_temp2 = utl_mac16x16_32( s_temp, as_cos[2], i_temp2, 1);
    gt_insDev.as_dcm[0][1] = utl_rShft32_16( i_temp2, 14);
 
-   s_temp = utl_mult16x16_16( utl_cos16_16(s_roll), utl_sin16_16(s_pitch), 15);
+   s_temp = utl_mult16x16_16( as_cos[0], as_sin[1], 15);
    i_temp2 = 0;
-   i_temp2 = utl_mac16x16_32( utl_sin16_16(s_roll), utl_sin16_16(s_yaw), i_temp2, 1);
-   i_temp2 = utl_mac16x16_32( s_temp, utl_cos16_16(s_yaw), i_temp2, 1);
+   i_temp2 = utl_mac16x16_32( as_sin[0], as_sin[2], i_temp2, 1);
+   i_temp2 = utl_mac16x16_32( s_temp, as_cos[2], i_temp2, 1);
    gt_insDev.as_dcm[0][2] = utl_rShft32_16( i_temp2, 14);
 
-   gt_insDev.as_dcm[1][0] = utl_mult16x16_16( utl_cos16_16(s_pitch),
-   utl_sin16_16(s_yaw), 15);
+   gt_insDev.as_dcm[1][0] = utl_mult16x16_16( as_cos[1], as_sin[2], 15);
 
-   s_temp = utl_mult16x16_16( utl_sin16_16(s_roll), utl_sin16_16(s_pitch), 15);
+   s_temp = utl_mult16x16_16( as_sin[0], as_sin[1], 15);
    i_temp2 = 0;
-   i_temp2 = utl_mac16x16_32( utl_cos16_16(s_roll), utl_cos16_16(s_yaw), i_temp2, 1);
-   i_temp2 = utl_mac16x16_32( s_temp, utl_sin16_16(s_yaw), i_temp2, 1);
+   i_temp2 = utl_mac16x16_32( as_cos[0], as_cos[2], i_temp2, 1);
+   i_temp2 = utl_mac16x16_32( s_temp, as_sin[2], i_temp2, 1);
    gt_insDev.as_dcm[1][1] = utl_rShft32_16( i_temp2, 14);
 
-   s_temp = utl_mult16x16_16( utl_cos16_16(s_roll), utl_sin16_16(s_pitch), 15);
+   s_temp = utl_mult16x16_16( as_cos[0], as_sin[1], 15);
    i_temp2 = 0;
-   i_temp2 = -utl_mac16x16_32( utl_sin16_16(s_roll), utl_cos16_16(s_yaw), i_temp2, 1);
-   i_temp2 = utl_mac16x16_32( s_temp, utl_sin16_16(s_yaw), i_temp2, 1);
+   i_temp2 = -utl_mac16x16_32( as_sin[0], as_cos[2], i_temp2, 1);
+   i_temp2 = utl_mac16x16_32( s_temp, as_sin[2], i_temp2, 1);
    gt_insDev.as_dcm[1][2] = utl_rShft32_16( i_temp2, 14);
 
-   gt_insDev.as_dcm[2][0] = -utl_sin16_16(s_pitch);
-   gt_insDev.as_dcm[2][1] = utl_mult16x16_16( utl_sin16_16(s_roll),
-   utl_cos16_16(s_pitch), 15);
-   gt_insDev.as_dcm[2][2] = utl_mult16x16_16( utl_cos16_16(s_roll),
-   utl_cos16_16(s_pitch), 15);
+   gt_insDev.as_dcm[2][0] = -as_sin[1];
+   gt_insDev.as_dcm[2][1] = utl_mult16x16_16( as_sin[0], as_cos[1], 15);
+   gt_insDev.as_dcm[2][2] = utl_mult16x16_16( as_cos[0], as_cos[1], 15);
 
 }/*End dcmInit*/
 
@@ -1897,8 +1693,8 @@ static inline void dcmToEuler( int16_t *ps_att)
 {
    int32_t i_temp;
    int32_t i_temp2;
-
-   ps_att[0] = utl_atan2_16( gt_insDev.as_dcm[2][1], gt_insDev.as_dcm[2][2]);
+   int16_t as_y[3];
+   int16_t as_x[3];
 
    /*------------------------------------------------------------------------*
     * In order to get accurate results when the 'x' is small in the sqrt x,
@@ -1915,8 +1711,20 @@ static inline void dcmToEuler( int16_t *ps_att)
    if( i_temp > 32767)
       i_temp = 32767;
 
-   ps_att[1] = -utl_atan2_16( gt_insDev.as_dcm[2][0], i_temp);
-   ps_att[2] = utl_atan2_16( gt_insDev.as_dcm[1][0], gt_insDev.as_dcm[0][0]);
+   /*------------------------------------------------------------------------*
+    * Roll, pitch, and yaw are found with a single pass over the atan2
+    * table...
+    *------------------------------------------------------------------------*/
+   as_y[0] = gt_insDev.as_dcm[2][1];
+   as_x[0] = gt_insDev.as_dcm[2][2];
+   as_y[1] = gt_insDev.as_dcm[2][0];
+   as_x[1] = (int16_t)i_temp;
+   as_y[2] = gt_insDev.as_dcm[1][0];
+   as_x[2] = gt_insDev.as_dcm[0][0];
+
+   utl_vAtan2_16( as_y, as_x, ps_att, 3);
+
+   ps_att[1] = -ps_att[1];
 
 }/*End dcmToEuler*/
 
@@ -1994,11 +1802,8 @@ static inline void getRawAttitude( int16_t *ps_acc,
     *------------------------------------------------------------------------*/
    ps_att[1] = utl_atan2_16( -ps_acc[0], (int16_t)i_temp2);
 
-   s_cosRoll = utl_cos16_16( ps_att[0]);
-   s_sinRoll = utl_sin16_16( ps_att[0]);
-
-   s_cosPitch = utl_cos16_16( ps_att[1]);
-   s_sinPitch = utl_sin16_16( ps_att[1]);
+   utl_sincos16_16( ps_att[0], &s_sinRoll, &s_cosRoll);
+   utl_sincos16_16( ps_att[1], &s_sinPitch, &s_cosPitch);
 
    i_temp2 = 0;
    i_temp2 = utl_mac16x16_32( ps_mag[1], s_sinRoll, i_temp2, 0);
@@ -2476,7 +2281,10 @@ static void dcmUpdate( void)
 
  gc_debugUpdateCount++;
 
- if( gc_debugUpdateCount == 5)
+ /*-------------------------------------------------------------------------*
+  * Only pay for formatting the debug strings when they will be displayed.
+  *-------------------------------------------------------------------------*/
+ if( (gc_debugUpdateCount >= 5) && (arb_getPrintfDbgLevel() <= PRINTF_DBG_HIGH))
  {
     gc_debugUpdateCount = 0;
 #if 0
@@ -2637,6 +2445,17 @@ static int32_t insIoctl( t_DEVHANDLE t_handle,
       }
       break;/*End case INS_GET_STATE_EST:*/
 
+      case INS_GET_DCM:
+
+         /*------------------------------------------------------------------*
+          * Copy out the 3x3 DCM, row major Q15.
+          *------------------------------------------------------------------*/
+         memcpy( (void *)((uint16_t)i_arguments),
+                 (void *)&gt_insDev.as_dcm[0][0],
+                 sizeof( gt_insDev.as_dcm));
+
+      break;/*End case INS_GET_DCM:*/
+
       /*---------------------------------------------------------------------*
        * Bring the Sensors out of reset...
        *---------------------------------------------------------------------*/
@@ -2959,12 +2778,12 @@ static int32_t insIoctl( t_DEVHANDLE t_handle,
          if( gt_insDev.t_mag.t_cal != INS_CAL_IN_PROGRESS)
          {
             gt_insDev.t_mag.t_cal = INS_CAL_IN_PROGRESS;
-            gt_insDev.c_HWrtPtr = 0;
+            ellipsoidFitReset();
          }
 
          i_return = (int32_t)gt_insDev.t_mag.t_cal;
 
-         if( gt_insDev.c_HWrtPtr < INS_MAX_CAL_SAMPLES)
+         if( gt_insDev.s_calSamples < INS_MAX_CAL_SAMPLES)
          {
             for( i_index = 0; i_index < 10; i_index++)
             {
@@ -2982,23 +2801,19 @@ static int32_t insIoctl( t_DEVHANDLE t_handle,
    				arb_sleep( INS_DT_SLEEP);
             }
 
-            gas_H[gt_insDev.c_HWrtPtr][0] = (int16_t)(af_avrMag[0] / i_index);
-            gas_H[gt_insDev.c_HWrtPtr][1] = (int16_t)(af_avrMag[1] / i_index);
-            gas_H[gt_insDev.c_HWrtPtr][2] = (int16_t)(af_avrMag[2] / i_index);
-
             /*---------------------------------------------------------------*
              * Return the current reading...
              *---------------------------------------------------------------*/
             ps_results = (int16_t *)((int16_t)i_arguments);
-            ps_results[0] = gas_H[gt_insDev.c_HWrtPtr][0];
-            ps_results[1] = gas_H[gt_insDev.c_HWrtPtr][1];
-            ps_results[2] = gas_H[gt_insDev.c_HWrtPtr][2];
+            ps_results[0] = (int16_t)(af_avrMag[0] / i_index);
+            ps_results[1] = (int16_t)(af_avrMag[1] / i_index);
+            ps_results[2] = (int16_t)(af_avrMag[2] / i_index);
 
-            gt_insDev.c_HWrtPtr++;
+            ellipsoidFitAccum( ps_results);
 
-         }/*End if( (*pc_HWrtPtr) < INS_MAX_CAL_SAMPLES)*/
+         }/*End if( gt_insDev.s_calSamples < INS_MAX_CAL_SAMPLES)*/
 
-	      if( gt_insDev.c_HWrtPtr == INS_MAX_CAL_SAMPLES)
+	      if( gt_insDev.s_calSamples == INS_MAX_CAL_SAMPLES)
          {
 
             if( ellipsoidFit( &gt_insDev.t_mag.as_R[0][0],
@@ -3016,7 +2831,7 @@ static int32_t insIoctl( t_DEVHANDLE t_handle,
                i_return = (int32_t)gt_insDev.t_mag.t_cal;
             }
 
-         }/*End if( (*pc_HWrtPtr) == INS_MAX_CAL_SAMPLES)*/
+         }/*End if( gt_insDev.s_calSamples == INS_MAX_CAL_SAMPLES)*/
       }
       break;/*End INS_CALIBRATE_MAG*/
 
@@ -3029,12 +2844,12 @@ static int32_t insIoctl( t_DEVHANDLE t_handle,
          if( gt_insDev.t_accel.t_cal != INS_CAL_IN_PROGRESS)
          {
             gt_insDev.t_accel.t_cal = INS_CAL_IN_PROGRESS;
-            gt_insDev.c_HWrtPtr = 0;
+            ellipsoidFitReset();
          }
 
          i_return = (int32_t)gt_insDev.t_accel.t_cal;
 
-         if( gt_insDev.c_HWrtPtr < INS_MAX_CAL_SAMPLES)
+         if( gt_insDev.s_calSamples < INS_MAX_CAL_SAMPLES)
          {
             for( i_index = 0; i_index < 10; i_index++)
             {
@@ -3052,23 +2867,19 @@ static int32_t insIoctl( t_DEVHANDLE t_handle,
    				arb_sleep( INS_DT_SLEEP);
             }
 
-            gas_H[gt_insDev.c_HWrtPtr][0] = (int16_t)(af_avrAcc[0] / i_index);
-            gas_H[gt_insDev.c_HWrtPtr][1] = (int16_t)(af_avrAcc[1] / i_index);
-            gas_H[gt_insDev.c_HWrtPtr][2] = (int16_t)(af_avrAcc[2] / i_index);
-
             /*---------------------------------------------------------------*
              * Return the current reading...
              *---------------------------------------------------------------*/
             ps_results = (int16_t *)((int16_t)i_arguments);
-            ps_results[0] = gas_H[gt_insDev.c_HWrtPtr][0];
-            ps_results[1] = gas_H[gt_insDev.c_HWrtPtr][1];
-            ps_results[2] = gas_H[gt_insDev.c_HWrtPtr][2];
+            ps_results[0] = (int16_t)(af_avrAcc[0] / i_index);
+            ps_results[1] = (int16_t)(af_avrAcc[1] / i_index);
+            ps_results[2] = (int16_t)(af_avrAcc[2] / i_index);
 
-            gt_insDev.c_HWrtPtr++;
+            ellipsoidFitAccum( ps_results);
 
-         }/*End if( (*pc_HWrtPtr) < INS_MAX_CAL_SAMPLES)*/
+         }/*End if( gt_insDev.s_calSamples < INS_MAX_CAL_SAMPLES)*/
 
-	      if( gt_insDev.c_HWrtPtr == INS_MAX_CAL_SAMPLES)
+	      if( gt_insDev.s_calSamples == INS_MAX_CAL_SAMPLES)
          {
             if( ellipsoidFit( &gt_insDev.t_accel.as_R[0][0],
                               &gt_insDev.t_accel.as_bias[0],
@@ -3085,7 +2896,7 @@ static int32_t insIoctl( t_DEVHANDLE t_handle,
                i_return = (int32_t)gt_insDev.t_accel.t_cal;
             }
 
-         }/*End if( (*pc_HWrtPtr) == INS_MAX_CAL_SAMPLES)*/
+         }/*End if( gt_insDev.s_calSamples == INS_MAX_CAL_SAMPLES)*/
       }
       break;/*End case INS_CALIBRATE_ACCEL:*/
 
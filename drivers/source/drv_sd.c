@@ -361,6 +361,27 @@ int32_t sdIoctl( t_DEVHANDLE t_dev,
          i_return = sd_fileSize( pt_dev->pv_privateData);
       break;
 
+      case SD_PREALLOC:
+         /*------------------------------------------------------------------*
+          * Reserve 'i_arguments' bytes of contiguous clusters so that
+          * subsequent writes never have to search the FAT for free space.
+          *------------------------------------------------------------------*/
+         if( sd_preAllocate( pt_dev->pv_privateData,
+                             (uint32_t)i_arguments) == false)
+            i_return = (int32_t)SD_OPERATION_FAILED;
+      break;/*End case SD_PREALLOC:*/
+
+      case SD_SYNC:
+         if( sd_sync( pt_dev->pv_privateData) == false)
+            i_return = (int32_t)SD_OPERATION_FAILED;
+      break;/*End case SD_SYNC:*/
+
+      case SD_SEEK:
+         if( sd_seek( pt_dev->pv_privateData,
+                      (uint32_t)i_arguments) == false)
+            i_return = (int32_t)SD_OPERATION_FAILED;
+      break;/*End case SD_SEEK:*/
+
       default:
          i_return = (int32_t)ARB_INVALID_CMD;
       break;
@@ -79,6 +79,7 @@
 #include "drv_sonar.h"
 #include "hal_gpio.h"
 #include "hal_adc.h"
+#include "utl_filter.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
@@ -144,9 +145,16 @@ typedef struct
    uint16_t s_currMeas;
 
    /*------------------------------------------------------------------------*
-    * The running total of the last 'c_numAvr' measurments.
+    * Moving average over the last 'c_numAvr' ADC readings. It is restarted
+    * for every measurement, so once 'c_numAvr' readings have been taken its
+    * output is the mean of all of them.
     *------------------------------------------------------------------------*/
-   uint32_t i_measSum;
+   t_movAvgFilter t_measAvg;
+
+   /*------------------------------------------------------------------------*
+    * The readings inside the moving average window.
+    *------------------------------------------------------------------------*/
+   int16_t as_measWindow[MAX_AVERAGES];
 
    /*------------------------------------------------------------------------*
     * The number of consecutive reading to average.
@@ -271,8 +279,10 @@ int32_t sonarIoctl( t_DEVHANDLE t_devHandle,
          {
 
             gat_sonarDev[0].c_numAvr = (uint8_t)i_arguments;
-            
-            gat_sonarDev[0].i_measSum = 0;
+
+            utl_initMovAvg( &gat_sonarDev[0].t_measAvg,
+                            gat_sonarDev[0].as_measWindow,
+                            (uint16_t)i_arguments);
 
             gat_sonarDev[0].c_avrCount = 0;
 
@@ -480,9 +490,11 @@ t_error drv_sonarInit( void)
       gat_sonarDev[c_index].s_currMeas = 0;
 
       /*---------------------------------------------------------------------*
-       * The aggregate of a measurement currently taking place.
+       * The average of a measurement currently taking place.
        *---------------------------------------------------------------------*/
-      gat_sonarDev[c_index].i_measSum = 0;
+      utl_initMovAvg( &gat_sonarDev[c_index].t_measAvg,
+                      gat_sonarDev[c_index].as_measWindow,
+                      MAX_AVERAGES);
 
       /*---------------------------------------------------------------------*
        * The number of consecutive reading to average.
@@ -567,10 +579,14 @@ void drv_sonarExit( void)
 static void adcConversionComplete()
 {
    int16_t s_temp = 0;
-   
+   int16_t s_avg  = 0;
+
    s_temp = hal_getAdcSample( gat_sonarDev[0].t_adcHandle);
 
-   gat_sonarDev[0].i_measSum += s_temp;
+   utl_movAvg16( &gat_sonarDev[0].t_measAvg,
+                 &s_temp,
+                 &s_avg,
+                 1);
    gat_sonarDev[0].c_avrCount++;
 
 #ifdef SONAR_DEBUG
@@ -585,12 +601,9 @@ static void adcConversionComplete()
       gat_sonarDev[0].b_measEnabled = false;
 
       /*---------------------------------------------------------------------*
-       * Calculate the average distance in inches.
+       * Convert the average of the readings into inches.
        *---------------------------------------------------------------------*/
-      s_temp = (uint16_t)((gat_sonarDev[0].i_measSum + 
-      (uint32_t)(gat_sonarDev[0].c_avrCount >> 1)) / 
-      gat_sonarDev[0].c_avrCount);
-      s_temp = (s_temp - ADC_OFFSET);
+      s_temp = (s_avg - ADC_OFFSET);
 
       if( s_temp < 0)
          s_temp = 0;
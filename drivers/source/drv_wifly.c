@@ -23,7 +23,7 @@
  *               the Roving Networks Wifly module. This code was based upon
  *               exampled provided in the Sparkfun Wifly shield library.
  *
- * Last Update : July 8, 2013
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------*
@@ -38,12 +38,12 @@
 #include "arb_sysTimer.h"
 #include "arb_printf.h"
 #include "arb_thread.h"
+#include "arb_dispatcher.h"
 #include "drv_wifly.h"
 #include "hal_uart.h"
 #include "utl_buffer.h"
 #include "hal_gpio.h"
 #include "hal_clocks.h"
-#include "utl_buffer.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
@@ -51,10 +51,22 @@
 #define WIFLY_CMD_MODE_RETRIES (5)
 #define WIFLY_REBOOT_RETRIES   (5)
 #define WIFLY_RESP_STRING_MAX  (15)
+#define WIFLY_RX_BUFF_SIZE     (64)
+#define WIFLY_RESP_TIMEOUT     (25) /*System ticks*/
 
 /*---------------------------------------------------------------------------*
  * Private Data Types
  *---------------------------------------------------------------------------*/
+typedef enum
+{
+   WIFLY_ST_DATA = 0, /*Received bytes are passed to the rx buffer*/
+   WIFLY_ST_ESCAPE,   /*'$$$' sent, waiting for "CMD"*/
+   WIFLY_ST_CMD,      /*In command mode and idle*/
+   WIFLY_ST_SEND,     /*Command sent, waiting for it to be echoed*/
+   WIFLY_NUM_STATES
+
+}t_wiflyState;
+
 typedef struct
 {
 
@@ -77,14 +89,15 @@ typedef struct
    t_SEMHANDLE t_rxBlockingSem;
 
    /*------------------------------------------------------------------------*
-    * Ptr to the user-space receive buffer
+    * Bytes received while in data mode are held here until read by the
+    * user-space thread.
     *------------------------------------------------------------------------*/
-   uint8_t *pc_rxBuffer;
+   t_buffer t_rxBuffer;
 
    /*------------------------------------------------------------------------*
-    * Ptr to the user-space transmit buffer
+    * Storage area for 't_rxBuffer'.
     *------------------------------------------------------------------------*/
-   uint8_t *pc_txBuffer;
+   int8_t ac_rxStorage[WIFLY_RX_BUFF_SIZE];
 
    /*------------------------------------------------------------------------*
     * Handle to the particular WIFLY this wifly driver is using.
@@ -129,11 +142,39 @@ typedef struct
     *------------------------------------------------------------------------*/
    uint8_t c_respSize;
 
+   /*------------------------------------------------------------------------*
+    * The state posted by 'rxComplete' once 'ac_respString' has been found.
+    *------------------------------------------------------------------------*/
+   uint8_t c_respState;
+
    /*------------------------------------------------------------------------*
     * If true, the Wifly module is in command mode.
     *------------------------------------------------------------------------*/
    bool b_enCmdMode;
 
+   /*------------------------------------------------------------------------*
+    * Runs the command mode negotiation on the dispatcher thread. Events are
+    * posted by the ioctl routine, 'rxComplete', and the time event used for
+    * the response timeout.
+    *------------------------------------------------------------------------*/
+   t_activeObject t_ao;
+
+   /*------------------------------------------------------------------------*
+    * Number of attempts made at the current escape sequence or command.
+    *------------------------------------------------------------------------*/
+   uint8_t c_retries;
+
+   /*------------------------------------------------------------------------*
+    * The command sent while in state WIFLY_ST_SEND.
+    *------------------------------------------------------------------------*/
+   const char *pc_cmd;
+
+   /*------------------------------------------------------------------------*
+    * Signaled once a negotiation finishes, 'i_result' holds the outcome.
+    *------------------------------------------------------------------------*/
+   t_SEMHANDLE t_doneSem;
+   int32_t i_result;
+
 }t_wiflyDev;
 
 /*---------------------------------------------------------------------------*
@@ -157,9 +198,24 @@ static t_error wiflyClose( t_DEVHANDLE t_handle);
 
 static void rxComplete( uint16_t s_byte);
 
-static bool wiflyEnterCommandMode( void);
+static void wiflyPrepareForResponse( const char *pc_respString,
+                                     uint8_t c_respState);
+
+static int32_t wiflyNegotiate( uint8_t c_state);
+
+static void wiflyComplete( int32_t i_result);
+
+static void wiflyData( int32_t i_stateData,
+                       uint8_t c_prevState);
+
+static void wiflyEscape( int32_t i_stateData,
+                         uint8_t c_prevState);
 
-static void wiflyPrepareForResponse( const char *pc_respString);
+static void wiflyCmd( int32_t i_stateData,
+                      uint8_t c_prevState);
+
+static void wiflySend( int32_t i_stateData,
+                       uint8_t c_prevState);
 
 /*---------------------------------------------------------------------------*
  * Private Global Variables
@@ -180,6 +236,44 @@ t_deviceOperations gt_wiflyDevOps =
  *---------------------------------------------------------------------------*/
 static t_wiflyDev gt_wiflyDev;
 
+/*---------------------------------------------------------------------------*
+ * Command mode negotiation. A timeout re-posts the state it occurred in so
+ * the escape sequence or command is resent until the response is found or
+ * the retries run out.
+ *---------------------------------------------------------------------------*/
+UTL_STMN_CREATE_TABLE( gat_wiflyStates, WIFLY_NUM_STATES) =
+{
+   [WIFLY_ST_DATA]   = UTL_STMN_STATE( &wiflyData,
+                                       NULL,
+                                       NULL,
+                                       UTL_STMN_NO_STATE,
+                                       UTL_STMN_TRANS( WIFLY_ST_DATA) |
+                                       UTL_STMN_TRANS( WIFLY_ST_ESCAPE)),
+
+   [WIFLY_ST_ESCAPE] = UTL_STMN_STATE( &wiflyEscape,
+                                       NULL,
+                                       NULL,
+                                       UTL_STMN_NO_STATE,
+                                       UTL_STMN_TRANS( WIFLY_ST_DATA) |
+                                       UTL_STMN_TRANS( WIFLY_ST_ESCAPE) |
+                                       UTL_STMN_TRANS( WIFLY_ST_CMD)),
+
+   [WIFLY_ST_CMD]    = UTL_STMN_STATE( &wiflyCmd,
+                                       NULL,
+                                       NULL,
+                                       UTL_STMN_NO_STATE,
+                                       UTL_STMN_TRANS( WIFLY_ST_DATA) |
+                                       UTL_STMN_TRANS( WIFLY_ST_SEND)),
+
+   [WIFLY_ST_SEND]   = UTL_STMN_STATE( &wiflySend,
+                                       NULL,
+                                       NULL,
+                                       UTL_STMN_NO_STATE,
+                                       UTL_STMN_TRANS( WIFLY_ST_DATA) |
+                                       UTL_STMN_TRANS( WIFLY_ST_CMD) |
+                                       UTL_STMN_TRANS( WIFLY_ST_SEND))
+};
+
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
  *---------------------------------------------------------------------------*/
@@ -187,7 +281,8 @@ static t_wiflyDev gt_wiflyDev;
 /*---------------------------------------------------------------------------*
  * Private Function Definitions
  *---------------------------------------------------------------------------*/
-static void wiflyPrepareForResponse( const char *pc_respString)
+static void wiflyPrepareForResponse( const char *pc_respString,
+                                     uint8_t c_respState)
 {
    size_t t_numBytes = strlen( pc_respString);
 
@@ -200,55 +295,139 @@ static void wiflyPrepareForResponse( const char *pc_respString)
 
    gt_wiflyDev.c_respSize = (uint8_t)t_numBytes;
    gt_wiflyDev.c_respIndex = 0;
+   gt_wiflyDev.c_respState = c_respState;
 
    gt_wiflyDev.b_respFound = false;
 
 }/*End wiflyPrepareForResponse*/
 
-static bool wiflyEnterCommandMode( void)
+/*---------------------------------------------------------------------------*
+ * Hands a request to the state machine and blocks until it has been carried
+ * out, must be called with the tx lock held.
+ *---------------------------------------------------------------------------*/
+static int32_t wiflyNegotiate( uint8_t c_state)
+{
+   gt_wiflyDev.c_retries = 0;
+
+   if( arb_activeObjectPost( &gt_wiflyDev.t_ao,
+                             c_state,
+                             (int32_t)WIFLY_PASSED) < 0)
+   {
+      return (int32_t)WIFLY_CMD_MODE_FAIL;
+   }
+
+   arb_wait( gt_wiflyDev.t_doneSem,
+             BLOCKING);
+
+   return gt_wiflyDev.i_result;
+
+}/*End wiflyNegotiate*/
+
+static void wiflyComplete( int32_t i_result)
+{
+   arb_activeObjectArmTimeout( &gt_wiflyDev.t_ao,
+                               0,
+                               WIFLY_ST_DATA);
+
+   gt_wiflyDev.i_result = i_result;
+   arb_signal( gt_wiflyDev.t_doneSem);
+
+}/*End wiflyComplete*/
+
+static void wiflyData( int32_t i_stateData,
+                       uint8_t c_prevState)
+{
+   gt_wiflyDev.b_enCmdMode = false;
+   wiflyComplete( i_stateData);
+
+}/*End wiflyData*/
+
+static void wiflyEscape( int32_t i_stateData,
+                         uint8_t c_prevState)
 {
-   uint8_t c_retryCount;
-   int8_t ac_buff[10];
-   size_t t_size;
+   int8_t ac_buff[3] = {'$','$','$'};
 
-   gt_wiflyDev.b_enCmdMode = true;
-   for( c_retryCount = 0; c_retryCount < WIFLY_CMD_MODE_RETRIES; c_retryCount++)
+   if( gt_wiflyDev.c_retries == WIFLY_CMD_MODE_RETRIES)
    {
-      wiflyPrepareForResponse( "CMD");
-      arb_sleep( 25);
+      arb_activeObjectPost( &gt_wiflyDev.t_ao,
+                            WIFLY_ST_DATA,
+                            (int32_t)WIFLY_CMD_MODE_FAIL);
+      return;
+   }
+
+   gt_wiflyDev.c_retries++;
+
+   /*------------------------------------------------------------------------*
+    * Arm the search before sending, the response can arrive before the
+    * write returns.
+    *------------------------------------------------------------------------*/
+   wiflyPrepareForResponse( "CMD",
+                            WIFLY_ST_CMD);
+
+   hal_uartWriteBlock( gt_wiflyDev.t_uHandle,
+                       ac_buff,
+                       3);
 
-      t_size = sprintf_P( (char *)ac_buff, PSTR("$$$"));
+   arb_activeObjectArmTimeout( &gt_wiflyDev.t_ao,
+                               WIFLY_RESP_TIMEOUT,
+                               WIFLY_ST_ESCAPE);
 
+}/*End wiflyEscape*/
+
+static void wiflyCmd( int32_t i_stateData,
+                      uint8_t c_prevState)
+{
+   int8_t ac_buff[5] = {'v','e','r','\n','\r'};
+
+   if( c_prevState == WIFLY_ST_ESCAPE)
+   {
       hal_uartWriteBlock( gt_wiflyDev.t_uHandle,
                           ac_buff,
-                          3);
+                          5);
+   }
 
-      arb_sleep( 25);
+   wiflyComplete( i_stateData);
 
-      //t_size = sprintf_P( (char *)ac_buff, PSTR("\n\r"));
-      //hal_uartWriteBlock( gt_wiflyDev.t_uHandle,
-      //                    ac_buff,
-       //                   t_size);
+}/*End wiflyCmd*/
 
-      if( gt_wiflyDev.b_respFound == true)
-      {
-         t_size = sprintf_P( (char *)ac_buff, PSTR("ver\n\r"));
+static void wiflySend( int32_t i_stateData,
+                       uint8_t c_prevState)
+{
+   int8_t ac_end[2] = {'\n','\r'};
+   uint8_t c_respState = WIFLY_ST_CMD;
 
-         hal_uartWriteBlock( gt_wiflyDev.t_uHandle,
-                             ac_buff,
-                             5);
+   if( gt_wiflyDev.c_retries == WIFLY_CMD_MODE_RETRIES)
+   {
+      arb_activeObjectPost( &gt_wiflyDev.t_ao,
+                            WIFLY_ST_CMD,
+                            (int32_t)WIFLY_CMD_MODE_FAIL);
+      return;
+   }
 
-         arb_sleep( 25);
+   gt_wiflyDev.c_retries++;
 
-         return true;
-      }
+   /*------------------------------------------------------------------------*
+    * The module leaves command mode once "exit" has been echoed.
+    *------------------------------------------------------------------------*/
+   if( strncmp_P( gt_wiflyDev.pc_cmd, PSTR("exit"), 4) == 0)
+      c_respState = WIFLY_ST_DATA;
 
-   }
+   wiflyPrepareForResponse( gt_wiflyDev.pc_cmd,
+                            c_respState);
 
-   gt_wiflyDev.b_enCmdMode = false;
-   return false;
+   hal_uartWriteBlock( gt_wiflyDev.t_uHandle,
+                       (int8_t *)gt_wiflyDev.pc_cmd,
+                       (uint16_t)strlen( gt_wiflyDev.pc_cmd));
+
+   hal_uartWriteBlock( gt_wiflyDev.t_uHandle,
+                       ac_end,
+                       2);
 
-}/*End wiflyEnterCommandMode*/
+   arb_activeObjectArmTimeout( &gt_wiflyDev.t_ao,
+                               WIFLY_RESP_TIMEOUT,
+                               WIFLY_ST_SEND);
+
+}/*End wiflySend*/
 
 static void rxComplete( uint16_t s_byte)
 {
@@ -275,6 +454,13 @@ static void rxComplete( uint16_t s_byte)
 
                gt_wiflyDev.c_respIndex = 0;
                gt_wiflyDev.b_respFound = true;
+
+               /*------------------------------------------------------------*
+                * Let the state machine know the response arrived.
+                *------------------------------------------------------------*/
+               arb_activeObjectPost( &gt_wiflyDev.t_ao,
+                                     gt_wiflyDev.c_respState,
+                                     (int32_t)WIFLY_PASSED);
             }
          }
          else
@@ -290,8 +476,25 @@ static void rxComplete( uint16_t s_byte)
    }/*End if( gt_wiflyDev.b_enCmdMode == true)*/
    else
    {
+      bool b_wasEmpty = utl_isBufferEmpty( &gt_wiflyDev.t_rxBuffer);
 
-   }
+      /*---------------------------------------------------------------------*
+       * Bytes arriving while the buffer is full are dropped.
+       *---------------------------------------------------------------------*/
+      if( !utl_isBufferFull( &gt_wiflyDev.t_rxBuffer))
+      {
+         utl_writeByte( &gt_wiflyDev.t_rxBuffer,
+                        (int8_t)s_byte);
+
+         /*------------------------------------------------------------------*
+          * Only wake the reader on the empty to non-empty transition, it
+          * drains everything available once it runs.
+          *------------------------------------------------------------------*/
+         if( b_wasEmpty)
+            arb_signal( gt_wiflyDev.t_rxBlockingSem);
+      }
+
+   }/*End else*/
 
 }/*End rxComplete*/
 
@@ -350,8 +553,19 @@ static int16_t wiflyRead( t_DEVHANDLE t_handle,
    /*------------------------------------------------------------------------*
     * Wait for data to be available in the RX buffer.
     *------------------------------------------------------------------------*/
-   arb_wait( gt_wiflyDev.t_rxBlockingSem,
-             0);
+   while( utl_isBufferEmpty( &gt_wiflyDev.t_rxBuffer))
+   {
+      arb_wait( gt_wiflyDev.t_rxBlockingSem,
+                0);
+   }
+
+   s_bufferLevel = utl_getBufferFullLevel( &gt_wiflyDev.t_rxBuffer);
+   if( s_bufferLevel > (int16_t)s_size)
+      s_bufferLevel = (int16_t)s_size;
+
+   utl_readBlock( &gt_wiflyDev.t_rxBuffer,
+                  pc_buff,
+                  (uint16_t)s_bufferLevel);
 
    /*------------------------------------------------------------------------*
     * Release the lock
@@ -442,10 +656,14 @@ static int32_t wiflyIoctl( t_DEVHANDLE t_handle,
          arb_wait( gt_wiflyDev.t_txMutex,
                    0);
 
-         if( wiflyEnterCommandMode() == false)
+         if( gt_wiflyDev.b_enCmdMode == false)
          {
-            i_return = (int32_t)WIFLY_CMD_MODE_FAIL;
-            gt_wiflyDev.b_enCmdMode = false;
+            /*---------------------------------------------------------------*
+             * Received bytes are matched against the expected response from
+             * here on out.
+             *---------------------------------------------------------------*/
+            gt_wiflyDev.b_enCmdMode = true;
+            i_return = wiflyNegotiate( WIFLY_ST_ESCAPE);
          }
 
          /*------------------------------------------------------------------*
@@ -462,7 +680,8 @@ static int32_t wiflyIoctl( t_DEVHANDLE t_handle,
          arb_wait( gt_wiflyDev.t_txMutex,
                    0);
 
-         gt_wiflyDev.b_enCmdMode = false;
+         if( gt_wiflyDev.b_enCmdMode == true)
+            i_return = wiflyNegotiate( WIFLY_ST_DATA);
 
          /*------------------------------------------------------------------*
           * Release the lock
@@ -479,47 +698,10 @@ static int32_t wiflyIoctl( t_DEVHANDLE t_handle,
          arb_wait( gt_wiflyDev.t_txMutex,
                    0);
 
-         char *pc_cmd = (char *)((uint16_t)i_arguments);
-         char ac_end[2] = {'\n','\r'};
-         uint8_t c_retries = 0;
-         uint16_t s_size;
-
          if( gt_wiflyDev.b_enCmdMode == true)
          {
-            
-            do 
-            {
-            
-               /*------------------------------------------------------------*
-                * Initialize the search string
-                *------------------------------------------------------------*/
-               wiflyPrepareForResponse( (const char *)pc_cmd); 
-               s_size = strlen(pc_cmd);
-               i_return = (int32_t)hal_uartWriteBlock( gt_wiflyDev.t_uHandle,
-                                                      (int8_t *)pc_cmd,
-                                                      s_size);
-               hal_uartWriteBlock( gt_wiflyDev.t_uHandle,
-                                   (int8_t *)ac_end,
-                                   2);
-               /*------------------------------------------------------------*
-                * Wait for the WiFly module to send the response message.
-                *------------------------------------------------------------*/
-               arb_sleep( 25);
-
-               if( gt_wiflyDev.b_respFound == true)
-                  break;
-
-               c_retries++;
-
-            }while( (gt_wiflyDev.b_respFound == false) &&
-                    (c_retries < WIFLY_CMD_MODE_RETRIES));
-
-            if( (gt_wiflyDev.b_respFound == true) &&
-                (strncmp_P( (const char *)pc_cmd, PSTR("exit"), 4) == 0))
-            {
-               gt_wiflyDev.b_enCmdMode = false;
-
-            }
+            gt_wiflyDev.pc_cmd = (const char *)((uint16_t)i_arguments);
+            i_return = wiflyNegotiate( WIFLY_ST_SEND);
          }
          else
             i_return = (int32_t)WIFLY_NO_CMD_MODE;
@@ -616,6 +798,10 @@ t_error drv_wiflyInit( t_wiflySetup t_setup)
 
    }/*End if( gt_wiflyDev.t_rxMutex < 0)*/
 
+   utl_initBuffer( &gt_wiflyDev.t_rxBuffer,
+                   gt_wiflyDev.ac_rxStorage,
+                   WIFLY_RX_BUFF_SIZE);
+
    /*------------------------------------------------------------------------*
     * Request a semaphore from the kernel. We will use this semaphore for
     * signaling the user-space program when the RX buffer has data.
@@ -691,6 +877,35 @@ t_error drv_wiflyInit( t_wiflySetup t_setup)
    gt_wiflyDev.c_resetPort = t_setup.c_resetPort;
    gt_wiflyDev.c_resetPin = t_setup.c_resetPin;
 
+   /*------------------------------------------------------------------------*
+    * Request a semaphore from the kernel. We will use this semaphore for
+    * waking the user-space thread once a command mode request finishes.
+    *------------------------------------------------------------------------*/
+   gt_wiflyDev.t_doneSem = arb_semaphoreCreate( COUNTING);
+
+   if( gt_wiflyDev.t_doneSem < 0)
+   {
+      t_err = (t_error)gt_wiflyDev.t_doneSem;
+      goto failed6;
+
+   }/*End if( gt_wiflyDev.t_doneSem < 0)*/
+
+   /*------------------------------------------------------------------------*
+    * Hand the command mode state machine over to the dispatcher thread.
+    *------------------------------------------------------------------------*/
+   utl_stMnInit( &gt_wiflyDev.t_ao.t_stMn,
+                 gat_wiflyStates,
+                 WIFLY_NUM_STATES,
+                 WIFLY_ST_DATA);
+
+   t_err = arb_activeObjectRegister( &gt_wiflyDev.t_ao,
+                                     t_setup.c_dspPrio);
+
+   if( t_err < 0)
+   {
+      goto failed7;
+   }
+
    /*------------------------------------------------------------------------*
     * We don't have any users attached to this device
     *------------------------------------------------------------------------*/
@@ -699,6 +914,10 @@ t_error drv_wiflyInit( t_wiflySetup t_setup)
 
    return ARB_PASSED;
 
+failed7:
+
+   arb_semaphoreDestroy( gt_wiflyDev.t_doneSem);
+
 failed6:
 
    arb_semaphoreDestroy( gt_wiflyDev.t_txMutex);
@@ -713,6 +932,7 @@ failed4:
 
 failed3:
 
+   utl_destroyBuffer( &gt_wiflyDev.t_rxBuffer);
    arb_semaphoreDestroy( gt_wiflyDev.t_rxMutex);
 
 failed2:
@@ -733,10 +953,13 @@ void drv_wiflyExit( void)
 
    if( gt_wiflyDev.t_rxMutex != 0) /*If created... destroy*/
    {
+      arb_activeObjectRemove( &gt_wiflyDev.t_ao);
       hal_releaseUartChannel( gt_wiflyDev.t_uHandle);
+      arb_semaphoreDestroy( gt_wiflyDev.t_doneSem);
       arb_semaphoreDestroy( gt_wiflyDev.t_rxBlockingSem);
       arb_semaphoreDestroy( gt_wiflyDev.t_rxMutex);
       arb_semaphoreDestroy( gt_wiflyDev.t_txMutex);
+      utl_destroyBuffer( &gt_wiflyDev.t_rxBuffer);
       arb_destroyDevice( "wiflyDevice0");
 
       memset( (void *)&gt_wiflyDev, 0, sizeof( gt_wiflyDev));
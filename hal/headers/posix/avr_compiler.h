@@ -0,0 +1,82 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : avr_compiler.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Stands in for the avr-libc headers when building on a
+ *               POSIX host. Program memory is ordinary memory on the host,
+ *               so the PROGMEM attribute goes away and the '_P' string and
+ *               'pgm_read' routines map onto their standard C equivalents.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef COMPILER_AVR_H
+#define COMPILER_AVR_H
+
+#ifndef F_CPU
+/*---------------------------------------------------------------------------*
+ * The clock the xmega build runs at, timer periods are emulated against it.
+ *---------------------------------------------------------------------------*/
+#define F_CPU 32000000UL
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+
+/*---------------------------------------------------------------------------*
+ * Size of the 'SRAM' reported by the console, there is no fixed memory map
+ * on the host.
+ *---------------------------------------------------------------------------*/
+#define RAMEND (0xFFFF)
+
+#define PROGMEM
+#define PSTR( s) (s)
+#define PGM_P const char *
+
+#define pgm_read_byte( addr) (*(const uint8_t *)(addr))
+#define pgm_read_word( addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword( addr) (*(const uint32_t *)(addr))
+#define pgm_read_float( addr) (*(const float *)(addr))
+
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcasecmp_P strcasecmp
+#define strncasecmp_P strncasecmp
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+#define printf_P printf
+
+#define INLINE static inline
+
+#define nop() do { __asm__ __volatile__ ("nop"); } while (0)
+
+#define MAIN_TASK_PROLOGUE int
+
+#define MAIN_TASK_EPILOGUE() return -1;
+
+#define SHORTENUM __attribute__ ((packed))
+
+#endif
@@ -0,0 +1,142 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_clocks.h
+ *
+ * Project     : Arbitros
+ *               https://code.google.com/p/arbitros/
+ *
+ * Description : The clock interface of the POSIX host. The CPU frequency is
+ *               only recorded and the busy delays sleep on the monotonic
+ *               clock. The cycle counter is the time stamp counter on x86
+ *               and the monotonic clock in nanoseconds elsewhere.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef hal_clocks_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define hal_clocks_h
+ 
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include <time.h>
+   #if defined( __x86_64__) || defined( __i386__)
+   #include <x86intrin.h>
+   #endif
+   #include "avr_compiler.h"
+   #include "hal_pmic.h"
+
+   /*------------------------------------------------------------------------*
+    * Global typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+      CLOCKS_COUNTER_BUSY = -2, /*Cycle counter timers are in use.*/
+      CLOCKS_INVALID_FREQ = -1, /*Can't set CPU freq.*/
+      CLOCKS_PASSED       = 0   /*Configuration good.*/
+
+   }t_clocksError;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Inline functions
+    *------------------------------------------------------------------------*/
+   /*------------------------------------------------------------------------*
+    * Blocks for 'i_usec' microseconds, interrupts raised in the meantime are
+    * left pending as they would be on the xmega.
+    *------------------------------------------------------------------------*/
+   static inline void __attribute__((always_inline)) \
+   hal_busyDelayUs(uint32_t i_usec, uint32_t i_cpuSpeed)
+   {
+      struct timespec t_end;
+
+      HAL_BEGIN_CRITICAL();
+
+      clock_gettime( CLOCK_MONOTONIC, &t_end);
+      t_end.tv_sec  += i_usec / 1000000;
+      t_end.tv_nsec += (long)(i_usec % 1000000)*1000;
+      if( t_end.tv_nsec >= 1000000000L)
+      {
+         t_end.tv_sec++;
+         t_end.tv_nsec -= 1000000000L;
+      }
+
+      while( clock_nanosleep( CLOCK_MONOTONIC,
+                              TIMER_ABSTIME,
+                              &t_end,
+                              NULL) != 0);
+
+      HAL_END_CRITICAL();
+
+   }/*End hal_busyDelayUs*/
+
+   static inline void __attribute__((always_inline)) \
+   hal_busyDelayMs(uint32_t i_msec, uint32_t i_cpuSpeed)
+   {
+      hal_busyDelayUs( i_msec*1000, i_cpuSpeed);
+
+   }/*End hal_busyDelayMs*/
+
+   /*------------------------------------------------------------------------*
+    * Returns the low 32 bits of the cycle counter.
+    *------------------------------------------------------------------------*/
+   static inline uint32_t __attribute__((always_inline)) \
+   hal_getCycleCount( void)
+   {
+   #if defined( __x86_64__) || defined( __i386__)
+      return (uint32_t)__rdtsc();
+   #else
+      struct timespec t_now;
+
+      clock_gettime( CLOCK_MONOTONIC, &t_now);
+
+      return (uint32_t)t_now.tv_sec*1000000000UL + (uint32_t)t_now.tv_nsec;
+   #endif
+
+   }/*End hal_getCycleCount*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+   t_clocksError hal_setCpuFreq( uint32_t i_cpuFreq);
+   uint32_t hal_getCpuFreq( void);
+
+   /*------------------------------------------------------------------------*
+    * Measures the rate of the cycle counter, which always runs on the host.
+    *------------------------------------------------------------------------*/
+   t_clocksError hal_startCycleCounter( void);
+
+   /*------------------------------------------------------------------------*
+    * Rate at which 'hal_getCycleCount' advances in counts per second.
+    *------------------------------------------------------------------------*/
+   uint32_t hal_getCycleCounterFreq( void);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef hal_clocks_h*/
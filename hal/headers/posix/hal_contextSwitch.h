@@ -0,0 +1,153 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_contextSwitch.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Thread context switching for the POSIX host using ucontext.
+ *               Each thread runs on its own host stack (the stack allocated
+ *               in the TCB is far too small for libc) and the TCB's 's_sP'
+ *               points at the thread's t_halContext. A context save only
+ *               records which thread is being switched out, the actual
+ *               'swapcontext' happens in 'hal_contextRestore' once the
+ *               scheduler has picked the next thread.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef hal_contextSave_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define hal_contextSave_h
+
+   /*------------------------------------------------------------------------*
+    * The yield functions are ordinary calls on the host, 'noinline' keeps
+    * each one a single frame to return to once the thread is resumed.
+    *------------------------------------------------------------------------*/
+   #define HAL_NAKED_FUNC __attribute__ ( ( noinline))
+
+   /*------------------------------------------------------------------------*
+    * Size of the host stack given to each thread.
+    *------------------------------------------------------------------------*/
+   #define HAL_HOST_STACK_BYTES (65536)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include <ucontext.h>
+   #include "avr_compiler.h"
+   #include "arb_thread.h"
+   #include "arb_error.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef struct halContext
+   {
+      /*---------------------------------------------------------------------*
+       * Registers, signal mask and stack of the thread.
+       *---------------------------------------------------------------------*/
+      ucontext_t t_context;
+      uint8_t *pc_stack;
+
+      /*---------------------------------------------------------------------*
+       * The 's_stackEnd' of the TCB this context belongs to, a thread
+       * created in the memory of a destroyed one reuses its context.
+       *---------------------------------------------------------------------*/
+      uintptr_t i_owner;
+
+      /*---------------------------------------------------------------------*
+       * The thread's entry point and its arguments.
+       *---------------------------------------------------------------------*/
+      void (*pf_thread)( t_parameters t_parms,
+                         t_arguments t_args);
+      t_parameters t_parms;
+      t_arguments t_args;
+
+      /*---------------------------------------------------------------------*
+       * State of the interrupt flags to restore when the thread resumes,
+       * the equivalent of the SREG saved on the xmega.
+       *---------------------------------------------------------------------*/
+      bool b_intsEnabled;
+      bool b_activeInt;
+
+      /*---------------------------------------------------------------------*
+       * Next context ever created, they are kept for reuse.
+       *---------------------------------------------------------------------*/
+      struct halContext *pt_next;
+
+   }t_halContext;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Records the current thread as the one being switched out, it resumes
+    * with interrupts set to 'b_intsEnabled'.
+    *------------------------------------------------------------------------*/
+   void hal_contextSave( bool b_intsEnabled);
+
+   /*------------------------------------------------------------------------*
+    * Switches to the current thread on 'gt_activeThreads', returns once the
+    * thread that was saved is picked to run again.
+    *------------------------------------------------------------------------*/
+   void hal_contextRestore( void);
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * The scheduler runs on the host stack of the thread being switched out,
+    * there is no separate kernel stack.
+    *------------------------------------------------------------------------*/
+   static inline void __attribute__((always_inline)) \
+   hal_switchToKernelStack( void)
+   {
+
+   }/*End hal_switchToKernelStack*/
+
+   static inline void __attribute__((always_inline)) \
+   hal_contextSaveWithIntsOn( void)
+   {
+      hal_contextSave( true);
+
+   }/*End hal_contextSaveWithIntsOn*/
+
+   static inline void __attribute__((always_inline)) \
+   hal_contextSaveWithIntsOff( void)
+   {
+      hal_contextSave( false);
+
+   }/*End hal_contextSaveWithIntsOff*/
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef hal_contextSave_h*/
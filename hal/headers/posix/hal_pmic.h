@@ -0,0 +1,138 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_pmic.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Simulated interrupt controller for the POSIX host. Every
+ *               arbitros thread runs on the process's main thread, the
+ *               'interrupts' are raised by helper threads (system timer,
+ *               stdin) which mark a source pending and signal the main
+ *               thread. The global interrupt enable is a flag, so entering
+ *               and leaving a critical section never makes a system call.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef hal_pmic_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include <signal.h>
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define hal_pmic_h
+   #define HAL_BEGIN_CRITICAL( ) bool volatile b_savedInts = \
+                                 gb_halIntsEnabled; \
+                                 gb_halIntsEnabled = false;
+   #define HAL_END_CRITICAL( ) hal_restoreInts( b_savedInts);
+   #define HAL_SEI( ) hal_restoreInts( true);
+   #define HAL_CLI( ) gb_halIntsEnabled = false;
+   #define HAL_RETI( ) hal_returnFromInt();
+   #define HAL_RET( ) hal_restoreInts( gb_halIntsEnabled);
+   #define HAL_ARE_INTS_EN( ) (gb_halIntsEnabled)
+   #define HAL_IS_ACTIVE_INT( ) (gc_halActiveInt)
+
+   /*------------------------------------------------------------------------*
+    * The host signal used to interrupt the main thread.
+    *------------------------------------------------------------------------*/
+   #define HAL_INT_SIGNAL (SIGALRM)
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+      INT_LEVEL_0 = 1,
+      INT_LEVEL_1 = 2,
+      INT_LEVEL_2 = 4
+   }t_pmicLevel;
+
+   typedef enum
+   {
+      PMIC_SRC_TIMER = 0, /*System timer overflow*/
+      PMIC_SRC_UART,      /*Byte received on stdin*/
+      PMIC_NUM_SOURCES
+
+   }t_pmicSource;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * The global interrupt enable, the equivalent of the GIE bit.
+    *------------------------------------------------------------------------*/
+   extern volatile sig_atomic_t gb_halIntsEnabled;
+
+   /*------------------------------------------------------------------------*
+    * Non-zero while an interrupt handler is executing, the equivalent of
+    * PMIC_STATUS.
+    *------------------------------------------------------------------------*/
+   extern volatile sig_atomic_t gc_halActiveInt;
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+   void hal_configureIntLevel( t_pmicLevel t_level);
+
+   /*------------------------------------------------------------------------*
+    * Sets the interrupt enable to 'b_enable' and, if enabled, runs the
+    * handlers of any sources that became pending while it was cleared.
+    *------------------------------------------------------------------------*/
+   void hal_restoreInts( bool b_enable);
+
+   /*------------------------------------------------------------------------*
+    * Marks the end of a handler that switched threads.
+    *------------------------------------------------------------------------*/
+   void hal_returnFromInt( void);
+
+   /*------------------------------------------------------------------------*
+    * Maps 'pf_isr' to 't_src'. Passing NULL unmaps the source.
+    *------------------------------------------------------------------------*/
+   void hal_registerInterrupt( t_pmicSource t_src,
+                               void (*pf_isr)( void));
+
+   /*------------------------------------------------------------------------*
+    * Marks 't_src' pending and interrupts the main thread, called by the
+    * helper threads that model the peripherals.
+    *------------------------------------------------------------------------*/
+   void hal_raiseInterrupt( t_pmicSource t_src);
+
+   /*------------------------------------------------------------------------*
+    * Returns true if 't_src' is waiting for its handler to run, the
+    * equivalent of polling an interrupt flag.
+    *------------------------------------------------------------------------*/
+   bool hal_isInterruptPending( t_pmicSource t_src);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef hal_pmic_h*/
@@ -19,9 +19,10 @@
  * Project     : Arbitros
  *               https://code.google.com/p/arbitros/
  *
- * Description : This file is responsible for setting up the processor clocks.
+ * Description : This file is responsible for setting up the processor clocks
+ *               and the free running cycle counter.
  *
- * Last Update : Nov 12, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 #ifndef hal_clocks_h
 
@@ -33,6 +34,31 @@
     * Global Defines
     *------------------------------------------------------------------------*/
    #define hal_clocks_h
+
+   /*------------------------------------------------------------------------*
+    * The cycle counter is two cascaded 16-bit timers, the overflow of the
+    * low one is routed through an event channel to clock the high one.
+    *------------------------------------------------------------------------*/
+   #define HAL_CYCLE_CNT_LOW   (TCE0)
+   #define HAL_CYCLE_CNT_HIGH  (TCE1)
+   #define HAL_CYCLE_CNT_EVMUX (EVSYS.CH7MUX)
+
+   /*------------------------------------------------------------------------*
+    * EXPERIMENTAL, never run end to end. Built with HAL_SIM_CYCLE_COUNTER
+    * the count comes from the simulator instead (see
+    * boards/simavr/examples/kernelBench/tools/simRunner.c), so it doesn't
+    * depend on the timers and event system being emulated. A write to
+    * HAL_SIM_CYCLE_LATCH has the simulator store its cycle count, low byte
+    * first, in the four bytes starting at HAL_SIM_CYCLE_COUNT. The addresses
+    * are reserved on the xmega128A1 (0x0020 - 0x002F, between the virtual
+    * ports and the CPU registers). The GPIO registers can't be used, simavr
+    * can't hook addresses below 0x20 since its mega style cores map r0-r31
+    * there.
+    *------------------------------------------------------------------------*/
+   #ifdef HAL_SIM_CYCLE_COUNTER
+      #define HAL_SIM_CYCLE_LATCH (*(volatile uint8_t *)0x0020)
+      #define HAL_SIM_CYCLE_COUNT ((volatile uint8_t *)0x0021)
+   #endif
  
    /*------------------------------------------------------------------------*
     * Include Files
@@ -45,6 +71,7 @@
     *------------------------------------------------------------------------*/
    typedef enum
    {
+      CLOCKS_COUNTER_BUSY = -2, /*Cycle counter timers are in use.*/
       CLOCKS_INVALID_FREQ = -1, /*Can't set CPU freq.*/
       CLOCKS_PASSED       = 0   /*Configuration good.*/
 
@@ -117,12 +144,53 @@
 
    }/*End hal_busyDelayUs*/
 
+   /*------------------------------------------------------------------------*
+    * Returns the number of CPU cycles since 'hal_startCycleCounter' was
+    * called, wrapping every 2^32 cycles. The high half is read on either
+    * side of the low half so a carry between the two reads is never missed.
+    *------------------------------------------------------------------------*/
+   static inline uint32_t __attribute__((always_inline)) \
+   hal_getCycleCount( void)
+   {
+   #ifdef HAL_SIM_CYCLE_COUNTER
+
+      HAL_SIM_CYCLE_LATCH = 0;
+
+      return *(volatile uint32_t *)HAL_SIM_CYCLE_COUNT;
+
+   #else
+      uint16_t s_high;
+      uint16_t s_low;
+
+      do
+      {
+         s_high = HAL_CYCLE_CNT_HIGH.CNT;
+         s_low  = HAL_CYCLE_CNT_LOW.CNT;
+
+      }while( s_high != HAL_CYCLE_CNT_HIGH.CNT);
+
+      return ((uint32_t)s_high << 16) | (uint32_t)s_low;
+
+   #endif
+   }/*End hal_getCycleCount*/
+
    /*------------------------------------------------------------------------*
     * Global Function Prototypes
     *------------------------------------------------------------------------*/
    t_clocksError hal_setCpuFreq( uint32_t i_cpuFreq);
    uint32_t hal_getCpuFreq( void);
 
+   /*------------------------------------------------------------------------*
+    * Claims TIMER_5 and TIMER_6 and starts them counting CPU cycles, with
+    * HAL_SIM_CYCLE_COUNTER the timers are left alone.
+    *------------------------------------------------------------------------*/
+   t_clocksError hal_startCycleCounter( void);
+
+   /*------------------------------------------------------------------------*
+    * Rate at which 'hal_getCycleCount' advances in counts per second.
+    *------------------------------------------------------------------------*/
+   uint32_t hal_getCycleCounterFreq( void);
+
    #ifdef __cplusplus
    }/*End extern "C"*/
    #endif
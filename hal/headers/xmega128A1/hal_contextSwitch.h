@@ -38,6 +38,13 @@
     *------------------------------------------------------------------------*/
    #define hal_contextSave_h
 
+   /*------------------------------------------------------------------------*
+    * Applied to the kernel functions that save and restore a thread's
+    * context. They manage the stack themselves, so the compiler must not
+    * generate a prologue or epilogue for them.
+    *------------------------------------------------------------------------*/
+   #define HAL_NAKED_FUNC __attribute__ ( ( naked, noinline))
+
    /*------------------------------------------------------------------------*
     * Include Files
     *------------------------------------------------------------------------*/
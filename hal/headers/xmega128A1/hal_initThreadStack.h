@@ -58,8 +58,8 @@
                              t_parameters t_parms,
                              t_arguments t_args,
                              uint8_t *pc_stackPtr,
-                             uint16_t s_endOfStackAdd,
-                             uint16_t *ps_sP);
+                             uintptr_t s_endOfStackAdd,
+                             uintptr_t *ps_sP);
                              
    #ifdef __cplusplus
    }/*End extern "C"*/
@@ -0,0 +1,102 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_clocks.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : The host clock can't be changed, the requested frequency is
+ *               remembered so code scaling delays by it behaves the same.
+ *               The rate of the cycle counter is measured against the
+ *               monotonic clock.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "hal_clocks.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static uint32_t gi_cpuFreq = F_CPU;
+
+/*---------------------------------------------------------------------------*
+ * Counts per second of 'hal_getCycleCount', 0 until it has been measured.
+ *---------------------------------------------------------------------------*/
+static uint32_t gi_cycleFreq = 0;
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_clocksError hal_setCpuFreq( uint32_t i_cpuFreq)
+{
+   if( i_cpuFreq == 0)
+      return CLOCKS_INVALID_FREQ;
+
+   gi_cpuFreq = i_cpuFreq;
+
+   return CLOCKS_PASSED;
+
+}/*End hal_setCpuFreq*/
+
+uint32_t hal_getCpuFreq( void)
+{
+   return gi_cpuFreq;
+
+}/*End hal_getCpuFreq*/
+
+t_clocksError hal_startCycleCounter( void)
+{
+#if defined( __x86_64__) || defined( __i386__)
+   struct timespec t_start;
+   struct timespec t_end;
+   struct timespec t_wait = {0, 20000000};
+   uint64_t l_startCount;
+   uint64_t l_nsec;
+
+   if( gi_cycleFreq != 0)
+      return CLOCKS_PASSED;
+
+   /*------------------------------------------------------------------------*
+    * Count the time stamp counter over a 20 msec interval.
+    *------------------------------------------------------------------------*/
+   clock_gettime( CLOCK_MONOTONIC, &t_start);
+   l_startCount = __rdtsc();
+   while( nanosleep( &t_wait, &t_wait) != 0);
+   clock_gettime( CLOCK_MONOTONIC, &t_end);
+
+   l_nsec = (uint64_t)(t_end.tv_sec - t_start.tv_sec)*1000000000ULL +
+   (uint64_t)t_end.tv_nsec - (uint64_t)t_start.tv_nsec;
+
+   gi_cycleFreq = (uint32_t)(((__rdtsc() - l_startCount)*1000000000ULL) /
+   l_nsec);
+#else
+   gi_cycleFreq = 1000000000UL;
+#endif
+
+   return CLOCKS_PASSED;
+
+}/*End hal_startCycleCounter*/
+
+uint32_t hal_getCycleCounterFreq( void)
+{
+   return gi_cycleFreq;
+
+}/*End hal_getCycleCounterFreq*/
@@ -0,0 +1,106 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_contextSwitch.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file switches the host between thread contexts.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "hal_contextSwitch.h"
+#include "hal_pmic.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The context of the thread being switched out, NULL until the first
+ * thread has been started.
+ *---------------------------------------------------------------------------*/
+static t_halContext *gpt_savedContext = NULL;
+
+/*---------------------------------------------------------------------------*
+ * Inline Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+void hal_contextSave( bool b_intsEnabled)
+{
+   t_tcb *pt_tcb;
+
+   pt_tcb = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR_CONT_CURR(gt_activeThreads);
+   gpt_savedContext = (t_halContext *)pt_tcb->s_sP;
+
+   gpt_savedContext->b_intsEnabled = b_intsEnabled;
+   gpt_savedContext->b_activeInt   = (gc_halActiveInt != 0);
+
+}/*End hal_contextSave*/
+
+void hal_contextRestore( void)
+{
+   t_tcb *pt_tcb;
+   t_halContext *pt_next;
+   t_halContext *pt_prev = gpt_savedContext;
+
+   pt_tcb  = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR_CONT_CURR(gt_activeThreads);
+   pt_next = (t_halContext *)pt_tcb->s_sP;
+
+   /*------------------------------------------------------------------------*
+    * Starting the first thread, 'main' is never returned to.
+    *------------------------------------------------------------------------*/
+   if( pt_prev == NULL)
+      setcontext( &pt_next->t_context);
+
+   if( pt_next != pt_prev)
+   {
+      swapcontext( &pt_prev->t_context,
+                   &pt_next->t_context);
+   }
+
+   /*------------------------------------------------------------------------*
+    * Running as 'pt_prev' again, put back the interrupt state it had when
+    * it was saved.
+    *------------------------------------------------------------------------*/
+   gc_halActiveInt   = pt_prev->b_activeInt;
+   gb_halIntsEnabled = pt_prev->b_intsEnabled;
+
+}/*End hal_contextRestore*/
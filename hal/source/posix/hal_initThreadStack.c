@@ -0,0 +1,140 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_initThreadStack.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for creating the host context a
+ *               thread starts running in.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <unistd.h>
+#include "arb_thread.h"
+#include "hal_initThreadStack.h"
+#include "hal_contextSwitch.h"
+#include "hal_pmic.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void hal_threadEntry( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Every context created so far. The TCB owning a context is freed when its
+ * thread is destroyed, the context is picked up again by the next thread
+ * created at the same address.
+ *---------------------------------------------------------------------------*/
+static t_halContext *gpt_contexts = NULL;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void hal_threadEntry( void)
+{
+   t_halContext *pt_context;
+   t_tcb *pt_tcb;
+
+   /*------------------------------------------------------------------------*
+    * A new thread is always the current one on the active list.
+    *------------------------------------------------------------------------*/
+   pt_tcb = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR_CONT_CURR(gt_activeThreads);
+   pt_context = (t_halContext *)pt_tcb->s_sP;
+
+   /*------------------------------------------------------------------------*
+    * Threads start with interrupts enabled, as they do on the xmega.
+    *------------------------------------------------------------------------*/
+   gc_halActiveInt = 0;
+   HAL_SEI();
+
+   pt_context->pf_thread( pt_context->t_parms,
+                          pt_context->t_args);
+
+   /*------------------------------------------------------------------------*
+    * Threads aren't supposed to return, park this one until it is
+    * preempted for good.
+    *------------------------------------------------------------------------*/
+   while( RUN_FOREVER)
+      pause();
+
+}/*End hal_threadEntry*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+void hal_initThreadStack( void *pt_function,
+                          t_parameters t_parms,
+                          t_arguments t_args,
+                          uint8_t *pc_stackPtr,
+                          uintptr_t s_endOfStackAdd,
+                          uintptr_t *ps_sP)
+{
+   t_halContext *pt_context;
+
+   /*------------------------------------------------------------------------*
+    * Keep the allocations away from any thread that might be switched in
+    * while holding the heap lock.
+    *------------------------------------------------------------------------*/
+   HAL_BEGIN_CRITICAL();
+
+   pt_context = gpt_contexts;
+   while( (pt_context != NULL) && (pt_context->i_owner != s_endOfStackAdd))
+      pt_context = pt_context->pt_next;
+
+   if( pt_context == NULL)
+   {
+      pt_context = calloc( 1, sizeof( t_halContext));
+      if( pt_context != NULL)
+         pt_context->pc_stack = malloc( HAL_HOST_STACK_BYTES);
+
+      if( (pt_context == NULL) || (pt_context->pc_stack == NULL))
+         exit(0);
+
+      pt_context->i_owner = s_endOfStackAdd;
+      pt_context->pt_next = gpt_contexts;
+      gpt_contexts = pt_context;
+
+   }/*End if( pt_context == NULL)*/
+
+   HAL_END_CRITICAL();
+
+   pt_context->pf_thread = (void (*)( t_parameters, t_arguments))pt_function;
+   pt_context->t_parms   = t_parms;
+   pt_context->t_args    = t_args;
+
+   getcontext( &pt_context->t_context);
+   pt_context->t_context.uc_stack.ss_sp   = pt_context->pc_stack;
+   pt_context->t_context.uc_stack.ss_size = HAL_HOST_STACK_BYTES;
+   pt_context->t_context.uc_link          = NULL;
+   sigemptyset( &pt_context->t_context.uc_sigmask);
+   makecontext( &pt_context->t_context, &hal_threadEntry, 0);
+
+   /*------------------------------------------------------------------------*
+    * The TCB's stack pointer refers to the context instead.
+    *------------------------------------------------------------------------*/
+   *ps_sP = (uintptr_t)pt_context;
+
+}/*End hal_initThreadStack*/
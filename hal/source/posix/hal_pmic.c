@@ -0,0 +1,185 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_pmic.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file simulates the programmable interrupt controller
+ *               on a POSIX host. Pending sources are kept in a bit mask set
+ *               by the helper threads, the main thread runs their handlers
+ *               either from its signal handler or the moment interrupts are
+ *               re-enabled.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <pthread.h>
+#include <errno.h>
+#include "hal_pmic.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void hal_dispatchInts( void);
+static void hal_intSignal( int i_signal);
+
+/*---------------------------------------------------------------------------*
+ * Public Global Variables
+ *---------------------------------------------------------------------------*/
+volatile sig_atomic_t gb_halIntsEnabled = false;
+volatile sig_atomic_t gc_halActiveInt = 0;
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Bit 'n' is set when source 'n' is waiting to be serviced, written by the
+ * helper threads so it is only accessed atomically.
+ *---------------------------------------------------------------------------*/
+static volatile uint32_t gi_pendingInts = 0;
+
+static void (*gapf_isr[PMIC_NUM_SOURCES])( void);
+
+/*---------------------------------------------------------------------------*
+ * The host thread all the arbitros threads run on.
+ *---------------------------------------------------------------------------*/
+static pthread_t gt_mainThread;
+
+/*---------------------------------------------------------------------------*
+ * Inline Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void hal_dispatchInts( void)
+{
+   uint8_t c_src;
+
+   /*------------------------------------------------------------------------*
+    * Only called with interrupts enabled. Handlers run one at a time with
+    * interrupts disabled, lowest source first. A handler that switches
+    * threads returns here once the interrupted thread is resumed.
+    *------------------------------------------------------------------------*/
+   while( gi_pendingInts != 0)
+   {
+      gb_halIntsEnabled = false;
+
+      c_src = (uint8_t)__builtin_ctz( gi_pendingInts);
+      __atomic_fetch_and( &gi_pendingInts,
+                          ~((uint32_t)1 << c_src),
+                          __ATOMIC_SEQ_CST);
+
+      if( gapf_isr[c_src] != NULL)
+      {
+         gc_halActiveInt = 1;
+         gapf_isr[c_src]();
+      }
+
+      gc_halActiveInt   = 0;
+      gb_halIntsEnabled = true;
+
+   }/*End while( gi_pendingInts != 0)*/
+
+}/*End hal_dispatchInts*/
+
+static void hal_intSignal( int i_signal)
+{
+   int i_errno = errno;
+
+   /*------------------------------------------------------------------------*
+    * With interrupts disabled the source stays pending until they are
+    * turned back on.
+    *------------------------------------------------------------------------*/
+   if( gb_halIntsEnabled)
+      hal_dispatchInts();
+
+   errno = i_errno;
+
+}/*End hal_intSignal*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+void hal_configureIntLevel( t_pmicLevel t_level)
+{
+   struct sigaction t_action;
+
+   /*------------------------------------------------------------------------*
+    * There is a single interrupt level on the host, this call just
+    * connects the controller to the thread running the kernel.
+    *------------------------------------------------------------------------*/
+   gt_mainThread = pthread_self();
+
+   memset( &t_action, 0, sizeof( t_action));
+   t_action.sa_handler = &hal_intSignal;
+   t_action.sa_flags   = SA_RESTART;
+   sigemptyset( &t_action.sa_mask);
+   sigaction( HAL_INT_SIGNAL, &t_action, NULL);
+
+}/*End hal_configureIntLevel*/
+
+void hal_restoreInts( bool b_enable)
+{
+   gb_halIntsEnabled = b_enable;
+
+   if( b_enable && (gi_pendingInts != 0))
+      hal_dispatchInts();
+
+}/*End hal_restoreInts*/
+
+void hal_returnFromInt( void)
+{
+   gc_halActiveInt = 0;
+
+}/*End hal_returnFromInt*/
+
+void hal_registerInterrupt( t_pmicSource t_src,
+                            void (*pf_isr)( void))
+{
+   gapf_isr[t_src] = pf_isr;
+
+}/*End hal_registerInterrupt*/
+
+void hal_raiseInterrupt( t_pmicSource t_src)
+{
+   __atomic_fetch_or( &gi_pendingInts,
+                      (uint32_t)1 << t_src,
+                      __ATOMIC_SEQ_CST);
+
+   pthread_kill( gt_mainThread, HAL_INT_SIGNAL);
+
+}/*End hal_raiseInterrupt*/
+
+bool hal_isInterruptPending( t_pmicSource t_src)
+{
+   return (gi_pendingInts & ((uint32_t)1 << t_src)) != 0;
+
+}/*End hal_isInterruptPending*/
@@ -0,0 +1,377 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_timer.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file emulates a timer module on a POSIX host. A host
+ *               thread wakes up at each absolute period boundary and raises
+ *               the overflow interrupt, the count is derived from the time
+ *               elapsed since the last boundary.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <pthread.h>
+#include <time.h>
+#include "hal_timer.h"
+#include "hal_pmic.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define MAX_TIMER_RANGE (65535)
+#define NSEC_PER_SEC    (1000000000LL)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   t_timerModId t_id;
+
+   /*------------------------------------------------------------------------*
+    * True once 'hal_configureTimer' has been called.
+    *------------------------------------------------------------------------*/
+   bool b_configured;
+
+   /*------------------------------------------------------------------------*
+    * The count the timer overflows at and the rate it counts at, picked
+    * the same way the xmega driver picks its clock divisor.
+    *------------------------------------------------------------------------*/
+   int32_t i_topTicks;
+   int64_t l_ticksPerSec;
+   int64_t l_periodNsec;
+
+   /*------------------------------------------------------------------------*
+    * Monotonic time (nsec) of the last overflow, written by the timer
+    * thread.
+    *------------------------------------------------------------------------*/
+   volatile int64_t l_lastOverflow;
+
+   bool b_running;
+   pthread_t t_thread;
+
+}t_timerHndl;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void *hal_timerThread( void *pv_arg);
+static int64_t hal_nsecNow( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static const int16_t as_divisor[] = {1, 2, 4, 8, 64, 256, 1024};
+
+/*---------------------------------------------------------------------------*
+ * Only the one timer, the host just needs a system tick.
+ *---------------------------------------------------------------------------*/
+static t_timerHndl *gpt_timer = NULL;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static int64_t hal_nsecNow( void)
+{
+   struct timespec t_now;
+
+   clock_gettime( CLOCK_MONOTONIC, &t_now);
+
+   return (int64_t)t_now.tv_sec*NSEC_PER_SEC + t_now.tv_nsec;
+
+}/*End hal_nsecNow*/
+
+static void *hal_timerThread( void *pv_arg)
+{
+   t_timerHndl *pt_timerHndl = (t_timerHndl *)pv_arg;
+   struct timespec t_next;
+   int64_t l_next;
+
+   /*------------------------------------------------------------------------*
+    * Sleep to absolute boundaries so the period doesn't drift with the
+    * time spent raising the interrupt.
+    *------------------------------------------------------------------------*/
+   l_next = pt_timerHndl->l_lastOverflow;
+
+   while( true)
+   {
+      l_next += pt_timerHndl->l_periodNsec;
+      t_next.tv_sec  = (time_t)(l_next / NSEC_PER_SEC);
+      t_next.tv_nsec = (long)(l_next % NSEC_PER_SEC);
+
+      while( clock_nanosleep( CLOCK_MONOTONIC,
+                              TIMER_ABSTIME,
+                              &t_next,
+                              NULL) != 0);
+
+      __atomic_store_n( &pt_timerHndl->l_lastOverflow,
+                        l_next,
+                        __ATOMIC_SEQ_CST);
+
+      hal_raiseInterrupt( PMIC_SRC_TIMER);
+
+   }/*End while( true)*/
+
+   return NULL;
+
+}/*End hal_timerThread*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_timerError hal_requestTimerInterrupt( t_TIMERHNDL t_handle,
+                                        t_compType  t_type,
+                                        void (*pf_funPtr)( void))
+{
+   if( (t_timerHndl *)t_handle != gpt_timer)
+      return TIMER_INVALID_HANDLE;
+
+   if( t_type != OVERFLOW)
+      return TIMER_INVALID_COMP;
+
+   hal_registerInterrupt( PMIC_SRC_TIMER, pf_funPtr);
+
+   return TIMER_PASSED;
+
+}/*End hal_requestTimerInterrupt*/
+
+t_timerError hal_releaseTimerInterrupt( t_TIMERHNDL t_handle,
+                                        t_compType  t_type)
+{
+   if( (t_timerHndl *)t_handle != gpt_timer)
+      return TIMER_INVALID_HANDLE;
+
+   if( t_type != OVERFLOW)
+      return TIMER_INVALID_COMP;
+
+   hal_registerInterrupt( PMIC_SRC_TIMER, NULL);
+
+   return TIMER_PASSED;
+
+}/*End hal_releaseTimerInterrupt*/
+
+t_timerError hal_configureTimer( t_TIMERHNDL t_handle,
+                                 t_timerConfig t_conf)
+{
+   t_timerHndl *pt_timerHndl = (t_timerHndl *)t_handle;
+   uint8_t c_index;
+   int32_t i_topTicks = 0;
+
+   if( (pt_timerHndl == NULL) || (pt_timerHndl != gpt_timer))
+      return TIMER_INVALID_HANDLE;
+
+   if( t_conf.t_mode != NORMAL)
+      return TIMER_INVALID_WF_MODE;
+
+   if( t_conf.t_dir != DIRECTION_UP)
+      return TIMER_INVALID_DIR;
+
+   /*------------------------------------------------------------------------*
+    * Find a clock divisor that gives enough resolution for the requested
+    * period.
+    *------------------------------------------------------------------------*/
+   for( c_index = 0; c_index < 7; c_index++)
+   {
+      i_topTicks = (int32_t)(((float)F_CPU*t_conf.f_period) /
+      as_divisor[c_index]);
+
+      if( i_topTicks < MAX_TIMER_RANGE)
+         break;
+
+   }/*End for( c_index = 0; c_index < 7; c_index++)*/
+
+   if( (c_index == 7) || (i_topTicks <= 0))
+      return TIMER_INVALID_PERIOD;
+
+   pt_timerHndl->i_topTicks    = i_topTicks;
+   pt_timerHndl->l_ticksPerSec = (int64_t)F_CPU / as_divisor[c_index];
+   pt_timerHndl->l_periodNsec  = ((int64_t)i_topTicks*NSEC_PER_SEC) /
+                                 pt_timerHndl->l_ticksPerSec;
+   pt_timerHndl->b_configured  = true;
+
+   return TIMER_PASSED;
+
+}/*End hal_configureTimer*/
+
+t_TIMERHNDL hal_requestTimer( t_timerModId t_id)
+{
+   if( gpt_timer != NULL)
+      return (t_TIMERHNDL)TIMER_MODULE_OPEN;
+
+   gpt_timer = calloc( 1, sizeof( t_timerHndl));
+   if( gpt_timer == NULL)
+      return (t_TIMERHNDL)TIMER_OUT_OF_HEAP;
+
+   gpt_timer->t_id = t_id;
+
+   return (t_TIMERHNDL)gpt_timer;
+
+}/*End hal_requestTimer*/
+
+t_timerError hal_releaseTimer( t_TIMERHNDL t_handle)
+{
+   if( (gpt_timer == NULL) || ((t_timerHndl *)t_handle != gpt_timer))
+      return TIMER_INVALID_HANDLE;
+
+   hal_stopTimer( t_handle);
+   hal_registerInterrupt( PMIC_SRC_TIMER, NULL);
+
+   free( gpt_timer);
+   gpt_timer = NULL;
+
+   return TIMER_PASSED;
+
+}/*End hal_releaseTimer*/
+
+t_timerError hal_startTimer( t_TIMERHNDL t_handle)
+{
+   t_timerHndl *pt_timerHndl = (t_timerHndl *)t_handle;
+
+   if( (pt_timerHndl == NULL) || (pt_timerHndl != gpt_timer))
+      return TIMER_INVALID_HANDLE;
+
+   if( pt_timerHndl->b_configured == false)
+      return TIMER_NO_CONFIG;
+
+   if( pt_timerHndl->b_running == true)
+      return TIMER_PASSED;
+
+   pt_timerHndl->l_lastOverflow = hal_nsecNow();
+
+   if( pthread_create( &pt_timerHndl->t_thread,
+                       NULL,
+                       &hal_timerThread,
+                       pt_timerHndl) != 0)
+   {
+      return TIMER_OUT_OF_HEAP;
+   }
+
+   pt_timerHndl->b_running = true;
+
+   return TIMER_PASSED;
+
+}/*End hal_startTimer*/
+
+t_timerError hal_stopTimer( t_TIMERHNDL t_handle)
+{
+   t_timerHndl *pt_timerHndl = (t_timerHndl *)t_handle;
+
+   if( (pt_timerHndl == NULL) || (pt_timerHndl != gpt_timer))
+      return TIMER_INVALID_HANDLE;
+
+   if( pt_timerHndl->b_running == true)
+   {
+      pthread_cancel( pt_timerHndl->t_thread);
+      pthread_join( pt_timerHndl->t_thread, NULL);
+      pt_timerHndl->b_running = false;
+   }
+
+   return TIMER_PASSED;
+
+}/*End hal_stopTimer*/
+
+int32_t hal_getTimerCount( t_TIMERHNDL t_handle)
+{
+   t_timerHndl *pt_timerHndl = (t_timerHndl *)t_handle;
+   int64_t l_elapsed;
+   int64_t l_count;
+
+   if( (pt_timerHndl == NULL) || (pt_timerHndl != gpt_timer))
+      return (int32_t)TIMER_INVALID_HANDLE;
+
+   if( pt_timerHndl->b_running == false)
+      return 0;
+
+   l_elapsed = hal_nsecNow() - __atomic_load_n( &pt_timerHndl->l_lastOverflow,
+                                                __ATOMIC_SEQ_CST);
+
+   l_count = (l_elapsed*pt_timerHndl->l_ticksPerSec) / NSEC_PER_SEC;
+
+   /*------------------------------------------------------------------------*
+    * The timer thread can run late, the real counter would have wrapped.
+    *------------------------------------------------------------------------*/
+   if( l_count > pt_timerHndl->i_topTicks)
+      l_count = pt_timerHndl->i_topTicks;
+
+   return (int32_t)l_count;
+
+}/*End hal_getTimerCount*/
+
+t_timerError hal_setCompareValue( t_TIMERHNDL t_handle,
+                                  t_compType  t_type,
+                                  uint16_t    s_value)
+{
+   return TIMER_INVALID_COMP;
+
+}/*End hal_setCompareValue*/
+
+int32_t hal_getCompareValue( t_TIMERHNDL t_handle,
+                             t_compType  t_type)
+{
+   return (int32_t)TIMER_INVALID_COMP;
+
+}/*End hal_getCompareValue*/
+
+int16_t hal_getIntStatus( t_TIMERHNDL t_handle,
+                          t_compType  t_type)
+{
+   if( (t_timerHndl *)t_handle != gpt_timer)
+      return (int16_t)TIMER_INVALID_HANDLE;
+
+   if( t_type != OVERFLOW)
+      return (int16_t)TIMER_INVALID_COMP;
+
+   return (int16_t)hal_isInterruptPending( PMIC_SRC_TIMER);
+
+}/*End hal_getIntStatus*/
+
+t_timerError hal_clearIntStatus( t_TIMERHNDL t_handle,
+                                 t_compType  t_type)
+{
+   return TIMER_INVALID_COMP;
+
+}/*End hal_clearIntStatus*/
+
+t_timerError hal_enableCompareChannel( t_TIMERHNDL t_handle,
+                                       t_compType t_type,
+                                       bool b_ouputOnPin)
+{
+   return TIMER_INVALID_COMP;
+
+}/*End hal_enableCompareChannel*/
+
+t_timerError hal_disableCompareChannel( t_TIMERHNDL t_handle,
+                                        t_compType  t_type)
+{
+   return TIMER_INVALID_COMP;
+
+}/*End hal_disableCompareChannel*/
+
+int32_t hal_getPeriodValue( t_TIMERHNDL t_handle)
+{
+   if( (gpt_timer == NULL) || ((t_timerHndl *)t_handle != gpt_timer))
+      return (int32_t)TIMER_INVALID_HANDLE;
+
+   return gpt_timer->i_topTicks;
+
+}/*End hal_getPeriodValue*/
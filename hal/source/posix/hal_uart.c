@@ -0,0 +1,329 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_uart.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file maps a uart channel onto stdin and stdout. A host
+ *               thread blocks on stdin and queues what it reads, the bytes
+ *               are handed to the rx callback from the PMIC_SRC_UART
+ *               interrupt. Writes go straight to stdout with 'write' so they
+ *               never take a libc lock a preempted thread might be holding.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <pthread.h>
+#include <unistd.h>
+#include "hal_uart.h"
+#include "hal_pmic.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define UART_RX_QUEUE_SIZE (256) /*Must be a power of two*/
+#define UART_RX_QUEUE_MASK (UART_RX_QUEUE_SIZE - 1)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   t_uartChanId t_id;
+
+   /*------------------------------------------------------------------------*
+    * True once 'hal_configureUartChannel' has been called.
+    *------------------------------------------------------------------------*/
+   bool b_configured;
+
+   uint32_t i_baudRate;
+
+   void (*pf_rxCallBack)( uint16_t s_data);
+   void (*pf_txCallBack)( uint16_t s_size);
+
+   volatile bool b_rxIntEnabled;
+
+   /*------------------------------------------------------------------------*
+    * Bytes read from stdin, 'c_head' is written by the reader thread and
+    * 'c_tail' by the interrupt.
+    *------------------------------------------------------------------------*/
+   uint8_t ac_rxQueue[UART_RX_QUEUE_SIZE];
+   volatile uint32_t i_head;
+   volatile uint32_t i_tail;
+
+   bool b_readerRunning;
+   pthread_t t_reader;
+
+}t_uartChanHndl;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void *hal_uartReader( void *pv_arg);
+static void hal_uartRxInterrupt( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The host has one console, so only one channel can be open.
+ *---------------------------------------------------------------------------*/
+static t_uartChanHndl *gpt_uart = NULL;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void *hal_uartReader( void *pv_arg)
+{
+   t_uartChanHndl *pt_uartChanHndl = (t_uartChanHndl *)pv_arg;
+   uint8_t c_byte;
+   uint32_t i_head;
+
+   while( read( STDIN_FILENO, &c_byte, 1) == 1)
+   {
+      /*---------------------------------------------------------------------*
+       * Like an overrun on the real part, a byte arriving with the queue
+       * full is lost.
+       *---------------------------------------------------------------------*/
+      i_head = pt_uartChanHndl->i_head;
+      if( (i_head - __atomic_load_n( &pt_uartChanHndl->i_tail,
+          __ATOMIC_SEQ_CST)) < UART_RX_QUEUE_SIZE)
+      {
+         pt_uartChanHndl->ac_rxQueue[i_head & UART_RX_QUEUE_MASK] = c_byte;
+         __atomic_store_n( &pt_uartChanHndl->i_head,
+                           i_head + 1,
+                           __ATOMIC_SEQ_CST);
+      }
+
+      hal_raiseInterrupt( PMIC_SRC_UART);
+
+   }/*End while( read( STDIN_FILENO, &c_byte, 1) == 1)*/
+
+   return NULL;
+
+}/*End hal_uartReader*/
+
+static void hal_uartRxInterrupt( void)
+{
+   t_uartChanHndl *pt_uartChanHndl = gpt_uart;
+   uint8_t c_byte;
+
+   if( pt_uartChanHndl == NULL)
+      return;
+
+   while( (pt_uartChanHndl->b_rxIntEnabled == true) &&
+          (pt_uartChanHndl->i_tail != __atomic_load_n( &pt_uartChanHndl->
+          i_head, __ATOMIC_SEQ_CST)))
+   {
+      c_byte = pt_uartChanHndl->ac_rxQueue[pt_uartChanHndl->i_tail &
+      UART_RX_QUEUE_MASK];
+      __atomic_store_n( &pt_uartChanHndl->i_tail,
+                        pt_uartChanHndl->i_tail + 1,
+                        __ATOMIC_SEQ_CST);
+
+      if( pt_uartChanHndl->pf_rxCallBack != NULL)
+         pt_uartChanHndl->pf_rxCallBack( (uint16_t)c_byte);
+
+   }
+
+}/*End hal_uartRxInterrupt*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
+{
+   if( gpt_uart != NULL)
+      return (t_UARTHNDL)UART_CHANNEL_OPEN;
+
+   gpt_uart = calloc( 1, sizeof( t_uartChanHndl));
+   if( gpt_uart == NULL)
+      return (t_UARTHNDL)UART_OUT_OF_HEAP;
+
+   gpt_uart->t_id = t_chanId;
+
+   return (t_UARTHNDL)gpt_uart;
+
+}/*End hal_requestUartChannel*/
+
+t_uartError hal_releaseUartChannel( t_UARTHNDL t_handle)
+{
+   if( (gpt_uart == NULL) || ((t_uartChanHndl *)t_handle != gpt_uart))
+      return UART_INVALID_HANDLE;
+
+   hal_registerInterrupt( PMIC_SRC_UART, NULL);
+
+   /*------------------------------------------------------------------------*
+    * The reader can't be woken from a blocking read, leave it running and
+    * just drop what it queues from now on.
+    *------------------------------------------------------------------------*/
+   if( gpt_uart->b_readerRunning == false)
+      free( gpt_uart);
+
+   gpt_uart = NULL;
+
+   return UART_PASSED;
+
+}/*End hal_releaseUartChannel*/
+
+t_uartError hal_configureUartChannel( t_UARTHNDL t_handle,
+                                      t_uartConfig t_conf)
+{
+   t_uartChanHndl *pt_uartChanHndl = (t_uartChanHndl *)t_handle;
+
+   if( (pt_uartChanHndl == NULL) || (pt_uartChanHndl != gpt_uart))
+      return UART_INVALID_HANDLE;
+
+   if( t_conf.t_comMd != ASYNC)
+      return UART_MODE_NOT_SUPPORTED;
+
+   if( t_conf.i_baudRate == 0)
+      return UART_INVALID_BAUD_RATE;
+
+   pt_uartChanHndl->i_baudRate     = t_conf.i_baudRate;
+   pt_uartChanHndl->pf_rxCallBack  = t_conf.pf_rxCallBack;
+   pt_uartChanHndl->pf_txCallBack  = t_conf.pf_txCallBack;
+   pt_uartChanHndl->b_rxIntEnabled = (t_conf.pf_rxCallBack != NULL);
+   pt_uartChanHndl->b_configured   = true;
+
+   hal_registerInterrupt( PMIC_SRC_UART, &hal_uartRxInterrupt);
+
+   if( (pt_uartChanHndl->pf_rxCallBack != NULL) &&
+       (pt_uartChanHndl->b_readerRunning == false))
+   {
+      if( pthread_create( &pt_uartChanHndl->t_reader,
+                          NULL,
+                          &hal_uartReader,
+                          pt_uartChanHndl) != 0)
+      {
+         return UART_OUT_OF_HEAP;
+      }
+
+      pthread_detach( pt_uartChanHndl->t_reader);
+      pt_uartChanHndl->b_readerRunning = true;
+
+   }
+
+   return UART_PASSED;
+
+}/*End hal_configureUartChannel*/
+
+t_uartError hal_enableUartRxInt( t_UARTHNDL t_handle)
+{
+   t_uartChanHndl *pt_uartChanHndl = (t_uartChanHndl *)t_handle;
+
+   if( (pt_uartChanHndl == NULL) || (pt_uartChanHndl != gpt_uart))
+      return UART_INVALID_HANDLE;
+
+   if( pt_uartChanHndl->b_configured == false)
+      return UART_NO_CONFIG;
+
+   pt_uartChanHndl->b_rxIntEnabled = true;
+
+   /*------------------------------------------------------------------------*
+    * Bytes that arrived while the interrupt was off are delivered now.
+    *------------------------------------------------------------------------*/
+   if( pt_uartChanHndl->i_tail != pt_uartChanHndl->i_head)
+      hal_raiseInterrupt( PMIC_SRC_UART);
+
+   return UART_PASSED;
+
+}/*End hal_enableUartRxInt*/
+
+t_uartError hal_disableUartRxInt( t_UARTHNDL t_handle)
+{
+   t_uartChanHndl *pt_uartChanHndl = (t_uartChanHndl *)t_handle;
+
+   if( (pt_uartChanHndl == NULL) || (pt_uartChanHndl != gpt_uart))
+      return UART_INVALID_HANDLE;
+
+   pt_uartChanHndl->b_rxIntEnabled = false;
+
+   return UART_PASSED;
+
+}/*End hal_disableUartRxInt*/
+
+t_uartError hal_uartWriteByte( t_UARTHNDL t_handle,
+                               uint8_t c_byte)
+{
+   if( (gpt_uart == NULL) || ((t_uartChanHndl *)t_handle != gpt_uart))
+      return UART_INVALID_HANDLE;
+
+   while( write( STDOUT_FILENO, &c_byte, 1) < 0);
+
+   return UART_PASSED;
+
+}/*End hal_uartWriteByte*/
+
+t_uartError hal_uartReadBlock( t_UARTHNDL t_handle,
+                               int8_t *pc_rxBuffer,
+                               uint16_t s_numBytes)
+{
+   return UART_MODE_NOT_SUPPORTED;
+
+}/*End hal_uartReadBlock*/
+
+t_uartError hal_uartWriteBlock( t_UARTHNDL t_handle,
+                                int8_t *pc_txBuffer,
+                                uint16_t s_numBytes)
+{
+   t_uartChanHndl *pt_uartChanHndl = (t_uartChanHndl *)t_handle;
+   ssize_t i_written;
+   uint16_t s_index = 0;
+
+   if( (pt_uartChanHndl == NULL) || (pt_uartChanHndl != gpt_uart))
+      return UART_INVALID_HANDLE;
+
+   /*------------------------------------------------------------------------*
+    * Always transmitted in place, as the xmega driver does when there is
+    * no tx callback.
+    *------------------------------------------------------------------------*/
+   while( s_index < s_numBytes)
+   {
+      i_written = write( STDOUT_FILENO,
+                         &pc_txBuffer[s_index],
+                         s_numBytes - s_index);
+      if( i_written > 0)
+         s_index += (uint16_t)i_written;
+   }
+
+   if( pt_uartChanHndl->pf_txCallBack != NULL)
+      pt_uartChanHndl->pf_txCallBack( s_numBytes);
+
+   return UART_PASSED;
+
+}/*End hal_uartWriteBlock*/
+
+int32_t hal_uartGetDataAddress( t_UARTHNDL t_handle)
+{
+   return (int32_t)UART_MODE_NOT_SUPPORTED;
+
+}/*End hal_uartGetDataAddress*/
+
+int32_t hal_uartGetBaudRate( t_UARTHNDL t_handle)
+{
+   if( (gpt_uart == NULL) || ((t_uartChanHndl *)t_handle != gpt_uart))
+      return (int32_t)UART_INVALID_HANDLE;
+
+   return (int32_t)gpt_uart->i_baudRate;
+
+}/*End hal_uartGetBaudRate*/
@@ -0,0 +1,136 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : hal_watchDog.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : The host has nothing to reset, this file only keeps track of
+ *               who owns the watchdog so callers see the same errors they
+ *               would on the xmega.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "hal_watchDog.h"
+#include "hal_pmic.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define WD_MAX_PERIOD (8000) /*Longest period on the xmega, in milliseconds*/
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   bool b_validConfig;
+   uint32_t i_period;
+   bool b_enabled;
+
+}t_wdObject;
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static t_wdObject *gpt_wd = NULL;
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_WDHNDL hal_requestWdAccess( void)
+{
+   t_wdObject *pt_wd;
+
+   HAL_BEGIN_CRITICAL(); //Disable interrupts
+
+   if( gpt_wd != NULL)
+   {
+      HAL_END_CRITICAL(); //Enable interrupts
+      return (t_WDHNDL)WD_UNAVAILABLE;
+   }
+
+   pt_wd = calloc( 1, sizeof( t_wdObject));
+   gpt_wd = pt_wd;
+
+   HAL_END_CRITICAL(); //Enable interrupts
+
+   if( pt_wd == NULL)
+      return (t_WDHNDL)WD_OUT_OF_HEAP;
+
+   return (t_WDHNDL)pt_wd;
+
+}/*End hal_requestWdAccess*/
+
+t_wdError hal_releaseWdAccess( t_WDHNDL t_handle)
+{
+   if( (gpt_wd == NULL) || ((t_wdObject *)t_handle != gpt_wd))
+      return WD_INVALID_HANDLE;
+
+   HAL_BEGIN_CRITICAL(); //Disable interrupts
+   free( gpt_wd);
+   gpt_wd = NULL;
+   HAL_END_CRITICAL(); //Enable interrupts
+
+   return WD_PASSED;
+
+}/*End hal_releaseWdAccess*/
+
+t_wdError hal_configureWd( t_WDHNDL t_handle,
+                           t_wdConfig t_conf)
+{
+   if( (gpt_wd == NULL) || ((t_wdObject *)t_handle != gpt_wd))
+      return WD_INVALID_HANDLE;
+
+   if( (t_conf.i_period == 0) || (t_conf.i_period > WD_MAX_PERIOD))
+      return WD_INVALID_PERIOD;
+
+   gpt_wd->i_period      = t_conf.i_period;
+   gpt_wd->b_validConfig = true;
+
+   return WD_PASSED;
+
+}/*End hal_configureWd*/
+
+t_wdError hal_wdEnable( t_WDHNDL t_handle)
+{
+   if( (gpt_wd == NULL) || ((t_wdObject *)t_handle != gpt_wd))
+      return WD_INVALID_HANDLE;
+
+   if( gpt_wd->b_validConfig == false)
+      return WD_NO_CONFIG;
+
+   gpt_wd->b_enabled = true;
+
+   return WD_PASSED;
+
+}/*End hal_wdEnable*/
+
+t_wdError hal_wdDisable( t_WDHNDL t_handle)
+{
+   if( (gpt_wd == NULL) || ((t_wdObject *)t_handle != gpt_wd))
+      return WD_INVALID_HANDLE;
+
+   gpt_wd->b_enabled = false;
+
+   return WD_PASSED;
+
+}/*End hal_wdDisable*/
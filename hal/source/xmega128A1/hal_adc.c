@@ -33,7 +33,8 @@
 #include <stddef.h>
 #include <avr\pgmspace.h>
 #include "hal_adc.h"
-#include "utl_linkedList.h"
+#include "utl_linkedlist.h"
+#include "utl_handleTable.h"
 #include "hal_pmic.h"
 #include "hal_clocks.h"
 
@@ -45,6 +46,8 @@
 #define ADC_MIN_CONV_FREQ                (100000)  /*hz*/
 #define ADC_NUM_OF_MODULES               (2)
 #define ADC_NUM_CHAN_PER_MOD             (4)
+#define ADC_NUM_CHANNELS                 (ADC_NUM_OF_MODULES*\
+                                          ADC_NUM_CHAN_PER_MOD)
 
 /*---------------------------------------------------------------------------*
  * Private Datatypes
@@ -64,6 +67,12 @@ typedef enum
 
 typedef struct
 {
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_adcChanList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * The module associated with this particular ADC virtual channel.
     *------------------------------------------------------------------------*/
@@ -100,8 +109,6 @@ static t_LINKHNDL createChanHandle( t_chanId t_id);
 static t_adcError isGainValid( t_adcChanConf *pt_chan,
                                ADC_CH_GAIN_t *pt_gain);
 
-static t_chanHandle *adc_findChannelElement( t_chanId t_id);
-
 static t_LINKHNDL createChannelAdcA( void);
 
 static t_LINKHNDL createChannelAdcB( void);
@@ -125,6 +132,11 @@ static bool gt_adcModConfigured[ADC_NUM_OF_MODULES] = {false, false};
  *---------------------------------------------------------------------------*/
 UTL_CREATE_CONTAINER( gt_adcChanList);
 
+/*---------------------------------------------------------------------------*
+ * Maps an ADC channel ID to its open handle, used directly by the ISRs.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CREATE( gt_adcChanTable, ADC_NUM_CHANNELS);
+
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
  *---------------------------------------------------------------------------*/
@@ -136,7 +148,7 @@ ISR( ADCA_CH0_vect)
 {
    t_chanHandle *pt_element = NULL;
 
-   pt_element = adc_findChannelElement( ADC1_CHAN0);
+   pt_element = utl_getHandle( &gt_adcChanTable, ADC1_CHAN0);
    if( pt_element != NULL)
    {
       /*---------------------------------------------------------------------*
@@ -153,7 +165,7 @@ ISR( ADCA_CH1_vect)
 {
    t_chanHandle *pt_element = NULL;
 
-   pt_element = adc_findChannelElement( ADC1_CHAN1);
+   pt_element = utl_getHandle( &gt_adcChanTable, ADC1_CHAN1);
    if( pt_element != NULL)
    {
       /*---------------------------------------------------------------------*
@@ -170,7 +182,7 @@ ISR( ADCA_CH2_vect)
 {
    t_chanHandle *pt_element = NULL;
 
-   pt_element = adc_findChannelElement( ADC1_CHAN2);
+   pt_element = utl_getHandle( &gt_adcChanTable, ADC1_CHAN2);
    if( pt_element != NULL)
    {
       /*---------------------------------------------------------------------*
@@ -187,7 +199,7 @@ ISR( ADCA_CH3_vect)
 {
    t_chanHandle *pt_element = NULL;
 
-   pt_element = adc_findChannelElement( ADC1_CHAN3);
+   pt_element = utl_getHandle( &gt_adcChanTable, ADC1_CHAN3);
    if( pt_element != NULL)
    {
       /*---------------------------------------------------------------------*
@@ -204,7 +216,7 @@ ISR( ADCB_CH0_vect)
 {
    t_chanHandle *pt_element = NULL;
 
-   pt_element = adc_findChannelElement( ADC2_CHAN0);
+   pt_element = utl_getHandle( &gt_adcChanTable, ADC2_CHAN0);
    if( pt_element != NULL)
    {
       /*---------------------------------------------------------------------*
@@ -221,7 +233,7 @@ ISR( ADCB_CH1_vect)
 {
    t_chanHandle *pt_element = NULL;
 
-   pt_element = adc_findChannelElement( ADC2_CHAN1);
+   pt_element = utl_getHandle( &gt_adcChanTable, ADC2_CHAN1);
    if( pt_element != NULL)
    {
       /*---------------------------------------------------------------------*
@@ -238,7 +250,7 @@ ISR( ADCB_CH2_vect)
 {
    t_chanHandle *pt_element = NULL;
 
-   pt_element = adc_findChannelElement( ADC2_CHAN2);
+   pt_element = utl_getHandle( &gt_adcChanTable, ADC2_CHAN2);
    if( pt_element != NULL)
    {
       /*---------------------------------------------------------------------*
@@ -255,7 +267,7 @@ ISR( ADCB_CH3_vect)
 {
    t_chanHandle *pt_element = NULL;
 
-   pt_element = adc_findChannelElement( ADC2_CHAN3);
+   pt_element = utl_getHandle( &gt_adcChanTable, ADC2_CHAN3);
    if( pt_element != NULL)
    {
       /*---------------------------------------------------------------------*
@@ -355,37 +367,14 @@ static t_LINKHNDL createChanHandle( t_chanId t_id)
                            t_linkHndl,
                            true);
 
+   utl_insertHandle( &gt_adcChanTable,
+                     t_id,
+                     pt_element);
+
    return t_linkHndl;
 
 }/*End createChanHandle*/
 
-static t_chanHandle *adc_findChannelElement( t_chanId t_id)
-{
-   t_LINKHNDL t_linkHndl;
-   t_chanHandle *pt_element;
-   int16_t s_count;
-
-   /*------------------------------------------------------------------------*
-    * Find the ADC channel with an ID of t_id
-    *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_adcChanList, s_count)
-   {
-      pt_element = (t_chanHandle *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-      if( pt_element->t_id == t_id)
-      {
-         return pt_element;
-      }
-
-   }
-
-   /*------------------------------------------------------------------------*
-    * If we make it this far the ID has not been found in the open ADC
-    * channel list.
-    *------------------------------------------------------------------------*/
-   return NULL;
-
-}/*End adc_findChannelElement*/
-
 static t_adcError isGainValid( t_adcChanConf *pt_chan,
                                ADC_CH_GAIN_t *pt_gain)
 {
@@ -653,7 +642,8 @@ static t_LINKHNDL createChannelAdcA( void)
     *------------------------------------------------------------------------*/
    for( t_chan = ADC1_CHAN0; t_chan <= ADC1_CHAN3; t_chan++)
    {
-      pt_chanElement = adc_findChannelElement( t_chan);
+      pt_chanElement = utl_getHandle( &gt_adcChanTable,
+                                      t_chan);
       if( pt_chanElement == NULL) /*Didn't find the channel*/
          break;
 
@@ -687,7 +677,8 @@ static t_LINKHNDL createChannelAdcB( void)
     *------------------------------------------------------------------------*/
    for( t_chan = ADC2_CHAN0; t_chan <= ADC2_CHAN3; t_chan++)
    {
-      pt_chanElement = adc_findChannelElement( t_chan);
+      pt_chanElement = utl_getHandle( &gt_adcChanTable,
+                                      t_chan);
       if( pt_chanElement == NULL) /*Didn't find the channel*/
          break;
 
@@ -1071,6 +1062,9 @@ t_ADCCHANHNDL hal_requestAdcChannel( t_adcModuleId t_module,
       /*---------------------------------------------------------------------*
        * Remove the device driver from the driver list.
        *---------------------------------------------------------------------*/
+      utl_removeHandle( &gt_adcChanTable,
+                        pt_element->t_id);
+
       t_lErr = utl_destroyLink( gt_adcChanList,
                                 (t_LINKHNDL)t_linkHndl);
 
@@ -1158,14 +1152,27 @@ t_ADCCHANHNDL hal_requestAdcChannel( t_adcModuleId t_module,
  *---------------------------------------------------------------------------*/
 t_adcError hal_releaseAdcChannel( t_ADCCHANHNDL t_handle)
 {
-
+   t_chanHandle *pt_element;
    t_linkedListError t_lErr;
 
+   HAL_BEGIN_CRITICAL(); //Disable interrupts
+
+   if( UTL_IS_LINK_ON_LIST( (t_LINKHNDL)t_handle, gt_adcChanList) == false)
+   {
+      HAL_END_CRITICAL(); //Enable interrupts
+      return ADC_INVALID_HNDL;
+   }
+
+   pt_element = (t_chanHandle *)
+   UTL_GET_LINK_ELEMENT_PTR( (t_LINKHNDL)t_handle);
+
+   utl_removeHandle( &gt_adcChanTable,
+                     pt_element->t_id);
+
    t_lErr = utl_destroyLink( gt_adcChanList,
                              (t_LINKHNDL)t_handle);
 
-   if( t_lErr == LINKEDLIST_INVALID_LINK)
-      return ADC_INVALID_HNDL;
+   HAL_END_CRITICAL(); //Enable interrupts
 
    return ADC_PASSED;
 
@@ -19,15 +19,17 @@
  * Project     : Arbitros 
  *               https://code.google.com/p/arbitros/
  *               
- * Description : This file is responsible for setting up the processor clocks.
+ * Description : This file is responsible for setting up the processor clocks
+ *               and the free running cycle counter.
  *
- * Last Update : Nov 12, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------*
  * Include Files
  *---------------------------------------------------------------------------*/
 #include "hal_clocks.h"
+#include "hal_timer.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
@@ -40,6 +42,11 @@ typedef struct
 {
    uint32_t i_cpuClock;
 
+   /*------------------------------------------------------------------------*
+    * True once the cycle counter has been started.
+    *------------------------------------------------------------------------*/
+   bool b_cycleCounter;
+
 }t_clocks;
 
 /*---------------------------------------------------------------------------*
@@ -85,3 +92,67 @@ t_clocksError hal_setCpuFreq( uint32_t i_clockRate)
    return CLOCKS_PASSED;
 
 }/*End hal_setCpuFreq*/
+
+t_clocksError hal_startCycleCounter( void)
+{
+#ifndef HAL_SIM_CYCLE_COUNTER
+   t_TIMERHNDL t_lowHndl;
+   t_TIMERHNDL t_highHndl;
+#endif
+
+   if( gt_clocks.b_cycleCounter == true)
+      return CLOCKS_PASSED;
+
+#ifdef HAL_SIM_CYCLE_COUNTER
+   /*------------------------------------------------------------------------*
+    * The simulator keeps the count, see 'hal_getCycleCount'.
+    *------------------------------------------------------------------------*/
+   gt_clocks.b_cycleCounter = true;
+#else
+   /*------------------------------------------------------------------------*
+    * Open both timers so the timer driver hands them to nobody else, they
+    * are programmed directly since it has no notion of cascading.
+    *------------------------------------------------------------------------*/
+   t_lowHndl = hal_requestTimer( TIMER_5);
+   if( t_lowHndl < 0)
+      return CLOCKS_COUNTER_BUSY;
+
+   t_highHndl = hal_requestTimer( TIMER_6);
+   if( t_highHndl < 0)
+   {
+      hal_releaseTimer( t_lowHndl);
+      return CLOCKS_COUNTER_BUSY;
+   }
+
+   HAL_BEGIN_CRITICAL(); //Disable interrupts
+
+   HAL_CYCLE_CNT_LOW.CTRLA  = TC_CLKSEL_OFF_gc;
+   HAL_CYCLE_CNT_HIGH.CTRLA = TC_CLKSEL_OFF_gc;
+   HAL_CYCLE_CNT_LOW.CTRLB  = TC_WGMODE_NORMAL_gc;
+   HAL_CYCLE_CNT_HIGH.CTRLB = TC_WGMODE_NORMAL_gc;
+   HAL_CYCLE_CNT_LOW.PER    = 0xFFFF;
+   HAL_CYCLE_CNT_HIGH.PER   = 0xFFFF;
+   HAL_CYCLE_CNT_LOW.CNT    = 0;
+   HAL_CYCLE_CNT_HIGH.CNT   = 0;
+
+   /*------------------------------------------------------------------------*
+    * The low timer's overflow clocks the high one through event channel 7.
+    *------------------------------------------------------------------------*/
+   HAL_CYCLE_CNT_EVMUX      = EVSYS_CHMUX_TCE0_OVF_gc;
+   HAL_CYCLE_CNT_HIGH.CTRLA = TC_CLKSEL_EVCH7_gc;
+   HAL_CYCLE_CNT_LOW.CTRLA  = TC_CLKSEL_DIV1_gc;
+
+   gt_clocks.b_cycleCounter = true;
+
+   HAL_END_CRITICAL(); //Enable interrupts
+#endif
+
+   return CLOCKS_PASSED;
+
+}/*End hal_startCycleCounter*/
+
+uint32_t hal_getCycleCounterFreq( void)
+{
+   return gt_clocks.i_cpuClock;
+
+}/*End hal_getCycleCounterFreq*/
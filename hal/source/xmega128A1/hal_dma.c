@@ -42,11 +42,20 @@
 #include <string.h>
 #include "hal_dma.h"
 #include "utl_linkedlist.h"
+#include "utl_handleTable.h"
 #include "hal_pmic.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
  *---------------------------------------------------------------------------*/
+#define DMA_NUM_CHANNELS   (4)
+#define DMA_NUM_INTERRUPTS (8)
+
+/*---------------------------------------------------------------------------*
+ * The channel IDs are spaced two apart (leaving room for the interrupt
+ * type), this maps them onto consecutive slots of 'gt_dmaChanTable'.
+ *---------------------------------------------------------------------------*/
+#define DMA_CHAN_SLOT( t_id) ((uint8_t)(t_id) >> 1)
 
 /*---------------------------------------------------------------------------*
  * Private Datatypes
@@ -66,6 +75,12 @@ typedef enum
 
 typedef struct
 {
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_dmaChanList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * A unique number referring to one of the 4 possible DMA's
     *------------------------------------------------------------------------*/
@@ -91,6 +106,12 @@ typedef struct
 typedef struct
 {
 
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_dmaIntHndlList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * A unique number referring to one of the 32 possible DMA interrupts
     *------------------------------------------------------------------------*/
@@ -110,10 +131,6 @@ static t_LINKHNDL createIntHandle( void);
 
 static t_LINKHNDL createDmaHandle( t_dmaChanId t_id);
 
-static t_dmaIntHndl *findDmaIntElement( t_dmaIntId t_id);
-
-static t_dmaChan *findDmaChanElement( t_dmaChanId t_id);
-
 /*---------------------------------------------------------------------------*
  * Private Global Variables
  *---------------------------------------------------------------------------*/
@@ -134,6 +151,21 @@ UTL_CREATE_CONTAINER( gt_dmaChanList);
  *---------------------------------------------------------------------------*/
 UTL_CREATE_CONTAINER( gt_dmaIntHndlList);
 
+/*---------------------------------------------------------------------------*
+ * Maps a DMA channel (DMA_CHAN_SLOT) and a DMA interrupt ID (t_dmaIntId) to
+ * the open handle, the interrupt table is used directly by the ISRs.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CREATE( gt_dmaChanTable, DMA_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CREATE( gt_dmaIntTable, DMA_NUM_INTERRUPTS);
+
+/*---------------------------------------------------------------------------*
+ * Every channel ID must fold onto its own slot of the table.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CHECK_SLOT( DMA_CHAN_SLOT( DMA_CHAN_0), 0, DMA_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( DMA_CHAN_SLOT( DMA_CHAN_1), 1, DMA_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( DMA_CHAN_SLOT( DMA_CHAN_2), 2, DMA_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( DMA_CHAN_SLOT( DMA_CHAN_3), 3, DMA_NUM_CHANNELS);
+
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
  *---------------------------------------------------------------------------*/
@@ -149,17 +181,17 @@ ISR( DMA_CH0_vect)
    {
       DMA.CH0.CTRLB |= DMA_CH_ERRIF_bm;
       /*---------------------------------------------------------------------*
-       * See if there is a handle on the list for this dma interrupt.
+       * See if there is a handle registered for this dma interrupt.
        *---------------------------------------------------------------------*/
-      pt_iElement = findDmaIntElement( (uint8_t)DMA_CHAN0_TR_ERROR);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable, DMA_CHAN0_TR_ERROR);
    }
    else
    {
       DMA.CH0.CTRLB |= DMA_CH_TRNIF_bm;
       /*---------------------------------------------------------------------*
-       * See if there is a handle on the list for this dma interrupt.
+       * See if there is a handle registered for this dma interrupt.
        *---------------------------------------------------------------------*/
-      pt_iElement = findDmaIntElement( (uint8_t)DMA_CHAN0_TR_COMP);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable, DMA_CHAN0_TR_COMP);
 
    }
 
@@ -179,17 +211,17 @@ ISR( DMA_CH1_vect)
    {
       DMA.CH1.CTRLB |= DMA_CH_ERRIF_bm;
       /*---------------------------------------------------------------------*
-       * See if there is a handle on the list for this dma interrupt.
+       * See if there is a handle registered for this dma interrupt.
        *---------------------------------------------------------------------*/
-      pt_iElement = findDmaIntElement( (uint8_t)DMA_CHAN1_TR_ERROR);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable, DMA_CHAN1_TR_ERROR);
    }
    else
    {
       DMA.CH1.CTRLB |= DMA_CH_TRNIF_bm;
       /*---------------------------------------------------------------------*
-       * See if there is a handle on the list for this dma interrupt.
+       * See if there is a handle registered for this dma interrupt.
        *---------------------------------------------------------------------*/
-      pt_iElement = findDmaIntElement( (uint8_t)DMA_CHAN1_TR_COMP);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable, DMA_CHAN1_TR_COMP);
 
    }
 
@@ -209,17 +241,17 @@ ISR( DMA_CH2_vect)
    {
       DMA.CH2.CTRLB |= DMA_CH_ERRIF_bm;
       /*---------------------------------------------------------------------*
-       * See if there is a handle on the list for this dma interrupt.
+       * See if there is a handle registered for this dma interrupt.
        *---------------------------------------------------------------------*/
-      pt_iElement = findDmaIntElement( (uint8_t)DMA_CHAN2_TR_ERROR);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable, DMA_CHAN2_TR_ERROR);
    }
    else
    {
       DMA.CH2.CTRLB |= DMA_CH_TRNIF_bm;
       /*---------------------------------------------------------------------*
-       * See if there is a handle on the list for this dma interrupt.
+       * See if there is a handle registered for this dma interrupt.
        *---------------------------------------------------------------------*/
-      pt_iElement = findDmaIntElement( (uint8_t)DMA_CHAN2_TR_COMP);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable, DMA_CHAN2_TR_COMP);
 
    }
 
@@ -239,17 +271,17 @@ ISR( DMA_CH3_vect)
    {
       DMA.CH3.CTRLB |= DMA_CH_ERRIF_bm;
       /*---------------------------------------------------------------------*
-       * See if there is a handle on the list for this dma interrupt.
+       * See if there is a handle registered for this dma interrupt.
        *---------------------------------------------------------------------*/
-      pt_iElement = findDmaIntElement( (uint8_t)DMA_CHAN3_TR_ERROR);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable, DMA_CHAN3_TR_ERROR);
    }
    else
    {
       DMA.CH3.CTRLB |= DMA_CH_TRNIF_bm;
       /*---------------------------------------------------------------------*
-       * See if there is a handle on the list for this dma interrupt.
+       * See if there is a handle registered for this dma interrupt.
        *---------------------------------------------------------------------*/
-      pt_iElement = findDmaIntElement( (uint8_t)DMA_CHAN3_TR_COMP);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable, DMA_CHAN3_TR_COMP);
 
    }
 
@@ -308,60 +340,6 @@ static t_dmaError hal_configureDmaController( t_dmaCntrlConfig t_conf)
 
 }/*End hal_configureDmaController*/
 
-static t_dmaIntHndl *findDmaIntElement( t_dmaIntId t_id)
-{
-   t_dmaIntHndl *pt_element;
-   t_LINKHNDL t_linkHndl;
-   int16_t s_count;
-
-   /*------------------------------------------------------------------------*
-    * Search the DMA interrupt list for the requested ID
-    *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_dmaIntHndlList, s_count)
-   {
-      pt_element = (t_dmaIntHndl *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-      if( pt_element->t_id == t_id)
-      {
-         return pt_element;
-      }
-
-   }
-
-   /*------------------------------------------------------------------------*
-    * If we make it this far the ID has not been found in the open DMA
-    * interrupt list.
-    *------------------------------------------------------------------------*/
-   return NULL;
-
-}/*End findDmaIntElement*/
-
-static t_dmaChan *findDmaChanElement( t_dmaChanId t_id)
-{
-   t_dmaChan *pt_element;
-   t_LINKHNDL t_linkHndl;
-   int16_t s_count;
-
-   /*------------------------------------------------------------------------*
-    * Search the DMA channel list for the requested ID
-    *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_dmaChanList, s_count)
-   {
-      pt_element = (t_dmaChan *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-      if( pt_element->t_id == t_id)
-      {
-         return pt_element;
-      }
-
-   }
-
-   /*------------------------------------------------------------------------*
-    * If we make it this far the ID has not been found on the open DMA
-    * channel list.
-    *------------------------------------------------------------------------*/
-   return NULL;
-
-}/*End findDmaChanElement*/
-
 static t_LINKHNDL createIntHandle( void)
 {
    t_LINKHNDL t_linkHndl;
@@ -443,6 +421,10 @@ static t_LINKHNDL createDmaHandle( t_dmaChanId t_id)
                            t_linkHndl,
                            true);
 
+   utl_insertHandle( &gt_dmaChanTable,
+                     DMA_CHAN_SLOT( t_id),
+                     pt_element);
+
    return t_linkHndl;
 
 }/*End createDmaHandle*/
@@ -491,7 +473,8 @@ t_dmaError hal_requestDmaInterrupt( t_DMAHNDL t_handle,
          return DMA_INVALID_INT_TYPE;
       }
 
-      pt_iElement = findDmaIntElement( t_intId);
+      pt_iElement = utl_getHandle( &gt_dmaIntTable,
+                                   t_intId);
 
       /*---------------------------------------------------------------------*
        * Is there already and open handle for this interrupt?
@@ -517,6 +500,10 @@ t_dmaError hal_requestDmaInterrupt( t_DMAHNDL t_handle,
          pt_iElement->t_id      = t_intId;
          pt_iElement->pf_funPtr = pf_funPtr;
 
+         utl_insertHandle( &gt_dmaIntTable,
+                           t_intId,
+                           pt_iElement);
+
          /*------------------------------------------------------------------*
           * Keep track of the number of interrupts attached to this channel.
           *------------------------------------------------------------------*/
@@ -551,11 +538,9 @@ t_dmaError hal_requestDmaInterrupt( t_DMAHNDL t_handle,
 t_dmaError hal_releaseDmaInterrupt( t_DMAHNDL t_handle,
                                     t_dmaIntType t_type)
 {
-   static t_LINKHNDL t_linkHndl;
    t_dmaChan *pt_dElement;
    t_dmaIntHndl *pt_iElement;
    t_dmaIntId t_intId;
-   int16_t s_count;
    t_linkedListError t_lErr;
 
    HAL_BEGIN_CRITICAL(); //Disable interrupts
@@ -584,26 +569,26 @@ t_dmaError hal_releaseDmaInterrupt( t_DMAHNDL t_handle,
       t_intId = (t_dmaIntId)pt_dElement->t_id + (t_dmaIntId)t_type;
 
       /*---------------------------------------------------------------------*
-       * Search the DMA interrupt list for the requested ID
+       * Look up the handle for the requested ID
        *---------------------------------------------------------------------*/
-      UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_dmaIntHndlList, s_count)
+      pt_iElement = utl_getHandle( &gt_dmaIntTable,
+                                   t_intId);
+      if( pt_iElement != NULL)
       {
-         pt_iElement = (t_dmaIntHndl *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-         if( pt_iElement->t_id == t_intId)
-         {
-            pt_dElement->c_intCount--;
-            if( t_type == DMA_TRANSFER_COMPLETE)
-               pt_dElement->pt_dma->CTRLB &= ~DMA_CH_TRNINTLVL_gm;
-            else
-               pt_dElement->pt_dma->CTRLB &= ~DMA_CH_ERRINTLVL_gm;
+         pt_dElement->c_intCount--;
+         if( t_type == DMA_TRANSFER_COMPLETE)
+            pt_dElement->pt_dma->CTRLB &= ~DMA_CH_TRNINTLVL_gm;
+         else
+            pt_dElement->pt_dma->CTRLB &= ~DMA_CH_ERRINTLVL_gm;
 
-            t_lErr = utl_destroyLink( gt_dmaIntHndlList,
-                                      t_linkHndl);
+         utl_removeHandle( &gt_dmaIntTable,
+                           t_intId);
 
-            HAL_END_CRITICAL();//Enable interrupts
-            return DMA_PASSED;
+         t_lErr = utl_destroyLink( gt_dmaIntHndlList,
+                                   UTL_GET_ELEMENT_LINK( pt_iElement));
 
-         }
+         HAL_END_CRITICAL();//Enable interrupts
+         return DMA_PASSED;
 
       }
 
@@ -653,7 +638,8 @@ t_DMAHNDL hal_requestDmaChannel( void)
     *------------------------------------------------------------------------*/
    for( t_chanId = DMA_CHAN_0; t_chanId <= DMA_CHAN_3; t_chanId+=2)
    {
-      pt_dmaChan = findDmaChanElement( t_chanId);
+      pt_dmaChan = utl_getHandle( &gt_dmaChanTable,
+                                  DMA_CHAN_SLOT( t_chanId));
       if( pt_dmaChan == NULL) /*Not open*/
          break;
    }
@@ -686,13 +672,10 @@ t_DMAHNDL hal_requestDmaChannel( void)
 
 t_dmaError hal_releaseDmaChannel( t_DMAHNDL t_handle)
 {
-   static t_LINKHNDL t_linkHndl;
-   static t_LINKHNDL t_prevLinkHndl;
    t_dmaChan *pt_dElement;
    t_dmaIntHndl *pt_iElement;
    t_dmaIntId t_intId;
    t_dmaIntType t_type;
-   int16_t s_count;
    t_linkedListError t_lErr;
 
    /*------------------------------------------------------------------------*
@@ -720,12 +703,6 @@ t_dmaError hal_releaseDmaChannel( t_DMAHNDL t_handle)
 
       /*---------------------------------------------------------------------*
        * Remove all the interrupts associated with this particular DMA channel.
-       * Since UTL_TRAVERSE_CONTAINER traverses through the entire interrupt
-       * list changing the value of t_linkHndl on each iteration, once
-       * 't_linkHndl' has been deleted information about the next position on
-       * the list is lost.  This issue is resolved by using a previous ptr to
-       * change 't_linkHndl' back to a valid location once an item has been
-       * removed.
        *---------------------------------------------------------------------*/
       for( t_type = DMA_TRANSFER_COMPLETE; t_type <= DMA_TRANSFER_ERROR;
       t_type++)
@@ -736,28 +713,22 @@ t_dmaError hal_releaseDmaChannel( t_DMAHNDL t_handle)
           *------------------------------------------------------------------*/
          t_intId = (t_dmaIntId)pt_dElement->t_id + (t_dmaIntId)t_type;
 
-         /*------------------------------------------------------------------*
-          * Search the DMA interrupt list for the requested ID
-          *------------------------------------------------------------------*/
-         UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_dmaIntHndlList, s_count)
+         pt_iElement = utl_getHandle( &gt_dmaIntTable,
+                                      t_intId);
+         if( pt_iElement != NULL)
          {
-            pt_iElement = (t_dmaIntHndl *)
-            UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-            t_prevLinkHndl = UTL_GET_PREV_LINK( t_linkHndl);
-            if( pt_iElement->t_id == t_intId)
-            {
-               pt_dElement->c_intCount--;
-               if( t_type == DMA_TRANSFER_COMPLETE)
-                  pt_dElement->pt_dma->CTRLB &= ~DMA_CH_TRNINTLVL_gm;
-               else
-                  pt_dElement->pt_dma->CTRLB &= ~DMA_CH_ERRINTLVL_gm;
-
-               t_lErr = utl_destroyLink( gt_dmaIntHndlList,
-                                         t_linkHndl);
-
-               t_linkHndl = t_prevLinkHndl;
-
-            }
+            pt_dElement->c_intCount--;
+            if( t_type == DMA_TRANSFER_COMPLETE)
+               pt_dElement->pt_dma->CTRLB &= ~DMA_CH_TRNINTLVL_gm;
+            else
+               pt_dElement->pt_dma->CTRLB &= ~DMA_CH_ERRINTLVL_gm;
+
+            utl_removeHandle( &gt_dmaIntTable,
+                              t_intId);
+
+            t_lErr = utl_destroyLink( gt_dmaIntHndlList,
+                                      UTL_GET_ELEMENT_LINK( pt_iElement));
+
          }
 
       }/*End for( t_type = DMA_TRANSFER_COMPLETE; t_type <= DMA_TRANSFER_ERROR;
@@ -775,6 +746,9 @@ t_dmaError hal_releaseDmaChannel( t_DMAHNDL t_handle)
       pt_dElement->pt_dma->CTRLA |= DMA_CH_RESET_bm;
       pt_dElement->pt_dma->CTRLA &= ~DMA_CH_RESET_bm;
 
+      utl_removeHandle( &gt_dmaChanTable,
+                        DMA_CHAN_SLOT( pt_dElement->t_id));
+
       t_lErr = utl_destroyLink( gt_dmaChanList,
                                 (t_LINKHNDL)t_handle);
 
@@ -85,6 +85,12 @@ typedef enum
 typedef struct
 {
 
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_gpioHndlList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * A unique number referring to one of the eleven ports and one of its two
     * configurable interrupts.
@@ -36,8 +36,8 @@ void hal_initThreadStack( void *pt_function,
                           t_parameters t_parms,
                           t_arguments t_args,
                           uint8_t *pc_stackPtr,
-                          uint16_t s_endOfStackAdd,
-                          uint16_t *ps_sP)
+                          uintptr_t s_endOfStackAdd,
+                          uintptr_t *ps_sP)
 {
    uint32_t i_funAdd = 0;
 
@@ -142,6 +142,6 @@ void hal_initThreadStack( void *pt_function,
    /*------------------------------------------------------------------------*
     * Save the stack pointer
     *------------------------------------------------------------------------*/
-   *ps_sP = (uint16_t)pc_stackPtr;
+   *ps_sP = (uintptr_t)pc_stackPtr;
 
 }/*End arb_initThreadStack*/
\ No newline at end of file
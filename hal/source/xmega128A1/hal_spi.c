@@ -34,6 +34,7 @@
 #include "hal_spi.h"
 #include "hal_clocks.h"
 #include "utl_linkedlist.h"
+#include "utl_handleTable.h"
 #include "hal_gpio.h"
 #include "hal_pmic.h"
 #include "hal_dma.h"
@@ -41,12 +42,19 @@
 /*---------------------------------------------------------------------------*
  * Private Defines
  *---------------------------------------------------------------------------*/
+#define SPI_NUM_CHANNELS (4)
 
 /*---------------------------------------------------------------------------*
  * Private Datatypes
  *---------------------------------------------------------------------------*/
 typedef struct
 {
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_spiChanHndlList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * A unique number referring to one of the 4 possible spi channels
     *------------------------------------------------------------------------*/
@@ -106,6 +114,12 @@ typedef struct
 typedef struct
 {
 
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_spiUserHndlList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * Pointer to the interrupt call-back function
     *------------------------------------------------------------------------*/
@@ -166,7 +180,6 @@ typedef struct
  *---------------------------------------------------------------------------*/
 static t_LINKHNDL createSpiHandle( void);
 static t_LINKHNDL createSpiUserHandle( void);
-static t_spiChanHndl *findSpiElement( t_spiChanId t_id);
 static bool updateBuffersMast( t_spiUserHndl *pt_handle);
 static bool updateBuffersSlave( t_spiUserHndl *pt_handle);
 static void slaveSpiCChipSelectInt( t_gpioPort t_port,
@@ -203,6 +216,12 @@ UTL_CREATE_CONTAINER( gt_spiChanHndlList);
  *---------------------------------------------------------------------------*/
 UTL_CREATE_CONTAINER( gt_spiUserHndlList);
 
+/*---------------------------------------------------------------------------*
+ * Maps a spi channel ID to its configured handle, used directly by the
+ * interrupt routines.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CREATE( gt_spiChanTable, SPI_NUM_CHANNELS);
+
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
  *---------------------------------------------------------------------------*/
@@ -443,9 +462,9 @@ static void masterSpiCRxDmaInt( void)
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_1);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_1);
 
    if( pt_chanHndl != NULL)
    {
@@ -464,9 +483,9 @@ static void masterSpiDRxDmaInt( void)
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_2);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_2);
 
    if( pt_chanHndl != NULL)
    {
@@ -485,9 +504,9 @@ static void masterSpiERxDmaInt( void)
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_3);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_3);
 
    if( pt_chanHndl != NULL)
    {
@@ -506,9 +525,9 @@ static void masterSpiFRxDmaInt( void)
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_4);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_4);
 
    if( pt_chanHndl != NULL)
    {
@@ -528,9 +547,9 @@ static void slaveSpiCChipSelectInt( t_gpioPort t_port,
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_1);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_1);
 
    if( (pt_chanHndl != NULL) && (pt_chanHndl->t_spiOp == SPI_SLAVE))
    {
@@ -550,9 +569,9 @@ static void slaveSpiDChipSelectInt( t_gpioPort t_port,
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_2);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_2);
 
    if( (pt_chanHndl != NULL) && (pt_chanHndl->t_spiOp == SPI_SLAVE))
    {
@@ -572,9 +591,9 @@ static void slaveSpiEChipSelectInt( t_gpioPort t_port,
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_3);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_3);
 
    if( (pt_chanHndl != NULL) && (pt_chanHndl->t_spiOp == SPI_SLAVE))
    {
@@ -593,9 +612,9 @@ static void slaveSpiFChipSelectInt( t_gpioPort t_port,
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_4);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_4);
 
    if( (pt_chanHndl != NULL) && (pt_chanHndl->t_spiOp == SPI_SLAVE))
    {
@@ -614,9 +633,9 @@ ISR( SPIC_INT_vect)
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_1);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_1);
 
    if( pt_chanHndl != NULL)
    {
@@ -635,9 +654,9 @@ ISR( SPID_INT_vect)
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_2);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_2);
 
    if( pt_chanHndl != NULL)
    {
@@ -656,9 +675,9 @@ ISR( SPIE_INT_vect)
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_3);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_3);
 
    if( pt_chanHndl != NULL)
    {
@@ -677,9 +696,9 @@ ISR( SPIF_INT_vect)
    t_spiUserHndl *pt_activeUser = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this spi interrupt.
+    * See if there is a handle registered for this spi interrupt.
     *------------------------------------------------------------------------*/
-   pt_chanHndl = findSpiElement( (uint8_t)SPI_4);
+   pt_chanHndl = utl_getHandle( &gt_spiChanTable, SPI_4);
 
    if( pt_chanHndl != NULL)
    {
@@ -692,33 +711,6 @@ ISR( SPIF_INT_vect)
 
 }/*End ISR( SPIF_INT_vect)*/
 
-static t_spiChanHndl *findSpiElement( t_spiChanId t_id)
-{
-   t_spiChanHndl *pt_element;
-   t_LINKHNDL t_linkHndl;
-   int16_t s_count;
-
-   /*------------------------------------------------------------------------*
-    * Search the spi list for the requested ID
-    *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_spiChanHndlList, s_count)
-   {
-      pt_element = (t_spiChanHndl *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-      if( pt_element->t_id == t_id)
-      {
-         return pt_element;
-      }
-
-   }
-
-   /*------------------------------------------------------------------------*
-    * If we make it this far the ID has not been found in the open spi module
-    * list.
-    *------------------------------------------------------------------------*/
-   return NULL;
-
-}/*End findSpiElement*/
-
 static t_LINKHNDL createSpiHandle( void)
 {
 
@@ -1749,7 +1741,8 @@ t_SPIHNDL hal_requestSpiChannel( t_spiChanId t_chanId,
    /*------------------------------------------------------------------------*
     * Grab the handle associated with this channel ID.
     *------------------------------------------------------------------------*/
-   pt_spiChanHndl = findSpiElement( t_chanId);
+   pt_spiChanHndl = utl_getHandle( &gt_spiChanTable,
+                                   t_chanId);
 
    /*------------------------------------------------------------------------*
     * Has a spi channel been configured?
@@ -1782,9 +1775,10 @@ t_SPIHNDL hal_requestSpiChannel( t_spiChanId t_chanId,
       UTL_GET_LINK_ELEMENT_PTR( (t_LINKHNDL)t_linkHndl);
 
       /*---------------------------------------------------------------------*
-       * Make sure all the elements of the spi user handle are reset.
+       * Make sure all the elements of the spi user handle are reset. The
+       * handle is already on its list, so the link is left alone.
        *---------------------------------------------------------------------*/
-      memset( (void *)pt_spiUserHndl, 0, sizeof( t_spiUserHndl));
+      UTL_CLEAR_LINK_ELEMENT( pt_spiUserHndl, t_spiUserHndl);
 
       /*---------------------------------------------------------------------*
        * Keep track of how many users are attached to this spi.
@@ -1943,6 +1937,9 @@ t_spiError hal_releaseSpiChannel( t_SPIHNDL t_handle)
          /*------------------------------------------------------------------*
           * Disable and reset this spi channel.
           *------------------------------------------------------------------*/
+         utl_removeHandle( &gt_spiChanTable,
+                           pt_spiChanHndl->t_id);
+
          t_lErr = utl_destroyLink( gt_spiChanHndlList,
                                    pt_spiChanHndl->t_linkHndl);
        }/*End if( pt_spiChanHndl->c_numUsers == 0)*/
@@ -1974,7 +1971,8 @@ t_spiError hal_configureSpiChannel( t_spiChanId t_chanId,
     *------------------------------------------------------------------------*/
    HAL_BEGIN_CRITICAL(); //Disable interrupts
 
-   pt_spiChanHndl = findSpiElement( (uint8_t)t_chanId);
+   pt_spiChanHndl = utl_getHandle( &gt_spiChanTable,
+                                   t_chanId);
 
    /*------------------------------------------------------------------------*
     * Has this particular spi channel already been configured?
@@ -2043,9 +2041,10 @@ t_spiError hal_configureSpiChannel( t_spiChanId t_chanId,
       UTL_GET_LINK_ELEMENT_PTR( (t_LINKHNDL)t_linkHndl);
 
       /*---------------------------------------------------------------------*
-       * Make sure all the elements of the spi channel handle are reset.
+       * Make sure all the elements of the spi channel handle are reset. The
+       * handle is already on its list, so the link is left alone.
        *---------------------------------------------------------------------*/
-      memset( (void *)pt_spiChanHndl, 0, sizeof( t_spiChanHndl));
+      UTL_CLEAR_LINK_ELEMENT( pt_spiChanHndl, t_spiChanHndl);
 
       /*---------------------------------------------------------------------*
        * Keep track of the link address so that it can be 'destroyed' at a
@@ -2241,6 +2240,10 @@ t_spiError hal_configureSpiChannel( t_spiChanId t_chanId,
        *---------------------------------------------------------------------*/
       pt_spiChanHndl->t_id = t_chanId;
 
+      utl_insertHandle( &gt_spiChanTable,
+                        t_chanId,
+                        pt_spiChanHndl);
+
       /*---------------------------------------------------------------------*
        * Number users attached at this time.
        *---------------------------------------------------------------------*/
@@ -28,7 +28,8 @@
 /*---------------------------------------------------------------------------*
  * Include Files
  *---------------------------------------------------------------------------*/
-#include "utl_linkedList.h"
+#include "utl_linkedlist.h"
+#include "utl_handleTable.h"
 #include "hal_timer.h"
 #include "hal_pmic.h"
 #include "hal_gpio.h"
@@ -38,6 +39,15 @@
  *---------------------------------------------------------------------------*/
 #define MAX_TIMER_RANGE (32767) /*Max number of timer ticks*/
 
+#define TIMER_NUM_MODULES    (8)
+#define TIMER_NUM_INTERRUPTS (TIMER_NUM_MODULES*5)
+
+/*---------------------------------------------------------------------------*
+ * The module IDs are spaced five apart (one for each interrupt type), this
+ * maps them onto consecutive slots of 'gt_timerTable'.
+ *---------------------------------------------------------------------------*/
+#define TIMER_MOD_SLOT( t_id) ((uint8_t)(t_id) / 5)
+
 /*---------------------------------------------------------------------------*
  * Private Datatypes
  *---------------------------------------------------------------------------*/
@@ -88,6 +98,12 @@ typedef enum
 
 typedef struct timerMod
 {
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_timerHndlList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * A unique number refering to one of the 8 possible timers
     *------------------------------------------------------------------------*/
@@ -123,6 +139,12 @@ typedef struct timerMod
 typedef struct timerInt
 {
 
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_timerIntHndlList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * A unique number refering to one of the 32 possible timer interrupts
     *------------------------------------------------------------------------*/
@@ -142,10 +164,6 @@ static t_LINKHNDL createIntHandle( void);
 
 static t_LINKHNDL createTimerHandle( void);
 
-static t_timerIntHndl *findTimerIntElement( t_timerIntId t_id);
-
-static t_timerModHndl *findTimerElement( t_timerModId t_id);
-
 /*---------------------------------------------------------------------------*
  * Private Global Variables
  *---------------------------------------------------------------------------*/
@@ -160,6 +178,26 @@ UTL_CREATE_CONTAINER( gt_timerHndlList);
  *---------------------------------------------------------------------------*/
 UTL_CREATE_CONTAINER( gt_timerIntHndlList);
 
+/*---------------------------------------------------------------------------*
+ * Maps a timer module (TIMER_MOD_SLOT) and a timer interrupt ID 
+ * (t_timerIntId) to the open handle, the interrupt table is used directly by
+ * the ISRs.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CREATE( gt_timerTable, TIMER_NUM_MODULES);
+UTL_HANDLE_TABLE_CREATE( gt_timerIntTable, TIMER_NUM_INTERRUPTS);
+
+/*---------------------------------------------------------------------------*
+ * Every module ID must fold onto its own slot of the table.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CHECK_SLOT( TIMER_MOD_SLOT( TIMER_1), 0, TIMER_NUM_MODULES);
+UTL_HANDLE_TABLE_CHECK_SLOT( TIMER_MOD_SLOT( TIMER_2), 1, TIMER_NUM_MODULES);
+UTL_HANDLE_TABLE_CHECK_SLOT( TIMER_MOD_SLOT( TIMER_3), 2, TIMER_NUM_MODULES);
+UTL_HANDLE_TABLE_CHECK_SLOT( TIMER_MOD_SLOT( TIMER_4), 3, TIMER_NUM_MODULES);
+UTL_HANDLE_TABLE_CHECK_SLOT( TIMER_MOD_SLOT( TIMER_5), 4, TIMER_NUM_MODULES);
+UTL_HANDLE_TABLE_CHECK_SLOT( TIMER_MOD_SLOT( TIMER_6), 5, TIMER_NUM_MODULES);
+UTL_HANDLE_TABLE_CHECK_SLOT( TIMER_MOD_SLOT( TIMER_7), 6, TIMER_NUM_MODULES);
+UTL_HANDLE_TABLE_CHECK_SLOT( TIMER_MOD_SLOT( TIMER_8), 7, TIMER_NUM_MODULES);
+
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
  *---------------------------------------------------------------------------*/
@@ -177,9 +215,9 @@ ISR( TCC0_CCA_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_1_COMP_A);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_1_COMP_A);
 
    if( pt_intHndl != NULL)
    {
@@ -194,9 +232,9 @@ ISR( TCC0_CCB_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_1_COMP_B);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_1_COMP_B);
 
    if( pt_intHndl != NULL)
    {
@@ -211,9 +249,9 @@ ISR( TCC0_CCC_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_1_COMP_C);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_1_COMP_C);
 
    if( pt_intHndl != NULL)
    {
@@ -228,9 +266,9 @@ ISR( TCC0_CCD_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_1_COMP_D);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_1_COMP_D);
 
    if( pt_intHndl != NULL)
    {
@@ -245,9 +283,9 @@ ISR( TCC0_OVF_vect)//, ISR_NAKED)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_1_OVERFLOW);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_1_OVERFLOW);
 
    if( pt_intHndl != NULL)
    {
@@ -262,9 +300,9 @@ ISR( TCC1_CCA_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_2_COMP_A);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_2_COMP_A);
 
    if( pt_intHndl != NULL)
    {
@@ -279,9 +317,9 @@ ISR( TCC1_CCB_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_2_COMP_B);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_2_COMP_B);
 
    if( pt_intHndl != NULL)
    {
@@ -296,9 +334,9 @@ ISR( TCC1_OVF_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_2_OVERFLOW);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_2_OVERFLOW);
 
    if( pt_intHndl != NULL)
    {
@@ -313,9 +351,9 @@ ISR( TCD0_CCA_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_3_COMP_A);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_3_COMP_A);
 
    if( pt_intHndl != NULL)
    {
@@ -330,9 +368,9 @@ ISR( TCD0_CCB_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_3_COMP_B);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_3_COMP_B);
 
    if( pt_intHndl != NULL)
    {
@@ -347,9 +385,9 @@ ISR( TCD0_CCC_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_3_COMP_C);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_3_COMP_C);
 
    if( pt_intHndl != NULL)
    {
@@ -364,9 +402,9 @@ ISR( TCD0_CCD_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_3_COMP_D);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_3_COMP_D);
 
    if( pt_intHndl != NULL)
    {
@@ -381,9 +419,9 @@ ISR( TCD0_OVF_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_3_OVERFLOW);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_3_OVERFLOW);
 
    if( pt_intHndl != NULL)
    {
@@ -398,9 +436,9 @@ ISR( TCD1_CCA_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_4_COMP_A);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_4_COMP_A);
 
    if( pt_intHndl != NULL)
    {
@@ -415,9 +453,9 @@ ISR( TCD1_CCB_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_4_COMP_B);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_4_COMP_B);
 
    if( pt_intHndl != NULL)
    {
@@ -432,9 +470,9 @@ ISR( TCD1_OVF_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_4_OVERFLOW);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_4_OVERFLOW);
 
    if( pt_intHndl != NULL)
    {
@@ -449,9 +487,9 @@ ISR( TCE0_CCA_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_5_COMP_A);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_5_COMP_A);
 
    if( pt_intHndl != NULL)
    {
@@ -466,9 +504,9 @@ ISR( TCE0_CCB_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_5_COMP_B);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_5_COMP_B);
 
    if( pt_intHndl != NULL)
    {
@@ -483,9 +521,9 @@ ISR( TCE0_CCC_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_5_COMP_C);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_5_COMP_C);
 
    if( pt_intHndl != NULL)
    {
@@ -500,9 +538,9 @@ ISR( TCE0_CCD_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_5_COMP_D);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_5_COMP_D);
 
    if( pt_intHndl != NULL)
    {
@@ -517,9 +555,9 @@ ISR( TCE0_OVF_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_5_OVERFLOW);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_5_OVERFLOW);
 
    if( pt_intHndl != NULL)
    {
@@ -534,9 +572,9 @@ ISR( TCE1_CCA_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_6_COMP_A);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_6_COMP_A);
 
    if( pt_intHndl != NULL)
    {
@@ -551,9 +589,9 @@ ISR( TCE1_CCB_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_6_COMP_B);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_6_COMP_B);
 
    if( pt_intHndl != NULL)
    {
@@ -568,9 +606,9 @@ ISR( TCE1_OVF_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_6_OVERFLOW);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_6_OVERFLOW);
 
    if( pt_intHndl != NULL)
    {
@@ -585,9 +623,9 @@ ISR( TCF0_CCA_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_7_COMP_A);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_7_COMP_A);
 
    if( pt_intHndl != NULL)
    {
@@ -602,9 +640,9 @@ ISR( TCF0_CCB_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_7_COMP_B);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_7_COMP_B);
 
    if( pt_intHndl != NULL)
    {
@@ -619,9 +657,9 @@ ISR( TCF0_CCC_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_7_COMP_C);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_7_COMP_C);
 
    if( pt_intHndl != NULL)
    {
@@ -636,9 +674,9 @@ ISR( TCF0_CCD_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_7_COMP_D);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_7_COMP_D);
 
    if( pt_intHndl != NULL)
    {
@@ -653,9 +691,9 @@ ISR( TCF0_OVF_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_7_OVERFLOW);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_7_OVERFLOW);
 
    if( pt_intHndl != NULL)
    {
@@ -670,9 +708,9 @@ ISR( TCF1_CCA_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_8_COMP_A);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_8_COMP_A);
 
    if( pt_intHndl != NULL)
    {
@@ -687,9 +725,9 @@ ISR( TCF1_CCB_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_8_COMP_B);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_8_COMP_B);
 
    if( pt_intHndl != NULL)
    {
@@ -704,9 +742,9 @@ ISR( TCF1_OVF_vect)
    t_timerIntHndl *pt_intHndl = NULL;
 
    /*---------------------------------------------------------------------*
-    * See if there is a handle on the list for this timer interrupt.
+    * See if there is a handle registered for this timer interrupt.
     *---------------------------------------------------------------------*/
-   pt_intHndl = findTimerIntElement( TIMER_8_OVERFLOW);
+   pt_intHndl = utl_getHandle( &gt_timerIntTable, TIMER_8_OVERFLOW);
 
    if( pt_intHndl != NULL)
    {
@@ -716,60 +754,6 @@ ISR( TCF1_OVF_vect)
 
 }/*End ISR( TCF1_OVF_vect)*/
 
-static t_timerIntHndl *findTimerIntElement( t_timerIntId t_id)
-{
-   t_timerIntHndl *pt_element;
-   t_LINKHNDL t_linkHndl;
-   int16_t s_count;
-
-   /*------------------------------------------------------------------------*
-    * Search the Timer interrupt list for the requested ID
-    *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_timerIntHndlList, s_count)
-   {
-      pt_element = (t_timerIntHndl *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-      if( pt_element->t_id == t_id)
-      {
-         return pt_element;
-      }
-
-   }
-
-   /*------------------------------------------------------------------------*
-    * If we make it this far the ID has not been found in the open Timer
-    * interrupt list.
-    *------------------------------------------------------------------------*/
-   return NULL;
-
-}/*End findTimerIntElement*/
-
-static t_timerModHndl *findTimerElement( t_timerModId t_id)
-{
-   t_timerModHndl *pt_element;
-   t_LINKHNDL t_linkHndl;
-   int16_t s_count;
-
-   /*------------------------------------------------------------------------*
-    * Search the Timer list for the requested ID
-    *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_timerHndlList, s_count)
-   {
-      pt_element = (t_timerModHndl *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-      if( pt_element->t_id == t_id)
-      {
-         return pt_element;
-      }
-
-   }
-
-   /*------------------------------------------------------------------------*
-    * If we make it this far the ID has not been found in the open Timer
-    * list.
-    *------------------------------------------------------------------------*/
-   return NULL;
-
-}/*End findTimerElement*/
-
 static t_LINKHNDL createIntHandle( void)
 {
    t_LINKHNDL t_linkHndl;
@@ -872,7 +856,8 @@ t_timerError hal_requestTimerInterrupt( t_TIMERHNDL t_handle,
          return TIMER_INVALID_COMP;
       }
 
-      pt_timerIntHndl = findTimerIntElement( t_intId);
+      pt_timerIntHndl = utl_getHandle( &gt_timerIntTable,
+                                       t_intId);
 
       /*---------------------------------------------------------------------*
        * Is there already and open handle for this interrupt?
@@ -896,6 +881,10 @@ t_timerError hal_requestTimerInterrupt( t_TIMERHNDL t_handle,
          pt_timerIntHndl->t_id = t_intId;
          pt_timerIntHndl->pf_funPtr = pf_funPtr;
 
+         utl_insertHandle( &gt_timerIntTable,
+                           t_intId,
+                           pt_timerIntHndl);
+
          /*------------------------------------------------------------------*
           * Keep track of how many interrupts this handle has open.
           *------------------------------------------------------------------*/
@@ -960,10 +949,8 @@ t_timerError hal_requestTimerInterrupt( t_TIMERHNDL t_handle,
 t_timerError hal_releaseTimerInterrupt( t_TIMERHNDL t_handle,
                                         t_compType   t_type)
 {
-   static t_LINKHNDL t_linkHndl;
    t_timerModHndl *pt_timerHndl;
    t_timerIntId t_intId;
-   int16_t s_count;
    t_linkedListError t_lErr;
    t_timerIntHndl *pt_timerIntHndl;
 
@@ -1008,68 +995,66 @@ t_timerError hal_releaseTimerInterrupt( t_TIMERHNDL t_handle,
       }
 
       /*---------------------------------------------------------------------*
-       * Search the Timer interrupt list for the requested ID
+       * Look up the handle for the requested ID
        *---------------------------------------------------------------------*/
-      UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_timerIntHndlList, s_count)
+      pt_timerIntHndl = utl_getHandle( &gt_timerIntTable,
+                                       t_intId);
+      if( pt_timerIntHndl != NULL)
       {
-         pt_timerIntHndl = (t_timerIntHndl *)
-         UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-         if( pt_timerIntHndl->t_id == t_intId)
-         {
 
-            /*---------------------------------------------------------------*
-             * One less timer opened against this handle.
-             *---------------------------------------------------------------*/
-            pt_timerHndl->c_intCount--;
+         /*------------------------------------------------------------------*
+          * One less timer opened against this handle.
+          *------------------------------------------------------------------*/
+         pt_timerHndl->c_intCount--;
 
-            if( t_type == OVERFLOW)
-            {
-               if( pt_timerHndl->pt_timer0 != NULL)
-                  pt_timerHndl->pt_timer0->INTCTRLA &= ~TC_OVFINTLVL_HI_gc;
-               else
-                  pt_timerHndl->pt_timer1->INTCTRLA &= ~TC_OVFINTLVL_HI_gc;
+         if( t_type == OVERFLOW)
+         {
+            if( pt_timerHndl->pt_timer0 != NULL)
+               pt_timerHndl->pt_timer0->INTCTRLA &= ~TC_OVFINTLVL_HI_gc;
+            else
+               pt_timerHndl->pt_timer1->INTCTRLA &= ~TC_OVFINTLVL_HI_gc;
 
-            }/*End if( t_type == OVERFLOW)*/
-            else if( t_type == COMPAREA)
-            {
-               if( pt_timerHndl->pt_timer0 != NULL)
-                  pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCAINTLVL_HI_gc;
-               else
-                  pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCAINTLVL_HI_gc;
+         }/*End if( t_type == OVERFLOW)*/
+         else if( t_type == COMPAREA)
+         {
+            if( pt_timerHndl->pt_timer0 != NULL)
+               pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCAINTLVL_HI_gc;
+            else
+               pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCAINTLVL_HI_gc;
 
-            }
-            else if( t_type == COMPAREB)
-            {
-               if( pt_timerHndl->pt_timer0 != NULL)
-                  pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCBINTLVL_HI_gc;
-               else
-                  pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCBINTLVL_HI_gc;
-            }
-            else if( t_type == COMPAREC)
-            {
-               if( pt_timerHndl->pt_timer0 != NULL)
-                  pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCCINTLVL_HI_gc;
-               else
-                  pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCCINTLVL_HI_gc;
-            }
-            else if( t_type == COMPARED)
-            {
-               if( pt_timerHndl->pt_timer0 != NULL)
-                  pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCDINTLVL_HI_gc;
-               else
-                  pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCDINTLVL_HI_gc;
-            }
+         }
+         else if( t_type == COMPAREB)
+         {
+            if( pt_timerHndl->pt_timer0 != NULL)
+               pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCBINTLVL_HI_gc;
+            else
+               pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCBINTLVL_HI_gc;
+         }
+         else if( t_type == COMPAREC)
+         {
+            if( pt_timerHndl->pt_timer0 != NULL)
+               pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCCINTLVL_HI_gc;
+            else
+               pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCCINTLVL_HI_gc;
+         }
+         else if( t_type == COMPARED)
+         {
+            if( pt_timerHndl->pt_timer0 != NULL)
+               pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCDINTLVL_HI_gc;
+            else
+               pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCDINTLVL_HI_gc;
+         }
 
-            t_lErr = utl_destroyLink( gt_timerIntHndlList,
-                                      t_linkHndl);
+         utl_removeHandle( &gt_timerIntTable,
+                           t_intId);
 
-            HAL_END_CRITICAL();//Enable interrupts
-            return TIMER_PASSED;
+         t_lErr = utl_destroyLink( gt_timerIntHndlList,
+                                   UTL_GET_ELEMENT_LINK( pt_timerIntHndl));
 
-         }
+         HAL_END_CRITICAL();//Enable interrupts
+         return TIMER_PASSED;
 
-      }/*End UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_timerIntHndlList, 
-      s_count)*/
+      }/*End if( pt_timerIntHndl != NULL)*/
 
    }
 
@@ -1099,7 +1084,8 @@ t_TIMERHNDL hal_requestTimer( t_timerModId t_id)
       return (t_TIMERHNDL)TIMER_INVALID_MODULE;
    }
 
-   pt_timerHndl = findTimerElement( t_id);
+   pt_timerHndl = utl_getHandle( &gt_timerTable,
+                                 TIMER_MOD_SLOT( t_id));
 
    /*------------------------------------------------------------------------*
     * Has this timer already been opened?
@@ -1125,6 +1111,10 @@ t_TIMERHNDL hal_requestTimer( t_timerModId t_id)
 
       pt_timerHndl->t_id = t_id;
 
+      utl_insertHandle( &gt_timerTable,
+                        TIMER_MOD_SLOT( t_id),
+                        pt_timerHndl);
+
       /*---------------------------------------------------------------------*
        * Clock isn't configured until configureTimer gets called.
        *---------------------------------------------------------------------*/
@@ -1210,13 +1200,10 @@ t_TIMERHNDL hal_requestTimer( t_timerModId t_id)
 
 t_timerError hal_releaseTimer( t_TIMERHNDL t_handle)
 {
-   static t_LINKHNDL t_linkHndl;
-   static t_LINKHNDL t_prevLinkHndl;
    t_timerModHndl *pt_timerHndl;
    t_timerIntHndl *pt_timerIntHndl;
    t_timerIntId t_intId;
    t_compType t_type;
-   int16_t s_count;
    t_linkedListError t_lErr;
 
    /*------------------------------------------------------------------------*
@@ -1245,12 +1232,7 @@ t_timerError hal_releaseTimer( t_TIMERHNDL t_handle)
 
       /*---------------------------------------------------------------------*
        * Remove all the interrupts associated with this particular timer 
-       * channel. Since UTL_TRAVERSE_CONTAINER traverses through the entire 
-       * interrupt list changing the value of t_linkHndl on each iteration, 
-       * once 't_linkHndl' has been deleted information about the next position
-       * on the list is lost.  This issue is resolved by using a previous ptr 
-       * to change 't_linkHndl' back to a valid location once an item has been
-       * removed.
+       * channel.
        *---------------------------------------------------------------------*/
       for( t_type = COMPAREA; t_type <= OVERFLOW; t_type++)
       {
@@ -1260,66 +1242,57 @@ t_timerError hal_releaseTimer( t_TIMERHNDL t_handle)
           *------------------------------------------------------------------*/
          t_intId = (t_timerIntId)pt_timerHndl->t_id + (t_timerIntId)t_type;
 
-         /*------------------------------------------------------------------*
-          * Search the timer interrupt list for the requested ID
-          *------------------------------------------------------------------*/
-         UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_timerIntHndlList, s_count)
+         pt_timerIntHndl = utl_getHandle( &gt_timerIntTable,
+                                          t_intId);
+         if( pt_timerIntHndl != NULL)
          {
-            pt_timerIntHndl = (t_timerIntHndl *)
-            UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
+            pt_timerHndl->c_intCount--;
 
-            t_prevLinkHndl = UTL_GET_PREV_LINK( t_linkHndl);
-            if( pt_timerIntHndl->t_id == t_intId)
+            if( t_type == OVERFLOW)
             {
-               pt_timerHndl->c_intCount--;
-
-               if( t_type == OVERFLOW)
-               {
-                  if( pt_timerHndl->pt_timer0 != NULL)
-                     pt_timerHndl->pt_timer0->INTCTRLA &= ~TC_OVFINTLVL_HI_gc;
-                  else
-                     pt_timerHndl->pt_timer1->INTCTRLA &= ~TC_OVFINTLVL_HI_gc;
-
-               }/*End if( t_type == OVERFLOW)*/
-               else if( t_type == COMPAREA)
-               {
-                  if( pt_timerHndl->pt_timer0 != NULL)
-                     pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCAINTLVL_HI_gc;
-                  else
-                     pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCAINTLVL_HI_gc;
-
-               }
-               else if( t_type == COMPAREB)
-               {
-                  if( pt_timerHndl->pt_timer0 != NULL)
-                     pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCBINTLVL_HI_gc;
-                  else
-                     pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCBINTLVL_HI_gc;
-               }
-               else if( t_type == COMPAREC)
-               {
-                  if( pt_timerHndl->pt_timer0 != NULL)
-                     pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCCINTLVL_HI_gc;
-                  else
-                     pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCCINTLVL_HI_gc;
-               }
-               else if( t_type == COMPARED)
-               {
-                  if( pt_timerHndl->pt_timer0 != NULL)
-                     pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCDINTLVL_HI_gc;
-                  else
-                     pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCDINTLVL_HI_gc;
-               }
-
-               t_lErr = utl_destroyLink( gt_timerIntHndlList,
-                                         t_linkHndl);
-
-               t_linkHndl = t_prevLinkHndl;
-
-            }/*End if( pt_timerIntHndl->t_id == t_intId)*/
-
-         }/*End UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_timerIntHndlList, 
-         s_count)*/
+               if( pt_timerHndl->pt_timer0 != NULL)
+                  pt_timerHndl->pt_timer0->INTCTRLA &= ~TC_OVFINTLVL_HI_gc;
+               else
+                  pt_timerHndl->pt_timer1->INTCTRLA &= ~TC_OVFINTLVL_HI_gc;
+
+            }/*End if( t_type == OVERFLOW)*/
+            else if( t_type == COMPAREA)
+            {
+               if( pt_timerHndl->pt_timer0 != NULL)
+                  pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCAINTLVL_HI_gc;
+               else
+                  pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCAINTLVL_HI_gc;
+
+            }
+            else if( t_type == COMPAREB)
+            {
+               if( pt_timerHndl->pt_timer0 != NULL)
+                  pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCBINTLVL_HI_gc;
+               else
+                  pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCBINTLVL_HI_gc;
+            }
+            else if( t_type == COMPAREC)
+            {
+               if( pt_timerHndl->pt_timer0 != NULL)
+                  pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCCINTLVL_HI_gc;
+               else
+                  pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCCINTLVL_HI_gc;
+            }
+            else if( t_type == COMPARED)
+            {
+               if( pt_timerHndl->pt_timer0 != NULL)
+                  pt_timerHndl->pt_timer0->INTCTRLB &= ~TC_CCDINTLVL_HI_gc;
+               else
+                  pt_timerHndl->pt_timer1->INTCTRLB &= ~TC_CCDINTLVL_HI_gc;
+            }
+
+            utl_removeHandle( &gt_timerIntTable,
+                              t_intId);
+
+            t_lErr = utl_destroyLink( gt_timerIntHndlList,
+                                      UTL_GET_ELEMENT_LINK( pt_timerIntHndl));
+
+         }/*End if( pt_timerIntHndl != NULL)*/
 
       }/*End for( t_type = COMPAREA; t_type <= OVERFLOW; t_type++)*/
 
@@ -1349,6 +1322,9 @@ t_timerError hal_releaseTimer( t_TIMERHNDL t_handle)
 
       }
 
+      utl_removeHandle( &gt_timerTable,
+                        TIMER_MOD_SLOT( pt_timerHndl->t_id));
+
       t_lErr = utl_destroyLink( gt_timerHndlList,
                                 (t_LINKHNDL)t_handle);
 
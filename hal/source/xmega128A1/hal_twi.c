@@ -33,7 +33,8 @@
 #include <math.h>
 #include "arb_sysTimer.h"
 #include "hal_gpio.h"
-#include "utl_linkedList.h"
+#include "utl_linkedlist.h"
+#include "utl_handleTable.h"
 #include "hal_pmic.h"
 #include "hal_clocks.h"
 #include "hal_twi.h"
@@ -43,6 +44,8 @@
  *---------------------------------------------------------------------------*/
 #define TWI_MAX_SLAVE_ADDRESS (127)
 
+#define TWI_NUM_CHANNELS (4)
+
 /*---------------------------------------------------------------------------*
  * If there has been inactivity on the bus for this period of time the
  * particular TWI channel needs to be reset.
@@ -54,6 +57,12 @@
  *---------------------------------------------------------------------------*/
 typedef struct twiChanHndl
 {
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_twiChanHndlList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * A unique number referring to one of the 4 possible twi
     *------------------------------------------------------------------------*/
@@ -120,8 +129,6 @@ typedef struct twiChanHndl
  *---------------------------------------------------------------------------*/
 static t_LINKHNDL createTwiHandle( void);
 
-static t_twiChanHndl *findTwiElement( t_twiChanId t_id);
-
 static void hal_resetTwiMaster( TWI_MASTER_t *pt_master);
 
 static void hal_resetTwiSlave( TWI_SLAVE_t *pt_slave);
@@ -135,6 +142,11 @@ static void hal_resetTwiSlave( TWI_SLAVE_t *pt_slave);
  *---------------------------------------------------------------------------*/
 UTL_CREATE_CONTAINER( gt_twiChanHndlList);
 
+/*---------------------------------------------------------------------------*
+ * Maps a twi channel ID to its open handle, used directly by the ISRs.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CREATE( gt_twiChanTable, TWI_NUM_CHANNELS);
+
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
  *---------------------------------------------------------------------------*/
@@ -383,9 +395,9 @@ ISR( TWIC_TWIM_vect)
    t_twiChanHndl *pt_handle = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this twi interrupt.
+    * See if there is a handle registered for this twi interrupt.
     *------------------------------------------------------------------------*/
-   pt_handle = findTwiElement( (uint8_t)TWI_1);
+   pt_handle = utl_getHandle( &gt_twiChanTable, TWI_1);
 
    if( pt_handle != NULL)
    {
@@ -399,9 +411,9 @@ ISR(TWIC_TWIS_vect)
    t_twiChanHndl *pt_handle = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this twi interrupt.
+    * See if there is a handle registered for this twi interrupt.
     *------------------------------------------------------------------------*/
-   pt_handle = findTwiElement( (uint8_t)TWI_1);
+   pt_handle = utl_getHandle( &gt_twiChanTable, TWI_1);
 
    if( pt_handle != NULL)
    {
@@ -415,9 +427,9 @@ ISR( TWID_TWIM_vect)
     t_twiChanHndl *pt_handle = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this twi interrupt.
+    * See if there is a handle registered for this twi interrupt.
     *------------------------------------------------------------------------*/
-   pt_handle = findTwiElement( (uint8_t)TWI_2);
+   pt_handle = utl_getHandle( &gt_twiChanTable, TWI_2);
 
    if( pt_handle != NULL)
    {
@@ -431,9 +443,9 @@ ISR( TWID_TWIS_vect)
    t_twiChanHndl *pt_handle = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this twi interrupt.
+    * See if there is a handle registered for this twi interrupt.
     *------------------------------------------------------------------------*/
-   pt_handle = findTwiElement( (uint8_t)TWI_2);
+   pt_handle = utl_getHandle( &gt_twiChanTable, TWI_2);
 
    if( pt_handle != NULL)
    {
@@ -447,9 +459,9 @@ ISR( TWIE_TWIM_vect)
    t_twiChanHndl *pt_handle = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this twi interrupt.
+    * See if there is a handle registered for this twi interrupt.
     *------------------------------------------------------------------------*/
-   pt_handle = findTwiElement( (uint8_t)TWI_3);
+   pt_handle = utl_getHandle( &gt_twiChanTable, TWI_3);
 
    if( pt_handle != NULL)
    {
@@ -463,9 +475,9 @@ ISR( TWIE_TWIS_vect)
    t_twiChanHndl *pt_handle = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this twi interrupt.
+    * See if there is a handle registered for this twi interrupt.
     *------------------------------------------------------------------------*/
-   pt_handle = findTwiElement( (uint8_t)TWI_3);
+   pt_handle = utl_getHandle( &gt_twiChanTable, TWI_3);
 
    if( pt_handle != NULL)
    {
@@ -479,9 +491,9 @@ ISR( TWIF_TWIM_vect)
    t_twiChanHndl *pt_handle = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this twi interrupt.
+    * See if there is a handle registered for this twi interrupt.
     *------------------------------------------------------------------------*/
-   pt_handle = findTwiElement( (uint8_t)TWI_4);
+   pt_handle = utl_getHandle( &gt_twiChanTable, TWI_4);
 
    if( pt_handle != NULL)
    {
@@ -495,9 +507,9 @@ ISR( TWIF_TWIS_vect)
    t_twiChanHndl *pt_handle = NULL;
 
    /*------------------------------------------------------------------------*
-    * See if there is a handle on the list for this twi interrupt.
+    * See if there is a handle registered for this twi interrupt.
     *------------------------------------------------------------------------*/
-   pt_handle = findTwiElement( (uint8_t)TWI_4);
+   pt_handle = utl_getHandle( &gt_twiChanTable, TWI_4);
 
    if( pt_handle != NULL)
    {
@@ -506,33 +518,6 @@ ISR( TWIF_TWIS_vect)
 
 }/*End ISR( TWIF_TWIS_vect)*/
 
-static t_twiChanHndl *findTwiElement( t_twiChanId t_id)
-{
-   t_twiChanHndl *pt_element;
-   t_LINKHNDL t_linkHndl;
-   int16_t s_count;
-
-   /*------------------------------------------------------------------------*
-    * Search the twi list for the requested ID
-    *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_twiChanHndlList, s_count)
-   {
-      pt_element = (t_twiChanHndl *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-      if( pt_element->t_id == t_id)
-      {
-         return pt_element;
-      }
-
-   }
-
-   /*------------------------------------------------------------------------*
-    * If we make it this far the ID has not been found in the open twi module
-    * list.
-    *------------------------------------------------------------------------*/
-   return NULL;
-
-}/*End findTwiElement*/
-
 static t_LINKHNDL createTwiHandle( void)
 {
    t_LINKHNDL t_linkHndl;
@@ -627,7 +612,8 @@ t_TWIHNDL hal_requestTwiChannel( t_twiChanId t_chanId)
       return (t_TWIHNDL)TWI_INVALID_CHAN;
    }
 
-   pt_twiChanHndl = findTwiElement( t_chanId);
+   pt_twiChanHndl = utl_getHandle( &gt_twiChanTable,
+                                   t_chanId);
 
    /*------------------------------------------------------------------------*
     * Is this channel available?
@@ -653,6 +639,10 @@ t_TWIHNDL hal_requestTwiChannel( t_twiChanId t_chanId)
       pt_twiChanHndl->t_id          = t_chanId;
       pt_twiChanHndl->t_status      = TWI_IDLE;
 
+      utl_insertHandle( &gt_twiChanTable,
+                        t_chanId,
+                        pt_twiChanHndl);
+
    }/*End if( pt_twiChanHndl == NULL)*/
    else /*No*/
    {
@@ -703,6 +693,9 @@ t_twiError hal_releaseTwiChannel( t_TWIHNDL t_handle)
       else
          hal_resetTwiMaster( (TWI_MASTER_t *)pt_twiChanHndl->pt_master);
 
+      utl_removeHandle( &gt_twiChanTable,
+                        pt_twiChanHndl->t_id);
+
       t_lErr = utl_destroyLink( gt_twiChanHndlList,
                                 (t_LINKHNDL)t_handle);
 
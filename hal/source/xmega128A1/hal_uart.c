@@ -34,6 +34,7 @@
 #include "hal_uart.h"
 #include "hal_clocks.h"
 #include "utl_linkedlist.h"
+#include "utl_handleTable.h"
 #include "hal_gpio.h"
 #include "hal_pmic.h"
 #include "hal_dma.h"
@@ -44,11 +45,25 @@
 #define BSEL_MAX_RANGE  ((1 << 12) - 1)
 #define BSCALE_MAX_RAGE (7)
 
+#define UART_NUM_CHANNELS (8)
+
+/*---------------------------------------------------------------------------*
+ * The channel IDs are spaced three apart, this maps them onto consecutive
+ * slots of 'gt_uartChanTable'.
+ *---------------------------------------------------------------------------*/
+#define UART_CHAN_SLOT( t_id) ((uint8_t)(t_id) / 3)
+
 /*---------------------------------------------------------------------------*
  * Private Datatypes
  *---------------------------------------------------------------------------*/
 typedef struct
 {
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_uartChanHndlList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * A unique number referring to one of the 8 possible uarts
     *------------------------------------------------------------------------*/
@@ -136,24 +151,10 @@ typedef struct
 
 }t_uartChanHndl;
 
-typedef struct
-{
-   t_uartChanHndl *pt_uart1Chan;
-   t_uartChanHndl *pt_uart2Chan;
-   t_uartChanHndl *pt_uart3Chan;
-   t_uartChanHndl *pt_uart4Chan;
-   t_uartChanHndl *pt_uart5Chan;
-   t_uartChanHndl *pt_uart6Chan;
-   t_uartChanHndl *pt_uart7Chan;
-   t_uartChanHndl *pt_uart8Chan;
-
-}t_intChanMap;
-
 /*---------------------------------------------------------------------------*
  * Private Function Prototypes
  *---------------------------------------------------------------------------*/
 static t_LINKHNDL createUartHandle( void);
-static t_uartChanHndl *findUartElement( t_uartChanId t_id);
 static void uart1RxDmaInt( void);
 static void uart2RxDmaInt( void);
 static void uart3RxDmaInt( void);
@@ -177,13 +178,29 @@ static void updateRxDmaInt( t_uartChanHndl *pt_handle);
 /*---------------------------------------------------------------------------*
  * Private Global Variables
  *---------------------------------------------------------------------------*/
-static t_intChanMap gt_intChanMap = {NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL};
-
 /*---------------------------------------------------------------------------*
  * List of currently active UART modules.
  *---------------------------------------------------------------------------*/
 UTL_CREATE_CONTAINER( gt_uartChanHndlList);
 
+/*---------------------------------------------------------------------------*
+ * Maps a UART channel (UART_CHAN_SLOT) to its open handle, used directly by
+ * the interrupt routines.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CREATE( gt_uartChanTable, UART_NUM_CHANNELS);
+
+/*---------------------------------------------------------------------------*
+ * Every channel ID must fold onto its own slot of the table.
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CHECK_SLOT( UART_CHAN_SLOT( UART_1), 0, UART_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( UART_CHAN_SLOT( UART_2), 1, UART_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( UART_CHAN_SLOT( UART_3), 2, UART_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( UART_CHAN_SLOT( UART_4), 3, UART_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( UART_CHAN_SLOT( UART_5), 4, UART_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( UART_CHAN_SLOT( UART_6), 5, UART_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( UART_CHAN_SLOT( UART_7), 6, UART_NUM_CHANNELS);
+UTL_HANDLE_TABLE_CHECK_SLOT( UART_CHAN_SLOT( UART_8), 7, UART_NUM_CHANNELS);
+
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
  *---------------------------------------------------------------------------*/
@@ -313,7 +330,7 @@ static void uart1RxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart1Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_1));
 
    if( pt_handle != NULL)
    {
@@ -326,7 +343,7 @@ static void uart2RxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart2Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_2));
 
    if( pt_handle != NULL)
    {
@@ -339,7 +356,7 @@ static void uart3RxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart3Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_3));
 
    if( pt_handle != NULL)
    {
@@ -352,7 +369,7 @@ static void uart4RxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart4Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_4));
 
    if( pt_handle != NULL)
    {
@@ -365,7 +382,7 @@ static void uart5RxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart5Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_5));
 
    if( pt_handle != NULL)
    {
@@ -378,7 +395,7 @@ static void uart6RxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart6Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_6));
 
    if( pt_handle != NULL)
    {
@@ -391,7 +408,7 @@ static void uart7RxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart7Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_7));
 
    if( pt_handle != NULL)
    {
@@ -404,7 +421,7 @@ static void uart8RxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart8Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_8));
 
    if( pt_handle != NULL)
    {
@@ -417,7 +434,7 @@ static void uart1TxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart1Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_1));
 
    if( pt_handle != NULL)
    {
@@ -437,7 +454,7 @@ static void uart2TxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart2Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_2));
 
    if( pt_handle != NULL)
    {
@@ -457,7 +474,7 @@ static void uart3TxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart3Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_3));
 
    if( pt_handle != NULL)
    {
@@ -477,7 +494,7 @@ static void uart4TxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart4Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_4));
 
    if( pt_handle != NULL)
    {
@@ -497,7 +514,7 @@ static void uart5TxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart5Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_5));
 
    if( pt_handle != NULL)
    {
@@ -517,7 +534,7 @@ static void uart6TxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart6Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_6));
 
    if( pt_handle != NULL)
    {
@@ -537,7 +554,7 @@ static void uart7TxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart7Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_7));
 
    if( pt_handle != NULL)
    {
@@ -557,7 +574,7 @@ static void uart8TxDmaInt( void)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart8Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_8));
 
    if( pt_handle != NULL)
    {
@@ -577,7 +594,7 @@ ISR( USARTC0_RXC_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart1Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_1));
 
    if( pt_handle != NULL)
    {
@@ -590,7 +607,7 @@ ISR( USARTC0_DRE_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart1Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_1));
 
    if( pt_handle != NULL)
    {
@@ -603,7 +620,7 @@ ISR( USARTC1_RXC_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart2Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_2));
 
    if( pt_handle != NULL)
    {
@@ -616,7 +633,7 @@ ISR( USARTC1_DRE_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart2Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_2));
 
    if( pt_handle != NULL)
    {
@@ -629,7 +646,7 @@ ISR( USARTD0_RXC_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart3Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_3));
 
    if( pt_handle != NULL)
    {
@@ -642,7 +659,7 @@ ISR( USARTD0_DRE_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart3Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_3));
 
    if( pt_handle != NULL)
    {
@@ -655,7 +672,7 @@ ISR( USARTD1_RXC_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart4Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_4));
 
    if( pt_handle != NULL)
    {
@@ -668,7 +685,7 @@ ISR( USARTD1_DRE_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart4Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_4));
 
    if( pt_handle != NULL)
    {
@@ -681,7 +698,7 @@ ISR( USARTE0_RXC_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart5Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_5));
 
    if( pt_handle != NULL)
    {
@@ -694,7 +711,7 @@ ISR( USARTE0_DRE_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart5Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_5));
 
    if( pt_handle != NULL)
    {
@@ -707,7 +724,7 @@ ISR( USARTE1_RXC_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart6Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_6));
 
    if( pt_handle != NULL)
    {
@@ -720,7 +737,7 @@ ISR( USARTE1_DRE_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart6Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_6));
 
    if( pt_handle != NULL)
    {
@@ -733,7 +750,7 @@ ISR( USARTF0_RXC_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart7Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_7));
 
    if( pt_handle != NULL)
    {
@@ -746,7 +763,7 @@ ISR( USARTF0_DRE_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart7Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_7));
 
    if( pt_handle != NULL)
    {
@@ -759,7 +776,7 @@ ISR( USARTF1_RXC_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart8Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_8));
 
    if( pt_handle != NULL)
    {
@@ -772,7 +789,7 @@ ISR( USARTF1_DRE_vect)
 {
    t_uartChanHndl *pt_handle = NULL;
 
-   pt_handle = gt_intChanMap.pt_uart8Chan;
+   pt_handle = utl_getHandle( &gt_uartChanTable, UART_CHAN_SLOT( UART_8));
 
    if( pt_handle != NULL)
    {
@@ -781,33 +798,6 @@ ISR( USARTF1_DRE_vect)
 
 }/*End ISR( USARTF1_DRE_vect)*/
 
-static t_uartChanHndl *findUartElement( t_uartChanId t_id)
-{
-   t_uartChanHndl *pt_element;
-   t_LINKHNDL t_linkHndl;
-   int16_t s_count;
-
-   /*------------------------------------------------------------------------*
-    * Search the UART list for the requested ID
-    *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_linkHndl, gt_uartChanHndlList, s_count)
-   {
-      pt_element = (t_uartChanHndl *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
-      if( pt_element->t_id == t_id)
-      {
-         return pt_element;
-      }
-
-   }
-
-   /*------------------------------------------------------------------------*
-    * If we make it this far the ID has not been found in the open UART module
-    * list.
-    *------------------------------------------------------------------------*/
-   return NULL;
-
-}/*End findUartElement*/
-
 static t_LINKHNDL createUartHandle( void)
 {
 
@@ -1353,7 +1343,8 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
       return (t_UARTHNDL)UART_INVALID_MODULE;
    }
 
-   pt_uartChanHndl = findUartElement( t_chanId);
+   pt_uartChanHndl = utl_getHandle( &gt_uartChanTable,
+                                    UART_CHAN_SLOT( t_chanId));
 
    /*------------------------------------------------------------------------*
     * Is there a channel available?
@@ -1379,6 +1370,10 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
       pt_uartChanHndl->t_id = t_chanId;
       pt_uartChanHndl->i_baudRate = 0;
 
+      utl_insertHandle( &gt_uartChanTable,
+                        UART_CHAN_SLOT( t_chanId),
+                        pt_uartChanHndl);
+
       switch( t_chanId)
       {
          case UART_1:
@@ -1393,7 +1388,6 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
             t_conf.t_inConf       = TOTEM;
             t_conf.t_outConf      = TOTEM;
             t_gErr = hal_configureGpioPort( GPIO_PORTC, t_conf);
-            gt_intChanMap.pt_uart1Chan = pt_uartChanHndl;
 
          break;
 
@@ -1409,7 +1403,6 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
             t_conf.t_inConf       = TOTEM;
             t_conf.t_outConf      = TOTEM;
             t_gErr = hal_configureGpioPort( GPIO_PORTC, t_conf);
-            gt_intChanMap.pt_uart2Chan = pt_uartChanHndl;
 
          break;
 
@@ -1425,7 +1418,6 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
             t_conf.t_inConf       = TOTEM;
             t_conf.t_outConf      = TOTEM;
             t_gErr = hal_configureGpioPort( GPIO_PORTD, t_conf);
-            gt_intChanMap.pt_uart3Chan = pt_uartChanHndl;
 
          break;
 
@@ -1441,7 +1433,6 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
             t_conf.t_inConf       = TOTEM;
             t_conf.t_outConf      = TOTEM;
             t_gErr = hal_configureGpioPort( GPIO_PORTD, t_conf);
-            gt_intChanMap.pt_uart4Chan = pt_uartChanHndl;
 
          break;
 
@@ -1457,7 +1448,6 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
             t_conf.t_inConf       = PULLUP;//TOTEM;
             t_conf.t_outConf      = TOTEM;
             t_gErr = hal_configureGpioPort( GPIO_PORTE, t_conf);
-            gt_intChanMap.pt_uart5Chan = pt_uartChanHndl;
 
          break;
 
@@ -1473,7 +1463,6 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
             t_conf.t_inConf       = PULLUP;//TOTEM;
             t_conf.t_outConf      = TOTEM;
             t_gErr = hal_configureGpioPort( GPIO_PORTE, t_conf);
-            gt_intChanMap.pt_uart6Chan = pt_uartChanHndl;
 
          break;
 
@@ -1489,7 +1478,6 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
             t_conf.t_inConf       = PULLUP;//TOTEM;
             t_conf.t_outConf      = TOTEM;
             t_gErr = hal_configureGpioPort( GPIO_PORTF, t_conf);
-            gt_intChanMap.pt_uart7Chan = pt_uartChanHndl;
 
          break;
 
@@ -1505,7 +1493,6 @@ t_UARTHNDL hal_requestUartChannel( t_uartChanId t_chanId)
             t_conf.t_inConf       = PULLUP;//TOTEM;
             t_conf.t_outConf      = TOTEM;
             t_gErr = hal_configureGpioPort( GPIO_PORTF, t_conf);
-            gt_intChanMap.pt_uart8Chan = pt_uartChanHndl;
 
          break;
 
@@ -1573,41 +1560,8 @@ t_uartError hal_releaseUartChannel( t_UARTHNDL t_handle)
       pt_uartChanHndl->pt_uart->BAUDCTRLB &= ~0x0F; /*BSEL in control B reg*/
       pt_uartChanHndl->pt_uart->BAUDCTRLB &= ~USART_BSCALE_gm;
 
-      switch( pt_uartChanHndl->t_id)
-      {
-         case UART_1:
-            gt_intChanMap.pt_uart1Chan = NULL;
-         break;
-
-         case UART_2:
-            gt_intChanMap.pt_uart2Chan = NULL;
-         break;
-
-         case UART_3:
-            gt_intChanMap.pt_uart3Chan = NULL;
-         break;
-
-         case UART_4:
-            gt_intChanMap.pt_uart4Chan = NULL;
-         break;
-
-         case UART_5:
-            gt_intChanMap.pt_uart5Chan = NULL;
-         break;
-
-         case UART_6:
-            gt_intChanMap.pt_uart6Chan = NULL;
-         break;
-
-         case UART_7:
-            gt_intChanMap.pt_uart7Chan = NULL;
-         break;
-
-         case UART_8:
-            gt_intChanMap.pt_uart8Chan = NULL;
-         break;
-
-      }/*End switch( pt_uartChanHndl->t_id)*/
+      utl_removeHandle( &gt_uartChanTable,
+                        UART_CHAN_SLOT( pt_uartChanHndl->t_id));
 
       t_lErr = utl_destroyLink( gt_uartChanHndlList,
                                 (t_LINKHNDL)t_handle);
@@ -28,7 +28,7 @@
 /*---------------------------------------------------------------------------*
  * Include Files
  *---------------------------------------------------------------------------*/
-#include "utl_linkedList.h"
+#include "utl_linkedlist.h"
 #include "hal_watchDog.h"
 #include "hal_pmic.h"
 
@@ -42,6 +42,12 @@
 typedef struct
 {
 
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_wdAccessList', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * If true, then 'hal_configureWd' successfully completed
     *------------------------------------------------------------------------*/
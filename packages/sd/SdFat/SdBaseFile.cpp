@@ -196,6 +196,52 @@ bool SdBaseFile::createContiguous(SdBaseFile* dirFile,
   return false;
 }
 //------------------------------------------------------------------------------
+/** Allocate a contiguous cluster chain for an open, empty file.
+ *
+ * The clusters are attached to the file but the file size remains zero,
+ * so writes fill the chain in order without searching the FAT for free
+ * clusters. Writing beyond \a size extends the chain as usual.
+ *
+ * \param[in] size The number of bytes to allocate.
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ * Reasons for failure include a file that is not empty or not open for
+ * write, no contiguous free space on the volume or an I/O error.
+ */
+bool SdBaseFile::preAllocate(uint32_t size) {
+  uint32_t count;
+  if (!isFile() || !(flags_ & O_WRITE) || fileSize_ != 0 || size == 0) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  // release a chain left over from a previous allocation
+  if (firstCluster_) {
+    if (!vol_->freeChain(firstCluster_)) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    firstCluster_ = 0;
+  }
+  // calculate number of clusters needed
+  count = ((size - 1) >> (vol_->clusterSizeShift_ + 9)) + 1;
+
+  if (!vol_->allocContiguous(count, &firstCluster_)) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  curCluster_ = 0;
+  curPosition_ = 0;
+
+  // insure sync() will update dir entry
+  flags_ |= F_FILE_DIR_DIRTY;
+
+  return sync();
+
+ fail:
+  return false;
+}
+//------------------------------------------------------------------------------
 /** Return a file's directory entry.
  *
  * \param[out] dir Location for return of the file's directory entry.
@@ -2123,8 +2169,9 @@ bool SdBaseFile::truncate(uint32_t length) {
     DBG_FAIL_MACRO;
     goto fail;
   }
-  // fileSize and length are zero - nothing to do
-  if (fileSize_ == 0) return true;
+  // fileSize and length are zero - nothing to do unless clusters were
+  // pre-allocated
+  if (fileSize_ == 0 && firstCluster_ == 0) return true;
 
   // remember position for seek after truncation
   newPos = curPosition_ > length ? length : curPosition_;
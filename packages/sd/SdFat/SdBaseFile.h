@@ -235,6 +235,7 @@ class SdBaseFile {
   bool contiguousRange(uint32_t* bgnBlock, uint32_t* endBlock);
   bool createContiguous(SdBaseFile* dirFile,
           const char* path, uint32_t size);
+  bool preAllocate(uint32_t size);
   /** \return The current cluster number for a file or directory. */
   uint32_t curCluster() const {return curCluster_;}
   /** \return The current position for a file or directory. */
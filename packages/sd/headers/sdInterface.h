@@ -97,6 +97,14 @@
 
    int32_t sd_fileSize( void *pv_fileHndle);
 
+   bool sd_preAllocate( void *pv_fileHndle,
+                        uint32_t i_size);
+
+   bool sd_sync( void *pv_fileHndle);
+
+   bool sd_seek( void *pv_fileHndle,
+                 uint32_t i_pos);
+
    #ifdef __cplusplus
    }/*End extern "C"*/
    #endif
@@ -274,3 +274,23 @@ bool sd_truncate( void *pv_fileHndle,
    SdFile *pt_file = (SdFile *)pv_fileHndle;
    return pt_file->truncate( i_length);
 }/*End sd_truncate*/
+
+bool sd_preAllocate( void *pv_fileHndle,
+                     uint32_t i_size)
+{
+   SdFile *pt_file = (SdFile *)pv_fileHndle;
+   return pt_file->preAllocate( i_size);
+}/*End sd_preAllocate*/
+
+bool sd_sync( void *pv_fileHndle)
+{
+   SdFile *pt_file = (SdFile *)pv_fileHndle;
+   return pt_file->sync();
+}/*End sd_sync*/
+
+bool sd_seek( void *pv_fileHndle,
+              uint32_t i_pos)
+{
+   SdFile *pt_file = (SdFile *)pv_fileHndle;
+   return pt_file->seekSet( i_pos);
+}/*End sd_seek*/
@@ -123,9 +123,18 @@ static void usr_platformInit( void)
     * Initialize the console interface.
     *------------------------------------------------------------------------*/
    if( arb_consoleInit( "consoleDevice0",
+                        "sdDevice0",
                         ARB_STACK_1024B,
                         254,
-                        &usr_console) < 0)
+                        NULL) < 0)
+   {
+      exit(0);
+   }
+
+   /*------------------------------------------------------------------------*
+    * Register the user-space console commands.
+    *------------------------------------------------------------------------*/
+   if( usr_consoleInit() < 0)
    {
       exit(0);
    }
@@ -60,67 +60,46 @@
 /*---------------------------------------------------------------------------*
  * Private Function Definitions
  *---------------------------------------------------------------------------*/
-static void usr_displayUserHelp( t_DEVHANDLE t_consoleHndl,
-                                 int8_t *pc_buff)
-{
-   uint16_t s_size;
-
-   /*------------------------------------------------------------------------*
-    * Display a list of all the possible console commands specific
-    * to a user-space application.
-    *------------------------------------------------------------------------*/
-   s_size = sprintf_P( (char *)pc_buff, PSTR(".------------------------------------------------------------------------.\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| Command |     Arguments     |              Description                 |\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("|---------|-------------------|------------------------------------------|\n\r"));
-   arb_write( t_consoleHndl,
-              pc_buff,
-              s_size);
-   /*########################################################################
-     # Describe your commands here like the following example...
-     #
-     # s_size = sprintf_P( (char *)pc_buff, PSTR("| pwr     |                   | Returns the measured platform voltage.   |\n\r"));
-     # arb_write( t_consoleHndl,
-     #            pc_buff,
-     #            s_size);
-     ########################################################################*/
-}/*End usr_displayUserHelp*/
+/*###########################################################################
+  # Define a handler for each of your commands like the following example...
+  #
+  # static bool usr_getPower( t_DEVHANDLE t_consoleHndl,
+  #                           int8_t *pc_buff,
+  #                           t_consoleTokHndl *pt_tokHndl)
+  # {
+  #    uint16_t s_size;
+  #
+  #    if( pt_tokHndl->c_numTokens != 1)
+  #       return false;
+  #
+  #    s_size = sprintf_P( (char *)pc_buff, PSTR("%f\n\r"), usr_getVoltage());
+  #    arb_write( t_consoleHndl,
+  #               pc_buff,
+  #               s_size);
+  #
+  #    return true;
+  # }
+  ###########################################################################*/
 
 /*---------------------------------------------------------------------------*
  * Public Function Definitions
  *---------------------------------------------------------------------------*/
-bool usr_console( t_DEVHANDLE t_consoleHndl,
-                  int8_t *pc_buff,
-                  t_consoleTokHndl *pt_tokHndl)
+t_error usr_consoleInit( void)
 {
+   t_error t_err = ARB_PASSED;
 
-   bool b_success = true; /*A valid command was found...*/
-
-   if( strcmp( (char *)pt_tokHndl->ac_tok[0], "hlpu") == 0)
-   {
-      /*---------------------------------------------------------------------*
-       * Display a list of all the possible user-space specific commands.
-       *---------------------------------------------------------------------*/
-      usr_displayUserHelp( t_consoleHndl,
-                           pc_buff);
-
-   }/*End else if( strcmp( (char *)pt_tokHndl->ac_tok[0], "hlpu") == 0)*/
-   else /*Unrecognized message*/
-   {
-      /*---------------------------------------------------------------------*
-       * Let 'arb_console' know the command wasn't found.
-       *---------------------------------------------------------------------*/
-      b_success = false;
-   }
+   /*########################################################################
+     # Register your commands here like the following example. The command
+     # name and description are stored in program memory and the description
+     # is displayed by the kernel's 'help' command.
+     #
+     # t_err = arb_consoleRegisterCmd( PSTR("pwr"),
+     #                                 usr_getPower,
+     #                                 PSTR("Returns the measured platform voltage."));
+     # if( t_err < 0)
+     #    return t_err;
+     ########################################################################*/
 
-   /*------------------------------------------------------------------------*
-    * Return control over the console to the kernel...
-    *------------------------------------------------------------------------*/
-   return b_success;
+   return t_err;
 
-}/*End usr_console*/
+}/*End usr_consoleInit*/
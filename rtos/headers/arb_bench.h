@@ -0,0 +1,99 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : arb_bench.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : The standard benchmark suites for the kernel primitives:
+ *               context switch, semaphore ping-pong, mailbox round trip,
+ *               link creation, and the buffer and ring operations. The
+ *               math suites live in utl_mathBench.
+ *               'arb_benchInit' creates the partner threads the suites talk
+ *               to, and 'arb_benchRun' times every suite with utl_bench and
+ *               writes the CSV report to a device. The same suites run on
+ *               the xmega and in the host build.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef arb_bench_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define arb_bench_h
+
+   /*------------------------------------------------------------------------*
+    * Operations per sample, samples per suite, and the calls discarded
+    * before sampling starts.
+    *------------------------------------------------------------------------*/
+   #define ARB_BENCH_ITERATIONS (16)
+   #define ARB_BENCH_SAMPLES    (15)
+   #define ARB_BENCH_WARMUP     (2)
+
+   /*------------------------------------------------------------------------*
+    * Number of partner threads, they take the priorities 't_prio' through
+    * 't_prio + ARB_BENCH_NUM_PARTNERS - 1' passed to 'arb_benchInit'.
+    *------------------------------------------------------------------------*/
+   #define ARB_BENCH_NUM_PARTNERS (3)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+   #include "arb_error.h"
+   #include "arb_thread.h"
+   #include "arb_device.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Creates the partner threads, semaphores, and mailboxes used by the
+    * suites and starts the cycle counter.
+    *------------------------------------------------------------------------*/
+   t_error arb_benchInit( t_thrdPrio t_prio);
+
+   /*------------------------------------------------------------------------*
+    * Runs every suite and writes the report to 't_outHndl'. Must be called
+    * from a thread of lower priority than the partners, with at least
+    * ARB_STACK_512B of stack.
+    *------------------------------------------------------------------------*/
+   t_error arb_benchRun( t_DEVHANDLE t_outHndl);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef arb_bench_h*/
@@ -41,6 +41,12 @@
    #define arb_console_h
    #define MAX_CONSOLE_BUFF_SIZE (300)
 
+   /*------------------------------------------------------------------------*
+    * Maximum number of commands (kernel and user-space) that can be
+    * registered with the console.
+    *------------------------------------------------------------------------*/
+   #define ARB_CONSOLE_MAX_CMDS  (24)
+
    /*------------------------------------------------------------------------*
     * Include Files
     *------------------------------------------------------------------------*/
@@ -49,6 +55,21 @@
    #include "arb_device.h"
    #include "arb_thread.h"
 
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Signature of a console command handler. 'pc_buff' is a scratch buffer
+    * of size MAX_CONSOLE_BUFF_SIZE and 'pt_tokHndl' holds the tokenized
+    * command line, where ac_tok[0] is the command itself. A handler returns
+    * 'false' if the arguments are invalid, in which case the console prints
+    * an error message.
+    *------------------------------------------------------------------------*/
+   typedef bool (*t_consoleCmdHndlr)( t_DEVHANDLE t_consoleHndl,
+                                      int8_t *pc_buff,
+                                      t_consoleTokHndl *pt_tokHndl);
+
    /*------------------------------------------------------------------------*
     * Global Variables
     *------------------------------------------------------------------------*/
@@ -60,9 +81,11 @@
                             char *pc_sdDriver,
                             t_stackSize t_stack,
                             t_thrdPrio t_pri,
-                            bool (*pf_funPtr)( t_DEVHANDLE t_consoleHndl,
-                                               int8_t *pc_buff,
-                                               t_consoleTokHndl *pt_tokHndl));
+                            t_consoleCmdHndlr pf_funPtr);
+
+   t_error arb_consoleRegisterCmd( const char *pc_name,
+                                   t_consoleCmdHndlr pf_handler,
+                                   const char *pc_help);
 
    #ifdef __cplusplus
    }/*End extern "C"*/
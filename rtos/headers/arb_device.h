@@ -49,7 +49,7 @@
    #include "avr_compiler.h"
    #include "arb_error.h"
    #include "arb_semaphore.h"
-   #include "utl_linkedList.h"
+   #include "utl_linkedlist.h"
 
    /*------------------------------------------------------------------------*
     * Global Typedefs
@@ -60,7 +60,7 @@
     * This type def defines the handle for interfacing the user space
     * application and driver.
     *------------------------------------------------------------------------*/
-   typedef volatile int16_t t_DEVHANDLE;
+   typedef volatile intptr_t t_DEVHANDLE;
 
    typedef volatile int16_t t_deviceId;
 
@@ -96,6 +96,12 @@
     *------------------------------------------------------------------------*/
    typedef struct
    {
+      /*---------------------------------------------------------------------*
+       * Link on 'gt_activeDevices', must be the first member (see
+       * utl_linkedlist.h).
+       *---------------------------------------------------------------------*/
+      t_listLink t_link;
+
       /*---------------------------------------------------------------------*
        * The identification number of the device registering with the kernel
        *---------------------------------------------------------------------*/
@@ -122,6 +128,12 @@
 
    typedef struct
    {
+      /*---------------------------------------------------------------------*
+       * Link on 'gt_activeHandles', must be the first member (see
+       * utl_linkedlist.h).
+       *---------------------------------------------------------------------*/
+      t_listLink t_link;
+
       /*---------------------------------------------------------------------*
        * Pointer to the particular device this handle is accessing.
        *---------------------------------------------------------------------*/
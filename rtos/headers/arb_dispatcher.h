@@ -0,0 +1,168 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : arb_dispatcher.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Event driven state machines (active objects) which share a
+ *               single dispatcher thread. Each object pairs a utl_stateMachine
+ *               with a small event queue; an event is simply a request to
+ *               move to a state along with the data passed to its actions.
+ *               Events can be posted from a thread or an ISR and the
+ *               dispatcher runs the engine of the highest priority object
+ *               with a pending event, so protocols no longer need their own
+ *               polling thread and stack.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef arb_dispatcher_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define arb_dispatcher_h
+
+   /*------------------------------------------------------------------------*
+    * The max number of objects sharing the dispatcher, also the number of
+    * priority levels (0 being the highest).
+    *------------------------------------------------------------------------*/
+   #define ARB_DSP_MAX_OBJECTS (8)
+
+   /*------------------------------------------------------------------------*
+    * The number of events each object can hold, must be a power of two.
+    *------------------------------------------------------------------------*/
+   #define ARB_DSP_QUEUE_SIZE  (4)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+   #include "arb_error.h"
+   #include "arb_thread.h"
+   #include "utl_stateMachine.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef struct
+   {
+      /*---------------------------------------------------------------------*
+       * The state to move to.
+       *---------------------------------------------------------------------*/
+      uint8_t c_state;
+      /*---------------------------------------------------------------------*
+       * Passed to the actions of 'c_state'.
+       *---------------------------------------------------------------------*/
+      int32_t i_data;
+
+   }t_dspEvent;
+
+   typedef struct
+   {
+      /*---------------------------------------------------------------------*
+       * The machine driven by this object, initialized by the owner with
+       * 'utl_stMnInit' before the object is registered.
+       *---------------------------------------------------------------------*/
+      t_stateMachine t_stMn;
+      /*---------------------------------------------------------------------*
+       * Pending events, indexed by free-running head and tail counters.
+       *---------------------------------------------------------------------*/
+      t_dspEvent at_queue[ARB_DSP_QUEUE_SIZE];
+      volatile uint8_t c_head;
+      volatile uint8_t c_tail;
+      /*---------------------------------------------------------------------*
+       * Number of system ticks until 'c_timeoutState' is posted, 0 when
+       * disarmed.
+       *---------------------------------------------------------------------*/
+      volatile uint16_t s_timeout;
+      uint8_t c_timeoutState;
+      /*---------------------------------------------------------------------*
+       * Bumped every time the time event is armed or disarmed. A queued
+       * time event carries the value it was armed with and is dropped if
+       * the two no longer match when it is dispatched.
+       *---------------------------------------------------------------------*/
+      volatile uint16_t s_timeoutGen;
+      /*---------------------------------------------------------------------*
+       * Slot in the dispatcher table, UTL_STMN_NO_STATE when not registered.
+       *---------------------------------------------------------------------*/
+      uint8_t c_prio;
+
+   }t_activeObject;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Creates the dispatcher thread, must be called (from 'usr_appInit')
+    * before any object is registered.
+    *------------------------------------------------------------------------*/
+   t_THRDHANDLE arb_dispatcherInit( t_stackSize t_stack,
+                                    t_thrdPrio t_pri);
+
+   /*------------------------------------------------------------------------*
+    * Adds 'pt_obj' to the dispatcher at priority 'c_prio' (0 to
+    * ARB_DSP_MAX_OBJECTS - 1, 0 being the highest). Each priority can only
+    * be used by one object.
+    *------------------------------------------------------------------------*/
+   t_error arb_activeObjectRegister( t_activeObject *pt_obj,
+                                     uint8_t c_prio);
+
+   t_error arb_activeObjectRemove( t_activeObject *pt_obj);
+
+   /*------------------------------------------------------------------------*
+    * Queues a request for 'pt_obj' to move to 'c_state', safe to call from
+    * an ISR. Posting the current state runs its action again. Events whose
+    * transition isn't allowed by the state table are dropped when
+    * dispatched.
+    *------------------------------------------------------------------------*/
+   t_error arb_activeObjectPost( t_activeObject *pt_obj,
+                                 uint8_t c_state,
+                                 int32_t i_data);
+
+   /*------------------------------------------------------------------------*
+    * Posts 'c_state' once 's_ticks' system ticks have passed, replacing any
+    * time event already armed. Passing 0 ticks disarms the time event; one
+    * that has expired but is still sitting in the queue is discarded.
+    *------------------------------------------------------------------------*/
+   void arb_activeObjectArmTimeout( t_activeObject *pt_obj,
+                                    uint16_t s_ticks,
+                                    uint8_t c_state);
+
+   /*------------------------------------------------------------------------*
+    * Called once per system tick from the system timer interrupt.
+    *------------------------------------------------------------------------*/
+   void arb_dispatcherTick( void);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef arb_dispatcher_h*/
@@ -44,6 +44,7 @@
     *------------------------------------------------------------------------*/
    typedef enum
    {
+      ARB_TABLE_FULL       = -17,/*A fixed size table has no free entry*/
       ARB_OPEN_ERROR       = -16,/*A file failed to open*/
       ARB_MBX_EMPTY        = -15,/*A mailbox queue is empty*/
       ARB_MBX_FULL         = -14,/*A mailbox queue is full*/
@@ -47,7 +47,7 @@
    #include "arb_error.h"
    #include "arb_thread.h"
    #include "arb_semaphore.h"
-   #include "utl_linkedList.h"
+   #include "utl_linkedlist.h"
 
    /*------------------------------------------------------------------------*
     * Global Typedefs
@@ -88,7 +88,7 @@
 
    }t_mailboxConfig; /*Configuration for a particular mailbox*/
 
-   typedef volatile int16_t t_MAILBOXHNDL; /*Mailbox handle type*/
+   typedef volatile intptr_t t_MAILBOXHNDL; /*Mailbox handle type*/
 
    /*------------------------------------------------------------------------*
     * Global Variables
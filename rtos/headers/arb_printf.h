@@ -94,6 +94,12 @@
 
    uint8_t arb_getPrintfDbgLevel( void);
 
+   /*------------------------------------------------------------------------*
+    * Returns the number of messages discarded because the log buffer was
+    * full.
+    *------------------------------------------------------------------------*/
+   uint32_t arb_getPrintfDropCount( void);
+
    void arb_sysPrintChar( const char c_buff);
 
    #ifdef __cplusplus
@@ -44,7 +44,7 @@
    #include "avr_compiler.h"
    #include "arb_error.h"
    #include "arb_thread.h"
-   #include "utl_linkedList.h"
+   #include "utl_linkedlist.h"
 
    /*------------------------------------------------------------------------*
     * Global Typedefs
@@ -85,7 +85,7 @@
 
    }t_semMode;
 
-   typedef volatile int16_t t_SEMHANDLE; /*Semaphore handle type*/
+   typedef volatile intptr_t t_SEMHANDLE; /*Semaphore handle type*/
 
    /*------------------------------------------------------------------------*
     * Global Variables
@@ -107,6 +107,13 @@
 
    t_error arb_signal( t_SEMHANDLE t_semHandle)  __attribute__ ((noinline));
 
+   /*------------------------------------------------------------------------*
+    * 'arb_signal' for code running inside the system timer interrupt, where
+    * the interrupted thread has already been saved. Wakes the waiting
+    * thread without switching to it and leaves that to the scheduler.
+    *------------------------------------------------------------------------*/
+   void arb_signalFromTick( t_SEMHANDLE t_semHandle);
+
    t_error arb_semaphoreInit( t_SEMHANDLE t_semHandle,
                               int16_t s_value);
 
@@ -106,7 +106,7 @@
 
    typedef uint8_t t_thrdPrio;   /*Thread priority 0->255 with 0 being highest*/
 
-   typedef volatile int16_t t_THRDHANDLE;  /*Thread handle type*/
+   typedef volatile intptr_t t_THRDHANDLE; /*Thread handle type*/
 
    typedef int16_t t_parameters; /*Thread function parameters*/
 
@@ -114,6 +114,12 @@
 
    typedef struct TCB
    {
+      /*--------------------------------------------------------------------*
+       * Places this thread on either 'gt_activeThreads' or the blocked list
+       * of a semaphore. Must be the first member, see utl_linkedlist.h.
+       *--------------------------------------------------------------------*/
+      t_listLink t_link;
+
       /*--------------------------------------------------------------------*
        * Thread identification number.
        *--------------------------------------------------------------------*/
@@ -139,12 +145,12 @@
       /*--------------------------------------------------------------------*
        * Starting address of the stack.
        *--------------------------------------------------------------------*/
-      uint16_t s_stackStart;
+      uintptr_t s_stackStart;
 
       /*--------------------------------------------------------------------*
        * Ending address of the stack.
        *--------------------------------------------------------------------*/
-      uint16_t s_stackEnd;
+      uintptr_t s_stackEnd;
 
       /*--------------------------------------------------------------------*
        * Location of where the stack pointer last left off for this thread.
@@ -153,7 +159,7 @@
        * OS. After performing a context save, this value will be increased
        * so that it spans all 32 registers and the SREG.
        *--------------------------------------------------------------------*/
-      uint16_t s_sP;
+      uintptr_t s_sP;
 
       /*--------------------------------------------------------------------*
        * Storage location of the stack for this thread. After a context save,
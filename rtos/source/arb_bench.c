@@ -0,0 +1,488 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : arb_bench.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for the standard kernel benchmark
+ *               suites and the partner threads they exercise.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "arb_bench.h"
+#include "arb_semaphore.h"
+#include "arb_mailbox.h"
+#include "utl_linkedlist.h"
+#include "utl_buffer.h"
+#include "utl_ring.h"
+#include "utl_bench.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define BENCH_MSG_BYTES  (8)
+#define BENCH_BUF_BYTES  (64)
+#define BENCH_BLOCK_SIZE (16)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   /*------------------------------------------------------------------------*
+    * True once 'arb_benchInit' has completed.
+    *------------------------------------------------------------------------*/
+   bool b_init;
+
+   /*------------------------------------------------------------------------*
+    * Priority of the lowest priority partner.
+    *------------------------------------------------------------------------*/
+   t_thrdPrio t_lowestPrio;
+
+   /*------------------------------------------------------------------------*
+    * Blocks the switch partner, each signal wakes it for one loop.
+    *------------------------------------------------------------------------*/
+   t_SEMHANDLE t_switchSem;
+
+   /*------------------------------------------------------------------------*
+    * The ping is answered by the pong partner with a pong.
+    *------------------------------------------------------------------------*/
+   t_SEMHANDLE t_pingSem;
+   t_SEMHANDLE t_pongSem;
+
+   /*------------------------------------------------------------------------*
+    * Only ever signaled and waited on by the caller, nothing blocks on it.
+    *------------------------------------------------------------------------*/
+   t_SEMHANDLE t_localSem;
+
+   /*------------------------------------------------------------------------*
+    * Messages written to the request mailbox are echoed back on the reply
+    * mailbox.
+    *------------------------------------------------------------------------*/
+   t_MAILBOXHNDL t_requestMbx;
+   t_MAILBOXHNDL t_replyMbx;
+
+   /*------------------------------------------------------------------------*
+    * Container the created links are inserted onto.
+    *------------------------------------------------------------------------*/
+   t_listContainer t_linkCont;
+
+   /*------------------------------------------------------------------------*
+    * Buffer exercised by the buffer suites.
+    *------------------------------------------------------------------------*/
+   t_buffer t_buf;
+   int8_t ac_bufStorage[BENCH_BUF_BYTES];
+
+   /*------------------------------------------------------------------------*
+    * Ring exercised by the ring suites, the same size as the buffer so the
+    * two can be compared.
+    *------------------------------------------------------------------------*/
+   t_ring t_ring;
+   int8_t ac_ringStorage[BENCH_BUF_BYTES];
+
+}t_benchObject;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void arb_benchSwitchThread( t_parameters t_param,
+                                   t_arguments t_args);
+static void arb_benchPongThread( t_parameters t_param,
+                                 t_arguments t_args);
+static void arb_benchEchoThread( t_parameters t_param,
+                                 t_arguments t_args);
+static void arb_benchCtxSwitch( void *pv_arg,
+                                uint16_t s_iterations);
+static void arb_benchPingPong( void *pv_arg,
+                               uint16_t s_iterations);
+static void arb_benchSignalWait( void *pv_arg,
+                                 uint16_t s_iterations);
+static void arb_benchMbxRoundTrip( void *pv_arg,
+                                   uint16_t s_iterations);
+static void arb_benchCreateLink( void *pv_arg,
+                                 uint16_t s_iterations);
+static void arb_benchBufferByte( void *pv_arg,
+                                 uint16_t s_iterations);
+static void arb_benchBufferBlock( void *pv_arg,
+                                  uint16_t s_iterations);
+static void arb_benchRingByte( void *pv_arg,
+                               uint16_t s_iterations);
+static void arb_benchRingBlock( void *pv_arg,
+                                uint16_t s_iterations);
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static t_benchObject gt_benchObject;
+
+/*---------------------------------------------------------------------------*
+ * The standard suites, in the order they are reported.
+ *---------------------------------------------------------------------------*/
+static const t_benchCase gat_benchSuites[] =
+{
+   /*------------------------------------------------------------------------*
+    * Wakes a higher priority thread which immediately blocks again, two
+    * context switches per iteration.
+    *------------------------------------------------------------------------*/
+   {"ctxSwitch", &arb_benchCtxSwitch, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES},
+   {"semPingPong", &arb_benchPingPong, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES},
+   {"signalWait", &arb_benchSignalWait, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES},
+   {"mbxRoundTrip", &arb_benchMbxRoundTrip, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES},
+   /*------------------------------------------------------------------------*
+    * Create, insert, and destroy of a link with an 8 byte element.
+    *------------------------------------------------------------------------*/
+   {"utl_createLink", &arb_benchCreateLink, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES},
+   {"bufferByte", &arb_benchBufferByte, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES},
+   {"bufferBlock16", &arb_benchBufferBlock, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES},
+   {"ringByte", &arb_benchRingByte, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES},
+   {"ringBlock16", &arb_benchRingBlock, NULL, ARB_BENCH_ITERATIONS,
+    ARB_BENCH_WARMUP, ARB_BENCH_SAMPLES}
+};
+
+#define BENCH_NUM_SUITES (sizeof( gat_benchSuites) / sizeof( t_benchCase))
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void arb_benchSwitchThread( t_parameters t_param,
+                                   t_arguments t_args)
+{
+   while( RUN_FOREVER)
+   {
+      arb_wait( gt_benchObject.t_switchSem, BLOCKING);
+
+   }/*End while( RUN_FOREVER)*/
+
+}/*End arb_benchSwitchThread*/
+
+static void arb_benchPongThread( t_parameters t_param,
+                                 t_arguments t_args)
+{
+   while( RUN_FOREVER)
+   {
+      arb_wait( gt_benchObject.t_pingSem, BLOCKING);
+      arb_signal( gt_benchObject.t_pongSem);
+
+   }/*End while( RUN_FOREVER)*/
+
+}/*End arb_benchPongThread*/
+
+static void arb_benchEchoThread( t_parameters t_param,
+                                 t_arguments t_args)
+{
+   int8_t ac_msg[BENCH_MSG_BYTES];
+   int16_t s_size;
+
+   while( RUN_FOREVER)
+   {
+      s_size = arb_mailboxRead( gt_benchObject.t_requestMbx,
+                                ac_msg,
+                                sizeof( ac_msg));
+      if( s_size > 0)
+      {
+         arb_mailboxWrite( gt_benchObject.t_replyMbx,
+                           ac_msg,
+                           (uint16_t)s_size);
+      }
+
+   }/*End while( RUN_FOREVER)*/
+
+}/*End arb_benchEchoThread*/
+
+static void arb_benchCtxSwitch( void *pv_arg,
+                                uint16_t s_iterations)
+{
+   while( s_iterations--)
+      arb_signal( gt_benchObject.t_switchSem);
+
+}/*End arb_benchCtxSwitch*/
+
+static void arb_benchPingPong( void *pv_arg,
+                               uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      arb_signal( gt_benchObject.t_pingSem);
+      arb_wait( gt_benchObject.t_pongSem, BLOCKING);
+   }
+
+}/*End arb_benchPingPong*/
+
+static void arb_benchSignalWait( void *pv_arg,
+                                 uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      arb_signal( gt_benchObject.t_localSem);
+      arb_wait( gt_benchObject.t_localSem, BLOCKING);
+   }
+
+}/*End arb_benchSignalWait*/
+
+static void arb_benchMbxRoundTrip( void *pv_arg,
+                                   uint16_t s_iterations)
+{
+   int8_t ac_msg[BENCH_MSG_BYTES];
+
+   memset( (void *)ac_msg, 0, sizeof( ac_msg));
+
+   while( s_iterations--)
+   {
+      arb_mailboxWrite( gt_benchObject.t_requestMbx,
+                        ac_msg,
+                        sizeof( ac_msg));
+      arb_mailboxRead( gt_benchObject.t_replyMbx,
+                       ac_msg,
+                       sizeof( ac_msg));
+   }
+
+}/*End arb_benchMbxRoundTrip*/
+
+static void arb_benchCreateLink( void *pv_arg,
+                                 uint16_t s_iterations)
+{
+   t_CONTHNDL t_contHndl = UTL_GET_CONT_HNDL( gt_benchObject.t_linkCont);
+   t_LINKHNDL t_linkHndl;
+
+   while( s_iterations--)
+   {
+      t_linkHndl = utl_createLink( sizeof( t_listLink) + 8);
+      if( t_linkHndl < 0)
+         return;
+
+      utl_insertLink( t_contHndl,
+                      t_linkHndl,
+                      true);
+      utl_destroyLink( t_contHndl,
+                       t_linkHndl);
+   }
+
+}/*End arb_benchCreateLink*/
+
+static void arb_benchBufferByte( void *pv_arg,
+                                 uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      utl_writeByte( &gt_benchObject.t_buf, (int8_t)s_iterations);
+      utl_readByte( &gt_benchObject.t_buf);
+   }
+
+}/*End arb_benchBufferByte*/
+
+static void arb_benchBufferBlock( void *pv_arg,
+                                  uint16_t s_iterations)
+{
+   int8_t ac_block[BENCH_BLOCK_SIZE];
+
+   memset( (void *)ac_block, 0, sizeof( ac_block));
+
+   while( s_iterations--)
+   {
+      utl_writeBlock( &gt_benchObject.t_buf,
+                      ac_block,
+                      sizeof( ac_block));
+      utl_readBlock( &gt_benchObject.t_buf,
+                     ac_block,
+                     sizeof( ac_block));
+   }
+
+}/*End arb_benchBufferBlock*/
+
+static void arb_benchRingByte( void *pv_arg,
+                               uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      utl_ringWriteByte( &gt_benchObject.t_ring, (int8_t)s_iterations);
+      utl_ringReadByte( &gt_benchObject.t_ring);
+   }
+
+}/*End arb_benchRingByte*/
+
+static void arb_benchRingBlock( void *pv_arg,
+                                uint16_t s_iterations)
+{
+   int8_t ac_block[BENCH_BLOCK_SIZE];
+
+   memset( (void *)ac_block, 0, sizeof( ac_block));
+
+   while( s_iterations--)
+   {
+      utl_ringWriteBlock( &gt_benchObject.t_ring,
+                          ac_block,
+                          sizeof( ac_block));
+      utl_ringReadBlock( &gt_benchObject.t_ring,
+                         ac_block,
+                         sizeof( ac_block));
+   }
+
+}/*End arb_benchRingBlock*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_error arb_benchInit( t_thrdPrio t_prio)
+{
+   t_mailboxConfig t_mbxConfig;
+   t_THRDHANDLE t_thread;
+
+   if( gt_benchObject.b_init == true)
+      return ARB_PASSED;
+
+   if( t_prio > (255 - ARB_BENCH_NUM_PARTNERS))
+      return ARB_INVALID_PRIORITY;
+
+   if( utl_benchInit() < 0)
+      return ARB_HAL_ERROR;
+
+   gt_benchObject.t_switchSem = arb_semaphoreCreate( COUNTING);
+   if( gt_benchObject.t_switchSem < 0)
+      return (t_error)gt_benchObject.t_switchSem;
+
+   gt_benchObject.t_pingSem = arb_semaphoreCreate( COUNTING);
+   if( gt_benchObject.t_pingSem < 0)
+      return (t_error)gt_benchObject.t_pingSem;
+
+   gt_benchObject.t_pongSem = arb_semaphoreCreate( COUNTING);
+   if( gt_benchObject.t_pongSem < 0)
+      return (t_error)gt_benchObject.t_pongSem;
+
+   gt_benchObject.t_localSem = arb_semaphoreCreate( COUNTING);
+   if( gt_benchObject.t_localSem < 0)
+      return (t_error)gt_benchObject.t_localSem;
+
+   t_mbxConfig.s_queueSize  = BENCH_MSG_BYTES;
+   t_mbxConfig.s_queueDepth = 1;
+   t_mbxConfig.t_writeMode  = BLOCKING;
+   t_mbxConfig.t_readMode   = BLOCKING;
+   t_mbxConfig.b_wrtFromInt = false;
+   t_mbxConfig.b_multRdWr   = false;
+
+   gt_benchObject.t_requestMbx = arb_mailboxCreate( t_mbxConfig);
+   if( gt_benchObject.t_requestMbx < 0)
+      return (t_error)gt_benchObject.t_requestMbx;
+
+   gt_benchObject.t_replyMbx = arb_mailboxCreate( t_mbxConfig);
+   if( gt_benchObject.t_replyMbx < 0)
+      return (t_error)gt_benchObject.t_replyMbx;
+
+   utl_initContainer( &gt_benchObject.t_linkCont);
+
+   utl_initBuffer( &gt_benchObject.t_buf,
+                   gt_benchObject.ac_bufStorage,
+                   sizeof( gt_benchObject.ac_bufStorage));
+
+   utl_ringInit( &gt_benchObject.t_ring,
+                 gt_benchObject.ac_ringStorage,
+                 sizeof( gt_benchObject.ac_ringStorage));
+
+   t_thread = arb_threadCreate( arb_benchSwitchThread,
+                                1,
+                                0,
+                                ARB_STACK_256B,
+                                t_prio);
+   if( t_thread < 0)
+      return (t_error)t_thread;
+
+   t_thread = arb_threadCreate( arb_benchPongThread,
+                                1,
+                                0,
+                                ARB_STACK_256B,
+                                t_prio + 1);
+   if( t_thread < 0)
+      return (t_error)t_thread;
+
+   t_thread = arb_threadCreate( arb_benchEchoThread,
+                                1,
+                                0,
+                                ARB_STACK_256B,
+                                t_prio + 2);
+   if( t_thread < 0)
+      return (t_error)t_thread;
+
+   gt_benchObject.t_lowestPrio = t_prio + ARB_BENCH_NUM_PARTNERS - 1;
+   gt_benchObject.b_init       = true;
+
+   return ARB_PASSED;
+
+}/*End arb_benchInit*/
+
+t_error arb_benchRun( t_DEVHANDLE t_outHndl)
+{
+   char ac_line[UTL_BENCH_LINE_BYTES];
+   t_benchResult t_result;
+   t_tcb *pt_caller;
+   int16_t s_size;
+   uint8_t c_index;
+
+   if( gt_benchObject.b_init == false)
+      return ARB_NULL_PTR;
+
+   /*------------------------------------------------------------------------*
+    * The suites rely on the partners preempting the caller as soon as they
+    * are woken.
+    *------------------------------------------------------------------------*/
+   pt_caller = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR_CONT_CURR(gt_activeThreads);
+   if( pt_caller->t_priority <= gt_benchObject.t_lowestPrio)
+      return ARB_INVALID_PRIORITY;
+
+   s_size = utl_benchFormatHeader( ac_line,
+                                   sizeof( ac_line));
+   if( s_size > 0)
+   {
+      arb_write( t_outHndl,
+                 (int8_t *)ac_line,
+                 (uint16_t)s_size);
+   }
+
+   for( c_index = 0; c_index < BENCH_NUM_SUITES; c_index++)
+   {
+      if( utl_benchRun( &gat_benchSuites[c_index],
+                        &t_result) < 0)
+      {
+         return ARB_HAL_ERROR;
+      }
+
+      s_size = utl_benchFormatResult( &gat_benchSuites[c_index],
+                                      &t_result,
+                                      ac_line,
+                                      sizeof( ac_line));
+      if( s_size > 0)
+      {
+         arb_write( t_outHndl,
+                    (int8_t *)ac_line,
+                    (uint16_t)s_size);
+      }
+
+   }/*End for( c_index = 0; c_index < BENCH_NUM_SUITES; c_index++)*/
+
+   return ARB_PASSED;
+
+}/*End arb_benchRun*/
@@ -14,13 +14,15 @@
  *          validated between the driver, console thread, and user-space 
  *          handler.
  * @image html consoleMsgFlow.jpg Example: Console message handling
- *        After waking, the thread validates the tokenized message by checking 
- *        the first entry against a list of basic kernel commands (<b>ls, cd, 
- *        help, dev, top, sdl, rm, sct, and head</b>). If the token doesn't 
- *        match, the entire message is routed to the user-space layer for 
- *        further evaluation. After processing the message the user-space 
- *        layer returns control back to #arb_console with an indicator letting
- *        the thread know if the message was handled properly.
+ *        After waking, the thread looks up the first token in a table of 
+ *        registered commands. The table is populated with the basic kernel 
+ *        commands (<b>ls, cd, help, dev, top, sdl, rm, sct, and head</b>) 
+ *        during initialization and extended by the user-space layer via 
+ *        #arb_consoleRegisterCmd. If the token matches, the command's handler
+ *        is called; otherwise, the entire message is routed to the optional 
+ *        user-space fallback handler passed to #arb_consoleInit. Handlers 
+ *        return an indicator letting the thread know if the message was 
+ *        handled properly.
  *
  * @paragpraph @ref <term> Standard Output (Terminal)
  * @image html cmdPrompt1.jpg Example: Using commands ls, cd, help, and dev
@@ -83,6 +85,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include "arb_error.h"
 #include "arb_thread.h"
 #include "arb_device.h"
@@ -92,6 +95,7 @@
 #include "arb_scheduler.h"
 #include "drv_console.h"
 #include "drv_sd.h"
+#include "hal_pmic.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
@@ -103,10 +107,58 @@
  *****************************************************************************/
 #define PRINTF_NUM_LINES_TO_PRINT (20)
 
+/*************************************************************************//**
+ * @brief Conversion for a string held in program memory. avr-libc reads one
+ *        with '%S', everywhere else that means a wide string.
+ *****************************************************************************/
+#ifdef __AVR__
+   #define CONSOLE_PGM_STR "S"
+#else
+   #define CONSOLE_PGM_STR "s"
+#endif
+
+/*************************************************************************//**
+ * @brief Number of entries in the command hash index. Must be a power of two
+ *        larger than #ARB_CONSOLE_MAX_CMDS so that the open-addressed probe
+ *        sequence always terminates on an empty slot.
+ *****************************************************************************/
+#define ARB_CONSOLE_HASH_SIZE (32)
+
+/*************************************************************************//**
+ * @brief Number of commands built into the kernel.
+ *****************************************************************************/
+#define ARB_CONSOLE_NUM_KERNEL_CMDS (sizeof( gat_kernelCmds) / \
+sizeof( t_consoleCmdEntry))
+
 /*---------------------------------------------------------------------------*
  * Private Typedefs
  *---------------------------------------------------------------------------*/
 
+/*************************************************************************//**
+ * @struct t_consoleCmdEntry
+ *
+ * @brief Single entry in the console command table. The name and help
+ *        strings are stored in program memory.
+ *****************************************************************************/
+typedef struct
+{
+   /**********************************************************************//**
+    * Command name as entered over the terminal (case insensitive).
+    **************************************************************************/
+   const char *pc_name;
+
+   /**********************************************************************//**
+    * Function called when the command is entered.
+    **************************************************************************/
+   t_consoleCmdHndlr pf_handler;
+
+   /**********************************************************************//**
+    * Description displayed by the <b>help</b> command.
+    **************************************************************************/
+   const char *pc_help;
+
+}t_consoleCmdEntry;
+
 /*************************************************************************//**
  * @struct t_consoleObject
  *
@@ -144,9 +196,23 @@ typedef struct
     * passes control to this function after determining that a command (entered
     * over the terminal) is not part of the Arbitros basic kernel command set.
     **************************************************************************/
-   bool (*pf_funPtr)( t_DEVHANDLE t_consoleHndl,
-                      int8_t *pc_buff,
-                      t_consoleTokHndl *pt_tokHndl);
+   t_consoleCmdHndlr pf_funPtr;
+
+   /**********************************************************************//**
+    * Table of registered commands, stored in the order they were registered.
+    **************************************************************************/
+   t_consoleCmdEntry at_cmds[ARB_CONSOLE_MAX_CMDS];
+
+   /**********************************************************************//**
+    * Open-addressed hash index into #at_cmds keyed on the command name. Each
+    * slot holds the table index plus one, zero marks an empty slot.
+    **************************************************************************/
+   uint8_t ac_cmdHash[ARB_CONSOLE_HASH_SIZE];
+
+   /**********************************************************************//**
+    * Number of commands in #at_cmds.
+    **************************************************************************/
+   volatile uint8_t c_numCmds;
 
 }t_consoleObject;
 
@@ -156,17 +222,91 @@ typedef struct
 static void arb_console( t_parameters t_param,
                          t_arguments  t_args);
 
-static bool arb_head( int8_t *pc_buff,
+static uint8_t arb_hashCmdName( const char *pc_name,
+                                bool b_progMem);
+
+static t_consoleCmdEntry *arb_findCmd( const char *pc_name);
+
+static const char *arb_completeCmd( const int8_t *pc_line,
+                                    uint8_t c_len);
+
+static bool arb_head( t_DEVHANDLE t_consoleHndl,
+                      int8_t *pc_buff,
                       t_consoleTokHndl *pt_tokHndl);
 
-static void arb_displayKernelHelp( int8_t *pc_buff);
+static bool arb_displayHelp( t_DEVHANDLE t_consoleHndl,
+                             int8_t *pc_buff,
+                             t_consoleTokHndl *pt_tokHndl);
+
+static bool arb_setDebugLevel( t_DEVHANDLE t_consoleHndl,
+                               int8_t *pc_buff,
+                               t_consoleTokHndl *pt_tokHndl);
+
+static bool arb_displayDeviceList( t_DEVHANDLE t_consoleHndl,
+                                   int8_t *pc_buff,
+                                   t_consoleTokHndl *pt_tokHndl);
+
+static bool arb_displaySystemStatistics( t_DEVHANDLE t_consoleHndl,
+                                         int8_t *pc_buff,
+                                         t_consoleTokHndl *pt_tokHndl);
+
+static bool arb_setCurrentTime( t_DEVHANDLE t_consoleHndl,
+                                int8_t *pc_buff,
+                                t_consoleTokHndl *pt_tokHndl);
 
-static void arb_setDebugLevel( t_consoleTokHndl *pt_tokHndl,
-                               int8_t *pc_buff);
+static bool arb_sdCommand( t_DEVHANDLE t_consoleHndl,
+                           int8_t *pc_buff,
+                           t_consoleTokHndl *pt_tokHndl);
 
-static void arb_displayDeviceList( int8_t *pc_buff);
+static bool arb_changeDir( t_DEVHANDLE t_consoleHndl,
+                           int8_t *pc_buff,
+                           t_consoleTokHndl *pt_tokHndl);
 
-static void arb_displaySystemStatistics( int8_t *pc_buff);
+/*---------------------------------------------------------------------------*
+ * Kernel command names and descriptions, stored in program memory.
+ *---------------------------------------------------------------------------*/
+static const char gac_sctName[]   PROGMEM = "sct";
+static const char gac_sctHelp[]   PROGMEM = "<hh> <mm> <ss> Set the current time.";
+static const char gac_helpName[]  PROGMEM = "help";
+static const char gac_helpHelp[]  PROGMEM = "Displays this list of commands.";
+static const char gac_sdlName[]   PROGMEM = "sdl";
+static const char gac_sdlHelp[]   PROGMEM = "<0|1|2> Set the debug level (low, med, high).";
+static const char gac_devName[]   PROGMEM = "dev";
+static const char gac_devHelp[]   PROGMEM = "Returns a list of active drivers.";
+static const char gac_topName[]   PROGMEM = "top";
+static const char gac_topHelp[]   PROGMEM = "Displays system statistics.";
+static const char gac_lsName[]    PROGMEM = "ls";
+static const char gac_lsHelp[]    PROGMEM = "Displays the contents of the current dir.";
+static const char gac_cdName[]    PROGMEM = "cd";
+static const char gac_cdHelp[]    PROGMEM = "<dir> Change to dir <dir>.";
+static const char gac_rmName[]    PROGMEM = "rm";
+static const char gac_rmHelp[]    PROGMEM = "<file|-r> Remove a file or the current dir.";
+static const char gac_rmdirName[] PROGMEM = "rmdir";
+static const char gac_rmdirHelp[] PROGMEM = "<dir> Remove a directory.";
+static const char gac_mkdirName[] PROGMEM = "mkdir";
+static const char gac_mkdirHelp[] PROGMEM = "<dir> Create a directory <dir>.";
+static const char gac_headName[]  PROGMEM = "head";
+static const char gac_headHelp[]  PROGMEM = "<file> Prints a file <file> to the terminal.";
+
+/*************************************************************************//**
+ * @var gat_kernelCmds
+ *
+ * @brief Table of kernel commands registered during #arb_consoleInit.
+ *****************************************************************************/
+static const t_consoleCmdEntry gat_kernelCmds[] PROGMEM =
+{
+   {gac_sctName,   arb_setCurrentTime,          gac_sctHelp},
+   {gac_helpName,  arb_displayHelp,             gac_helpHelp},
+   {gac_sdlName,   arb_setDebugLevel,           gac_sdlHelp},
+   {gac_devName,   arb_displayDeviceList,       gac_devHelp},
+   {gac_topName,   arb_displaySystemStatistics, gac_topHelp},
+   {gac_lsName,    arb_sdCommand,               gac_lsHelp},
+   {gac_cdName,    arb_changeDir,               gac_cdHelp},
+   {gac_rmName,    arb_sdCommand,               gac_rmHelp},
+   {gac_rmdirName, arb_sdCommand,               gac_rmdirHelp},
+   {gac_mkdirName, arb_sdCommand,               gac_mkdirHelp},
+   {gac_headName,  arb_head,                    gac_headHelp}
+};
 
 /*************************************************************************//**
  * @var gt_conObject
@@ -181,7 +321,120 @@ static t_consoleObject gt_conObject;
  *---------------------------------------------------------------------------*/
 
 /*************************************************************************//**
- * @fn static bool arb_head( int8_t *pc_buff,
+ * @fn static uint8_t arb_hashCmdName( const char *pc_name,
+ *                                     bool b_progMem)
+ *
+ * @brief Computes a case-insensitive hash of a command name.
+ *
+ * @param[in] pc_name The command name.
+ *
+ * @param[in] b_progMem If 'true', 'pc_name' points to program memory.
+ *
+ * @return Hash index in the range [0, #ARB_CONSOLE_HASH_SIZE).
+ *****************************************************************************/
+static uint8_t arb_hashCmdName( const char *pc_name,
+                                bool b_progMem)
+{
+   uint8_t c_hash = 0;
+   char c_char;
+
+   do
+   {
+      if( b_progMem == true)
+         c_char = (char)pgm_read_byte( pc_name);
+      else
+         c_char = *pc_name;
+
+      c_hash = (uint8_t)((c_hash << 3) + (c_hash >> 5)) ^
+      (uint8_t)tolower( (uint8_t)c_char);
+
+      pc_name++;
+
+   }while( c_char != '\0');
+
+   return c_hash & (ARB_CONSOLE_HASH_SIZE - 1);
+
+}/*End arb_hashCmdName*/
+
+/*************************************************************************//**
+ * @fn static t_consoleCmdEntry *arb_findCmd( const char *pc_name)
+ *
+ * @brief Looks up a command by name using the hash index.
+ *
+ * @param[in] pc_name The command name (RAM).
+ *
+ * @return Pointer to the command's table entry, NULL if not registered.
+ *****************************************************************************/
+static t_consoleCmdEntry *arb_findCmd( const char *pc_name)
+{
+   uint8_t c_slot = arb_hashCmdName( pc_name, false);
+   uint8_t c_index;
+   t_consoleCmdEntry *pt_cmd;
+
+   /*------------------------------------------------------------------------*
+    * Linear probe until the name is found or an empty slot is reached.
+    *------------------------------------------------------------------------*/
+   while( gt_conObject.ac_cmdHash[c_slot] != 0)
+   {
+      c_index = gt_conObject.ac_cmdHash[c_slot] - 1;
+      pt_cmd  = &gt_conObject.at_cmds[c_index];
+
+      if( strcasecmp_P( pc_name, pt_cmd->pc_name) == 0)
+         return pt_cmd;
+
+      c_slot = (c_slot + 1) & (ARB_CONSOLE_HASH_SIZE - 1);
+   }
+
+   return NULL;
+
+}/*End arb_findCmd*/
+
+/*************************************************************************//**
+ * @fn static const char *arb_completeCmd( const int8_t *pc_line,
+ *                                         uint8_t c_len)
+ *
+ * @brief Tab completion handler registered with the console driver.
+ *
+ * @details Called from the console RX interrupt when the tab key is pressed.
+ *          The partially entered command is compared against every
+ *          registered command name.
+ *
+ * @param[in] pc_line The command line entered so far (not NULL terminated).
+ *
+ * @param[in] c_len Number of characters in 'pc_line'.
+ *
+ * @return Program memory pointer to the matching command name if exactly
+ *         one command matches the prefix, otherwise NULL.
+ *****************************************************************************/
+static const char *arb_completeCmd( const int8_t *pc_line,
+                                    uint8_t c_len)
+{
+   const char *pc_match = NULL;
+   uint8_t c_index;
+
+   for( c_index = 0; c_index < gt_conObject.c_numCmds; c_index++)
+   {
+      if( strncasecmp_P( (const char *)pc_line,
+                         gt_conObject.at_cmds[c_index].pc_name,
+                         c_len) == 0)
+      {
+         /*------------------------------------------------------------------*
+          * More than one match, the prefix is ambiguous.
+          *------------------------------------------------------------------*/
+         if( pc_match != NULL)
+            return NULL;
+
+         pc_match = gt_conObject.at_cmds[c_index].pc_name;
+      }
+   }
+
+   return pc_match;
+
+}/*End arb_completeCmd*/
+
+/*************************************************************************//**
+ * @fn static bool arb_head( t_DEVHANDLE t_consoleHndl,
+ *                           int8_t *pc_buff,
  *                           t_consoleTokHndl *pt_tokHndl)
  *
  * @brief Reads the contents of a file and writes them to the command window.
@@ -193,6 +446,8 @@ static t_consoleObject gt_conObject;
  *          iteration, the user is asked if another #PRINTF_NUM_LINES_TO_PRINT
  *          lines should be displayed or if termination is required.
  *
+ * @param[in] t_consoleHndl Handle to the console driver.
+ *
  * @param[in] pc_buff Scratch buffer used for reading/writing messages between
  *            the command window and system console thread #arb_console.
  *
@@ -200,7 +455,8 @@ static t_consoleObject gt_conObject;
  *
  * @return 'true', if the file (<filename>) was opened, otherwise 'false'.
  *****************************************************************************/
-static bool arb_head( int8_t *pc_buff,
+static bool arb_head( t_DEVHANDLE t_consoleHndl,
+                      int8_t *pc_buff,
                       t_consoleTokHndl *pt_tokHndl)
 {
 
@@ -216,6 +472,9 @@ static bool arb_head( int8_t *pc_buff,
    int32_t i_fileSize;
    char *pc_newLinePos;
 
+   if( pt_tokHndl->c_numTokens != 2)
+      return false;
+
    ac_data[20] = '\0';
 
    pc_devName = arb_getDevName( gt_conObject.t_sdHndl);
@@ -284,8 +543,8 @@ static bool arb_head( int8_t *pc_buff,
                /*------------------------------------------------------------*
                 * Print all the characters up to and including the new line.
                 *------------------------------------------------------------*/
-               s_numBytesToNewLine = (int16_t)pc_newLinePos -
-               (int16_t)&ac_data[0];
+               s_numBytesToNewLine = (int16_t)(pc_newLinePos -
+               (char *)&ac_data[0]);
 
                if( s_numBytesToNewLine > 0)
                {
@@ -305,7 +564,7 @@ static bool arb_head( int8_t *pc_buff,
                 *------------------------------------------------------------*/
                arb_ioctl( gt_conObject.t_consoleHndl,
                           CONSOLE_PARSE_CMD_LINE,
-                          (uint32_t)((uint16_t)pt_tokHndl));
+                          (uint32_t)((uintptr_t)pt_tokHndl));
 
                /*------------------------------------------------------------*
                 * Quit reading the file?
@@ -362,88 +621,73 @@ static bool arb_head( int8_t *pc_buff,
 }/*End arb_head*/
 
 /*************************************************************************//**
- * @fn static void arb_displayKernelHelp( int8_t *pc_buff)
+ * @fn static bool arb_displayHelp( t_DEVHANDLE t_consoleHndl,
+ *                                  int8_t *pc_buff,
+ *                                  t_consoleTokHndl *pt_tokHndl)
  *
- * @brief Displays a list of kernel commands to the terminal window.
+ * @brief Displays a list of registered commands to the terminal window.
  *
  * @details After the thread #arb_console receives the <b>help</b> command via
  *          the terminal window it calls this function in order to display a
- *          list of all possible kernel commands.
+ *          list of all the kernel and user-space commands, generated from the
+ *          command table.
+ *
+ * @param[in] t_consoleHndl Handle to the console driver.
  *
- * @param[in] pc_buff scratch buffer used for writing the kernel commands and
+ * @param[in] pc_buff scratch buffer used for writing the commands and
  *            their description to the terminal window.
  *
- * @return None.
+ * @param[in] pt_tokHndl pointer to the current list of command line tokens.
+ *
+ * @return 'true', if the command was entered without arguments.
  *****************************************************************************/
-static void arb_displayKernelHelp( int8_t *pc_buff)
+static bool arb_displayHelp( t_DEVHANDLE t_consoleHndl,
+                             int8_t *pc_buff,
+                             t_consoleTokHndl *pt_tokHndl)
 {
    uint16_t s_size;
+   uint8_t c_index;
+
+   if( pt_tokHndl->c_numTokens != 1)
+      return false;
 
    s_size = sprintf_P( (char *)pc_buff, PSTR(".------------------------------------------------------------------------.\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
+   arb_write( t_consoleHndl,
               pc_buff,
               s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| Command |     Arguments     |              Description                 |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
+   s_size = sprintf_P( (char *)pc_buff, PSTR("| Command |                        Description                           |\n\r"));
+   arb_write( t_consoleHndl,
               pc_buff,
               s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("|---------|-------------------|------------------------------------------|\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| sdl     | <arg1>            | Set the debug level, where <arg1> =      |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("|         |                   | 0,1,2 (low, med, high)                   |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
+   s_size = sprintf_P( (char *)pc_buff, PSTR("|---------|--------------------------------------------------------------|\n\r"));
+   arb_write( t_consoleHndl,
               pc_buff,
               s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| dev     |                   | Returns a list of active drivers.        |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| top     |                   | Displays system statistics.              |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| ls      | <arg1>            | Displays the contents of dir <arg1>.     |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| cd      | <arg1>            | Change to dir <arg1>.                    |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| rm      | <arg1>            | Remove a file <arg1>.                    |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| rmdir   | <arg1>            | Remove a directory.                      |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| mkdir   | <arg1>            | Create a directory <arg1>.               |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| touch   | <arg1>            | Create file <arg1>.                      |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("| head    | <arg1>            | Prints a file <arg1> to the terminal.    |\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
-              pc_buff,
-              s_size);
-   s_size = sprintf_P( (char *)pc_buff, PSTR("'---------'-------------------'------------------------------------------'\n\r"));
-   arb_write( gt_conObject.t_consoleHndl,
+
+   for( c_index = 0; c_index < gt_conObject.c_numCmds; c_index++)
+   {
+      s_size = sprintf_P( (char *)pc_buff,
+                          PSTR("| %-7" CONSOLE_PGM_STR " | %-60" CONSOLE_PGM_STR " |\n\r"),
+                          gt_conObject.at_cmds[c_index].pc_name,
+                          gt_conObject.at_cmds[c_index].pc_help);
+      arb_write( t_consoleHndl,
+                 pc_buff,
+                 s_size);
+   }
+
+   s_size = sprintf_P( (char *)pc_buff, PSTR("'---------'--------------------------------------------------------------'\n\r"));
+   arb_write( t_consoleHndl,
               pc_buff,
               s_size);
-}/*End arb_displayKernelHelp*/
+
+   return true;
+
+}/*End arb_displayHelp*/
 
 /*************************************************************************//**
- * @fn static void arb_setDebugLevel( t_consoleTokHndl *pt_tokHndl,
- *                                    int8_t *pc_buff)
+ * @fn static bool arb_setDebugLevel( t_DEVHANDLE t_consoleHndl,
+ *                                    int8_t *pc_buff,
+ *                                    t_consoleTokHndl *pt_tokHndl)
  *
  * @brief Puts the system into debug mode where #arb_printf information is
  *        written to the terminal.
@@ -459,20 +703,26 @@ static void arb_displayKernelHelp( int8_t *pc_buff)
  *          return to nominal console operation.
  * @see term for further information
  *
+ * @param[in] t_consoleHndl Handle to the console driver.
+ *
  * @param[in] pc_buff Scratch buffer used for writing messages to the terminal.
  *
  * @param[in] pt_tokHndl pointer to the tokenized list of terminal commands and
  *            arguments.
  *
- * @return None.
+ * @return 'false', if the number of arguments is invalid.
  *****************************************************************************/
-static void arb_setDebugLevel( t_consoleTokHndl *pt_tokHndl,
-                               int8_t *pc_buff)
+static bool arb_setDebugLevel( t_DEVHANDLE t_consoleHndl,
+                               int8_t *pc_buff,
+                               t_consoleTokHndl *pt_tokHndl)
 {
    uint8_t c_dbg = PRINTF_DBG_OFF;
    t_consoleError t_conError;
    uint16_t s_size;
 
+   if( pt_tokHndl->c_numTokens != 2)
+      return false;
+
    if( pt_tokHndl->ac_tok[1][0] == '0')
       c_dbg = PRINTF_DBG_LOW;
    else if( pt_tokHndl->ac_tok[1][0] == '1')
@@ -499,7 +749,7 @@ static void arb_setDebugLevel( t_consoleTokHndl *pt_tokHndl,
        *---------------------------------------------------------------*/
       t_conError = arb_ioctl( gt_conObject.t_consoleHndl,
                               CONSOLE_PARSE_CMD_LINE,
-                              (uint32_t)((uint16_t)pt_tokHndl));
+                              (uint32_t)((uintptr_t)pt_tokHndl));
 
       /*---------------------------------------------------------------*
        * Enable debug...
@@ -511,7 +761,7 @@ static void arb_setDebugLevel( t_consoleTokHndl *pt_tokHndl,
        *---------------------------------------------------------------*/
       t_conError = arb_ioctl( gt_conObject.t_consoleHndl,
                               CONSOLE_PARSE_CMD_LINE,
-                              (uint32_t)((uint16_t)pt_tokHndl));
+                              (uint32_t)((uintptr_t)pt_tokHndl));
 
       /*---------------------------------------------------------------*
        * Disable debug...
@@ -519,20 +769,28 @@ static void arb_setDebugLevel( t_consoleTokHndl *pt_tokHndl,
       arb_setPrintfDbgLevel( PRINTF_DBG_OFF);
    }/*End if( c_dbg <= PRINTF_DBG_HIGH)*/
 
+   return true;
+
 }/*End arb_setDebugLevel*/
 
 /*************************************************************************//**
- * @fn static void arb_displayDeviceList( int8_t *pc_buff)
+ * @fn static bool arb_displayDeviceList( t_DEVHANDLE t_consoleHndl,
+ *                                        int8_t *pc_buff,
+ *                                        t_consoleTokHndl *pt_tokHndl)
  *
- * @brief 
+ * @brief Displays the device drivers registered with the kernel.
  *
- * @details 
+ * @param[in] t_consoleHndl Handle to the console driver.
  *
  * @param[in] pc_buff Scratch buffer used for writing messages to the terminal.
  *
- * @return None.
+ * @param[in] pt_tokHndl pointer to the current list of command line tokens.
+ *
+ * @return 'true', if the command was entered without arguments.
  *****************************************************************************/
-static void arb_displayDeviceList( int8_t *pc_buff)
+static bool arb_displayDeviceList( t_DEVHANDLE t_consoleHndl,
+                                   int8_t *pc_buff,
+                                   t_consoleTokHndl *pt_tokHndl)
 {
    t_CONTHNDL t_deviceList = arb_getDeviceList();
    t_LINKHNDL t_curr;
@@ -540,6 +798,9 @@ static void arb_displayDeviceList( int8_t *pc_buff)
    uint16_t s_count;
    uint16_t s_size;
 
+   if( pt_tokHndl->c_numTokens != 1)
+      return false;
+
    s_size = sprintf_P( (char *)pc_buff, PSTR(".-------------------------------------------------------------.\n\r"));
    arb_write( gt_conObject.t_consoleHndl,
               pc_buff,
@@ -572,11 +833,20 @@ static void arb_displayDeviceList( int8_t *pc_buff)
               pc_buff,
               s_size);
 
+   return true;
+
 }/*End arb_displayDeviceList*/
 
-static void arb_displaySystemStatistics( int8_t *pc_buff)
+static bool arb_displaySystemStatistics( t_DEVHANDLE t_consoleHndl,
+                                         int8_t *pc_buff,
+                                         t_consoleTokHndl *pt_tokHndl)
 {
    uint16_t s_size;
+#ifdef __AVR__
+   /*------------------------------------------------------------------------*
+    * The memory map comes from the avr-libc linker symbols, a host build
+    * only reports the load estimates.
+    *------------------------------------------------------------------------*/
    extern char *__data_start;
    extern char *__data_end;
    extern char *__bss_end;
@@ -588,7 +858,12 @@ static void arb_displaySystemStatistics( int8_t *pc_buff)
    int32_t i_freeSize;
    int32_t i_ramUsed;
    int32_t i_percUsed;
+#endif
 
+   if( pt_tokHndl->c_numTokens != 1)
+      return false;
+
+#ifdef __AVR__
    i_dataSize = (int32_t)(uint16_t)&__data_end - (int32_t)(uint16_t)&__data_start;
    i_bssSize  = (int32_t)(uint16_t)&__bss_end - (int32_t)(uint16_t)&__data_end;
    i_heapSize = (int32_t)(uint16_t)__brkval - (int32_t)(uint16_t)&__bss_end;
@@ -645,6 +920,9 @@ static void arb_displaySystemStatistics( int8_t *pc_buff)
               pc_buff,
               s_size);
    s_size = sprintf_P( (char *)pc_buff, PSTR("'---------'---------------'---------------'\n\r"));
+#else
+   s_size = sprintf_P( (char *)pc_buff, PSTR(".-------------------------.---------------.\n\r"));
+#endif
    arb_write( gt_conObject.t_consoleHndl,
               pc_buff,
               s_size);
@@ -665,8 +943,177 @@ static void arb_displaySystemStatistics( int8_t *pc_buff)
               pc_buff,
               s_size);
 
+   return true;
+
 }/*End arb_displaySystemStatistics*/
 
+/*************************************************************************//**
+ * @fn static bool arb_setCurrentTime( t_DEVHANDLE t_consoleHndl,
+ *                                     int8_t *pc_buff,
+ *                                     t_consoleTokHndl *pt_tokHndl)
+ *
+ * @brief Sets the system time from the command <b>sct <hh> <mm> <ss></b>.
+ *
+ * @param[in] t_consoleHndl Handle to the console driver.
+ *
+ * @param[in] pc_buff Scratch buffer used for writing messages to the terminal.
+ *
+ * @param[in] pt_tokHndl pointer to the current list of command line tokens.
+ *
+ * @return 'false', if the number of arguments is invalid.
+ *****************************************************************************/
+static bool arb_setCurrentTime( t_DEVHANDLE t_consoleHndl,
+                                int8_t *pc_buff,
+                                t_consoleTokHndl *pt_tokHndl)
+{
+   uint8_t c_hours;
+   uint8_t c_min;
+   uint8_t c_sec;
+
+   if( pt_tokHndl->c_numTokens != 4)
+      return false;
+
+   c_hours = (uint8_t)atoi( (const char *)pt_tokHndl->ac_tok[1]);
+   c_min = (uint8_t)atoi( (const char *)pt_tokHndl->ac_tok[2]);
+   c_sec = (uint8_t)atoi( (const char *)pt_tokHndl->ac_tok[3]);
+
+   arb_setSysTime( c_hours,
+                   c_min,
+                   c_sec);
+
+   return true;
+
+}/*End arb_setCurrentTime*/
+
+/*************************************************************************//**
+ * @fn static bool arb_sdCommand( t_DEVHANDLE t_consoleHndl,
+ *                                int8_t *pc_buff,
+ *                                t_consoleTokHndl *pt_tokHndl)
+ *
+ * @brief Handles the file system commands <b>ls, rm, rmdir, and mkdir</b>.
+ *
+ * @param[in] t_consoleHndl Handle to the console driver.
+ *
+ * @param[in] pc_buff Scratch buffer used for writing messages to the terminal.
+ *
+ * @param[in] pt_tokHndl pointer to the current list of command line tokens.
+ *
+ * @return 'false', if the number of arguments is invalid.
+ *****************************************************************************/
+static bool arb_sdCommand( t_DEVHANDLE t_consoleHndl,
+                           int8_t *pc_buff,
+                           t_consoleTokHndl *pt_tokHndl)
+{
+   char *pc_cmd = (char *)pt_tokHndl->ac_tok[0];
+   int32_t i_arg = (int32_t)((uintptr_t)&pt_tokHndl->ac_tok[1]);
+
+   if( strcasecmp_P( pc_cmd, gac_lsName) == 0)
+   {
+      if( pt_tokHndl->c_numTokens != 1)
+         return false;
+
+      arb_ioctl( gt_conObject.t_sdHndl,
+                 SD_LS,
+                 0);
+   }
+   else if( pt_tokHndl->c_numTokens != 2)
+   {
+      return false;
+   }
+   else if( strcasecmp_P( pc_cmd, gac_rmName) == 0)
+   {
+      if( strcasecmp_P( (char *)pt_tokHndl->ac_tok[1], PSTR("-r")) == 0)
+      {
+         /*------------------------------------------------------------------*
+          * Remove all the files within, and the current working directory
+          * itself.
+          *------------------------------------------------------------------*/
+         arb_ioctl( gt_conObject.t_sdHndl,
+                    SD_RMDASHR,
+                    0);
+      }/*End if( strcasecmp_P( (char *)pt_tokHndl->ac_tok[1], PSTR("-r")) == 0)*/
+      else
+      {
+         /*------------------------------------------------------------------*
+          * Remove the file specified by 'pt_tokHndl->ac_tok[1]'.
+          *------------------------------------------------------------------*/
+         arb_ioctl( gt_conObject.t_sdHndl,
+                    SD_RM,
+                    i_arg);
+      }
+   }
+   else if( strcasecmp_P( pc_cmd, gac_rmdirName) == 0)
+   {
+      arb_ioctl( gt_conObject.t_sdHndl,
+                 SD_RMDIR,
+                 i_arg);
+   }
+   else /*mkdir*/
+   {
+      arb_ioctl( gt_conObject.t_sdHndl,
+                 SD_MKDIR,
+                 i_arg);
+   }
+
+   return true;
+
+}/*End arb_sdCommand*/
+
+/*************************************************************************//**
+ * @fn static bool arb_changeDir( t_DEVHANDLE t_consoleHndl,
+ *                                int8_t *pc_buff,
+ *                                t_consoleTokHndl *pt_tokHndl)
+ *
+ * @brief Changes the working directory and updates the prompt.
+ *
+ * @param[in] t_consoleHndl Handle to the console driver.
+ *
+ * @param[in] pc_buff Scratch buffer used for writing messages to the terminal.
+ *
+ * @param[in] pt_tokHndl pointer to the current list of command line tokens.
+ *
+ * @return 'false', if the number of arguments is invalid.
+ *****************************************************************************/
+static bool arb_changeDir( t_DEVHANDLE t_consoleHndl,
+                           int8_t *pc_buff,
+                           t_consoleTokHndl *pt_tokHndl)
+{
+   t_sdError t_err;
+
+   if( pt_tokHndl->c_numTokens != 2)
+      return false;
+
+   t_err = (t_sdError)arb_ioctl( gt_conObject.t_sdHndl,
+                                 SD_CD,
+                                 (int32_t)((uintptr_t)&pt_tokHndl->ac_tok[1]));
+
+   /*------------------------------------------------------------------------*
+    * If directory change accepted, update the prompt.
+    *------------------------------------------------------------------------*/
+   if( t_err == SD_PASSED)
+   {
+      arb_ioctl( t_consoleHndl,
+                 CONSOLE_SET_PROMPT,
+                 (int32_t)((uintptr_t)&pt_tokHndl->ac_tok[1]));
+
+      if( strcasecmp_P( (char *)pt_tokHndl->ac_tok[1], PSTR("/")) == 0)
+      {
+         arb_ioctl( t_consoleHndl,
+                    CONSOLE_SET_PROMPT_COLOR,
+                    CONSOLE_GREEN);
+      }
+      else
+      {
+         arb_ioctl( t_consoleHndl,
+                    CONSOLE_SET_PROMPT_COLOR,
+                    CONSOLE_RED);
+      }
+   }/*End if( t_err == SD_PASSED)*/
+
+   return true;
+
+}/*End arb_changeDir*/
+
 /*************************************************************************//**
  * @fn static void arb_console( t_parameters t_param,
  *                              t_arguments t_args)
@@ -679,13 +1126,13 @@ static void arb_displaySystemStatistics( int8_t *pc_buff)
  *          --and Arbitros kernel or user-space application. The thread blocks
  *          until detecting a carriage return, from which it wakes and reads
  *          the contents of the device driver's (drv_console.c) buffer. The
- *          new message is checked against a set of 'Linux like' Arbitros
- *          kernel commands such as; <b>sct, help, sdl, dev, top, ls, rm, cd,
- *          and head</b>. If the message is recognized as a kernel command it
- *          is subsequently processed; otherwise, control of the console is 
- *          passed onto the user-space application via a function pointer 
- *          passed in as a parameter to #arb_consoleInit during system 
- *          initialization.
+ *          first token is looked up in the hashed table of registered 
+ *          commands, which contains the 'Linux like' Arbitros kernel commands
+ *          (<b>sct, help, sdl, dev, top, ls, rm, cd, and head</b>) and any 
+ *          commands registered by user-space via #arb_consoleRegisterCmd. If 
+ *          the command is found its handler is called; otherwise, control of 
+ *          the console is passed onto the optional user-space fallback 
+ *          handler passed in as a parameter to #arb_consoleInit.
  *
  * @param[in] t_param User-definable parameter passed in at time of thread
  *            initialization.
@@ -718,6 +1165,8 @@ static void arb_console( t_parameters t_param,
     *------------------------------------------------------------------------*/
    t_consoleTokHndl t_tokHndl;
    t_consoleError t_conError;
+   t_consoleCmdEntry *pt_cmd;
+   bool b_handled;
 
    t_conError = arb_ioctl( gt_conObject.t_consoleHndl,
                            CONSOLE_RESET_TERMINAL,
@@ -758,7 +1207,7 @@ static void arb_console( t_parameters t_param,
        *---------------------------------------------------------------------*/
       t_conError = arb_ioctl( gt_conObject.t_consoleHndl,
                               CONSOLE_PARSE_CMD_LINE,
-                              (uint32_t)((uint16_t)&t_tokHndl));
+                              (uint32_t)((uintptr_t)&t_tokHndl));
 
       if( t_conError == CONSOLE_TOKEN_TOO_LARGE)
       {
@@ -774,159 +1223,37 @@ static void arb_console( t_parameters t_param,
                     ac_buff, 
                     s_size);
       }/*End else if( t_conError == CONSOLE_TOO_MANY_TOKENS)*/
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("sct")) == 0)
-      && (t_tokHndl.c_numTokens == 4)) /*Set current time*/
+      else if( t_tokHndl.c_numTokens > 0)
       {
-         uint8_t c_hours;
-         uint8_t c_min;
-         uint8_t c_sec;
-
-         c_hours = (uint8_t)atoi( (const char *)t_tokHndl.ac_tok[1]);
-         c_min = (uint8_t)atoi( (const char *)t_tokHndl.ac_tok[2]);
-         c_sec = (uint8_t)atoi( (const char *)t_tokHndl.ac_tok[3]);
-
-         arb_setSysTime( c_hours,
-                         c_min,
-                         c_sec);
-      }/*End else if( strcasecmp( (char *)t_tokHndl.ac_tok[0], "sct") == 0)*/
-      else if( strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("help")) == 0)
-      {
-         /*------------------------------------------------------------------*
-          * Display a list of all the possible RTOS specific commands.
-          *------------------------------------------------------------------*/
-         arb_displayKernelHelp( ac_buff);
-      }/*End else if( strcasecmp( (char *)t_tokHndl.ac_tok[0], "help") == 0)*/
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("sdl")) == 0)
-      && (t_tokHndl.c_numTokens == 2)) /*Set the debug level*/
-      {
-         /*------------------------------------------------------------------*
-          * Turn on/off a given level of system debug.
-          *------------------------------------------------------------------*/
-         arb_setDebugLevel( &t_tokHndl,
-                            ac_buff);
-      }
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("dev")) == 0)
-      && (t_tokHndl.c_numTokens == 1))
-      {
-         /*------------------------------------------------------------------*
-          * Display a list of all the device drivers registered with the
-          * kernel.
-          *------------------------------------------------------------------*/
-         arb_displayDeviceList( ac_buff);
-      }
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("top")) == 0)
-      && (t_tokHndl.c_numTokens == 1))
-      {
-         /*------------------------------------------------------------------*
-          * Display the memory footprint of the system.
-          *------------------------------------------------------------------*/
-         arb_displaySystemStatistics( ac_buff);
-      }
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("ls")) == 0)
-      && (t_tokHndl.c_numTokens == 1))
-      {
-         arb_ioctl( gt_conObject.t_sdHndl,
-                    SD_LS,
-                    0);
-      }
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("rm")) == 0)
-      && (t_tokHndl.c_numTokens == 2))
-      {
-         if( strcasecmp_P( (char *)t_tokHndl.ac_tok[1], PSTR("-r")) == 0)
+         b_handled = false;
+
+         pt_cmd = arb_findCmd( (char *)t_tokHndl.ac_tok[0]);
+         if( pt_cmd != NULL)
          {
-            /*---------------------------------------------------------------*
-             * Remove all the files within, and the current working directory
-             * itself.
-             *---------------------------------------------------------------*/
-            arb_ioctl( gt_conObject.t_sdHndl,
-                       SD_RMDASHR,
-                       0);
-         }/*End if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[1], PSTR("-r")) == 0)*/
-         else
+            b_handled = pt_cmd->pf_handler( gt_conObject.t_consoleHndl,
+                                            ac_buff,
+                                            &t_tokHndl);
+         }/*End if( pt_cmd != NULL)*/
+         else if( gt_conObject.pf_funPtr != NULL)
          {
             /*---------------------------------------------------------------*
-             * Remove the file specified by 't_tokHndl.ac_tok[1]'.
+             * Pass control over to the user-space fallback handler for
+             * commands that haven't been registered.
              *---------------------------------------------------------------*/
-            arb_ioctl( gt_conObject.t_sdHndl,
-                       SD_RM,
-                       (int32_t)((uint16_t)&t_tokHndl.ac_tok[1]));
+            b_handled = gt_conObject.pf_funPtr( gt_conObject.t_consoleHndl,
+                                                ac_buff,
+                                                &t_tokHndl);
          }
 
-      }
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("rmdir")) == 0)
-      && (t_tokHndl.c_numTokens == 2))
-      {
-         arb_ioctl( gt_conObject.t_sdHndl,
-                    SD_RMDIR,
-                    (int32_t)((uint16_t)&t_tokHndl.ac_tok[1]));
-      }
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("mkdir")) == 0)
-      && (t_tokHndl.c_numTokens == 2))
-      {
-         arb_ioctl( gt_conObject.t_sdHndl,
-                    SD_MKDIR,
-                    (int32_t)((uint16_t)&t_tokHndl.ac_tok[1]));
-      }
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("cd")) == 0)
-      && (t_tokHndl.c_numTokens == 2))
-      {
-         t_sdError t_err;
-
-         t_err = (t_sdError)arb_ioctl( gt_conObject.t_sdHndl,
-                                       SD_CD,
-                                       (int32_t)((uint16_t)&t_tokHndl.ac_tok[1]));
-
-         /*------------------------------------------------------------------*
-          * If directory change accepted, update the prompt.
-          *------------------------------------------------------------------*/
-         if( t_err == SD_PASSED)
+         if( b_handled == false)
          {
-            arb_ioctl( gt_conObject.t_consoleHndl,
-                       CONSOLE_SET_PROMPT,
-                       (int32_t)((uint16_t)&t_tokHndl.ac_tok[1]));
+            s_size = sprintf_P( (char *)ac_buff, PSTR("Invalid CMD\n\r"));
+            arb_write( gt_conObject.t_consoleHndl,
+                       ac_buff,
+                       s_size);
+         }
 
-            if( strcasecmp_P( (char *)t_tokHndl.ac_tok[1], PSTR("/")) == 0)
-            {
-               arb_ioctl( gt_conObject.t_consoleHndl,
-                          CONSOLE_SET_PROMPT_COLOR,
-                          CONSOLE_GREEN);
-            }
-            else
-            {
-               arb_ioctl( gt_conObject.t_consoleHndl,
-                          CONSOLE_SET_PROMPT_COLOR,
-                          CONSOLE_RED);
-            }
-         }/*End if( t_err == SD_PASSED)*/
-      }
-      else if( (strcasecmp_P( (char *)t_tokHndl.ac_tok[0], PSTR("head")) == 0)
-      && (t_tokHndl.c_numTokens == 2))
-      {
-         arb_head( ac_buff,
-                   &t_tokHndl);
-      }
-      else /*Pass control over to a user-space application...*/
-      {
-         /*------------------------------------------------------------------*
-          * The function pointed to by 'pf_funPtr' is an extension of
-          * 'arb_console' that is modifiable from a user-space perspective.
-          * If the user-space application requires control over its various
-          * threads via a CMD line interface then all subsequent commands
-          * should be placed within the function pointed to by 'pf_funPtr'.
-          *------------------------------------------------------------------*/
-         if( gt_conObject.pf_funPtr != NULL)
-         {
-            if( gt_conObject.pf_funPtr( gt_conObject.t_consoleHndl,
-                                        ac_buff,
-                                        &t_tokHndl) == false)
-            {
-               s_size = sprintf_P( (char *)ac_buff, PSTR("Invalid CMD\n\r"));
-               arb_write( gt_conObject.t_consoleHndl,
-                          ac_buff,
-                          s_size);
-            }
-         }/*End if( gt_conObject.pf_funPtr != NULL)*/
-      }
+      }/*End else if( t_tokHndl.c_numTokens > 0)*/
 
       /*---------------------------------------------------------------------*
        * Display prompt...
@@ -939,6 +1266,77 @@ static void arb_console( t_parameters t_param,
 
 }/*End arb_console*/
 
+/*************************************************************************//**
+ * @fn t_error arb_consoleRegisterCmd( const char *pc_name,
+ *                                     t_consoleCmdHndlr pf_handler,
+ *                                     const char *pc_help)
+ *
+ * @brief Adds a command to the console command table.
+ *
+ * @details Once registered, entering <b>pc_name</b> over the terminal calls
+ *          <b>pf_handler</b>, the command is listed by <b>help</b>, and it
+ *          can be completed with the tab key. Both strings must be stored in
+ *          program memory (e.g. PSTR("cmd")) and remain valid for the life of
+ *          the system.
+ *
+ * @param[in] pc_name Command name (program memory), shorter than
+ *            #CONSOLE_MAX_TOKEN_SIZE.
+ *
+ * @param[in] pf_handler Function called when the command is entered.
+ *
+ * @param[in] pc_help One-line description (program memory).
+ *
+ * @return ARB_PASSED, ARB_NULL_PTR, ARB_NAME_ERROR if the name is too long,
+ *         ARB_INVALID_ARG if the name is already registered, or
+ *         ARB_TABLE_FULL if all #ARB_CONSOLE_MAX_CMDS entries are taken.
+ *****************************************************************************/
+t_error arb_consoleRegisterCmd( const char *pc_name,
+                                t_consoleCmdHndlr pf_handler,
+                                const char *pc_help)
+{
+   char ac_name[CONSOLE_MAX_TOKEN_SIZE];
+   uint8_t c_slot;
+   uint8_t c_index;
+
+   if( (pc_name == NULL) || (pf_handler == NULL) || (pc_help == NULL))
+      return ARB_NULL_PTR;
+
+   if( strlen_P( pc_name) >= CONSOLE_MAX_TOKEN_SIZE)
+      return ARB_NAME_ERROR;
+
+   strcpy_P( ac_name, pc_name);
+
+   if( arb_findCmd( ac_name) != NULL)
+      return ARB_INVALID_ARG;
+
+   if( gt_conObject.c_numCmds == ARB_CONSOLE_MAX_CMDS)
+      return ARB_TABLE_FULL;
+
+   c_slot = arb_hashCmdName( ac_name, false);
+   while( gt_conObject.ac_cmdHash[c_slot] != 0)
+   {
+      c_slot = (c_slot + 1) & (ARB_CONSOLE_HASH_SIZE - 1);
+   }
+
+   /*------------------------------------------------------------------------*
+    * The table is read by the tab completion handler from within the console
+    * RX interrupt.
+    *------------------------------------------------------------------------*/
+   HAL_BEGIN_CRITICAL();
+
+   c_index = gt_conObject.c_numCmds;
+   gt_conObject.at_cmds[c_index].pc_name    = pc_name;
+   gt_conObject.at_cmds[c_index].pf_handler = pf_handler;
+   gt_conObject.at_cmds[c_index].pc_help    = pc_help;
+   gt_conObject.ac_cmdHash[c_slot] = c_index + 1;
+   gt_conObject.c_numCmds++;
+
+   HAL_END_CRITICAL();
+
+   return ARB_PASSED;
+
+}/*End arb_consoleRegisterCmd*/
+
 /*************************************************************************//**
  * @fn arb_consoleInit
  *
@@ -947,10 +1345,10 @@ t_error arb_consoleInit( char *pc_consDriver,
                          char *pc_sdDriver,
                          t_stackSize t_stack,
                          t_thrdPrio t_pri,
-                         bool (*pf_funPtr)( t_DEVHANDLE t_consoleHndl,
-                                            int8_t *pc_buff,
-                                            t_consoleTokHndl *pt_tokHndl))
+                         t_consoleCmdHndlr pf_funPtr)
 {
+   t_consoleCmdEntry t_entry;
+   uint8_t c_index;
 
    /*------------------------------------------------------------------------*
     * Create a new thread.
@@ -981,6 +1379,24 @@ t_error arb_consoleInit( char *pc_consDriver,
 
    gt_conObject.pf_funPtr = pf_funPtr;
 
+   /*------------------------------------------------------------------------*
+    * Populate the command table with the kernel commands.
+    *------------------------------------------------------------------------*/
+   for( c_index = 0; c_index < ARB_CONSOLE_NUM_KERNEL_CMDS; c_index++)
+   {
+      memcpy_P( &t_entry,
+                &gat_kernelCmds[c_index],
+                sizeof( t_consoleCmdEntry));
+
+      arb_consoleRegisterCmd( t_entry.pc_name,
+                              t_entry.pf_handler,
+                              t_entry.pc_help);
+   }
+
+   arb_ioctl( gt_conObject.t_consoleHndl,
+              CONSOLE_SET_TAB_HANDLER,
+              (int32_t)((uintptr_t)&arb_completeCmd));
+
    /*------------------------------------------------------------------------*
     * Open a handle to the sd card driver.
     *------------------------------------------------------------------------*/
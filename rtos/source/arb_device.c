@@ -30,7 +30,7 @@
  *---------------------------------------------------------------------------*/
 #include <string.h>
 #include "arb_device.h"
-#include "utl_linkedList.h"
+#include "utl_linkedlist.h"
 #include "hal_pmic.h"
 
 /*---------------------------------------------------------------------------*
@@ -94,7 +94,7 @@ static void arb_initDevice( t_device **pt_newDevice,
    /*------------------------------------------------------------------------*
     * Initialize this new memory region to 0
     *------------------------------------------------------------------------*/
-   memset( (*pt_newDevice), 0, sizeof( t_device));
+   UTL_CLEAR_LINK_ELEMENT( (*pt_newDevice), t_device);
 
    (*pt_newDevice)->t_devId = t_devId;
 
@@ -114,7 +114,7 @@ static void arb_initDeviceHandle( t_devHandle **pt_new,
    /*------------------------------------------------------------------------*
     * Initialize this new memory region to 0
     *------------------------------------------------------------------------*/
-   memset( (*pt_new), 0, sizeof( t_devHandle));
+   UTL_CLEAR_LINK_ELEMENT( (*pt_new), t_devHandle);
 
    /*------------------------------------------------------------------------*
     * Increment the count of handles opened against this particular device
@@ -232,7 +232,9 @@ t_DEVHANDLE arb_open( char *pc_name,
     *------------------------------------------------------------------------*/
    pc_fileName = strtok( NULL, "/");
 
-   s_size2 = strlen( pc_fileName);
+   s_size2 = 0;
+   if( pc_fileName != NULL)
+      s_size2 = strlen( pc_fileName);
 
    /*------------------------------------------------------------------------*
     * Are there characters left after the second token?
@@ -0,0 +1,366 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : arb_dispatcher.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file contains the dispatcher thread which runs the
+ *               state machines of the registered active objects as events
+ *               are posted to them.
+ *
+ * References  : 1) http://en.wikipedia.org/wiki/Active_object
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "arb_thread.h"
+#include "arb_semaphore.h"
+#include "arb_dispatcher.h"
+#include "hal_pmic.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define DSP_QUEUE_MASK (ARB_DSP_QUEUE_SIZE - 1)
+
+/*---------------------------------------------------------------------------*
+ * Set in 'c_state' of events posted by the time event (state numbers are
+ * limited to UTL_STMN_MAX_STATES so the top bit is free), 'i_data' of those
+ * events holds 's_timeoutGen' at the time the event was armed.
+ *---------------------------------------------------------------------------*/
+#define DSP_TIME_EVENT (0x80)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   /*------------------------------------------------------------------------*
+    * Dispatcher thread handle
+    *------------------------------------------------------------------------*/
+   t_THRDHANDLE t_dspThrdHndl;
+
+   /*------------------------------------------------------------------------*
+    * Signaled once for every event posted, the count is the total number
+    * of events waiting across all the objects.
+    *------------------------------------------------------------------------*/
+   t_SEMHANDLE t_eventSem;
+
+   /*------------------------------------------------------------------------*
+    * Bit 'n' is set when the object at priority 'n' has a pending event.
+    *------------------------------------------------------------------------*/
+   volatile uint8_t c_readyMask;
+
+   /*------------------------------------------------------------------------*
+    * The registered objects indexed by priority.
+    *------------------------------------------------------------------------*/
+   t_activeObject *apt_objects[ARB_DSP_MAX_OBJECTS];
+
+}t_dspObject;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void arb_dispatcher( t_parameters t_param,
+                            t_arguments  t_args);
+static t_error arb_dispatcherQueue( t_activeObject *pt_obj,
+                                    uint8_t c_state,
+                                    int32_t i_data);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static t_dspObject gt_dspObject;
+
+/*---------------------------------------------------------------------------*
+ * Inline Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*
+ * Adds an event to the queue of 'pt_obj' without waking the dispatcher.
+ *---------------------------------------------------------------------------*/
+static t_error arb_dispatcherQueue( t_activeObject *pt_obj,
+                                    uint8_t c_state,
+                                    int32_t i_data)
+{
+   t_dspEvent *pt_event;
+
+   HAL_BEGIN_CRITICAL();
+
+   if( (pt_obj->c_prio >= ARB_DSP_MAX_OBJECTS) ||
+       (gt_dspObject.apt_objects[pt_obj->c_prio] != pt_obj))
+   {
+      HAL_END_CRITICAL();
+      return ARB_INVALID_HANDLE;
+   }
+
+   if( (uint8_t)(pt_obj->c_head - pt_obj->c_tail) >= ARB_DSP_QUEUE_SIZE)
+   {
+      HAL_END_CRITICAL();
+      return ARB_MBX_FULL;
+   }
+
+   pt_event = &pt_obj->at_queue[pt_obj->c_head & DSP_QUEUE_MASK];
+   pt_event->c_state = c_state;
+   pt_event->i_data  = i_data;
+   pt_obj->c_head++;
+
+   gt_dspObject.c_readyMask |= (1 << pt_obj->c_prio);
+
+   HAL_END_CRITICAL();
+
+   return ARB_PASSED;
+
+}/*End arb_dispatcherQueue*/
+
+static void arb_dispatcher( t_parameters t_param,
+                            t_arguments  t_args)
+{
+   t_activeObject *pt_obj;
+   t_dspEvent t_event;
+   uint8_t c_prio;
+
+   while( RUN_FOREVER)
+   {
+      /*---------------------------------------------------------------------*
+       * Sleep until an event has been posted...
+       *---------------------------------------------------------------------*/
+      arb_wait( gt_dspObject.t_eventSem,
+                BLOCKING);
+
+      HAL_BEGIN_CRITICAL();
+
+      /*---------------------------------------------------------------------*
+       * The ready mask is empty when the only events pending belonged to an
+       * object that has since been removed.
+       *---------------------------------------------------------------------*/
+      if( gt_dspObject.c_readyMask == 0)
+      {
+         HAL_END_CRITICAL();
+         continue;
+      }
+
+      /*---------------------------------------------------------------------*
+       * Take one event from the highest priority object with work, the
+       * others get their turn on the next pass.
+       *---------------------------------------------------------------------*/
+      c_prio = 0;
+      while( !(gt_dspObject.c_readyMask & (1 << c_prio)))
+         c_prio++;
+
+      pt_obj  = gt_dspObject.apt_objects[c_prio];
+      t_event = pt_obj->at_queue[pt_obj->c_tail & DSP_QUEUE_MASK];
+      pt_obj->c_tail++;
+
+      if( pt_obj->c_tail == pt_obj->c_head)
+         gt_dspObject.c_readyMask &= ~(1 << c_prio);
+
+      /*---------------------------------------------------------------------*
+       * A time event that was re-armed or disarmed after it expired, but
+       * before it was dispatched, is stale. Comparing generations (rather
+       * than keeping a single flag) also catches the case where it was
+       * re-armed and fired again while the first event was still queued.
+       *---------------------------------------------------------------------*/
+      if( t_event.c_state & DSP_TIME_EVENT)
+      {
+         if( (uint16_t)t_event.i_data != pt_obj->s_timeoutGen)
+            t_event.c_state = UTL_STMN_NO_STATE;
+         else
+            t_event.c_state &= ~DSP_TIME_EVENT;
+
+         t_event.i_data = 0;
+      }
+
+      HAL_END_CRITICAL();
+
+      /*---------------------------------------------------------------------*
+       * Events asking for a transition the table doesn't allow are dropped.
+       *---------------------------------------------------------------------*/
+      if( (t_event.c_state != UTL_STMN_NO_STATE) &&
+          (utl_stMnChangeState( &pt_obj->t_stMn,
+                                t_event.c_state,
+                                t_event.i_data) == STMN_PASSED))
+      {
+         utl_stMnEngine( &pt_obj->t_stMn);
+      }
+
+   }/*End while( RUN_FOREVER)*/
+
+}/*End arb_dispatcher*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_THRDHANDLE arb_dispatcherInit( t_stackSize t_stack,
+                                 t_thrdPrio t_pri)
+{
+   gt_dspObject.t_eventSem = arb_semaphoreCreate( COUNTING);
+
+   if( gt_dspObject.t_eventSem < 0)
+   {
+      return (t_THRDHANDLE)gt_dspObject.t_eventSem;
+   }
+
+   gt_dspObject.t_dspThrdHndl = arb_threadCreate( arb_dispatcher,
+                                                  0,
+                                                  0,
+                                                  t_stack,
+                                                  t_pri);
+
+   if( gt_dspObject.t_dspThrdHndl < 0)
+   {
+      arb_semaphoreDestroy( gt_dspObject.t_eventSem);
+      gt_dspObject.t_eventSem = 0;
+
+   }/*End if( gt_dspObject.t_dspThrdHndl < 0)*/
+
+   return gt_dspObject.t_dspThrdHndl;
+
+}/*End arb_dispatcherInit*/
+
+t_error arb_activeObjectRegister( t_activeObject *pt_obj,
+                                  uint8_t c_prio)
+{
+   if( pt_obj == NULL)
+      return ARB_NULL_PTR;
+
+   if( gt_dspObject.t_eventSem == 0) /*Dispatcher not running?*/
+      return ARB_INVALID_HANDLE;
+
+   if( c_prio >= ARB_DSP_MAX_OBJECTS)
+      return ARB_INVALID_ARG;
+
+   pt_obj->c_head    = 0;
+   pt_obj->c_tail    = 0;
+   pt_obj->s_timeout = 0;
+
+   HAL_BEGIN_CRITICAL();
+
+   if( gt_dspObject.apt_objects[c_prio] != NULL)
+   {
+      HAL_END_CRITICAL();
+      return ARB_INVALID_PRIORITY;
+   }
+
+   pt_obj->c_prio = c_prio;
+   gt_dspObject.apt_objects[c_prio] = pt_obj;
+
+   HAL_END_CRITICAL();
+
+   return ARB_PASSED;
+
+}/*End arb_activeObjectRegister*/
+
+t_error arb_activeObjectRemove( t_activeObject *pt_obj)
+{
+   if( pt_obj == NULL)
+      return ARB_NULL_PTR;
+
+   HAL_BEGIN_CRITICAL();
+
+   if( (pt_obj->c_prio >= ARB_DSP_MAX_OBJECTS) ||
+       (gt_dspObject.apt_objects[pt_obj->c_prio] != pt_obj))
+   {
+      HAL_END_CRITICAL();
+      return ARB_INVALID_HANDLE;
+   }
+
+   /*------------------------------------------------------------------------*
+    * Any events still queued are discarded, the dispatcher skips the
+    * semaphore counts they leave behind.
+    *------------------------------------------------------------------------*/
+   gt_dspObject.apt_objects[pt_obj->c_prio] = NULL;
+   gt_dspObject.c_readyMask &= ~(1 << pt_obj->c_prio);
+   pt_obj->c_prio = UTL_STMN_NO_STATE;
+   pt_obj->s_timeout = 0;
+
+   HAL_END_CRITICAL();
+
+   return ARB_PASSED;
+
+}/*End arb_activeObjectRemove*/
+
+t_error arb_activeObjectPost( t_activeObject *pt_obj,
+                              uint8_t c_state,
+                              int32_t i_data)
+{
+   t_error t_err = arb_dispatcherQueue( pt_obj,
+                                        c_state,
+                                        i_data);
+
+   /*------------------------------------------------------------------------*
+    * Wake the dispatcher, when called from an ISR the switch happens on the
+    * way out of the interrupt.
+    *------------------------------------------------------------------------*/
+   if( t_err == ARB_PASSED)
+      arb_signal( gt_dspObject.t_eventSem);
+
+   return t_err;
+
+}/*End arb_activeObjectPost*/
+
+void arb_activeObjectArmTimeout( t_activeObject *pt_obj,
+                                 uint16_t s_ticks,
+                                 uint8_t c_state)
+{
+   HAL_BEGIN_CRITICAL();
+   pt_obj->c_timeoutState = c_state;
+   pt_obj->s_timeout      = s_ticks;
+   pt_obj->s_timeoutGen++;
+   HAL_END_CRITICAL();
+
+}/*End arb_activeObjectArmTimeout*/
+
+void arb_dispatcherTick( void)
+{
+   t_activeObject *pt_obj;
+   uint8_t c_prio;
+
+   for( c_prio = 0; c_prio < ARB_DSP_MAX_OBJECTS; c_prio++)
+   {
+      pt_obj = gt_dspObject.apt_objects[c_prio];
+
+      if( (pt_obj != NULL) && (pt_obj->s_timeout != 0))
+      {
+         pt_obj->s_timeout--;
+         if( pt_obj->s_timeout == 0)
+         {
+            /*---------------------------------------------------------------*
+             * The interrupted thread has already been saved, so the normal
+             * signal (which may switch threads itself) can't be used here.
+             *---------------------------------------------------------------*/
+            if( arb_dispatcherQueue( pt_obj,
+                                     pt_obj->c_timeoutState | DSP_TIME_EVENT,
+                                     (int32_t)pt_obj->s_timeoutGen) ==
+                                     ARB_PASSED)
+            {
+               arb_signalFromTick( gt_dspObject.t_eventSem);
+            }
+         }
+      }
+
+   }/*End for( c_prio = 0; c_prio < ARB_DSP_MAX_OBJECTS; c_prio++)*/
+
+}/*End arb_dispatcherTick*/
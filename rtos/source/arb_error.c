@@ -66,7 +66,7 @@
  *---------------------------------------------------------------------------*/
 void arb_stackOverflow( void)
 {
-   static int8_t ac_buff[30];
+   static int8_t ac_buff[32];
 
    /*------------------------------------------------------------------------*
     * If you have reached this point, a thread's stack has overflowed. This
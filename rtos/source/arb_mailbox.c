@@ -40,7 +40,6 @@
 #include "arb_thread.h"
 #include "arb_semaphore.h"
 #include "arb_mailbox.h"
-#include "hal_dma.h"
 #include "utl_linkedlist.h"
 #include "hal_pmic.h"
 
@@ -55,6 +54,12 @@
 typedef struct
 {
 
+   /*------------------------------------------------------------------------*
+    * Link on 'gt_activeMbx', must be the first member (see
+    * utl_linkedlist.h).
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    /*------------------------------------------------------------------------*
     * Mutual exclusion of the shared resources 's_wrPtr', 's_rdPtr', and
     * 's_numMessages'.
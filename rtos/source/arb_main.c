@@ -5,9 +5,10 @@
  *        system (RTOS).
  *
  * @details This module contains the collection of files--arb_console.c,
- *          arb_device.c, arb_error.c, arb_idle.c, arb_mailbox.c, arb_main.c,
- *          arb_memory.c, arb_printf.c, arb_scheduler.c, arb_semaphore.c,
- *          arb_sysTimer.c, and arb_thread.c--comprising the heart of the
+ *          arb_device.c, arb_dispatcher.c, arb_error.c, arb_idle.c,
+ *          arb_mailbox.c, arb_main.c, arb_memory.c, arb_printf.c,
+ *          arb_scheduler.c, arb_semaphore.c, arb_sysTimer.c, and
+ *          arb_thread.c--comprising the heart of the
  *          the Arbitros RTOS. The first file arb_console.c, provides the
  *          functionality for interfacing the kernel and user-space
  *          application with a terminal window via a user specified console
@@ -40,8 +40,8 @@
 /*---------------------------------------------------------------------------*
  * Private Function Prototypes
  *---------------------------------------------------------------------------*/
-static void arb_createMemIntsOn( void) __attribute__ ( ( naked, noinline));
-static void arb_createMemIntsOff( void) __attribute__ ( ( naked, noinline));
+static void arb_createMemIntsOn( void) HAL_NAKED_FUNC;
+static void arb_createMemIntsOff( void) HAL_NAKED_FUNC;
 
 /*---------------------------------------------------------------------------*
  * Private Typedefs
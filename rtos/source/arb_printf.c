@@ -38,12 +38,43 @@
 #include "arb_sysTimer.h"
 #include "drv_console.h"
 #include "drv_sd.h"
+#include "arb_memory.h"
 #include "hal_pmic.h"
 #include "utl_buffer.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
  *---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*
+ * The log file is written in whole sectors so that each card write maps onto
+ * exactly one block and never requires a read-modify-write of the sdfat
+ * cache.
+ *---------------------------------------------------------------------------*/
+#define PRINTF_LOG_SECTOR_BYTES   (512)
+/*---------------------------------------------------------------------------*
+ * The log is spread across PRINTF_LOG_NUM_FILES files, each capped at
+ * PRINTF_LOG_FILE_BYTES (a multiple of the sector size) and allocated as
+ * contiguous clusters when opened. When a file fills up the next one in the
+ * set is truncated and reused, so the cost of an append never depends on
+ * how long the system has been running. File 'n' is named by inserting 'n'
+ * in front of the extension of the name passed to 'arb_printfInit', i.e.
+ * "logs/dmsg.txt" becomes "logs/dmsg0.txt" through "logs/dmsg3.txt".
+ *---------------------------------------------------------------------------*/
+#define PRINTF_LOG_NUM_FILES      (4)
+#define PRINTF_LOG_FILE_BYTES     ((uint32_t)262144)
+/*---------------------------------------------------------------------------*
+ * The maximum length of the log file path, including the file index.
+ *---------------------------------------------------------------------------*/
+#define PRINTF_LOG_MAX_NAME       (32)
+/*---------------------------------------------------------------------------*
+ * A partially filled sector is written to the card (and the file's directory
+ * entry updated) when it has been waiting this long...
+ *---------------------------------------------------------------------------*/
+#define PRINTF_LOG_SYNC_PERIOD    (1000) /*msec*/
+/*---------------------------------------------------------------------------*
+ * ...or as soon as a message with this priority or higher is logged.
+ *---------------------------------------------------------------------------*/
+#define PRINTF_LOG_SYNC_LEVEL     (PRINTF_DBG_HIGH)
 
 /*---------------------------------------------------------------------------*
  * Private Datatypes
@@ -62,9 +93,90 @@ typedef struct
    t_DEVHANDLE t_logFileHndl;
 
    /*------------------------------------------------------------------------*
-    * Handle to the particular circular buffer used for storing debug messages.
+    * Circular buffer used for storing debug messages. Space in the buffer is
+    * handed out to multiple producers (threads and interrupts) using a
+    * reserve/commit protocol...
+    *
+    *                   |<------------ s_fillCount ------------>|
+    *                   |<---- s_readCount ---->|
+    *    .--------------.-----------------------.---------------.----------.
+    *    |     free     | committed (flushable) |  reserved     |   free   |
+    *    '--------------'-----------------------'---------------'----------'
+    *                   ^                                       ^
+    *               s_rdIndex                               s_wrIndex
+    *
+    * A producer reserves space by advancing the buffer's write index inside
+    * a critical section only a few instructions long. The message is then
+    * copied into the reserved region with interrupts enabled. When the last
+    * outstanding reservation commits, every reserved byte becomes visible to
+    * the consumer ('arb_printfFlushBuf').
+    *------------------------------------------------------------------------*/
+   t_buffer t_logBuf;
+
+   /*------------------------------------------------------------------------*
+    * The number of committed bytes (starting at the buffer's read index) the
+    * consumer is allowed to read.
+    *------------------------------------------------------------------------*/
+   volatile uint16_t s_readCount;
+
+   /*------------------------------------------------------------------------*
+    * The number of reservations that have yet to be committed.
+    *------------------------------------------------------------------------*/
+   volatile uint8_t c_numPending;
+
+   /*------------------------------------------------------------------------*
+    * The number of messages discarded because there wasn't enough room in
+    * the circular buffer.
+    *------------------------------------------------------------------------*/
+   volatile uint32_t i_numDropped;
+
+   /*------------------------------------------------------------------------*
+    * The value of 'i_numDropped' the last time it was reported to the
+    * console.
+    *------------------------------------------------------------------------*/
+   uint32_t i_numDroppedRep;
+
+   /*------------------------------------------------------------------------*
+    * The path of the log file as given to 'arb_printfInit' (without the
+    * file index).
+    *------------------------------------------------------------------------*/
+   char ac_logName[PRINTF_LOG_MAX_NAME];
+
+   /*------------------------------------------------------------------------*
+    * The index of the log file currently being written.
     *------------------------------------------------------------------------*/
-   t_BUFFHANDLE t_logBuffer;
+   uint8_t c_logIndex;
+
+   /*------------------------------------------------------------------------*
+    * Sector sized staging area for data headed to the log file.
+    *------------------------------------------------------------------------*/
+   int8_t *pc_sector;
+
+   /*------------------------------------------------------------------------*
+    * The number of bytes currently held in 'pc_sector'.
+    *------------------------------------------------------------------------*/
+   uint16_t s_sectorLevel;
+
+   /*------------------------------------------------------------------------*
+    * The offset within the log file where 'pc_sector' will be written.
+    *------------------------------------------------------------------------*/
+   uint32_t i_sectorPos;
+
+   /*------------------------------------------------------------------------*
+    * If true, 'pc_sector' holds data that hasn't been written to the card.
+    *------------------------------------------------------------------------*/
+   bool b_sectorDirty;
+
+   /*------------------------------------------------------------------------*
+    * Set when a message at or above 'PRINTF_LOG_SYNC_LEVEL' is logged,
+    * forcing the partial sector out on the next flush.
+    *------------------------------------------------------------------------*/
+   volatile bool b_syncReq;
+
+   /*------------------------------------------------------------------------*
+    * The system time (msec) the log file was last synchronized.
+    *------------------------------------------------------------------------*/
+   uint64_t l_lastSync;
 
    /*------------------------------------------------------------------------*
     * This variable controls which messages are allowed to print to the
@@ -85,6 +197,24 @@ typedef struct
 /*---------------------------------------------------------------------------*
  * Private Function Prototypes
  *---------------------------------------------------------------------------*/
+static int16_t reserveLogSpace( uint16_t s_size);
+
+static uint16_t copyToLog( uint16_t s_index,
+                           const int8_t *pc_src,
+                           uint16_t s_size);
+
+static void commitLogSpace( void);
+
+static void writeLogSinks( int8_t *pc_buff,
+                           uint16_t s_size);
+
+static void writeLogSector( uint16_t s_size);
+
+static void syncLogFile( void);
+
+static t_error openLogFile( uint8_t c_index);
+
+static void rotateLogFile( void);
 
 /*---------------------------------------------------------------------------*
  * Private Global Variables
@@ -98,6 +228,263 @@ static t_printObject gt_pObject;
 /*---------------------------------------------------------------------------*
  * Private Function Definitions
  *---------------------------------------------------------------------------*/
+static int16_t reserveLogSpace( uint16_t s_size)
+{
+   int16_t s_start;
+
+   HAL_BEGIN_CRITICAL();
+
+   if( (int16_t)s_size > utl_getBufferEmptyLevel( &gt_pObject.t_logBuf))
+   {
+      gt_pObject.i_numDropped++;
+      HAL_END_CRITICAL();
+      return -1;
+   }
+
+   s_start = gt_pObject.t_logBuf.s_wrIndex;
+   utl_commitBufferWrite( &gt_pObject.t_logBuf,
+                          s_size);
+   gt_pObject.c_numPending++;
+
+   HAL_END_CRITICAL();
+
+   return s_start;
+
+}/*End reserveLogSpace*/
+
+static uint16_t copyToLog( uint16_t s_index,
+                           const int8_t *pc_src,
+                           uint16_t s_size)
+{
+   int8_t *pc_logBuffer = gt_pObject.t_logBuf.pc_buffer;
+   uint16_t s_bufSize   = gt_pObject.t_logBuf.s_sizeBytes;
+   uint16_t s_room      = s_bufSize - s_index;
+
+   /*------------------------------------------------------------------------*
+    * The reserved region is owned by the caller, so no locking is needed.
+    *------------------------------------------------------------------------*/
+   if( s_room < s_size)
+   {
+      memcpy( (void *)&pc_logBuffer[s_index],
+              (void *)pc_src,
+              s_room);
+      memcpy( (void *)pc_logBuffer,
+              (void *)&pc_src[s_room],
+              s_size - s_room);
+      return s_size - s_room;
+   }
+
+   memcpy( (void *)&pc_logBuffer[s_index],
+           (void *)pc_src,
+           s_size);
+
+   s_index += s_size;
+   if( s_index == s_bufSize)
+      s_index = 0;
+
+   return s_index;
+
+}/*End copyToLog*/
+
+static void commitLogSpace( void)
+{
+   HAL_BEGIN_CRITICAL();
+
+   /*------------------------------------------------------------------------*
+    * Reservations can complete out of order (a thread preempted by an
+    * interrupt that also prints), so nothing is published to the consumer
+    * until the last outstanding reservation has been filled.
+    *------------------------------------------------------------------------*/
+   gt_pObject.c_numPending--;
+   if( gt_pObject.c_numPending == 0)
+      gt_pObject.s_readCount = (uint16_t)utl_getBufferFullLevel(
+      &gt_pObject.t_logBuf);
+
+   HAL_END_CRITICAL();
+
+}/*End commitLogSpace*/
+
+static void writeLogSector( uint16_t s_size)
+{
+   uint8_t ac_buff[20];
+   int16_t s_bytes;
+
+   s_bytes = arb_write( gt_pObject.t_logFileHndl,
+                        gt_pObject.pc_sector,
+                        s_size);
+
+   if( s_bytes != (int16_t)s_size)
+   {
+      sprintf( (char *)ac_buff, "sd write failed\r");
+      arb_write( gt_pObject.t_printfHndl,
+                 (int8_t *)ac_buff,
+                 (uint16_t)strlen( (char *)ac_buff));
+   }/*End if( s_bytes != (int16_t)s_size)*/
+
+}/*End writeLogSector*/
+
+static void syncLogFile( void)
+{
+   /*------------------------------------------------------------------------*
+    * Write the partial sector and update the directory entry, then move the
+    * file position back to the start of the sector. The next write of this
+    * sector is then a full block overwrite rather than an unaligned append.
+    *------------------------------------------------------------------------*/
+   writeLogSector( gt_pObject.s_sectorLevel);
+
+   arb_ioctl( gt_pObject.t_logFileHndl,
+              SD_SYNC,
+              0);
+
+   arb_ioctl( gt_pObject.t_logFileHndl,
+              SD_SEEK,
+              (int32_t)gt_pObject.i_sectorPos);
+
+   gt_pObject.b_sectorDirty = false;
+
+}/*End syncLogFile*/
+
+static t_error openLogFile( uint8_t c_index)
+{
+   char ac_name[PRINTF_LOG_MAX_NAME];
+   char *pc_base;
+   char *pc_ext;
+
+   /*------------------------------------------------------------------------*
+    * 'arb_open' tokenizes the path in place, so build a fresh copy with the
+    * file index inserted in front of the extension. If the 8.3 base name is
+    * already full, the index replaces its last character.
+    *------------------------------------------------------------------------*/
+   strcpy( ac_name, gt_pObject.ac_logName);
+
+   pc_base = strrchr( ac_name, '/');
+   if( pc_base == NULL)
+      pc_base = ac_name;
+   else
+      pc_base++;
+
+   pc_ext = strrchr( pc_base, '.');
+   if( pc_ext == NULL)
+      pc_ext = &pc_base[strlen( pc_base)];
+
+   if( (pc_ext - pc_base) >= 8)
+      pc_ext--;
+   else
+      memmove( pc_ext + 1, pc_ext, strlen( pc_ext) + 1);
+
+   *pc_ext = '0' + c_index;
+
+   gt_pObject.t_logFileHndl = arb_open( ac_name,
+                                        ARB_O_WRITE |
+                                        ARB_O_CREAT);
+
+   if( gt_pObject.t_logFileHndl < 0)
+   {
+      return (t_error)gt_pObject.t_logFileHndl;
+   }
+
+   /*------------------------------------------------------------------------*
+    * Drop whatever was logged to this file before...
+    *------------------------------------------------------------------------*/
+   if( arb_ioctl( gt_pObject.t_logFileHndl,
+                  SD_ERASE,
+                  0) < 0)
+   {
+      arb_close( gt_pObject.t_logFileHndl);
+      return ARB_OPEN_ERROR;
+   }
+
+   /*------------------------------------------------------------------------*
+    * Reserve contiguous clusters for the log. Not fatal if the card is too
+    * fragmented, the file simply grows one cluster at a time.
+    *------------------------------------------------------------------------*/
+   arb_ioctl( gt_pObject.t_logFileHndl,
+              SD_PREALLOC,
+              (int32_t)PRINTF_LOG_FILE_BYTES);
+
+   gt_pObject.c_logIndex    = c_index;
+   gt_pObject.s_sectorLevel = 0;
+   gt_pObject.i_sectorPos   = 0;
+   gt_pObject.b_sectorDirty = false;
+
+   return ARB_PASSED;
+
+}/*End openLogFile*/
+
+static void rotateLogFile( void)
+{
+   uint8_t c_index;
+
+   arb_ioctl( gt_pObject.t_logFileHndl,
+              SD_SYNC,
+              0);
+
+   arb_close( gt_pObject.t_logFileHndl);
+
+   c_index = gt_pObject.c_logIndex + 1;
+   if( c_index == PRINTF_LOG_NUM_FILES)
+      c_index = 0;
+
+   /*------------------------------------------------------------------------*
+    * If the next file can't be opened stop logging rather than failing on
+    * every subsequent flush.
+    *------------------------------------------------------------------------*/
+   if( openLogFile( c_index) < 0)
+      gt_pObject.b_wrtLogFile = false;
+
+}/*End rotateLogFile*/
+
+static void writeLogSinks( int8_t *pc_buff,
+                           uint16_t s_size)
+{
+   uint16_t s_room;
+
+   arb_write( gt_pObject.t_printfHndl,
+              pc_buff,
+              s_size);
+
+   if( gt_pObject.b_wrtLogFile == true)
+   {
+
+      /*---------------------------------------------------------------------*
+       * Accumulate into the sector buffer, writing only complete sectors.
+       *---------------------------------------------------------------------*/
+      while( s_size > 0)
+      {
+         s_room = PRINTF_LOG_SECTOR_BYTES - gt_pObject.s_sectorLevel;
+         if( s_room > s_size)
+            s_room = s_size;
+
+         memcpy( (void *)&gt_pObject.pc_sector[gt_pObject.s_sectorLevel],
+                 (void *)pc_buff,
+                 s_room);
+
+         gt_pObject.s_sectorLevel += s_room;
+         gt_pObject.b_sectorDirty  = true;
+         pc_buff += s_room;
+         s_size  -= s_room;
+
+         if( gt_pObject.s_sectorLevel == PRINTF_LOG_SECTOR_BYTES)
+         {
+            writeLogSector( PRINTF_LOG_SECTOR_BYTES);
+            gt_pObject.i_sectorPos   += PRINTF_LOG_SECTOR_BYTES;
+            gt_pObject.s_sectorLevel  = 0;
+            gt_pObject.b_sectorDirty  = false;
+            gt_pObject.l_lastSync     = arb_sysMsecNow();
+
+            if( gt_pObject.i_sectorPos >= PRINTF_LOG_FILE_BYTES)
+            {
+               rotateLogFile();
+               if( gt_pObject.b_wrtLogFile == false)
+                  break;
+            }
+         }
+
+      }/*End while( s_size > 0)*/
+
+   }/*End if( gt_pObject.b_wrtLogFile == true)*/
+
+}/*End writeLogSinks*/
 
 /*---------------------------------------------------------------------------*
  * Public Function Definitions
@@ -127,6 +514,18 @@ uint8_t arb_getPrintfDbgLevel( void)
    return gt_pObject.c_termDbgLevel;
 }/*End arb_getPrintfDbgLevel*/
 
+uint32_t arb_getPrintfDropCount( void)
+{
+   uint32_t i_numDropped;
+
+   HAL_BEGIN_CRITICAL();
+   i_numDropped = gt_pObject.i_numDropped;
+   HAL_END_CRITICAL();
+
+   return i_numDropped;
+
+}/*End arb_getPrintfDropCount*/
+
 void arb_sysPrintChar( const char c_buff)
 {
    /*------------------------------------------------------------------------*
@@ -142,220 +541,139 @@ void arb_printf( uint8_t c_flags,
                  const char *pc_buff)
 {
    t_sysTime t_time;
-   uint16_t s_size = 0;
-   uint8_t ac_buff[20];
-   int16_t s_msec;
+   uint16_t s_timeSize = 0;
+   uint16_t s_msgSize;
+   int16_t s_index;
+   uint8_t ac_buff[24]; /*Worst case time prefix and terminator*/
+   int8_t c_newLine = '\n';
 
-   HAL_BEGIN_CRITICAL();
+   if( (c_flags & PRINTF_DBG_PRIORITY_MASK) < gt_pObject.c_termDbgLevel)
+      return;
 
-   if( (c_flags &  PRINTF_DBG_SHOW_TIME) &&
-       ((c_flags & PRINTF_DBG_PRIORITY_MASK) >= gt_pObject.c_termDbgLevel))
+   /*------------------------------------------------------------------------*
+    * Format the message prefix before reserving space so that the only work
+    * done with interrupts disabled is the reservation itself.
+    *------------------------------------------------------------------------*/
+   if( c_flags & PRINTF_DBG_SHOW_TIME)
    {
       t_time = arb_sysTimeNow();
-      if( t_time.c_hours < 10)
-         s_size = sprintf_P( (char *)ac_buff,
-                              PSTR("[%02d:"),
-                              t_time.c_hours);
-      else
-         s_size = sprintf_P( (char *)ac_buff,
-                             PSTR("[%2d:"),
-                             t_time.c_hours);
-
-      if( t_time.c_min < 10)
-         s_size += sprintf_P( (char *)&ac_buff[s_size],
-                              PSTR("%02d:"),
-                              t_time.c_min);
-      else
-         s_size += sprintf_P( (char *)&ac_buff[s_size],
-                              PSTR("%2d:"),
-                              t_time.c_min);
-
-      if( t_time.c_sec < 10)
-         s_size += sprintf_P( (char *)&ac_buff[s_size],
-                              PSTR("%02d:"),
-                              t_time.c_sec);
-      else
-         s_size += sprintf_P( (char *)&ac_buff[s_size],
-                              PSTR("%2d:"),
-                              t_time.c_sec);
-
-      s_msec = t_time.i_usec/1000;
-      if( s_msec < 10)
-         s_size += sprintf_P( (char *)&ac_buff[s_size],
-                               PSTR("%003d]  "),
-                               s_msec);
-      else if( s_msec < 100)
-         s_size += sprintf_P( (char *)&ac_buff[s_size],
-                              PSTR("%03d]  "),
-                              s_msec);
-      else if( s_msec < 1000)
-         s_size += sprintf_P( (char *)&ac_buff[s_size],
-                              PSTR("%3d]  "),
-                              s_msec);
-
-      /*---------------------------------------------------------------------*
-       * Store the current time in the circular buffer.
-       *---------------------------------------------------------------------*/
-      utl_writeBlock( gt_pObject.t_logBuffer,
-                      (int8_t *)ac_buff,
-                      s_size);
-
+      s_timeSize = sprintf_P( (char *)ac_buff,
+                              PSTR("[%02d:%02d:%02d:%03d]  "),
+                              t_time.c_hours,
+                              t_time.c_min,
+                              t_time.c_sec,
+                              (int16_t)(t_time.i_usec/1000));
    }
 
+   s_msgSize = (uint16_t)strlen( pc_buff);
+
    /*------------------------------------------------------------------------*
-    * Store the debug message in the circular buffer based on priority.
+    * Reserve room for the time, message, and trailing new line.
     *------------------------------------------------------------------------*/
-   if( (c_flags & PRINTF_DBG_PRIORITY_MASK) >= gt_pObject.c_termDbgLevel)
+   s_index = reserveLogSpace( s_timeSize + s_msgSize + 1);
+   if( s_index < 0)
+      return;
+
+   if( s_timeSize > 0)
    {
+      s_index = (int16_t)copyToLog( (uint16_t)s_index,
+                                    (int8_t *)ac_buff,
+                                    s_timeSize);
+   }
 
-      utl_writeBlock( gt_pObject.t_logBuffer,
-                      (int8_t *)pc_buff,
-                      (uint16_t)strlen( (char *)pc_buff));
+   s_index = (int16_t)copyToLog( (uint16_t)s_index,
+                                 (const int8_t *)pc_buff,
+                                 s_msgSize);
 
-      /*------------------------------------------------------------------------*
-       * Append a new line to the end of the buffer.
-       *------------------------------------------------------------------------*/
-      utl_writeByte( gt_pObject.t_logBuffer,
-                     '\n');
+   copyToLog( (uint16_t)s_index,
+              &c_newLine,
+              1);
 
-   }/*End if( (c_flags & PRINTF_DBG_PRIORITY_MASK) >= gt_pObject.c_termDbgLevel)*/
+   commitLogSpace();
 
-   HAL_END_CRITICAL();
+   if( (c_flags & PRINTF_DBG_PRIORITY_MASK) >= PRINTF_LOG_SYNC_LEVEL)
+      gt_pObject.b_syncReq = true;
 
 }/*End arb_printf*/
 
 void arb_printfFlushBuf( void)
 {
-   uint8_t ac_buff[20];
-   int8_t *pc_headPtr;
-   int16_t s_level;
-   int16_t s_size;
-   int16_t s_rdPtr;
-   int16_t s_room;
-   int16_t s_bytes;
+   uint8_t ac_buff[32]; /*Room for a 10 digit count*/
+   uint32_t i_numDropped;
+   uint16_t s_level;
+   uint16_t s_span;
+   int8_t *pc_span;
 
    /*------------------------------------------------------------------------*
-    * Get the head location of the log buffer...
+    * Take a snapshot of the committed region...
     *------------------------------------------------------------------------*/
    HAL_BEGIN_CRITICAL();
-   pc_headPtr = utl_getBufferPtr( gt_pObject.t_logBuffer);
-   s_level    = utl_getBufferFullLevel( gt_pObject.t_logBuffer);
-   s_size     = utl_getBufferSize( gt_pObject.t_logBuffer);
-   s_rdPtr    = utl_getBufRdPtr(gt_pObject.t_logBuffer);
+   s_level      = gt_pObject.s_readCount;
+   i_numDropped = gt_pObject.i_numDropped;
    HAL_END_CRITICAL();
 
    /*------------------------------------------------------------------------*
-    * Write the entire contents of the buffer...
+    * Hand the sinks the largest contiguous pieces possible, which is two
+    * writes at most when the committed region wraps the end of the buffer.
     *------------------------------------------------------------------------*/
-   if( s_level >= s_size)
+   while( s_level > 0)
    {
-      /*---------------------------------------------------------------------*
-       * Print only s_size bytes...
-       *---------------------------------------------------------------------*/
-      arb_write( gt_pObject.t_printfHndl,
-                 (int8_t *)pc_headPtr,
-                 (uint16_t)s_size);
-
-      if( gt_pObject.b_wrtLogFile == true)
-      {
-
-         s_bytes = arb_write( gt_pObject.t_logFileHndl,
-                              (int8_t *)pc_headPtr,
-                              s_size);
-
-         if( s_bytes != s_size)
-         {
-            sprintf( (char *)ac_buff, "sd write failed\r");
-            arb_write( gt_pObject.t_printfHndl,
-                       (int8_t *)ac_buff,
-                       (uint16_t)strlen( (char *)ac_buff));
-         }/*End if( s_bytes != s_size)*/
+      s_span = utl_getBufferReadSpan( &gt_pObject.t_logBuf,
+                                      &pc_span);
+      if( s_span > s_level)
+         s_span = s_level;
 
-      }/*End if( gt_pObject.b_wrtLogFile == true)*/
+      writeLogSinks( pc_span,
+                     s_span);
 
       /*---------------------------------------------------------------------*
-       * Buffer overflowed so reset...
+       * Release the space back to the producers.
        *---------------------------------------------------------------------*/
       HAL_BEGIN_CRITICAL();
-      ult_resetBuffer(gt_pObject.t_logBuffer);
+      utl_commitBufferRead( &gt_pObject.t_logBuf,
+                            s_span);
+      gt_pObject.s_readCount -= s_span;
       HAL_END_CRITICAL();
 
-   }/*End if( s_level > s_size)*/
-   else if( s_level > 0)
-   {
-      /*---------------------------------------------------------------------*
-       * If wrapping the end of the buffer, print to console twice...
-       *---------------------------------------------------------------------*/
-      s_room = s_size - s_rdPtr;
-      if( s_room < s_level)
-      {
-         arb_write( gt_pObject.t_printfHndl,
-                    (int8_t *)&pc_headPtr[s_rdPtr],
-                    (uint16_t)s_room);
-
-         arb_write( gt_pObject.t_printfHndl,
-                    (int8_t *)&pc_headPtr[0],
-                    (uint16_t)(s_level - s_room));
-
-         if( gt_pObject.b_wrtLogFile == true)
-         {
-            s_bytes = arb_write( gt_pObject.t_logFileHndl,
-                                 (int8_t *)&pc_headPtr[s_rdPtr],
-                                 (uint16_t)s_room);
-
-            if( s_bytes != s_room)
-            {
-               sprintf( (char *)ac_buff, "sd write failed\r");
-               arb_write( gt_pObject.t_printfHndl,
-                          (int8_t *)ac_buff,
-                          (uint16_t)strlen( (char *)ac_buff));
-            }/*End if( s_bytes != s_room)*/
+      s_level -= s_span;
 
-            s_bytes = arb_write( gt_pObject.t_logFileHndl,
-                                 (int8_t *)&pc_headPtr[0],
-                                 (uint16_t)(s_level - s_room));
+   }/*End while( s_level > 0)*/
 
-            if( s_bytes != (uint16_t)(s_level - s_room))
-            {
-               sprintf( (char *)ac_buff, "sd write failed\r");
-               arb_write( gt_pObject.t_printfHndl,
-                          (int8_t *)ac_buff,
-                          (uint16_t)strlen( (char *)ac_buff));
-            }/*End if( s_bytes != (uint16_t)(s_level - s_room))*/
-
-         }/*End if( gt_pObject.b_wrtLogFile == true)*/
+   /*------------------------------------------------------------------------*
+    * Push a partially filled sector to the card if it has been waiting too
+    * long or a high priority message needs to be persisted.
+    *------------------------------------------------------------------------*/
+   if( gt_pObject.b_wrtLogFile == true)
+   {
+      uint64_t l_now = arb_sysMsecNow();
 
-      }/*End if( s_room < s_level)*/
-      else
+      if( (gt_pObject.b_sectorDirty == true) &&
+          ((gt_pObject.b_syncReq == true) ||
+          (arb_sysMsecDelta( l_now, gt_pObject.l_lastSync) >=
+          PRINTF_LOG_SYNC_PERIOD)))
       {
-         arb_write( gt_pObject.t_printfHndl,
-                   (int8_t *)&pc_headPtr[s_rdPtr],
-                   (uint16_t)s_level);
+         syncLogFile();
+         gt_pObject.l_lastSync = l_now;
+      }
 
-         if( gt_pObject.b_wrtLogFile == true)
-         {
+      gt_pObject.b_syncReq = false;
 
-            s_bytes = arb_write( gt_pObject.t_logFileHndl,
-                                 (int8_t *)&pc_headPtr[s_rdPtr],
-                                 (uint16_t)s_level);
+   }/*End if( gt_pObject.b_wrtLogFile == true)*/
 
-            if( s_bytes != s_level)
-            {
-               sprintf( (char *)ac_buff, "sd write failed\r");
-               arb_write( gt_pObject.t_printfHndl,
-                          (int8_t *)ac_buff,
-                          (uint16_t)strlen( (char *)ac_buff));
-            }/*End if( s_bytes != s_level)*/
-
-         }/*End if( gt_pObject.b_wrtLogFile == true)*/
-      }
-      
-      HAL_BEGIN_CRITICAL();
-      utl_incrBufRdPtr( gt_pObject.t_logBuffer,
-                        (uint16_t)s_level);
-      HAL_END_CRITICAL();
-      
-   }/*End else if( s_level > 0)*/
+   /*------------------------------------------------------------------------*
+    * Let the user know messages were lost since the last flush.
+    *------------------------------------------------------------------------*/
+   if( i_numDropped != gt_pObject.i_numDroppedRep)
+   {
+      snprintf( (char *)ac_buff,
+                sizeof( ac_buff),
+                "%lu printf msgs dropped\r",
+                (unsigned long)(i_numDropped - gt_pObject.i_numDroppedRep));
+      arb_write( gt_pObject.t_printfHndl,
+                 (int8_t *)ac_buff,
+                 (uint16_t)strlen( (char *)ac_buff));
+      gt_pObject.i_numDroppedRep = i_numDropped;
+   }
 
 }/*End arb_printfFlushBuf*/
 
@@ -363,6 +681,7 @@ t_error arb_printfInit( char *pc_driver,
                         int16_t s_bufSize,
                         char *pc_logFile)
 {
+   t_error t_err;
 
    gt_pObject.c_termDbgLevel = PRINTF_DBG_OFF;
    gt_pObject.b_wrtLogFile   = false;
@@ -386,41 +705,48 @@ t_error arb_printfInit( char *pc_driver,
    if( pc_logFile != NULL)
    {
 
-      /*---------------------------------------------------------------------*
-       * Open a file for logging debug information.
-       *---------------------------------------------------------------------*/
-      gt_pObject.t_logFileHndl = arb_open( pc_logFile,
-                                           ARB_O_WRITE |
-                                           ARB_O_CREAT |
-                                           ARB_O_SYNC);
+      if( strlen( pc_logFile) >= (PRINTF_LOG_MAX_NAME - 1))
+      {
+         return ARB_NAME_ERROR;
+      }
+
+      strcpy( gt_pObject.ac_logName, pc_logFile);
 
       /*---------------------------------------------------------------------*
-       * Don't return a failure if the file couldn't be opened.
+       * Open the first file of the set for logging debug information.
        *---------------------------------------------------------------------*/
-      if( gt_pObject.t_logFileHndl < 0)
+      t_err = openLogFile( 0);
+      if( t_err < 0)
       {
-         return (t_error)gt_pObject.t_logFileHndl;
+         return t_err;
       }
 
-      if( arb_ioctl( gt_pObject.t_logFileHndl,
-                     SD_ERASE,
-                     0) < 0)
+      arb_malloc( PRINTF_LOG_SECTOR_BYTES,
+                  (void **)&gt_pObject.pc_sector);
+      if( gt_pObject.pc_sector == NULL)
       {
-         return ARB_OPEN_ERROR;
+         return ARB_OUT_OF_HEAP;
       }
 
-      gt_pObject.b_wrtLogFile = true;
+      gt_pObject.b_syncReq     = false;
+      gt_pObject.l_lastSync    = 0;
+      gt_pObject.b_wrtLogFile  = true;
 
    }/*End if( pc_logFile != NULL)*/
 
    /*------------------------------------------------------------------------*
     * Allocate a circular buffer for holding the debug messages.
     *------------------------------------------------------------------------*/
-   gt_pObject.t_logBuffer = utl_createBuffer( s_bufSize);
-   if( gt_pObject.t_logBuffer < 0)
+   if( utl_createBuffer( &gt_pObject.t_logBuf,
+                         (uint16_t)s_bufSize) < 0)
    {
       return ARB_OUT_OF_HEAP;
-   }/*End if( gt_pObject.t_logBuffer < 0)*/
+   }
+
+   gt_pObject.s_readCount     = 0;
+   gt_pObject.c_numPending    = 0;
+   gt_pObject.i_numDropped    = 0;
+   gt_pObject.i_numDroppedRep = 0;
 
    return ARB_PASSED;
 
@@ -43,32 +43,41 @@
  * Private Defines
  *---------------------------------------------------------------------------*/
 
+/*---------------------------------------------------------------------------*
+ * Handle to the list of threads blocked on a particular semaphore.
+ *---------------------------------------------------------------------------*/
+#define SEM_BLOCKED_LIST( pt_sem) UTL_GET_CONT_HNDL( (pt_sem)->t_blockedList)
+
 /*---------------------------------------------------------------------------*
  * Private Datatypes
  *---------------------------------------------------------------------------*/
 typedef struct t_sem
 {
+   /*------------------------------------------------------------------------*
+    * Places this semaphore on 'gt_activeSems', must be the first member.
+    *------------------------------------------------------------------------*/
+   t_listLink t_link;
+
    t_semType t_type;
 
    int16_t s_count;
 
-   t_CONTHNDL t_blockedList;
+   /*------------------------------------------------------------------------*
+    * Threads waiting on this semaphore. The TCBs are moved here directly
+    * from 'gt_activeThreads', no memory is allocated when blocking.
+    *------------------------------------------------------------------------*/
+   t_listContainer t_blockedList;
 
 }t_semaphore;
 
 /*---------------------------------------------------------------------------*
  * Private Function Prototypes
  *---------------------------------------------------------------------------*/
-static void arb_yieldFromWaitIntsOn( void) __attribute__\
- ( ( naked, noinline));
-static void arb_yieldFromWaitIntsOff( void) __attribute__\
- ( ( naked, noinline));
-static void arb_yieldFromSignalActiveInt( void) __attribute__\
- ( ( naked, noinline));
-static void arb_yieldFromSignalIntsOn( void) __attribute__\
- ( ( naked, noinline));
-static void arb_yieldFromSignalIntsOff( void) __attribute__\
- ( ( naked, noinline));
+static void arb_yieldFromWaitIntsOn( void) HAL_NAKED_FUNC;
+static void arb_yieldFromWaitIntsOff( void) HAL_NAKED_FUNC;
+static void arb_yieldFromSignalActiveInt( void) HAL_NAKED_FUNC;
+static void arb_yieldFromSignalIntsOn( void) HAL_NAKED_FUNC;
+static void arb_yieldFromSignalIntsOff( void) HAL_NAKED_FUNC;
 
 /*---------------------------------------------------------------------------*
  * Private Global Variables
@@ -296,7 +305,7 @@ static void arb_yieldFromWaitIntsOn( void)
    /*------------------------------------------------------------------------*
     * Insert this thread onto the blocked list for this semaphore...
     *------------------------------------------------------------------------*/
-   gt_linkError = utl_insertLink( gpt_currentSem->t_blockedList,
+   gt_linkError = utl_insertLink( SEM_BLOCKED_LIST( gpt_currentSem),
                                   UTL_GET_CURR_OF_CONT( gt_activeThreads),
                                   true);
 
@@ -378,7 +387,7 @@ static void arb_yieldFromWaitIntsOff( void)
    /*------------------------------------------------------------------------*
     * Insert this thread onto the blocked list for this semaphore...
     *------------------------------------------------------------------------*/
-   gt_linkError = utl_insertLink( gpt_currentSem->t_blockedList,
+   gt_linkError = utl_insertLink( SEM_BLOCKED_LIST( gpt_currentSem),
                                   UTL_GET_CURR_OF_CONT( gt_activeThreads),
                                   true);
 
@@ -631,18 +640,18 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
        * according to priority.
        *---------------------------------------------------------------------*/
       if( (gpt_currentSem->s_count <= 0) &&
-      (UTL_GET_NUM_LINKS_CONT( gpt_currentSem->t_blockedList) > 0))
+      (UTL_GET_NUM_LINKS_CONT( SEM_BLOCKED_LIST( gpt_currentSem)) > 0))
       {
 
          /*------------------------------------------------------------------*
           * Find the thread with the highest priority on the blocked
           * list for this semaphore.
           *------------------------------------------------------------------*/
-         t_highest = UTL_GET_HEAD_OF_CONT( gpt_currentSem->t_blockedList);
+         t_highest = UTL_GET_HEAD_OF_CONT( SEM_BLOCKED_LIST( gpt_currentSem));
          pt_temp   = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_highest);
          s_highest = pt_temp->t_priority;
-         UTL_TRAVERSE_CONTAINER_HEAD( t_curr, gpt_currentSem->t_blockedList,\
-         s_count)
+         UTL_TRAVERSE_CONTAINER_HEAD( t_curr,
+         SEM_BLOCKED_LIST( gpt_currentSem), s_count)
          {
             pt_temp = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_curr);
             if( pt_temp->t_priority < s_highest)
@@ -668,7 +677,7 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
             /*---------------------------------------------------------------*
              * Remove the highest priority thread from the blocked list
              *---------------------------------------------------------------*/
-            t_linkError = utl_removeLink( gpt_currentSem->t_blockedList,
+            t_linkError = utl_removeLink( SEM_BLOCKED_LIST( gpt_currentSem),
                                           t_highest);
 
             /*---------------------------------------------------------------*
@@ -691,8 +700,8 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
              * previous ptr to change t_curr back to a valid location once an
              * item has been removed.
              *----------------------------------------------------------------*/
-            UTL_TRAVERSE_CONTAINER_HEAD( t_curr, gpt_currentSem->t_blockedList,\
-            s_count)
+            UTL_TRAVERSE_CONTAINER_HEAD( t_curr,
+            SEM_BLOCKED_LIST( gpt_currentSem), s_count)
             {
                pt_temp = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_curr);
 
@@ -700,7 +709,7 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
 
                t_prevLink = UTL_GET_PREV_LINK( t_curr);
 
-               t_linkError = utl_removeLink( gpt_currentSem->t_blockedList,
+               t_linkError = utl_removeLink( SEM_BLOCKED_LIST( gpt_currentSem),
                                              t_curr);
 
                t_linkError = utl_insertLink( gt_activeThreads,
@@ -797,17 +806,17 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
        * according to priority.
        *---------------------------------------------------------------------*/
       if( (gpt_currentSem->s_count <= 0) &&
-      (UTL_GET_NUM_LINKS_CONT( gpt_currentSem->t_blockedList) > 0))
+      (UTL_GET_NUM_LINKS_CONT( SEM_BLOCKED_LIST( gpt_currentSem)) > 0))
       {
          /*------------------------------------------------------------------*
           * Find the thread with the highest priority on the blocked
           * list for this semaphore.
           *------------------------------------------------------------------*/
-         t_highest = UTL_GET_HEAD_OF_CONT( gpt_currentSem->t_blockedList);
+         t_highest = UTL_GET_HEAD_OF_CONT( SEM_BLOCKED_LIST( gpt_currentSem));
          pt_temp   = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_highest);
          s_highest = pt_temp->t_priority;
-         UTL_TRAVERSE_CONTAINER_HEAD( t_curr, gpt_currentSem->t_blockedList,\
-         s_count)
+         UTL_TRAVERSE_CONTAINER_HEAD( t_curr,
+         SEM_BLOCKED_LIST( gpt_currentSem), s_count)
          {
             pt_temp = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_curr);
             if( pt_temp->t_priority < s_highest)
@@ -833,7 +842,7 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
             /*---------------------------------------------------------------*
              * Remove the highest priority thread from the blocked list
              *---------------------------------------------------------------*/
-            t_linkError = utl_removeLink( gpt_currentSem->t_blockedList,
+            t_linkError = utl_removeLink( SEM_BLOCKED_LIST( gpt_currentSem),
                                           t_highest);
 
             /*---------------------------------------------------------------*
@@ -856,8 +865,8 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
              * previous ptr to change t_curr back to a valid location once an
              * item has been removed.
              *----------------------------------------------------------------*/
-            UTL_TRAVERSE_CONTAINER_HEAD( t_curr, gpt_currentSem->t_blockedList,\
-            s_count)
+            UTL_TRAVERSE_CONTAINER_HEAD( t_curr,
+            SEM_BLOCKED_LIST( gpt_currentSem), s_count)
             {
                pt_temp = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_curr);
 
@@ -865,7 +874,7 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
 
                t_prevLink = UTL_GET_PREV_LINK( t_curr);
 
-               t_linkError = utl_removeLink( gpt_currentSem->t_blockedList,
+               t_linkError = utl_removeLink( SEM_BLOCKED_LIST( gpt_currentSem),
                                              t_curr);
 
                t_linkError = utl_insertLink( gt_activeThreads,
@@ -929,6 +938,87 @@ t_error arb_signal( t_SEMHANDLE t_semHandle)
 
 }/*End arb_signal( t_SEMHANDLE *pt_semHandle)*/
 
+void arb_signalFromTick( t_SEMHANDLE t_semHandle)
+{
+   t_LINKHNDL t_curr;
+   t_LINKHNDL t_highest;
+   t_LINKHNDL t_prevLink;
+   uint16_t s_count;
+   uint16_t s_highest;
+   t_tcb *pt_temp;
+
+   /*------------------------------------------------------------------------*
+    * Called with interrupts off from the system timer interrupt, after the
+    * current thread has been saved and the kernel stack switched in. The
+    * woken threads are only put back on the active list, the scheduler
+    * call that follows decides who runs next.
+    *------------------------------------------------------------------------*/
+   if( UTL_IS_LINK_ON_LIST( (t_LINKHNDL)t_semHandle, gt_activeSems) ==
+   false)
+   {
+      return;
+   }
+
+   gpt_currentSem = (t_semaphore *)UTL_GET_LINK_ELEMENT_PTR( (t_LINKHNDL)\
+   t_semHandle);
+
+   gpt_currentSem->s_count++;
+
+   if( (gpt_currentSem->s_count > 0) ||
+   (UTL_GET_NUM_LINKS_CONT( SEM_BLOCKED_LIST( gpt_currentSem)) == 0))
+   {
+      return;
+   }
+
+   if( gpt_currentSem->t_type != SIGNAL) /*Remove highest...*/
+   {
+      t_highest = UTL_GET_HEAD_OF_CONT( SEM_BLOCKED_LIST( gpt_currentSem));
+      pt_temp   = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_highest);
+      s_highest = pt_temp->t_priority;
+      UTL_TRAVERSE_CONTAINER_HEAD( t_curr,
+      SEM_BLOCKED_LIST( gpt_currentSem), s_count)
+      {
+         pt_temp = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_curr);
+         if( pt_temp->t_priority < s_highest)
+         {
+            s_highest = pt_temp->t_priority;
+            t_highest = t_curr;
+         }
+      }
+
+      pt_temp = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_highest);
+      pt_temp->t_status = READY;
+
+      gt_linkError = utl_removeLink( SEM_BLOCKED_LIST( gpt_currentSem),
+                                     t_highest);
+      gt_linkError = utl_insertLink( gt_activeThreads,
+                                     t_highest,
+                                     true);
+
+   }/*End if( gpt_currentSem->t_type != SIGNAL)*/
+   else /*SIGNAL...remove all*/
+   {
+      UTL_TRAVERSE_CONTAINER_HEAD( t_curr,
+      SEM_BLOCKED_LIST( gpt_currentSem), s_count)
+      {
+         pt_temp = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_curr);
+         pt_temp->t_status = READY;
+         t_prevLink = UTL_GET_PREV_LINK( t_curr);
+
+         gt_linkError = utl_removeLink( SEM_BLOCKED_LIST( gpt_currentSem),
+                                        t_curr);
+         gt_linkError = utl_insertLink( gt_activeThreads,
+                                        t_curr,
+                                        true);
+         t_curr = t_prevLink;
+      }
+
+      gpt_currentSem->s_count = 0;
+
+   }
+
+}/*End arb_signalFromTick*/
+
 t_SEMHANDLE arb_semaphoreCreate( t_semType t_type)
 {
    t_semaphore *pt_newSem;
@@ -971,14 +1061,7 @@ t_SEMHANDLE arb_semaphoreCreate( t_semType t_type)
     * Each semaphore contains a blocked list where threads waiting on the
     * semaphore will be stored.
     *------------------------------------------------------------------------*/
-   pt_newSem->t_blockedList = utl_createContainer();
-   if( pt_newSem->t_blockedList < 0)
-   {
-      t_err = utl_destroyLink( gt_activeSems,
-                               t_linkHndl);
-      HAL_END_CRITICAL();//Enable interrupts
-      return (t_SEMHANDLE)ARB_OUT_OF_HEAP;
-   }
+   utl_initContainer( &pt_newSem->t_blockedList);
 
    /*------------------------------------------------------------------------*
     * Are we a SIGNAL or COUNTING semaphore?
@@ -1042,7 +1125,7 @@ t_error arb_semaphoreDestroy( t_SEMHANDLE t_semHandle)
     * resolved by using a previous ptr to change t_curr back to a valid
     * location once an item has been removed.
     *------------------------------------------------------------------------*/
-   UTL_TRAVERSE_CONTAINER_HEAD( t_curr, pt_sem->t_blockedList, s_count)
+   UTL_TRAVERSE_CONTAINER_HEAD( t_curr, SEM_BLOCKED_LIST( pt_sem), s_count)
    {
       pt_temp = (t_tcb *)UTL_GET_LINK_ELEMENT_PTR( t_curr);
 
@@ -1050,7 +1133,7 @@ t_error arb_semaphoreDestroy( t_SEMHANDLE t_semHandle)
 
       t_prevLink = UTL_GET_PREV_LINK( t_curr);
 
-      t_err = utl_removeLink( pt_sem->t_blockedList,
+      t_err = utl_removeLink( SEM_BLOCKED_LIST( pt_sem),
                               t_curr);
 
       t_err = utl_insertLink( gt_activeThreads,
@@ -1059,11 +1142,6 @@ t_error arb_semaphoreDestroy( t_SEMHANDLE t_semHandle)
       t_curr = t_prevLink;
    }
 
-   /*------------------------------------------------------------------------*
-    * Destroy the blocked list for this semaphore.
-    *------------------------------------------------------------------------*/
-   t_err = utl_destroyContainer( pt_sem->t_blockedList);
-
    /*------------------------------------------------------------------------*
     * Destroy the semaphore
     *------------------------------------------------------------------------*/
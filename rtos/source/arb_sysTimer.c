@@ -31,10 +31,10 @@
 #include "arb_sysTimer.h"
 #include "arb_thread.h"
 #include "arb_scheduler.h"
+#include "arb_dispatcher.h"
 #include "hal_timer.h"
 #include "arb_printf.h"
 #include "hal_pmic.h"
-#include "hal_gpio.h"
 #include "hal_contextSwitch.h"
 
 /*---------------------------------------------------------------------------*
@@ -50,7 +50,7 @@ t_sysTime gt_sysTime = {0,0,0,0,0};
  * Private Function Prototypes
  *---------------------------------------------------------------------------*/
 static void updateSystemTime( void);
-static void sysTimerInterrupt( void) __attribute__ ( ( naked, noinline ) );
+static void sysTimerInterrupt( void) HAL_NAKED_FUNC;
 
 /*---------------------------------------------------------------------------*
  * Private Global Variables
@@ -157,6 +157,12 @@ static void sysTimerInterrupt( void)
     *------------------------------------------------------------------------*/
    arb_updateSleepingThreads();
 
+   /*------------------------------------------------------------------------*
+    * Count down the time events of the active objects, any that expire are
+    * posted to the dispatcher before the scheduler runs.
+    *------------------------------------------------------------------------*/
+   arb_dispatcherTick();
+
    /*------------------------------------------------------------------------*
     * See if there is a higher priority thread ready to run.
     *------------------------------------------------------------------------*/
@@ -74,9 +74,9 @@ static void arb_threadInit( t_tcb **pt_newTcb,
                             t_stackSize t_stack,
                             t_thrdPrio t_priority);
 
-static void arb_yieldFromSleepIntsOn( void) __attribute__ ( ( naked, noinline ) );
+static void arb_yieldFromSleepIntsOn( void) HAL_NAKED_FUNC;
 
-static void arb_yieldFromSleepIntsOff( void) __attribute__ ( ( naked, noinline ) );
+static void arb_yieldFromSleepIntsOff( void) HAL_NAKED_FUNC;
 
 /*---------------------------------------------------------------------------*
  * Private Global Variables
@@ -219,7 +219,7 @@ static void arb_threadInit( t_tcb **pt_newTcb,
    /*------------------------------------------------------------------------*
     * Save the starting address of the stack
     *------------------------------------------------------------------------*/
-   (*pt_newTcb)->s_stackStart = (uint16_t)pc_stackPtr;
+   (*pt_newTcb)->s_stackStart = (uintptr_t)pc_stackPtr;
 
    /*------------------------------------------------------------------------*
     * Point to the last byte in the stack
@@ -229,7 +229,7 @@ static void arb_threadInit( t_tcb **pt_newTcb,
    /*------------------------------------------------------------------------*
     * Save the ending address of the stack
     *------------------------------------------------------------------------*/
-   (*pt_newTcb)->s_stackEnd = (uint16_t)pc_stackPtr;
+   (*pt_newTcb)->s_stackEnd = (uintptr_t)pc_stackPtr;
 
    /*------------------------------------------------------------------------*
     * Store the new thread's priority
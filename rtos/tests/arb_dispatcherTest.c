@@ -0,0 +1,539 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : arb_dispatcherTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of arb_dispatcher, run on the POSIX HAL with the
+ *               real scheduler and system tick. The test thread sits above
+ *               the dispatcher, so everything it posts piles up until it
+ *               sleeps, and the order the run actions were called in shows
+ *               how the dispatcher picked the events. Covers priority order,
+ *               FIFO order and a full queue, dropped transitions, time
+ *               events that fire, are disarmed, or go stale in the queue,
+ *               and removing an object with events pending.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "arb_scheduler.h"
+#include "arb_printf.h"
+#include "arb_dispatcher.h"
+#include "drv_console.h"
+#include "hal_pmic.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_PRIO       (1)
+#define TEST_DSP_PRIO   (2)
+#define TEST_MAX_TRACE  (32)
+
+/*---------------------------------------------------------------------------*
+ * Longest the test waits for the dispatcher to catch up, in system ticks.
+ *---------------------------------------------------------------------------*/
+#define TEST_WAIT_TICKS (200)
+
+/*---------------------------------------------------------------------------*
+ * States shared by every object in the test.
+ *---------------------------------------------------------------------------*/
+#define ST_IDLE    (0)
+#define ST_A       (1)
+#define ST_B       (2)
+#define ST_TIMEOUT (3)
+#define ST_NUM     (4)
+
+/*---------------------------------------------------------------------------*
+ * Event data is 'object * TEST_OBJ_DATA + sequence', so the trace shows
+ * which object an action ran for.
+ *---------------------------------------------------------------------------*/
+#define TEST_OBJ_DATA   (1000)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   uint8_t c_state;
+   int32_t i_data;
+
+}t_traceEntry;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void testRun( int32_t i_data,
+                     uint8_t c_prevState);
+static void testRunIdle( int32_t i_data,
+                         uint8_t c_prevState);
+static void testRunA( int32_t i_data,
+                      uint8_t c_prevState);
+static void testRunB( int32_t i_data,
+                      uint8_t c_prevState);
+static void testRunTimeout( int32_t i_data,
+                            uint8_t c_prevState);
+static bool waitTrace( uint8_t c_length);
+static bool traceIs( const t_traceEntry *pt_expect,
+                     uint8_t c_length,
+                     const char *pc_what);
+static void testThread( t_parameters t_param,
+                        t_arguments t_args);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Written by the run actions on the dispatcher thread, read by the test
+ * thread once the dispatcher has caught up.
+ *---------------------------------------------------------------------------*/
+static t_traceEntry gat_trace[TEST_MAX_TRACE];
+static volatile uint8_t gc_traceLen = 0;
+
+/*---------------------------------------------------------------------------*
+ * Set by the run action so 'testRun' knows which state it is recording.
+ *---------------------------------------------------------------------------*/
+static uint8_t gc_runState;
+
+static t_activeObject gat_objects[4];
+
+UTL_STMN_CREATE_TABLE( gat_testStates, ST_NUM) =
+{
+   [ST_IDLE]    = UTL_STMN_STATE( &testRunIdle, NULL, NULL, UTL_STMN_NO_STATE,
+                                  UTL_STMN_TRANS( ST_IDLE) |
+                                  UTL_STMN_TRANS( ST_A) |
+                                  UTL_STMN_TRANS( ST_B) |
+                                  UTL_STMN_TRANS( ST_TIMEOUT)),
+   [ST_A]       = UTL_STMN_STATE( &testRunA, NULL, NULL, UTL_STMN_NO_STATE,
+                                  UTL_STMN_TRANS( ST_IDLE) |
+                                  UTL_STMN_TRANS( ST_A) |
+                                  UTL_STMN_TRANS( ST_B) |
+                                  UTL_STMN_TRANS( ST_TIMEOUT)),
+   [ST_B]       = UTL_STMN_STATE( &testRunB, NULL, NULL, UTL_STMN_NO_STATE,
+                                  UTL_STMN_TRANS( ST_IDLE) |
+                                  UTL_STMN_TRANS( ST_TIMEOUT)),
+   [ST_TIMEOUT] = UTL_STMN_STATE( &testRunTimeout, NULL, NULL,
+                                  UTL_STMN_NO_STATE,
+                                  UTL_STMN_TRANS( ST_IDLE) |
+                                  UTL_STMN_TRANS( ST_A))
+};
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void testRun( int32_t i_data,
+                     uint8_t c_prevState)
+{
+   if( gc_traceLen < TEST_MAX_TRACE)
+   {
+      gat_trace[gc_traceLen].c_state = gc_runState;
+      gat_trace[gc_traceLen].i_data  = i_data;
+      gc_traceLen++;
+   }
+
+}/*End testRun*/
+
+static void testRunIdle( int32_t i_data,
+                         uint8_t c_prevState)
+{
+   gc_runState = ST_IDLE;
+   testRun( i_data, c_prevState);
+}/*End testRunIdle*/
+
+static void testRunA( int32_t i_data,
+                      uint8_t c_prevState)
+{
+   gc_runState = ST_A;
+   testRun( i_data, c_prevState);
+}/*End testRunA*/
+
+static void testRunB( int32_t i_data,
+                      uint8_t c_prevState)
+{
+   gc_runState = ST_B;
+   testRun( i_data, c_prevState);
+}/*End testRunB*/
+
+static void testRunTimeout( int32_t i_data,
+                            uint8_t c_prevState)
+{
+   gc_runState = ST_TIMEOUT;
+   testRun( i_data, c_prevState);
+}/*End testRunTimeout*/
+
+/*---------------------------------------------------------------------------*
+ * Sleeps until the trace holds 'c_length' entries, giving the dispatcher
+ * the processor.
+ *---------------------------------------------------------------------------*/
+static bool waitTrace( uint8_t c_length)
+{
+   uint16_t s_ticks;
+
+   for( s_ticks = 0; (s_ticks < TEST_WAIT_TICKS) && (gc_traceLen <
+   c_length); s_ticks++)
+   {
+      arb_sleep( 1);
+   }
+
+   return (bool)(gc_traceLen >= c_length);
+
+}/*End waitTrace*/
+
+static bool traceIs( const t_traceEntry *pt_expect,
+                     uint8_t c_length,
+                     const char *pc_what)
+{
+   uint8_t c_index;
+   bool b_match = waitTrace( c_length);
+
+   /*------------------------------------------------------------------------*
+    * Nothing more should show up after the expected entries.
+    *------------------------------------------------------------------------*/
+   arb_sleep( 2);
+   b_match = b_match && (gc_traceLen == c_length);
+
+   for( c_index = 0; b_match && (c_index < c_length); c_index++)
+   {
+      b_match = (gat_trace[c_index].c_state == pt_expect[c_index].c_state) &&
+                (gat_trace[c_index].i_data == pt_expect[c_index].i_data);
+   }
+
+   if( b_match == false)
+   {
+      printf( "%s\n  got:     ", pc_what);
+      for( c_index = 0; c_index < gc_traceLen; c_index++)
+      {
+         printf( "%u/%d ",
+                 gat_trace[c_index].c_state,
+                 (int)gat_trace[c_index].i_data);
+      }
+
+      printf( "\n  expected: ");
+      for( c_index = 0; c_index < c_length; c_index++)
+      {
+         printf( "%u/%d ",
+                 pt_expect[c_index].c_state,
+                 (int)pt_expect[c_index].i_data);
+      }
+
+      printf( "\n");
+   }
+
+   gc_traceLen = 0;
+
+   return b_match;
+
+}/*End traceIs*/
+
+static void testThread( t_parameters t_param,
+                        t_arguments t_args)
+{
+   t_activeObject t_extra;
+   uint8_t c_obj;
+   uint8_t c_index;
+   t_error t_err;
+
+   /*------------------------------------------------------------------------*
+    * Objects 0, 1 and 3 at the priority of their index, object 2 is left
+    * out so the dispatcher has a gap to skip.
+    *------------------------------------------------------------------------*/
+   for( c_obj = 0; c_obj < 4; c_obj++)
+   {
+      utl_stMnInit( &gat_objects[c_obj].t_stMn,
+                    gat_testStates,
+                    ST_NUM,
+                    ST_IDLE);
+
+      if( c_obj != 2)
+      {
+         UTL_TEST_CHECK( arb_activeObjectRegister( &gat_objects[c_obj],
+                         c_obj) == ARB_PASSED,
+                         "object %u refused",
+                         c_obj);
+      }
+   }
+
+   /*------------------------------------------------------------------------*
+    * Registration errors.
+    *------------------------------------------------------------------------*/
+   memset( (void *)&t_extra, 0, sizeof( t_extra));
+   utl_stMnInit( &t_extra.t_stMn, gat_testStates, ST_NUM, ST_IDLE);
+   UTL_TEST_CHECK( arb_activeObjectRegister( &t_extra, 0) ==
+                   ARB_INVALID_PRIORITY,
+                   "shared priority accepted");
+   UTL_TEST_CHECK( arb_activeObjectRegister( &t_extra, ARB_DSP_MAX_OBJECTS)
+                   == ARB_INVALID_ARG,
+                   "priority %u accepted",
+                   ARB_DSP_MAX_OBJECTS);
+   UTL_TEST_CHECK( arb_activeObjectRegister( NULL, 4) == ARB_NULL_PTR,
+                   "NULL object accepted");
+
+   /*------------------------------------------------------------------------*
+    * Posted lowest priority first, dispatched highest priority first.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_A, 0*TEST_OBJ_DATA + 1},
+         {ST_A, 1*TEST_OBJ_DATA + 1},
+         {ST_A, 3*TEST_OBJ_DATA + 1}
+      };
+
+      arb_activeObjectPost( &gat_objects[3], ST_A, 3*TEST_OBJ_DATA + 1);
+      arb_activeObjectPost( &gat_objects[1], ST_A, 1*TEST_OBJ_DATA + 1);
+      arb_activeObjectPost( &gat_objects[0], ST_A, 0*TEST_OBJ_DATA + 1);
+
+      UTL_TEST_CHECK( traceIs( at_expect, 3, "priority order"),
+                      "priority order");
+   }
+
+   /*------------------------------------------------------------------------*
+    * One object's events come out in the order they went in, and the
+    * queue holds ARB_DSP_QUEUE_SIZE of them.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_B, 2},
+         {ST_IDLE, 3},
+         {ST_A, 4},
+         {ST_A, 5}
+      };
+
+      for( c_index = 0; c_index < ARB_DSP_QUEUE_SIZE; c_index++)
+      {
+         t_err = arb_activeObjectPost( &gat_objects[0],
+                                       at_expect[c_index].c_state,
+                                       at_expect[c_index].i_data);
+         UTL_TEST_CHECK( t_err == ARB_PASSED,
+                         "post %u refused",
+                         c_index);
+      }
+
+      UTL_TEST_CHECK( arb_activeObjectPost( &gat_objects[0], ST_B, 6) ==
+                      ARB_MBX_FULL,
+                      "post to a full queue accepted");
+
+      UTL_TEST_CHECK( traceIs( at_expect, ARB_DSP_QUEUE_SIZE, "FIFO order"),
+                      "FIFO order");
+   }
+
+   /*------------------------------------------------------------------------*
+    * B -> A isn't in the table, that event is dropped and the machine
+    * stays in B.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_B, 7},
+         {ST_IDLE, 9}
+      };
+
+      arb_activeObjectPost( &gat_objects[0], ST_B, 7);
+      arb_activeObjectPost( &gat_objects[0], ST_A, 8);
+      arb_activeObjectPost( &gat_objects[0], ST_IDLE, 9);
+
+      UTL_TEST_CHECK( traceIs( at_expect, 2, "dropped transition"),
+                      "dropped transition");
+   }
+
+   /*------------------------------------------------------------------------*
+    * A time event arrives as its state with no data.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_TIMEOUT, 0}
+      };
+
+      arb_activeObjectArmTimeout( &gat_objects[1], 3, ST_TIMEOUT);
+
+      UTL_TEST_CHECK( traceIs( at_expect, 1, "time event"), "time event");
+   }
+
+   /*------------------------------------------------------------------------*
+    * Disarmed before it expires, only the event posted afterwards shows up.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_IDLE, 1*TEST_OBJ_DATA + 2}
+      };
+
+      arb_activeObjectArmTimeout( &gat_objects[1], 5, ST_TIMEOUT);
+      arb_activeObjectArmTimeout( &gat_objects[1], 0, ST_TIMEOUT);
+      arb_sleep( 10);
+      arb_activeObjectPost( &gat_objects[1], ST_IDLE, 1*TEST_OBJ_DATA + 2);
+
+      UTL_TEST_CHECK( traceIs( at_expect, 1, "disarmed time event"),
+                      "disarmed time event");
+   }
+
+   /*------------------------------------------------------------------------*
+    * Expired and queued, but disarmed before the dispatcher got to it. The
+    * dispatcher sits below this thread, so spinning keeps it from running
+    * while the tick still comes in.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_A, 1*TEST_OBJ_DATA + 3}
+      };
+
+      arb_activeObjectArmTimeout( &gat_objects[1], 1, ST_TIMEOUT);
+      while( gat_objects[1].s_timeout != 0);
+      arb_activeObjectArmTimeout( &gat_objects[1], 0, ST_TIMEOUT);
+      arb_activeObjectPost( &gat_objects[1], ST_A, 1*TEST_OBJ_DATA + 3);
+
+      UTL_TEST_CHECK( traceIs( at_expect, 1, "stale time event"),
+                      "stale time event");
+   }
+
+   /*------------------------------------------------------------------------*
+    * Re-armed after it expired: of the two time events queued, only one
+    * may reach the machine.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_TIMEOUT, 0},
+         {ST_IDLE, 1*TEST_OBJ_DATA + 4}
+      };
+
+      arb_activeObjectArmTimeout( &gat_objects[1], 1, ST_TIMEOUT);
+      while( gat_objects[1].s_timeout != 0);
+      arb_activeObjectArmTimeout( &gat_objects[1], 1, ST_TIMEOUT);
+      while( gat_objects[1].s_timeout != 0);
+      arb_activeObjectPost( &gat_objects[1], ST_IDLE, 1*TEST_OBJ_DATA + 4);
+
+      UTL_TEST_CHECK( traceIs( at_expect, 2, "re-armed time event"),
+                      "re-armed time event");
+   }
+
+   /*------------------------------------------------------------------------*
+    * Re-armed for a different state and fired again before the first time
+    * event was dispatched: the first one is stale even though a time event
+    * has fired since, only the second state may show up.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_TIMEOUT, 0},
+         {ST_IDLE, 1*TEST_OBJ_DATA + 5}
+      };
+
+      arb_activeObjectArmTimeout( &gat_objects[1], 1, ST_A);
+      while( gat_objects[1].s_timeout != 0);
+      arb_activeObjectArmTimeout( &gat_objects[1], 1, ST_TIMEOUT);
+      while( gat_objects[1].s_timeout != 0);
+      arb_activeObjectPost( &gat_objects[1], ST_IDLE, 1*TEST_OBJ_DATA + 5);
+
+      UTL_TEST_CHECK( traceIs( at_expect, 2, "re-armed and fired twice"),
+                      "re-armed and fired twice");
+   }
+
+   /*------------------------------------------------------------------------*
+    * Removing an object throws away what it had queued, the dispatcher has
+    * to skip the semaphore counts they leave behind.
+    *------------------------------------------------------------------------*/
+   {
+      static const t_traceEntry at_expect[] =
+      {
+         {ST_A, 0*TEST_OBJ_DATA + 10}
+      };
+
+      arb_activeObjectPost( &gat_objects[3], ST_B, 3*TEST_OBJ_DATA + 2);
+      arb_activeObjectPost( &gat_objects[3], ST_IDLE, 3*TEST_OBJ_DATA + 3);
+      UTL_TEST_CHECK( arb_activeObjectRemove( &gat_objects[3]) == ARB_PASSED,
+                      "remove refused");
+      UTL_TEST_CHECK( arb_activeObjectPost( &gat_objects[3], ST_A, 0) ==
+                      ARB_INVALID_HANDLE,
+                      "post to a removed object accepted");
+      UTL_TEST_CHECK( arb_activeObjectRemove( &gat_objects[3]) ==
+                      ARB_INVALID_HANDLE,
+                      "object removed twice");
+      arb_activeObjectPost( &gat_objects[0], ST_A, 0*TEST_OBJ_DATA + 10);
+
+      UTL_TEST_CHECK( traceIs( at_expect, 1, "removed object"),
+                      "removed object");
+   }
+
+   /*------------------------------------------------------------------------*
+    * Leave with interrupts off so nothing gets switched in while libc is
+    * tearing the process down.
+    *------------------------------------------------------------------------*/
+   t_err = (t_error)UTL_TEST_RESULT();
+   HAL_CLI();
+   exit( t_err);
+
+}/*End testThread*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+void usr_appInit( void)
+{
+   t_consoleSetup t_conSetup;
+
+   t_conSetup.c_uartId   = UART_1;
+   t_conSetup.i_baudRate = 115200;
+   t_conSetup.c_majorNum = 1;
+
+   if( drv_consoleInit( t_conSetup) < 0)
+      exit(1);
+
+   if( arb_printfInit( "consoleDevice0",
+                       256,
+                       NULL) < 0)
+   {
+      exit(1);
+   }
+
+   if( arb_schedulerInit( PRIORITY,
+                          ARB_STACK_512B,
+                          TIMER_7) < 0)
+   {
+      exit(1);
+   }
+
+   if( arb_dispatcherInit( ARB_STACK_512B,
+                           TEST_DSP_PRIO) < 0)
+   {
+      exit(1);
+   }
+
+   /*------------------------------------------------------------------------*
+    * The failure reports go through the host printf, which needs far more
+    * stack than anything the dispatcher runs.
+    *------------------------------------------------------------------------*/
+   if( arb_threadCreate( testThread,
+                         0,
+                         0,
+                         ARB_STACK_4096B,
+                         TEST_PRIO) < 0)
+   {
+      exit(1);
+   }
+
+}/*End usr_appInit*/
@@ -0,0 +1,172 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_bench.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : A microbenchmark harness built on the HAL's cycle counter.
+ *               A case is a function that runs the code under test a given
+ *               number of times. Every sample times one call to it, less
+ *               the fixed cost of timing an empty call (measured once by
+ *               'utl_benchInit'). After the warmup calls are discarded, the
+ *               min, median and max of the samples are reported in cycles
+ *               per iteration as CSV lines a script can pick out of the
+ *               console output.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_bench_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define utl_bench_h
+
+   /*------------------------------------------------------------------------*
+    * Most samples a case can take, they are kept on the caller's stack.
+    *------------------------------------------------------------------------*/
+   #define UTL_BENCH_MAX_SAMPLES (32)
+
+   /*------------------------------------------------------------------------*
+    * Smallest buffer the format functions accept, names are cut off at
+    * UTL_BENCH_MAX_NAME characters so a line always fits.
+    *------------------------------------------------------------------------*/
+   #define UTL_BENCH_LINE_BYTES (96)
+   #define UTL_BENCH_MAX_NAME   (24)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+
+      BENCH_BUFFER_TOO_SMALL = -4, /*Less than UTL_BENCH_LINE_BYTES*/
+      BENCH_COUNTER_BUSY     = -3, /*The cycle counter couldn't be started*/
+      BENCH_INVALID_SAMPLES  = -2, /*No samples or more than the max*/
+      BENCH_NULL_PTR         = -1, /*Pointer is not mapped to a valid
+                                     address*/
+      BENCH_PASSED           = 0   /*Configuration good.*/
+
+   }t_benchError;
+
+   typedef struct
+   {
+      /*---------------------------------------------------------------------*
+       * Name the case is reported under, no commas.
+       *---------------------------------------------------------------------*/
+      const char *pc_name;
+
+      /*---------------------------------------------------------------------*
+       * Runs the code under test 's_iterations' times.
+       *---------------------------------------------------------------------*/
+      void (*pf_run)( void *pv_arg,
+                      uint16_t s_iterations);
+
+      /*---------------------------------------------------------------------*
+       * Passed through to 'pf_run'.
+       *---------------------------------------------------------------------*/
+      void *pv_arg;
+
+      /*---------------------------------------------------------------------*
+       * Iterations timed by each sample.
+       *---------------------------------------------------------------------*/
+      uint16_t s_iterations;
+
+      /*---------------------------------------------------------------------*
+       * Calls thrown away before sampling starts, they warm the caches on
+       * the host and fill the heap and queues to their steady state.
+       *---------------------------------------------------------------------*/
+      uint8_t c_warmup;
+
+      /*---------------------------------------------------------------------*
+       * Number of samples taken, 1 to UTL_BENCH_MAX_SAMPLES.
+       *---------------------------------------------------------------------*/
+      uint8_t c_samples;
+
+   }t_benchCase;
+
+   typedef struct
+   {
+      /*---------------------------------------------------------------------*
+       * Cycles per sample with the timing overhead removed.
+       *---------------------------------------------------------------------*/
+      uint32_t i_min;
+      uint32_t i_median;
+      uint32_t i_max;
+
+      /*---------------------------------------------------------------------*
+       * Overhead that was subtracted from every sample.
+       *---------------------------------------------------------------------*/
+      uint32_t i_overhead;
+
+      uint16_t s_iterations;
+      uint8_t c_samples;
+
+   }t_benchResult;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Starts the cycle counter and measures the timing overhead.
+    *------------------------------------------------------------------------*/
+   t_benchError utl_benchInit( void);
+
+   t_benchError utl_benchRun( const t_benchCase *pt_case,
+                              t_benchResult *pt_result);
+
+   /*------------------------------------------------------------------------*
+    * The two lines that start a report, the counter rate and the column
+    * names. Both begin with '#'. Returns the number of characters written
+    * to 'pc_buff' or a negative t_benchError.
+    *------------------------------------------------------------------------*/
+   int16_t utl_benchFormatHeader( char *pc_buff,
+                                  uint16_t s_size);
+
+   /*------------------------------------------------------------------------*
+    * One report line, 'name,iterations,samples,min,median,max' with the
+    * statistics in cycles per iteration to one decimal place.
+    *------------------------------------------------------------------------*/
+   int16_t utl_benchFormatResult( const t_benchCase *pt_case,
+                                  const t_benchResult *pt_result,
+                                  char *pc_buff,
+                                  uint16_t s_size);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef utl_bench_h*/
@@ -20,9 +20,13 @@
  *               <https://code.google.com/p/arbitros/>
  *
  * Description : This file provides and abstraction layer for the creation and
- *               control over circular buffers.
+ *               control over circular buffers. A buffer is a plain struct
+ *               owned by the caller (usually a static variable or a member of
+ *               a driver's device structure), and the per-byte operations
+ *               are inlined so they can be used from an ISR without a
+ *               function call.
  *
- * Last Update : Dec 3, 2011
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 #ifndef utl_buffer_h
 
@@ -35,10 +39,19 @@
     *------------------------------------------------------------------------*/
    #define utl_buffer_h
 
+   /*------------------------------------------------------------------------*
+    * If defined, every buffer passed to 'utl_initBuffer' or
+    * 'utl_createBuffer' is kept on a list that can be walked from a
+    * debugger (or 'utl_getBufferList') for checking fill levels. Costs an
+    * extra pointer per buffer.
+    *------------------------------------------------------------------------*/
+   //#define UTL_BUFFER_DEBUG
+
    /*------------------------------------------------------------------------*
     * Include Files
     *------------------------------------------------------------------------*/
    #include "avr_compiler.h"
+   #include "hal_pmic.h"
 
    /*------------------------------------------------------------------------*
     * Global Typedefs
@@ -53,7 +66,50 @@
 
    }t_bufferError;
 
-   typedef volatile int16_t t_BUFFHANDLE; /*Handle to an 8-bit buffer*/
+   typedef struct t_buffer
+   {
+
+      /*---------------------------------------------------------------------*
+       * Location where the next element will be added to the buffer.
+       *---------------------------------------------------------------------*/
+      volatile int16_t s_wrIndex;
+
+      /*---------------------------------------------------------------------*
+       * Location where the next element will be read from the buffer.
+       *---------------------------------------------------------------------*/
+      volatile int16_t s_rdIndex;
+
+      /*---------------------------------------------------------------------*
+       * The number of elements in the buffer. When s_fillCount < 0 the
+       * consuming process has underflowed the buffer or read too many
+       * elements. When s_fillCount > s_sizeBytes the producing process has
+       * overflowed the buffer or wrote too many words.
+       *---------------------------------------------------------------------*/
+      volatile int16_t s_fillCount;
+
+      /*---------------------------------------------------------------------*
+       * The size of the buffer in 8-bit words
+       *---------------------------------------------------------------------*/
+      uint16_t s_sizeBytes;
+
+      /*---------------------------------------------------------------------*
+       * Pointer to the circular buffer
+       *---------------------------------------------------------------------*/
+      int8_t *pc_buffer;
+
+      /*---------------------------------------------------------------------*
+       * If true, 'pc_buffer' was allocated by 'utl_createBuffer'.
+       *---------------------------------------------------------------------*/
+      bool b_onHeap;
+
+#ifdef UTL_BUFFER_DEBUG
+      /*---------------------------------------------------------------------*
+       * Next buffer on the debug list.
+       *---------------------------------------------------------------------*/
+      struct t_buffer *pt_next;
+#endif
+
+   }t_buffer;
 
    /*------------------------------------------------------------------------*
     * Global Variables
@@ -62,59 +118,216 @@
    /*------------------------------------------------------------------------*
     * Global Inline functions
     *------------------------------------------------------------------------*/
+   static inline int16_t __attribute__((always_inline)) \
+   utl_getBufferFullLevel( t_buffer *pt_buffer)
+   {
+      return pt_buffer->s_fillCount; /*Return the number of bytes in the
+                                       buffer*/
+   }/*End utl_getBufferFullLevel*/
+
+   static inline int16_t __attribute__((always_inline)) \
+   utl_getBufferEmptyLevel( t_buffer *pt_buffer)
+   {
+      /*---------------------------------------------------------------------*
+       * Return the number of bytes of space left in the buffer.
+       *---------------------------------------------------------------------*/
+      return ((int16_t)pt_buffer->s_sizeBytes - pt_buffer->s_fillCount);
+   }/*End utl_getBufferEmptyLevel*/
+
+   static inline int16_t __attribute__((always_inline)) \
+   utl_getBufferSize( t_buffer *pt_buffer)
+   {
+      return ((int16_t)pt_buffer->s_sizeBytes);
+   }/*End utl_getBufferSize*/
+
+   static inline bool __attribute__((always_inline)) \
+   utl_isBufferFull( t_buffer *pt_buffer)
+   {
+      return (bool)(pt_buffer->s_fillCount ==
+      (int16_t)pt_buffer->s_sizeBytes);
+   }/*End utl_isBufferFull*/
+
+   static inline bool __attribute__((always_inline)) \
+   utl_isBufferEmpty( t_buffer *pt_buffer)
+   {
+      return (bool)(pt_buffer->s_fillCount == 0);
+   }/*End utl_isBufferEmpty*/
+
+   static inline bool __attribute__((always_inline)) \
+   utl_hasBufferOverflowed( t_buffer *pt_buffer)
+   {
+      return (bool)(pt_buffer->s_fillCount >
+      (int16_t)pt_buffer->s_sizeBytes);
+   }/*End utl_hasBufferOverflowed*/
+
+   static inline bool __attribute__((always_inline)) \
+   utl_hasBufferUnderflowed( t_buffer *pt_buffer)
+   {
+      return (bool)(pt_buffer->s_fillCount < 0);
+   }/*End utl_hasBufferUnderflowed*/
 
    /*------------------------------------------------------------------------*
-    * Global Function Prototypes
+    * Adds a byte to the buffer, the caller must make sure there is room.
+    * Only meant to be called from the side that owns the write index (an
+    * ISR or a thread with interrupts disabled).
     *------------------------------------------------------------------------*/
-   t_BUFFHANDLE utl_createBuffer( int16_t s_sizeBytes);
+   static inline void __attribute__((always_inline)) \
+   utl_writeByte( t_buffer *pt_buffer,
+                  int8_t c_byte)
+   {
+      int16_t s_wrIndex = pt_buffer->s_wrIndex;
 
-   t_bufferError utl_destroyBuffer( t_BUFFHANDLE t_handle);
+      pt_buffer->pc_buffer[s_wrIndex] = c_byte;
+      s_wrIndex++;
+      if( s_wrIndex == (int16_t)pt_buffer->s_sizeBytes)
+         s_wrIndex = 0;
 
-   bool utl_isBufferFull( t_BUFFHANDLE t_handle);
+      pt_buffer->s_wrIndex = s_wrIndex;
+      pt_buffer->s_fillCount++;
 
-   bool utl_isBufferEmpty( t_BUFFHANDLE t_handle);
+   }/*End utl_writeByte*/
 
-   bool utl_hasBufferOverflowed( t_BUFFHANDLE t_handle);
+   static inline int8_t __attribute__((always_inline)) \
+   utl_readByte( t_buffer *pt_buffer)
+   {
+      int16_t s_rdIndex = pt_buffer->s_rdIndex;
+      int8_t c_byte;
 
-   bool utl_hasBufferUnderflowed( t_BUFFHANDLE t_handle);
+      c_byte = pt_buffer->pc_buffer[s_rdIndex];
+      s_rdIndex++;
+      if( s_rdIndex == (int16_t)pt_buffer->s_sizeBytes)
+         s_rdIndex = 0;
 
-   int16_t utl_getBufferFullLevel( t_BUFFHANDLE t_handle);
+      pt_buffer->s_rdIndex = s_rdIndex;
+      pt_buffer->s_fillCount--;
 
-   int16_t utl_getBufferEmptyLevel( t_BUFFHANDLE t_handle);
+      return c_byte;
 
-   int16_t utl_getBufferSize( t_BUFFHANDLE t_handle);
+   }/*End utl_readByte*/
 
-   int8_t *utl_getBufferPtr( t_BUFFHANDLE t_handle);
+   /*------------------------------------------------------------------------*
+    * This function erases a byte at the tail of the buffer.
+    *------------------------------------------------------------------------*/
+   static inline void __attribute__((always_inline)) \
+   utl_buffEraseTailByte( t_buffer *pt_buffer)
+   {
+      int16_t s_wrIndex = pt_buffer->s_wrIndex;
 
-   void utl_writeByte( t_BUFFHANDLE t_handle,
-                       int8_t c_byte);
+      s_wrIndex--;
+      if( s_wrIndex < 0)
+         s_wrIndex = (int16_t)pt_buffer->s_sizeBytes - 1;
 
-   void utl_writeBlock( t_BUFFHANDLE t_handle,
-                        int8_t *pc_buff,
-                        uint16_t s_size);
+      pt_buffer->pc_buffer[s_wrIndex] = 0;
+      pt_buffer->s_wrIndex = s_wrIndex;
+      pt_buffer->s_fillCount--;
 
-   int8_t utl_readByte( t_BUFFHANDLE t_handle);
+   }/*End utl_buffEraseTailByte*/
 
-   void utl_readBlock( t_BUFFHANDLE t_handle,
-                       int8_t *pc_buff,
-                       uint16_t s_size);
+   static inline void __attribute__((always_inline)) \
+   utl_resetBuffer( t_buffer *pt_buffer)
+   {
+      pt_buffer->s_rdIndex   = 0;
+      pt_buffer->s_wrIndex   = 0;
+      pt_buffer->s_fillCount = 0;
+   }/*End utl_resetBuffer*/
 
-   void utl_incrBufWrtPtr( t_BUFFHANDLE t_handle,
-                           uint16_t s_size);
+   /*------------------------------------------------------------------------*
+    * Advances the write index past 's_size' bytes placed in the span
+    * returned by 'utl_getBufferWriteSpan'. The fill count is shared with the
+    * reading side (usually an interrupt), so it is updated atomically.
+    *------------------------------------------------------------------------*/
+   static inline void __attribute__((always_inline)) \
+   utl_commitBufferWrite( t_buffer *pt_buffer,
+                          uint16_t s_size)
+   {
+      int16_t s_wrIndex = pt_buffer->s_wrIndex + (int16_t)s_size;
 
-   void utl_incrBufRdPtr( t_BUFFHANDLE t_handle,
-                          uint16_t s_size);
+      if( s_wrIndex >= (int16_t)pt_buffer->s_sizeBytes)
+         s_wrIndex -= (int16_t)pt_buffer->s_sizeBytes;
 
-   int16_t utl_getBufRdPtr( t_BUFFHANDLE t_handle);
+      pt_buffer->s_wrIndex = s_wrIndex;
 
-   int16_t utl_getBufWrtPtr( t_BUFFHANDLE t_handle);
+      HAL_BEGIN_CRITICAL();
+      pt_buffer->s_fillCount += (int16_t)s_size;
+      HAL_END_CRITICAL();
+
+   }/*End utl_commitBufferWrite*/
 
    /*------------------------------------------------------------------------*
-    * This function erases a byte at the tail of the buffer.
+    * Advances the read index past 's_size' bytes taken from the span
+    * returned by 'utl_getBufferReadSpan'.
     *------------------------------------------------------------------------*/
-   void utl_buffEraseTailByte( t_BUFFHANDLE t_handle);
+   static inline void __attribute__((always_inline)) \
+   utl_commitBufferRead( t_buffer *pt_buffer,
+                         uint16_t s_size)
+   {
+      int16_t s_rdIndex = pt_buffer->s_rdIndex + (int16_t)s_size;
+
+      if( s_rdIndex >= (int16_t)pt_buffer->s_sizeBytes)
+         s_rdIndex -= (int16_t)pt_buffer->s_sizeBytes;
+
+      pt_buffer->s_rdIndex = s_rdIndex;
+
+      HAL_BEGIN_CRITICAL();
+      pt_buffer->s_fillCount -= (int16_t)s_size;
+      HAL_END_CRITICAL();
+
+   }/*End utl_commitBufferRead*/
 
-   void ult_resetBuffer( t_BUFFHANDLE t_handle);
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Attaches 's_sizeBytes' of caller supplied storage to the buffer.
+    *------------------------------------------------------------------------*/
+   t_bufferError utl_initBuffer( t_buffer *pt_buffer,
+                                 int8_t *pc_storage,
+                                 uint16_t s_sizeBytes);
+
+   /*------------------------------------------------------------------------*
+    * Same as 'utl_initBuffer' except the storage is taken from the heap.
+    *------------------------------------------------------------------------*/
+   t_bufferError utl_createBuffer( t_buffer *pt_buffer,
+                                   uint16_t s_sizeBytes);
+
+   /*------------------------------------------------------------------------*
+    * Releases storage allocated by 'utl_createBuffer' (if any) and removes
+    * the buffer from the debug list.
+    *------------------------------------------------------------------------*/
+   void utl_destroyBuffer( t_buffer *pt_buffer);
+
+   void utl_writeBlock( t_buffer *pt_buffer,
+                        int8_t *pc_buff,
+                        uint16_t s_size);
+
+   void utl_readBlock( t_buffer *pt_buffer,
+                       int8_t *pc_buff,
+                       uint16_t s_size);
+
+   /*------------------------------------------------------------------------*
+    * Returns the number of bytes that can be read starting at '*ppc_span'
+    * without wrapping the end of the buffer. Meant for pointing a DMA
+    * channel (or a single block write) at the buffer, follow up with
+    * 'utl_commitBufferRead' once the bytes have been consumed.
+    *------------------------------------------------------------------------*/
+   uint16_t utl_getBufferReadSpan( t_buffer *pt_buffer,
+                                   int8_t **ppc_span);
+
+   /*------------------------------------------------------------------------*
+    * Returns the number of bytes that can be written starting at
+    * '*ppc_span' without wrapping the end of the buffer, follow up with
+    * 'utl_commitBufferWrite' once the bytes have been filled in.
+    *------------------------------------------------------------------------*/
+   uint16_t utl_getBufferWriteSpan( t_buffer *pt_buffer,
+                                    int8_t **ppc_span);
+
+#ifdef UTL_BUFFER_DEBUG
+   /*------------------------------------------------------------------------*
+    * Returns the head of the list of registered buffers.
+    *------------------------------------------------------------------------*/
+   t_buffer *utl_getBufferList( void);
+#endif
 
    #ifdef __cplusplus
    }/*End extern "C"*/
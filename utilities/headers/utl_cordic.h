@@ -0,0 +1,158 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_cordic.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : A fixed-point CORDIC engine. The circular mode rotates a
+ *               vector by an angle (sin/cos) or rotates it onto the x axis
+ *               to find its angle and magnitude in the same pass. The
+ *               hyperbolic mode gives the square root, the natural
+ *               logarithm, and the exponential. Every function is built
+ *               from shifts and adds only, one multiply is used to remove
+ *               the CORDIC gain.
+ *
+ *               The number of iterations and the number of guard bits kept
+ *               below Q15 in the working registers are fixed at compile
+ *               time, override UTL_CORDIC_ITERATIONS and
+ *               UTL_CORDIC_GUARD_BITS on the compiler command line to trade
+ *               accuracy for speed. Each iteration adds about one bit of
+ *               accuracy to the result.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_cordic_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define utl_cordic_h
+
+   /*------------------------------------------------------------------------*
+    * Size of the angle and gain tables.
+    *------------------------------------------------------------------------*/
+   #define UTL_CORDIC_MAX_ITERATIONS (16)
+
+   /*------------------------------------------------------------------------*
+    * Number of iterations, 1 to UTL_CORDIC_MAX_ITERATIONS. The hyperbolic
+    * mode repeats iterations 4 and 13 on top of these in order to converge.
+    *------------------------------------------------------------------------*/
+   #ifndef UTL_CORDIC_ITERATIONS
+      #define UTL_CORDIC_ITERATIONS (14)
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Fractional bits carried below Q15 in the 32-bit working registers,
+    * 0 to 14. They keep the truncation of the shifted terms from building
+    * up over the iterations.
+    *------------------------------------------------------------------------*/
+   #ifndef UTL_CORDIC_GUARD_BITS
+      #define UTL_CORDIC_GUARD_BITS (8)
+   #endif
+
+   #if (UTL_CORDIC_ITERATIONS < 1) || \
+       (UTL_CORDIC_ITERATIONS > UTL_CORDIC_MAX_ITERATIONS)
+      #error UTL_CORDIC_ITERATIONS must be 1 to UTL_CORDIC_MAX_ITERATIONS.
+   #endif
+
+   #if (UTL_CORDIC_GUARD_BITS < 0) || (UTL_CORDIC_GUARD_BITS > 14)
+      #error UTL_CORDIC_GUARD_BITS must be 0 to 14.
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * The working registers are Q(UTL_CORDIC_FRAC_BITS) numbers. Angles in
+    * the circular mode are phases where 2*pi = (65536 << guard bits).
+    *------------------------------------------------------------------------*/
+   #define UTL_CORDIC_FRAC_BITS (15 + UTL_CORDIC_GUARD_BITS)
+   #define UTL_CORDIC_ONE       ((int32_t)1 << UTL_CORDIC_FRAC_BITS)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+
+      CORDIC_ROTATE = 0, /*Drive z to zero, rotates (x,y) by z*/
+      CORDIC_VECTOR      /*Drive y to zero, z accumulates the angle of (x,y)*/
+
+   }t_cordicMode;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * The raw iterations on Q(UTL_CORDIC_FRAC_BITS) registers, the gain is
+    * left in x and y. The circular mode only converges for angles within
+    * +/-99 degrees, the hyperbolic mode for |z| < 1.118 and |y/x| < 0.806.
+    *------------------------------------------------------------------------*/
+   void utl_cordicCircular( int32_t *pi_x,
+                            int32_t *pi_y,
+                            int32_t *pi_z,
+                            t_cordicMode t_mode);
+
+   void utl_cordicHyperbolic( int32_t *pi_x,
+                              int32_t *pi_y,
+                              int32_t *pi_z,
+                              t_cordicMode t_mode);
+
+   void utl_cordicRotate16( int16_t *ps_x,
+                            int16_t *ps_y,
+                            uint16_t s_phase);
+
+   void utl_cordicSincos16( uint16_t s_phase,
+                            int16_t *ps_sin,
+                            int16_t *ps_cos);
+
+   int16_t utl_cordicAtan2_16( int16_t s_y,
+                               int16_t s_x,
+                               uint16_t *ps_mag);
+
+   uint16_t utl_cordicMag3_16( int16_t s_x,
+                               int16_t s_y,
+                               int16_t s_z);
+
+   uint32_t utl_cordicSqrt32( uint32_t i_input,
+                              int8_t c_n);
+
+   int32_t utl_cordicLn32( uint32_t i_y);
+
+   uint32_t utl_cordicExp32( int32_t i_x);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef utl_cordic_h*/
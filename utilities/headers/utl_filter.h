@@ -0,0 +1,237 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_filter.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Fixed-point filters that work on blocks of Q15 samples, so
+ *               a driver can filter a whole DMA or ADC block in one call
+ *               instead of one sample at a time. There is an FIR filter, a
+ *               cascade of biquad IIR sections, a moving average, and a CIC
+ *               decimator. The products are accumulated with
+ *               'utl_mac16x16_32', which uses the hardware multiplier on the
+ *               xmega.
+ *
+ *               Every filter is a plain struct owned by the caller together
+ *               with its coefficients and state arrays, nothing is taken
+ *               from the heap.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_filter_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define utl_filter_h
+
+   /*------------------------------------------------------------------------*
+    * Number of int16_t state words each filter needs.
+    *------------------------------------------------------------------------*/
+   #define UTL_FILTER_FIR_STATE_SIZE(taps)      ((taps) - 1)
+   #define UTL_FILTER_BIQUAD_STATE_SIZE(stages) ((stages)*4)
+
+   /*------------------------------------------------------------------------*
+    * Number of coefficients in a biquad cascade, b0, b1, b2, a1, a2 for
+    * each stage.
+    *------------------------------------------------------------------------*/
+   #define UTL_FILTER_BIQUAD_COEFF_SIZE(stages) ((stages)*5)
+
+   /*------------------------------------------------------------------------*
+    * Largest number of integrator/comb pairs in a CIC decimator.
+    *------------------------------------------------------------------------*/
+   #define UTL_FILTER_CIC_MAX_ORDER (4)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+
+      FILTER_INVALID_ARG = -2, /*A length, order or factor is out of range.*/
+      FILTER_NULL_PTR    = -1, /*Pointer is not mapped to a valid address.*/
+      FILTER_PASSED      = 0   /*Configuration good.*/
+
+   }t_filterError;
+
+   typedef struct
+   {
+
+      /*---------------------------------------------------------------------*
+       * Q15 taps h[0] to h[s_numTaps - 1], h[0] weights the newest sample.
+       *---------------------------------------------------------------------*/
+      const int16_t *ps_coeffs;
+
+      /*---------------------------------------------------------------------*
+       * The last s_numTaps - 1 inputs, oldest first.
+       *---------------------------------------------------------------------*/
+      int16_t *ps_state;
+
+      uint16_t s_numTaps;
+
+      /*---------------------------------------------------------------------*
+       * Each product is shifted down by this many bits before it is
+       * accumulated, the headroom needed for the sum of the taps.
+       *---------------------------------------------------------------------*/
+      int8_t c_o;
+
+   }t_firFilter;
+
+   typedef struct
+   {
+
+      /*---------------------------------------------------------------------*
+       * b0, b1, b2, a1, a2 of each stage with c_n fractional bits, where
+       *    H(z) = (b0 + b1*z^-1 + b2*z^-2) / (1 + a1*z^-1 + a2*z^-2)
+       *---------------------------------------------------------------------*/
+      const int16_t *ps_coeffs;
+
+      /*---------------------------------------------------------------------*
+       * x[n-1], x[n-2], y[n-1], y[n-2] of each stage.
+       *---------------------------------------------------------------------*/
+      int16_t *ps_state;
+
+      uint8_t c_numStages;
+
+      /*---------------------------------------------------------------------*
+       * Fractional bits of the coefficients, 14 lets them reach +/-2.
+       *---------------------------------------------------------------------*/
+      int8_t c_n;
+
+   }t_biquadFilter;
+
+   typedef struct
+   {
+
+      /*---------------------------------------------------------------------*
+       * The last s_length inputs, a ring indexed by s_index.
+       *---------------------------------------------------------------------*/
+      int16_t *ps_window;
+
+      int32_t i_sum;
+
+      /*---------------------------------------------------------------------*
+       * 2^30 / s_length, so the average is a multiply instead of a divide.
+       *---------------------------------------------------------------------*/
+      int32_t i_gain;
+
+      uint16_t s_length;
+
+      uint16_t s_index;
+
+   }t_movAvgFilter;
+
+   typedef struct
+   {
+
+      /*---------------------------------------------------------------------*
+       * The integrators and the previous input of each comb. The registers
+       * are allowed to wrap, the combs undo it as long as the gain of the
+       * filter fits in 16 bits.
+       *---------------------------------------------------------------------*/
+      uint32_t ai_integ[UTL_FILTER_CIC_MAX_ORDER];
+      uint32_t ai_comb[UTL_FILTER_CIC_MAX_ORDER];
+
+      uint16_t s_decimation;
+
+      /*---------------------------------------------------------------------*
+       * Inputs taken since the last output.
+       *---------------------------------------------------------------------*/
+      uint16_t s_count;
+
+      uint8_t c_order;
+
+      /*---------------------------------------------------------------------*
+       * Removes the gain (s_decimation^c_order) rounded up to a power of
+       * two.
+       *---------------------------------------------------------------------*/
+      int8_t c_shift;
+
+   }t_cicDecimator;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+   t_filterError utl_initFir( t_firFilter *pt_fir,
+                              const int16_t *ps_coeffs,
+                              uint16_t s_numTaps,
+                              int16_t *ps_state,
+                              int8_t c_o);
+
+   /*------------------------------------------------------------------------*
+    * 'ps_out' can't overlap 'ps_in'.
+    *------------------------------------------------------------------------*/
+   void utl_fir16( t_firFilter *pt_fir,
+                   const int16_t *ps_in,
+                   int16_t *ps_out,
+                   uint16_t s_length);
+
+   t_filterError utl_initBiquad( t_biquadFilter *pt_biquad,
+                                 const int16_t *ps_coeffs,
+                                 uint8_t c_numStages,
+                                 int16_t *ps_state,
+                                 int8_t c_n);
+
+   /*------------------------------------------------------------------------*
+    * 'ps_out' can be the same array as 'ps_in' for the remaining filters.
+    *------------------------------------------------------------------------*/
+   void utl_biquad16( t_biquadFilter *pt_biquad,
+                      const int16_t *ps_in,
+                      int16_t *ps_out,
+                      uint16_t s_length);
+
+   t_filterError utl_initMovAvg( t_movAvgFilter *pt_avg,
+                                 int16_t *ps_window,
+                                 uint16_t s_length);
+
+   void utl_movAvg16( t_movAvgFilter *pt_avg,
+                      const int16_t *ps_in,
+                      int16_t *ps_out,
+                      uint16_t s_length);
+
+   t_filterError utl_initCic( t_cicDecimator *pt_cic,
+                              uint8_t c_order,
+                              uint16_t s_decimation);
+
+   uint16_t utl_cicDecimate16( t_cicDecimator *pt_cic,
+                               const int16_t *ps_in,
+                               int16_t *ps_out,
+                               uint16_t s_length);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef utl_filter_h*/
@@ -0,0 +1,142 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_frame.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file provides a set of routines for packing binary
+ *               messages into COBS (consistent overhead byte stuffing)
+ *               frames protected by a CRC-16. Since an encoded frame never
+ *               contains the delimiter byte (0x00) it can share a serial
+ *               link with plain text, which never contains a NULL either.
+ *
+ *               Frame layout before encoding (multi-byte fields are little
+ *               endian):
+ *
+ *               | msg id | version | sequence | payload ... | crc16 |
+ *
+ *               On the wire: 0x00, COBS(frame), 0x00. The CRC is
+ *               CRC-16/CCITT (poly 0x1021, init 0xFFFF) over the header and
+ *               payload.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_frame_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define utl_frame_h
+
+   /*------------------------------------------------------------------------*
+    * Byte used for delimiting frames on the link.
+    *------------------------------------------------------------------------*/
+   #define UTL_FRAME_DELIM    (0x00)
+
+   /*------------------------------------------------------------------------*
+    * Size of the message id, version, and sequence number fields.
+    *------------------------------------------------------------------------*/
+   #define UTL_FRAME_HDR_SIZE (3)
+
+   #define UTL_FRAME_CRC_SIZE (2)
+
+   /*------------------------------------------------------------------------*
+    * Worst case number of bytes needed to encode a payload of 's' bytes,
+    * including both delimiters and the COBS overhead of one byte every 254
+    * bytes.
+    *------------------------------------------------------------------------*/
+   #define UTL_FRAME_MAX_ENCODED_SIZE(s) ((s) + UTL_FRAME_HDR_SIZE +\
+   UTL_FRAME_CRC_SIZE + (((s) + UTL_FRAME_HDR_SIZE + UTL_FRAME_CRC_SIZE) /\
+   254) + 3)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+
+      FRAME_CRC_ERROR    = -4, /*Frame failed the CRC check*/
+      FRAME_DECODE_ERROR = -3, /*Invalid COBS sequence*/
+      FRAME_INVALID_SIZE = -2, /*Buffer too small or frame too short*/
+      FRAME_NULL_PTR     = -1, /*Pointer is not mapped to a valid address.*/
+      FRAME_PASSED       = 0   /*Configuration good.*/
+
+   }t_frameError;
+
+   /*------------------------------------------------------------------------*
+    * A decoded frame. 'pc_payload' points into the buffer passed to
+    * 'utl_frameDecode'.
+    *------------------------------------------------------------------------*/
+   typedef struct
+   {
+      uint8_t c_msgId;
+      uint8_t c_version;
+      uint8_t c_seq;
+      uint8_t *pc_payload;
+      uint16_t s_size;
+   }t_frameMsg;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+   uint16_t utl_crc16( uint16_t s_crc,
+                       const uint8_t *pc_data,
+                       uint16_t s_size);
+
+   /*------------------------------------------------------------------------*
+    * Builds a delimited frame in 'pc_out' and returns the number of bytes
+    * written, or a negative 't_frameError'.
+    *------------------------------------------------------------------------*/
+   int16_t utl_frameEncode( uint8_t c_msgId,
+                            uint8_t c_version,
+                            uint8_t c_seq,
+                            const void *pv_payload,
+                            uint16_t s_size,
+                            uint8_t *pc_out,
+                            uint16_t s_outSize);
+
+   /*------------------------------------------------------------------------*
+    * Decodes--in place--the bytes found between two delimiters and checks
+    * the CRC.
+    *------------------------------------------------------------------------*/
+   t_frameError utl_frameDecode( uint8_t *pc_frame,
+                                 uint16_t s_size,
+                                 t_frameMsg *pt_msg);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef utl_frame_h*/
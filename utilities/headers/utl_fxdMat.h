@@ -0,0 +1,257 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_fxdMat.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Fixed-point matrix kernels whose dimensions and Q formats
+ *               are fixed at compile time. Each UTL_FXD_MAT_* macro
+ *               expands to an inline function for one shape and one set of
+ *               Q formats, so every shift is a constant and every loop has
+ *               a constant trip count. Dot products are always unrolled and
+ *               kernels of up to UTL_FXD_MAT_UNROLL_MAX multiplies are
+ *               unrolled completely. Products are accumulated in 32 bits
+ *               and the result saturates to 16 bits instead of wrapping.
+ *
+ *               For example, a 3x3 by 3x3 product of Q15 numbers with one
+ *               bit of overflow headroom in the accumulator,
+ *
+ *                  UTL_FXD_MAT_MULT( usr_mult3x3Q15, 3, 3, 3, 15, 15, 15, 1)
+ *
+ *                  usr_mult3x3Q15( &as_a[0][0], &as_b[0][0], &as_res[0][0]);
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_fxdMat_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Public defines
+    *------------------------------------------------------------------------*/
+   #define utl_fxdMat_h
+
+   /*------------------------------------------------------------------------*
+    * Kernels with no more than this many multiplies are unrolled
+    * completely, larger ones only have their dot products unrolled.
+    *------------------------------------------------------------------------*/
+   #define UTL_FXD_MAT_UNROLL_MAX (27)
+
+   /*------------------------------------------------------------------------*
+    * Macro definitions
+    *------------------------------------------------------------------------*/
+   #define UTL_FXD_MAT_STR(x)  #x
+   #define UTL_FXD_MAT_XSTR(x) UTL_FXD_MAT_STR(x)
+
+   /*------------------------------------------------------------------------*
+    * '#pragma GCC unroll' is only understood from gcc 8 on, older compilers
+    * are left to unroll the constant trip counts on their own.
+    *------------------------------------------------------------------------*/
+   #if (__GNUC__ >= 8)
+      #define UTL_FXD_MAT_UNROLL(n) _Pragma( UTL_FXD_MAT_XSTR( GCC unroll (n)))
+   #else
+      #define UTL_FXD_MAT_UNROLL(n)
+   #endif
+
+   #define UTL_FXD_MAT_OUTER_UNROLL( rows, inner, cols, n) \
+   ((((rows)*(inner)*(cols)) <= UTL_FXD_MAT_UNROLL_MAX) ? (n) : 1)
+
+   /*------------------------------------------------------------------------*
+    * Right shift that takes a product of Qa and Qb numbers, with 'o' bits
+    * of headroom taken off every product, down to Qres. Fails to compile
+    * if the Q formats ask for a left shift.
+    *------------------------------------------------------------------------*/
+   #define UTL_FXD_MAT_SHFT( qa, qb, qRes, o) ((qa) + (qb) - (o) - (qRes))
+
+   #define UTL_FXD_MAT_CHECK( name, qa, qb, qRes, o) \
+   typedef char name##_qCheck[((UTL_FXD_MAT_SHFT( qa, qb, qRes, o) >= 0) && \
+   ((o) >= 0) && ((o) < 16)) ? 1 : -1]
+
+   /*------------------------------------------------------------------------*
+    * name( ps_a, ps_b, ps_res) - ps_res = ps_a*ps_b
+    *
+    *    ps_a   - rows x inner matrix in Qqa
+    *    ps_b   - inner x cols matrix in Qqb
+    *    ps_res - rows x cols matrix in QqRes, must not overlap the inputs
+    *    o      - bits every product is shifted down by before it is
+    *             accumulated, in order to prevent overflow
+    *------------------------------------------------------------------------*/
+   #define UTL_FXD_MAT_MULT( name, rows, inner, cols, qa, qb, qRes, o) \
+   UTL_FXD_MAT_CHECK( name, qa, qb, qRes, o); \
+   static inline void __attribute__((always_inline)) \
+   name( const int16_t *ps_a, \
+         const int16_t *ps_b, \
+         int16_t *ps_res) \
+   { \
+      int8_t c_r; \
+      int8_t c_c; \
+      int8_t c_k; \
+      int32_t i_acc; \
+      \
+      UTL_FXD_MAT_UNROLL( UTL_FXD_MAT_OUTER_UNROLL( rows, inner, cols, rows)) \
+      for( c_r = 0; c_r < (rows); c_r++) \
+      { \
+         UTL_FXD_MAT_UNROLL( UTL_FXD_MAT_OUTER_UNROLL( rows, inner, cols, \
+         cols)) \
+         for( c_c = 0; c_c < (cols); c_c++) \
+         { \
+            i_acc = 0; \
+            UTL_FXD_MAT_UNROLL( inner) \
+            for( c_k = 0; c_k < (inner); c_k++) \
+            { \
+               i_acc += utl_fxdMatProd( ps_a[c_r*(inner) + c_k], \
+                                        ps_b[c_k*(cols) + c_c], \
+                                        (o)); \
+            } \
+            ps_res[c_r*(cols) + c_c] = utl_fxdMatNarrow( i_acc, \
+            UTL_FXD_MAT_SHFT( qa, qb, qRes, o)); \
+         } \
+      } \
+   }
+
+   /*------------------------------------------------------------------------*
+    * name( ps_a, ps_b, ps_res) - ps_res = ps_a*ps_b', which saves forming
+    * the transpose when ps_b is stored by rows.
+    *
+    *    ps_a   - rows x inner matrix in Qqa
+    *    ps_b   - cols x inner matrix in Qqb
+    *    ps_res - rows x cols matrix in QqRes, must not overlap the inputs
+    *    o      - bits every product is shifted down by before it is
+    *             accumulated, in order to prevent overflow
+    *------------------------------------------------------------------------*/
+   #define UTL_FXD_MAT_MULT_TRANS_B( name, rows, inner, cols, qa, qb, qRes, o) \
+   UTL_FXD_MAT_CHECK( name, qa, qb, qRes, o); \
+   static inline void __attribute__((always_inline)) \
+   name( const int16_t *ps_a, \
+         const int16_t *ps_b, \
+         int16_t *ps_res) \
+   { \
+      int8_t c_r; \
+      int8_t c_c; \
+      int8_t c_k; \
+      int32_t i_acc; \
+      \
+      UTL_FXD_MAT_UNROLL( UTL_FXD_MAT_OUTER_UNROLL( rows, inner, cols, rows)) \
+      for( c_r = 0; c_r < (rows); c_r++) \
+      { \
+         UTL_FXD_MAT_UNROLL( UTL_FXD_MAT_OUTER_UNROLL( rows, inner, cols, \
+         cols)) \
+         for( c_c = 0; c_c < (cols); c_c++) \
+         { \
+            i_acc = 0; \
+            UTL_FXD_MAT_UNROLL( inner) \
+            for( c_k = 0; c_k < (inner); c_k++) \
+            { \
+               i_acc += utl_fxdMatProd( ps_a[c_r*(inner) + c_k], \
+                                        ps_b[c_c*(inner) + c_k], \
+                                        (o)); \
+            } \
+            ps_res[c_r*(cols) + c_c] = utl_fxdMatNarrow( i_acc, \
+            UTL_FXD_MAT_SHFT( qa, qb, qRes, o)); \
+         } \
+      } \
+   }
+
+   /*------------------------------------------------------------------------*
+    * Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_fxdMatProd
+    *
+    * Description:
+    *	   Product of two 16-bit numbers shifted down by c_o bits. The shift
+    *    is applied to the magnitude, the same as 'utl_mac16x16_32', so
+    *    negative products round toward zero.
+    *
+    * Parameters:
+    *    s_x1 - 16-bit multiplicand
+    *    s_x2 - 16-bit multiplicand
+    *    c_o  - Overflow prevention factor, a constant in every kernel
+    *
+    * Return:
+    *    i_y - 32-bit product
+    *------------------------------------------------------------------------*/
+   static inline int32_t __attribute__((always_inline)) \
+   utl_fxdMatProd( int16_t s_x1, int16_t s_x2, int8_t c_o)
+   {
+      int32_t i_y = (int32_t)s_x1*(int32_t)s_x2;
+
+      if( c_o == 0)
+         return i_y;
+
+      if( i_y < 0)
+         return -((-i_y) >> c_o);
+
+      return i_y >> c_o;
+
+   }/*End utl_fxdMatProd*/
+
+   /*------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_fxdMatNarrow
+    *
+    * Description:
+    *	   Shifts a 32-bit accumulation down to a 16-bit result. Like
+    *    'utl_rShft32_16' the magnitude is truncated, but a result that
+    *    doesn't fit saturates at 32767/-32768 instead of wrapping.
+    *
+    * Parameters:
+    *    i_x    - 32-bit accumulation
+    *    c_shft - Number of bits to shift down by, a constant in every kernel
+    *
+    * Return:
+    *    s_y - Saturated 16-bit result
+    *------------------------------------------------------------------------*/
+   static inline int16_t __attribute__((always_inline)) \
+   utl_fxdMatNarrow( int32_t i_x, int8_t c_shft)
+   {
+      uint32_t i_mag;
+
+      if( i_x < 0)
+      {
+         i_mag = ((uint32_t)(-(i_x + 1)) + 1) >> c_shft;
+         if( i_mag > 32768)
+            return -32768;
+
+         return (int16_t)(-(int32_t)i_mag);
+      }
+
+      i_mag = (uint32_t)i_x >> c_shft;
+      if( i_mag > 32767)
+         return 32767;
+
+      return (int16_t)i_mag;
+
+   }/*End utl_fxdMatNarrow*/
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif /*End #ifndef utl_fxdMat_h*/
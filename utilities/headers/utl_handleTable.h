@@ -0,0 +1,145 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_handleTable.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : A fixed-capacity table mapping a small hardware ID (channel,
+ *               interrupt source, etc.) to the handle currently registered
+ *               against it. Lookups are a bounds check and an array index,
+ *               so they are safe to use from an ISR. The storage is sized at
+ *               compile time with 'UTL_HANDLE_TABLE_CREATE'.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_handleTable_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define utl_handleTable_h
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+
+      HANDLE_TABLE_SLOT_USED  = -3, /*A handle is already mapped to the ID*/
+      HANDLE_TABLE_INVALID_ID = -2, /*ID is outside the table*/
+      HANDLE_TABLE_NULL_PTR   = -1, /*Pointer is not mapped to a valid
+                                      address.*/
+      HANDLE_TABLE_PASSED     = 0   /*Configuration good.*/
+
+   }t_handleTableError;
+
+   typedef struct
+   {
+
+      /*---------------------------------------------------------------------*
+       * The number of IDs the table can hold, valid IDs are 0 to
+       * 'c_numSlots' - 1.
+       *---------------------------------------------------------------------*/
+      uint8_t c_numSlots;
+
+      /*---------------------------------------------------------------------*
+       * One entry per ID, NULL when nothing is registered.
+       *---------------------------------------------------------------------*/
+      void **ppv_slots;
+
+   }t_handleTable;
+
+   /*------------------------------------------------------------------------*
+    * Global Macros
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * This macro declares (and zeros) a table along with its storage.
+    *------------------------------------------------------------------------*/
+   #define UTL_HANDLE_TABLE_CREATE( name, c_numSlots)\
+      static void *name##Slots[(c_numSlots)];\
+      static t_handleTable name = {(c_numSlots), name##Slots}
+
+   /*------------------------------------------------------------------------*
+    * Compile time check that a folded ID lands on slot 'c_expect' and that
+    * the slot fits in a table of 'c_numSlots'. Listing every ID with
+    * consecutive 'c_expect' values proves the folding is one-to-one, the
+    * build fails (negative array size) if it isn't.
+    *------------------------------------------------------------------------*/
+   #define UTL_HANDLE_TABLE_CHECK_SLOT( c_slot, c_expect, c_numSlots)\
+      UTL_HANDLE_TABLE_CHECK_SLOT_( c_slot, c_expect, c_numSlots, __LINE__)
+   #define UTL_HANDLE_TABLE_CHECK_SLOT_( c_slot, c_expect, c_numSlots, line)\
+      UTL_HANDLE_TABLE_CHECK_SLOT__( c_slot, c_expect, c_numSlots, line)
+   #define UTL_HANDLE_TABLE_CHECK_SLOT__( c_slot, c_expect, c_numSlots, line)\
+      typedef char utl_handleTableSlotCheck##line[(((c_slot) == (c_expect))\
+      && ((c_expect) < (c_numSlots))) ? 1 : -1]
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Returns the handle registered against 'c_id' or NULL if there isn't
+    * one.
+    *------------------------------------------------------------------------*/
+   static inline void * __attribute__((always_inline)) \
+   utl_getHandle( const t_handleTable *pt_table,
+                  uint8_t c_id)
+   {
+      if( c_id >= pt_table->c_numSlots)
+         return NULL;
+
+      return pt_table->ppv_slots[c_id];
+
+   }/*End utl_getHandle*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Maps 'pv_handle' to 'c_id', fails if the ID is already in use.
+    *------------------------------------------------------------------------*/
+   t_handleTableError utl_insertHandle( t_handleTable *pt_table,
+                                        uint8_t c_id,
+                                        void *pv_handle);
+
+   /*------------------------------------------------------------------------*
+    * Clears the entry for 'c_id'.
+    *------------------------------------------------------------------------*/
+   t_handleTableError utl_removeHandle( t_handleTable *pt_table,
+                                        uint8_t c_id);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef utl_handleTable_h*/
@@ -20,9 +20,13 @@
  *               <https://code.google.com/p/arbitros/>
  *
  * Description : This file provides an abstraction layer for the creation and
- *               control over linked-list objects.
+ *               control over intrusive linked-list objects. The 'link' is
+ *               embedded as the first member of the object being stored,
+ *               so a link handle and a pointer to its element are the same
+ *               address and moving an object between lists only rewires
+ *               pointers.
  *
- * Last Update : June 11, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 #ifndef utl_linkedList_h
 
@@ -55,38 +59,24 @@
    }t_linkedListError;
 
    /*------------------------------------------------------------------------*
-    * This typedef is the primary building block for a linked-list. When
-    * constructing a list, links are created by calling the function
-    * 'utl_createLink' and inserting them into a particular container using
-    * the function 'utl_insertLink'. A link is the individual piece that
-    * encapsulates an area of memory that contains the data being stored on the
-    * list by a particular user-space application, kernel object, or device
-    * driver. The area of memory is known as an element.
+    * This typedef is the primary building block for a linked-list. A link is
+    * embedded as the FIRST member of every structure (known as an element)
+    * that is stored on a list, e.g...
+    *
+    *    typedef struct
+    *    {
+    *       t_listLink t_link;
+    *       uint8_t c_id;
+    *       ...
+    *    }t_myElement;
+    *
+    * Elements are allocated by calling the function 'utl_createLink' (or
+    * 'utl_initLink' for static storage) and are inserted into a particular
+    * container using the function 'utl_insertLink'. Since the link is the
+    * start of the element, no memory is allocated for the link itself.
     *------------------------------------------------------------------------*/
    typedef struct listLink
    {
-      /*---------------------------------------------------------------------*
-       * Pointer to the particular element encapsulated by this particular
-       * 'link'. An element is the area of memory set aside for the actual
-       * user-data being stored on the list.
-       *---------------------------------------------------------------------*/
-      void *pv_element;
-
-      /*---------------------------------------------------------------------*
-       * The size of the memory region pointed to by 'pv_element' in bytes
-       *---------------------------------------------------------------------*/
-      uint16_t s_elementSizeBytes;
-
-      /*---------------------------------------------------------------------*
-       * Address of the container that is associated with this link.
-       *---------------------------------------------------------------------*/
-      uint16_t s_contAddr;
-
-      /*---------------------------------------------------------------------*
-       * The size of the this 'link' in bytes
-       *---------------------------------------------------------------------*/
-      uint16_t s_linkSizeBytes;
-
       /*---------------------------------------------------------------------*
        * Pointer to the next 'link' on the list
        *---------------------------------------------------------------------*/
@@ -97,14 +87,20 @@
        *---------------------------------------------------------------------*/
       struct listLink *pt_prev;
 
+      /*---------------------------------------------------------------------*
+       * Address of the container that is associated with this link.
+       *---------------------------------------------------------------------*/
+      intptr_t s_contAddr;
+
    }t_listLink;
 
    /*------------------------------------------------------------------------*
     * This typedef defines collection of 'links' that define a particular list.
     * The first step in the creation of a list is to define the containing
-    * 'object' using the function 'utl_createContainer' (for dynamic allocation)
-    * or 'UTL_CREATE_CONTAINER' (for static allocation) from which 'links' can
-    * be added using the function 'utl_insertLink'.
+    * 'object' using the function 'utl_createContainer' (for dynamic
+    * allocation), 'UTL_CREATE_CONTAINER' (for static allocation), or
+    * 'utl_initContainer' (for a container embedded in another structure)
+    * from which 'links' can be added using the function 'utl_insertLink'.
     *------------------------------------------------------------------------*/
    typedef struct
    {
@@ -119,11 +115,6 @@
        *---------------------------------------------------------------------*/
       uint16_t s_numLinks;
 
-      /*---------------------------------------------------------------------*
-       * The size of this list in bytes (including the container).
-       *---------------------------------------------------------------------*/
-      uint16_t s_contSizeBytes;
-
       /*---------------------------------------------------------------------*
        * Pointer to the current 'link' being used on the list. This pointer
        * is not updated by this utility. It is up to the calling application
@@ -143,9 +134,9 @@
 
    }t_listContainer;
 
-   typedef volatile int16_t t_CONTHNDL; /*Handle to a 'list'*/
+   typedef volatile intptr_t t_CONTHNDL; /*Handle to a 'list'*/
 
-   typedef volatile int16_t t_LINKHNDL; /*Handle to a 'link' on a 'list'*/
+   typedef volatile intptr_t t_LINKHNDL; /*Handle to a 'link' on a 'list'*/
 
    /*------------------------------------------------------------------------*
     * Global Macros
@@ -163,9 +154,22 @@
     *------------------------------------------------------------------------*/
    #define UTL_CREATE_CONTAINER( name)\
       t_listContainer UTL_CREATENAME(name) = {LINKEDLIST_CHECKSUM, 0, \
-      sizeof(t_listContainer), NULL, NULL, NULL};\
+      NULL, NULL, NULL};\
       t_CONTHNDL name = (t_CONTHNDL)&UTL_CREATENAME(name);
 
+   /*------------------------------------------------------------------------*
+    * This macro returns the handle of a container embedded in another
+    * structure (see 'utl_initContainer').
+    *------------------------------------------------------------------------*/
+   #define UTL_GET_CONT_HNDL( t_cont) ((t_CONTHNDL)&(t_cont))
+
+   /*------------------------------------------------------------------------*
+    * This macro returns the link handle of an element, i.e. the address of
+    * its embedded 't_link' member.
+    *------------------------------------------------------------------------*/
+   #define UTL_GET_ELEMENT_LINK( pt_element) ((t_LINKHNDL)&(pt_element)->\
+   t_link)
+
     /*------------------------------------------------------------------------*
     * This macro sets the current link in a container.
     *------------------------------------------------------------------------*/
@@ -210,31 +214,40 @@
 
    /*------------------------------------------------------------------------*
     * This macro returns a ptr to an individual record 'element' contained in
-    * a given 'link'
+    * a given 'link'. Since the link is the first member of the element this
+    * is just a cast.
     *------------------------------------------------------------------------*/
-   #define UTL_GET_LINK_ELEMENT_PTR( t_linkHndl) (((t_listLink *)t_linkHndl)->\
-   pv_element);
+   #define UTL_GET_LINK_ELEMENT_PTR( t_linkHndl) ((void *)(t_listLink *)\
+   t_linkHndl);
 
    /*------------------------------------------------------------------------*
     * This macro returns a ptr to an individual record 'element' contained in
     * the head of a given 'container'
     *------------------------------------------------------------------------*/
-   #define UTL_GET_LINK_ELEMENT_PTR_CONT_HEAD( t_contHndl) (((t_listContainer\
-    *)t_contHndl)->pt_head->pv_element);
+   #define UTL_GET_LINK_ELEMENT_PTR_CONT_HEAD( t_contHndl) ((void *)\
+   ((t_listContainer *)t_contHndl)->pt_head);
 
     /*------------------------------------------------------------------------*
     * This macro returns a ptr to an individual record 'element' contained in
     * the tail of a given 'container'
     *------------------------------------------------------------------------*/
-   #define UTL_GET_LINK_ELEMENT_PTR_CONT_TAIL( t_contHndl) (((t_listContainer\
-    *)t_contHndl)->pt_tail->pv_element);
+   #define UTL_GET_LINK_ELEMENT_PTR_CONT_TAIL( t_contHndl) ((void *)\
+   ((t_listContainer *)t_contHndl)->pt_tail);
 
     /*------------------------------------------------------------------------*
     * This macro returns a ptr to an individual record 'element' contained in
-    * the tail of a given 'container'
+    * the current link of a given 'container'
+    *------------------------------------------------------------------------*/
+   #define UTL_GET_LINK_ELEMENT_PTR_CONT_CURR( t_contHndl) ((void *)\
+   ((t_listContainer *)t_contHndl)->pt_curr);
+
+   /*------------------------------------------------------------------------*
+    * This macro clears every member of an element except for its embedded
+    * link, which is safe to call while the element is on a list.
     *------------------------------------------------------------------------*/
-   #define UTL_GET_LINK_ELEMENT_PTR_CONT_CURR( t_contHndl) (((t_listContainer\
-    *)t_contHndl)->pt_curr->pv_element);
+   #define UTL_CLEAR_LINK_ELEMENT( pt_element, type)\
+   memset( (void *)((t_listLink *)(pt_element) + 1), 0, sizeof( type) -\
+   sizeof( t_listLink))
 
     /*------------------------------------------------------------------------*
     * This macro checks to see if a particular 'link' is contained on the
@@ -290,8 +303,19 @@
    /*------------------------------------------------------------------------*
     * Global Function Prototypes
     *------------------------------------------------------------------------*/
+   /*------------------------------------------------------------------------*
+    * Allocates an element of 's_elementSizeBytes' (which includes the
+    * embedded link) from the heap. Everything after the link is initialized
+    * to 0xFF.
+    *------------------------------------------------------------------------*/
    t_LINKHNDL utl_createLink( uint16_t s_elementSizeBytes);
 
+   /*------------------------------------------------------------------------*
+    * Prepares the link embedded in a statically allocated element for
+    * insertion onto a list.
+    *------------------------------------------------------------------------*/
+   t_LINKHNDL utl_initLink( t_listLink *pt_link);
+
    t_linkedListError utl_destroyLink( t_CONTHNDL t_contHndl,
                                       t_LINKHNDL t_linkHndl);
 
@@ -304,9 +328,13 @@
 
    t_CONTHNDL utl_createContainer( void);
 
-   t_linkedListError utl_destroyContainer( t_CONTHNDL t_contHndl);
+   /*------------------------------------------------------------------------*
+    * Initializes a container embedded in another structure and returns its
+    * handle.
+    *------------------------------------------------------------------------*/
+   t_CONTHNDL utl_initContainer( t_listContainer *pt_cont);
 
-   uint32_t utl_getDynListMemUsage( void);
+   t_linkedListError utl_destroyContainer( t_CONTHNDL t_contHndl);
 
    #ifdef __cplusplus
    }/*End extern "C"*/
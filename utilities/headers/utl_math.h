@@ -22,7 +22,7 @@
  * Description : This file provides various optimized fixed-point and
  *               float-point vector/matrix operations.
  *
- * Last Update : September 26, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 #ifndef utl_math_h
 
@@ -44,6 +44,25 @@
    #define UTL_MATH_FXDPNT_TWO_PI_WRAP (65536)
    #define UTL_MATH_SAT_CHECK          (0)
 
+   /*------------------------------------------------------------------------*
+    * The multiply primitives drive the xmega's hardware multiplier through
+    * inline assembly, any other target gets C with the same results.
+    *------------------------------------------------------------------------*/
+   #if defined( __AVR__) && defined( __AVR_HAVE_MUL__)
+      #define UTL_MATH_AVR_MUL         (1)
+   #else
+      #define UTL_MATH_AVR_MUL         (0)
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * utl_mult32x32_32 builds its product from four 16x16 bit multiplies
+    * where the 64-bit multiply is slow. The host tests turn it on to check
+    * the split against the exact product.
+    *------------------------------------------------------------------------*/
+   #ifndef UTL_MATH_MUL32_SPLIT
+      #define UTL_MATH_MUL32_SPLIT     UTL_MATH_AVR_MUL
+   #endif
+
    /*------------------------------------------------------------------------*
     * Public typdefs
     *------------------------------------------------------------------------*/
@@ -66,6 +85,14 @@
     * Macro definitions
     *------------------------------------------------------------------------*/
 
+   /*------------------------------------------------------------------------*
+    * Packed storage of a symmetric or lower triangular n by n matrix, the
+    * lower triangle is kept row after row so element (r,c), c <= r, is at
+    * UTL_MATH_PACKED_IDX( r, c).
+    *------------------------------------------------------------------------*/
+   #define UTL_MATH_PACKED_SIZE(n)    (((n)*((n) + 1)) >> 1)
+   #define UTL_MATH_PACKED_IDX(r, c)  ((((r)*((r) + 1)) >> 1) + (c))
+
    /*------------------------------------------------------------------------*
     * Inline functions
     *------------------------------------------------------------------------*/
@@ -270,7 +297,7 @@
    {
       int16_t s_y;
       int16_t s_b1 = s_y1 - s_y0;
-      int16_t s_b2 = (((s_y2 - s_y1) - (s_y1 - s_y0)) + (int16_t)1) >> 1;
+      int16_t s_b2 = (((int16_t)(s_y2 - s_y1) - s_b1) + (int16_t)1) >> 1;
       int16_t s_temp;
       int16_t s_temp2;
       s_temp = utl_rShft32_16((int32_t)s_b2*(int32_t)(s_x - s_x1), c_step);
@@ -281,30 +308,396 @@
 
    }/*End utl_quadInterp16_16*/
 
+   /*-------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_macF
+    *
+    * Description:
+    *	   Floating-point multiply and accumulate. Inlined so the matrix kernels
+    *    don't pay for a call per element.
+    *
+    * Parameters:
+    *    f_x1 - 32-bit floating-point multiplicand
+    *    f_x2 - 32-bit floating-point multiplicand
+    *    f_y - 32-bit floating-point accumulated result
+    *
+    * Return:
+    *    f_y - 32-bit floating-point accumulation of f_x1*f_x2
+    *------------------------------------------------------------------------*/
+   static inline float __attribute__((always_inline)) \
+   utl_macF( float f_x1,
+             float f_x2,
+             float f_y)
+   {
+
+      return (f_y + (f_x1*f_x2));
+
+   }/*End utl_macF*/
+
    /*------------------------------------------------------------------------*
-    * Public function prototypes
+    *
+    * Function:
+    *	   utl_muls16x16_32
+    *
+    * Description:
+    *	   Exact signed 16x16 bit product. On the xmega the product is built
+    *    from the 8x8 hardware multiplier (AVR201), avr-gcc otherwise extends
+    *    both operands to 32 bits and calls its 32x32 multiply.
+    *------------------------------------------------------------------------*/
+   static inline int32_t __attribute__((always_inline)) \
+   utl_muls16x16_32( int16_t s_x1,
+                     int16_t s_x2)
+   {
+#if UTL_MATH_AVR_MUL
+      int32_t i_y;
+      uint8_t c_zero;
+
+      __asm__ ( "clr   %[z]"          "\n\t"
+                "muls  %B[a], %B[b]"  "\n\t" /*ah*bh*/
+                "movw  %C[y], r0"     "\n\t"
+                "mul   %A[a], %A[b]"  "\n\t" /*al*bl*/
+                "movw  %A[y], r0"     "\n\t"
+                "mulsu %B[a], %A[b]"  "\n\t" /*ah*bl*/
+                "sbc   %D[y], %[z]"   "\n\t"
+                "add   %B[y], r0"     "\n\t"
+                "adc   %C[y], r1"     "\n\t"
+                "adc   %D[y], %[z]"   "\n\t"
+                "mulsu %B[b], %A[a]"  "\n\t" /*bh*al*/
+                "sbc   %D[y], %[z]"   "\n\t"
+                "add   %B[y], r0"     "\n\t"
+                "adc   %C[y], r1"     "\n\t"
+                "adc   %D[y], %[z]"   "\n\t"
+                "clr   __zero_reg__"
+                : [y] "=&r" (i_y), [z] "=&r" (c_zero)
+                : [a] "a" (s_x1), [b] "a" (s_x2));
+
+      return i_y;
+#else
+      return (int32_t)s_x1*(int32_t)s_x2;
+#endif
+
+   }/*End utl_muls16x16_32*/
+
+   /*------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_fmuls16x16_32
+    *
+    * Description:
+    *	   Signed 16x16 bit product shifted up by one, so the upper word of
+    *    the result is the Q15 product of two Q15 numbers. -1*-1 wraps to
+    *    0x80000000. Uses FMULS/FMULSU on the xmega.
+    *------------------------------------------------------------------------*/
+   static inline int32_t __attribute__((always_inline)) \
+   utl_fmuls16x16_32( int16_t s_x1,
+                      int16_t s_x2)
+   {
+#if UTL_MATH_AVR_MUL
+      int32_t i_y;
+      uint8_t c_zero;
+
+      __asm__ ( "clr    %[z]"          "\n\t"
+                "fmuls  %B[a], %B[b]"  "\n\t" /*(ah*bh) << 1*/
+                "movw   %C[y], r0"     "\n\t"
+                "fmul   %A[a], %A[b]"  "\n\t" /*(al*bl) << 1*/
+                "adc    %C[y], %[z]"   "\n\t"
+                "movw   %A[y], r0"     "\n\t"
+                "fmulsu %B[a], %A[b]"  "\n\t" /*(ah*bl) << 1*/
+                "sbc    %D[y], %[z]"   "\n\t"
+                "add    %B[y], r0"     "\n\t"
+                "adc    %C[y], r1"     "\n\t"
+                "adc    %D[y], %[z]"   "\n\t"
+                "fmulsu %B[b], %A[a]"  "\n\t" /*(bh*al) << 1*/
+                "sbc    %D[y], %[z]"   "\n\t"
+                "add    %B[y], r0"     "\n\t"
+                "adc    %C[y], r1"     "\n\t"
+                "adc    %D[y], %[z]"   "\n\t"
+                "clr    __zero_reg__"
+                : [y] "=&r" (i_y), [z] "=&r" (c_zero)
+                : [a] "a" (s_x1), [b] "a" (s_x2));
+
+      return i_y;
+#else
+      return (int32_t)((uint32_t)((int32_t)s_x1*(int32_t)s_x2) << 1);
+#endif
+
+   }/*End utl_fmuls16x16_32*/
+
+   /*------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_mulu16x16_32
+    *
+    * Description:
+    *	   Exact unsigned 16x16 bit product, MUL sequence on the xmega.
+    *------------------------------------------------------------------------*/
+   static inline uint32_t __attribute__((always_inline)) \
+   utl_mulu16x16_32( uint16_t s_x1,
+                     uint16_t s_x2)
+   {
+#if UTL_MATH_AVR_MUL
+      uint32_t i_y;
+      uint8_t c_zero;
+
+      __asm__ ( "clr   %[z]"          "\n\t"
+                "mul   %B[a], %B[b]"  "\n\t" /*ah*bh*/
+                "movw  %C[y], r0"     "\n\t"
+                "mul   %A[a], %A[b]"  "\n\t" /*al*bl*/
+                "movw  %A[y], r0"     "\n\t"
+                "mul   %B[a], %A[b]"  "\n\t" /*ah*bl*/
+                "add   %B[y], r0"     "\n\t"
+                "adc   %C[y], r1"     "\n\t"
+                "adc   %D[y], %[z]"   "\n\t"
+                "mul   %B[b], %A[a]"  "\n\t" /*bh*al*/
+                "add   %B[y], r0"     "\n\t"
+                "adc   %C[y], r1"     "\n\t"
+                "adc   %D[y], %[z]"   "\n\t"
+                "clr   __zero_reg__"
+                : [y] "=&r" (i_y), [z] "=&r" (c_zero)
+                : [a] "r" (s_x1), [b] "r" (s_x2));
+
+      return i_y;
+#else
+      return (uint32_t)s_x1*(uint32_t)s_x2;
+#endif
+
+   }/*End utl_mulu16x16_32*/
+
+   /*------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_mult16x16_16
+    *
+    * Description:
+    *	   Signed multiply of two Qm.n 16-bit numbers returning a Qm.n 16-bit
+    *    result. Where m is the number of integer bits and n represents the
+    *    number of fractional bits. The magnitude of the product is rounded,
+    *    so the result is symmetric about zero.
+    *
+    * Parameters:
+    *    s_x1 - Qm.n 16-bit number where m is the number of integer bits and n
+    *           is the number of fractional bits
+    *    s_x2 - Qm.n 16-bit number where m is the number of integer bits and n
+    *           is the number of fractional bits
+    *    c_n  - The number of fractional bits of the return value.
+    *
+    * Return:
+    *    s_out - Qm.n 16-bit number where m is the number of integer bits and n
+    *            is the number of fractional bits.
+    *
+    * References:
+    *    http://en.wikipedia.org/wiki/Q_(number_format)
+    *------------------------------------------------------------------------*/
+   static inline int16_t __attribute__((always_inline)) \
+   utl_mult16x16_16( int16_t s_x1,
+                     int16_t s_x2,
+                     int8_t c_n)
+   {
+      int32_t i_y;
+      int32_t i_sign;
+      uint32_t i_mag;
+      int16_t s_y;
+#if UTL_MATH_SAT_CHECK
+      uint16_t s_mask;
+#endif
+
+      /*---------------------------------------------------------------------*
+       * A Q15 result is the upper word of the product shifted up by one,
+       * which FMULS gives directly. The rounding below is the same for both
+       * forms, -1*-1 wraps the same way it does with the shift.
+       *---------------------------------------------------------------------*/
+      if( __builtin_constant_p( c_n) && (c_n == 15))
+      {
+         i_y    = utl_fmuls16x16_32( s_x1, s_x2);
+         i_sign = i_y >> 31;
+         i_mag  = ((uint32_t)i_y ^ (uint32_t)i_sign) - (uint32_t)i_sign;
+         s_y    = (int16_t)((i_mag + ((uint32_t)1 << 15)) >> 16);
+      }
+      else
+      {
+         i_y    = utl_muls16x16_32( s_x1, s_x2);
+         i_sign = i_y >> 31;
+         i_mag  = ((uint32_t)i_y ^ (uint32_t)i_sign) - (uint32_t)i_sign;
+         s_y    = (int16_t)((i_mag + ((uint32_t)1 << (c_n - 1))) >> c_n);
+      }
+
+      s_y = (s_y ^ (int16_t)i_sign) - (int16_t)i_sign;
+
+      /*---------------------------------------------------------------------*
+       * Check for negative saturation, -1*-1 returns max positive. The mask
+       * is all ones when both inputs are -1 and is found without a branch.
+       *---------------------------------------------------------------------*/
+#if UTL_MATH_SAT_CHECK
+      s_mask = (uint16_t)(((uint32_t)(uint16_t)((s_x1 ^ (-(int32_t)1 << c_n)) |
+               (s_x2 ^ (-(int32_t)1 << c_n))) - 1) >> 16);
+      s_y = (int16_t)(((uint16_t)s_y & ~s_mask) |
+            ((uint16_t)(((int32_t)1 << c_n) - 1) & s_mask));
+#endif
+
+      return s_y;
+
+   }/*End utl_mult16x16_16*/
+
+   /*------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_mult16x16_32
+    *
+    * Description:
+    *	   Signed multiply of two Qm.n 16-bit numbers returning a Qm.n 32-bit
+    *    result. Where m is the number of integer bits and n represents the
+    *    number of fractional bits.
+    *
+    * Parameters:
+    *    s_x1 - Qm.n 16-bit number where m is the number of integer bits and n
+    *           is the number of fractional bits
+    *    s_x2 - Qm.n 16-bit number where m is the number of integer bits and n
+    *           is the number of fractional bits
+    *    c_n  - The number of fractional bits of the return value.
+    *
+    * Return:
+    *    i_out - Qm.n 32-bit number where m is the number of integer bits and n
+    *            is the number of fractional bits.
+    *
+    * References:
+    *    http://en.wikipedia.org/wiki/Q_(number_format)
+    *------------------------------------------------------------------------*/
+   static inline int32_t __attribute__((always_inline)) \
+   utl_mult16x16_32( int16_t s_x1,
+                     int16_t s_x2,
+                     int8_t c_n)
+   {
+      int32_t i_y;
+      int32_t i_sign;
+      uint32_t i_mag;
+
+      i_y    = utl_muls16x16_32( s_x1, s_x2);
+      i_sign = i_y >> 31;
+      i_mag  = ((uint32_t)i_y ^ (uint32_t)i_sign) - (uint32_t)i_sign;
+      i_mag  = (i_mag + ((uint32_t)1 << (c_n - 1))) >> c_n;
+
+      return ((int32_t)i_mag ^ i_sign) - i_sign;
+
+   }/*End utl_mult16x16_32*/
+
+   /*------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_mult32x32_32
+    *
+    * Description:
+    *	   Signed multiply of two Qm.n 32-bit numbers returning a Qm.n 32-bit
+    *    result. Where m is the number of integer bits and n represents the
+    *    number of fractional bits.
+    *
+    * Parameters:
+    *    i_x1 - Qm.n 32-bit number where m is the number of integer bits and n
+    *           is the number of fractional bits
+    *    i_x2 - Qm.n 32-bit number where m is the number of integer bits and n
+    *           is the number of fractional bits
+    *    c_n  - The number of fractional bits of the return value.
+    *
+    * Return:
+    *    i_out - Qm.n 32-bit number where m is the number of integer bits and n
+    *            is the number of fractional bits.
+    *
+    * References:
+    *    http://en.wikipedia.org/wiki/Q_(number_format)
     *------------------------------------------------------------------------*/
-   int16_t utl_mult16x16_16( int16_t s_x1,
-                             int16_t s_x2,
-                             int8_t c_n);
+   static inline int32_t __attribute__((always_inline)) \
+   utl_mult32x32_32( int32_t i_x1,
+                     int32_t i_x2,
+                     int8_t c_n)
+   {
+#if UTL_MATH_MUL32_SPLIT
+      int32_t i_sign1 = i_x1 >> 31;
+      int32_t i_sign2 = i_x2 >> 31;
+      uint32_t i_mag1;
+      uint32_t i_mag2;
+      uint64_t l_mag;
+
+      /*---------------------------------------------------------------------*
+       * avr-gcc multiplies 64-bit numbers with a shift and add loop, the
+       * magnitudes are multiplied as four 16x16 bit products instead and
+       * the sign is put back at the end.
+       *---------------------------------------------------------------------*/
+      i_mag1 = ((uint32_t)i_x1 ^ (uint32_t)i_sign1) - (uint32_t)i_sign1;
+      i_mag2 = ((uint32_t)i_x2 ^ (uint32_t)i_sign2) - (uint32_t)i_sign2;
+
+      l_mag = ((uint64_t)utl_mulu16x16_32( (uint16_t)(i_mag1 >> 16),
+                                           (uint16_t)(i_mag2 >> 16)) << 32) +
+              ((uint64_t)utl_mulu16x16_32( (uint16_t)(i_mag1 >> 16),
+                                           (uint16_t)i_mag2) << 16) +
+              ((uint64_t)utl_mulu16x16_32( (uint16_t)i_mag1,
+                                           (uint16_t)(i_mag2 >> 16)) << 16) +
+              (uint64_t)utl_mulu16x16_32( (uint16_t)i_mag1, (uint16_t)i_mag2);
+
+      l_mag = (l_mag + ((uint64_t)1 << (c_n - 1))) >> c_n;
+
+      i_sign1 ^= i_sign2;
+
+      return ((int32_t)l_mag ^ i_sign1) - i_sign1;
+#else
+      int64_t l_y;
 
-   int32_t utl_mult16x16_32( int16_t s_x1,
-                             int16_t s_x2,
-                             int8_t c_n);
+      l_y = (int64_t)i_x1*(int64_t)i_x2;
+      if( l_y < 0)
+        l_y = -((-l_y + ((int64_t)1 << (c_n - 1))) >> c_n);
+      else
+         l_y = (l_y + ((int64_t)1 << (c_n - 1))) >> c_n;
 
-   int32_t utl_mult32x32_32( int32_t i_x1,
-                             int32_t i_x2,
-                             int8_t c_n);
+      return (int32_t)l_y;
+#endif
 
+   }/*End utl_mult32x32_32*/
+
+   /*------------------------------------------------------------------------*
+    *
+    * Function:
+    *	   utl_mac16x16_32
+    *
+    * Description:
+    *	   Signed multiply and accumulate of two Qm.n 16-bit numbers returning
+    *    a Qm.n 32-bit result.
+    *
+    * Parameters:
+    *    s_x1 - Qm.n 16-bit number where m is the number of integer bits and
+    *           n is the number of fractional bits
+    *    s_x2 - Qm.n 16-bit number where m is the number of integer bits and
+    *           n is the number of fractional bits
+    *    i_y - Qm.n accumulator initial value.
+    *    c_o - Overflow prevention factor
+    *
+    * Return:
+    *    i_y - Qm.n 32-bit number where m is the number of integer bits and n
+    *          is the number of fractional bits
+    *------------------------------------------------------------------------*/
+   static inline int32_t __attribute__((always_inline)) \
+   utl_mac16x16_32( int16_t s_x1,
+                    int16_t s_x2,
+                    int32_t i_y,
+                    int8_t c_o)
+   {
+      int32_t i_tmp;
+      int32_t i_sign;
+      uint32_t i_mag;
+
+      i_tmp  = utl_muls16x16_32( s_x1, s_x2);
+      i_sign = i_tmp >> 31;
+      i_mag  = (((uint32_t)i_tmp ^ (uint32_t)i_sign) - (uint32_t)i_sign) >> c_o;
+
+      return i_y + (((int32_t)i_mag ^ i_sign) - i_sign);
+
+   }/*End utl_mac16x16_32*/
+
+   /*------------------------------------------------------------------------*
+    * Public function prototypes
+    *------------------------------------------------------------------------*/
    int16_t utl_div16x16_16( int16_t s_x1,
                             int16_t s_x2,
                             int8_t c_n);
 
-   int32_t utl_mac16x16_32( int16_t s_x1,
-                            int16_t s_x2,
-                            int32_t i_y,
-                            int8_t c_o);
-
    int32_t utl_vMult16x16_32( int16_t *ps_x1,
                               int16_t *ps_x2,
                               int32_t i_y,
@@ -334,10 +727,6 @@
                          int8_t c_rows,
                          int8_t c_col);
 
-   float utl_macF( float f_x1,
-                   float f_x2,
-                   float f_y);
-
    float utl_divF( float f_x1,
                    float f_x2);
 
@@ -356,11 +745,33 @@
 
    int16_t utl_sin16_16( uint16_t s_phase);
 
+   void utl_sincos16_16( uint16_t s_phase,
+                         int16_t *ps_sin,
+                         int16_t *ps_cos);
+
+   void utl_vCos16_16( uint16_t *ps_phase,
+                       int16_t *ps_cos,
+                       int16_t s_length);
+
+   void utl_vSin16_16( uint16_t *ps_phase,
+                       int16_t *ps_sin,
+                       int16_t s_length);
+
+   void utl_vSincos16_16( uint16_t *ps_phase,
+                          int16_t *ps_sin,
+                          int16_t *ps_cos,
+                          int16_t s_length);
+
    uint32_t utl_sqrt32_32( uint32_t i_input,
                            int8_t c_n);
 
    int16_t utl_atan2_16( int16_t s_y, int16_t s_x);
 
+   void utl_vAtan2_16( int16_t *ps_y,
+                       int16_t *ps_x,
+                       int16_t *ps_angle,
+                       int16_t s_length);
+
    bool utl_matMultF( float *pf_mat1,
                       int32_t i_rows1,
                       int32_t i_col1,
@@ -369,6 +780,55 @@
                       int32_t i_col2,
                       float *pf_res);
 
+   bool utl_matMultTransAF( float *pf_mat1,
+                            int32_t i_rows1,
+                            int32_t i_col1,
+                            float *pf_mat2,
+                            int32_t i_rows2,
+                            int32_t i_col2,
+                            float *pf_res);
+
+   void utl_matSyrkF( float *pf_mat,
+                      int32_t i_rows,
+                      int32_t i_col,
+                      float *pf_res,
+                      bool b_fillLower);
+
+   void utl_matSyrF( float *pf_vect,
+                     int32_t i_size,
+                     float *pf_res);
+
+   void utl_matSprF( float *pf_vect,
+                     int32_t i_size,
+                     float *pf_packed);
+
+   void utl_matPackF( float *pf_mat,
+                      int32_t i_size,
+                      float *pf_packed);
+
+   bool utl_matCholF( float *pf_packed,
+                      int32_t i_size);
+
+   void utl_matCholSolveF( float *pf_packed,
+                           int32_t i_size,
+                           float *pf_x);
+
+   bool utl_matLdltF( float *pf_packed,
+                      int32_t i_size);
+
+   void utl_matLdltSolveF( float *pf_packed,
+                           int32_t i_size,
+                           float *pf_x);
+
+   bool utl_matLuF( float *pf_mat,
+                    int32_t i_size,
+                    int8_t *pc_piv);
+
+   void utl_matLuSolveF( float *pf_mat,
+                         int32_t i_size,
+                         int8_t *pc_piv,
+                         float *pf_x);
+
    bool utl_matInvF( float *pf_mat,
                      float *pf_inv,
                      int32_t i_numElements);
@@ -0,0 +1,92 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_mathBench.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Benchmark suites for the math in utilities: the table based
+ *               routines against their CORDIC equivalents, the fixed-point
+ *               multiply primitives, and the FIR and biquad block filters.
+ *               They need nothing from the kernel, so the report is handed
+ *               back one line at a time and the caller writes it wherever it
+ *               likes. The lines follow the header from
+ *               'utl_benchFormatHeader', the same as the kernel suites in
+ *               arb_bench.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_mathBench_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define utl_mathBench_h
+
+   /*------------------------------------------------------------------------*
+    * Operations per sample, samples per suite, and the calls discarded
+    * before sampling starts.
+    *------------------------------------------------------------------------*/
+   #define UTL_MATH_BENCH_ITERATIONS (16)
+   #define UTL_MATH_BENCH_SAMPLES    (15)
+   #define UTL_MATH_BENCH_WARMUP     (2)
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+   #include "utl_bench.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Starts the cycle counter and sets up the filters the suites run.
+    *------------------------------------------------------------------------*/
+   t_benchError utl_mathBenchInit( void);
+
+   /*------------------------------------------------------------------------*
+    * Times suite 'c_suite' and writes its report line to 'pc_buff'. Returns
+    * the number of characters written, 0 once 'c_suite' is past the last
+    * suite, or a negative t_benchError.
+    *------------------------------------------------------------------------*/
+   int16_t utl_mathBenchRun( uint8_t c_suite,
+                             char *pc_buff,
+                             uint16_t s_size);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef utl_mathBench_h*/
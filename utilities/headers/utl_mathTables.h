@@ -0,0 +1,60 @@
+/*---------------------------------------------------------------------------*
+ * Generated by utilities/scripts/utlMathTables.py, do not edit.
+ *
+ * Lookup tables for utl_math.c. The _ERR defines are the max error of
+ * each table in LSBs, rounded up, for the tests to check against.
+ *
+ * sincos   step 2^12   17 entries, max error 618.88 LSB
+ * atan2    step 2^11   17 entries, max error 4.71 LSB
+ * log10    step 2^10   18 entries, max error 7.23 LSB
+ * alog10   step 2^10   11 entries, max error 20.66 LSB
+ *---------------------------------------------------------------------------*/
+#ifndef utl_mathTables_h
+#define utl_mathTables_h
+
+/*---------------------------------------------------------------------------*
+ * 1 = linear, 2 = quadratic interpolation between entries
+ *---------------------------------------------------------------------------*/
+#define UTL_MATH_INTERP_ORDER (1)
+
+#define UTL_MATH_SINCOS_SHFT   (12)
+#define UTL_MATH_SINCOS_TBL_SZ (17)
+#define UTL_MATH_SINCOS_PERIOD (16)
+#define UTL_MATH_SINCOS_ERR    (618.88)
+
+#define UTL_MATH_ATAN2_SHFT   (11)
+#define UTL_MATH_ATAN2_TBL_SZ (17)
+#define UTL_MATH_ATAN2_ERR    (4.72)
+
+#define UTL_MATH_LOG10_SHFT   (10)
+#define UTL_MATH_LOG10_TBL_SZ (18)
+#define UTL_MATH_LOG10_ERR    (7.24)
+
+#define UTL_MATH_ALOG10_SHFT   (10)
+#define UTL_MATH_ALOG10_TBL_SZ (11)
+#define UTL_MATH_ALOG10_ERR    (20.66)
+
+static const int16_t gas_cosTbl[UTL_MATH_SINCOS_TBL_SZ] PROGMEM =
+{
+   32767, 30274, 23170, 12540, 0, -12540, -23170, -30274, -32768, -30274,
+   -23170, -12540, 0, 12540, 23170, 30274, 32767
+};
+
+static const uint16_t gas_atan2Tbl[UTL_MATH_ATAN2_TBL_SZ] PROGMEM =
+{
+   0, 651, 1297, 1933, 2555, 3159, 3742, 4302, 4836, 5344, 5826, 6282, 6712,
+   7117, 7498, 7856, 8192
+};
+
+static const int16_t gas_log10Tbl[UTL_MATH_LOG10_TBL_SZ] PROGMEM =
+{
+   -9864, -9001, -8188, -7419, -6689, -5994, -5332, -4700, -4094, -3513,
+   -2955, -2418, -1900, -1401, -918, -452, 0, 438
+};
+
+static const uint16_t gas_alog10Tbl[UTL_MATH_ALOG10_TBL_SZ] PROGMEM =
+{
+   16384, 17607, 18920, 20332, 21849, 23479, 25230, 27113, 29136, 31309, 33645
+};
+
+#endif/*End #ifndef utl_mathTables_h*/
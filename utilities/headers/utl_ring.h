@@ -0,0 +1,283 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_ring.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : A power-of-two sized variant of the circular buffers found in
+ *               utl_buffer.h. The read and write indices are free-running
+ *               16-bit counters that are only masked when the storage is
+ *               accessed, so wrapping costs an AND instead of a compare and
+ *               branch, and the fill level is simply 'wr - rd'. Since the
+ *               producer only ever writes 's_wrIndex' and the consumer only
+ *               ever writes 's_rdIndex', a single ISR producer and a single
+ *               thread consumer (or vice versa) don't need a critical
+ *               section.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_ring_h
+
+   #ifdef __cplusplus
+   extern "C" {
+   #endif
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define utl_ring_h
+
+   /*------------------------------------------------------------------------*
+    * The largest ring the 16-bit free-running indices can describe.
+    *------------------------------------------------------------------------*/
+   #define UTL_RING_MAX_SIZE (32768)
+
+   #define UTL_RING_IS_POW2(s) (((s) != 0) && (((s) & ((s) - 1)) == 0))
+
+   /*------------------------------------------------------------------------*
+    * Keeps the compiler from moving accesses to the storage area past an
+    * index update, which would publish bytes before they are written.
+    *------------------------------------------------------------------------*/
+   #define UTL_RING_BARRIER() __asm__ __volatile__( "" ::: "memory")
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include "avr_compiler.h"
+
+   /*------------------------------------------------------------------------*
+    * Global Typedefs
+    *------------------------------------------------------------------------*/
+   typedef enum
+   {
+
+      RING_INVALID_SIZE = -3, /*Size isn't a power of two*/
+      RING_NULL_PTR     = -2, /*Pointer is not mapped to a valid address.*/
+      RING_OUT_OF_HEAP  = -1, /*No more memory.*/
+      RING_PASSED       = 0   /*Configuration good.*/
+
+   }t_ringError;
+
+   typedef struct
+   {
+
+      /*---------------------------------------------------------------------*
+       * Total number of bytes ever written, only modified by the producer.
+       *---------------------------------------------------------------------*/
+      volatile uint16_t s_wrIndex;
+
+      /*---------------------------------------------------------------------*
+       * Total number of bytes ever read, only modified by the consumer.
+       *---------------------------------------------------------------------*/
+      volatile uint16_t s_rdIndex;
+
+      /*---------------------------------------------------------------------*
+       * The size of the ring in bytes minus one.
+       *---------------------------------------------------------------------*/
+      uint16_t s_mask;
+
+      /*---------------------------------------------------------------------*
+       * Pointer to the storage area.
+       *---------------------------------------------------------------------*/
+      int8_t *pc_buffer;
+
+   }t_ring;
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Returns a consistent copy of an index that may be changing underneath
+    * us. On an 8-bit machine a 16-bit load takes two instructions, and an
+    * interrupt updating the index between them would give a torn value.
+    *------------------------------------------------------------------------*/
+   static inline uint16_t __attribute__((always_inline)) \
+   utl_ringLoadIndex( volatile uint16_t *ps_index)
+   {
+      uint16_t s_index;
+
+      do
+      {
+         s_index = *ps_index;
+      }while( s_index != *ps_index);
+
+      return s_index;
+
+   }/*End utl_ringLoadIndex*/
+
+   static inline uint16_t __attribute__((always_inline)) \
+   utl_ringGetSize( const t_ring *pt_ring)
+   {
+      return pt_ring->s_mask + 1;
+   }/*End utl_ringGetSize*/
+
+   static inline uint16_t __attribute__((always_inline)) \
+   utl_ringGetFullLevel( t_ring *pt_ring)
+   {
+      return utl_ringLoadIndex( &pt_ring->s_wrIndex) -
+      utl_ringLoadIndex( &pt_ring->s_rdIndex);
+   }/*End utl_ringGetFullLevel*/
+
+   static inline uint16_t __attribute__((always_inline)) \
+   utl_ringGetEmptyLevel( t_ring *pt_ring)
+   {
+      return (pt_ring->s_mask + 1) - utl_ringGetFullLevel( pt_ring);
+   }/*End utl_ringGetEmptyLevel*/
+
+   static inline bool __attribute__((always_inline)) \
+   utl_ringIsEmpty( t_ring *pt_ring)
+   {
+      return (bool)(utl_ringGetFullLevel( pt_ring) == 0);
+   }/*End utl_ringIsEmpty*/
+
+   static inline bool __attribute__((always_inline)) \
+   utl_ringIsFull( t_ring *pt_ring)
+   {
+      return (bool)(utl_ringGetFullLevel( pt_ring) > pt_ring->s_mask);
+   }/*End utl_ringIsFull*/
+
+   /*------------------------------------------------------------------------*
+    * Adds a byte to the ring if there is room, returns false otherwise. Meant
+    * to be called once per byte from a receive ISR.
+    *------------------------------------------------------------------------*/
+   static inline bool __attribute__((always_inline)) \
+   utl_ringWriteByte( t_ring *pt_ring,
+                      int8_t c_byte)
+   {
+      uint16_t s_wrIndex = pt_ring->s_wrIndex;
+
+      if( (uint16_t)(s_wrIndex - utl_ringLoadIndex( &pt_ring->s_rdIndex)) >
+      pt_ring->s_mask)
+      {
+         return false;
+      }
+
+      pt_ring->pc_buffer[s_wrIndex & pt_ring->s_mask] = c_byte;
+      UTL_RING_BARRIER();
+      pt_ring->s_wrIndex = s_wrIndex + 1;
+
+      return true;
+
+   }/*End utl_ringWriteByte*/
+
+   /*------------------------------------------------------------------------*
+    * Removes a byte from the ring, the caller must make sure the ring isn't
+    * empty.
+    *------------------------------------------------------------------------*/
+   static inline int8_t __attribute__((always_inline)) \
+   utl_ringReadByte( t_ring *pt_ring)
+   {
+      uint16_t s_rdIndex = pt_ring->s_rdIndex;
+      int8_t c_byte;
+
+      c_byte = pt_ring->pc_buffer[s_rdIndex & pt_ring->s_mask];
+      UTL_RING_BARRIER();
+      pt_ring->s_rdIndex = s_rdIndex + 1;
+
+      return c_byte;
+
+   }/*End utl_ringReadByte*/
+
+   /*------------------------------------------------------------------------*
+    * Marks 's_size' bytes of the span returned by 'utl_ringPeekWrite' as
+    * written.
+    *------------------------------------------------------------------------*/
+   static inline void __attribute__((always_inline)) \
+   utl_ringCommitWrite( t_ring *pt_ring,
+                        uint16_t s_size)
+   {
+      UTL_RING_BARRIER();
+      pt_ring->s_wrIndex += s_size;
+   }/*End utl_ringCommitWrite*/
+
+   /*------------------------------------------------------------------------*
+    * Marks 's_size' bytes of the span returned by 'utl_ringPeekRead' as
+    * consumed.
+    *------------------------------------------------------------------------*/
+   static inline void __attribute__((always_inline)) \
+   utl_ringCommitRead( t_ring *pt_ring,
+                       uint16_t s_size)
+   {
+      UTL_RING_BARRIER();
+      pt_ring->s_rdIndex += s_size;
+   }/*End utl_ringCommitRead*/
+
+   /*------------------------------------------------------------------------*
+    * Global Function Prototypes
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Attaches caller supplied storage of 's_sizeBytes' (a power of two) to
+    * the ring.
+    *------------------------------------------------------------------------*/
+   t_ringError utl_ringInit( t_ring *pt_ring,
+                             int8_t *pc_storage,
+                             uint16_t s_sizeBytes);
+
+   /*------------------------------------------------------------------------*
+    * Same as 'utl_ringInit' except the storage is taken from the heap.
+    *------------------------------------------------------------------------*/
+   t_ringError utl_createRing( t_ring *pt_ring,
+                               uint16_t s_sizeBytes);
+
+   void utl_destroyRing( t_ring *pt_ring);
+
+   void utl_resetRing( t_ring *pt_ring);
+
+   /*------------------------------------------------------------------------*
+    * Copies up to 's_size' bytes into the ring using at most two memcpy's.
+    * Returns the number of bytes actually written.
+    *------------------------------------------------------------------------*/
+   uint16_t utl_ringWriteBlock( t_ring *pt_ring,
+                                const int8_t *pc_buff,
+                                uint16_t s_size);
+
+   /*------------------------------------------------------------------------*
+    * Copies up to 's_size' bytes out of the ring using at most two memcpy's.
+    * Returns the number of bytes actually read.
+    *------------------------------------------------------------------------*/
+   uint16_t utl_ringReadBlock( t_ring *pt_ring,
+                               int8_t *pc_buff,
+                               uint16_t s_size);
+
+   /*------------------------------------------------------------------------*
+    * Returns the largest contiguous region that can be written without
+    * wrapping ('*ppc_span' points to its start). Meant for handing space to
+    * a DMA channel, follow up with 'utl_ringCommitWrite'.
+    *------------------------------------------------------------------------*/
+   uint16_t utl_ringPeekWrite( t_ring *pt_ring,
+                               int8_t **ppc_span);
+
+   /*------------------------------------------------------------------------*
+    * Returns the largest contiguous region that can be read without
+    * wrapping ('*ppc_span' points to its start). Follow up with
+    * 'utl_ringCommitRead'.
+    *------------------------------------------------------------------------*/
+   uint16_t utl_ringPeekRead( t_ring *pt_ring,
+                              int8_t **ppc_span);
+
+   #ifdef __cplusplus
+   }/*End extern "C"*/
+   #endif
+
+#endif/*End #ifndef utl_ring_h*/
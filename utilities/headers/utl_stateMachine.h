@@ -20,9 +20,13 @@
  *               <https://code.google.com/p/arbitros/>
  *
  * Description : This file provides an abstraction layer for the
- *               implementation of a state-machine.
+ *               implementation of a state-machine. A machine is described by
+ *               a constant table of states (kept in flash) where each entry
+ *               holds the state's actions, its parent state and a bitmask of
+ *               the states it may transition to. The only RAM needed is the
+ *               't_stateMachine' object itself.
  *
- * Last Update : Oct 27, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 #ifndef utl_stateMachine_h
 
@@ -35,6 +39,22 @@
     *------------------------------------------------------------------------*/
    #define utl_stateMachine_h
 
+   /*------------------------------------------------------------------------*
+    * The transition rules for a state are stored as a 32-bit mask.
+    *------------------------------------------------------------------------*/
+   #define UTL_STMN_MAX_STATES (32)
+
+   /*------------------------------------------------------------------------*
+    * The deepest a state can be nested underneath top-level states.
+    *------------------------------------------------------------------------*/
+   #define UTL_STMN_MAX_DEPTH  (4)
+
+   /*------------------------------------------------------------------------*
+    * Used for the parent of a top-level state and as the 'previous state' of
+    * a machine that hasn't run yet.
+    *------------------------------------------------------------------------*/
+   #define UTL_STMN_NO_STATE   (0xFF)
+
    /*------------------------------------------------------------------------*
     * Include Files
     *------------------------------------------------------------------------*/
@@ -45,67 +65,164 @@
     *------------------------------------------------------------------------*/
    typedef enum
    {
-      STMN_INVALID_STATE  = -4, /*State out of range*/
-      STMN_INVALID_TRANS  = -3, /*An invalid transition was requested*/
-      STMN_INVALID_HANDLE = -2, /*Handle doesn't map to an open state-machine*/
-      STMN_OUT_OF_HEAP    = -1, /*No more memory.*/
-      STMN_PASSED         = 0   /*Configuration good.*/
+      STMN_INVALID_STATE = -3, /*State out of range or badly nested*/
+      STMN_INVALID_TRANS = -2, /*An invalid transition was requested*/
+      STMN_NULL_PTR      = -1, /*Pointer is not mapped to a valid address.*/
+      STMN_PASSED        = 0   /*Configuration good.*/
 
    }t_stmnError;
 
-   typedef volatile int16_t t_STMNHNDL; /*Handle to a particular
-                                          state-machine*/
+   /*------------------------------------------------------------------------*
+    * Signature for all state actions. The run action is passed the state the
+    * machine was in on the previous call to 'utl_stMnEngine', the entry
+    * action the state being left and the exit action the state being
+    * entered.
+    *------------------------------------------------------------------------*/
+   typedef void (*t_stMnAction)( int32_t i_stateData,
+                                 uint8_t c_state);
+
+   typedef struct
+   {
+      /*---------------------------------------------------------------------*
+       * Called on every pass through 'utl_stMnEngine' while the machine is in
+       * this state. If NULL, the nearest parent's run action is used.
+       *---------------------------------------------------------------------*/
+      t_stMnAction pf_run;
+
+      /*---------------------------------------------------------------------*
+       * Called once when the state is entered, can be NULL.
+       *---------------------------------------------------------------------*/
+      t_stMnAction pf_entry;
+
+      /*---------------------------------------------------------------------*
+       * Called once when the state is left, can be NULL.
+       *---------------------------------------------------------------------*/
+      t_stMnAction pf_exit;
+
+      /*---------------------------------------------------------------------*
+       * One bit for each state that can be reached from this one. Bits set
+       * in a parent's mask apply to all of its children.
+       *---------------------------------------------------------------------*/
+      uint32_t i_transMask;
+
+      /*---------------------------------------------------------------------*
+       * The enclosing state or UTL_STMN_NO_STATE.
+       *---------------------------------------------------------------------*/
+      uint8_t c_parent;
+
+   }t_stMnState;
+
+   typedef struct
+   {
+      /*---------------------------------------------------------------------*
+       * The state table, which lives in program memory.
+       *---------------------------------------------------------------------*/
+      const t_stMnState *pt_states;
+
+      /*---------------------------------------------------------------------*
+       * The number of entries in 'pt_states'.
+       *---------------------------------------------------------------------*/
+      uint8_t c_numStates;
+
+      /*---------------------------------------------------------------------*
+       * The state requested by the last call to 'utl_stMnChangeState'.
+       *---------------------------------------------------------------------*/
+      uint8_t c_nextState;
+
+      /*---------------------------------------------------------------------*
+       * The current state executing.
+       *---------------------------------------------------------------------*/
+      uint8_t c_currState;
+
+      /*---------------------------------------------------------------------*
+       * The last state that executed.
+       *---------------------------------------------------------------------*/
+      uint8_t c_prevState;
+
+      /*---------------------------------------------------------------------*
+       * Data passed into a particular state.
+       *---------------------------------------------------------------------*/
+      int32_t i_stateData;
+
+   }t_stateMachine;
+
+   /*------------------------------------------------------------------------*
+    * Global Macros
+    *------------------------------------------------------------------------*/
 
    /*------------------------------------------------------------------------*
-    * Global Variables
+    * Returns the transition mask bit for state 'c_state'.
     *------------------------------------------------------------------------*/
+   #define UTL_STMN_TRANS( c_state) ((uint32_t)1 << (c_state))
 
    /*------------------------------------------------------------------------*
-    * Global Inline functions
+    * Builds one entry of a state table, i.e.
+    *
+    * UTL_STMN_CREATE_TABLE( gat_states, NUM_STATES) =
+    * {
+    *    [IDLE] = UTL_STMN_STATE( &idle, NULL, NULL, UTL_STMN_NO_STATE,
+    *                             UTL_STMN_TRANS( IDLE) |
+    *                             UTL_STMN_TRANS( RUN)),
+    *    ...
+    * };
     *------------------------------------------------------------------------*/
+   #define UTL_STMN_STATE( pf_run, pf_entry, pf_exit, c_parent, i_mask)\
+      {(pf_run), (pf_entry), (pf_exit), (i_mask), (c_parent)}
 
    /*------------------------------------------------------------------------*
-    * Global Function Prototypes
+    * Declares a state table of 'c_numStates' entries in program memory. The
+    * typedef fails to compile if the table is too large.
     *------------------------------------------------------------------------*/
+   #define UTL_STMN_CREATE_TABLE( name, c_numStates)\
+      typedef char name##SizeCheck[((c_numStates) <= UTL_STMN_MAX_STATES) ?\
+      1 : -1];\
+      static const t_stMnState name[(c_numStates)] PROGMEM
 
    /*------------------------------------------------------------------------*
-    * This function transitions the state-machine object defined by
-    * 't_handle' to a new state given by 'c_newState'.
+    * Global Variables
     *------------------------------------------------------------------------*/
-   t_stmnError utl_stMnChangeState( t_STMNHNDL t_handle,
-                                    int8_t c_newState,
-                                    int32_t i_stateData);
 
    /*------------------------------------------------------------------------*
-    * This function vectors to the specific states as defined by 't_handle'.
+    * Global Inline functions
     *------------------------------------------------------------------------*/
-   t_stmnError utl_stMnEngine( t_STMNHNDL t_handle);
+   static inline uint8_t __attribute__((always_inline)) \
+   utl_stMnGetState( const t_stateMachine *pt_stMn)
+   {
+      return pt_stMn->c_currState;
+   }/*End utl_stMnGetState*/
 
    /*------------------------------------------------------------------------*
-    * Creates a state-machine object with 'c_numStates' number of states.
+    * Global Function Prototypes
     *------------------------------------------------------------------------*/
-   t_STMNHNDL utl_requestStMnObject( uint8_t c_numStates,
-                                     uint8_t c_startingState);
 
    /*------------------------------------------------------------------------*
-    * Releases a state-machine object from memory.
+    * Attaches the state table 'pt_states' to 'pt_stMn', checking that every
+    * parent index is valid and no state is nested deeper than
+    * UTL_STMN_MAX_DEPTH. The machine enters 'c_startState' on the first call
+    * to 'utl_stMnEngine'.
     *------------------------------------------------------------------------*/
-   t_stmnError utl_releaseStMnObject( t_STMNHNDL t_handle);
+   t_stmnError utl_stMnInit( t_stateMachine *pt_stMn,
+                             const t_stMnState *pt_states,
+                             uint8_t c_numStates,
+                             uint8_t c_startState);
 
    /*------------------------------------------------------------------------*
-    * Populates the state-machine function map with the particular call-back
-    * function requested for a given state.
+    * This function requests that the state-machine 'pt_stMn' move to a new
+    * state given by 'c_newState' the next time 'utl_stMnEngine' is called.
+    * The transition is allowed if 'c_newState' is set in the mask of the
+    * current state or any of its parents. Not thread safe, callers sharing a
+    * machine need to protect it.
     *------------------------------------------------------------------------*/
-   t_stmnError utl_stMnPopFunMap( t_STMNHNDL t_handle,
-                                  void (*pf_funPtr)( int32_t, uint8_t),
-                                  uint8_t c_state);
+   t_stmnError utl_stMnChangeState( t_stateMachine *pt_stMn,
+                                    uint8_t c_newState,
+                                    int32_t i_stateData);
 
    /*------------------------------------------------------------------------*
-    * Populates the state-machine transition map which defines the rules for
-    * moving between states.
+    * Performs any pending transition (exit actions up to the common parent,
+    * then entry actions down to the new state) and calls the run action of
+    * the current state.
     *------------------------------------------------------------------------*/
-   t_stmnError utl_stMnPopTransMap( t_STMNHNDL t_handle,
-                                    uint8_t *pc_transMap);
+   t_stmnError utl_stMnEngine( t_stateMachine *pt_stMn);
 
    #ifdef __cplusplus
    }/*End extern "C"*/
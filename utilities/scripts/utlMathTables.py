@@ -0,0 +1,275 @@
+#-------------------------------------------------------------------------------
+# Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+#
+# Generates the lookup tables used by utl_math.c (cos, atan2, log10 and
+# alog10) as a header of PROGMEM arrays.
+#
+#   python utlMathTables.py [options] --out utl_mathTables.h
+#   python utlMathTables.py --report
+#
+# Each table's step size is given as a shift, the table covers its input
+# range in steps of 2^shift so a smaller shift means a bigger and more
+# accurate table. '--order' picks linear or quadratic interpolation between
+# the entries, quadratic needs one more entry per table and a few more
+# multiplies per lookup.
+#
+# The max error of every table is found by running the same integer
+# interpolation as utl_math.c over every input and comparing against the
+# exact function, in LSBs of the Q15 result. '--report' lists it for every
+# shift and order so a product can pick its trade between flash, accuracy
+# and speed.
+#
+# The copy of the header in utilities/headers is generated with the
+# defaults, the host and simavr builds generate their own from the options
+# they are configured with.
+#-------------------------------------------------------------------------------
+import argparse
+import math
+import sys
+
+#-------------------------------------------------------------------------------
+# round((2^15*log10(2))), the lower bound of the log10 and alog10 tables.
+#-------------------------------------------------------------------------------
+LOG10_OF_2 = 9864
+
+#-------------------------------------------------------------------------------
+# Defaults, these are the tables utl_math.c was originally written with.
+#-------------------------------------------------------------------------------
+DEFAULTS = {'sincos': 12, 'atan2': 11, 'log10': 10, 'alog10': 10}
+DEFAULT_ORDER = 1
+
+def toInt16( x):
+   x = x & 0xFFFF
+   return x - 0x10000 if x & 0x8000 else x
+
+def rShft32_16( x, n):
+   #----------------------------------------------------------------------------
+   # Mirrors utl_rShft32_16, the magnitude is shifted and the sign restored.
+   #----------------------------------------------------------------------------
+   y = toInt16( abs( x) >> n)
+   return -y if x < 0 else y
+
+def linInterp( frac, step, y0, y1):
+   #----------------------------------------------------------------------------
+   # Mirrors utl_linInterp32_32 with i_x0 = 0.
+   #----------------------------------------------------------------------------
+   return y0 + rShft32_16( toInt16( y1 - y0)*toInt16( frac), step)
+
+def quadInterp( frac, step, y0, y1, y2):
+   #----------------------------------------------------------------------------
+   # Mirrors utl_quadInterp16_16 with s_x0 = 0 and s_x1 = 2^step, the entries
+   # are passed as int16_t so an unsigned table wraps and is unwrapped by the
+   # caller.
+   #----------------------------------------------------------------------------
+   y0 = toInt16( y0)
+   b1 = toInt16( toInt16( y1) - y0)
+   b2 = toInt16( (toInt16( toInt16( y2) - toInt16( y1)) - b1 + 1) >> 1)
+   temp = rShft32_16( b2*(frac - (1 << step)), step)
+   return toInt16( y0 + rShft32_16( frac*(b1 + temp), step))
+
+#-------------------------------------------------------------------------------
+# Each table is described by the exact function in Q15, where its first
+# entry sits, the span of inputs the code looks up, and the C type of its
+# entries. 'first' and 'span' are in the units of the table's input.
+#-------------------------------------------------------------------------------
+class Table( object):
+   def __init__( self, key, name, ctype, function, first, span, limits,
+                 minShift, maxShift, periodic=False):
+      self.key = key
+      self.name = name
+      self.ctype = ctype
+      self.function = function
+      self.first = first
+      self.span = span
+      self.limits = limits
+      self.minShift = minShift
+      self.maxShift = maxShift
+      self.periodic = periodic
+
+   def length( self, shift, order):
+      #-------------------------------------------------------------------------
+      # The last looked up index plus the entries the interpolation reads
+      # past it.
+      #-------------------------------------------------------------------------
+      return ((self.span - 1) >> shift) + 1 + order
+
+   def entries( self, shift, order):
+      low, high = self.limits
+      values = []
+      for k in range( self.length( shift, order)):
+         y = int( math.floor( self.function( self.first + (k << shift)) + 0.5))
+         values.append( min( max( y, low), high))
+      return values
+
+   def lookup( self, values, shift, order, x):
+      offset = x - self.first
+      index = offset >> shift
+      frac = offset & ((1 << shift) - 1)
+      if order == 2:
+         y = quadInterp( frac, shift, values[index], values[index + 1],
+                         values[index + 2])
+         return y if self.ctype == 'int16_t' else y & 0xFFFF
+      return linInterp( frac, shift, values[index], values[index + 1])
+
+   def maxError( self, shift, order):
+      values = self.entries( shift, order)
+
+      #-------------------------------------------------------------------------
+      # The step between two entries has to fit the 16-bit difference taken
+      # by utl_linInterp32_32.
+      #-------------------------------------------------------------------------
+      for k in range( len( values) - 1):
+         if abs( values[k + 1] - values[k]) > 32767:
+            return None
+
+      low, high = self.limits
+      error = 0.0
+      for x in range( self.first, self.first + self.span):
+         exact = min( max( self.function( x), low), high)
+         error = max( error, abs( self.lookup( values, shift, order, x) -
+                      exact))
+
+      return error
+
+TABLES = [
+   #----------------------------------------------------------------------------
+   # cos of a Q0.16 phase, 2*pi = 65536. The fused sin/cos lookup indexes
+   # it a quarter period back, so it always covers a whole period.
+   #----------------------------------------------------------------------------
+   Table( 'sincos', 'gas_cosTbl', 'int16_t',
+          lambda x: 32768.0*math.cos( 2.0*math.pi*x/65536.0),
+          0, 65536, (-32768, 32767), 6, 13, periodic=True),
+   #----------------------------------------------------------------------------
+   # atan(x) of 0 <= x < 1 in Q15, pi = 32768.
+   #----------------------------------------------------------------------------
+   Table( 'atan2', 'gas_atan2Tbl', 'uint16_t',
+          lambda x: 32768.0*math.atan( x/32768.0)/math.pi,
+          0, 32768, (0, 65535), 6, 14),
+   #----------------------------------------------------------------------------
+   # log10(z) of .5 <= z <= 1 in Q15, z is exactly 1 when utl_log10_32 is
+   # handed a power of two below .5.
+   #----------------------------------------------------------------------------
+   Table( 'log10', 'gas_log10Tbl', 'int16_t',
+          lambda x: 32768.0*math.log10( x/32768.0),
+          16384, 16385, (-32768, 32767), 6, 13),
+   #----------------------------------------------------------------------------
+   # 10^x of -log10(2) <= x <= 0 in Q15.
+   #----------------------------------------------------------------------------
+   Table( 'alog10', 'gas_alog10Tbl', 'uint16_t',
+          lambda x: 32768.0*math.pow( 10.0, x/32768.0),
+          -LOG10_OF_2, LOG10_OF_2 + 1, (0, 65535), 6, 13)
+]
+
+DEFINES = {'sincos': 'UTL_MATH_SINCOS', 'atan2': 'UTL_MATH_ATAN2',
+           'log10': 'UTL_MATH_LOG10', 'alog10': 'UTL_MATH_ALOG10'}
+
+def formatTable( table, shift, order):
+   values = table.entries( shift, order)
+   lines = []
+   line = '  '
+   for k, value in enumerate( values):
+      text = ' %d' % value + (',' if k < len( values) - 1 else '')
+      if len( line) + len( text) > 78:
+         lines.append( line)
+         line = '  '
+      line += text
+   lines.append( line)
+
+   return ('static const %s %s[%s_TBL_SZ] PROGMEM =\n{\n%s\n};\n' %
+           (table.ctype, table.name, DEFINES[table.key], '\n'.join( lines)))
+
+def writeHeader( path, shifts, order, errors):
+   out = []
+   out.append( '/*' + '-'*75 + '*')
+   out.append( ' * Generated by utilities/scripts/utlMathTables.py, do not edit.')
+   out.append( ' *')
+   out.append( ' * Lookup tables for utl_math.c. The _ERR defines are the max error of')
+   out.append( ' * each table in LSBs, rounded up, for the tests to check against.')
+   out.append( ' *')
+   for table in TABLES:
+      out.append( ' * %-8s step 2^%-2d %4d entries, max error %.2f LSB' %
+                  (table.key, shifts[table.key], table.length(
+                  shifts[table.key], order), errors[table.key]))
+   out.append( ' *' + '-'*75 + '*/')
+   out.append( '#ifndef utl_mathTables_h')
+   out.append( '#define utl_mathTables_h')
+   out.append( '')
+   out.append( '/*' + '-'*75 + '*')
+   out.append( ' * 1 = linear, 2 = quadratic interpolation between entries')
+   out.append( ' *' + '-'*75 + '*/')
+   out.append( '#define UTL_MATH_INTERP_ORDER (%d)' % order)
+   out.append( '')
+   for table in TABLES:
+      define = DEFINES[table.key]
+      out.append( '#define %s_SHFT   (%d)' % (define, shifts[table.key]))
+      out.append( '#define %s_TBL_SZ (%d)' % (define, table.length(
+                  shifts[table.key], order)))
+      if table.periodic:
+         out.append( '#define %s_PERIOD (%d)' % (define,
+                     table.span >> shifts[table.key]))
+      out.append( '#define %s_ERR    (%.2f)' % (define, math.ceil(
+                  errors[table.key]*100.0)/100.0))
+      out.append( '')
+   for table in TABLES:
+      out.append( formatTable( table, shifts[table.key], order))
+   out.append( '#endif/*End #ifndef utl_mathTables_h*/')
+
+   with open( path, 'w') as f:
+      f.write( '\n'.join( out) + '\n')
+
+def report( order):
+   sys.stdout.write( '%-8s %5s %5s %7s %6s %10s\n' % ('table', 'order',
+                     'shift', 'entries', 'bytes', 'max error'))
+   for table in TABLES:
+      orders = [order] if order else [1, 2]
+      for o in orders:
+         for shift in range( table.maxShift, table.minShift - 1, -1):
+            error = table.maxError( shift, o)
+            if error is None:
+               continue
+            length = table.length( shift, o)
+            sys.stdout.write( '%-8s %5d %5d %7d %6d %10.2f\n' % (table.key,
+                              o, shift, length, 2*length, error))
+
+def main():
+   parser = argparse.ArgumentParser(
+            description='Generate the utl_math lookup tables.')
+   for table in TABLES:
+      parser.add_argument( '--%s-shft' % table.key, type=int,
+                           default=DEFAULTS[table.key],
+                           help='%s table step as a power of two (%d to %d)'
+                           % (table.key, table.minShift, table.maxShift))
+   parser.add_argument( '--order', type=int, choices=[1, 2], default=None,
+                        help='1 = linear, 2 = quadratic interpolation')
+   parser.add_argument( '--out', help='header to write')
+   parser.add_argument( '--report', action='store_true',
+                        help='list the max error of every configuration')
+   args = parser.parse_args()
+
+   if args.report:
+      report( args.order)
+      return 0
+
+   if not args.out:
+      parser.error( 'no output given')
+
+   order = args.order if args.order else DEFAULT_ORDER
+   shifts = {}
+   errors = {}
+   for table in TABLES:
+      shift = getattr( args, '%s_shft' % table.key)
+      if shift < table.minShift or shift > table.maxShift:
+         parser.error( '%s shift must be %d to %d' % (table.key,
+                       table.minShift, table.maxShift))
+      errors[table.key] = table.maxError( shift, order)
+      if errors[table.key] is None:
+         parser.error( '%s shift %d steps more than 16 bits' % (table.key,
+                       shift))
+      shifts[table.key] = shift
+
+   writeHeader( args.out, shifts, order, errors)
+
+   return 0
+
+if __name__ == '__main__':
+   sys.exit( main())
@@ -0,0 +1,297 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_bench.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for timing benchmark cases and
+ *               reducing their samples to min/median/max statistics.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "utl_bench.h"
+#include "hal_clocks.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Number of empty calls timed when measuring the overhead.
+ *---------------------------------------------------------------------------*/
+#define BENCH_CAL_SAMPLES (16)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void utl_benchEmpty( void *pv_arg,
+                            uint16_t s_iterations) __attribute__ ((noinline));
+
+static uint32_t utl_benchSample( const t_benchCase *pt_case);
+
+static int16_t utl_benchFormatCycles( char *pc_buff,
+                                      uint16_t s_size,
+                                      uint32_t i_cycles,
+                                      uint16_t s_iterations);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Cycles taken to time a call that does nothing, 0xFFFFFFFF until
+ * 'utl_benchInit' has been called.
+ *---------------------------------------------------------------------------*/
+static uint32_t gi_overhead = 0xFFFFFFFF;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void utl_benchEmpty( void *pv_arg,
+                            uint16_t s_iterations)
+{
+   /*------------------------------------------------------------------------*
+    * Keeps the call from being optimized away.
+    *------------------------------------------------------------------------*/
+   __asm__ __volatile__( "" ::: "memory");
+
+}/*End utl_benchEmpty*/
+
+static uint32_t utl_benchSample( const t_benchCase *pt_case)
+{
+   uint32_t i_start;
+
+   i_start = hal_getCycleCount();
+
+   pt_case->pf_run( pt_case->pv_arg,
+                    pt_case->s_iterations);
+
+   return hal_getCycleCount() - i_start;
+
+}/*End utl_benchSample*/
+
+static int16_t utl_benchFormatCycles( char *pc_buff,
+                                      uint16_t s_size,
+                                      uint32_t i_cycles,
+                                      uint16_t s_iterations)
+{
+   uint32_t i_whole;
+   uint32_t i_tenths;
+
+   /*------------------------------------------------------------------------*
+    * Rounded to the nearest tenth of a cycle without using floating point.
+    * Only the remainder is scaled, so a sample near the top of the 32 bit
+    * range doesn't wrap.
+    *------------------------------------------------------------------------*/
+   i_whole  = i_cycles / s_iterations;
+   i_tenths = ((i_cycles % s_iterations)*10 + (s_iterations >> 1)) /
+   s_iterations;
+
+   if( i_tenths == 10)
+   {
+      i_whole++;
+      i_tenths = 0;
+   }
+
+   return (int16_t)snprintf( pc_buff,
+                             s_size,
+                             ",%lu.%lu",
+                             (unsigned long)i_whole,
+                             (unsigned long)i_tenths);
+
+}/*End utl_benchFormatCycles*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_benchError utl_benchInit( void)
+{
+   t_benchCase t_empty;
+   uint32_t i_cycles;
+   uint8_t c_index;
+
+   if( hal_startCycleCounter() < 0)
+      return BENCH_COUNTER_BUSY;
+
+   t_empty.pc_name      = "empty";
+   t_empty.pf_run       = &utl_benchEmpty;
+   t_empty.pv_arg       = NULL;
+   t_empty.s_iterations = 1;
+
+   /*------------------------------------------------------------------------*
+    * The smallest time is the one no interrupt landed in.
+    *------------------------------------------------------------------------*/
+   gi_overhead = 0xFFFFFFFF;
+   for( c_index = 0; c_index < BENCH_CAL_SAMPLES; c_index++)
+   {
+      i_cycles = utl_benchSample( &t_empty);
+      if( i_cycles < gi_overhead)
+         gi_overhead = i_cycles;
+   }
+
+   return BENCH_PASSED;
+
+}/*End utl_benchInit*/
+
+t_benchError utl_benchRun( const t_benchCase *pt_case,
+                           t_benchResult *pt_result)
+{
+   uint32_t ai_samples[UTL_BENCH_MAX_SAMPLES];
+   uint32_t i_cycles;
+   uint8_t c_index;
+   uint8_t c_pos;
+   uint8_t c_mid;
+   t_benchError t_err;
+
+   if( (pt_case == NULL) || (pt_result == NULL) || (pt_case->pf_run ==
+   NULL))
+   {
+      return BENCH_NULL_PTR;
+   }
+
+   if( (pt_case->c_samples == 0) || (pt_case->c_samples >
+   UTL_BENCH_MAX_SAMPLES) || (pt_case->s_iterations == 0))
+   {
+      return BENCH_INVALID_SAMPLES;
+   }
+
+   if( gi_overhead == 0xFFFFFFFF)
+   {
+      t_err = utl_benchInit();
+      if( t_err < 0)
+         return t_err;
+   }
+
+   for( c_index = 0; c_index < pt_case->c_warmup; c_index++)
+      utl_benchSample( pt_case);
+
+   /*------------------------------------------------------------------------*
+    * Take the samples, inserting each one in order so the statistics can be
+    * read straight off the array.
+    *------------------------------------------------------------------------*/
+   ai_samples[0] = 0;
+   for( c_index = 0; c_index < pt_case->c_samples; c_index++)
+   {
+      i_cycles = utl_benchSample( pt_case);
+      if( i_cycles > gi_overhead)
+         i_cycles -= gi_overhead;
+      else
+         i_cycles = 0;
+
+      c_pos = c_index;
+      while( (c_pos > 0) && (ai_samples[c_pos - 1] > i_cycles))
+      {
+         ai_samples[c_pos] = ai_samples[c_pos - 1];
+         c_pos--;
+      }
+
+      ai_samples[c_pos] = i_cycles;
+
+   }/*End for( c_index = 0; c_index < pt_case->c_samples; c_index++)*/
+
+   c_mid = pt_case->c_samples >> 1;
+
+   pt_result->i_min = ai_samples[0];
+   pt_result->i_max = ai_samples[pt_case->c_samples - 1];
+   if( pt_case->c_samples & 1)
+      pt_result->i_median = ai_samples[c_mid];
+   else
+      pt_result->i_median = (ai_samples[c_mid - 1] >> 1) +
+      (ai_samples[c_mid] >> 1) + (ai_samples[c_mid - 1] & ai_samples[c_mid]
+      & 1);
+
+   pt_result->i_overhead   = gi_overhead;
+   pt_result->s_iterations = pt_case->s_iterations;
+   pt_result->c_samples    = pt_case->c_samples;
+
+   return BENCH_PASSED;
+
+}/*End utl_benchRun*/
+
+int16_t utl_benchFormatHeader( char *pc_buff,
+                               uint16_t s_size)
+{
+   if( pc_buff == NULL)
+      return (int16_t)BENCH_NULL_PTR;
+
+   if( s_size < UTL_BENCH_LINE_BYTES)
+      return (int16_t)BENCH_BUFFER_TOO_SMALL;
+
+   return (int16_t)snprintf( pc_buff,
+                             s_size,
+                             "#hz,%lu\n\r#name,iterations,samples,min,median,"
+                             "max\n\r",
+                             (unsigned long)hal_getCycleCounterFreq());
+
+}/*End utl_benchFormatHeader*/
+
+int16_t utl_benchFormatResult( const t_benchCase *pt_case,
+                               const t_benchResult *pt_result,
+                               char *pc_buff,
+                               uint16_t s_size)
+{
+   int16_t s_length;
+   int16_t s_index;
+
+   if( (pt_case == NULL) || (pt_result == NULL) || (pc_buff == NULL))
+      return (int16_t)BENCH_NULL_PTR;
+
+   if( s_size < UTL_BENCH_LINE_BYTES)
+      return (int16_t)BENCH_BUFFER_TOO_SMALL;
+
+   s_index = (int16_t)snprintf( pc_buff,
+                                s_size,
+                                "%.*s,%u,%u",
+                                UTL_BENCH_MAX_NAME,
+                                pt_case->pc_name,
+                                pt_result->s_iterations,
+                                pt_result->c_samples);
+
+   s_length = utl_benchFormatCycles( &pc_buff[s_index],
+                                     s_size - s_index,
+                                     pt_result->i_min,
+                                     pt_result->s_iterations);
+   s_index += s_length;
+
+   s_length = utl_benchFormatCycles( &pc_buff[s_index],
+                                     s_size - s_index,
+                                     pt_result->i_median,
+                                     pt_result->s_iterations);
+   s_index += s_length;
+
+   s_length = utl_benchFormatCycles( &pc_buff[s_index],
+                                     s_size - s_index,
+                                     pt_result->i_max,
+                                     pt_result->s_iterations);
+   s_index += s_length;
+
+   s_index += (int16_t)snprintf( &pc_buff[s_index],
+                                 s_size - s_index,
+                                 "\n\r");
+
+   return s_index;
+
+}/*End utl_benchFormatResult*/
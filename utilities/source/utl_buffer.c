@@ -22,7 +22,7 @@
  * Description : This file provides and abstraction layer for the creation and 
  *               control over circular buffers.
  *
- * Last Update : Dec 3, 2011
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------*
@@ -30,8 +30,8 @@
  *---------------------------------------------------------------------------*/
 #include <stdio.h>
 #include <string.h>
-#include "utl_linkedList.h"
 #include "utl_buffer.h"
+#include "arb_memory.h"
 #include "hal_pmic.h"
 
 /*---------------------------------------------------------------------------*
@@ -41,47 +41,17 @@
 /*---------------------------------------------------------------------------*
  * Private Datatypes
  *---------------------------------------------------------------------------*/
-typedef struct
-{
-
-   /*------------------------------------------------------------------------*
-    * Location where the next element will be added to the buffer.
-    *------------------------------------------------------------------------*/
-   int16_t s_wrIndex;
-
-   /*------------------------------------------------------------------------*
-    * Location where the next element will be read from the buffer.
-    *------------------------------------------------------------------------*/
-   int16_t s_rdIndex;
-
-   /*------------------------------------------------------------------------*
-    * The number of elements in the buffer. When s_fillCount < 0 the
-    * consuming process has underflowed the buffer or read too many elements.
-    * When s_fillCount > s_sizeWords the producing process has overflowed
-    * the buffer or wrote too many words.
-    *------------------------------------------------------------------------*/
-   int16_t s_fillCount;
-
-   /*------------------------------------------------------------------------*
-    * The size of the buffer in 8-bit words
-    *------------------------------------------------------------------------*/
-   uint16_t s_sizeBytes;
-
-   /*------------------------------------------------------------------------*
-    * Pointer to the circular buffer
-    *------------------------------------------------------------------------*/
-   int8_t *pc_buffer;
-
-}t_bufferHandle;
 
 /*---------------------------------------------------------------------------*
  * Private Global Variables
  *---------------------------------------------------------------------------*/
-
+#ifdef UTL_BUFFER_DEBUG
 /*---------------------------------------------------------------------------*
- * This variable keeps track of all the open circular buffers on the system.
+ * This variable keeps track of all the registered circular buffers on the
+ * system.
  *---------------------------------------------------------------------------*/
-UTL_CREATE_CONTAINER( gt_bufferList);
+static t_buffer *gpt_bufferList = NULL;
+#endif
 
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
@@ -94,156 +64,63 @@ UTL_CREATE_CONTAINER( gt_bufferList);
 /*---------------------------------------------------------------------------*
  * Public Function Definitions
  *---------------------------------------------------------------------------*/
-int16_t utl_getBufferFullLevel( t_BUFFHANDLE t_handle)
+uint16_t utl_getBufferReadSpan( t_buffer *pt_buffer,
+                                int8_t **ppc_span)
 {
-   t_bufferHandle *pt_handle =
-   (t_bufferHandle *)UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   return pt_handle->s_fillCount; /*Return the number of bytes in the buffer*/
+   int16_t s_level = pt_buffer->s_fillCount;
+   uint16_t s_span;
 
-}/*End utl_getBufferFullLevel*/
+   *ppc_span = &pt_buffer->pc_buffer[pt_buffer->s_rdIndex];
 
-int16_t utl_getBufferEmptyLevel( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
+   if( s_level <= 0)
+      return 0;
 
    /*------------------------------------------------------------------------*
-    * Return the number of bytes of space left in the buffer.
+    * The readable region ends either at the write index or at the end of
+    * the buffer, whichever comes first.
     *------------------------------------------------------------------------*/
-   return ((int16_t)pt_handle->s_sizeBytes - pt_handle->s_fillCount);
-
-}/*End utl_getBufferEmptyLevel*/
-
-int16_t utl_getBufferSize( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   return ((int16_t)pt_handle->s_sizeBytes);
-
-}/*End utl_getBufferSize*/
-
-bool utl_isBufferFull( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   return (bool)(pt_handle->s_fillCount == pt_handle->s_sizeBytes);
-}/*End utl_isBufferFull*/
-
-bool utl_isBufferEmpty( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   return (bool)(pt_handle->s_fillCount == 0);
-}/*End utl_isBufferEmpty*/
-
-bool utl_hasBufferOverflowed( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   return (bool)(pt_handle->s_fillCount > pt_handle->s_sizeBytes);
-}/*End utl_hasBufferOverflowed*/
-
-bool utl_hasBufferUnderflowed( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-   return (bool)(pt_handle->s_fillCount < 0);
-}/*End hasBufferUnderflowed*/
-
-int8_t *utl_getBufferPtr( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-   return pt_handle->pc_buffer;
-}/*End utl_getBufferPtr*/
-
-void utl_writeByte( t_BUFFHANDLE t_handle,
-                    int8_t c_byte)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   pt_handle->pc_buffer[pt_handle->s_wrIndex] = c_byte;
-   pt_handle->s_wrIndex++;
-   if( pt_handle->s_wrIndex == pt_handle->s_sizeBytes)
-      pt_handle->s_wrIndex = 0;
+   s_span = pt_buffer->s_sizeBytes - (uint16_t)pt_buffer->s_rdIndex;
+   if( s_span > (uint16_t)s_level)
+      s_span = (uint16_t)s_level;
 
-   pt_handle->s_fillCount++;
+   return s_span;
 
-}/*End utl_writeByte*/
+}/*End utl_getBufferReadSpan*/
 
-void utl_incrBufWrtPtr( t_BUFFHANDLE t_handle,
-                        uint16_t s_size)
+uint16_t utl_getBufferWriteSpan( t_buffer *pt_buffer,
+                                 int8_t **ppc_span)
 {
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-   int16_t *ps_wrIndex       = &pt_handle->s_wrIndex;
+   int16_t s_room = (int16_t)pt_buffer->s_sizeBytes - pt_buffer->s_fillCount;
+   uint16_t s_span;
 
-   *ps_wrIndex += s_size;
-   if( *ps_wrIndex >= pt_handle->s_sizeBytes)
-   {
-      *ps_wrIndex -= pt_handle->s_sizeBytes;
-   }
+   *ppc_span = &pt_buffer->pc_buffer[pt_buffer->s_wrIndex];
 
-   pt_handle->s_fillCount += (int16_t)s_size;
+   if( s_room <= 0)
+      return 0;
 
-}/*End utl_incrBufWrtPtr*/
+   s_span = pt_buffer->s_sizeBytes - (uint16_t)pt_buffer->s_wrIndex;
+   if( s_span > (uint16_t)s_room)
+      s_span = (uint16_t)s_room;
 
-void utl_incrBufRdPtr( t_BUFFHANDLE t_handle,
-                       uint16_t s_size)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-   int16_t *ps_rdIndex       = &pt_handle->s_rdIndex;
+   return s_span;
 
-   *ps_rdIndex += s_size;
-   if( *ps_rdIndex >= pt_handle->s_sizeBytes)
-   {
-      *ps_rdIndex -= pt_handle->s_sizeBytes;
-   }
+}/*End utl_getBufferWriteSpan*/
 
-   pt_handle->s_fillCount -= (int16_t)s_size;
-
-}/*End utl_incrBufRdPtr*/
-
-int16_t utl_getBufRdPtr( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   return pt_handle->s_rdIndex;
-}/*End utl_getBufRdPtr*/
-
-int16_t utl_getBufWrtPtr( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   return pt_handle->s_wrIndex;
-}/*End utl_getBufWrtPtr*/
-
-void utl_writeBlock( t_BUFFHANDLE t_handle,
+void utl_writeBlock( t_buffer *pt_buffer,
                      int8_t *pc_buff,
                      uint16_t s_size)
 {
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-   int8_t *pc_buffer         = pt_handle->pc_buffer;
-   int16_t *ps_wrIndex       = &pt_handle->s_wrIndex;
-   uint16_t s_room           = 0;
+   int8_t *pc_buffer = pt_buffer->pc_buffer;
+   int16_t s_wrIndex = pt_buffer->s_wrIndex;
+   uint16_t s_room   = 0;
 
-   s_room = pt_handle->s_sizeBytes - pt_handle->s_wrIndex;
+   s_room = pt_buffer->s_sizeBytes - (uint16_t)s_wrIndex;
    if( s_room < s_size)
    {
       /*---------------------------------------------------------------------*
        * Copy from current location to the end of the buffer.
        *---------------------------------------------------------------------*/
-      memcpy( (void *)&pc_buffer[*ps_wrIndex], (void *)pc_buff, s_room);
+      memcpy( (void *)&pc_buffer[s_wrIndex], (void *)pc_buff, s_room);
 
       /*---------------------------------------------------------------------*
        * Copy the rest of the data starting at the beginning of the buffer.
@@ -252,68 +129,29 @@ void utl_writeBlock( t_BUFFHANDLE t_handle,
    }
    else
    {
-      memcpy( (void *)&pc_buffer[*ps_wrIndex], (void *)pc_buff, s_size);
+      memcpy( (void *)&pc_buffer[s_wrIndex], (void *)pc_buff, s_size);
    }
 
-   *ps_wrIndex += s_size;
-   if( *ps_wrIndex >= pt_handle->s_sizeBytes)
-   {
-      *ps_wrIndex -= pt_handle->s_sizeBytes;
-   }
-
-   pt_handle->s_fillCount += (int16_t)s_size;
+   utl_commitBufferWrite( pt_buffer,
+                          s_size);
 
 }/*End utl_writeBlock*/
 
-int8_t utl_readByte( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-   int8_t c_byte = 0;
-
-   c_byte = pt_handle->pc_buffer[pt_handle->s_rdIndex];
-   pt_handle->s_rdIndex++;
-   if( pt_handle->s_rdIndex == pt_handle->s_sizeBytes)
-      pt_handle->s_rdIndex = 0;
-
-   pt_handle->s_fillCount--;
-
-   return c_byte;
-
-}/*End utl_readByte*/
-
-void utl_buffEraseTailByte( t_BUFFHANDLE t_handle)
-{
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   pt_handle->s_wrIndex--;
-   if( pt_handle->s_wrIndex < 0)
-      pt_handle->s_wrIndex = pt_handle->s_sizeBytes - 1;
-
-   pt_handle->pc_buffer[pt_handle->s_wrIndex] = 0;
-
-   pt_handle->s_fillCount--;
-
-}/*End utl_buffEraseTailByte*/
-
-void utl_readBlock( t_BUFFHANDLE t_handle,
+void utl_readBlock( t_buffer *pt_buffer,
                     int8_t *pc_buff,
                     uint16_t s_size)
 {
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-   int8_t *pc_buffer         = pt_handle->pc_buffer;
-   int16_t *ps_rdIndex       = &pt_handle->s_rdIndex;
-   uint16_t s_room           = 0;
+   int8_t *pc_buffer = pt_buffer->pc_buffer;
+   int16_t s_rdIndex = pt_buffer->s_rdIndex;
+   uint16_t s_room   = 0;
 
-   s_room = pt_handle->s_sizeBytes - pt_handle->s_rdIndex;
+   s_room = pt_buffer->s_sizeBytes - (uint16_t)s_rdIndex;
    if( s_room < s_size)
    {
       /*---------------------------------------------------------------------*
        * Copy from current location to the end of the buffer.
        *---------------------------------------------------------------------*/
-      memcpy( (void *)pc_buff, (void *)&pc_buffer[*ps_rdIndex], s_room);
+      memcpy( (void *)pc_buff, (void *)&pc_buffer[s_rdIndex], s_room);
 
       /*---------------------------------------------------------------------*
        * Copy the rest of the data starting at the beginning of the buffer.
@@ -322,110 +160,117 @@ void utl_readBlock( t_BUFFHANDLE t_handle,
    }
    else
    {
-      memcpy( (void *)pc_buff, (void *)&pc_buffer[*ps_rdIndex], s_size);
-   }
-
-   *ps_rdIndex += s_size;
-   if( *ps_rdIndex >= pt_handle->s_sizeBytes)
-   {
-      *ps_rdIndex -= pt_handle->s_sizeBytes;
+      memcpy( (void *)pc_buff, (void *)&pc_buffer[s_rdIndex], s_size);
    }
 
-   pt_handle->s_fillCount -= (int16_t)s_size;
+   utl_commitBufferRead( pt_buffer,
+                         s_size);
 
 }/*End utl_readBlock*/
 
-void ult_resetBuffer( t_BUFFHANDLE t_handle)
+t_bufferError utl_initBuffer( t_buffer *pt_buffer,
+                              int8_t *pc_storage,
+                              uint16_t s_sizeBytes)
 {
-   t_bufferHandle *pt_handle = (t_bufferHandle *)
-   UTL_GET_LINK_ELEMENT_PTR(t_handle);
-
-   pt_handle->s_rdIndex   = 0;
-   pt_handle->s_wrIndex   = 0;
-   pt_handle->s_fillCount = 0;
-
-}/*End ult_resetBuffer*/
-
-t_BUFFHANDLE utl_createBuffer( int16_t s_sizeBytes)
-{
-   t_bufferHandle *pt_newBuff;
-   t_LINKHNDL t_newLinkHndl;
-   t_linkedListError t_err;
+   if( (pt_buffer == NULL) || (pc_storage == NULL))
+      return BUFFER_NULL_PTR;
 
    /*------------------------------------------------------------------------*
-    * Since we are about to act on global variables, protect this region
-    * of code against higher priority threads interrupting us while we are
-    * trying to register.
+    * Initialize the read and write index's.
     *------------------------------------------------------------------------*/
-   HAL_BEGIN_CRITICAL();
+   pt_buffer->s_wrIndex   = 0;
+   pt_buffer->s_rdIndex   = 0;
+   pt_buffer->s_fillCount = 0;
+   pt_buffer->s_sizeBytes = s_sizeBytes;
+   pt_buffer->pc_buffer   = pc_storage;
+   pt_buffer->b_onHeap    = false;
 
    /*------------------------------------------------------------------------*
-    * Create a new link handle with room at the end for the buffer..
+    * Initialize the buffer to all NULL's.
     *------------------------------------------------------------------------*/
-   t_newLinkHndl = utl_createLink( sizeof(t_bufferHandle) + s_sizeBytes);
+   memset( (void *)pc_storage, '\0', s_sizeBytes);
 
-   if( t_newLinkHndl < 0)
+#ifdef UTL_BUFFER_DEBUG
    {
+      /*---------------------------------------------------------------------*
+       * Since we are about to act on global variables, protect this region
+       * of code against higher priority threads interrupting us while we
+       * are trying to register.
+       *---------------------------------------------------------------------*/
+      HAL_BEGIN_CRITICAL();
+      pt_buffer->pt_next = gpt_bufferList;
+      gpt_bufferList     = pt_buffer;
       HAL_END_CRITICAL();//Enable interrupts
-      return (t_BUFFHANDLE)BUFFER_OUT_OF_HEAP;
-   }/*End if( t_newLinkHndl < 0)*/
+   }
+#endif
 
-   /*------------------------------------------------------------------------*
-    * Initialize the read and write index's.
-    *------------------------------------------------------------------------*/
-   pt_newBuff = (t_bufferHandle *)UTL_GET_LINK_ELEMENT_PTR(t_newLinkHndl);
+   return BUFFER_PASSED;
 
-   pt_newBuff->s_wrIndex   = 0;
-   pt_newBuff->s_rdIndex   = 0;
-   pt_newBuff->s_fillCount = 0;
+}/*End utl_initBuffer*/
 
-   /*------------------------------------------------------------------------*
-    * Initialize the buffer ptr to the location of the buffer which starts
-    * at the next address location as the address of the buffer pointer.
-    *------------------------------------------------------------------------*/
-   pt_newBuff->pc_buffer = (int8_t *)(&pt_newBuff->pc_buffer + 1);
+t_bufferError utl_createBuffer( t_buffer *pt_buffer,
+                                uint16_t s_sizeBytes)
+{
+   int8_t *pc_storage = NULL;
+   t_bufferError t_err;
 
-   /*------------------------------------------------------------------------*
-    * Initialize the buffer to all NULL's.
-    *------------------------------------------------------------------------*/
-   memset( (void *)pt_newBuff->pc_buffer, '\0', s_sizeBytes);
+   if( pt_buffer == NULL)
+      return BUFFER_NULL_PTR;
 
-   /*------------------------------------------------------------------------*
-    * The size of the buffer in 8-bit words.
-    *------------------------------------------------------------------------*/
-   pt_newBuff->s_sizeBytes = s_sizeBytes;
+   arb_malloc( (size_t)s_sizeBytes,
+               (void **)&pc_storage);
+
+   if( pc_storage == NULL)
+      return BUFFER_OUT_OF_HEAP;
 
-   t_err = utl_insertLink( gt_bufferList,
-                           t_newLinkHndl,
-                           true);
+   t_err = utl_initBuffer( pt_buffer,
+                           pc_storage,
+                           s_sizeBytes);
 
-   HAL_END_CRITICAL();//Enable interrupts
+   pt_buffer->b_onHeap = true;
 
-   return (t_BUFFHANDLE)t_newLinkHndl;
+   return t_err;
 
 }/*End utl_createBuffer*/
 
-t_bufferError utl_destroyBuffer( t_BUFFHANDLE t_handle)
+void utl_destroyBuffer( t_buffer *pt_buffer)
 {
-   t_linkedListError t_err;
+   if( pt_buffer == NULL)
+      return;
 
-   /*------------------------------------------------------------------------*
-    * Since we are about to act on global variables, protect this region
-    * of code against higher priority threads interrupting us while we are
-    * trying to register.
-    *------------------------------------------------------------------------*/
-   HAL_BEGIN_CRITICAL();
+#ifdef UTL_BUFFER_DEBUG
+   {
+      t_buffer **ppt_link;
 
-   t_err = utl_destroyLink( gt_bufferList,
-                            (t_LINKHNDL)t_handle);
+      HAL_BEGIN_CRITICAL();
+
+      for( ppt_link = &gpt_bufferList; (*ppt_link) != NULL; ppt_link =
+      &(*ppt_link)->pt_next)
+      {
+         if( (*ppt_link) == pt_buffer)
+         {
+            (*ppt_link) = pt_buffer->pt_next;
+            break;
+         }
+      }
 
-   if( t_err < 0)
-   {
       HAL_END_CRITICAL();//Enable interrupts
-      return BUFFER_INVALID_HNDL;
    }
+#endif
 
-   HAL_END_CRITICAL();//Enable interrupts
-   return BUFFER_PASSED;
+   if( (pt_buffer->b_onHeap == true) && (pt_buffer->pc_buffer != NULL))
+      arb_free( (void **)&pt_buffer->pc_buffer);
+
+   pt_buffer->pc_buffer   = NULL;
+   pt_buffer->b_onHeap    = false;
+   pt_buffer->s_sizeBytes = 0;
+   utl_resetBuffer( pt_buffer);
 
 }/*End utl_destroyBuffer*/
+
+#ifdef UTL_BUFFER_DEBUG
+t_buffer *utl_getBufferList( void)
+{
+   return gpt_bufferList;
+}/*End utl_getBufferList*/
+#endif
@@ -0,0 +1,736 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_cordic.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for the CORDIC rotations and the
+ *               trig, magnitude, sqrt, log and exp functions built on them.
+ *               See "The CORDIC Trigonometric Computing Technique", J.E.
+ *               Volder, and "A Unified Algorithm for Elementary Functions",
+ *               J.S. Walther, for the derivation.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "utl_cordic.h"
+#include "utl_math.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The angle tables are stored with 14 guard bits, this scales an entry
+ * down to UTL_CORDIC_GUARD_BITS with rounding.
+ *---------------------------------------------------------------------------*/
+#define CORDIC_TBL_SHFT (14 - UTL_CORDIC_GUARD_BITS)
+#define CORDIC_SCALE(x) ((int32_t)(((x) + (((int32_t)1 << CORDIC_TBL_SHFT) \
+                        >> 1)) >> CORDIC_TBL_SHFT))
+
+/*---------------------------------------------------------------------------*
+ * Phases in the working registers, 2*pi = (65536 << guard bits)
+ *---------------------------------------------------------------------------*/
+#define CORDIC_GUARD      ((int32_t)1 << UTL_CORDIC_GUARD_BITS)
+#define CORDIC_PI         ((int32_t)32768*CORDIC_GUARD)
+
+/*---------------------------------------------------------------------------*
+ * Q0.16 phases between these two are more than 90 degrees from zero.
+ *---------------------------------------------------------------------------*/
+#define CORDIC_PHASE_90  (16384)
+#define CORDIC_PHASE_270 (49152)
+
+/*---------------------------------------------------------------------------*
+ * ln(2) is split into a Q15 part, and the bits below Q15 that are kept in
+ * the working registers, so that multiples of it can't overflow.
+ *---------------------------------------------------------------------------*/
+#define CORDIC_LN2_Q15 ((int32_t)22713)
+#define CORDIC_LN2_RES (CORDIC_SCALE( 372130559) - CORDIC_LN2_Q15*CORDIC_GUARD)
+
+/*---------------------------------------------------------------------------*
+ * ln(131072) in Q15, the largest Q17.15 result of utl_cordicExp32.
+ *---------------------------------------------------------------------------*/
+#define CORDIC_EXP_MAX_INPUT ((int32_t)386127)
+
+/*---------------------------------------------------------------------------*
+ * Bit length the Q1.15 vectoring inputs are normalized to, the largest that
+ * keeps utl_cordicRemoveGain from overflowing on a 3-D magnitude.
+ *---------------------------------------------------------------------------*/
+#define CORDIC_NORM_BITS (15)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * atan(2^-i) for i = 0 to 15, as a phase where 2*pi = 2^30.
+ *---------------------------------------------------------------------------*/
+static int32_t gai_cordicAtanTbl[UTL_CORDIC_MAX_ITERATIONS] =
+{
+   CORDIC_SCALE( 134217728), CORDIC_SCALE( 79233351),
+   CORDIC_SCALE( 41864727), CORDIC_SCALE( 21251189),
+   CORDIC_SCALE( 10666833), CORDIC_SCALE( 5338616),
+   CORDIC_SCALE( 2669960), CORDIC_SCALE( 1335061),
+   CORDIC_SCALE( 667541), CORDIC_SCALE( 333772),
+   CORDIC_SCALE( 166886), CORDIC_SCALE( 83443),
+   CORDIC_SCALE( 41722), CORDIC_SCALE( 20861),
+   CORDIC_SCALE( 10430), CORDIC_SCALE( 5215)
+};
+
+/*---------------------------------------------------------------------------*
+ * atanh(2^-i) for i = 1 to 16, Q29.
+ *---------------------------------------------------------------------------*/
+static int32_t gai_cordicAtanhTbl[UTL_CORDIC_MAX_ITERATIONS] =
+{
+   CORDIC_SCALE( 294906491), CORDIC_SCALE( 137123709),
+   CORDIC_SCALE( 67461703), CORDIC_SCALE( 33598225),
+   CORDIC_SCALE( 16782681), CORDIC_SCALE( 8389291),
+   CORDIC_SCALE( 4194389), CORDIC_SCALE( 2097163),
+   CORDIC_SCALE( 1048577), CORDIC_SCALE( 524288),
+   CORDIC_SCALE( 262144), CORDIC_SCALE( 131072),
+   CORDIC_SCALE( 65536), CORDIC_SCALE( 32768),
+   CORDIC_SCALE( 16384), CORDIC_SCALE( 8192)
+};
+
+/*---------------------------------------------------------------------------*
+ * 1/K after n + 1 circular iterations, where K = prod( sqrt( 1 + 2^-2i)).
+ * Q0.15
+ *---------------------------------------------------------------------------*/
+static uint16_t gas_cordicInvGain[UTL_CORDIC_MAX_ITERATIONS] =
+{
+   23170, 20724, 20106, 19950, 19911, 19902, 19899, 19899, 19899, 19898,
+   19898, 19898, 19898, 19898, 19898, 19898
+};
+
+/*---------------------------------------------------------------------------*
+ * 1/K after n + 1 hyperbolic iterations (plus the repeats of 4 and 13),
+ * where K = prod( sqrt( 1 - 2^-2i)).
+ * Q1.15
+ *---------------------------------------------------------------------------*/
+static uint16_t gas_cordicInvGainH[UTL_CORDIC_MAX_ITERATIONS] =
+{
+   37837, 39078, 39387, 39542, 39561, 39566, 39567, 39567, 39567, 39567,
+   39567, 39567, 39567, 39567, 39567, 39567
+};
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Rounds a working register to Q15.
+ *---------------------------------------------------------------------------*/
+static inline int32_t __attribute__((always_inline)) \
+utl_cordicToQ15( int32_t i_x)
+{
+   return (i_x + (CORDIC_GUARD >> 1)) >> UTL_CORDIC_GUARD_BITS;
+
+}/*End utl_cordicToQ15*/
+
+/*---------------------------------------------------------------------------*
+ * Removes the CORDIC gain from a working register, the Q15 result is
+ * i_x*(s_invGain/32768).
+ *---------------------------------------------------------------------------*/
+static inline int32_t __attribute__((always_inline)) \
+utl_cordicRemoveGain( int32_t i_x,
+                      uint16_t s_invGain)
+{
+   return (utl_cordicToQ15( i_x)*(int32_t)s_invGain + 16384) >> 15;
+
+}/*End utl_cordicRemoveGain*/
+
+/*---------------------------------------------------------------------------*
+ * Number of bits needed to hold i_x.
+ *---------------------------------------------------------------------------*/
+static inline int8_t __attribute__((always_inline)) \
+utl_cordicBitLength( uint32_t i_x)
+{
+   int8_t c_len = 0;
+
+   while( i_x != 0)
+   {
+      i_x = i_x >> 1;
+      c_len++;
+   }
+
+   return c_len;
+
+}/*End utl_cordicBitLength*/
+
+/*---------------------------------------------------------------------------*
+ * Left shift that brings the largest magnitude of a Q1.15 vector up to
+ * CORDIC_NORM_BITS. Without it a small vector has only a few significant
+ * bits in the working registers and its angle is far off.
+ *---------------------------------------------------------------------------*/
+static inline int8_t __attribute__((always_inline)) \
+utl_cordicNormShift( uint32_t i_max)
+{
+   int8_t c_shift = CORDIC_NORM_BITS - utl_cordicBitLength( i_max);
+
+   if( c_shift < 0)
+      c_shift = 0;
+
+   return c_shift;
+
+}/*End utl_cordicNormShift*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicCircular
+ *
+ * Description:
+ *    Runs UTL_CORDIC_ITERATIONS circular CORDIC iterations. Each one rotates
+ *    (x,y) by +/-atan(2^-i) using shifts and adds only,
+ *       x' = x -/+ (y >> i)
+ *       y' = y +/- (x >> i)
+ *       z' = z -/+ atan(2^-i)
+ *    In CORDIC_ROTATE mode the direction is chosen to drive z to zero, so
+ *    (x,y) ends up rotated by the starting z. In CORDIC_VECTOR mode it is
+ *    chosen to drive y to zero, x ends up as the magnitude and z as the
+ *    starting z plus the angle of (x,y). Either way x and y are scaled by
+ *    the gain K (~1.647) which is left for the caller to remove.
+ *
+ * Parameters:
+ *    pi_x, pi_y - Q(UTL_CORDIC_FRAC_BITS) vector
+ *    pi_z - Phase where 2*pi = (65536 << UTL_CORDIC_GUARD_BITS)
+ *    t_mode - CORDIC_ROTATE or CORDIC_VECTOR
+ *
+ * Return:
+ *    pi_x, pi_y, pi_z - The values after the last iteration
+ *---------------------------------------------------------------------------*/
+void utl_cordicCircular( int32_t *pi_x,
+                         int32_t *pi_y,
+                         int32_t *pi_z,
+                         t_cordicMode t_mode)
+{
+   int32_t i_x = *pi_x;
+   int32_t i_y = *pi_y;
+   int32_t i_z = *pi_z;
+   int32_t i_temp;
+   uint8_t c_i;
+
+   for( c_i = 0; c_i < UTL_CORDIC_ITERATIONS; c_i++)
+   {
+      i_temp = i_x;
+
+      if( (t_mode == CORDIC_ROTATE) ? (i_z >= 0) : (i_y < 0))
+      {
+         i_x = i_x - (i_y >> c_i);
+         i_y = i_y + (i_temp >> c_i);
+         i_z = i_z - gai_cordicAtanTbl[c_i];
+      }
+      else
+      {
+         i_x = i_x + (i_y >> c_i);
+         i_y = i_y - (i_temp >> c_i);
+         i_z = i_z + gai_cordicAtanTbl[c_i];
+      }
+
+   }/*End for( c_i = 0; c_i < UTL_CORDIC_ITERATIONS; c_i++)*/
+
+   *pi_x = i_x;
+   *pi_y = i_y;
+   *pi_z = i_z;
+
+}/*End utl_cordicCircular*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicHyperbolic
+ *
+ * Description:
+ *    Runs the hyperbolic CORDIC iterations i = 1 to UTL_CORDIC_ITERATIONS,
+ *       x' = x +/- (y >> i)
+ *       y' = y +/- (x >> i)
+ *       z' = z -/+ atanh(2^-i)
+ *    Iterations 4 and 13 are run twice, without the repeats the sum of the
+ *    atanh terms can't reach every angle and the result doesn't converge.
+ *    In CORDIC_ROTATE mode x and y end up as K*(x*cosh(z) + y*sinh(z)) and
+ *    K*(y*cosh(z) + x*sinh(z)). In CORDIC_VECTOR mode x ends up as
+ *    K*sqrt(x^2 - y^2) and z as z + atanh(y/x). The gain K (~0.828) is left
+ *    for the caller to remove.
+ *
+ * Parameters:
+ *    pi_x, pi_y, pi_z - Q(UTL_CORDIC_FRAC_BITS) numbers
+ *    t_mode - CORDIC_ROTATE or CORDIC_VECTOR
+ *
+ * Return:
+ *    pi_x, pi_y, pi_z - The values after the last iteration
+ *---------------------------------------------------------------------------*/
+void utl_cordicHyperbolic( int32_t *pi_x,
+                           int32_t *pi_y,
+                           int32_t *pi_z,
+                           t_cordicMode t_mode)
+{
+   int32_t i_x = *pi_x;
+   int32_t i_y = *pi_y;
+   int32_t i_z = *pi_z;
+   int32_t i_temp;
+   uint8_t c_i = 1;
+   uint8_t c_repeat = 4;
+
+   while( c_i <= UTL_CORDIC_ITERATIONS)
+   {
+      i_temp = i_x;
+
+      if( (t_mode == CORDIC_ROTATE) ? (i_z >= 0) : (i_y < 0))
+      {
+         i_x = i_x + (i_y >> c_i);
+         i_y = i_y + (i_temp >> c_i);
+         i_z = i_z - gai_cordicAtanhTbl[c_i - 1];
+      }
+      else
+      {
+         i_x = i_x - (i_y >> c_i);
+         i_y = i_y - (i_temp >> c_i);
+         i_z = i_z + gai_cordicAtanhTbl[c_i - 1];
+      }
+
+      /*---------------------------------------------------------------------*
+       * Iterations 4, 13, 40... are repeated.
+       *---------------------------------------------------------------------*/
+      if( c_i == c_repeat)
+         c_repeat = 3*c_repeat + 1;
+      else
+         c_i++;
+
+   }/*End while( c_i <= UTL_CORDIC_ITERATIONS)*/
+
+   *pi_x = i_x;
+   *pi_y = i_y;
+   *pi_z = i_z;
+
+}/*End utl_cordicHyperbolic*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicRotate16
+ *
+ * Description:
+ *    Rotates the vector (x,y) counter-clockwise by s_phase. The result
+ *    saturates to 16 bits.
+ *
+ * Parameters:
+ *    ps_x, ps_y - Q1.15 vector
+ *    s_phase - Q0.16 number where 2*pi = 65,536
+ *
+ * Return:
+ *    ps_x, ps_y - Q1.15 rotated vector
+ *---------------------------------------------------------------------------*/
+void utl_cordicRotate16( int16_t *ps_x,
+                         int16_t *ps_y,
+                         uint16_t s_phase)
+{
+   int32_t i_x;
+   int32_t i_y;
+   int32_t i_z;
+   uint16_t s_invGain = gas_cordicInvGain[UTL_CORDIC_ITERATIONS - 1];
+
+   /*------------------------------------------------------------------------*
+    * The gain is removed up front so the result can't overflow.
+    *------------------------------------------------------------------------*/
+   i_x = ((int32_t)*ps_x*(int32_t)s_invGain) >> (15 - UTL_CORDIC_GUARD_BITS);
+   i_y = ((int32_t)*ps_y*(int32_t)s_invGain) >> (15 - UTL_CORDIC_GUARD_BITS);
+
+   /*------------------------------------------------------------------------*
+    * The iterations only converge within +/-99 degrees, larger angles start
+    * with a rotation of 180 degrees.
+    *------------------------------------------------------------------------*/
+   if( (s_phase > CORDIC_PHASE_90) && (s_phase < CORDIC_PHASE_270))
+   {
+      i_x = -i_x;
+      i_y = -i_y;
+      s_phase = s_phase + 32768;
+   }
+
+   i_z = (int32_t)((int16_t)s_phase)*CORDIC_GUARD;
+
+   utl_cordicCircular( &i_x, &i_y, &i_z, CORDIC_ROTATE);
+
+   *ps_x = (int16_t)utl_hardLimit32_32( utl_cordicToQ15( i_x), 15);
+   *ps_y = (int16_t)utl_hardLimit32_32( utl_cordicToQ15( i_y), 15);
+
+}/*End utl_cordicRotate16*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicSincos16
+ *
+ * Description:
+ *    Returns the sin and cos of a Q0.16 phase by rotating the unit vector.
+ *
+ * Parameters:
+ *    s_phase - Q0.16 number where 2*pi = 65,536
+ *
+ * Return:
+ *    ps_sin - Q1.15 sin of s_phase
+ *    ps_cos - Q1.15 cos of s_phase
+ *---------------------------------------------------------------------------*/
+void utl_cordicSincos16( uint16_t s_phase,
+                         int16_t *ps_sin,
+                         int16_t *ps_cos)
+{
+   int32_t i_x;
+   int32_t i_y = 0;
+   int32_t i_z;
+
+   /*------------------------------------------------------------------------*
+    * Starting at 1/K leaves the unit vector after the gain is applied.
+    *------------------------------------------------------------------------*/
+   i_x = (int32_t)gas_cordicInvGain[UTL_CORDIC_ITERATIONS - 1]*CORDIC_GUARD;
+
+   if( (s_phase > CORDIC_PHASE_90) && (s_phase < CORDIC_PHASE_270))
+   {
+      i_x = -i_x;
+      s_phase = s_phase + 32768;
+   }
+
+   i_z = (int32_t)((int16_t)s_phase)*CORDIC_GUARD;
+
+   utl_cordicCircular( &i_x, &i_y, &i_z, CORDIC_ROTATE);
+
+   *ps_cos = (int16_t)utl_hardLimit32_32( utl_cordicToQ15( i_x), 15);
+   *ps_sin = (int16_t)utl_hardLimit32_32( utl_cordicToQ15( i_y), 15);
+
+}/*End utl_cordicSincos16*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicAtan2_16
+ *
+ * Description:
+ *    Finds the angle and the magnitude of (x,y) in a single pass.
+ *
+ * Parameters:
+ *    s_y, s_x - Q1.15 numbers
+ *
+ * Return:
+ *    ps_mag - Q1.15 magnitude sqrt(x^2 + y^2) with a range of 0 to 46341,
+ *             not written if NULL.
+ *    s_atan2 - Q1.15 number where +/-pi = 32767/-32768 respectively.
+ *---------------------------------------------------------------------------*/
+int16_t utl_cordicAtan2_16( int16_t s_y,
+                            int16_t s_x,
+                            uint16_t *ps_mag)
+{
+   int32_t i_x;
+   int32_t i_y;
+   int32_t i_z = 0;
+   int32_t i_mag;
+   int8_t c_norm;
+
+   /*------------------------------------------------------------------------*
+    * The angle of (0,0) is taken as 0, same as atan2f.
+    *------------------------------------------------------------------------*/
+   if( (s_x == 0) && (s_y == 0))
+   {
+      if( ps_mag != NULL)
+         *ps_mag = 0;
+
+      return 0;
+   }
+
+   c_norm = utl_cordicNormShift( (uint32_t)(utl_abs32_32( (int32_t)s_x) |
+   utl_abs32_32( (int32_t)s_y)));
+
+   i_x = (int32_t)s_x*((int32_t)1 << c_norm)*CORDIC_GUARD;
+   i_y = (int32_t)s_y*((int32_t)1 << c_norm)*CORDIC_GUARD;
+
+   /*------------------------------------------------------------------------*
+    * Quadrants 2 and 3 are rotated by 180 degrees into 1 and 4.
+    *------------------------------------------------------------------------*/
+   if( i_x < 0)
+   {
+      i_x = -i_x;
+      i_y = -i_y;
+      if( s_y >= 0)
+         i_z = CORDIC_PI;
+      else
+         i_z = -CORDIC_PI;
+   }
+
+   utl_cordicCircular( &i_x, &i_y, &i_z, CORDIC_VECTOR);
+
+   if( ps_mag != NULL)
+   {
+      i_mag = utl_cordicRemoveGain( i_x,
+      gas_cordicInvGain[UTL_CORDIC_ITERATIONS - 1]);
+      if( c_norm > 0)
+         i_mag = (i_mag + ((int32_t)1 << (c_norm - 1))) >> c_norm;
+
+      *ps_mag = (uint16_t)i_mag;
+   }
+
+   return (int16_t)utl_hardLimit32_32( utl_cordicToQ15( i_z), 15);
+
+}/*End utl_cordicAtan2_16*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicMag3_16
+ *
+ * Description:
+ *    Returns the magnitude of a 3-D vector from two vectoring passes, the
+ *    first finds the magnitude of (x,y) and the second the magnitude of
+ *    that and z.
+ *
+ * Parameters:
+ *    s_x, s_y, s_z - Q1.15 numbers
+ *
+ * Return:
+ *    s_mag - Q1.15 magnitude sqrt(x^2 + y^2 + z^2) with a range of 0 to
+ *            56756
+ *---------------------------------------------------------------------------*/
+uint16_t utl_cordicMag3_16( int16_t s_x,
+                            int16_t s_y,
+                            int16_t s_z)
+{
+   int32_t i_x = utl_abs32_32( (int32_t)s_x);
+   int32_t i_y = utl_abs32_32( (int32_t)s_y);
+   int32_t i_z = 0;
+   uint16_t s_invGain = gas_cordicInvGain[UTL_CORDIC_ITERATIONS - 1];
+   int8_t c_norm;
+
+   c_norm = utl_cordicNormShift( (uint32_t)(i_x | i_y |
+   utl_abs32_32( (int32_t)s_z)));
+
+   i_x = i_x*((int32_t)1 << c_norm)*CORDIC_GUARD;
+   i_y = i_y*((int32_t)1 << c_norm)*CORDIC_GUARD;
+
+   utl_cordicCircular( &i_x, &i_y, &i_z, CORDIC_VECTOR);
+
+   i_x = utl_cordicRemoveGain( i_x, s_invGain)*CORDIC_GUARD;
+   i_y = (int32_t)s_z*((int32_t)1 << c_norm)*CORDIC_GUARD;
+
+   utl_cordicCircular( &i_x, &i_y, &i_z, CORDIC_VECTOR);
+
+   i_x = utl_cordicRemoveGain( i_x, s_invGain);
+   if( c_norm > 0)
+      i_x = (i_x + ((int32_t)1 << (c_norm - 1))) >> c_norm;
+
+   if( i_x > 65535)
+      i_x = 65535;
+
+   return (uint16_t)i_x;
+
+}/*End utl_cordicMag3_16*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicSqrt32
+ *
+ * Description:
+ *    Performs a 32-bit square root with the hyperbolic CORDIC, using
+ *    sqrt(w) = sqrt((w + 1/4)^2 - (w - 1/4)^2). The input is normalized
+ *    by an even power of two into the range .5 <= w < 2, where the
+ *    iterations converge, and the square root of the power of two is
+ *    applied as a shift afterwards. Takes the same arguments as
+ *    utl_sqrt32_32.
+ *
+ * Parameters:
+ *    i_input - Qm.n 32-bit number where m is the number of integer bits and n
+ *              is the number of fractional bits.
+ *    c_n - Number of fractional bits in i_input and i_sqrt, 0 to 31
+ *
+ * Return:
+ *    i_sqrt - Qm.n 32-bit number where m is the number of integer bits and n
+ *             is the number of fractional bits.
+ *---------------------------------------------------------------------------*/
+uint32_t utl_cordicSqrt32( uint32_t i_input,
+                           int8_t c_n)
+{
+   int32_t i_x;
+   int32_t i_y;
+   int32_t i_z = 0;
+   int32_t i_sqrt;
+   int8_t c_k;
+   int8_t c_shift;
+
+   if( i_input == 0)
+      return 0;
+
+   /*------------------------------------------------------------------------*
+    * The square root of a Qn number in Qn is the square root of the integer
+    * P = i_input*2^n. c_k is the even power of two that brings P into the
+    * range .5 to 2.
+    *------------------------------------------------------------------------*/
+   c_k = utl_cordicBitLength( i_input) + c_n;
+   c_k = c_k & ~1;
+
+   c_shift = c_n + UTL_CORDIC_FRAC_BITS - c_k;
+   if( c_shift >= 0)
+      i_x = (int32_t)(i_input << c_shift);
+   else
+      i_x = (int32_t)(i_input >> -c_shift);
+
+   i_y = i_x - (UTL_CORDIC_ONE >> 2);
+   i_x = i_x + (UTL_CORDIC_ONE >> 2);
+
+   utl_cordicHyperbolic( &i_x, &i_y, &i_z, CORDIC_VECTOR);
+
+   i_sqrt = utl_cordicRemoveGain( i_x,
+   gas_cordicInvGainH[UTL_CORDIC_ITERATIONS - 1]);
+
+   /*------------------------------------------------------------------------*
+    * sqrt(P) = sqrt(w)*2^(k/2), where sqrt(w) is Q15.
+    *------------------------------------------------------------------------*/
+   c_shift = (c_k >> 1) - 15;
+   if( c_shift >= 0)
+      return (uint32_t)i_sqrt << c_shift;
+
+   c_shift = -c_shift;
+
+   return (uint32_t)((i_sqrt + ((int32_t)1 << (c_shift - 1))) >> c_shift);
+
+}/*End utl_cordicSqrt32*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicLn32
+ *
+ * Description:
+ *    Performs a natural logarithm on the Q17.15 input. The input is written
+ *    as y = (2^M)*z with .5 <= z < 1, so ln(y) = M*ln(2) + ln(z), and ln(z)
+ *    = 2*atanh((z - 1)/(z + 1)) is found with the hyperbolic CORDIC in
+ *    vectoring mode.
+ *
+ * Parameters:
+ *    i_y - Q17.15 32-bit number with a range of 0.000030517578125 to
+ *          131071.999969482421875 (1 to 4,294,967,295)
+ *
+ * Return:
+ *    i_ln - Q16.15 32-bit number with a range of -10.397 to 11.784
+ *           (-340,695 to 386,127)
+ *---------------------------------------------------------------------------*/
+int32_t utl_cordicLn32( uint32_t i_y)
+{
+   int32_t i_x;
+   int32_t i_z = 0;
+   int32_t i_m;
+   int8_t c_len;
+   int8_t c_shift;
+
+   /*------------------------------------------------------------------------*
+    * Hard limit...
+    *------------------------------------------------------------------------*/
+   if( i_y == 0)
+      i_y = 1;
+
+   c_len = utl_cordicBitLength( i_y);
+
+   c_shift = UTL_CORDIC_FRAC_BITS - c_len;
+   if( c_shift >= 0)
+      i_m = (int32_t)(i_y << c_shift);
+   else
+      i_m = (int32_t)(i_y >> -c_shift);
+
+   i_x = i_m + UTL_CORDIC_ONE;
+   i_m = i_m - UTL_CORDIC_ONE;
+
+   utl_cordicHyperbolic( &i_x, &i_m, &i_z, CORDIC_VECTOR);
+
+   /*------------------------------------------------------------------------*
+    * M = c_len - 15 since the input is Q15.
+    *------------------------------------------------------------------------*/
+   c_len = c_len - 15;
+
+   return (int32_t)c_len*CORDIC_LN2_Q15 + utl_cordicToQ15( 2*i_z +
+   (int32_t)c_len*CORDIC_LN2_RES);
+
+}/*End utl_cordicLn32*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cordicExp32
+ *
+ * Description:
+ *    Performs an exponential on the Q16.15 input. The input is written as
+ *    x = M*ln(2) + r with |r| <= ln(2)/2, so exp(x) = (2^M)*exp(r), and
+ *    exp(r) = cosh(r) + sinh(r) is found with the hyperbolic CORDIC in
+ *    rotation mode.
+ *
+ * Parameters:
+ *    i_x - Q16.15 32-bit number, inputs above 11.784 (386,127) saturate
+ *
+ * Return:
+ *    i_exp - Q17.15 32-bit number with a range of 0 to
+ *            131071.999969482421875 (0 to 4,294,967,295)
+ *---------------------------------------------------------------------------*/
+uint32_t utl_cordicExp32( int32_t i_x)
+{
+   int32_t i_y = 0;
+   int32_t i_z;
+   int32_t i_m;
+   uint32_t i_exp;
+   int8_t c_shift;
+
+   if( i_x >= CORDIC_EXP_MAX_INPUT)
+      return 0xFFFFFFFF;
+
+   /*------------------------------------------------------------------------*
+    * M = round( x/ln(2))
+    *------------------------------------------------------------------------*/
+   if( i_x >= 0)
+      i_m = (i_x + (CORDIC_LN2_Q15 >> 1)) / CORDIC_LN2_Q15;
+   else
+      i_m = (i_x - (CORDIC_LN2_Q15 >> 1)) / CORDIC_LN2_Q15;
+
+   /*------------------------------------------------------------------------*
+    * Below 2^-17 the result rounds to zero.
+    *------------------------------------------------------------------------*/
+   if( i_m < -16)
+      return 0;
+
+   i_z = (i_x - i_m*CORDIC_LN2_Q15)*CORDIC_GUARD - i_m*CORDIC_LN2_RES;
+   i_x = (int32_t)gas_cordicInvGainH[UTL_CORDIC_ITERATIONS - 1]*CORDIC_GUARD;
+
+   utl_cordicHyperbolic( &i_x, &i_y, &i_z, CORDIC_ROTATE);
+
+   /*------------------------------------------------------------------------*
+    * exp(r) = x + y in Q(UTL_CORDIC_FRAC_BITS), scaled by 2^M into Q15.
+    *------------------------------------------------------------------------*/
+   i_exp = (uint32_t)(i_x + i_y);
+   c_shift = (int8_t)i_m - UTL_CORDIC_GUARD_BITS;
+   if( c_shift >= 0)
+   {
+      if( i_exp > (0xFFFFFFFF >> c_shift))
+         return 0xFFFFFFFF;
+
+      return i_exp << c_shift;
+   }
+
+   c_shift = -c_shift;
+
+   return (i_exp + ((uint32_t)1 << (c_shift - 1))) >> c_shift;
+
+}/*End utl_cordicExp32*/
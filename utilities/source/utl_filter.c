@@ -0,0 +1,512 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_filter.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Block processing Q15 FIR, biquad IIR, moving average and
+ *               CIC decimation filters.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include "utl_filter.h"
+#include "utl_math.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Inline Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_filterMac
+ *
+ * Description:
+ *    Accumulates 's_length' products of 'ps_x' walking forward and 'ps_h'
+ *    walking backward, the inner loop of the FIR filter. 'ps_h' points at
+ *    the first tap used.
+ *---------------------------------------------------------------------------*/
+static inline int32_t __attribute__((always_inline)) \
+utl_filterMac( const int16_t *ps_x,
+               const int16_t *ps_h,
+               int32_t i_y,
+               uint16_t s_length,
+               int8_t c_o)
+{
+   while( s_length--)
+   {
+      i_y = utl_mac16x16_32( *ps_x, *ps_h, i_y, c_o);
+      ps_x++;
+      ps_h--;
+   }
+
+   return i_y;
+
+}/*End utl_filterMac*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_filterToQ15
+ *
+ * Description:
+ *    Shifts an accumulator with 'c_n' fractional bits below Q15 back to
+ *    Q15 and saturates it. The magnitude is rounded, the same as
+ *    'utl_mult16x16_32'.
+ *---------------------------------------------------------------------------*/
+static inline int16_t __attribute__((always_inline)) \
+utl_filterToQ15( int32_t i_y,
+                 int8_t c_n)
+{
+   int32_t i_sign;
+   uint32_t i_mag;
+
+   if( c_n > 0)
+   {
+      i_sign = i_y >> 31;
+      i_mag  = ((uint32_t)i_y ^ (uint32_t)i_sign) - (uint32_t)i_sign;
+      i_mag  = (i_mag + ((uint32_t)1 << (c_n - 1))) >> c_n;
+      i_y    = ((int32_t)i_mag ^ i_sign) - i_sign;
+   }
+
+   return (int16_t)utl_hardLimit32_32( i_y, 15);
+
+}/*End utl_filterToQ15*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_filterError utl_initFir( t_firFilter *pt_fir,
+                           const int16_t *ps_coeffs,
+                           uint16_t s_numTaps,
+                           int16_t *ps_state,
+                           int8_t c_o)
+{
+   if( (pt_fir == NULL) || (ps_coeffs == NULL))
+      return FILTER_NULL_PTR;
+
+   if( (s_numTaps == 0) || (c_o < 0) || (c_o > 15))
+      return FILTER_INVALID_ARG;
+
+   if( (ps_state == NULL) && (s_numTaps > 1))
+      return FILTER_NULL_PTR;
+
+   pt_fir->ps_coeffs = ps_coeffs;
+   pt_fir->ps_state  = ps_state;
+   pt_fir->s_numTaps = s_numTaps;
+   pt_fir->c_o       = c_o;
+
+   if( s_numTaps > 1)
+      memset( (void *)ps_state, 0, UTL_FILTER_FIR_STATE_SIZE( s_numTaps)*
+      sizeof( int16_t));
+
+   return FILTER_PASSED;
+
+}/*End utl_initFir*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_fir16
+ *
+ * Description:
+ *    Filters a block of Q15 samples,
+ *       y[n] = sum( h[k]*x[n-k]), k = 0 to s_numTaps - 1
+ *    The samples that came before the block are taken from the state, so
+ *    consecutive blocks are filtered as one continuous signal.
+ *
+ * Parameters:
+ *    pt_fir - Filter set up by 'utl_initFir'
+ *    ps_in - 's_length' Q15 input samples
+ *    ps_out - 's_length' Q15 outputs, can't overlap 'ps_in'
+ *    s_length - Number of samples in the block
+ *---------------------------------------------------------------------------*/
+void utl_fir16( t_firFilter *pt_fir,
+                const int16_t *ps_in,
+                int16_t *ps_out,
+                uint16_t s_length)
+{
+   const int16_t *ps_h = pt_fir->ps_coeffs;
+   int16_t *ps_state   = pt_fir->ps_state;
+   uint16_t s_numHist  = pt_fir->s_numTaps - 1;
+   int8_t c_o          = pt_fir->c_o;
+   uint16_t s_index;
+   uint16_t s_fromHist;
+   int32_t i_y;
+
+   for( s_index = 0; s_index < s_length; s_index++)
+   {
+      /*---------------------------------------------------------------------*
+       * The window for this output runs from the oldest sample to the
+       * newest, h[s_numTaps - 1] down to h[0]. Its first part is still in
+       * the state and the rest is in the block, each part is contiguous.
+       *---------------------------------------------------------------------*/
+      s_fromHist = 0;
+      if( s_index < s_numHist)
+         s_fromHist = s_numHist - s_index;
+
+      i_y = utl_filterMac( &ps_state[s_index],
+                           &ps_h[s_numHist],
+                           0,
+                           s_fromHist,
+                           c_o);
+
+      i_y = utl_filterMac( &ps_in[s_index + s_fromHist - s_numHist],
+                           &ps_h[s_numHist - s_fromHist],
+                           i_y,
+                           s_numHist + 1 - s_fromHist,
+                           c_o);
+
+      ps_out[s_index] = utl_filterToQ15( i_y, 15 - c_o);
+
+   }/*End for( s_index = 0; s_index < s_length; s_index++)*/
+
+   /*------------------------------------------------------------------------*
+    * Keep the last s_numHist samples for the next block.
+    *------------------------------------------------------------------------*/
+   if( s_length >= s_numHist)
+   {
+      memcpy( (void *)ps_state,
+              (void *)&ps_in[s_length - s_numHist],
+              s_numHist*sizeof( int16_t));
+   }
+   else
+   {
+      memmove( (void *)ps_state,
+               (void *)&ps_state[s_length],
+               (s_numHist - s_length)*sizeof( int16_t));
+      memcpy( (void *)&ps_state[s_numHist - s_length],
+              (void *)ps_in,
+              s_length*sizeof( int16_t));
+   }
+
+}/*End utl_fir16*/
+
+t_filterError utl_initBiquad( t_biquadFilter *pt_biquad,
+                              const int16_t *ps_coeffs,
+                              uint8_t c_numStages,
+                              int16_t *ps_state,
+                              int8_t c_n)
+{
+   if( (pt_biquad == NULL) || (ps_coeffs == NULL) || (ps_state == NULL))
+      return FILTER_NULL_PTR;
+
+   if( (c_numStages == 0) || (c_n < 1) || (c_n > 15))
+      return FILTER_INVALID_ARG;
+
+   pt_biquad->ps_coeffs   = ps_coeffs;
+   pt_biquad->ps_state    = ps_state;
+   pt_biquad->c_numStages = c_numStages;
+   pt_biquad->c_n         = c_n;
+
+   memset( (void *)ps_state, 0, UTL_FILTER_BIQUAD_STATE_SIZE( c_numStages)*
+   sizeof( int16_t));
+
+   return FILTER_PASSED;
+
+}/*End utl_initBiquad*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_biquad16
+ *
+ * Description:
+ *    Runs a block of Q15 samples through a cascade of direct form I
+ *    biquad sections,
+ *       y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ *    The whole block goes through one stage before the next, so a stage's
+ *    coefficients and state stay in registers for the block. Each output
+ *    is saturated to Q15, the 32-bit accumulator has room for the
+ *    intermediate sums of any stable section with Q14 coefficients.
+ *
+ * Parameters:
+ *    pt_biquad - Filter set up by 'utl_initBiquad'
+ *    ps_in - 's_length' Q15 input samples
+ *    ps_out - 's_length' Q15 outputs, may be 'ps_in'
+ *    s_length - Number of samples in the block
+ *---------------------------------------------------------------------------*/
+void utl_biquad16( t_biquadFilter *pt_biquad,
+                   const int16_t *ps_in,
+                   int16_t *ps_out,
+                   uint16_t s_length)
+{
+   const int16_t *ps_coeffs = pt_biquad->ps_coeffs;
+   int16_t *ps_state        = pt_biquad->ps_state;
+   const int16_t *ps_x      = ps_in;
+   int8_t c_n               = pt_biquad->c_n;
+   uint8_t c_stage;
+   uint16_t s_index;
+   int16_t s_b0;
+   int16_t s_b1;
+   int16_t s_b2;
+   int16_t s_a1;
+   int16_t s_a2;
+   int16_t s_x0;
+   int16_t s_x1;
+   int16_t s_x2;
+   int16_t s_y1;
+   int16_t s_y2;
+   int32_t i_y;
+
+   for( c_stage = 0; c_stage < pt_biquad->c_numStages; c_stage++)
+   {
+      s_b0 = ps_coeffs[0];
+      s_b1 = ps_coeffs[1];
+      s_b2 = ps_coeffs[2];
+      s_a1 = ps_coeffs[3];
+      s_a2 = ps_coeffs[4];
+
+      s_x1 = ps_state[0];
+      s_x2 = ps_state[1];
+      s_y1 = ps_state[2];
+      s_y2 = ps_state[3];
+
+      for( s_index = 0; s_index < s_length; s_index++)
+      {
+         s_x0 = ps_x[s_index];
+
+         i_y = utl_mac16x16_32( s_b0, s_x0, 0, 0);
+         i_y = utl_mac16x16_32( s_b1, s_x1, i_y, 0);
+         i_y = utl_mac16x16_32( s_b2, s_x2, i_y, 0);
+         i_y -= utl_mac16x16_32( s_a1, s_y1, 0, 0);
+         i_y -= utl_mac16x16_32( s_a2, s_y2, 0, 0);
+
+         s_x2 = s_x1;
+         s_x1 = s_x0;
+         s_y2 = s_y1;
+         s_y1 = utl_filterToQ15( i_y, c_n);
+
+         ps_out[s_index] = s_y1;
+
+      }/*End for( s_index = 0; s_index < s_length; s_index++)*/
+
+      ps_state[0] = s_x1;
+      ps_state[1] = s_x2;
+      ps_state[2] = s_y1;
+      ps_state[3] = s_y2;
+
+      /*---------------------------------------------------------------------*
+       * The next stage filters this stage's output in place.
+       *---------------------------------------------------------------------*/
+      ps_x       = ps_out;
+      ps_coeffs += 5;
+      ps_state  += 4;
+
+   }/*End for( c_stage = 0; c_stage < pt_biquad->c_numStages; c_stage++)*/
+
+}/*End utl_biquad16*/
+
+t_filterError utl_initMovAvg( t_movAvgFilter *pt_avg,
+                              int16_t *ps_window,
+                              uint16_t s_length)
+{
+   if( (pt_avg == NULL) || (ps_window == NULL))
+      return FILTER_NULL_PTR;
+
+   if( s_length == 0)
+      return FILTER_INVALID_ARG;
+
+   pt_avg->ps_window = ps_window;
+   pt_avg->i_sum     = 0;
+   pt_avg->i_gain    = (int32_t)((((uint32_t)1 << 30) + (s_length >> 1)) /
+                       s_length);
+   pt_avg->s_length  = s_length;
+   pt_avg->s_index   = 0;
+
+   memset( (void *)ps_window, 0, s_length*sizeof( int16_t));
+
+   return FILTER_PASSED;
+
+}/*End utl_initMovAvg*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_movAvg16
+ *
+ * Description:
+ *    Each output is the mean of the last 's_length' inputs given to
+ *    'utl_initMovAvg'. A running sum is kept so the cost per sample
+ *    doesn't depend on the length of the window.
+ *
+ * Parameters:
+ *    pt_avg - Filter set up by 'utl_initMovAvg'
+ *    ps_in - 's_length' Q15 input samples
+ *    ps_out - 's_length' Q15 outputs, may be 'ps_in'
+ *    s_length - Number of samples in the block
+ *---------------------------------------------------------------------------*/
+void utl_movAvg16( t_movAvgFilter *pt_avg,
+                   const int16_t *ps_in,
+                   int16_t *ps_out,
+                   uint16_t s_length)
+{
+   int16_t *ps_window = pt_avg->ps_window;
+   int32_t i_sum      = pt_avg->i_sum;
+   uint16_t s_pos     = pt_avg->s_index;
+   uint16_t s_index;
+   int16_t s_x;
+
+   for( s_index = 0; s_index < s_length; s_index++)
+   {
+      s_x = ps_in[s_index];
+
+      i_sum += (int32_t)s_x - (int32_t)ps_window[s_pos];
+      ps_window[s_pos] = s_x;
+
+      s_pos++;
+      if( s_pos == pt_avg->s_length)
+         s_pos = 0;
+
+      ps_out[s_index] = (int16_t)utl_hardLimit32_32( utl_mult32x32_32( i_sum,
+      pt_avg->i_gain, 30), 15);
+
+   }/*End for( s_index = 0; s_index < s_length; s_index++)*/
+
+   pt_avg->i_sum   = i_sum;
+   pt_avg->s_index = s_pos;
+
+}/*End utl_movAvg16*/
+
+t_filterError utl_initCic( t_cicDecimator *pt_cic,
+                           uint8_t c_order,
+                           uint16_t s_decimation)
+{
+   uint32_t i_gain = 1;
+   uint8_t c_index;
+
+   if( pt_cic == NULL)
+      return FILTER_NULL_PTR;
+
+   if( (c_order == 0) || (c_order > UTL_FILTER_CIC_MAX_ORDER) ||
+       (s_decimation == 0))
+   {
+      return FILTER_INVALID_ARG;
+   }
+
+   /*------------------------------------------------------------------------*
+    * The gain R^N can't be more than 2^16, a Q15 input would no longer fit
+    * in the 32-bit registers.
+    *------------------------------------------------------------------------*/
+   for( c_index = 0; c_index < c_order; c_index++)
+   {
+      i_gain *= s_decimation;
+      if( i_gain > ((uint32_t)1 << 16))
+         return FILTER_INVALID_ARG;
+   }
+
+   memset( (void *)pt_cic, 0, sizeof( t_cicDecimator));
+
+   pt_cic->c_order      = c_order;
+   pt_cic->s_decimation = s_decimation;
+
+   while( ((uint32_t)1 << pt_cic->c_shift) < i_gain)
+      pt_cic->c_shift++;
+
+   return FILTER_PASSED;
+
+}/*End utl_initCic*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cicDecimate16
+ *
+ * Description:
+ *    Runs a block of Q15 samples through c_order integrators at the input
+ *    rate, keeps every s_decimation'th one, and runs those through c_order
+ *    combs at the output rate. The result is scaled by 2^-c_shift, so the
+ *    passband gain is R^N/2^c_shift, 1 when the decimation is a power of
+ *    two. A block doesn't have to be a multiple of the decimation, the
+ *    phase carries over to the next call.
+ *
+ * Parameters:
+ *    pt_cic - Decimator set up by 'utl_initCic'
+ *    ps_in - 's_length' Q15 input samples
+ *    ps_out - Q15 outputs, room for s_length/s_decimation + 1. May be
+ *             'ps_in'.
+ *    s_length - Number of samples in the block
+ *
+ * Return:
+ *    The number of outputs written.
+ *---------------------------------------------------------------------------*/
+uint16_t utl_cicDecimate16( t_cicDecimator *pt_cic,
+                            const int16_t *ps_in,
+                            int16_t *ps_out,
+                            uint16_t s_length)
+{
+   uint8_t c_order   = pt_cic->c_order;
+   uint16_t s_count  = pt_cic->s_count;
+   uint16_t s_numOut = 0;
+   uint16_t s_index;
+   uint8_t c_stage;
+   uint32_t i_acc;
+   uint32_t i_prev;
+
+   for( s_index = 0; s_index < s_length; s_index++)
+   {
+      i_acc = (uint32_t)(int32_t)ps_in[s_index];
+      for( c_stage = 0; c_stage < c_order; c_stage++)
+      {
+         pt_cic->ai_integ[c_stage] += i_acc;
+         i_acc = pt_cic->ai_integ[c_stage];
+      }
+
+      s_count++;
+      if( s_count == pt_cic->s_decimation)
+      {
+         s_count = 0;
+
+         for( c_stage = 0; c_stage < c_order; c_stage++)
+         {
+            i_prev = pt_cic->ai_comb[c_stage];
+            pt_cic->ai_comb[c_stage] = i_acc;
+            i_acc -= i_prev;
+         }
+
+         ps_out[s_numOut] = utl_filterToQ15( (int32_t)i_acc, pt_cic->c_shift);
+         s_numOut++;
+
+      }/*End if( s_count == pt_cic->s_decimation)*/
+
+   }/*End for( s_index = 0; s_index < s_length; s_index++)*/
+
+   pt_cic->s_count = s_count;
+
+   return s_numOut;
+
+}/*End utl_cicDecimate16*/
@@ -0,0 +1,282 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_frame.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file provides a set of routines for packing binary
+ *               messages into CRC protected COBS frames.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "utl_frame.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define FRAME_CRC_INIT      (0xFFFF)
+#define FRAME_MAX_CODE      (0xFF)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+
+   /*------------------------------------------------------------------------*
+    * Output buffer the encoded bytes are written to.
+    *------------------------------------------------------------------------*/
+   uint8_t *pc_out;
+
+   /*------------------------------------------------------------------------*
+    * Location of the code byte for the block currently being encoded.
+    *------------------------------------------------------------------------*/
+   uint16_t s_codeIndex;
+
+   /*------------------------------------------------------------------------*
+    * Location where the next data byte is written.
+    *------------------------------------------------------------------------*/
+   uint16_t s_wrIndex;
+
+   /*------------------------------------------------------------------------*
+    * Distance to the next zero (the value of the current code byte).
+    *------------------------------------------------------------------------*/
+   uint8_t c_code;
+
+}t_cobsEncoder;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void frameEncodeBlock( t_cobsEncoder *pt_enc,
+                              const uint8_t *pc_data,
+                              uint16_t s_size);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void frameEncodeBlock( t_cobsEncoder *pt_enc,
+                              const uint8_t *pc_data,
+                              uint16_t s_size)
+{
+   uint16_t s_index;
+
+   for( s_index = 0; s_index < s_size; s_index++)
+   {
+      if( pc_data[s_index] == 0)
+      {
+         /*------------------------------------------------------------------*
+          * Close the current block, the zero is implied by its code.
+          *------------------------------------------------------------------*/
+         pt_enc->pc_out[pt_enc->s_codeIndex] = pt_enc->c_code;
+         pt_enc->s_codeIndex = pt_enc->s_wrIndex;
+         pt_enc->s_wrIndex++;
+         pt_enc->c_code = 1;
+      }
+      else
+      {
+         pt_enc->pc_out[pt_enc->s_wrIndex] = pc_data[s_index];
+         pt_enc->s_wrIndex++;
+         pt_enc->c_code++;
+
+         /*------------------------------------------------------------------*
+          * A block holds at most 254 data bytes.
+          *------------------------------------------------------------------*/
+         if( pt_enc->c_code == FRAME_MAX_CODE)
+         {
+            pt_enc->pc_out[pt_enc->s_codeIndex] = pt_enc->c_code;
+            pt_enc->s_codeIndex = pt_enc->s_wrIndex;
+            pt_enc->s_wrIndex++;
+            pt_enc->c_code = 1;
+         }
+      }
+
+   }/*End for( s_index = 0; s_index < s_size; s_index++)*/
+
+}/*End frameEncodeBlock*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+uint16_t utl_crc16( uint16_t s_crc,
+                    const uint8_t *pc_data,
+                    uint16_t s_size)
+{
+   uint8_t c_x;
+
+   while( s_size > 0)
+   {
+      /*---------------------------------------------------------------------*
+       * Byte-wise CRC-16/CCITT (poly 0x1021) without a lookup table.
+       *---------------------------------------------------------------------*/
+      c_x = (uint8_t)(s_crc >> 8) ^ *pc_data;
+      c_x ^= c_x >> 4;
+      s_crc = (s_crc << 8) ^ ((uint16_t)c_x << 12) ^ ((uint16_t)c_x << 5) ^
+      (uint16_t)c_x;
+
+      pc_data++;
+      s_size--;
+   }
+
+   return s_crc;
+
+}/*End utl_crc16*/
+
+int16_t utl_frameEncode( uint8_t c_msgId,
+                         uint8_t c_version,
+                         uint8_t c_seq,
+                         const void *pv_payload,
+                         uint16_t s_size,
+                         uint8_t *pc_out,
+                         uint16_t s_outSize)
+{
+   t_cobsEncoder t_enc;
+   uint8_t ac_hdr[UTL_FRAME_HDR_SIZE];
+   uint8_t ac_crc[UTL_FRAME_CRC_SIZE];
+   uint16_t s_crc;
+
+   if( (pc_out == NULL) || ((pv_payload == NULL) && (s_size > 0)))
+      return (int16_t)FRAME_NULL_PTR;
+
+   if( UTL_FRAME_MAX_ENCODED_SIZE( (uint32_t)s_size) > s_outSize)
+      return (int16_t)FRAME_INVALID_SIZE;
+
+   ac_hdr[0] = c_msgId;
+   ac_hdr[1] = c_version;
+   ac_hdr[2] = c_seq;
+
+   s_crc = utl_crc16( FRAME_CRC_INIT,
+                      ac_hdr,
+                      UTL_FRAME_HDR_SIZE);
+   s_crc = utl_crc16( s_crc,
+                      (const uint8_t *)pv_payload,
+                      s_size);
+
+   ac_crc[0] = (uint8_t)(s_crc & 0xFF);
+   ac_crc[1] = (uint8_t)(s_crc >> 8);
+
+   /*------------------------------------------------------------------------*
+    * Leading delimiter followed by the first (not yet known) code byte.
+    *------------------------------------------------------------------------*/
+   pc_out[0]         = UTL_FRAME_DELIM;
+   t_enc.pc_out      = pc_out;
+   t_enc.s_codeIndex = 1;
+   t_enc.s_wrIndex   = 2;
+   t_enc.c_code      = 1;
+
+   frameEncodeBlock( &t_enc,
+                     ac_hdr,
+                     UTL_FRAME_HDR_SIZE);
+   frameEncodeBlock( &t_enc,
+                     (const uint8_t *)pv_payload,
+                     s_size);
+   frameEncodeBlock( &t_enc,
+                     ac_crc,
+                     UTL_FRAME_CRC_SIZE);
+
+   /*------------------------------------------------------------------------*
+    * Close the last block and terminate the frame.
+    *------------------------------------------------------------------------*/
+   pc_out[t_enc.s_codeIndex] = t_enc.c_code;
+   pc_out[t_enc.s_wrIndex]   = UTL_FRAME_DELIM;
+   t_enc.s_wrIndex++;
+
+   return (int16_t)t_enc.s_wrIndex;
+
+}/*End utl_frameEncode*/
+
+t_frameError utl_frameDecode( uint8_t *pc_frame,
+                              uint16_t s_size,
+                              t_frameMsg *pt_msg)
+{
+   uint16_t s_rdIndex = 0;
+   uint16_t s_wrIndex = 0;
+   uint16_t s_crc;
+   uint8_t c_code;
+   uint8_t c_index;
+
+   if( (pc_frame == NULL) || (pt_msg == NULL))
+      return FRAME_NULL_PTR;
+
+   /*------------------------------------------------------------------------*
+    * Undo the byte stuffing. The decoded data is never longer than the
+    * encoded data so the frame can be decoded in place.
+    *------------------------------------------------------------------------*/
+   while( s_rdIndex < s_size)
+   {
+      c_code = pc_frame[s_rdIndex];
+      s_rdIndex++;
+
+      if( c_code == 0)
+         return FRAME_DECODE_ERROR;
+
+      for( c_index = 1; c_index < c_code; c_index++)
+      {
+         if( s_rdIndex >= s_size)
+            return FRAME_DECODE_ERROR;
+
+         pc_frame[s_wrIndex] = pc_frame[s_rdIndex];
+         s_wrIndex++;
+         s_rdIndex++;
+      }
+
+      /*---------------------------------------------------------------------*
+       * Every block except the last and those of maximum length ends in a
+       * zero.
+       *---------------------------------------------------------------------*/
+      if( (c_code < FRAME_MAX_CODE) && (s_rdIndex < s_size))
+      {
+         pc_frame[s_wrIndex] = 0;
+         s_wrIndex++;
+      }
+
+   }/*End while( s_rdIndex < s_size)*/
+
+   if( s_wrIndex < (UTL_FRAME_HDR_SIZE + UTL_FRAME_CRC_SIZE))
+      return FRAME_INVALID_SIZE;
+
+   s_wrIndex -= UTL_FRAME_CRC_SIZE;
+   s_crc = utl_crc16( FRAME_CRC_INIT,
+                      pc_frame,
+                      s_wrIndex);
+
+   if( (pc_frame[s_wrIndex] != (uint8_t)(s_crc & 0xFF)) ||
+   (pc_frame[s_wrIndex + 1] != (uint8_t)(s_crc >> 8)))
+   {
+      return FRAME_CRC_ERROR;
+   }
+
+   pt_msg->c_msgId    = pc_frame[0];
+   pt_msg->c_version  = pc_frame[1];
+   pt_msg->c_seq      = pc_frame[2];
+   pt_msg->pc_payload = &pc_frame[UTL_FRAME_HDR_SIZE];
+   pt_msg->s_size     = s_wrIndex - UTL_FRAME_HDR_SIZE;
+
+   return FRAME_PASSED;
+
+}/*End utl_frameDecode*/
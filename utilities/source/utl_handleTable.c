@@ -0,0 +1,100 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_handleTable.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file provides the routines for registering and
+ *               removing handles from an ID-indexed handle table.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "utl_handleTable.h"
+#include "hal_pmic.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_handleTableError utl_insertHandle( t_handleTable *pt_table,
+                                     uint8_t c_id,
+                                     void *pv_handle)
+{
+   if( pv_handle == NULL)
+      return HANDLE_TABLE_NULL_PTR;
+
+   if( c_id >= pt_table->c_numSlots)
+      return HANDLE_TABLE_INVALID_ID;
+
+   /*------------------------------------------------------------------------*
+    * The slots are read from interrupts, make sure the (two byte) pointer
+    * is written atomically.
+    *------------------------------------------------------------------------*/
+   HAL_BEGIN_CRITICAL();
+
+   if( pt_table->ppv_slots[c_id] != NULL)
+   {
+      HAL_END_CRITICAL();
+      return HANDLE_TABLE_SLOT_USED;
+   }
+
+   pt_table->ppv_slots[c_id] = pv_handle;
+
+   HAL_END_CRITICAL();
+
+   return HANDLE_TABLE_PASSED;
+
+}/*End utl_insertHandle*/
+
+t_handleTableError utl_removeHandle( t_handleTable *pt_table,
+                                     uint8_t c_id)
+{
+   if( c_id >= pt_table->c_numSlots)
+      return HANDLE_TABLE_INVALID_ID;
+
+   HAL_BEGIN_CRITICAL();
+   pt_table->ppv_slots[c_id] = NULL;
+   HAL_END_CRITICAL();
+
+   return HANDLE_TABLE_PASSED;
+
+}/*End utl_removeHandle*/
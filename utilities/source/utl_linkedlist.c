@@ -20,9 +20,9 @@
  *               <https://code.google.com/p/arbitros/>
  *
  * Description : This file provides an abstraction layer for the creation and
- *               control over linked-list objects.
+ *               control over intrusive linked-list objects.
  *
- * Last Update : June 11, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------*
@@ -31,7 +31,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "arb_memory.h"
-#include "utl_linkedList.h"
+#include "utl_linkedlist.h"
 #include "hal_pmic.h"
 
 /*---------------------------------------------------------------------------*
@@ -50,7 +50,6 @@
 /*---------------------------------------------------------------------------*
  * Private Global Variables
  *---------------------------------------------------------------------------*/
-static uint32_t gi_dynListMemUsage = 0; /*Keeps track of total dyn mem used*/
 
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
@@ -63,10 +62,17 @@ static uint32_t gi_dynListMemUsage = 0; /*Keeps track of total dyn mem used*/
 /*---------------------------------------------------------------------------*
  * Public Function Definitions
  *---------------------------------------------------------------------------*/
-uint32_t utl_getDynListMemUsage( void)
+t_CONTHNDL utl_initContainer( t_listContainer *pt_cont)
 {
-   return gi_dynListMemUsage;
-}/*End utl_getDynListMemUsage*/
+   pt_cont->s_checkSum = LINKEDLIST_CHECKSUM;
+   pt_cont->s_numLinks = 0;
+   pt_cont->pt_curr    = NULL;
+   pt_cont->pt_head    = NULL;
+   pt_cont->pt_tail    = NULL;
+
+   return (t_CONTHNDL)pt_cont;
+
+}/*End utl_initContainer*/
 
 t_CONTHNDL utl_createContainer( void)
 {
@@ -84,24 +90,13 @@ t_CONTHNDL utl_createContainer( void)
    arb_malloc( sizeof( t_listContainer),
                (void **)&pt_cont);
 
-   //pt_cont = (t_listContainer *)malloc( sizeof( t_listContainer));
-
    if( pt_cont == NULL)
    {
       HAL_END_CRITICAL();//Enable interrupts
       return (t_CONTHNDL)LINKEDLIST_OUT_OF_HEAP;
    }/*End if( pt_cont == NULL)*/
 
-   pt_cont->s_checkSum      = LINKEDLIST_CHECKSUM;
-   pt_cont->s_numLinks      = 0;
-   pt_cont->s_contSizeBytes = (uint16_t)sizeof( t_listContainer);
-   pt_cont->pt_head         = NULL;
-   pt_cont->pt_tail         = NULL;
-
-   /*------------------------------------------------------------------------*
-    * Keep track of the total memory usage...
-    *------------------------------------------------------------------------*/
-   gi_dynListMemUsage += pt_cont->s_contSizeBytes;
+   utl_initContainer( pt_cont);
 
    HAL_END_CRITICAL();//Enable interrupts
 
@@ -124,20 +119,15 @@ t_linkedListError utl_destroyContainer( t_CONTHNDL t_contHndl)
    if( pt_cont->s_checkSum == LINKEDLIST_CHECKSUM)
    {
       /*---------------------------------------------------------------------*
-       * Keep track of the total amount of memory being consumed...
+       * Clear the old memory region, so that stale handles no longer pass
+       * the checksum test.
        *---------------------------------------------------------------------*/
-      gi_dynListMemUsage -= pt_cont->s_contSizeBytes;
+      memset( pt_cont, 0, sizeof( t_listContainer));
 
       /*---------------------------------------------------------------------*
-       * Delete this 'link' from memory.
+       * Delete this 'container' from memory.
        *---------------------------------------------------------------------*/
       arb_free( (void **)&pt_cont);
-      //free( (void *)pt_cont);
-
-      /*---------------------------------------------------------------------*
-       * Clear the old memory region.
-       *---------------------------------------------------------------------*/
-      memset( pt_cont, 0, sizeof( t_listContainer));
 
    }/*End if( pt_cont->s_checkSum == LINKEDLIST_CHECKSUM)*/
    else
@@ -152,10 +142,22 @@ t_linkedListError utl_destroyContainer( t_CONTHNDL t_contHndl)
 
 }/*End utl_destroyContainer*/
 
+t_LINKHNDL utl_initLink( t_listLink *pt_link)
+{
+   pt_link->s_contAddr = LINKEDLIST_LINK_UNMAPPED;
+   pt_link->pt_next    = NULL;
+   pt_link->pt_prev    = NULL;
+
+   return (t_LINKHNDL)pt_link;
+
+}/*End utl_initLink*/
+
 t_LINKHNDL utl_createLink( uint16_t s_elementSizeBytes)
 {
    t_listLink *pt_link;
-   void *pv_element;
+
+   if( s_elementSizeBytes < (uint16_t)sizeof( t_listLink))
+      return (t_LINKHNDL)LINKEDLIST_INVALID_LINK;
 
    /*------------------------------------------------------------------------*
     * We are going to be adding an element to a shared list so enforce
@@ -164,55 +166,25 @@ t_LINKHNDL utl_createLink( uint16_t s_elementSizeBytes)
    HAL_BEGIN_CRITICAL(); //Disable interrupts
 
    /*------------------------------------------------------------------------*
-    * Allocated memory for the new linked-list 'link'
+    * Allocated memory for the new 'element', the 'link' lives at the start
+    * of it.
     *------------------------------------------------------------------------*/
-   arb_malloc( sizeof(t_listLink),
+   arb_malloc( (size_t)s_elementSizeBytes,
                (void **)&pt_link);
 
-   //pt_link = (t_listLink *)malloc( sizeof(t_listLink));
-
    if( pt_link == NULL)
    {
       HAL_END_CRITICAL();//Enable interrupts
       return (t_LINKHNDL)LINKEDLIST_OUT_OF_HEAP;
    }/*End if( pt_link == NULL)*/
 
-   /*------------------------------------------------------------------------*
-    * Allocated memory for the new linked-list 'element'
-    *------------------------------------------------------------------------*/
-   arb_malloc( (size_t)s_elementSizeBytes,
-               (void **)&pv_element);
-
-   //pv_element = (void *)malloc( s_elementSizeBytes);
-
-   if( pv_element == NULL)
-   {
-      /*---------------------------------------------------------------------*
-       * Delete this 'link' from memory.
-       *---------------------------------------------------------------------*/
-      arb_free( (void **)&pt_link);
-      //free( (void *)pt_link);
-      HAL_END_CRITICAL();//Enable interrupts
-      return (t_LINKHNDL)LINKEDLIST_OUT_OF_HEAP;
-   }/*End if( pv_element == NULL)*/
-
    /*------------------------------------------------------------------------*
     * Initialize the element memory with 0xFF's
     *------------------------------------------------------------------------*/
-   memset( pv_element, 0xFF, s_elementSizeBytes);
+   memset( (void *)(pt_link + 1), 0xFF, s_elementSizeBytes -
+   sizeof( t_listLink));
 
-   pt_link->pv_element         = pv_element;
-   pt_link->s_contAddr         = LINKEDLIST_LINK_UNMAPPED;
-   pt_link->s_elementSizeBytes = s_elementSizeBytes;
-   pt_link->s_linkSizeBytes    = (uint16_t)sizeof( t_listLink) +
-   s_elementSizeBytes;
-   pt_link->pt_next            = NULL;
-   pt_link->pt_prev            = NULL;
-
-   /*------------------------------------------------------------------------*
-    * Keep track of the total memory usage...
-    *------------------------------------------------------------------------*/
-   gi_dynListMemUsage += pt_link->s_linkSizeBytes;
+   utl_initLink( pt_link);
 
    HAL_END_CRITICAL();//Enable interrupts
 
@@ -303,7 +275,6 @@ t_linkedListError utl_insertLink( t_CONTHNDL t_contHndl,
        * Update the status for this container...
        *---------------------------------------------------------------------*/
       pt_cont->s_numLinks++;
-      pt_cont->s_contSizeBytes += pt_link->s_linkSizeBytes;
 
    }/*End if( pt_cont->s_checkSum == LINKEDLIST_CHECKSUM)*/
    else
@@ -321,10 +292,8 @@ t_linkedListError utl_insertLink( t_CONTHNDL t_contHndl,
 t_linkedListError utl_destroyLink( t_CONTHNDL t_contHndl,
                                    t_LINKHNDL t_linkHndl)
 {
-   t_listContainer *pt_cont;
+   t_linkedListError t_err;
    t_listLink *pt_curr;
-   static t_listLink *pt_prev = NULL;
-   static t_listLink *pt_next = NULL;
 
    /*------------------------------------------------------------------------*
     * Since we are about to act on global variables, protect this region
@@ -333,97 +302,22 @@ t_linkedListError utl_destroyLink( t_CONTHNDL t_contHndl,
     *------------------------------------------------------------------------*/
    HAL_BEGIN_CRITICAL();
 
-   pt_cont = (t_listContainer *)t_contHndl;
+   t_err = utl_removeLink( t_contHndl,
+                           t_linkHndl);
 
-   /*------------------------------------------------------------------------*
-    * Is this a valid container?
-    *------------------------------------------------------------------------*/
-   if( pt_cont->s_checkSum == LINKEDLIST_CHECKSUM) /*Yes*/
+   if( t_err == LINKEDLIST_PASSED)
    {
-      pt_curr = (t_listLink *)t_linkHndl;
-
       /*---------------------------------------------------------------------*
-       * Is this 'link' on the list?
-       *---------------------------------------------------------------------*/
-      if( UTL_IS_LINK_ON_LIST( t_linkHndl, t_contHndl) == false) /*No*/
-      {
-         HAL_END_CRITICAL();//Enable interrupts
-         return LINKEDLIST_INVALID_LINK;
-      }
-
-      pt_prev = pt_curr->pt_prev;
-      pt_next = pt_curr->pt_next;
-
-      /*---------------------------------------------------------------------*
-       * Are there other 'links' still on the list?
-       *---------------------------------------------------------------------*/
-      if( pt_curr != pt_next)
-      {
-         /*------------------------------------------------------------------*
-          * Remove the node from this list.
-          *------------------------------------------------------------------*/
-         pt_prev->pt_next = pt_next;
-         pt_next->pt_prev = pt_prev;
-
-         /*------------------------------------------------------------------*
-          * Were we at the start or end of the list?
-          *------------------------------------------------------------------*/
-         if( pt_curr == pt_cont->pt_head)
-            pt_cont->pt_head = pt_next;
-         else if( pt_curr == pt_cont->pt_tail)
-            pt_cont->pt_tail = pt_prev;
-
-      }
-      else /*Last node*/
-      {
-         pt_cont->pt_head = NULL;
-         pt_cont->pt_tail = NULL;
-
-      }
-
-      /*---------------------------------------------------------------------*
-       * Keep track of our memory usage.
-       *---------------------------------------------------------------------*/
-      pt_cont->s_numLinks--;
-      pt_cont->s_contSizeBytes -= pt_curr->s_linkSizeBytes;
-
-      /*---------------------------------------------------------------------*
-       * Keep track of the total amount of memory being consumed...
-       *---------------------------------------------------------------------*/
-      gi_dynListMemUsage -= pt_curr->s_linkSizeBytes;
-
-      /*---------------------------------------------------------------------*
-       * Delete the 'element' from memory.
-       *---------------------------------------------------------------------*/
-      arb_free( (void **)&pt_curr->pv_element);
-      //free( pt_curr->pv_element);
-
-      /*---------------------------------------------------------------------*
-       * Clear the old memory region.
-       *---------------------------------------------------------------------*/
-      memset( pt_curr->pv_element, 0, pt_curr->s_elementSizeBytes);
-
-      /*---------------------------------------------------------------------*
-       * Delete this 'link' from memory.
+       * Delete the 'element' (and the 'link' at its start) from memory.
        *---------------------------------------------------------------------*/
+      pt_curr = (t_listLink *)t_linkHndl;
       arb_free( (void **)&pt_curr);
-      //free( (void *)pt_curr);
 
-      /*---------------------------------------------------------------------*
-       * Clear the old memory region.
-       *---------------------------------------------------------------------*/
-      memset( pt_curr, 0, sizeof( t_listLink));
-
-   }/*End if( pt_cont->s_checkSum == LINKEDLIST_CHECKSUM)*/
-   else
-   {
-      HAL_END_CRITICAL();//Enable interrupts
-      return LINKEDLIST_INVALID_CONT;
-   }
+   }/*End if( t_err == LINKEDLIST_PASSED)*/
 
    HAL_END_CRITICAL();//Enable interrupts
 
-   return LINKEDLIST_PASSED;
+   return t_err;
 
 }/*End utl_destroyLink*/
 
@@ -432,8 +326,8 @@ t_linkedListError utl_removeLink( t_CONTHNDL t_contHndl,
 {
    t_listContainer *pt_cont;
    t_listLink *pt_curr;
-   static t_listLink *pt_prev = NULL;
-   static t_listLink *pt_next = NULL;
+   t_listLink *pt_prev;
+   t_listLink *pt_next;
 
    /*------------------------------------------------------------------------*
     * Since we are about to act on global variables, protect this region
@@ -460,11 +354,6 @@ t_linkedListError utl_removeLink( t_CONTHNDL t_contHndl,
          return LINKEDLIST_INVALID_LINK;
       }
 
-      /*---------------------------------------------------------------------*
-       * Make sure the link is no longer mapped to this particular container.
-       *---------------------------------------------------------------------*/
-      pt_curr->s_contAddr = LINKEDLIST_LINK_UNMAPPED;
-
       pt_prev = pt_curr->pt_prev;
       pt_next = pt_curr->pt_next;
 
@@ -506,7 +395,6 @@ t_linkedListError utl_removeLink( t_CONTHNDL t_contHndl,
        * Keep track of the size of the container...
        *---------------------------------------------------------------------*/
       pt_cont->s_numLinks--;
-      pt_cont->s_contSizeBytes -= pt_curr->s_linkSizeBytes;
 
    }/*End if( pt_cont->s_checkSum == LINKEDLIST_CHECKSUM)*/
    else
@@ -515,6 +403,8 @@ t_linkedListError utl_removeLink( t_CONTHNDL t_contHndl,
       return LINKEDLIST_INVALID_CONT;
    }
 
+   HAL_END_CRITICAL();//Enable interrupts
+
    return LINKEDLIST_PASSED;
 
 }/*End utl_removeLink*/
@@ -22,7 +22,7 @@
  * Description : This file provides various optimized fixed-point and
  *               float-point vector/matrix operations.
  *
- * Last Update : September 26, 2012
+ * Last Update : Oct 18, 2013
  *---------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------*
@@ -31,73 +31,40 @@
 #include <string.h>
 #include <math.h>
 #include "utl_math.h"
+#include "utl_mathTables.h"
 
 /*---------------------------------------------------------------------------*
  * Private defines
  *---------------------------------------------------------------------------*/
-#define UTL_MATH_MAX_MAT_COL_SZ          (18)
-#define UTL_MATH_MAX_MAT_ROW_SZ          (9)
-#define UTL_MATH_LOG10_SHFT              (10)
-#define UTL_MATH_ALOG10_SHFT             (10)
-#define UTL_MATH_SINCOS_SHFT             (12)
-#define UTL_MATH_ATAN2_SHFT              (11)
+#define UTL_MATH_MAX_MAT_SZ              (9)
 #define UTL_MATH_SQRT_SHFT               (11)
-#define UTL_MATH_LOG10_TBL_SZ            (17)
-#define UTL_MATH_ALOG10_TBL_SZ           (11)
-#define UTL_MATH_SINCOS_TBL_SZ           (16)
-#define UTL_MATH_ATAN2_TBL_SZ            (18)
 #define UTL_MATH_SQRT_TBL_SZ             (14)
 #define UTL_MATH_ONEOVER_SQRT_OF_TWO     (23170)
 #define UTL_MATH_SQRT_LKUP_TBL_MIN_INPUT (8192)
 #define UTL_MATH_SQRT_LKUP_TBL_MAX_INPUT (34816)
 #define UTL_MATH_ONEOVER_LOG10OF2_Q13    (27213) /* round((2^13/log10(2)))*/
 #define UTL_MATH_LOG10OF2_Q15            (9864)  /* round((2^15*log10(2)))*/
-#define POWER_METHOD_MAX_ERROR           (.0001f)
+#define UTL_MATH_JACOBI_MAX_SWEEPS       (10)
+#define UTL_MATH_JACOBI_EPS              (1.0e-7f)
 
 /*---------------------------------------------------------------------------*
  * Private function prototypes
  *---------------------------------------------------------------------------*/
+static void utl_matMultKernelF( float *pf_a,
+                               int32_t i_aStep,
+                               int32_t i_aRowStep,
+                               float *pf_b,
+                               int32_t i_bStep,
+                               int32_t i_rows,
+                               int32_t i_inner,
+                               int32_t i_col,
+                               float *pf_res,
+                               bool b_upper);
 
 /*---------------------------------------------------------------------------*
  * Private variables
  *---------------------------------------------------------------------------*/
 
-static int16_t gas_log10Tbl[UTL_MATH_LOG10_TBL_SZ] =
-{
-   -9864, -9001, -8188, -7418, -6688, -5994, -5332, -4700, -4094, -3513,
-   -2955, -2418, -1900, -1401, -918, -452, 0
-};
-
-static uint16_t gas_alog10Tbl[UTL_MATH_ALOG10_TBL_SZ] =
-{
-   16384, 17606, 18919, 20331, 21848, 23478, 25229, 27112, 29134, 31308,
-   33644
-};
-
-/*---------------------------------------------------------------------------*
- * Table size                     = 16
- * Input step size                = 4096 (4096 / 65536) = 0.0625 radians
- * Table input range              = 0 to 65536 (0 to 2PI radians)
- * Table output range             = 1 to 1
- *---------------------------------------------------------------------------*/
-static int16_t gas_cosTbl[UTL_MATH_SINCOS_TBL_SZ+1] =
-{
-   32767, 30273, 23170, 12539, 0, -12539, -23170, -30273, -32768, -30273,
-  -23170, -12539, 0, 12539, 23170, 30273, 32767
-};
-
-/*---------------------------------------------------------------------------*
- * Table size                     = 18
- * Input step size                = 2048 (2048 / 32768) = 0.0625
- * Table input range              = 0 to 32767 (0 to 1)
- * Table output range             = 0 to 46.73570459 degrees
- *---------------------------------------------------------------------------*/
-static uint16_t gas_atan2Tbl[UTL_MATH_ATAN2_TBL_SZ] =
-{
-   0, 651, 1297, 1933, 2555, 3159, 3742, 4301, 4836, 5344, 5826, 6282, 6712,
-   7117, 7497, 7855, 8192, 8508
-};
-
 /*---------------------------------------------------------------------------*
  * Table size                     = 14
  * Input step size                = 2048 (2048 / 32768) = 0.0625
@@ -135,6 +102,207 @@ static uint16_t gas_sqrtDownNorm[UTL_MATH_SQRT_TBL_SZ] =
    23170, 32767
 };
 
+/*---------------------------------------------------------------------------*
+ * Private inline function definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_tblRead
+ *
+ * Description:
+ *    Reads entry 's_index' of one of the PROGMEM tables in utl_mathTables.h,
+ *    'b_signed' = true for the int16_t tables.
+ *---------------------------------------------------------------------------*/
+static inline int32_t __attribute__((always_inline)) \
+utl_tblRead( const void *pv_tbl,
+             uint16_t s_index,
+             bool b_signed)
+{
+   uint16_t s_entry = pgm_read_word( (const uint16_t *)pv_tbl + s_index);
+
+   if( b_signed == true)
+      return (int32_t)(int16_t)s_entry;
+
+   return (int32_t)s_entry;
+
+}/*End utl_tblRead*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_tblInterp
+ *
+ * Description:
+ *    Interpolates a PROGMEM table between entry 's_index' and the ones
+ *    following it, where 's_frac' is the distance past 's_index' in units
+ *    of 2^-c_step entries. The order of the interpolation is chosen when the
+ *    tables are generated (UTL_MATH_INTERP_ORDER).
+ *---------------------------------------------------------------------------*/
+static inline int32_t __attribute__((always_inline)) \
+utl_tblInterp( const void *pv_tbl,
+               uint16_t s_index,
+               uint16_t s_frac,
+               int8_t c_step,
+               bool b_signed)
+{
+#if (UTL_MATH_INTERP_ORDER == 2)
+   int16_t s_y;
+
+   /*------------------------------------------------------------------------*
+    * The entries are handed over as int16_t, an unsigned table wraps and
+    * is unwrapped again on the way out.
+    *------------------------------------------------------------------------*/
+   s_y = utl_quadInterp16_16( (int16_t)s_frac,
+                              0,
+                              (int16_t)(1 << c_step),
+                              c_step,
+                              (int16_t)utl_tblRead( pv_tbl, s_index, b_signed),
+                              (int16_t)utl_tblRead( pv_tbl,
+                                                    s_index + 1,
+                                                    b_signed),
+                              (int16_t)utl_tblRead( pv_tbl,
+                                                    s_index + 2,
+                                                    b_signed));
+
+   if( b_signed == true)
+      return (int32_t)s_y;
+
+   return (int32_t)(uint16_t)s_y;
+#else
+   return utl_linInterp32_32( (int32_t)s_frac,
+                              0,
+                              c_step,
+                              utl_tblRead( pv_tbl, s_index, b_signed),
+                              utl_tblRead( pv_tbl, s_index + 1, b_signed));
+#endif
+
+}/*End utl_tblInterp*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_cosLookup
+ *
+ * Description:
+ *    Interpolates gas_cosTbl from entry 's_index', where 's_frac' is the
+ *    Q0.16 phase past entry 's_index'. Shared by the scalar and array
+ *    versions of the sin and cos functions so that a whole array is
+ *    evaluated without a call per element.
+ *---------------------------------------------------------------------------*/
+static inline int16_t __attribute__((always_inline)) \
+utl_cosLookup( uint16_t s_index,
+               uint16_t s_frac)
+{
+   return (int16_t)utl_tblInterp( gas_cosTbl,
+                                  s_index,
+                                  s_frac,
+                                  UTL_MATH_SINCOS_SHFT,
+                                  true);
+
+}/*End utl_cosLookup*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_sincosLookup
+ *
+ * Description:
+ *    Returns both the sin and cos of 's_phase' from a single index and
+ *    fraction calculation. Sin is cos rotated back 90 degrees, which is a
+ *    whole number of table steps, so it shares the fraction and only its
+ *    index changes.
+ *---------------------------------------------------------------------------*/
+static inline void __attribute__((always_inline)) \
+utl_sincosLookup( uint16_t s_phase,
+                  int16_t *ps_sin,
+                  int16_t *ps_cos)
+{
+   uint16_t s_index;
+   uint16_t s_frac;
+
+   s_index = s_phase >> UTL_MATH_SINCOS_SHFT;
+   s_frac  = s_phase & ((1 << UTL_MATH_SINCOS_SHFT) - 1);
+
+   *ps_cos = utl_cosLookup( s_index, s_frac);
+   *ps_sin = utl_cosLookup( (s_index - (UTL_MATH_SINCOS_PERIOD >> 2)) &
+                            (UTL_MATH_SINCOS_PERIOD - 1), s_frac);
+
+}/*End utl_sincosLookup*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_atan2Lookup
+ *
+ * Description:
+ *    The body of utl_atan2_16, shared with utl_vAtan2_16.
+ *---------------------------------------------------------------------------*/
+static inline int16_t __attribute__((always_inline)) \
+utl_atan2Lookup( int16_t s_y,
+                 int16_t s_x)
+{
+   uint16_t s_div;
+   uint16_t s_num;
+   uint16_t s_den;
+   int32_t i_index;
+   int16_t s_angle;
+   uint16_t s_absx;
+   uint16_t s_absy;
+
+   s_absx = (uint16_t)utl_abs32_32( (int32_t)s_x);
+   s_absy = (uint16_t)utl_abs32_32( (int32_t)s_y);
+
+   /*------------------------------------------------------------------------*
+    * Manipulate x and y in order to take obtain a value from a lookup table
+    * encompassing the first 45 degrees of quadrant 1.
+    *------------------------------------------------------------------------*/
+   if( s_absx >= s_absy)
+   {
+      s_num = s_absy;
+      s_den = s_absx;
+   }
+   else
+   {
+      s_num = s_absx;
+      s_den = s_absy;
+   }
+
+   s_div = (uint16_t)(((uint32_t)s_num*(uint32_t)32767) /
+           ((uint32_t)s_den + 1));
+   i_index = s_div >> UTL_MATH_ATAN2_SHFT;
+
+   s_angle = (int16_t)utl_tblInterp( gas_atan2Tbl,
+                                     (uint16_t)i_index,
+                                     s_div & ((1 << UTL_MATH_ATAN2_SHFT) - 1),
+                                     UTL_MATH_ATAN2_SHFT,
+                                     false);
+
+   /*------------------------------------------------------------------------*
+    * If x and y were swapped in order to be able to use the 45 degree
+    * lookup table, the 'true' angle lies above 45 degrees and a rotation is
+    * needed.
+    *------------------------------------------------------------------------*/
+   if( s_absx < s_absy)
+      s_angle = (UTL_MATH_FXDPNT_PI >> 1) - s_angle;
+
+   /*------------------------------------------------------------------------*
+    * Rotate the angle so that it falls back into its original quadrant
+    *------------------------------------------------------------------------*/
+   if( (s_x < 0) && ( s_y >= 0)) /*The angle should be in quadrant 2*/
+   {
+      s_angle = UTL_MATH_FXDPNT_PI - s_angle;
+   }
+   else if( (s_x <= 0) && (s_y <=0))  /*The angle should be in quadrant 3*/
+   {
+      s_angle = s_angle + UTL_MATH_FXDPNT_NEGATIVE_PI;
+
+   }
+   else if( (s_x >= 0) && (s_y <= 0)) /*The angle should be in quadrant 4*/
+   {
+      s_angle = -s_angle;
+   }
+
+   return s_angle;
+
+}/*End utl_atan2Lookup*/
+
 /*---------------------------------------------------------------------------*
  *
  * Function:
@@ -212,19 +380,14 @@ int32_t utl_log10_32( uint32_t i_y)
     *------------------------------------------------------------------------*/
    s_zIndex = (s_z - 16384) >> UTL_MATH_LOG10_SHFT;
 
-   if( s_zIndex < (UTL_MATH_LOG10_TBL_SZ - 1))
-   {
-      s_temp = utl_linInterp32_32( s_z,
-                                   (int32_t)(16384 + (s_zIndex*(1 <<
-                                   UTL_MATH_LOG10_SHFT))),
-                                   UTL_MATH_LOG10_SHFT,
-                                   (int32_t)gas_log10Tbl[s_zIndex],
-                                   (int32_t)gas_log10Tbl[s_zIndex + 1]);
-
-      i_log10 = (int32_t)9864*(int32_t)s_M + s_temp;
-   }
-   else
-      i_log10 = (int32_t)9864*(int32_t)s_M + gas_log10Tbl[s_zIndex];
+   s_temp = (int16_t)utl_tblInterp( gas_log10Tbl,
+                                    (uint16_t)s_zIndex,
+                                    (s_z - 16384) & ((1 <<
+                                    UTL_MATH_LOG10_SHFT) - 1),
+                                    UTL_MATH_LOG10_SHFT,
+                                    true);
+
+   i_log10 = (int32_t)9864*(int32_t)s_M + s_temp;
 
    return i_log10;
 
@@ -334,26 +497,12 @@ uint32_t utl_alog10_32( int32_t i_log10)
     *------------------------------------------------------------------------*/
    s_zIndex = (int16_t)((i_zLog10 + 9864) >> UTL_MATH_ALOG10_SHFT);
 
-   if( s_zIndex < (UTL_MATH_ALOG10_TBL_SZ - 1))
-   {
-
-      s_z = utl_linInterp32_32( i_zLog10,
-                                (int32_t)(-9864 + (s_zIndex*(1 <<
-                                UTL_MATH_ALOG10_SHFT))),
-                                UTL_MATH_ALOG10_SHFT,
-                                (int32_t)gas_alog10Tbl[s_zIndex],
-                                (int32_t)gas_alog10Tbl[s_zIndex + 1]);
-
-   }
-   else
-   {
-      s_z = utl_linInterp32_32( i_zLog10,
-                                (int32_t)(-9864 + ((s_zIndex - 1)*(1 <<
-                                UTL_MATH_ALOG10_SHFT))),
-                                UTL_MATH_ALOG10_SHFT,
-                                (int32_t)gas_alog10Tbl[s_zIndex - 1],
-                                (int32_t)gas_alog10Tbl[s_zIndex]);
-   }
+   s_z = (uint16_t)utl_tblInterp( gas_alog10Tbl,
+                                  (uint16_t)s_zIndex,
+                                  (uint16_t)(i_zLog10 + 9864) & ((1 <<
+                                  UTL_MATH_ALOG10_SHFT) - 1),
+                                  UTL_MATH_ALOG10_SHFT,
+                                  false);
 
    while( s_M > 0)
    {
@@ -443,17 +592,9 @@ uint32_t utl_alog2_32( int32_t i_log2)
  *---------------------------------------------------------------------------*/
 int16_t utl_cos16_16( uint16_t s_phase)
 {
-   uint8_t c_index = 0;
-   int16_t s_cos   = 0;
 
-   c_index = (uint8_t)(s_phase >> UTL_MATH_SINCOS_SHFT);
-
-   s_cos = utl_linInterp32_32( (int32_t)s_phase,
-                               ((int32_t)c_index)*(1 << UTL_MATH_SINCOS_SHFT),
-                               (int8_t)UTL_MATH_SINCOS_SHFT,
-                               (int32_t)gas_cosTbl[c_index],
-                               (int32_t)gas_cosTbl[c_index+1]);
-   return s_cos;
+   return utl_cosLookup( (uint8_t)(s_phase >> UTL_MATH_SINCOS_SHFT),
+                         s_phase & ((1 << UTL_MATH_SINCOS_SHFT) - 1));
 
 }/*End utl_cos16_16*/
 
@@ -475,19 +616,138 @@ int16_t utl_cos16_16( uint16_t s_phase)
  *---------------------------------------------------------------------------*/
 int16_t utl_sin16_16( uint16_t s_phase)
 {
-   int32_t i_temp = 0;
 
    /*------------------------------------------------------------------------*
-    * Rotate back 90 degrees
+    * Rotate back 90 degrees, the 16-bit phase wraps at 2*pi.
     *------------------------------------------------------------------------*/
-   i_temp = (int32_t)s_phase - (UTL_MATH_FXDPNT_TWO_PI_WRAP >> 2);
-   if( i_temp < 0)
-      i_temp = i_temp + UTL_MATH_FXDPNT_TWO_PI_WRAP;
+   s_phase = s_phase - (uint16_t)(UTL_MATH_FXDPNT_TWO_PI_WRAP >> 2);
 
-   return utl_cos16_16( (uint16_t)i_temp);
+   return utl_cos16_16( s_phase);
 
 }/*End utl_sin16_16*/
 
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_sincos16_16
+ *
+ * Description:
+ *    Returns both the sin and cos of a Q0.16 phase. Cheaper than calling
+ *    utl_sin16_16 and utl_cos16_16, the table index and fraction are only
+ *    computed once. The results are identical to the separate functions.
+ *
+ * Parameters:
+ *    s_phase = Q0.16 number where 2*pi = 65,535
+ *
+ * Return:
+ *    ps_sin = Q1.15 sin of s_phase
+ *    ps_cos = Q1.15 cos of s_phase
+ *---------------------------------------------------------------------------*/
+void utl_sincos16_16( uint16_t s_phase,
+                      int16_t *ps_sin,
+                      int16_t *ps_cos)
+{
+
+   utl_sincosLookup( s_phase, ps_sin, ps_cos);
+
+}/*End utl_sincos16_16*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_vCos16_16
+ *
+ * Description:
+ *    Array version of utl_cos16_16, ps_cos[n] = cos(ps_phase[n]).
+ *
+ * Parameters:
+ *    ps_phase = s_length Q0.16 phases where 2*pi = 65,535
+ *    s_length = Number of elements in each array
+ *
+ * Return:
+ *    ps_cos = s_length Q1.15 results
+ *---------------------------------------------------------------------------*/
+void utl_vCos16_16( uint16_t *ps_phase,
+                    int16_t *ps_cos,
+                    int16_t s_length)
+{
+   int16_t s_index;
+   uint16_t s_phase;
+
+   for( s_index = 0; s_index < s_length; s_index++)
+   {
+      s_phase = ps_phase[s_index];
+      ps_cos[s_index] = utl_cosLookup( (uint8_t)(s_phase >>
+                                       UTL_MATH_SINCOS_SHFT),
+                                       s_phase & ((1 <<
+                                       UTL_MATH_SINCOS_SHFT) - 1));
+   }
+
+}/*End utl_vCos16_16*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_vSin16_16
+ *
+ * Description:
+ *    Array version of utl_sin16_16, ps_sin[n] = sin(ps_phase[n]).
+ *
+ * Parameters:
+ *    ps_phase = s_length Q0.16 phases where 2*pi = 65,535
+ *    s_length = Number of elements in each array
+ *
+ * Return:
+ *    ps_sin = s_length Q1.15 results
+ *---------------------------------------------------------------------------*/
+void utl_vSin16_16( uint16_t *ps_phase,
+                    int16_t *ps_sin,
+                    int16_t s_length)
+{
+   int16_t s_index;
+   uint16_t s_phase;
+
+   for( s_index = 0; s_index < s_length; s_index++)
+   {
+      s_phase = ps_phase[s_index] - (uint16_t)(UTL_MATH_FXDPNT_TWO_PI_WRAP
+      >> 2);
+      ps_sin[s_index] = utl_cosLookup( (uint8_t)(s_phase >>
+                                       UTL_MATH_SINCOS_SHFT),
+                                       s_phase & ((1 <<
+                                       UTL_MATH_SINCOS_SHFT) - 1));
+   }
+
+}/*End utl_vSin16_16*/
+
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_vSincos16_16
+ *
+ * Description:
+ *    Array version of utl_sincos16_16. Used where a set of angles is turned
+ *    into a rotation matrix, e.g. the roll, pitch and yaw of an attitude.
+ *
+ * Parameters:
+ *    ps_phase = s_length Q0.16 phases where 2*pi = 65,535
+ *    s_length = Number of elements in each array
+ *
+ * Return:
+ *    ps_sin = s_length Q1.15 sin results
+ *    ps_cos = s_length Q1.15 cos results
+ *---------------------------------------------------------------------------*/
+void utl_vSincos16_16( uint16_t *ps_phase,
+                       int16_t *ps_sin,
+                       int16_t *ps_cos,
+                       int16_t s_length)
+{
+   int16_t s_index;
+
+   for( s_index = 0; s_index < s_length; s_index++)
+   {
+      utl_sincosLookup( ps_phase[s_index],
+                        &ps_sin[s_index],
+                        &ps_cos[s_index]);
+   }
+
+}/*End utl_vSincos16_16*/
+
 /*---------------------------------------------------------------------------*
  * Function:
  *    utl_sqrt32_32
@@ -628,81 +888,46 @@ uint32_t utl_sqrt32_32( uint32_t i_input, int8_t c_n)
 int16_t utl_atan2_16( int16_t s_y, int16_t s_x)
 {
 
-   uint16_t s_div;
-   int32_t i_index;
-   int16_t s_angle;
-   uint16_t s_absx;
-   uint16_t s_absy;
-
-   s_absx = (uint16_t)utl_abs32_32( (int32_t)s_x);
-   s_absy = (uint16_t)utl_abs32_32( (int32_t)s_y);
-
-   /*-------------------------------------------------------------------------*
-    * Manipulate x and y in order to take obtain a value from a lookup table
-    * encompassing the first 45 degrees of quadrant 1.
-    *-------------------------------------------------------------------------*/
-   if( s_absx >= s_absy)
-   {
-      s_div = (uint16_t)(((uint32_t)s_absy*(uint32_t)32767) / (s_absx + 1));
-      i_index = s_div >> UTL_MATH_ATAN2_SHFT;
-
-      s_angle = utl_linInterp32_32( (int32_t)s_div,
-                                    (int32_t)(((i_index)*(1 <<
-                                    UTL_MATH_ATAN2_SHFT))),
-                                    UTL_MATH_ATAN2_SHFT,
-                                    (int32_t)gas_atan2Tbl[i_index],
-                                    (int32_t)gas_atan2Tbl[i_index+1]);
-
-   }
-   else
-   {
-      s_div = (uint16_t)(((uint32_t)s_absx*(uint32_t)32767) / (s_absy + 1));
-      i_index = s_div >> UTL_MATH_ATAN2_SHFT;
-
-      s_angle = utl_linInterp32_32( (int32_t)s_div,
-                                    (int32_t)(((i_index)*(1 <<
-                                    UTL_MATH_ATAN2_SHFT))),
-                                    UTL_MATH_ATAN2_SHFT,
-                                    (int32_t)gas_atan2Tbl[i_index],
-                                    (int32_t)gas_atan2Tbl[i_index+1]);
-
-     /*----------------------------------------------------------------------*
-      * X and y were swapped in order to be able to use the 45 degree lookup
-      * table. The 'true' angle lies above 45 degrees, therefore a rotation is
-      * needed.
-      *----------------------------------------------------------------------*/
-      s_angle = (UTL_MATH_FXDPNT_PI >> 1) - s_angle;
+   return utl_atan2Lookup( s_y, s_x);
 
-   }
+}/*End utl_atan2_16*/
 
-   /*------------------------------------------------------------------------*
-    * Rotate the angle so that it falls back into its original quadrant
-    *------------------------------------------------------------------------*/
-   if( (s_x < 0) && ( s_y >= 0)) /*The angle should be in quadrant 2*/
-   {
-      s_angle = UTL_MATH_FXDPNT_PI - s_angle;
-   }
-   else if( (s_x <= 0) && (s_y <=0))  /*The angle should be in quadrant 3*/
-   {
-      s_angle = s_angle + UTL_MATH_FXDPNT_NEGATIVE_PI;
+/*---------------------------------------------------------------------------*
+ * Function:
+ *    utl_vAtan2_16
+ *
+ * Description:
+ *    Array version of utl_atan2_16, ps_angle[n] = atan2(ps_y[n], ps_x[n]).
+ *
+ * Parameters:
+ *    ps_y     = s_length Q1.15 y values
+ *    ps_x     = s_length Q1.15 x values
+ *    s_length = Number of elements in each array
+ *
+ * Return:
+ *    ps_angle = s_length Q1.15 angles where +/-pi = 32767/-32768
+ *---------------------------------------------------------------------------*/
+void utl_vAtan2_16( int16_t *ps_y,
+                    int16_t *ps_x,
+                    int16_t *ps_angle,
+                    int16_t s_length)
+{
+   int16_t s_index;
 
-   }
-   else if( (s_x >= 0) && (s_y <= 0)) /*The angle should be in quadrant 4*/
+   for( s_index = 0; s_index < s_length; s_index++)
    {
-      s_angle = -s_angle;
+      ps_angle[s_index] = utl_atan2Lookup( ps_y[s_index], ps_x[s_index]);
    }
 
-   return s_angle;
-
-}/*End utl_atan2_16*/
+}/*End utl_vAtan2_16*/
 
 /*-------------------------------------------------------------------------*
  *
  * Function:
- *	   utl_mult16x16_16
+ *	   utl_div16x16_16
  *
  * Description:
- *	   Signed multiply of two Qm.n 16-bit numbers returning a Qm.n 16-bit
+ *	   Signed divide of two Qm.n 16-bit numbers returning a Qm.n 16-bit
  *    result. Where m is the number of integer bits and n represents the
  *    number of fractional bits.
  *
@@ -720,251 +945,21 @@ int16_t utl_atan2_16( int16_t s_y, int16_t s_x)
  * References:
  *    http://en.wikipedia.org/wiki/Q_(number_format)
  *------------------------------------------------------------------------*/
-int16_t utl_mult16x16_16( int16_t s_x1,
-                          int16_t s_x2,
-                          int8_t c_n)
+int16_t utl_div16x16_16( int16_t s_x1,
+                         int16_t s_x2,
+                         int8_t c_n)
 {
-   t_typePunn t_tWord;
-   int8_t c_sign = 1;
 
-   /*---------------------------------------------------------------------*
-    * Check for negative saturation...
-    *---------------------------------------------------------------------*/
 #if UTL_MATH_SAT_CHECK
-   if( (s_x1 == -(int16_t)1<<c_n) && (s_x2 == -(int16_t)1<<c_n))
+   if( s_x1 == s_x2)
       return (((int16_t)1 << c_n) - 1); /*Return max positive*/
+   else if( (s_x1 == -32768) && (s_x2 == 32767))
+      return ((int16_t)1 << c_n);
 #endif
 
-   t_tWord.i_word32 = (int32_t)s_x1*(int32_t)s_x2;
+   return (int16_t)((((int32_t)s_x1*((int32_t)1<<c_n))) / s_x2);
 
-   if( t_tWord.i_word32 < 0)
-   {
-      t_tWord.i_word32 = -t_tWord.i_word32;
-       c_sign = -1;
-   }
-
-   /*---------------------------------------------------------------------*
-    * Perform rounding...
-    *---------------------------------------------------------------------*/
-   t_tWord.i_word32 += ((int32_t)1 << (c_n - 1));
-
-   /*---------------------------------------------------------------------*
-    * Normally a conversion from one Qm.n number to another requires a
-    * shift right of 'x' number of bits- which can be a costly operation
-    * in terms of processor cycles. This impact can be minimized by
-    * analyzing the product for a pivot point that gives the least number
-    * of shifts. Bits are shifted up or down from the surrounding words
-    * depending on the move that gives the least number of operations. The
-    * pivot point is then used as the starting location for the word that
-    * gets returned. This can be easily understood with a simply example of
-    * the mutliplication of two Q0.15 numbers;
-    *    x1 = 0x2000, x2 = 0x2000
-    *    y = (x1*x2) >> 15
-    *      = (0x2000*0x2000) >> 15
-    *      = (0x0400 0000) >> 15
-    *      = 0x0800
-    * This operation just moves the upper 15 bits of the 32-bit word into
-    * the lower 16-bits and retains just 1-bit of the original lower
-    * bits. This is the same thing as shifting up by 1-bit and returning the
-    * upper 16-bits of the 32-bit word;
-    *    y = UPPER[(0x2000*0x2000) << 1]
-    *      = UPPER[(0x0400 0000) << 1]
-    *      = UPPER[0x0800 0000]
-    *      = 0x0800
-    * In this example the pivot point is the second 16-bit word.
-    *---------------------------------------------------------------------*/
-   if( (c_n > 8) && (c_n <= 16))/*Pivot-point = second 16-bit word...*/
-   {
-      /*------------------------------------------------------------------*
-       * The least number of shifts occur if the first 16-bit word is
-       * shifted up into the second 16-bit word...
-       *------------------------------------------------------------------*/
-      t_tWord.i_word32 = t_tWord.i_word32 << (16 - c_n);
-
-      /*------------------------------------------------------------------*
-       * Use ptr's in order to return a 16-bit word starting from the
-       * location of the second 16-bit word.
-       *------------------------------------------------------------------*/
-      if( c_sign == -1)
-         return -t_tWord.as_word16[1];
-       else
-          return t_tWord.as_word16[1];
-   }
-
-   t_tWord.i_word32 = t_tWord.i_word32 >> c_n;
-
-   /*---------------------------------------------------------------------*
-    * The least number of shifts occur if the 32-bit word is shifted down
-    * and a 16-bit word is returned starting from the location of the first
-    * 16-bit word.
-    *---------------------------------------------------------------------*/
-   if( c_sign == -1)
-      return -(int16_t)t_tWord.i_word32; /*Pivot-point = first 16-bit word...*/
-   else
-      return (int16_t)t_tWord.i_word32;
-
-}/*End utl_mult16x16_16*/
-
-/*-------------------------------------------------------------------------*
- *
- * Function:
- *	   utl_mult16x16_32
- *
- * Description:
- *	   Signed multiply of two Qm.n 16-bit numbers returning a Qm.n 32-bit
- *    result. Where m is the number of integer bits and n represents the
- *    number of fractional bits.
- *
- * Parameters:
- *    s_x1 - Qm.n 16-bit number where m is the number of integer bits and n
- *           is the number of fractional bits
- *    s_x2 - Qm.n 16-bit number where m is the number of integer bits and n
- *           is the number of fractional bits
- *    c_n  - The number of fractional bits of the return value.
- *
- * Return:
- *    i_out - Qm.n 32-bit number where m is the number of integer bits and n
- *            is the number of fractional bits.
- *
- * References:
- *    http://en.wikipedia.org/wiki/Q_(number_format)
- *------------------------------------------------------------------------*/
-int32_t utl_mult16x16_32( int16_t s_x1,
-                          int16_t s_x2,
-                          int8_t c_n)
-{
-   int32_t i_y = 0;
-
-   i_y = (int32_t)s_x1*(int32_t)s_x2;
-
-   if( i_y < 0)
-     i_y = -((-i_y + ((int32_t)1 << (c_n - 1))) >> c_n);
-   else
-      i_y = (i_y + ((int32_t)1 << (c_n - 1))) >> c_n;
-
-   return i_y;
-
-}/*End utl_mult16x16_32*/
-
-/*-------------------------------------------------------------------------*
- *
- * Function:
- *	   utl_mult32x32_32
- *
- * Description:
- *	   Signed multiply of two Qm.n 32-bit numbers returning a Qm.n 32-bit
- *    result. Where m is the number of integer bits and n represents the
- *    number of fractional bits.
- *
- * Parameters:
- *    i_x1 - Qm.n 32-bit number where m is the number of integer bits and n
- *           is the number of fractional bits
- *    i_x2 - Qm.n 32-bit number where m is the number of integer bits and n
- *           is the number of fractional bits
- *    c_n  - The number of fractional bits of the return value.
- *
- * Return:
- *    i_out - Qm.n 32-bit number where m is the number of integer bits and n
- *            is the number of fractional bits.
- *
- * References:
- *    http://en.wikipedia.org/wiki/Q_(number_format)
- *------------------------------------------------------------------------*/
-int32_t utl_mult32x32_32( int32_t i_x1,
-                          int32_t i_x2,
-                          int8_t c_n)
-{
-   int64_t l_y;
-
-   l_y = (int64_t)i_x1*(int64_t)i_x2;
-   if( l_y < 0)
-     l_y = -((-l_y + ((int64_t)1 << (c_n - 1))) >> c_n);
-   else
-      l_y = (l_y + ((int64_t)1 << (c_n - 1))) >> c_n;
-
-   return (int32_t)l_y;
-
-}/*End utl_mult32x32_32*/
-
-/*-------------------------------------------------------------------------*
- *
- * Function:
- *	   utl_div16x16_16
- *
- * Description:
- *	   Signed divide of two Qm.n 16-bit numbers returning a Qm.n 16-bit
- *    result. Where m is the number of integer bits and n represents the
- *    number of fractional bits.
- *
- * Parameters:
- *    s_x1 - Qm.n 16-bit number where m is the number of integer bits and n
- *           is the number of fractional bits
- *    s_x2 - Qm.n 16-bit number where m is the number of integer bits and n
- *           is the number of fractional bits
- *    c_n  - The number of fractional bits of the return value.
- *
- * Return:
- *    s_out - Qm.n 16-bit number where m is the number of integer bits and n
- *            is the number of fractional bits.
- *
- * References:
- *    http://en.wikipedia.org/wiki/Q_(number_format)
- *------------------------------------------------------------------------*/
-int16_t utl_div16x16_16( int16_t s_x1,
-                         int16_t s_x2,
-                         int8_t c_n)
-{
-
-#if UTL_MATH_SAT_CHECK
-   if( s_x1 == s_x2)
-      return (((int16_t)1 << c_n) - 1); /*Return max positive*/
-   else if( (s_x1 == -32768) && (s_x2 == 32767))
-      return ((int16_t)1 << c_n);
-#endif
-
-   return (int16_t)((((int32_t)s_x1*((int32_t)1<<c_n))) / s_x2);
-
-}/*End utl_div16x16_16*/
-
-/*------------------------------------------------------------------------*
- *
- * Function:
- *	   utl_mac16x16_32
- *
- * Description:
- *	   Signed multiply and accumulate of two Qm.n 16-bit vectors returning
- *    a Qm.n 32-bit result.
- *
- * Parameters:
- *    s_x1 - Pointer to a Qm.n 16-bit numbers where m is the number of
- *           integer bits and n is the number of fractional bits
- *    s_x2 - Pointer to a Qm.n 16-bit number where m is the number of
- *           integer bits and n is the number of fractional bits
- *    i_y - Qm.n accumulator initial value.
- *    c_o - Overflow prevention factor
- *
- * Return:
- *    i_y - Qm.n 32-bit number where m is the number of integer bits and n
- *          is the number of fractional bits
- *------------------------------------------------------------------------*/
-int32_t utl_mac16x16_32( int16_t s_x1,
-                         int16_t s_x2,
-                         int32_t i_y,
-                         int8_t c_o)
-{
-   int32_t i_tmp;
-
-   i_tmp = (int32_t)s_x1*(int32_t)s_x2;
-   if( i_tmp < 0)
-      i_tmp = -((-i_tmp) >> c_o);
-   else
-       i_tmp = i_tmp >> c_o;
-
-   i_y += i_tmp;
-
-   return i_y;
-
-}/*End utl_mac16x16_32*/
+}/*End utl_div16x16_16*/
 
 /*------------------------------------------------------------------------*
  *
@@ -997,17 +992,10 @@ int32_t utl_vMult16x16_32( int16_t *ps_x1,
                            int8_t c_n)
 {
    int16_t s_index;
-   int32_t i_tmp;
 
    for( s_index = 0; s_index < s_length; s_index++)
    {
-      i_tmp = (int32_t)ps_x1[s_index]*(int32_t)ps_x2[s_index];
-      if( i_tmp < 0)
-         i_tmp = -((-i_tmp) >> c_o);
-      else
-          i_tmp = i_tmp >> c_o;
-
-      i_y += i_tmp;
+      i_y = utl_mac16x16_32( ps_x1[s_index], ps_x2[s_index], i_y, c_o);
 
    }/*End for( s_index = 0; s_index < s_length; s_index++)*/
 
@@ -1018,7 +1006,7 @@ int32_t utl_vMult16x16_32( int16_t *ps_x1,
 
    return i_y;
 
-}/*End utl_mac16x16_32*/
+}/*End utl_vMult16x16_32*/
 
 /*------------------------------------------------------------------------*
  *
@@ -1052,38 +1040,25 @@ int16_t utl_vMult16x16_16( int16_t *ps_x1,
 {
    int16_t s_index;
    t_typePunn t_tWord;
-   int32_t i_tmp;
    int8_t c_sign = 1;
 
    t_tWord.i_word32 = i_y;
 
    for( s_index = 0; s_index < s_length; s_index++)
    {
+      t_tWord.i_word32 = utl_mac16x16_32( ps_x1[s_index],
+                                          ps_x2[s_index],
+                                          t_tWord.i_word32,
+                                          c_o);
+
       /*------------------------------------------------------------------*
-       * Check for negative saturation...
+       * Check for negative saturation, -1*-1 accumulates max positive
+       * instead of 1. The correction is 1 when both inputs are -1 and is
+       * found without a branch.
        *------------------------------------------------------------------*/
 #if UTL_MATH_SAT_CHECK
-      if( (ps_x1[s_index] == -32768) && (ps_x2[s_index] == -32768))
-         t_tWord.i_word32 += ((((int32_t)1<<30) - 1) >> c_o);
-      else
-      {
-          i_tmp = (int32_t)ps_x1[s_index]*(int32_t)ps_x2[s_index];
-         if( i_tmp < 0)
-            i_tmp = -((-i_tmp) >> c_o);
-         else
-             i_tmp = i_tmp >> c_o;
-
-         t_tWord.i_word32 += i_tmp;
-      }
-
-#else
-       i_tmp = (int32_t)ps_x1[s_index]*(int32_t)ps_x2[s_index];
-      if( i_tmp < 0)
-         i_tmp = -((-i_tmp) >> c_o);
-      else
-          i_tmp = i_tmp >> c_o;
-
-      t_tWord.i_word32 += i_tmp;
+      t_tWord.i_word32 -= (int32_t)(((uint32_t)(uint16_t)((ps_x1[s_index] ^
+      -32768) | (ps_x2[s_index] ^ -32768)) - 1) >> 31);
 #endif
    }/*End for( s_index = 0; s_index < s_length; s_index++)*/
 
@@ -1215,31 +1190,6 @@ void utl_matTrans16( int16_t *ps_mat,
 
 }/*End utl_matTrans16*/
 
-/*-------------------------------------------------------------------------*
- *
- * Function:
- *	   utl_macF
- *
- * Description:
- *	   Floating-point multiply and accumulate.
- *
- * Parameters:
- *    f_x1 - 32-bit floating-point multiplicand
- *    f_x2 - 32-bit floating-point multiplicand
- *    f_y - 32-bit floating-point accumulated result
- *
- * Return:
- *    f_y - 32-bit floating-point accumulation of f_x1*f_x2
- *------------------------------------------------------------------------*/
-float utl_macF( float f_x1,
-                float f_x2,
-                float f_y)
-{
-
-   return (f_y + (f_x1*f_x2));
-
-}/*End utl_macF*/
-
 /*-------------------------------------------------------------------------*
  *
  * Function:
@@ -1288,6 +1238,116 @@ float utl_multF( float f_x1,
 
 }/*End utl_multF*/
 
+/*---------------------------------------------------------------------------*
+ * Function utl_matMultKernelF
+ *
+ * Description: The inner loops shared by the floating point matrix multiplies.
+ *              Result element (r,c) is the sum over k of a(r,k)*b(k,c), where
+ *              a(r,k) = pf_a[r*i_aRowStep + k*i_aStep] and b(k,c) =
+ *              pf_b[k*i_bStep + c]. The strides let the same loops multiply
+ *              by a transpose without forming it.
+ *
+ *              Four result columns are produced at a time, each a(r,k) is
+ *              loaded once for all four and b is read along its rows. The
+ *              accumulators stay in registers until the block is stored.
+ *
+ * Input Parameters:
+ *
+ *              i_rows, i_inner, i_col = Result rows, length of each dot
+ *                                       product, and result columns
+ *
+ *              b_upper = true, only the elements on or above the diagonal
+ *                        are computed (square results only)
+ *
+ * Output Parameters:
+ *
+ *              pf_res = The i_rows by i_col result
+ *---------------------------------------------------------------------------*/
+static void utl_matMultKernelF( float *pf_a,
+                               int32_t i_aStep,
+                               int32_t i_aRowStep,
+                               float *pf_b,
+                               int32_t i_bStep,
+                               int32_t i_rows,
+                               int32_t i_inner,
+                               int32_t i_col,
+                               float *pf_res,
+                               bool b_upper)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   int32_t i_k = 0;
+   float *pf_aRow;
+   float *pf_aPtr;
+   float *pf_bPtr;
+   float *pf_resRow;
+   float f_a;
+   float f_sum0;
+   float f_sum1;
+   float f_sum2;
+   float f_sum3;
+
+   for( i_r = 0; i_r < i_rows; i_r++)
+   {
+      pf_aRow   = pf_a + i_r*i_aRowStep;
+      pf_resRow = pf_res + i_r*i_col;
+
+      i_c = 0;
+      if( b_upper == true)
+         i_c = i_r;
+
+      for( ; (i_c + 4) <= i_col; i_c += 4)
+      {
+         f_sum0 = 0;
+         f_sum1 = 0;
+         f_sum2 = 0;
+         f_sum3 = 0;
+         pf_aPtr = pf_aRow;
+         pf_bPtr = pf_b + i_c;
+
+         for( i_k = 0; i_k < i_inner; i_k++)
+         {
+            f_a    = *pf_aPtr;
+            f_sum0 = utl_macF( f_a, pf_bPtr[0], f_sum0);
+            f_sum1 = utl_macF( f_a, pf_bPtr[1], f_sum1);
+            f_sum2 = utl_macF( f_a, pf_bPtr[2], f_sum2);
+            f_sum3 = utl_macF( f_a, pf_bPtr[3], f_sum3);
+            pf_aPtr += i_aStep;
+            pf_bPtr += i_bStep;
+
+         }/*End for( i_k = 0; i_k < i_inner; i_k++)*/
+
+         pf_resRow[i_c + 0] = f_sum0;
+         pf_resRow[i_c + 1] = f_sum1;
+         pf_resRow[i_c + 2] = f_sum2;
+         pf_resRow[i_c + 3] = f_sum3;
+
+      }/*End for( ; (i_c + 4) <= i_col; i_c += 4)*/
+
+      /*---------------------------------------------------------------------*
+       * Columns left over after the last block of four.
+       *---------------------------------------------------------------------*/
+      for( ; i_c < i_col; i_c++)
+      {
+         f_sum0 = 0;
+         pf_aPtr = pf_aRow;
+         pf_bPtr = pf_b + i_c;
+
+         for( i_k = 0; i_k < i_inner; i_k++)
+         {
+            f_sum0 = utl_macF( *pf_aPtr, *pf_bPtr, f_sum0);
+            pf_aPtr += i_aStep;
+            pf_bPtr += i_bStep;
+         }
+
+         pf_resRow[i_c] = f_sum0;
+
+      }/*End for( ; i_c < i_col; i_c++)*/
+
+   }/*End for( i_r = 0; i_r < i_rows; i_r++)*/
+
+}/*End utl_matMultKernelF*/
+
 /*---------------------------------------------------------------------------*
  * Function utl_matMultF
  *
@@ -1321,201 +1381,673 @@ bool utl_matMultF( float *pf_mat1,
                    int32_t i_col2,
                    float *pf_res)
 {
-   int32_t i_r1 = 0;
-   int32_t i_c1 = 0;
-   int32_t i_c2 = 0;
-   float f_sum = 0.0;
 
-   if( i_col1 == i_rows2)
-   {
-      for( i_r1 = 0; i_r1 < i_rows1; i_r1++)
-      {
-         for( i_c2 = 0; i_c2 < i_col2; i_c2++)
-         {
-            f_sum = 0;
-            for( i_c1 = 0; i_c1 < i_col1; i_c1++)
-            {
-               f_sum = utl_macF( (*(pf_mat1 + i_r1*i_col1 + i_c1)),
-                                 (*(pf_mat2 + i_c1*i_col2 + i_c2)),
-                                 f_sum);
+   if( i_col1 != i_rows2)
+      return false;
 
-            }/*End for( i_c1 = 0; i_c1 < i_col1; i_c1++)*/
+   utl_matMultKernelF( pf_mat1,
+                       1,
+                       i_col1,
+                       pf_mat2,
+                       i_col2,
+                       i_rows1,
+                       i_col1,
+                       i_col2,
+                       pf_res,
+                       false);
 
-            (*(pf_res + i_r1*i_col2 + i_c2)) = f_sum;
+   return true;
 
-         }/*End for( i_c2 = 0; i_c2 < i_col2; i_c2++)*/
+}/*End utl_matMultF*/
 
-      }/*End for( i_r1 = 0; i_r1 < i_rows1; i_r1++)*/
-   }
-   else
+/*---------------------------------------------------------------------------*
+ * Function utl_matMultTransAF
+ *
+ * Description: Computes pf_mat1' * pf_mat2 in floating point without forming
+ *              the transpose of pf_mat1.
+ *
+ * Input Parameters:
+ *
+ *              pf_mat1 = A i_rows1 by i_col1 matrix
+ *
+ *              pf_mat2 = A i_rows2 by i_col2 matrix
+ *
+ * Output Parameters:
+ *
+ *              pf_res = The i_col1 by i_col2 result
+ *
+ *              b_mult = true, if i_rows1 == i_rows2.
+ *---------------------------------------------------------------------------*/
+bool utl_matMultTransAF( float *pf_mat1,
+                         int32_t i_rows1,
+                         int32_t i_col1,
+                         float *pf_mat2,
+                         int32_t i_rows2,
+                         int32_t i_col2,
+                         float *pf_res)
+{
+
+   if( i_rows1 != i_rows2)
       return false;
 
+   utl_matMultKernelF( pf_mat1,
+                       i_col1,
+                       1,
+                       pf_mat2,
+                       i_col2,
+                       i_col1,
+                       i_rows1,
+                       i_col2,
+                       pf_res,
+                       false);
+
    return true;
 
-}/*End utl_matMultF*/
+}/*End utl_matMultTransAF*/
 
 /*---------------------------------------------------------------------------*
- * Function utl_matInvF
+ * Function utl_matSyrkF
  *
- * Description: Performs a floating point matrix inversion operation using the
- *              Gauss-Jordan method.
+ * Description: Symmetric rank-k update, computes pf_mat' * pf_mat in floating
+ *              point. Only the upper triangle is computed, which is a little
+ *              over half the work of a general multiply.
  *
  * Input Parameters:
  *
- *              pf_mat = A i_numElements by i_numElements square matrix
+ *              pf_mat = A i_rows by i_col matrix
  *
- *              i_numElements = The number of rows/columns
+ *              b_fillLower = true, the lower triangle is copied from the
+ *                            upper one. Otherwise it is left untouched.
  *
  * Output Parameters:
  *
- *              pf_inv = The resulting inverted matrix
+ *              pf_res = The i_col by i_col result
+ *---------------------------------------------------------------------------*/
+void utl_matSyrkF( float *pf_mat,
+                   int32_t i_rows,
+                   int32_t i_col,
+                   float *pf_res,
+                   bool b_fillLower)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+
+   utl_matMultKernelF( pf_mat,
+                       i_col,
+                       1,
+                       pf_mat,
+                       i_col,
+                       i_col,
+                       i_rows,
+                       i_col,
+                       pf_res,
+                       true);
+
+   if( b_fillLower == true)
+   {
+      for( i_r = 1; i_r < i_col; i_r++)
+         for( i_c = 0; i_c < i_r; i_c++)
+            pf_res[i_r*i_col + i_c] = pf_res[i_c*i_col + i_r];
+   }
+
+}/*End utl_matSyrkF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matSyrF
  *
- *              b_invertible = true, if the matrix is invertible.
+ * Description: Symmetric rank-1 update, adds pf_vect * pf_vect' to the upper
+ *              triangle of pf_res. Folding one row of a matrix in at a time
+ *              builds the same upper triangle as utl_matSyrkF without ever
+ *              storing the matrix.
+ *
+ * Input Parameters:
+ *
+ *              pf_vect = A 1 by i_size vector
+ *
+ * Output Parameters:
+ *
+ *              pf_res = The i_size by i_size accumulation, the lower
+ *                       triangle is left untouched
  *---------------------------------------------------------------------------*/
-bool utl_matInvF( float *pf_mat,
-                  float *pf_inv,
-                  int32_t i_numElements)
+void utl_matSyrF( float *pf_vect,
+                  int32_t i_size,
+                  float *pf_res)
 {
    int32_t i_r = 0;
    int32_t i_c = 0;
-   float af_augMatr[UTL_MATH_MAX_MAT_ROW_SZ]\
-   [UTL_MATH_MAX_MAT_COL_SZ];
-   float af_tempRow[UTL_MATH_MAX_MAT_COL_SZ];
-   int32_t i_currR = 0;
-   int32_t i_nextR = 0;
-   int32_t i_currC = 0;
-   float f_temp = 0;
-
-   if( (i_numElements*2) > UTL_MATH_MAX_MAT_COL_SZ)
-      return false;
-   else
+   float *pf_resRow;
+   float f_a;
+
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
+      f_a       = pf_vect[i_r];
+      pf_resRow = pf_res + i_r*i_size;
+
+      for( i_c = i_r; i_c < i_size; i_c++)
+         pf_resRow[i_c] = utl_macF( f_a, pf_vect[i_c], pf_resRow[i_c]);
+
+   }/*End for( i_r = 0; i_r < i_size; i_r++)*/
+
+}/*End utl_matSyrF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matSprF
+ *
+ * Description: Symmetric rank-1 update of a packed matrix, adds pf_vect *
+ *              pf_vect' to the lower triangle stored in pf_packed. Same as
+ *              utl_matSyrF for callers that only keep the packed form.
+ *
+ * Input Parameters:
+ *
+ *              pf_vect = A 1 by i_size vector
+ *
+ * Output Parameters:
+ *
+ *              pf_packed = The i_size by i_size accumulation, packed by rows
+ *                          (see UTL_MATH_PACKED_IDX)
+ *---------------------------------------------------------------------------*/
+void utl_matSprF( float *pf_vect,
+                  int32_t i_size,
+                  float *pf_packed)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   float f_a;
+
+   for( i_r = 0; i_r < i_size; i_r++)
    {
+      f_a = pf_vect[i_r];
+
+      for( i_c = 0; i_c <= i_r; i_c++)
+      {
+         *pf_packed = utl_macF( f_a, pf_vect[i_c], *pf_packed);
+         pf_packed++;
+      }
+
+   }/*End for( i_r = 0; i_r < i_size; i_r++)*/
+
+}/*End utl_matSprF*/
 
+/*---------------------------------------------------------------------------*
+ * Function utl_matPackF
+ *
+ * Description: Copies the lower triangle of a full symmetric matrix into
+ *              packed storage. The packed element (r,c) never lies past the
+ *              full one, so pf_packed may be the same buffer as pf_mat.
+ *
+ * Input Parameters:
+ *
+ *              pf_mat = A i_size by i_size symmetric matrix, only the lower
+ *                       triangle is read
+ *
+ * Output Parameters:
+ *
+ *              pf_packed = The UTL_MATH_PACKED_SIZE( i_size) packed matrix
+ *---------------------------------------------------------------------------*/
+void utl_matPackF( float *pf_mat,
+                   int32_t i_size,
+                   float *pf_packed)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+
+   for( i_r = 0; i_r < i_size; i_r++)
+      for( i_c = 0; i_c <= i_r; i_c++)
+         *pf_packed++ = pf_mat[i_r*i_size + i_c];
+
+}/*End utl_matPackF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matCholF
+ *
+ * Description: In place Cholesky factorization A = L*L' of a symmetric
+ *              positive definite matrix held in packed storage. Takes about
+ *              a sixth of the multiplies of an explicit inverse and needs no
+ *              scratch memory.
+ *
+ * Input Parameters:
+ *
+ *              pf_packed = The packed i_size by i_size matrix A
+ *
+ * Output Parameters:
+ *
+ *              pf_packed = The packed lower triangular factor L
+ *
+ *              b_passed = false, if A is not positive definite.
+ *---------------------------------------------------------------------------*/
+bool utl_matCholF( float *pf_packed,
+                   int32_t i_size)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   int32_t i_k = 0;
+   float *pf_row;
+   float *pf_colRow;
+   float f_sum;
+
+   pf_row = pf_packed;
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
       /*---------------------------------------------------------------------*
-       * Copy the elements of pi_mat into the augmented matrix...
+       * L(r,c) = (A(r,c) - sum L(r,k)*L(c,k))/L(c,c), rows r and c are both
+       * contiguous in packed storage...
        *---------------------------------------------------------------------*/
-      for( i_r = 0; i_r < i_numElements; i_r++)
+      pf_colRow = pf_packed;
+      for( i_c = 0; i_c < i_r; i_c++)
       {
-         for( i_c = 0; i_c < i_numElements; i_c++)
-         {
-            af_augMatr[i_r][i_c] =
-            *(pf_mat + i_r*i_numElements + i_c);
-         }
+         f_sum = pf_row[i_c];
+         for( i_k = 0; i_k < i_c; i_k++)
+            f_sum = utl_macF( -pf_row[i_k], pf_colRow[i_k], f_sum);
+
+         pf_row[i_c] = utl_divF( f_sum, pf_colRow[i_c]);
+         pf_colRow += i_c + 1;
       }
 
+      f_sum = pf_row[i_r];
+      for( i_k = 0; i_k < i_r; i_k++)
+         f_sum = utl_macF( -pf_row[i_k], pf_row[i_k], f_sum);
+
+      if( f_sum <= 0.0f)
+         return false; /*Not positive definite*/
+
+      pf_row[i_r] = sqrtf( f_sum);
+      pf_row += i_r + 1;
+
+   }/*End for( i_r = 0; i_r < i_size; i_r++)*/
+
+   return true;
+
+}/*End utl_matCholF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matCholSolveF
+ *
+ * Description: Solves A*x = b given the Cholesky factor from utl_matCholF,
+ *              by forward substitution with L followed by back substitution
+ *              with L'.
+ *
+ * Input Parameters:
+ *
+ *              pf_packed = The packed factor L
+ *
+ *              pf_x = The i_size by 1 right hand side b
+ *
+ * Output Parameters:
+ *
+ *              pf_x = The i_size by 1 solution x
+ *---------------------------------------------------------------------------*/
+void utl_matCholSolveF( float *pf_packed,
+                        int32_t i_size,
+                        float *pf_x)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   float *pf_row;
+   float f_sum;
+
+   /*------------------------------------------------------------------------*
+    * L*y = b...
+    *------------------------------------------------------------------------*/
+   pf_row = pf_packed;
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
+      f_sum = pf_x[i_r];
+      for( i_c = 0; i_c < i_r; i_c++)
+         f_sum = utl_macF( -pf_row[i_c], pf_x[i_c], f_sum);
+
+      pf_x[i_r] = utl_divF( f_sum, pf_row[i_r]);
+      pf_row += i_r + 1;
+   }
+
+   /*------------------------------------------------------------------------*
+    * L'*x = y, walked a row of L at a time so the packed reads stay
+    * contiguous...
+    *------------------------------------------------------------------------*/
+   for( i_r = i_size - 1; i_r >= 0; i_r--)
+   {
+      pf_row -= i_r + 1;
+      pf_x[i_r] = utl_divF( pf_x[i_r], pf_row[i_r]);
+      for( i_c = 0; i_c < i_r; i_c++)
+         pf_x[i_c] = utl_macF( -pf_row[i_c], pf_x[i_r], pf_x[i_c]);
+   }
+
+}/*End utl_matCholSolveF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matLdltF
+ *
+ * Description: In place A = L*D*L' factorization of a symmetric matrix held
+ *              in packed storage, where L is unit lower triangular and D is
+ *              diagonal. Unlike utl_matCholF it takes no square roots and
+ *              accepts indefinite matrices, there is no pivoting though so
+ *              none of the leading minors may be singular.
+ *
+ * Input Parameters:
+ *
+ *              pf_packed = The packed i_size by i_size matrix A
+ *
+ * Output Parameters:
+ *
+ *              pf_packed = L below the diagonal and D on the diagonal
+ *
+ *              b_passed = false, if a pivot of D is zero.
+ *---------------------------------------------------------------------------*/
+bool utl_matLdltF( float *pf_packed,
+                   int32_t i_size)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   int32_t i_k = 0;
+   float *pf_row;
+   float *pf_colRow;
+   float f_sum;
+   float f_l;
+
+   pf_row = pf_packed;
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
       /*---------------------------------------------------------------------*
-       * Form identity matrix on left hand side of ai_augMatr...
+       * First leave L(r,c)*D(c) in the row, it is what the next columns and
+       * the diagonal need...
        *---------------------------------------------------------------------*/
-      for( i_r = 0; i_r < i_numElements; i_r++)
+      pf_colRow = pf_packed;
+      for( i_c = 0; i_c < i_r; i_c++)
+      {
+         f_sum = pf_row[i_c];
+         for( i_k = 0; i_k < i_c; i_k++)
+            f_sum = utl_macF( -pf_row[i_k], pf_colRow[i_k], f_sum);
+
+         pf_row[i_c] = f_sum;
+         pf_colRow += i_c + 1;
+      }
+
+      /*---------------------------------------------------------------------*
+       * ...then D(r) = A(r,r) - sum L(r,c)*D(c)*L(r,c) and scale the row
+       * down to L(r,c).
+       *---------------------------------------------------------------------*/
+      f_sum = pf_row[i_r];
+      pf_colRow = pf_packed;
+      for( i_c = 0; i_c < i_r; i_c++)
+      {
+         f_l = utl_divF( pf_row[i_c], pf_colRow[i_c]);
+         f_sum = utl_macF( -f_l, pf_row[i_c], f_sum);
+         pf_row[i_c] = f_l;
+         pf_colRow += i_c + 1;
+      }
+
+      if( f_sum == 0.0f)
+         return false; /*Singular*/
+
+      pf_row[i_r] = f_sum;
+      pf_row += i_r + 1;
+
+   }/*End for( i_r = 0; i_r < i_size; i_r++)*/
+
+   return true;
+
+}/*End utl_matLdltF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matLdltSolveF
+ *
+ * Description: Solves A*x = b given the factors from utl_matLdltF.
+ *
+ * Input Parameters:
+ *
+ *              pf_packed = The packed L and D
+ *
+ *              pf_x = The i_size by 1 right hand side b
+ *
+ * Output Parameters:
+ *
+ *              pf_x = The i_size by 1 solution x
+ *---------------------------------------------------------------------------*/
+void utl_matLdltSolveF( float *pf_packed,
+                        int32_t i_size,
+                        float *pf_x)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   float *pf_row;
+   float f_sum;
+
+   /*------------------------------------------------------------------------*
+    * L*z = b...
+    *------------------------------------------------------------------------*/
+   pf_row = pf_packed;
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
+      f_sum = pf_x[i_r];
+      for( i_c = 0; i_c < i_r; i_c++)
+         f_sum = utl_macF( -pf_row[i_c], pf_x[i_c], f_sum);
+
+      pf_x[i_r] = f_sum;
+      pf_row += i_r + 1;
+   }
+
+   /*------------------------------------------------------------------------*
+    * D*y = z and L'*x = y...
+    *------------------------------------------------------------------------*/
+   for( i_r = i_size - 1; i_r >= 0; i_r--)
+   {
+      pf_row -= i_r + 1;
+      pf_x[i_r] = utl_divF( pf_x[i_r], pf_row[i_r]);
+   }
+
+   pf_row = pf_packed + UTL_MATH_PACKED_SIZE( i_size);
+   for( i_r = i_size - 1; i_r >= 0; i_r--)
+   {
+      pf_row -= i_r + 1;
+      for( i_c = 0; i_c < i_r; i_c++)
+         pf_x[i_c] = utl_macF( -pf_row[i_c], pf_x[i_r], pf_x[i_c]);
+   }
+
+}/*End utl_matLdltSolveF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matLuF
+ *
+ * Description: In place LU factorization with partial pivoting, P*A = L*U,
+ *              for general square matrices.
+ *
+ * Input Parameters:
+ *
+ *              pf_mat = A i_size by i_size matrix
+ *
+ *              i_size = The number of rows/columns, at most 127
+ *
+ * Output Parameters:
+ *
+ *              pf_mat = U on and above the diagonal, the unit lower
+ *                       triangular L below it
+ *
+ *              pc_piv = i_size row interchanges, row k was swapped with row
+ *                       pc_piv[k] at step k
+ *
+ *              b_passed = false, if the matrix is singular.
+ *---------------------------------------------------------------------------*/
+bool utl_matLuF( float *pf_mat,
+                 int32_t i_size,
+                 int8_t *pc_piv)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   int32_t i_k = 0;
+   int32_t i_p = 0;
+   float *pf_pivRow;
+   float *pf_row;
+   float f_max;
+   float f_temp;
+
+   for( i_k = 0; i_k < i_size; i_k++)
+   {
+      /*---------------------------------------------------------------------*
+       * Pick the largest magnitude in the column as the pivot...
+       *---------------------------------------------------------------------*/
+      i_p   = i_k;
+      f_max = fabsf( pf_mat[i_k*i_size + i_k]);
+      for( i_r = i_k + 1; i_r < i_size; i_r++)
       {
-         for( i_c = i_numElements; i_c < 2*i_numElements; i_c++)
+         f_temp = fabsf( pf_mat[i_r*i_size + i_k]);
+         if( f_temp > f_max)
          {
-            if( i_r == (i_c - i_numElements))
-               af_augMatr[i_r][i_c] = 1.0;
-            else
-               af_augMatr[i_r][i_c] = 0.0;
+            f_max = f_temp;
+            i_p   = i_r;
          }
       }
 
-      i_currC = 0;
+      if( f_max == 0.0f)
+         return false; /*Matrix is singular*/
 
-      for( i_currR = 0; i_currR < i_numElements; i_currR++)
+      pc_piv[i_k] = (int8_t)i_p;
+      pf_pivRow   = pf_mat + i_k*i_size;
+
+      if( i_p != i_k)
       {
-         if( i_currR == i_currC)
+         pf_row = pf_mat + i_p*i_size;
+         for( i_c = 0; i_c < i_size; i_c++)
          {
-            i_nextR = i_currR + 1;
+            f_temp         = pf_pivRow[i_c];
+            pf_pivRow[i_c] = pf_row[i_c];
+            pf_row[i_c]    = f_temp;
+         }
+      }
 
-            /*---------------------------------------------------------------*
-             * Check to see if we need to swap rows if the current element
-             * is zero - with margin for error...
-             *---------------------------------------------------------------*/
-            if( fabs(af_augMatr[i_currR][i_currC]) == 0)
-            {
-               if( (i_nextR != i_numElements) && (fabs(
-               af_augMatr[i_nextR][i_currC]) > 0.0000001))
-               {
-                  for( i_c = 0; i_c < i_numElements*2; i_c++)
-                  {
-                     af_tempRow[i_c] = af_augMatr[i_currR][i_c];
-                     af_augMatr[i_currR][i_c] = af_augMatr[i_nextR][i_c];
-                     af_augMatr[i_nextR][i_c] = af_tempRow[i_c];
-                  }
-               }
-               else
-                  return false; /*Matrix is not invertible*/
-            }
+      /*---------------------------------------------------------------------*
+       * Eliminate below the pivot, keeping the multipliers in place of the
+       * zeros...
+       *---------------------------------------------------------------------*/
+      f_temp = utl_divF( 1.0f, pf_pivRow[i_k]);
+      for( i_r = i_k + 1; i_r < i_size; i_r++)
+      {
+         pf_row      = pf_mat + i_r*i_size;
+         pf_row[i_k] = utl_multF( pf_row[i_k], f_temp);
+         for( i_c = i_k + 1; i_c < i_size; i_c++)
+            pf_row[i_c] = utl_macF( -pf_row[i_k], pf_pivRow[i_c], pf_row[i_c]);
+      }
 
-            /*---------------------------------------------------------------*
-             * Make sure the diagonal element is a positive 1 by dividing the
-             * entire row by its current value...
-             *---------------------------------------------------------------*/
-             f_temp = utl_divF( 1.0, af_augMatr[i_currR][i_currC]);
-             for( i_c = i_currC; i_c < i_numElements*2; i_c++)
-             {
-                af_augMatr[i_currR][i_c] = utl_multF( af_augMatr[i_currR][i_c],
-                f_temp);
-             }
-          }/*End if( i_currR == i_currC)*/
-
-          /*-----------------------------------------------------------------*
-           * Make sure all the rows above and below the diagonal element are
-           * zero...
-           *-----------------------------------------------------------------*/
-          for( i_r = 0; i_r < i_currR; i_r++)
-          {
-             /*--------------------------------------------------------------*
-              * Negate current value of the element we are going to zero...
-              *--------------------------------------------------------------*/
-             f_temp = -af_augMatr[i_r][i_currC];
-             for( i_c = i_currC; i_c < i_numElements*2; i_c++)
-             {
-
-                /*-----------------------------------------------------------*
-                 * Scale all elements in the row containing the diagnal by
-                 * this value and add to the row we are trying to zero...
-                 *-----------------------------------------------------------*/
-                af_augMatr[i_r][i_c] = utl_macF( f_temp,
-                af_augMatr[i_currR][i_c], af_augMatr[i_r][i_c]);
-
-             }/*End for( i_c = 0; i_c < i_numElements*2; i_c++)*/
-          }
-
-          for( i_r = i_currR + 1; i_r < i_numElements; i_r++)
-          {
-             /*--------------------------------------------------------------*
-              * Negate current value of the element we are going to zero...
-              *--------------------------------------------------------------*/
-             f_temp = -af_augMatr[i_r][i_currC];
-             for( i_c = i_currC; i_c < i_numElements*2; i_c++)
-             {
-                /*-----------------------------------------------------------*
-                 * Scale all elements in the row containing the diagnal by
-                 * this value and add to the row we are trying to zero...
-                 *-----------------------------------------------------------*/
-                af_augMatr[i_r][i_c] = utl_macF( f_temp,
-                af_augMatr[i_currR][i_c], af_augMatr[i_r][i_c]);
-
-             }/*End for( i_c = 0; i_c < i_numElements*2; i_c++)*/
-          }
-
-          /*-----------------------------------------------------------------*
-           * Increment to the next diagonal element...
-           *-----------------------------------------------------------------*/
-          i_currC++;
-
-       }/*End while( i_currR != i_numElements)*/
-
-       /*--------------------------------------------------------------------*
-        * Copy the elements of pi_mat into the augmented matrix...
-        *--------------------------------------------------------------------*/
-       for( i_r = 0; i_r < i_numElements; i_r++)
-       {
-          for( i_c = 0; i_c < i_numElements; i_c++)
-         {
-             (*(pf_inv + i_r*i_numElements + i_c)) = af_augMatr[i_r][i_c +
-             i_numElements];
-          }
-       }
+   }/*End for( i_k = 0; i_k < i_size; i_k++)*/
+
+   return true;
+
+}/*End utl_matLuF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matLuSolveF
+ *
+ * Description: Solves A*x = b given the factors from utl_matLuF.
+ *
+ * Input Parameters:
+ *
+ *              pf_mat = The factored i_size by i_size matrix
+ *
+ *              pc_piv = The row interchanges from utl_matLuF
+ *
+ *              pf_x = The i_size by 1 right hand side b
+ *
+ * Output Parameters:
+ *
+ *              pf_x = The i_size by 1 solution x
+ *---------------------------------------------------------------------------*/
+void utl_matLuSolveF( float *pf_mat,
+                      int32_t i_size,
+                      int8_t *pc_piv,
+                      float *pf_x)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   float *pf_row;
+   float f_sum;
+
+   /*------------------------------------------------------------------------*
+    * P*b, then L*y = P*b...
+    *------------------------------------------------------------------------*/
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
+      if( pc_piv[i_r] != i_r)
+      {
+         f_sum             = pf_x[i_r];
+         pf_x[i_r]         = pf_x[pc_piv[i_r]];
+         pf_x[pc_piv[i_r]] = f_sum;
+      }
+   }
+
+   for( i_r = 1; i_r < i_size; i_r++)
+   {
+      pf_row = pf_mat + i_r*i_size;
+      f_sum  = pf_x[i_r];
+      for( i_c = 0; i_c < i_r; i_c++)
+         f_sum = utl_macF( -pf_row[i_c], pf_x[i_c], f_sum);
+
+      pf_x[i_r] = f_sum;
+   }
+
+   /*------------------------------------------------------------------------*
+    * U*x = y...
+    *------------------------------------------------------------------------*/
+   for( i_r = i_size - 1; i_r >= 0; i_r--)
+   {
+      pf_row = pf_mat + i_r*i_size;
+      f_sum  = pf_x[i_r];
+      for( i_c = i_r + 1; i_c < i_size; i_c++)
+         f_sum = utl_macF( -pf_row[i_c], pf_x[i_c], f_sum);
+
+      pf_x[i_r] = utl_divF( f_sum, pf_row[i_r]);
+   }
+
+}/*End utl_matLuSolveF*/
+
+/*---------------------------------------------------------------------------*
+ * Function utl_matInvF
+ *
+ * Description: Performs a floating point matrix inversion by LU factoring a
+ *              copy of the matrix and solving for one column of the inverse
+ *              at a time. Where a system only has to be solved, factor and
+ *              solve directly, it is cheaper and more accurate than forming
+ *              the inverse.
+ *
+ * Input Parameters:
+ *
+ *              pf_mat = A i_numElements by i_numElements square matrix
+ *
+ *              i_numElements = The number of rows/columns
+ *
+ * Output Parameters:
+ *
+ *              pf_inv = The resulting inverted matrix
+ *
+ *              b_invertible = true, if the matrix is invertible.
+ *---------------------------------------------------------------------------*/
+bool utl_matInvF( float *pf_mat,
+                  float *pf_inv,
+                  int32_t i_numElements)
+{
+   int32_t i_r = 0;
+   int32_t i_c = 0;
+   float af_lu[UTL_MATH_MAX_MAT_SZ*UTL_MATH_MAX_MAT_SZ];
+   float af_col[UTL_MATH_MAX_MAT_SZ];
+   int8_t ac_piv[UTL_MATH_MAX_MAT_SZ];
+
+   if( i_numElements > UTL_MATH_MAX_MAT_SZ)
+      return false;
+
+   memcpy( (void *)af_lu,
+           (void *)pf_mat,
+           sizeof( float)*i_numElements*i_numElements);
+
+   if( utl_matLuF( af_lu, i_numElements, ac_piv) == false)
+      return false; /*Matrix is not invertible*/
+
+   for( i_c = 0; i_c < i_numElements; i_c++)
+   {
+      for( i_r = 0; i_r < i_numElements; i_r++)
+         af_col[i_r] = 0.0f;
+      af_col[i_c] = 1.0f;
+
+      utl_matLuSolveF( af_lu, i_numElements, ac_piv, af_col);
+
+      for( i_r = 0; i_r < i_numElements; i_r++)
+         pf_inv[i_r*i_numElements + i_c] = af_col[i_r];
    }
 
    return true; /*Matrix is invertible*/
@@ -1598,128 +2130,175 @@ void utl_matEyeF( float *pf_mat,
 /*---------------------------------------------------------------------------*
  * Function utl_matEigsF
  *
- * Description: Finds the absolute value of the eigenvalues and their
- *              corresponding eigenvectors of a square matrix using the
- *              power method with deflation. See http://www.miislita.com/
- *              information-retrieval-tutorial/matrix-tutorial-3-eigenvalues-
- *              eigenvectors.html and http://www.math.umn.edu/~olver/num_/lnqr.
- *              pdf for more details
+ * Description: Finds the eigenvalues and their corresponding eigenvectors of
+ *              a symmetric matrix using the cyclic Jacobi method. Each sweep
+ *              zeroes every off-diagonal element once with a plane rotation,
+ *              the rotations are accumulated into the eigenvector matrix. The
+ *              number of sweeps is capped at UTL_MATH_JACOBI_MAX_SWEEPS so
+ *              the worst case run time is fixed, a 3x3 matrix typically
+ *              converges in 3 or 4 sweeps regardless of how close the
+ *              eigenvalues are. See Golub and Van Loan, "Matrix
+ *              Computations" section 8.4 for more details.
  *
  * Input Parameters:
  *
- *              pf_mat = (i_size x i_size) matrix
+ *              pf_mat = (i_size x i_size) symmetric matrix
  *
- *              i_size = number of rows and columns - maximum of 6 allowed
+ *              i_size = number of rows and columns
  *
  * Output Parameters:
  *
- *              pf_eigValues = column vector of positive eignvalues in
- *                             assending order.
+ *              pf_mat = overwritten, the diagonal holds the unsorted
+ *                       eigenvalues
+ *
+ *              pf_eigValues = column vector of eigenvalues in ascending
+ *                             order.
  *
  *              pf_eigVectors = matrix of normalized eigenvectors of size
- *                             (i_size x i_size)
+ *                             (i_size x i_size), column i belongs to
+ *                             pf_eigValues[i] and its first element is
+ *                             positive.
  *
- *              b_pass = true if the algorithm was able to run
+ *              b_pass = false if the off-diagonal elements didn't vanish
+ *                       within UTL_MATH_JACOBI_MAX_SWEEPS sweeps
  *---------------------------------------------------------------------------*/
 bool utl_matEigsF( float *pf_mat,
                    int32_t i_size,
                    float *pf_eigValues,
                    float *pf_eigVectors)
 {
-   int32_t i_iterCount = 0;
-   float f_error = 100.0;
-   float f_lambdaNew = 0.0;
-   float f_lambdaOld = 1.0;
-   float af_x[6];
-   float af_temp1[6*6];
+   int32_t i_sweep = 0;
+   int32_t i_p = 0;
+   int32_t i_q = 0;
    int32_t i_r = 0;
-   int32_t i_c = 0;
-
-   if( i_size > 6)
-     return false;
-
-   for( i_c = 0; i_c < i_size; i_c++)
+   int32_t i_min = 0;
+   bool b_rotated = true;
+   float f_apq;
+   float f_theta;
+   float f_t;
+   float f_c;
+   float f_s;
+   float f_tau;
+   float f_g;
+   float f_h;
+
+   utl_matEyeF( pf_eigVectors,
+                i_size,
+                1.0f);
+
+   for( i_sweep = 0; (i_sweep < UTL_MATH_JACOBI_MAX_SWEEPS) && (b_rotated ==
+   true); i_sweep++)
    {
+      b_rotated = false;
 
-      for( i_r = 0; i_r < i_size; i_r++)
-         af_x[i_r] = 1;
-
-      f_lambdaOld = 1.0;
-      f_error = 100.0;
-      i_iterCount = 0;
-
-      while( f_error > POWER_METHOD_MAX_ERROR)
+      for( i_p = 0; i_p < (i_size - 1); i_p++)
       {
+         for( i_q = i_p + 1; i_q < i_size; i_q++)
+         {
+            f_apq = pf_mat[i_p*i_size + i_q];
+
+            /*------------------------------------------------------------*
+             * Off-diagonal elements lost in the precision of the diagonal
+             * are done...
+             *------------------------------------------------------------*/
+            if( fabsf( f_apq) <= UTL_MATH_JACOBI_EPS*(fabsf( pf_mat[i_p*i_size
+                + i_p]) + fabsf( pf_mat[i_q*i_size + i_q])))
+            {
+               pf_mat[i_p*i_size + i_q] = 0.0f;
+               pf_mat[i_q*i_size + i_p] = 0.0f;
+               continue;
+            }
 
-         utl_matMultF( pf_mat,
-                       i_size,
-                       i_size,
-                       af_x,
-                       i_size,
-                       1,
-                       af_temp1);
+            b_rotated = true;
+
+            /*------------------------------------------------------------*
+             * Pick the smaller of the two rotation angles that zero a(p,q),
+             * t = tan( angle)...
+             *------------------------------------------------------------*/
+            f_theta = utl_divF( pf_mat[i_q*i_size + i_q] - pf_mat[i_p*i_size
+            + i_p], 2.0f*f_apq);
+            f_t = 1.0f / (fabsf( f_theta) + sqrtf( f_theta*f_theta + 1.0f));
+            if( f_theta < 0.0f)
+               f_t = -f_t;
+
+            f_c   = 1.0f / sqrtf( f_t*f_t + 1.0f);
+            f_s   = f_t*f_c;
+            f_tau = f_s / (1.0f + f_c);
+
+            pf_mat[i_p*i_size + i_p] -= f_t*f_apq;
+            pf_mat[i_q*i_size + i_q] += f_t*f_apq;
+            pf_mat[i_p*i_size + i_q] = 0.0f;
+            pf_mat[i_q*i_size + i_p] = 0.0f;
+
+            /*------------------------------------------------------------*
+             * Rotate rows/columns p and q of the rest of the matrix and
+             * columns p and q of the eigenvectors...
+             *------------------------------------------------------------*/
+            for( i_r = 0; i_r < i_size; i_r++)
+            {
+               if( (i_r != i_p) && (i_r != i_q))
+               {
+                  f_g = pf_mat[i_r*i_size + i_p];
+                  f_h = pf_mat[i_r*i_size + i_q];
+                  pf_mat[i_r*i_size + i_p] = f_g - f_s*(f_h + f_g*f_tau);
+                  pf_mat[i_r*i_size + i_q] = f_h + f_s*(f_g - f_h*f_tau);
+                  pf_mat[i_p*i_size + i_r] = pf_mat[i_r*i_size + i_p];
+                  pf_mat[i_q*i_size + i_r] = pf_mat[i_r*i_size + i_q];
+               }
 
-         /*------------------------------------------------------------------*
-          * Find the new eigenvalue...
-          *------------------------------------------------------------------*/
-         f_lambdaNew = af_temp1[0];// / af_x[0];
+               f_g = pf_eigVectors[i_r*i_size + i_p];
+               f_h = pf_eigVectors[i_r*i_size + i_q];
+               pf_eigVectors[i_r*i_size + i_p] = f_g - f_s*(f_h + f_g*f_tau);
+               pf_eigVectors[i_r*i_size + i_q] = f_h + f_s*(f_g - f_h*f_tau);
+            }
 
-         /*------------------------------------------------------------------*
-          * Normalize the eigenvector
-          *------------------------------------------------------------------*/
-         //utl_normF( af_temp1, i_size);
+         }/*End for( i_q = i_p + 1; i_q < i_size; i_q++)*/
 
-         for( i_r = 0; i_r < i_size; i_r++)
-            af_x[i_r] = af_temp1[i_r] / f_lambdaNew;
+      }/*End for( i_p = 0; i_p < (i_size - 1); i_p++)*/
 
-         /*------------------------------------------------------------------*
-          * Calculate percentage error
-          *------------------------------------------------------------------*/
-         f_error = fabs((f_lambdaNew - f_lambdaOld)/f_lambdaNew)*100.0;
+   }/*End for( i_sweep = 0; i_sweep < UTL_MATH_JACOBI_MAX_SWEEPS...)*/
 
-         f_lambdaOld = f_lambdaNew;
-         i_iterCount++;
+   for( i_r = 0; i_r < i_size; i_r++)
+      pf_eigValues[i_r] = pf_mat[i_r*i_size + i_r];
 
-      }/*End while( f_error > POWER_METHOD_MAX_ERROR)*/
+   /*------------------------------------------------------------------------*
+    * Sort into ascending order, swapping the eigenvector columns along, and
+    * fix the sign of each vector...
+    *------------------------------------------------------------------------*/
+   for( i_p = 0; i_p < i_size; i_p++)
+   {
+      i_min = i_p;
+      for( i_q = i_p + 1; i_q < i_size; i_q++)
+      {
+         if( pf_eigValues[i_q] < pf_eigValues[i_min])
+            i_min = i_q;
+      }
 
-      /*---------------------------------------------------------------------*
-       * Store the next largest eigenvalue and eigenvector in ascending order
-       *---------------------------------------------------------------------*/
-      pf_eigValues[(i_size - 1) - i_c] = f_lambdaNew;
+      if( i_min != i_p)
+      {
+         f_g                 = pf_eigValues[i_p];
+         pf_eigValues[i_p]   = pf_eigValues[i_min];
+         pf_eigValues[i_min] = f_g;
 
-      /*---------------------------------------------------------------------*
-       * Normalize the eigenvector
-       *---------------------------------------------------------------------*/
-      utl_normF( af_x, i_size);
+         for( i_r = 0; i_r < i_size; i_r++)
+         {
+            f_g = pf_eigVectors[i_r*i_size + i_p];
+            pf_eigVectors[i_r*i_size + i_p]   = pf_eigVectors[i_r*i_size +
+            i_min];
+            pf_eigVectors[i_r*i_size + i_min] = f_g;
+         }
+      }
 
-      for( i_r = 0; i_r < i_size; i_r++)
-         (*(pf_eigVectors + (i_r*i_size) + (i_size - 1 - i_c))) = af_x[i_r];
+      if( pf_eigVectors[i_p] < 0.0f)
+      {
+         for( i_r = 0; i_r < i_size; i_r++)
+            pf_eigVectors[i_r*i_size + i_p] = -pf_eigVectors[i_r*i_size +
+            i_p];
+      }
 
-      /*---------------------------------------------------------------------*
-       * Perform Deflation where A* = A - c*X*X'
-       *---------------------------------------------------------------------*/
-      utl_matMultF( af_x,
-                    i_size,
-                    1,
-                    af_x,
-                    1,
-                    i_size,
-                    af_temp1);
-
-      utl_matScalerMultF( af_temp1,
-                          i_size,
-                          i_size,
-                          f_lambdaNew);
-
-      utl_matSubF( pf_mat,
-                   af_temp1,
-                   i_size,
-                   i_size,
-                   pf_mat);
-
-   }/*End for( i_c = 0; i_c < i_size; i_c++)*/
+   }/*End for( i_p = 0; i_p < i_size; i_p++)*/
 
-   return true;
+   return !b_rotated;
 
 }/*End utl_matEigsF*/
 
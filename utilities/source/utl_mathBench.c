@@ -0,0 +1,463 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_mathBench.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file is responsible for the suites comparing the
+ *               utl_math routines against their utl_cordic equivalents and
+ *               timing the fixed-point multiply primitives and the
+ *               utl_filter block routines.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "utl_mathBench.h"
+#include "utl_math.h"
+#include "utl_cordic.h"
+#include "utl_filter.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define MATH_BENCH_BLOCK_SIZE (16)
+#define MATH_BENCH_FIR_TAPS   (16)
+#define MATH_BENCH_IIR_STAGES (2)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   /*------------------------------------------------------------------------*
+    * Results of the suites are stored here so they can't be optimized
+    * away.
+    *------------------------------------------------------------------------*/
+   volatile int32_t i_sink;
+
+   /*------------------------------------------------------------------------*
+    * Filters exercised by the filter suites, each call filters one block
+    * of 'as_filterIn' into 'as_filterOut'.
+    *------------------------------------------------------------------------*/
+   t_firFilter t_fir;
+   int16_t as_firState[UTL_FILTER_FIR_STATE_SIZE( MATH_BENCH_FIR_TAPS)];
+   t_biquadFilter t_biquad;
+   int16_t as_biquadState[UTL_FILTER_BIQUAD_STATE_SIZE(
+   MATH_BENCH_IIR_STAGES)];
+   int16_t as_filterIn[MATH_BENCH_BLOCK_SIZE];
+   int16_t as_filterOut[MATH_BENCH_BLOCK_SIZE];
+
+}t_mathBenchObject;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void utl_mathBenchSincos( void *pv_arg,
+                                 uint16_t s_iterations);
+static void utl_mathBenchCordicSincos( void *pv_arg,
+                                       uint16_t s_iterations);
+static void utl_mathBenchAtan2( void *pv_arg,
+                                uint16_t s_iterations);
+static void utl_mathBenchCordicAtan2( void *pv_arg,
+                                      uint16_t s_iterations);
+static void utl_mathBenchSqrt( void *pv_arg,
+                               uint16_t s_iterations);
+static void utl_mathBenchCordicSqrt( void *pv_arg,
+                                     uint16_t s_iterations);
+static void utl_mathBenchLog( void *pv_arg,
+                              uint16_t s_iterations);
+static void utl_mathBenchCordicLn( void *pv_arg,
+                                   uint16_t s_iterations);
+static void utl_mathBenchAlog( void *pv_arg,
+                               uint16_t s_iterations);
+static void utl_mathBenchCordicExp( void *pv_arg,
+                                    uint16_t s_iterations);
+static void utl_mathBenchMult16( void *pv_arg,
+                                 uint16_t s_iterations);
+static void utl_mathBenchMult16x16_32( void *pv_arg,
+                                       uint16_t s_iterations);
+static void utl_mathBenchMult32( void *pv_arg,
+                                 uint16_t s_iterations);
+static void utl_mathBenchMac16( void *pv_arg,
+                                uint16_t s_iterations);
+static void utl_mathBenchFirBlock( void *pv_arg,
+                                   uint16_t s_iterations);
+static void utl_mathBenchBiquadBlock( void *pv_arg,
+                                      uint16_t s_iterations);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static t_mathBenchObject gt_mathBench;
+
+/*---------------------------------------------------------------------------*
+ * 16 tap Hamming windowed low-pass at 0.1*fs in Q15, and a 4th order
+ * Butterworth low-pass at 0.05*fs as two Q14 sections (b0,b1,b2,a1,a2).
+ *---------------------------------------------------------------------------*/
+static const int16_t gas_mathBenchFirTaps[MATH_BENCH_FIR_TAPS] =
+{
+   -114, -159, -139, 291, 1448, 3281, 5241, 6518,
+   6518, 5241, 3281, 1448, 291, -139, -159, -114
+};
+
+static const int16_t gas_mathBenchBiquadCoeffs[UTL_FILTER_BIQUAD_COEFF_SIZE(
+MATH_BENCH_IIR_STAGES)] =
+{
+   312, 624, 312, -24243, 9107,
+   359, 717, 359, -27869, 12919
+};
+
+/*---------------------------------------------------------------------------*
+ * The suites, in the order they are reported.
+ *---------------------------------------------------------------------------*/
+static const t_benchCase gat_mathBenchSuites[] =
+{
+   /*------------------------------------------------------------------------*
+    * The table based math routines, each followed by its CORDIC
+    * equivalent.
+    *------------------------------------------------------------------------*/
+   {"utl_sincos16_16", &utl_mathBenchSincos, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"utl_cordicSincos16", &utl_mathBenchCordicSincos, NULL,
+    UTL_MATH_BENCH_ITERATIONS, UTL_MATH_BENCH_WARMUP,
+    UTL_MATH_BENCH_SAMPLES},
+   {"utl_atan2_16", &utl_mathBenchAtan2, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"utl_cordicAtan2_16", &utl_mathBenchCordicAtan2, NULL,
+    UTL_MATH_BENCH_ITERATIONS, UTL_MATH_BENCH_WARMUP,
+    UTL_MATH_BENCH_SAMPLES},
+   {"utl_sqrt32_32", &utl_mathBenchSqrt, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"utl_cordicSqrt32", &utl_mathBenchCordicSqrt, NULL,
+    UTL_MATH_BENCH_ITERATIONS, UTL_MATH_BENCH_WARMUP,
+    UTL_MATH_BENCH_SAMPLES},
+   {"utl_log10_32", &utl_mathBenchLog, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"utl_cordicLn32", &utl_mathBenchCordicLn, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"utl_alog10_32", &utl_mathBenchAlog, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"utl_cordicExp32", &utl_mathBenchCordicExp, NULL,
+    UTL_MATH_BENCH_ITERATIONS, UTL_MATH_BENCH_WARMUP,
+    UTL_MATH_BENCH_SAMPLES},
+   /*------------------------------------------------------------------------*
+    * The fixed-point multiply primitives, all in Q15.
+    *------------------------------------------------------------------------*/
+   {"utl_mult16x16_16", &utl_mathBenchMult16, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"utl_mult16x16_32", &utl_mathBenchMult16x16_32, NULL,
+    UTL_MATH_BENCH_ITERATIONS, UTL_MATH_BENCH_WARMUP,
+    UTL_MATH_BENCH_SAMPLES},
+   {"utl_mult32x32_32", &utl_mathBenchMult32, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"utl_mac16x16_32", &utl_mathBenchMac16, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   /*------------------------------------------------------------------------*
+    * One MATH_BENCH_BLOCK_SIZE sample block per iteration.
+    *------------------------------------------------------------------------*/
+   {"firBlock16", &utl_mathBenchFirBlock, NULL, UTL_MATH_BENCH_ITERATIONS,
+    UTL_MATH_BENCH_WARMUP, UTL_MATH_BENCH_SAMPLES},
+   {"biquadBlock16", &utl_mathBenchBiquadBlock, NULL,
+    UTL_MATH_BENCH_ITERATIONS, UTL_MATH_BENCH_WARMUP,
+    UTL_MATH_BENCH_SAMPLES}
+};
+
+#define MATH_BENCH_NUM_SUITES (sizeof( gat_mathBenchSuites) / \
+sizeof( t_benchCase))
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void utl_mathBenchSincos( void *pv_arg,
+                                 uint16_t s_iterations)
+{
+   int16_t s_sin;
+   int16_t s_cos;
+
+   while( s_iterations--)
+   {
+      utl_sincos16_16( (uint16_t)(s_iterations*4099), &s_sin, &s_cos);
+      gt_mathBench.i_sink = s_sin + s_cos;
+   }
+
+}/*End utl_mathBenchSincos*/
+
+static void utl_mathBenchCordicSincos( void *pv_arg,
+                                       uint16_t s_iterations)
+{
+   int16_t s_sin;
+   int16_t s_cos;
+
+   while( s_iterations--)
+   {
+      utl_cordicSincos16( (uint16_t)(s_iterations*4099), &s_sin, &s_cos);
+      gt_mathBench.i_sink = s_sin + s_cos;
+   }
+
+}/*End utl_mathBenchCordicSincos*/
+
+static void utl_mathBenchAtan2( void *pv_arg,
+                                uint16_t s_iterations)
+{
+   int16_t s_y;
+   int16_t s_x;
+
+   while( s_iterations--)
+   {
+      s_y = (int16_t)(s_iterations*4099);
+      s_x = (int16_t)(s_iterations*-2053);
+      gt_mathBench.i_sink = utl_atan2_16( s_y, s_x);
+   }
+
+}/*End utl_mathBenchAtan2*/
+
+static void utl_mathBenchCordicAtan2( void *pv_arg,
+                                      uint16_t s_iterations)
+{
+   int16_t s_y;
+   int16_t s_x;
+   uint16_t s_mag;
+
+   while( s_iterations--)
+   {
+      s_y = (int16_t)(s_iterations*4099);
+      s_x = (int16_t)(s_iterations*-2053);
+      gt_mathBench.i_sink = utl_cordicAtan2_16( s_y, s_x, &s_mag) +
+      s_mag;
+   }
+
+}/*End utl_mathBenchCordicAtan2*/
+
+static void utl_mathBenchSqrt( void *pv_arg,
+                               uint16_t s_iterations)
+{
+   uint32_t i_input;
+
+   while( s_iterations--)
+   {
+      i_input = (uint32_t)s_iterations*1234567 + 8192;
+      gt_mathBench.i_sink = (int32_t)utl_sqrt32_32( i_input, 15);
+   }
+
+}/*End utl_mathBenchSqrt*/
+
+static void utl_mathBenchCordicSqrt( void *pv_arg,
+                                     uint16_t s_iterations)
+{
+   uint32_t i_input;
+
+   while( s_iterations--)
+   {
+      i_input = (uint32_t)s_iterations*1234567 + 8192;
+      gt_mathBench.i_sink = (int32_t)utl_cordicSqrt32( i_input, 15);
+   }
+
+}/*End utl_mathBenchCordicSqrt*/
+
+static void utl_mathBenchLog( void *pv_arg,
+                              uint16_t s_iterations)
+{
+   uint32_t i_input;
+
+   while( s_iterations--)
+   {
+      i_input = (uint32_t)s_iterations*1234567 + 8192;
+      gt_mathBench.i_sink = utl_log10_32( i_input);
+   }
+
+}/*End utl_mathBenchLog*/
+
+static void utl_mathBenchCordicLn( void *pv_arg,
+                                   uint16_t s_iterations)
+{
+   uint32_t i_input;
+
+   while( s_iterations--)
+   {
+      i_input = (uint32_t)s_iterations*1234567 + 8192;
+      gt_mathBench.i_sink = utl_cordicLn32( i_input);
+   }
+
+}/*End utl_mathBenchCordicLn*/
+
+static void utl_mathBenchAlog( void *pv_arg,
+                               uint16_t s_iterations)
+{
+   int32_t i_input;
+
+   while( s_iterations--)
+   {
+      i_input = (int32_t)s_iterations*8191 - 65536;
+      gt_mathBench.i_sink = (int32_t)utl_alog10_32( i_input);
+   }
+
+}/*End utl_mathBenchAlog*/
+
+static void utl_mathBenchCordicExp( void *pv_arg,
+                                    uint16_t s_iterations)
+{
+   int32_t i_input;
+
+   while( s_iterations--)
+   {
+      i_input = (int32_t)s_iterations*8191 - 65536;
+      gt_mathBench.i_sink = (int32_t)utl_cordicExp32( i_input);
+   }
+
+}/*End utl_mathBenchCordicExp*/
+
+static void utl_mathBenchMult16( void *pv_arg,
+                                 uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      gt_mathBench.i_sink = utl_mult16x16_16(
+      (int16_t)(s_iterations*4099), (int16_t)(s_iterations*-2053), 15);
+   }
+
+}/*End utl_mathBenchMult16*/
+
+static void utl_mathBenchMult16x16_32( void *pv_arg,
+                                       uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      gt_mathBench.i_sink = utl_mult16x16_32(
+      (int16_t)(s_iterations*4099), (int16_t)(s_iterations*-2053), 15);
+   }
+
+}/*End utl_mathBenchMult16x16_32*/
+
+static void utl_mathBenchMult32( void *pv_arg,
+                                 uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      gt_mathBench.i_sink = utl_mult32x32_32(
+      (int32_t)s_iterations*1234567, (int32_t)s_iterations*-7654321, 15);
+   }
+
+}/*End utl_mathBenchMult32*/
+
+static void utl_mathBenchMac16( void *pv_arg,
+                                uint16_t s_iterations)
+{
+   int32_t i_y = 0;
+
+   while( s_iterations--)
+   {
+      i_y = utl_mac16x16_32( (int16_t)(s_iterations*4099),
+                             (int16_t)(s_iterations*-2053),
+                             i_y,
+                             1);
+   }
+
+   gt_mathBench.i_sink = i_y;
+
+}/*End utl_mathBenchMac16*/
+
+static void utl_mathBenchFirBlock( void *pv_arg,
+                                   uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      utl_fir16( &gt_mathBench.t_fir,
+                 gt_mathBench.as_filterIn,
+                 gt_mathBench.as_filterOut,
+                 MATH_BENCH_BLOCK_SIZE);
+   }
+
+   gt_mathBench.i_sink = gt_mathBench.as_filterOut[0];
+
+}/*End utl_mathBenchFirBlock*/
+
+static void utl_mathBenchBiquadBlock( void *pv_arg,
+                                      uint16_t s_iterations)
+{
+   while( s_iterations--)
+   {
+      utl_biquad16( &gt_mathBench.t_biquad,
+                    gt_mathBench.as_filterIn,
+                    gt_mathBench.as_filterOut,
+                    MATH_BENCH_BLOCK_SIZE);
+   }
+
+   gt_mathBench.i_sink = gt_mathBench.as_filterOut[0];
+
+}/*End utl_mathBenchBiquadBlock*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_benchError utl_mathBenchInit( void)
+{
+   t_benchError t_err;
+   uint16_t s_index;
+
+   t_err = utl_benchInit();
+   if( t_err < 0)
+      return t_err;
+
+   utl_initFir( &gt_mathBench.t_fir,
+                gas_mathBenchFirTaps,
+                MATH_BENCH_FIR_TAPS,
+                gt_mathBench.as_firState,
+                15);
+
+   utl_initBiquad( &gt_mathBench.t_biquad,
+                   gas_mathBenchBiquadCoeffs,
+                   MATH_BENCH_IIR_STAGES,
+                   gt_mathBench.as_biquadState,
+                   14);
+
+   /*------------------------------------------------------------------------*
+    * A full scale square wave with a period of half a block.
+    *------------------------------------------------------------------------*/
+   for( s_index = 0; s_index < MATH_BENCH_BLOCK_SIZE; s_index++)
+   {
+      gt_mathBench.as_filterIn[s_index] = (s_index & 4) ? -32767 : 32767;
+   }
+
+   return BENCH_PASSED;
+
+}/*End utl_mathBenchInit*/
+
+int16_t utl_mathBenchRun( uint8_t c_suite,
+                          char *pc_buff,
+                          uint16_t s_size)
+{
+   t_benchResult t_result;
+   t_benchError t_err;
+
+   if( c_suite >= MATH_BENCH_NUM_SUITES)
+      return 0;
+
+   t_err = utl_benchRun( &gat_mathBenchSuites[c_suite],
+                         &t_result);
+   if( t_err < 0)
+      return (int16_t)t_err;
+
+   return utl_benchFormatResult( &gat_mathBenchSuites[c_suite],
+                                 &t_result,
+                                 pc_buff,
+                                 s_size);
+
+}/*End utl_mathBenchRun*/
@@ -0,0 +1,231 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_ring.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : This file provides the block and span operations for the
+ *               power-of-two circular buffers in utl_ring.h.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "utl_ring.h"
+#include "arb_memory.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_ringError utl_ringInit( t_ring *pt_ring,
+                          int8_t *pc_storage,
+                          uint16_t s_sizeBytes)
+{
+   if( (pt_ring == NULL) || (pc_storage == NULL))
+      return RING_NULL_PTR;
+
+   if( !UTL_RING_IS_POW2( s_sizeBytes) || (s_sizeBytes > UTL_RING_MAX_SIZE))
+      return RING_INVALID_SIZE;
+
+   pt_ring->pc_buffer = pc_storage;
+   pt_ring->s_mask    = s_sizeBytes - 1;
+   pt_ring->s_wrIndex = 0;
+   pt_ring->s_rdIndex = 0;
+
+   return RING_PASSED;
+
+}/*End utl_ringInit*/
+
+t_ringError utl_createRing( t_ring *pt_ring,
+                            uint16_t s_sizeBytes)
+{
+   int8_t *pc_storage = NULL;
+   t_ringError t_err;
+
+   if( pt_ring == NULL)
+      return RING_NULL_PTR;
+
+   if( !UTL_RING_IS_POW2( s_sizeBytes) || (s_sizeBytes > UTL_RING_MAX_SIZE))
+      return RING_INVALID_SIZE;
+
+   arb_malloc( (size_t)s_sizeBytes,
+               (void **)&pc_storage);
+
+   if( pc_storage == NULL)
+      return RING_OUT_OF_HEAP;
+
+   memset( (void *)pc_storage, 0, s_sizeBytes);
+
+   t_err = utl_ringInit( pt_ring,
+                         pc_storage,
+                         s_sizeBytes);
+
+   return t_err;
+
+}/*End utl_createRing*/
+
+void utl_destroyRing( t_ring *pt_ring)
+{
+   if( (pt_ring != NULL) && (pt_ring->pc_buffer != NULL))
+   {
+      arb_free( (void **)&pt_ring->pc_buffer);
+      pt_ring->s_mask = 0;
+   }
+
+}/*End utl_destroyRing*/
+
+void utl_resetRing( t_ring *pt_ring)
+{
+   pt_ring->s_rdIndex = pt_ring->s_wrIndex;
+}/*End utl_resetRing*/
+
+uint16_t utl_ringWriteBlock( t_ring *pt_ring,
+                             const int8_t *pc_buff,
+                             uint16_t s_size)
+{
+   uint16_t s_wrIndex = pt_ring->s_wrIndex;
+   uint16_t s_offset  = s_wrIndex & pt_ring->s_mask;
+   uint16_t s_room;
+   uint16_t s_first;
+
+   s_room = (pt_ring->s_mask + 1) - (uint16_t)(s_wrIndex -
+   utl_ringLoadIndex( &pt_ring->s_rdIndex));
+
+   if( s_size > s_room)
+      s_size = s_room;
+
+   /*------------------------------------------------------------------------*
+    * Copy up to the end of the storage area, then whatever is left starting
+    * at the beginning.
+    *------------------------------------------------------------------------*/
+   s_first = (pt_ring->s_mask + 1) - s_offset;
+   if( s_first > s_size)
+      s_first = s_size;
+
+   memcpy( (void *)&pt_ring->pc_buffer[s_offset],
+           (const void *)pc_buff,
+           s_first);
+
+   memcpy( (void *)pt_ring->pc_buffer,
+           (const void *)&pc_buff[s_first],
+           s_size - s_first);
+
+   utl_ringCommitWrite( pt_ring,
+                        s_size);
+
+   return s_size;
+
+}/*End utl_ringWriteBlock*/
+
+uint16_t utl_ringReadBlock( t_ring *pt_ring,
+                            int8_t *pc_buff,
+                            uint16_t s_size)
+{
+   uint16_t s_rdIndex = pt_ring->s_rdIndex;
+   uint16_t s_offset  = s_rdIndex & pt_ring->s_mask;
+   uint16_t s_level;
+   uint16_t s_first;
+
+   s_level = utl_ringLoadIndex( &pt_ring->s_wrIndex) - s_rdIndex;
+
+   if( s_size > s_level)
+      s_size = s_level;
+
+   s_first = (pt_ring->s_mask + 1) - s_offset;
+   if( s_first > s_size)
+      s_first = s_size;
+
+   memcpy( (void *)pc_buff,
+           (const void *)&pt_ring->pc_buffer[s_offset],
+           s_first);
+
+   memcpy( (void *)&pc_buff[s_first],
+           (const void *)pt_ring->pc_buffer,
+           s_size - s_first);
+
+   utl_ringCommitRead( pt_ring,
+                       s_size);
+
+   return s_size;
+
+}/*End utl_ringReadBlock*/
+
+uint16_t utl_ringPeekWrite( t_ring *pt_ring,
+                            int8_t **ppc_span)
+{
+   uint16_t s_wrIndex = pt_ring->s_wrIndex;
+   uint16_t s_offset  = s_wrIndex & pt_ring->s_mask;
+   uint16_t s_room;
+   uint16_t s_span;
+
+   s_room = (pt_ring->s_mask + 1) - (uint16_t)(s_wrIndex -
+   utl_ringLoadIndex( &pt_ring->s_rdIndex));
+
+   s_span = (pt_ring->s_mask + 1) - s_offset;
+   if( s_span > s_room)
+      s_span = s_room;
+
+   *ppc_span = &pt_ring->pc_buffer[s_offset];
+
+   return s_span;
+
+}/*End utl_ringPeekWrite*/
+
+uint16_t utl_ringPeekRead( t_ring *pt_ring,
+                           int8_t **ppc_span)
+{
+   uint16_t s_rdIndex = pt_ring->s_rdIndex;
+   uint16_t s_offset  = s_rdIndex & pt_ring->s_mask;
+   uint16_t s_level;
+   uint16_t s_span;
+
+   s_level = utl_ringLoadIndex( &pt_ring->s_wrIndex) - s_rdIndex;
+
+   s_span = (pt_ring->s_mask + 1) - s_offset;
+   if( s_span > s_level)
+      s_span = s_level;
+
+   *ppc_span = &pt_ring->pc_buffer[s_offset];
+
+   return s_span;
+
+}/*End utl_ringPeekRead*/
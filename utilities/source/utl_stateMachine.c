@@ -1,39 +1,10 @@
-/*---------------------------------------------------------------------------*
- * Copyright (C) 2011-2012 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
- *
- *	This program is free software: you can redistribute it and/or modify
- *	it under the terms of the GNU General Public License as published by
- *	the Free Software Foundation, either version 3 of the License, or
- *	(at your option) any later version.
- *
- *	This program is distributed in the hope that it will be useful,
- *	but WITHOUT ANY WARRANTY; without even the implied warranty of
- *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- *	GNU General Public License for more details.
- *
- *	You should have received a copy of the GNU General Public License
- *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
- *
- * File Name   : utl_stateMachine.c
- *
- * Project     : Arbitros
- *               <https://code.google.com/p/arbitros/>
- *
- * Description : This file provides an abstraction layer for the
- *               implementation of a state-machine.
- *
- * Last Update : Oct 27, 2012
- *---------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------*
  * Include Files
  *---------------------------------------------------------------------------*/
 #include <stdio.h>
 #include <string.h>
-#include "utl_linkedList.h"
-#include "hal_pmic.h"
 #include "utl_stateMachine.h"
-#include "arb_semaphore.h"
 
 /*---------------------------------------------------------------------------*
  * Private Defines
@@ -42,377 +13,256 @@
 /*---------------------------------------------------------------------------*
  * Private Datatypes
  *---------------------------------------------------------------------------*/
-typedef void (*funPtr_t)(int32_t, uint8_t);
-
-typedef struct
-{
-   /*------------------------------------------------------------------------*
-    * The next state to execute.
-    *------------------------------------------------------------------------*/
-   uint8_t c_nextState;
-   /*------------------------------------------------------------------------*
-    * The current state executing.
-    *------------------------------------------------------------------------*/
-   uint8_t c_currState;
-   /*------------------------------------------------------------------------*
-    * The last state that executed.
-    *------------------------------------------------------------------------*/
-   uint8_t c_prevState;
-   /*------------------------------------------------------------------------*
-    * The number of states defined by this state-machine object.
-    *------------------------------------------------------------------------*/
-   uint8_t c_numStates;
-   /*------------------------------------------------------------------------*
-    * Data passed into a particular state.
-    *------------------------------------------------------------------------*/
-   int32_t i_stateData;
-   /*------------------------------------------------------------------------*
-    * Array of function ptrs, one for each of the 'c_numStates' possible
-    * states.
-    *------------------------------------------------------------------------*/
-   funPtr_t *pv_funcMap;
-
-   /*------------------------------------------------------------------------*
-    * Matrix that defines the possible transitions from one state to another.
-    * Where a value of 1 means that a transition from 'c_currState' to
-    * 'c_nextState' is possible. Where *pc_transMap pts to the first location
-    * after the space that has been allocated
-    *------------------------------------------------------------------------*/
-   uint8_t *pc_transMap;
-
-   /*------------------------------------------------------------------------*
-    * Resources that can be shared amongst multiple users (either a global
-    * buffer or IO device) need to be protected against race conditions. We
-    * use this semaphore for just that purpose.
-    *------------------------------------------------------------------------*/
-   //t_SEMHANDLE t_mutex;
-
-}t_stMnObject;
 
 /*---------------------------------------------------------------------------*
  * Private Function Prototypes
  *---------------------------------------------------------------------------*/
-static t_LINKHNDL utl_createStMnObject( uint8_t c_numStates);
+static void utl_stMnTransition( t_stateMachine *pt_stMn,
+                                uint8_t c_from,
+                                uint8_t c_to);
 
 /*---------------------------------------------------------------------------*
  * Private Global Variables
  *---------------------------------------------------------------------------*/
 
-/*---------------------------------------------------------------------------*
- * List of currently active state-machine objects
- *---------------------------------------------------------------------------*/
-UTL_CREATE_CONTAINER( gt_stMnHndlList);
-
 /*---------------------------------------------------------------------------*
  * Inline Function Definitions
  *---------------------------------------------------------------------------*/
+static inline uint8_t __attribute__((always_inline)) \
+utl_stMnGetParent( const t_stateMachine *pt_stMn,
+                   uint8_t c_state)
+{
+   return pgm_read_byte( &pt_stMn->pt_states[c_state].c_parent);
+}/*End utl_stMnGetParent*/
 
 /*---------------------------------------------------------------------------*
- * Private Function Definitions
+ * Function pointers are copied out of program memory as raw bytes so the
+ * read doesn't depend on the size of a pointer.
  *---------------------------------------------------------------------------*/
-static t_LINKHNDL utl_createStMnObject( uint8_t c_numStates)
+static inline t_stMnAction __attribute__((always_inline)) \
+utl_stMnGetAction( const t_stMnAction *ppf_action)
 {
+   t_stMnAction pf_action;
 
-   t_LINKHNDL t_linkHndl;
-   t_linkedListError t_err;
-   int16_t s_sizeFuncMap = sizeof( funPtr_t)*(int16_t)c_numStates;
-   int16_t s_sizeTransMap = (int16_t)c_numStates*(int16_t)c_numStates;
+   memcpy_P( (void *)&pf_action,
+             (const void *)ppf_action,
+             sizeof( t_stMnAction));
 
-   /*------------------------------------------------------------------------*
-    * Allocated memory for the link (and element) that contains information
-    * specific to this particular state-machine object
-    *------------------------------------------------------------------------*/
-   t_linkHndl = utl_createLink( sizeof( t_stMnObject) + s_sizeFuncMap +
-   s_sizeTransMap);
-
-   if( t_linkHndl < 0)
-   {
-      return (t_LINKHNDL)STMN_OUT_OF_HEAP;
-   }
-
-   /*------------------------------------------------------------------------*
-    * Add the state-machine object link onto the list open state-machine
-    * objects.
-    *------------------------------------------------------------------------*/
-   t_err = utl_insertLink( gt_stMnHndlList,
-                           t_linkHndl,
-                           true);
-
-   return t_linkHndl;
+   return pf_action;
 
-}/*End utl_createStMnObject*/
+}/*End utl_stMnGetAction*/
 
 /*---------------------------------------------------------------------------*
- * Public Function Definitions
+ * Private Function Definitions
  *---------------------------------------------------------------------------*/
-t_stmnError utl_stMnChangeState( t_STMNHNDL t_handle,
-                                 int8_t c_newState,
-                                 int32_t i_stateData)
+static void utl_stMnTransition( t_stateMachine *pt_stMn,
+                                uint8_t c_from,
+                                uint8_t c_to)
 {
-   t_stMnObject *pt_stMnObject;
-   t_stmnError t_err = STMN_PASSED;
+   uint8_t ac_path[UTL_STMN_MAX_DEPTH + 1];
+   int8_t c_depth = 0;
+   int8_t c_index = 0;
+   uint8_t c_state;
+   t_stMnAction pf_action;
 
    /*------------------------------------------------------------------------*
-    * Is this a valid handle to a state-machine object?
+    * Record the chain of states from 'c_to' up to its top-level parent.
     *------------------------------------------------------------------------*/
-   if( UTL_IS_LINK_ON_LIST( (t_LINKHNDL)t_handle, gt_stMnHndlList) ==
-   false)
+   for( c_state = c_to; c_state != UTL_STMN_NO_STATE; c_state =
+   utl_stMnGetParent( pt_stMn, c_state))
    {
-      t_err = STMN_INVALID_HANDLE;
+      ac_path[c_depth++] = c_state;
    }
-   else /*Yes...*/
-   {
-      uint8_t c_row;
 
-      //arb_wait( pt_stMnObject->t_mutex, 0);
-
-      /*---------------------------------------------------------------------*
-       * Get a ptr to the link's element- which is the area where the state-
-       * machine object information is being stored.
-       *---------------------------------------------------------------------*/
-      pt_stMnObject = (t_stMnObject *)
-      UTL_GET_LINK_ELEMENT_PTR( (t_LINKHNDL)t_handle);
-
-      c_row = pt_stMnObject->c_currState;
-      if( pt_stMnObject->pc_transMap[((int16_t)c_row*(int16_t)pt_stMnObject->
-      c_numStates) + (int16_t)c_newState])
+   /*------------------------------------------------------------------------*
+    * Leave states starting at 'c_from' until we reach one that also
+    * encloses 'c_to'- that state (if there is one) stays active.
+    *------------------------------------------------------------------------*/
+   c_index = c_depth;
+   c_state = c_from;
+   while( c_state != UTL_STMN_NO_STATE)
+   {
+      for( c_index = 0; c_index < c_depth; c_index++)
       {
-         pt_stMnObject->c_nextState = c_newState;
-         pt_stMnObject->i_stateData = i_stateData;
-
+         if( ac_path[c_index] == c_state)
+            break;
       }
-      else
-         t_err = STMN_INVALID_TRANS;
 
-      //arb_signal( pt_stMnObject->t_mutex);
+      if( c_index < c_depth)
+         break;
 
-   }
+      pf_action = utl_stMnGetAction( &pt_stMn->pt_states[c_state].pf_exit);
+      if( pf_action != NULL)
+         pf_action( pt_stMn->i_stateData, c_to);
 
-   return t_err;
+      c_state = utl_stMnGetParent( pt_stMn, c_state);
 
-}/*End utl_stMnChangeState*/
+   }/*End while( c_state != UTL_STMN_NO_STATE)*/
 
-t_stmnError utl_stMnEngine( t_STMNHNDL t_handle)
-{
-   t_stMnObject *pt_stMnObject;
+   pt_stMn->c_prevState = c_from;
+   pt_stMn->c_currState = c_to;
 
    /*------------------------------------------------------------------------*
-    * Is this a valid handle to a state-machine object?
+    * Enter the states below the common parent, outermost first.
     *------------------------------------------------------------------------*/
-   if( UTL_IS_LINK_ON_LIST( (t_LINKHNDL)t_handle, gt_stMnHndlList) ==
-   false)
+   while( --c_index >= 0)
    {
-      return STMN_INVALID_HANDLE;
+      c_state = ac_path[c_index];
+      pf_action = utl_stMnGetAction( &pt_stMn->pt_states[c_state].pf_entry);
+      if( pf_action != NULL)
+         pf_action( pt_stMn->i_stateData, c_from);
    }
-   else /*Yes...*/
-   {
 
-      //arb_wait( pt_stMnObject->t_mutex, 0);
+}/*End utl_stMnTransition*/
 
-      /*---------------------------------------------------------------------*
-       * Get a ptr to the link's element- which is the area where the state-
-       * machine object information is being stored.
-       *---------------------------------------------------------------------*/
-      pt_stMnObject = (t_stMnObject *)
-      UTL_GET_LINK_ELEMENT_PTR( (t_LINKHNDL)t_handle);
-
-      /*---------------------------------------------------------------------*
-       * Update to reflect the current state...
-       *---------------------------------------------------------------------*/
-      pt_stMnObject->c_prevState = pt_stMnObject->c_currState;
-      pt_stMnObject->c_currState = pt_stMnObject->c_nextState;
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+t_stmnError utl_stMnInit( t_stateMachine *pt_stMn,
+                          const t_stMnState *pt_states,
+                          uint8_t c_numStates,
+                          uint8_t c_startState)
+{
+   uint8_t c_state;
+   uint8_t c_parent;
+   uint8_t c_depth;
 
-      /*---------------------------------------------------------------------*
-       * Call the next state to run...
-       *---------------------------------------------------------------------*/
-      pt_stMnObject->pv_funcMap[pt_stMnObject->c_nextState]( pt_stMnObject->\
-      i_stateData, pt_stMnObject->c_prevState);
+   if( (pt_stMn == NULL) || (pt_states == NULL))
+      return STMN_NULL_PTR;
 
-      //arb_signal( pt_stMnObject->t_mutex);
+   if( (c_numStates == 0) || (c_numStates > UTL_STMN_MAX_STATES) ||
+       (c_startState >= c_numStates))
+   {
+      return STMN_INVALID_STATE;
    }
 
-   return STMN_PASSED;
-
-}/*End utl_stMnEngine*/
-
-t_stmnError utl_stMnPopFunMap( t_STMNHNDL t_handle,
-                               void (*pf_funPtr)( int32_t, uint8_t),
-                               uint8_t c_state)
-{
-   t_stMnObject *pt_stMnObject;
+   pt_stMn->pt_states   = pt_states;
+   pt_stMn->c_numStates = c_numStates;
 
    /*------------------------------------------------------------------------*
-    * Since we are about to act on global variables, protect this region
-    * of code against higher priority threads interrupting us while we are
-    * trying to register.
+    * Make sure the state hierarchy is well formed, a loop in the parent
+    * chain shows up as a state that is nested too deep.
     *------------------------------------------------------------------------*/
-   HAL_BEGIN_CRITICAL();
-
-   /*------------------------------------------------------------------------*
-    * Is this a valid handle to a state-machine object?
-    *------------------------------------------------------------------------*/
-   if( UTL_IS_LINK_ON_LIST( (t_LINKHNDL)t_handle, gt_stMnHndlList) ==
-   false)
+   for( c_state = 0; c_state < c_numStates; c_state++)
    {
-      HAL_END_CRITICAL();//Enable interrupts
-      return STMN_INVALID_HANDLE;
-   }
-   else /*Yes...*/
-   {
-      /*---------------------------------------------------------------------*
-       * Get a ptr to the link's element- which is the area where the state-
-       * machine object information is being stored.
-       *---------------------------------------------------------------------*/
-      pt_stMnObject = (t_stMnObject *)
-      UTL_GET_LINK_ELEMENT_PTR( (t_LINKHNDL)t_handle);
-
-      if( c_state >= pt_stMnObject->c_numStates)
+      c_depth  = 0;
+      c_parent = utl_stMnGetParent( pt_stMn, c_state);
+
+      while( c_parent != UTL_STMN_NO_STATE)
       {
-         HAL_END_CRITICAL();//Enable interrupts
-         return STMN_INVALID_STATE;
-      }
+         c_depth++;
+         if( (c_parent >= c_numStates) || (c_depth > UTL_STMN_MAX_DEPTH))
+         {
+            pt_stMn->pt_states = NULL;
+            return STMN_INVALID_STATE;
+         }
 
-      /*---------------------------------------------------------------------*
-       * Store the call-back function for this particular state.
-       *---------------------------------------------------------------------*/
-      pt_stMnObject->pv_funcMap[c_state] = pf_funPtr;
+         c_parent = utl_stMnGetParent( pt_stMn, c_parent);
 
-   }
+      }/*End while( c_parent != UTL_STMN_NO_STATE)*/
+
+   }/*End for( c_state = 0; c_state < c_numStates; c_state++)*/
+
+   pt_stMn->c_nextState = c_startState;
+   /*------------------------------------------------------------------------*
+    * We aren't in a valid state as of yet, so initialize to an unknown
+    * state...
+    *------------------------------------------------------------------------*/
+   pt_stMn->c_currState = UTL_STMN_NO_STATE;
+   pt_stMn->c_prevState = UTL_STMN_NO_STATE;
+   pt_stMn->i_stateData = 0;
 
-   HAL_END_CRITICAL();//Enable interrupts
    return STMN_PASSED;
 
-}/*End utl_stMnPopFunMap*/
+}/*End utl_stMnInit*/
 
-t_stmnError utl_stMnPopTransMap( t_STMNHNDL t_handle,
-                                 uint8_t *pc_transMap)
+t_stmnError utl_stMnChangeState( t_stateMachine *pt_stMn,
+                                 uint8_t c_newState,
+                                 int32_t i_stateData)
 {
-   t_stMnObject *pt_stMnObject;
-   uint8_t c_row;
-   uint8_t c_col;
+   uint8_t c_state;
+   uint32_t i_transMask;
 
-   /*------------------------------------------------------------------------*
-    * Since we are about to act on global variables, protect this region
-    * of code against higher priority threads interrupting us while we are
-    * trying to register.
-    *------------------------------------------------------------------------*/
-   HAL_BEGIN_CRITICAL();
+   if( pt_stMn->pt_states == NULL)
+      return STMN_NULL_PTR;
+
+   if( c_newState >= pt_stMn->c_numStates)
+      return STMN_INVALID_STATE;
+
+   c_state = pt_stMn->c_currState;
 
    /*------------------------------------------------------------------------*
-    * Is this a valid handle to a state-machine object?
+    * Until the engine has run once any state can be requested, otherwise
+    * search the current state and its parents for a matching rule.
     *------------------------------------------------------------------------*/
-   if( UTL_IS_LINK_ON_LIST( (t_LINKHNDL)t_handle, gt_stMnHndlList) ==
-   false)
-   {
-      HAL_END_CRITICAL();//Enable interrupts
-      return STMN_INVALID_HANDLE;
-   }
-   else /*Yes...*/
+   if( c_state != UTL_STMN_NO_STATE)
    {
-      /*---------------------------------------------------------------------*
-       * Get a ptr to the link's element- which is the area where the state-
-       * machine object information is being stored.
-       *---------------------------------------------------------------------*/
-      pt_stMnObject = (t_stMnObject *)
-      UTL_GET_LINK_ELEMENT_PTR( (t_LINKHNDL)t_handle);
-
-      for( c_row = 0; c_row < pt_stMnObject->c_numStates; c_row++)
+      do
       {
-         for( c_col = 0; c_col < pt_stMnObject->c_numStates; c_col++)
-         {
-            pt_stMnObject->pc_transMap[((int16_t)c_row*(int16_t)pt_stMnObject->
-            c_numStates) + (int16_t)c_col] = pc_transMap[((int16_t)c_row*
-            (int16_t)pt_stMnObject->c_numStates) + (int16_t)c_col];
-         }
-      }
+         i_transMask = pgm_read_dword( &pt_stMn->pt_states[c_state].
+         i_transMask);
 
-   }
+         if( i_transMask & UTL_STMN_TRANS( c_newState))
+            break;
 
-   HAL_END_CRITICAL();//Enable interrupts
-   return STMN_PASSED;
+         c_state = utl_stMnGetParent( pt_stMn, c_state);
 
-}/*End utl_stMnPopTransMap*/
+      }while( c_state != UTL_STMN_NO_STATE);
 
-t_STMNHNDL utl_requestStMnObject( uint8_t c_numStates,
-                                  uint8_t c_startingState)
-{
-   t_stMnObject *pt_stMnObject;
-   t_LINKHNDL t_linkHndl;
+      if( c_state == UTL_STMN_NO_STATE)
+         return STMN_INVALID_TRANS;
 
-   /*------------------------------------------------------------------------*
-    * Since we are about to act on global variables, protect this region
-    * of code against higher priority threads interrupting us while we are
-    * trying to register.
-    *------------------------------------------------------------------------*/
-   HAL_BEGIN_CRITICAL();
+   }/*End if( c_state != UTL_STMN_NO_STATE)*/
 
-   if( c_startingState >= c_numStates)
-   {
-      HAL_END_CRITICAL();//Enable interrupts
-      return (t_STMNHNDL)STMN_INVALID_STATE;
-   }
+   pt_stMn->c_nextState = c_newState;
+   pt_stMn->i_stateData = i_stateData;
 
-   t_linkHndl = utl_createStMnObject( c_numStates);
-   if( t_linkHndl < 0)
-   {
-      HAL_END_CRITICAL();//Enable interrupts
-      return (t_STMNHNDL)STMN_OUT_OF_HEAP;
-   }
+   return STMN_PASSED;
 
-   /*------------------------------------------------------------------------*
-    * Get a ptr to the link's element- which is the area where the state-
-    * machine object information is being stored.
-    *------------------------------------------------------------------------*/
-   pt_stMnObject = (t_stMnObject *)UTL_GET_LINK_ELEMENT_PTR( t_linkHndl);
+}/*End utl_stMnChangeState*/
 
-   /*------------------------------------------------------------------------*
-    * Clear the state-machine object.
-    *------------------------------------------------------------------------*/
-   memset( (void *)pt_stMnObject, 0, sizeof( t_stMnObject));
+t_stmnError utl_stMnEngine( t_stateMachine *pt_stMn)
+{
+   uint8_t c_nextState;
+   uint8_t c_state;
+   t_stMnAction pf_run;
 
-//    pt_stMnObject->t_mutex = arb_semaphoreCreate( MUTEX);
-// 
-//    if( pt_stMnObject->t_mutex < 0)
-//    {
-//       utl_releaseStMnObject( t_linkHndl);
-//       HAL_END_CRITICAL();//Enable interrupts
-//       return (t_STMNHNDL)STMN_OUT_OF_HEAP;
-//    }
+   if( pt_stMn->pt_states == NULL)
+      return STMN_NULL_PTR;
 
-   /*------------------------------------------------------------------------*
-    * Point to the location of the function ptr buffer which starts
-    * immediately after the transition map ptr.
-    *------------------------------------------------------------------------*/
-   pt_stMnObject->pv_funcMap = (funPtr_t *)(&pt_stMnObject->pv_funcMap + 2);
+   c_nextState = pt_stMn->c_nextState;
 
    /*------------------------------------------------------------------------*
-    * Point to the location of the translation buffer which starts
-    * immediately after the function ptr buffer.
+    * Update to reflect the current state...
     *------------------------------------------------------------------------*/
-   pt_stMnObject->pc_transMap = (uint8_t *)(&pt_stMnObject->pv_funcMap + 2
-   + (int16_t)c_numStates);
+   if( c_nextState != pt_stMn->c_currState)
+   {
+      utl_stMnTransition( pt_stMn,
+                          pt_stMn->c_currState,
+                          c_nextState);
+   }
+   else
+      pt_stMn->c_prevState = pt_stMn->c_currState;
 
-   pt_stMnObject->c_numStates = c_numStates;
-   pt_stMnObject->c_nextState = c_startingState;
-   pt_stMnObject->c_currState = c_numStates;
    /*------------------------------------------------------------------------*
-    * We are in a valid state as of yet, so initialize to an unknown state...
+    * Call the next state to run, or the closest parent that has a run
+    * action...
     *------------------------------------------------------------------------*/
-   pt_stMnObject->c_prevState = c_numStates;
-
-   HAL_END_CRITICAL();//Enable interrupts
-
-   return (t_STMNHNDL)t_linkHndl;
+   c_state = c_nextState;
+   do
+   {
+      pf_run = utl_stMnGetAction( &pt_stMn->pt_states[c_state].pf_run);
+      if( pf_run != NULL)
+      {
+         pf_run( pt_stMn->i_stateData,
+                 pt_stMn->c_prevState);
+         break;
+      }
 
-}/*End utl_requestStMnObject*/
+      c_state = utl_stMnGetParent( pt_stMn, c_state);
 
-t_stmnError utl_releaseStMnObject( t_STMNHNDL t_handle)
-{
-
-   if( utl_destroyLink( gt_stMnHndlList, (t_LINKHNDL)t_handle) < 0)
-      return STMN_INVALID_HANDLE;
+   }while( c_state != UTL_STMN_NO_STATE);
 
    return STMN_PASSED;
 
-}/*End utl_releaseStMnObject*/
-
+}/*End utl_stMnEngine*/
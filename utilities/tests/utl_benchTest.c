@@ -0,0 +1,385 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_benchTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of utl_bench. The case spins on the cycle counter
+ *               for a shuffled set of lengths and records how long each call
+ *               really took, so the min, median and max the harness reports
+ *               can be checked against the same statistics worked out here,
+ *               even on a loaded machine where the spins get stretched. Also
+ *               checks the warmup and iteration counts passed to the case,
+ *               the exact CSV text the format functions produce, and every
+ *               error return.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include "hal_clocks.h"
+#include "utl_bench.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Cycles between the spin lengths.
+ *---------------------------------------------------------------------------*/
+#define TEST_STEP      (1000000UL)
+#define TEST_MAX_CALLS (UTL_BENCH_MAX_SAMPLES + 8)
+
+/*---------------------------------------------------------------------------*
+ * How far a reported figure may be from the spin it came from. Covers the
+ * call into the case and the few cycles on either side of the spin's own
+ * timing, but not a context switch landing right there.
+ *---------------------------------------------------------------------------*/
+#define TEST_SLACK     (200000UL)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   /*------------------------------------------------------------------------*
+    * Cycles to spin for on each call, in call order.
+    *------------------------------------------------------------------------*/
+   uint32_t ai_spin[TEST_MAX_CALLS];
+
+   /*------------------------------------------------------------------------*
+    * Cycles each call actually took.
+    *------------------------------------------------------------------------*/
+   uint32_t ai_took[TEST_MAX_CALLS];
+
+   uint8_t c_calls;
+
+   /*------------------------------------------------------------------------*
+    * Set if any call was passed an iteration count other than 's_expect'.
+    *------------------------------------------------------------------------*/
+   uint16_t s_expect;
+   bool b_badIterations;
+
+}t_spinCase;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void testSpin( void *pv_arg,
+                      uint16_t s_iterations);
+static bool near( uint32_t i_value,
+                  uint32_t i_expect);
+static void testStatistics( uint8_t c_warmup,
+                            const uint8_t *pc_order,
+                            uint8_t c_samples);
+static void testFormat( void);
+static void testErrors( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void testSpin( void *pv_arg,
+                      uint16_t s_iterations)
+{
+   t_spinCase *pt_spin = (t_spinCase *)pv_arg;
+   uint32_t i_start = hal_getCycleCount();
+   uint32_t i_cycles = 0;
+
+   if( s_iterations != pt_spin->s_expect)
+      pt_spin->b_badIterations = true;
+
+   if( pt_spin->c_calls < TEST_MAX_CALLS)
+      i_cycles = pt_spin->ai_spin[pt_spin->c_calls];
+
+   while( (hal_getCycleCount() - i_start) < i_cycles);
+
+   if( pt_spin->c_calls < TEST_MAX_CALLS)
+      pt_spin->ai_took[pt_spin->c_calls] = hal_getCycleCount() - i_start;
+
+   pt_spin->c_calls++;
+
+}/*End testSpin*/
+
+static bool near( uint32_t i_value,
+                  uint32_t i_expect)
+{
+   return (bool)((i_value + TEST_SLACK >= i_expect) && (i_value <= i_expect
+   + TEST_SLACK));
+
+}/*End near*/
+
+/*---------------------------------------------------------------------------*
+ * Sample 'n' spins for 'pc_order[n]' steps. The warmup calls spin for ten
+ * steps, so keeping one of them would show up as the max.
+ *---------------------------------------------------------------------------*/
+static void testStatistics( uint8_t c_warmup,
+                            const uint8_t *pc_order,
+                            uint8_t c_samples)
+{
+   t_spinCase t_spin;
+   t_benchCase t_case;
+   t_benchResult t_result;
+   uint32_t ai_sorted[UTL_BENCH_MAX_SAMPLES];
+   uint32_t i_took;
+   uint32_t i_median;
+   uint8_t c_index;
+   uint8_t c_pos;
+
+   memset( (void *)&t_spin, 0, sizeof( t_spin));
+   for( c_index = 0; c_index < c_warmup; c_index++)
+      t_spin.ai_spin[c_index] = 10*TEST_STEP;
+   for( c_index = 0; c_index < c_samples; c_index++)
+      t_spin.ai_spin[c_warmup + c_index] = pc_order[c_index]*TEST_STEP;
+
+   t_spin.s_expect = 3;
+
+   t_case.pc_name      = "spin";
+   t_case.pf_run       = &testSpin;
+   t_case.pv_arg       = &t_spin;
+   t_case.s_iterations = 3;
+   t_case.c_warmup     = c_warmup;
+   t_case.c_samples    = c_samples;
+
+   UTL_TEST_CHECK( utl_benchRun( &t_case, &t_result) == BENCH_PASSED,
+                   "run refused");
+   UTL_TEST_CHECK( t_spin.c_calls == (c_warmup + c_samples),
+                   "%u calls for %u warmup and %u samples",
+                   t_spin.c_calls,
+                   c_warmup,
+                   c_samples);
+   UTL_TEST_CHECK( t_spin.b_badIterations == false,
+                   "case passed the wrong iteration count");
+   UTL_TEST_CHECK( (t_result.s_iterations == 3) &&
+                   (t_result.c_samples == c_samples),
+                   "result holds %u iterations, %u samples",
+                   t_result.s_iterations,
+                   t_result.c_samples);
+
+   UTL_TEST_CHECK( (t_result.i_min <= t_result.i_median) &&
+                   (t_result.i_median <= t_result.i_max),
+                   "min %lu median %lu max %lu out of order",
+                   (unsigned long)t_result.i_min,
+                   (unsigned long)t_result.i_median,
+                   (unsigned long)t_result.i_max);
+
+   /*------------------------------------------------------------------------*
+    * The reference statistics, from the times the sampled calls recorded
+    * themselves. An even count averages the two middle samples.
+    *------------------------------------------------------------------------*/
+   for( c_index = 0; c_index < c_samples; c_index++)
+   {
+      i_took = t_spin.ai_took[c_warmup + c_index];
+      for( c_pos = c_index; (c_pos > 0) && (ai_sorted[c_pos - 1] > i_took);
+      c_pos--)
+      {
+         ai_sorted[c_pos] = ai_sorted[c_pos - 1];
+      }
+
+      ai_sorted[c_pos] = i_took;
+   }
+
+   if( c_samples & 1)
+      i_median = ai_sorted[c_samples >> 1];
+   else
+      i_median = (uint32_t)(((uint64_t)ai_sorted[(c_samples >> 1) - 1] +
+      ai_sorted[c_samples >> 1]) / 2);
+
+   UTL_TEST_CHECK( near( t_result.i_min, ai_sorted[0]),
+                   "min %lu, calls took at least %lu",
+                   (unsigned long)t_result.i_min,
+                   (unsigned long)ai_sorted[0]);
+   UTL_TEST_CHECK( near( t_result.i_median, i_median),
+                   "median %lu, calls took a median of %lu",
+                   (unsigned long)t_result.i_median,
+                   (unsigned long)i_median);
+   UTL_TEST_CHECK( near( t_result.i_max, ai_sorted[c_samples - 1]),
+                   "max %lu, calls took at most %lu",
+                   (unsigned long)t_result.i_max,
+                   (unsigned long)ai_sorted[c_samples - 1]);
+
+}/*End testStatistics*/
+
+static void testFormat( void)
+{
+   t_benchCase t_case;
+   t_benchResult t_result;
+   char ac_buff[UTL_BENCH_LINE_BYTES];
+   char ac_expect[UTL_BENCH_LINE_BYTES];
+   int16_t s_length;
+
+   s_length = utl_benchFormatHeader( ac_buff, sizeof( ac_buff));
+   snprintf( ac_expect,
+             sizeof( ac_expect),
+             "#hz,%lu\n\r#name,iterations,samples,min,median,max\n\r",
+             (unsigned long)hal_getCycleCounterFreq());
+   UTL_TEST_CHECK( (s_length == (int16_t)strlen( ac_expect)) &&
+                   (strcmp( ac_buff, ac_expect) == 0),
+                   "header '%s'",
+                   ac_buff);
+
+   /*------------------------------------------------------------------------*
+    * Per iteration figures rounded to the nearest tenth, halves round up
+    * and the rounding can carry into the whole cycles.
+    *------------------------------------------------------------------------*/
+   memset( (void *)&t_case, 0, sizeof( t_case));
+   t_case.pc_name        = "mailbox";
+   t_result.i_min        = 1234;
+   t_result.i_median     = 1235;
+   t_result.i_max        = 1999;
+   t_result.i_overhead   = 40;
+   t_result.s_iterations = 100;
+   t_result.c_samples    = 9;
+
+   s_length = utl_benchFormatResult( &t_case,
+                                     &t_result,
+                                     ac_buff,
+                                     sizeof( ac_buff));
+   UTL_TEST_CHECK( (s_length == 30) &&
+                   (strcmp( ac_buff, "mailbox,100,9,12.3,12.4,20.0\n\r")
+                   == 0),
+                   "result '%s'",
+                   ac_buff);
+
+   /*------------------------------------------------------------------------*
+    * Long names are cut at UTL_BENCH_MAX_NAME, and the largest counts
+    * still fit in the smallest buffer allowed.
+    *------------------------------------------------------------------------*/
+   t_case.pc_name        = "abcdefghijklmnopqrstuvwxyz0123456789";
+   t_result.i_min        = 0;
+   t_result.i_median     = 0xFFFFFFFF;
+   t_result.i_max        = 0xFFFFFFFF;
+   t_result.s_iterations = 1;
+   t_result.c_samples    = UTL_BENCH_MAX_SAMPLES;
+
+   s_length = utl_benchFormatResult( &t_case,
+                                     &t_result,
+                                     ac_buff,
+                                     UTL_BENCH_LINE_BYTES);
+   snprintf( ac_expect,
+             sizeof( ac_expect),
+             "%.*s,1,%u,0.0,4294967295.0,4294967295.0\n\r",
+             UTL_BENCH_MAX_NAME,
+             t_case.pc_name,
+             UTL_BENCH_MAX_SAMPLES);
+   UTL_TEST_CHECK( (s_length == (int16_t)strlen( ac_expect)) &&
+                   (strcmp( ac_buff, ac_expect) == 0),
+                   "long result '%s'",
+                   ac_buff);
+
+}/*End testFormat*/
+
+static void testErrors( void)
+{
+   t_spinCase t_spin;
+   t_benchCase t_case;
+   t_benchResult t_result;
+   char ac_buff[UTL_BENCH_LINE_BYTES];
+
+   memset( (void *)&t_spin, 0, sizeof( t_spin));
+   t_spin.s_expect = 1;
+
+   t_case.pc_name      = "errors";
+   t_case.pf_run       = &testSpin;
+   t_case.pv_arg       = &t_spin;
+   t_case.s_iterations = 1;
+   t_case.c_warmup     = 0;
+   t_case.c_samples    = 1;
+
+   UTL_TEST_CHECK( utl_benchRun( NULL, &t_result) == BENCH_NULL_PTR,
+                   "NULL case accepted");
+   UTL_TEST_CHECK( utl_benchRun( &t_case, NULL) == BENCH_NULL_PTR,
+                   "NULL result accepted");
+
+   t_case.pf_run = NULL;
+   UTL_TEST_CHECK( utl_benchRun( &t_case, &t_result) == BENCH_NULL_PTR,
+                   "NULL run function accepted");
+   t_case.pf_run = &testSpin;
+
+   t_case.c_samples = 0;
+   UTL_TEST_CHECK( utl_benchRun( &t_case, &t_result) ==
+                   BENCH_INVALID_SAMPLES,
+                   "0 samples accepted");
+
+   t_case.c_samples = UTL_BENCH_MAX_SAMPLES + 1;
+   UTL_TEST_CHECK( utl_benchRun( &t_case, &t_result) ==
+                   BENCH_INVALID_SAMPLES,
+                   "%u samples accepted",
+                   UTL_BENCH_MAX_SAMPLES + 1);
+
+   t_case.c_samples    = 1;
+   t_case.s_iterations = 0;
+   UTL_TEST_CHECK( utl_benchRun( &t_case, &t_result) ==
+                   BENCH_INVALID_SAMPLES,
+                   "0 iterations accepted");
+
+   UTL_TEST_CHECK( t_spin.c_calls == 0,
+                   "case called %u times by rejected runs",
+                   t_spin.c_calls);
+
+   t_case.s_iterations = 1;
+   t_case.c_samples    = UTL_BENCH_MAX_SAMPLES;
+   UTL_TEST_CHECK( utl_benchRun( &t_case, &t_result) == BENCH_PASSED,
+                   "%u samples refused",
+                   UTL_BENCH_MAX_SAMPLES);
+
+   UTL_TEST_CHECK( utl_benchFormatHeader( NULL, sizeof( ac_buff)) ==
+                   BENCH_NULL_PTR,
+                   "header into NULL accepted");
+   UTL_TEST_CHECK( utl_benchFormatHeader( ac_buff, UTL_BENCH_LINE_BYTES -
+                   1) == BENCH_BUFFER_TOO_SMALL,
+                   "short header buffer accepted");
+   UTL_TEST_CHECK( utl_benchFormatResult( &t_case, &t_result, NULL,
+                   sizeof( ac_buff)) == BENCH_NULL_PTR,
+                   "result into NULL accepted");
+   UTL_TEST_CHECK( utl_benchFormatResult( NULL, &t_result, ac_buff,
+                   sizeof( ac_buff)) == BENCH_NULL_PTR,
+                   "NULL case formatted");
+   UTL_TEST_CHECK( utl_benchFormatResult( &t_case, &t_result, ac_buff,
+                   UTL_BENCH_LINE_BYTES - 1) == BENCH_BUFFER_TOO_SMALL,
+                   "short result buffer accepted");
+
+}/*End testErrors*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   static const uint8_t ac_odd[]  = {5, 1, 7, 3, 6, 2, 4};
+   static const uint8_t ac_even[] = {6, 2, 5, 1, 3, 4};
+   static const uint8_t ac_one[]  = {1};
+
+   UTL_TEST_CHECK( utl_benchInit() == BENCH_PASSED, "init refused");
+
+   testStatistics( 2, ac_odd, sizeof( ac_odd));
+   testStatistics( 0, ac_even, sizeof( ac_even));
+   testStatistics( 1, ac_one, sizeof( ac_one));
+   testFormat();
+   testErrors();
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
@@ -0,0 +1,487 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_bufferTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of utl_buffer. Random sequences of byte, block
+ *               and span operations are run against utl_buffer and a plain
+ *               modulo ring at the same time, and the data, fill levels and
+ *               span lengths of the two must agree after every step. Buffer
+ *               sizes that aren't a power of two are included since the
+ *               indices wrap by comparison rather than by masking.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include "utl_buffer.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_MAX_BUFFER (1024)
+#define TEST_STEPS      (50000)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The reference, a ring that keeps a separate count and wraps with '%'.
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   int8_t ac_data[TEST_MAX_BUFFER];
+   uint32_t i_size;
+   uint32_t i_head;
+   uint32_t i_count;
+
+}t_refBuffer;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void refWrite( t_refBuffer *pt_ref,
+                      int8_t c_byte);
+static int8_t refRead( t_refBuffer *pt_ref);
+static void refEraseTail( t_refBuffer *pt_ref);
+static void checkLevels( t_buffer *pt_buffer,
+                         t_refBuffer *pt_ref,
+                         uint32_t i_step);
+static void testEdges( uint16_t s_size);
+static void testRandom( uint16_t s_size,
+                        uint16_t s_start,
+                        uint32_t i_steps);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static int8_t gac_storage[TEST_MAX_BUFFER];
+static int8_t gac_block[TEST_MAX_BUFFER];
+static t_refBuffer gt_ref;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void refWrite( t_refBuffer *pt_ref,
+                      int8_t c_byte)
+{
+   pt_ref->ac_data[(pt_ref->i_head + pt_ref->i_count) % pt_ref->i_size] =
+   c_byte;
+   pt_ref->i_count++;
+
+}/*End refWrite*/
+
+static int8_t refRead( t_refBuffer *pt_ref)
+{
+   int8_t c_byte = pt_ref->ac_data[pt_ref->i_head];
+
+   pt_ref->i_head = (pt_ref->i_head + 1) % pt_ref->i_size;
+   pt_ref->i_count--;
+
+   return c_byte;
+
+}/*End refRead*/
+
+static void refEraseTail( t_refBuffer *pt_ref)
+{
+   pt_ref->i_count--;
+   pt_ref->ac_data[(pt_ref->i_head + pt_ref->i_count) % pt_ref->i_size] = 0;
+
+}/*End refEraseTail*/
+
+static void checkLevels( t_buffer *pt_buffer,
+                         t_refBuffer *pt_ref,
+                         uint32_t i_step)
+{
+   UTL_TEST_CHECK( utl_getBufferFullLevel( pt_buffer) ==
+                   (int16_t)pt_ref->i_count,
+                   "step %u: full level %d, expected %u",
+                   i_step,
+                   utl_getBufferFullLevel( pt_buffer),
+                   pt_ref->i_count);
+   UTL_TEST_CHECK( utl_getBufferEmptyLevel( pt_buffer) ==
+                   (int16_t)(pt_ref->i_size - pt_ref->i_count),
+                   "step %u: empty level %d, expected %u",
+                   i_step,
+                   utl_getBufferEmptyLevel( pt_buffer),
+                   pt_ref->i_size - pt_ref->i_count);
+   UTL_TEST_CHECK( utl_isBufferEmpty( pt_buffer) == (pt_ref->i_count == 0),
+                   "step %u: empty flag",
+                   i_step);
+   UTL_TEST_CHECK( utl_isBufferFull( pt_buffer) == (pt_ref->i_count ==
+                   pt_ref->i_size),
+                   "step %u: full flag",
+                   i_step);
+   UTL_TEST_CHECK( (utl_hasBufferOverflowed( pt_buffer) == false) &&
+                   (utl_hasBufferUnderflowed( pt_buffer) == false),
+                   "step %u: over/underflow flagged",
+                   i_step);
+
+}/*End checkLevels*/
+
+static void testEdges( uint16_t s_size)
+{
+   t_buffer t_buffer;
+   int8_t *pc_span;
+   uint16_t s_index;
+   uint16_t s_span;
+
+   memset( gac_storage, 0x55, sizeof( gac_storage));
+   UTL_TEST_CHECK( utl_initBuffer( &t_buffer, gac_storage, s_size) ==
+                   BUFFER_PASSED,
+                   "size %u: init failed",
+                   s_size);
+   UTL_TEST_CHECK( (gac_storage[0] == 0) && (gac_storage[s_size - 1] == 0)
+                   && (gac_storage[s_size] == 0x55),
+                   "size %u: init cleared the wrong bytes",
+                   s_size);
+
+   /*------------------------------------------------------------------------*
+    * Empty, there is nothing to read and all of it can be written.
+    *------------------------------------------------------------------------*/
+   s_span = utl_getBufferReadSpan( &t_buffer, &pc_span);
+   UTL_TEST_CHECK( (s_span == 0) && (pc_span == gac_storage),
+                   "size %u: read span %u on an empty buffer",
+                   s_size,
+                   s_span);
+   s_span = utl_getBufferWriteSpan( &t_buffer, &pc_span);
+   UTL_TEST_CHECK( (s_span == s_size) && (pc_span == gac_storage),
+                   "size %u: write span %u on an empty buffer",
+                   s_size,
+                   s_span);
+
+   /*------------------------------------------------------------------------*
+    * Filled through the span in one go, the buffer is full and wraps the
+    * write index back to the start.
+    *------------------------------------------------------------------------*/
+   for( s_index = 0; s_index < s_size; s_index++)
+      pc_span[s_index] = (int8_t)s_index;
+   utl_commitBufferWrite( &t_buffer, s_size);
+
+   UTL_TEST_CHECK( utl_isBufferFull( &t_buffer) == true,
+                   "size %u: not full",
+                   s_size);
+   UTL_TEST_CHECK( utl_getBufferWriteSpan( &t_buffer, &pc_span) == 0,
+                   "size %u: write span on a full buffer",
+                   s_size);
+   UTL_TEST_CHECK( t_buffer.s_wrIndex == 0,
+                   "size %u: write index %d after filling",
+                   s_size,
+                   t_buffer.s_wrIndex);
+
+   s_span = utl_getBufferReadSpan( &t_buffer, &pc_span);
+   UTL_TEST_CHECK( (s_span == s_size) && (pc_span == gac_storage),
+                   "size %u: read span %u on a full buffer",
+                   s_size,
+                   s_span);
+
+   utl_readBlock( &t_buffer, gac_block, s_size);
+   for( s_index = 0; s_index < s_size; s_index++)
+   {
+      UTL_TEST_CHECK( gac_block[s_index] == (int8_t)s_index,
+                      "size %u: byte %u out of order",
+                      s_size,
+                      s_index);
+   }
+
+   UTL_TEST_CHECK( (utl_isBufferEmpty( &t_buffer) == true) &&
+                   (t_buffer.s_rdIndex == 0),
+                   "size %u: not empty after draining",
+                   s_size);
+
+   /*------------------------------------------------------------------------*
+    * Erasing the tail gives back the byte just written and clears it.
+    *------------------------------------------------------------------------*/
+   if( s_size > 1)
+   {
+      utl_writeByte( &t_buffer, 0x11);
+      utl_writeByte( &t_buffer, 0x22);
+      utl_buffEraseTailByte( &t_buffer);
+      UTL_TEST_CHECK( (utl_getBufferFullLevel( &t_buffer) == 1) &&
+                      (t_buffer.s_wrIndex == 1) && (gac_storage[1] == 0),
+                      "size %u: erase after a write",
+                      s_size);
+      UTL_TEST_CHECK( utl_readByte( &t_buffer) == 0x11,
+                      "size %u: read after an erase",
+                      s_size);
+   }
+
+   /*------------------------------------------------------------------------*
+    * A byte written into the last slot wraps the write index to 0, erasing
+    * it has to step back to the end of the storage.
+    *------------------------------------------------------------------------*/
+   utl_resetBuffer( &t_buffer);
+   utl_commitBufferWrite( &t_buffer, s_size - 1);
+   utl_commitBufferRead( &t_buffer, s_size - 1);
+   utl_writeByte( &t_buffer, 0x44);
+   UTL_TEST_CHECK( t_buffer.s_wrIndex == 0,
+                   "size %u: write into the last slot didn't wrap",
+                   s_size);
+   utl_buffEraseTailByte( &t_buffer);
+   UTL_TEST_CHECK( (utl_isBufferEmpty( &t_buffer) == true) &&
+                   (t_buffer.s_wrIndex == (int16_t)(s_size - 1)) &&
+                   (gac_storage[s_size - 1] == 0),
+                   "size %u: erase across the end moved the write index to "
+                   "%d",
+                   s_size,
+                   t_buffer.s_wrIndex);
+
+}/*End testEdges*/
+
+static void testRandom( uint16_t s_size,
+                        uint16_t s_start,
+                        uint32_t i_steps)
+{
+   t_buffer t_buffer;
+   int8_t *pc_span;
+   uint32_t i_step;
+   uint32_t i_wrIndex;
+   uint32_t i_expect;
+   uint16_t s_req;
+   uint16_t s_got;
+   uint16_t s_index;
+   int i_failures = gi_testFailures;
+
+   utl_initBuffer( &t_buffer, gac_storage, s_size);
+
+   /*------------------------------------------------------------------------*
+    * Move both indices to 's_start' so the first wrap comes early.
+    *------------------------------------------------------------------------*/
+   utl_commitBufferWrite( &t_buffer, s_start);
+   utl_commitBufferRead( &t_buffer, s_start);
+
+   gt_ref.i_size  = s_size;
+   gt_ref.i_head  = s_start;
+   gt_ref.i_count = 0;
+
+   for( i_step = 0; i_step < i_steps; i_step++)
+   {
+      i_wrIndex = (gt_ref.i_head + gt_ref.i_count) % s_size;
+
+      switch( utl_testRand() % 7)
+      {
+         case 0:
+
+            /*---------------------------------------------------------------*
+             * The block functions don't clamp, the caller checks the level
+             * first.
+             *---------------------------------------------------------------*/
+            s_req = (uint16_t)(utl_testRand() % (s_size - gt_ref.i_count +
+            1));
+
+            for( s_index = 0; s_index < s_req; s_index++)
+            {
+               gac_block[s_index] = (int8_t)utl_testRand();
+               refWrite( &gt_ref, gac_block[s_index]);
+            }
+
+            utl_writeBlock( &t_buffer, gac_block, s_req);
+
+         break;/*End case 0:*/
+
+         case 1:
+
+            s_req = (uint16_t)(utl_testRand() % (gt_ref.i_count + 1));
+
+            utl_readBlock( &t_buffer, gac_block, s_req);
+
+            for( s_index = 0; s_index < s_req; s_index++)
+            {
+               UTL_TEST_CHECK( gac_block[s_index] == refRead( &gt_ref),
+                               "step %u: block read data at %u",
+                               i_step,
+                               s_index);
+            }
+
+         break;/*End case 1:*/
+
+         case 2:
+
+            /*---------------------------------------------------------------*
+             * The span runs to the end of the storage or the first byte in
+             * use, whichever is closer.
+             *---------------------------------------------------------------*/
+            i_expect = s_size - i_wrIndex;
+            if( i_expect > (s_size - gt_ref.i_count))
+               i_expect = s_size - gt_ref.i_count;
+
+            s_got = utl_getBufferWriteSpan( &t_buffer, &pc_span);
+            UTL_TEST_CHECK( (s_got == i_expect) && (pc_span ==
+                            &gac_storage[i_wrIndex]),
+                            "step %u: write span %u, expected %u",
+                            i_step,
+                            s_got,
+                            i_expect);
+
+            /*---------------------------------------------------------------*
+             * Commit part of it, as a DMA transfer that stopped early would.
+             *---------------------------------------------------------------*/
+            if( s_got > 0)
+            {
+               s_got = (uint16_t)(utl_testRand() % (s_got + 1));
+               for( s_index = 0; s_index < s_got; s_index++)
+               {
+                  pc_span[s_index] = (int8_t)utl_testRand();
+                  refWrite( &gt_ref, pc_span[s_index]);
+               }
+
+               utl_commitBufferWrite( &t_buffer, s_got);
+            }
+
+         break;/*End case 2:*/
+
+         case 3:
+
+            i_expect = s_size - gt_ref.i_head;
+            if( i_expect > gt_ref.i_count)
+               i_expect = gt_ref.i_count;
+
+            s_got = utl_getBufferReadSpan( &t_buffer, &pc_span);
+            UTL_TEST_CHECK( (s_got == i_expect) && (pc_span ==
+                            &gac_storage[gt_ref.i_head]),
+                            "step %u: read span %u, expected %u",
+                            i_step,
+                            s_got,
+                            i_expect);
+
+            if( s_got > 0)
+            {
+               s_got = (uint16_t)(utl_testRand() % (s_got + 1));
+               for( s_index = 0; s_index < s_got; s_index++)
+               {
+                  UTL_TEST_CHECK( pc_span[s_index] == refRead( &gt_ref),
+                                  "step %u: read span data at %u",
+                                  i_step,
+                                  s_index);
+               }
+
+               utl_commitBufferRead( &t_buffer, s_got);
+            }
+
+         break;/*End case 3:*/
+
+         case 4:
+
+            if( gt_ref.i_count < s_size)
+            {
+               gac_block[0] = (int8_t)utl_testRand();
+               utl_writeByte( &t_buffer, gac_block[0]);
+               refWrite( &gt_ref, gac_block[0]);
+            }
+
+         break;/*End case 4:*/
+
+         case 5:
+
+            /*---------------------------------------------------------------*
+             * Take a byte from either end.
+             *---------------------------------------------------------------*/
+            if( gt_ref.i_count > 0)
+            {
+               if( utl_testRand() & 1)
+               {
+                  UTL_TEST_CHECK( utl_readByte( &t_buffer) ==
+                                  refRead( &gt_ref),
+                                  "step %u: read byte data",
+                                  i_step);
+               }
+               else
+               {
+                  utl_buffEraseTailByte( &t_buffer);
+                  refEraseTail( &gt_ref);
+                  UTL_TEST_CHECK( gac_storage[(gt_ref.i_head +
+                                  gt_ref.i_count) % s_size] == 0,
+                                  "step %u: erased byte not cleared",
+                                  i_step);
+               }
+            }
+
+         break;/*End case 5:*/
+
+         default:
+
+            /*---------------------------------------------------------------*
+             * Now and then fill or drain the buffer completely with a single
+             * block, so both edges show up no matter the size.
+             *---------------------------------------------------------------*/
+            if( utl_testRand() & 1)
+            {
+               s_req = (uint16_t)(s_size - gt_ref.i_count);
+               for( s_index = 0; s_index < s_req; s_index++)
+               {
+                  gac_block[s_index] = (int8_t)utl_testRand();
+                  refWrite( &gt_ref, gac_block[s_index]);
+               }
+
+               utl_writeBlock( &t_buffer, gac_block, s_req);
+            }
+            else
+            {
+               s_req = (uint16_t)gt_ref.i_count;
+               utl_readBlock( &t_buffer, gac_block, s_req);
+               for( s_index = 0; s_index < s_req; s_index++)
+               {
+                  UTL_TEST_CHECK( gac_block[s_index] == refRead( &gt_ref),
+                                  "step %u: drain data at %u",
+                                  i_step,
+                                  s_index);
+               }
+            }
+
+         break;/*End default:*/
+
+      }/*End switch( utl_testRand() % 7)*/
+
+      checkLevels( &t_buffer, &gt_ref, i_step);
+
+      /*---------------------------------------------------------------------*
+       * Once the two disagree every later step would fail as well.
+       *---------------------------------------------------------------------*/
+      if( gi_testFailures > i_failures)
+         break;
+
+   }/*End for( i_step = 0; i_step < i_steps; i_step++)*/
+
+}/*End testRandom*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   static const uint16_t as_sizes[] = {1, 2, 3, 7, 16, 100, 255, 1000};
+   uint16_t s_test;
+   uint16_t s_size;
+
+   for( s_test = 0; s_test < sizeof( as_sizes)/sizeof( as_sizes[0]);
+   s_test++)
+   {
+      s_size = as_sizes[s_test];
+      testEdges( s_size);
+      testRandom( s_size, s_size - 1 - s_size/4, TEST_STEPS);
+   }
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
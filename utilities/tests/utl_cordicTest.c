@@ -0,0 +1,359 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_cordicTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of the CORDIC functions against libm with the
+ *               default UTL_CORDIC_ITERATIONS and UTL_CORDIC_GUARD_BITS.
+ *               The iterations leave a residual angle of about 2^-13, so
+ *               errors that scale with the result are bounded relative to
+ *               it, and the others in Q15 LSBs.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "utl_cordic.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_TRIALS (1000000)
+
+/*---------------------------------------------------------------------------*
+ * Error bounds, in LSBs unless they are relative.
+ *---------------------------------------------------------------------------*/
+#define TEST_SINCOS_ERR (5.0)
+#define TEST_ROTATE_ERR (5.0)    /*Per unit of input magnitude*/
+#define TEST_ATAN2_ERR  (2.0)
+#define TEST_MAG_ERR    (2.0)
+#define TEST_MAG3_ERR   (4.0)
+#define TEST_LN_ERR     (5.0)
+#define TEST_SQRT_REL   (1.0 / 16384.0)
+#define TEST_EXP_REL    (1.0 / 4096.0)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static double testLimit16( double d_x);
+static int16_t testRandScaled16( void);
+static void testSincos( void);
+static void testRotate( void);
+static void testAtan2Mag( void);
+static void testMag3( void);
+static void testSqrt( void);
+static void testLnExp( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static double testLimit16( double d_x)
+{
+   if( d_x > 32767.0)
+      return 32767.0;
+   if( d_x < -32768.0)
+      return -32768.0;
+
+   return d_x;
+
+}/*End testLimit16*/
+
+/*---------------------------------------------------------------------------*
+ * Random Q1.15 number with a random magnitude, so small vectors are tested
+ * as often as large ones.
+ *---------------------------------------------------------------------------*/
+static int16_t testRandScaled16( void)
+{
+   return (int16_t)(utl_testRand16() >> (utl_testRand() & 15));
+
+}/*End testRandScaled16*/
+
+static void testSincos( void)
+{
+   int32_t i_phase;
+   int16_t s_sin;
+   int16_t s_cos;
+   double d_angle;
+   double d_err;
+   double d_worst = 0.0;
+
+   for( i_phase = 0; i_phase < 65536; i_phase++)
+   {
+      utl_cordicSincos16( (uint16_t)i_phase, &s_sin, &s_cos);
+
+      d_angle = (double)i_phase*2.0*M_PI / 65536.0;
+
+      d_err = fabs( (double)s_sin - testLimit16( sin( d_angle)*32768.0));
+      if( d_err > d_worst)
+         d_worst = d_err;
+
+      d_err = fabs( (double)s_cos - testLimit16( cos( d_angle)*32768.0));
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_cordicSincos16 (LSB)", d_worst, TEST_SINCOS_ERR);
+
+}/*End testSincos*/
+
+static void testRotate( void)
+{
+   int32_t i_trial;
+   int16_t s_x;
+   int16_t s_y;
+   int16_t s_rx;
+   int16_t s_ry;
+   uint16_t s_phase;
+   double d_angle;
+   double d_x;
+   double d_y;
+   double d_mag;
+   double d_err;
+   double d_worst = 0.0;
+
+   for( i_trial = 0; i_trial < TEST_TRIALS; i_trial++)
+   {
+      s_x     = utl_testRand16();
+      s_y     = utl_testRand16();
+      s_phase = (uint16_t)utl_testRand();
+      s_rx    = s_x;
+      s_ry    = s_y;
+
+      utl_cordicRotate16( &s_rx, &s_ry, s_phase);
+
+      d_angle = (double)s_phase*2.0*M_PI / 65536.0;
+      d_x     = (double)s_x*cos( d_angle) - (double)s_y*sin( d_angle);
+      d_y     = (double)s_x*sin( d_angle) + (double)s_y*cos( d_angle);
+
+      /*---------------------------------------------------------------------*
+       * The error grows with the vector, it is measured per unit of
+       * magnitude once the vector is longer than 1.
+       *---------------------------------------------------------------------*/
+      d_mag = hypot( (double)s_x, (double)s_y) / 32768.0;
+      if( d_mag < 1.0)
+         d_mag = 1.0;
+
+      d_err = fmax( fabs( (double)s_rx - testLimit16( d_x)),
+                    fabs( (double)s_ry - testLimit16( d_y))) / d_mag;
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_cordicRotate16 (LSB)", d_worst, TEST_ROTATE_ERR);
+
+}/*End testRotate*/
+
+static void testAtan2Mag( void)
+{
+   int32_t i_trial;
+   int16_t s_x;
+   int16_t s_y;
+   int16_t s_angle;
+   uint16_t s_mag;
+   double d_err;
+   double d_worstAngle = 0.0;
+   double d_worstMag   = 0.0;
+
+   s_mag = 1;
+   UTL_TEST_CHECK( (utl_cordicAtan2_16( 0, 0, &s_mag) == 0) && (s_mag == 0),
+                   "atan2 of (0,0) is not 0");
+
+   for( i_trial = 0; i_trial < TEST_TRIALS; i_trial++)
+   {
+      s_x = testRandScaled16();
+      s_y = testRandScaled16();
+      if( (s_x == 0) && (s_y == 0))
+         continue;
+
+      s_angle = utl_cordicAtan2_16( s_y, s_x, &s_mag);
+
+      UTL_TEST_CHECK( utl_cordicAtan2_16( s_y, s_x, NULL) == s_angle,
+                      "atan2(%d, %d) depends on ps_mag",
+                      s_y,
+                      s_x);
+
+      /*---------------------------------------------------------------------*
+       * pi is 32768, which saturates to 32767.
+       *---------------------------------------------------------------------*/
+      d_err = fabs( (double)s_angle - testLimit16( atan2( (double)s_y,
+      (double)s_x)*32768.0 / M_PI));
+      if( d_err > d_worstAngle)
+         d_worstAngle = d_err;
+
+      d_err = fabs( (double)s_mag - hypot( (double)s_x, (double)s_y));
+      if( d_err > d_worstMag)
+         d_worstMag = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_cordicAtan2_16 (LSB)", d_worstAngle, TEST_ATAN2_ERR);
+   UTL_TEST_BOUND( "utl_cordicAtan2_16 mag (LSB)", d_worstMag, TEST_MAG_ERR);
+
+}/*End testAtan2Mag*/
+
+static void testMag3( void)
+{
+   int32_t i_trial;
+   int16_t s_x;
+   int16_t s_y;
+   int16_t s_z;
+   double d_err;
+   double d_worst = 0.0;
+
+   for( i_trial = 0; i_trial < TEST_TRIALS; i_trial++)
+   {
+      s_x = testRandScaled16();
+      s_y = testRandScaled16();
+      s_z = testRandScaled16();
+
+      /*---------------------------------------------------------------------*
+       * The largest magnitude, the registers have to hold it.
+       *---------------------------------------------------------------------*/
+      if( i_trial == 0)
+      {
+         s_x = -32768;
+         s_y = -32768;
+         s_z = -32768;
+      }
+
+      d_err = fabs( (double)utl_cordicMag3_16( s_x, s_y, s_z) -
+      sqrt( (double)s_x*s_x + (double)s_y*s_y + (double)s_z*s_z));
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_cordicMag3_16 (LSB)", d_worst, TEST_MAG3_ERR);
+
+}/*End testMag3*/
+
+static void testSqrt( void)
+{
+   int32_t i_trial;
+   uint32_t i_input;
+   int8_t c_n;
+   double d_sqrt;
+   double d_err;
+   double d_worst = 0.0;
+
+   for( c_n = 0; c_n < 32; c_n++)
+   {
+      UTL_TEST_CHECK( utl_cordicSqrt32( 0, c_n) == 0,
+                      "sqrt of 0 in Q%d is not 0",
+                      c_n);
+   }
+
+   /*------------------------------------------------------------------------*
+    * Past the half LSB of rounding, the error is relative to the result.
+    *------------------------------------------------------------------------*/
+   for( i_trial = 0; i_trial < TEST_TRIALS; i_trial++)
+   {
+      i_input = utl_testRand() >> (utl_testRand() & 31);
+      c_n     = (int8_t)(utl_testRand() & 31);
+      if( i_trial < 32)
+      {
+         i_input = 0xFFFFFFFF;
+         c_n     = (int8_t)i_trial;
+      }
+
+      if( i_input == 0)
+         continue;
+
+      d_sqrt = sqrt( ldexp( (double)i_input, c_n));
+      d_err  = (fabs( (double)utl_cordicSqrt32( i_input, c_n) - d_sqrt) -
+      0.5) / d_sqrt;
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_cordicSqrt32 (rel)", d_worst, TEST_SQRT_REL);
+
+}/*End testSqrt*/
+
+static void testLnExp( void)
+{
+   int32_t i_trial;
+   int32_t i_x;
+   uint32_t i_y;
+   double d_exp;
+   double d_err;
+   double d_worstLn  = 0.0;
+   double d_worstExp = 0.0;
+
+   for( i_trial = 0; i_trial < TEST_TRIALS; i_trial++)
+   {
+      i_y = utl_testRand() >> (utl_testRand() & 31);
+      if( i_trial == 0)
+         i_y = 0xFFFFFFFF;
+      if( i_y == 0)
+         i_y = 1;
+
+      d_err = fabs( (double)utl_cordicLn32( i_y) -
+      log( (double)i_y / 32768.0)*32768.0);
+      if( d_err > d_worstLn)
+         d_worstLn = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_cordicLn32 (LSB)", d_worstLn, TEST_LN_ERR);
+
+   /*------------------------------------------------------------------------*
+    * Every input from where the result rounds to 0 up to saturation.
+    *------------------------------------------------------------------------*/
+   for( i_x = -400000; i_x < 386127; i_x++)
+   {
+      d_exp = exp( (double)i_x / 32768.0)*32768.0;
+      d_err = (fabs( (double)utl_cordicExp32( i_x) - d_exp) - 0.5) / d_exp;
+      if( d_err > d_worstExp)
+         d_worstExp = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_cordicExp32 (rel)", d_worstExp, TEST_EXP_REL);
+
+   UTL_TEST_CHECK( (utl_cordicExp32( 386127) == 0xFFFFFFFF) &&
+                   (utl_cordicExp32( 0x7FFFFFFF) == 0xFFFFFFFF),
+                   "exp does not saturate");
+
+}/*End testLnExp*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+
+   testSincos();
+   testRotate();
+   testAtan2Mag();
+   testMag3();
+   testSqrt();
+   testLnExp();
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
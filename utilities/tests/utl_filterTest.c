@@ -0,0 +1,576 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_filterTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of the block filters against double and 64-bit
+ *               references. Every filter has to give the same bits however
+ *               a signal is split into blocks. The FIR and moving average
+ *               outputs have to stay within their rounding of the exact
+ *               result, the CIC decimator has to match an integer boxcar
+ *               cascade exactly. A biquad's products are exact, only its
+ *               output rounding is fed back, so its bound is that rounding
+ *               through 1/A(z) and the stages after it.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include "utl_filter.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_SIGNAL_LEN  (2000)
+#define TEST_MAX_TAPS    (64)
+#define TEST_MAX_STAGES  (3)
+#define TEST_MAX_WINDOW  (100)
+#define TEST_IMPULSE_LEN (8192)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void testRandSignal( int16_t *ps_x,
+                            uint16_t s_length,
+                            int16_t s_amp);
+static uint16_t testRandBlock( uint16_t s_left);
+static void testFir( uint16_t s_numTaps,
+                     int8_t c_o);
+static double testIirL1( const double *pd_b,
+                         const double *pd_a);
+static void testBiquad( uint8_t c_numStages);
+static void testMovAvg( uint16_t s_window);
+static void testCic( uint8_t c_order,
+                     uint16_t s_decimation);
+static void testErrors( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static int16_t gas_in[TEST_SIGNAL_LEN];
+static int16_t gas_whole[TEST_SIGNAL_LEN];
+static int16_t gas_split[TEST_SIGNAL_LEN];
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void testRandSignal( int16_t *ps_x,
+                            uint16_t s_length,
+                            int16_t s_amp)
+{
+   uint16_t s_index;
+
+   for( s_index = 0; s_index < s_length; s_index++)
+      ps_x[s_index] = (int16_t)utl_testRandD( -(double)s_amp, (double)s_amp);
+
+}/*End testRandSignal*/
+
+/*---------------------------------------------------------------------------*
+ * Block lengths from 0 up to a little past the longest filter, so blocks
+ * shorter than the state are split as well.
+ *---------------------------------------------------------------------------*/
+static uint16_t testRandBlock( uint16_t s_left)
+{
+   uint16_t s_block = (uint16_t)(utl_testRand() % (TEST_MAX_TAPS + 8));
+
+   if( s_block > s_left)
+      s_block = s_left;
+
+   return s_block;
+
+}/*End testRandBlock*/
+
+static void testFir( uint16_t s_numTaps,
+                     int8_t c_o)
+{
+   t_firFilter t_fir;
+   int16_t as_h[TEST_MAX_TAPS];
+   int16_t as_state[TEST_MAX_TAPS];
+   uint16_t s_index;
+   uint16_t s_done;
+   uint16_t s_block;
+   uint16_t s_k;
+   double d_sumH = 0.0;
+   double d_y;
+   double d_err;
+   double d_worst = 0.0;
+   char ac_name[32];
+
+   /*------------------------------------------------------------------------*
+    * Taps whose magnitudes sum to less than 1, so nothing saturates.
+    *------------------------------------------------------------------------*/
+   for( s_k = 0; s_k < s_numTaps; s_k++)
+   {
+      as_h[s_k] = (int16_t)utl_testRandD( -32767.0 / s_numTaps,
+                                          32767.0 / s_numTaps);
+      d_sumH += fabs( (double)as_h[s_k]);
+   }
+
+   testRandSignal( gas_in, TEST_SIGNAL_LEN, 32767);
+
+   UTL_TEST_CHECK( utl_initFir( &t_fir, as_h, s_numTaps, as_state, c_o) ==
+                   FILTER_PASSED,
+                   "utl_initFir failed");
+   utl_fir16( &t_fir, gas_in, gas_whole, TEST_SIGNAL_LEN);
+
+   UTL_TEST_CHECK( utl_initFir( &t_fir, as_h, s_numTaps, as_state, c_o) ==
+                   FILTER_PASSED,
+                   "utl_initFir failed");
+   for( s_done = 0; s_done < TEST_SIGNAL_LEN; s_done += s_block)
+   {
+      s_block = testRandBlock( TEST_SIGNAL_LEN - s_done);
+      utl_fir16( &t_fir, &gas_in[s_done], &gas_split[s_done], s_block);
+   }
+
+   UTL_TEST_CHECK( memcmp( gas_whole, gas_split, sizeof( gas_whole)) == 0,
+                   "FIR %u taps, split blocks differ from one block",
+                   s_numTaps);
+
+   /*------------------------------------------------------------------------*
+    * Each product loses less than 2^c_o of the Q30 accumulator when it is
+    * shifted down, the final shift rounds.
+    *------------------------------------------------------------------------*/
+   for( s_index = 0; s_index < TEST_SIGNAL_LEN; s_index++)
+   {
+      d_y = 0.0;
+      for( s_k = 0; (s_k < s_numTaps) && (s_k <= s_index); s_k++)
+         d_y += (double)as_h[s_k]*(double)gas_in[s_index - s_k];
+
+      d_err = fabs( (double)gas_whole[s_index] - d_y / 32768.0);
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_CHECK( d_sumH < 32768.0, "FIR taps can saturate");
+
+   snprintf( ac_name, sizeof( ac_name), "utl_fir16 %u taps o %d (LSB)",
+   s_numTaps, c_o);
+   UTL_TEST_BOUND( ac_name,
+                   d_worst,
+                   0.5 + (double)s_numTaps*ldexp( 1.0, c_o - 15));
+
+}/*End testFir*/
+
+/*---------------------------------------------------------------------------*
+ * Sum of the magnitudes of the impulse response of B(z)/A(z).
+ *---------------------------------------------------------------------------*/
+static double testIirL1( const double *pd_b,
+                         const double *pd_a)
+{
+   double d_x1 = 0.0;
+   double d_x2 = 0.0;
+   double d_y1 = 0.0;
+   double d_y2 = 0.0;
+   double d_x0;
+   double d_y0;
+   double d_l1 = 0.0;
+   int32_t i_n;
+
+   for( i_n = 0; i_n < TEST_IMPULSE_LEN; i_n++)
+   {
+      d_x0 = (i_n == 0) ? 1.0 : 0.0;
+      d_y0 = pd_b[0]*d_x0 + pd_b[1]*d_x1 + pd_b[2]*d_x2 - pd_a[0]*d_y1 -
+      pd_a[1]*d_y2;
+
+      d_l1 += fabs( d_y0);
+      d_x2  = d_x1;
+      d_x1  = d_x0;
+      d_y2  = d_y1;
+      d_y1  = d_y0;
+   }
+
+   return d_l1;
+
+}/*End testIirL1*/
+
+static void testBiquad( uint8_t c_numStages)
+{
+   t_biquadFilter t_biquad;
+   int16_t as_coeffs[UTL_FILTER_BIQUAD_COEFF_SIZE( TEST_MAX_STAGES)];
+   int16_t as_state[UTL_FILTER_BIQUAD_STATE_SIZE( TEST_MAX_STAGES)];
+   double ad_b[TEST_MAX_STAGES][3];
+   double ad_a[TEST_MAX_STAGES][2];
+   double ad_state[TEST_MAX_STAGES][4];
+   double ad_one[3] = {1.0, 0.0, 0.0};
+   double d_w0;
+   double d_alpha;
+   double d_a0;
+   double d_x;
+   double d_y;
+   double d_bound = 0.0;
+   double d_err;
+   double d_worst = 0.0;
+   double d_peak = 0.0;
+   uint8_t c_stage;
+   uint16_t s_index;
+   uint16_t s_done;
+   uint16_t s_block;
+   char ac_name[32];
+
+   /*------------------------------------------------------------------------*
+    * Lowpass sections from the audio EQ cookbook with rising Q, quantized
+    * to Q14. The reference uses the quantized values.
+    *------------------------------------------------------------------------*/
+   for( c_stage = 0; c_stage < c_numStages; c_stage++)
+   {
+      d_w0    = 2.0*M_PI*(0.02 + 0.03*c_stage);
+      d_alpha = sin( d_w0) / (2.0*(0.55 + 0.4*c_stage));
+      d_a0    = 1.0 + d_alpha;
+
+      as_coeffs[c_stage*5 + 0] = (int16_t)lround( 16384.0*(1.0 - cos( d_w0))
+      / 2.0 / d_a0);
+      as_coeffs[c_stage*5 + 1] = (int16_t)lround( 16384.0*(1.0 - cos( d_w0))
+      / d_a0);
+      as_coeffs[c_stage*5 + 2] = as_coeffs[c_stage*5 + 0];
+      as_coeffs[c_stage*5 + 3] = (int16_t)lround( 16384.0*-2.0*cos( d_w0) /
+      d_a0);
+      as_coeffs[c_stage*5 + 4] = (int16_t)lround( 16384.0*(1.0 - d_alpha) /
+      d_a0);
+
+      ad_b[c_stage][0] = as_coeffs[c_stage*5 + 0] / 16384.0;
+      ad_b[c_stage][1] = as_coeffs[c_stage*5 + 1] / 16384.0;
+      ad_b[c_stage][2] = as_coeffs[c_stage*5 + 2] / 16384.0;
+      ad_a[c_stage][0] = as_coeffs[c_stage*5 + 3] / 16384.0;
+      ad_a[c_stage][1] = as_coeffs[c_stage*5 + 4] / 16384.0;
+
+      /*---------------------------------------------------------------------*
+       * The error out of a stage is the one coming in through H(z) plus
+       * half an LSB of rounding through 1/A(z).
+       *---------------------------------------------------------------------*/
+      d_bound = d_bound*testIirL1( ad_b[c_stage], ad_a[c_stage]) +
+      0.5*testIirL1( ad_one, ad_a[c_stage]);
+   }
+
+   testRandSignal( gas_in, TEST_SIGNAL_LEN, 8192);
+
+   UTL_TEST_CHECK( utl_initBiquad( &t_biquad, as_coeffs, c_numStages,
+                   as_state, 14) == FILTER_PASSED,
+                   "utl_initBiquad failed");
+   utl_biquad16( &t_biquad, gas_in, gas_whole, TEST_SIGNAL_LEN);
+
+   /*------------------------------------------------------------------------*
+    * Split blocks, filtered in place.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_initBiquad( &t_biquad, as_coeffs, c_numStages,
+                   as_state, 14) == FILTER_PASSED,
+                   "utl_initBiquad failed");
+   memcpy( gas_split, gas_in, sizeof( gas_in));
+   for( s_done = 0; s_done < TEST_SIGNAL_LEN; s_done += s_block)
+   {
+      s_block = testRandBlock( TEST_SIGNAL_LEN - s_done);
+      utl_biquad16( &t_biquad, &gas_split[s_done], &gas_split[s_done],
+      s_block);
+   }
+
+   UTL_TEST_CHECK( memcmp( gas_whole, gas_split, sizeof( gas_whole)) == 0,
+                   "biquad %u stages, split blocks differ from one block",
+                   c_numStages);
+
+   memset( ad_state, 0, sizeof( ad_state));
+   for( s_index = 0; s_index < TEST_SIGNAL_LEN; s_index++)
+   {
+      d_x = (double)gas_in[s_index];
+      for( c_stage = 0; c_stage < c_numStages; c_stage++)
+      {
+         d_y = ad_b[c_stage][0]*d_x + ad_b[c_stage][1]*ad_state[c_stage][0] +
+         ad_b[c_stage][2]*ad_state[c_stage][1] -
+         ad_a[c_stage][0]*ad_state[c_stage][2] -
+         ad_a[c_stage][1]*ad_state[c_stage][3];
+
+         ad_state[c_stage][1] = ad_state[c_stage][0];
+         ad_state[c_stage][0] = d_x;
+         ad_state[c_stage][3] = ad_state[c_stage][2];
+         ad_state[c_stage][2] = d_y;
+
+         if( fabs( d_y) > d_peak)
+            d_peak = fabs( d_y);
+
+         d_x = d_y;
+      }
+
+      d_err = fabs( (double)gas_whole[s_index] - d_x);
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_CHECK( d_peak < 32767.0, "biquad reference saturates");
+
+   snprintf( ac_name, sizeof( ac_name), "utl_biquad16 %u stages (LSB)",
+   c_numStages);
+   UTL_TEST_BOUND( ac_name, d_worst, d_bound);
+
+}/*End testBiquad*/
+
+static void testMovAvg( uint16_t s_window)
+{
+   t_movAvgFilter t_avg;
+   int16_t as_window[TEST_MAX_WINDOW];
+   uint16_t s_index;
+   uint16_t s_done;
+   uint16_t s_block;
+   uint16_t s_k;
+   int32_t i_sum;
+   double d_err;
+   double d_worst = 0.0;
+   char ac_name[32];
+
+   testRandSignal( gas_in, TEST_SIGNAL_LEN, 32767);
+
+   UTL_TEST_CHECK( utl_initMovAvg( &t_avg, as_window, s_window) ==
+                   FILTER_PASSED,
+                   "utl_initMovAvg failed");
+   utl_movAvg16( &t_avg, gas_in, gas_whole, TEST_SIGNAL_LEN);
+
+   UTL_TEST_CHECK( utl_initMovAvg( &t_avg, as_window, s_window) ==
+                   FILTER_PASSED,
+                   "utl_initMovAvg failed");
+   memcpy( gas_split, gas_in, sizeof( gas_in));
+   for( s_done = 0; s_done < TEST_SIGNAL_LEN; s_done += s_block)
+   {
+      s_block = testRandBlock( TEST_SIGNAL_LEN - s_done);
+      utl_movAvg16( &t_avg, &gas_split[s_done], &gas_split[s_done], s_block);
+   }
+
+   UTL_TEST_CHECK( memcmp( gas_whole, gas_split, sizeof( gas_whole)) == 0,
+                   "moving average of %u, split blocks differ from one block",
+                   s_window);
+
+   /*------------------------------------------------------------------------*
+    * The samples before the first are zero. The gain 2^30/length is
+    * rounded, which moves the mean by at most |sum|/2^31.
+    *------------------------------------------------------------------------*/
+   for( s_index = 0; s_index < TEST_SIGNAL_LEN; s_index++)
+   {
+      i_sum = 0;
+      for( s_k = 0; (s_k < s_window) && (s_k <= s_index); s_k++)
+         i_sum += gas_in[s_index - s_k];
+
+      d_err = fabs( (double)gas_whole[s_index] - (double)i_sum / s_window) -
+      fabs( (double)i_sum) / 2147483648.0;
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   snprintf( ac_name, sizeof( ac_name), "utl_movAvg16 %u (LSB)", s_window);
+   UTL_TEST_BOUND( ac_name, d_worst, 0.5);
+
+}/*End testMovAvg*/
+
+static void testCic( uint8_t c_order,
+                     uint16_t s_decimation)
+{
+   t_cicDecimator t_cic;
+   int64_t al_stage[UTL_FILTER_CIC_MAX_ORDER + 1][TEST_SIGNAL_LEN];
+   int16_t s_expect;
+   uint16_t s_numOut;
+   uint16_t s_numSplit = 0;
+   uint16_t s_done;
+   uint16_t s_block;
+   uint16_t s_index;
+   uint16_t s_k;
+   uint8_t c_stage;
+   int8_t c_shift = 0;
+   int64_t l_gain = 1;
+   int64_t l_y;
+   int64_t l_mag;
+   int32_t i_mismatch = 0;
+
+   testRandSignal( gas_in, TEST_SIGNAL_LEN, 32767);
+
+   UTL_TEST_CHECK( utl_initCic( &t_cic, c_order, s_decimation) ==
+                   FILTER_PASSED,
+                   "utl_initCic( %u, %u) failed",
+                   c_order,
+                   s_decimation);
+   s_numOut = utl_cicDecimate16( &t_cic, gas_in, gas_whole, TEST_SIGNAL_LEN);
+
+   UTL_TEST_CHECK( utl_initCic( &t_cic, c_order, s_decimation) ==
+                   FILTER_PASSED,
+                   "utl_initCic( %u, %u) failed",
+                   c_order,
+                   s_decimation);
+   memcpy( gas_split, gas_in, sizeof( gas_in));
+   for( s_done = 0; s_done < TEST_SIGNAL_LEN; s_done += s_block)
+   {
+      s_block = testRandBlock( TEST_SIGNAL_LEN - s_done);
+      s_numSplit += utl_cicDecimate16( &t_cic, &gas_split[s_done],
+      &gas_split[s_numSplit], s_block);
+   }
+
+   UTL_TEST_CHECK( (s_numOut == TEST_SIGNAL_LEN / s_decimation) &&
+                   (s_numSplit == s_numOut) &&
+                   (memcmp( gas_whole, gas_split, s_numOut*sizeof( int16_t))
+                   == 0),
+                   "CIC %u/%u, split blocks differ from one block",
+                   c_order,
+                   s_decimation);
+
+   /*------------------------------------------------------------------------*
+    * c_order boxcars of length R in 64 bits, every R'th sum scaled down
+    * by the gain rounded up to a power of two.
+    *------------------------------------------------------------------------*/
+   for( s_index = 0; s_index < TEST_SIGNAL_LEN; s_index++)
+      al_stage[0][s_index] = gas_in[s_index];
+
+   for( c_stage = 0; c_stage < c_order; c_stage++)
+   {
+      l_gain *= s_decimation;
+      for( s_index = 0; s_index < TEST_SIGNAL_LEN; s_index++)
+      {
+         al_stage[c_stage + 1][s_index] = 0;
+         for( s_k = 0; (s_k < s_decimation) && (s_k <= s_index); s_k++)
+         {
+            al_stage[c_stage + 1][s_index] += al_stage[c_stage][s_index -
+            s_k];
+         }
+      }
+   }
+
+   while( ((int64_t)1 << c_shift) < l_gain)
+      c_shift++;
+
+   for( s_index = 0; s_index < s_numOut; s_index++)
+   {
+      l_y   = al_stage[c_order][(s_index + 1)*s_decimation - 1];
+      l_mag = (l_y < 0) ? -l_y : l_y;
+      if( c_shift > 0)
+         l_mag = (l_mag + ((int64_t)1 << (c_shift - 1))) >> c_shift;
+      l_y = (l_y < 0) ? -l_mag : l_mag;
+
+      if( l_y > 32767)
+         l_y = 32767;
+      if( l_y < -32768)
+         l_y = -32768;
+
+      s_expect = (int16_t)l_y;
+      if( gas_whole[s_index] != s_expect)
+      {
+         if( i_mismatch == 0)
+         {
+            UTL_TEST_CHECK( false,
+                            "CIC %u/%u output %u is %d, expected %d",
+                            c_order,
+                            s_decimation,
+                            s_index,
+                            gas_whole[s_index],
+                            s_expect);
+         }
+         i_mismatch++;
+      }
+   }
+
+   printf( "utl_cicDecimate16 %u/%-3u      %u outputs, %ld differ\n",
+           c_order,
+           s_decimation,
+           s_numOut,
+           (long)i_mismatch);
+
+}/*End testCic*/
+
+static void testErrors( void)
+{
+   t_firFilter t_fir;
+   t_biquadFilter t_biquad;
+   t_movAvgFilter t_avg;
+   t_cicDecimator t_cic;
+   int16_t as_coeffs[UTL_FILTER_BIQUAD_COEFF_SIZE( 1)] = {0};
+   int16_t as_state[UTL_FILTER_BIQUAD_STATE_SIZE( 1)];
+
+   UTL_TEST_CHECK( (utl_initFir( NULL, as_coeffs, 2, as_state, 0) ==
+                   FILTER_NULL_PTR) &&
+                   (utl_initFir( &t_fir, NULL, 2, as_state, 0) ==
+                   FILTER_NULL_PTR) &&
+                   (utl_initFir( &t_fir, as_coeffs, 2, NULL, 0) ==
+                   FILTER_NULL_PTR) &&
+                   (utl_initFir( &t_fir, as_coeffs, 1, NULL, 0) ==
+                   FILTER_PASSED) &&
+                   (utl_initFir( &t_fir, as_coeffs, 0, as_state, 0) ==
+                   FILTER_INVALID_ARG) &&
+                   (utl_initFir( &t_fir, as_coeffs, 2, as_state, 16) ==
+                   FILTER_INVALID_ARG),
+                   "utl_initFir error returns");
+
+   UTL_TEST_CHECK( (utl_initBiquad( &t_biquad, as_coeffs, 1, NULL, 14) ==
+                   FILTER_NULL_PTR) &&
+                   (utl_initBiquad( &t_biquad, as_coeffs, 0, as_state, 14) ==
+                   FILTER_INVALID_ARG) &&
+                   (utl_initBiquad( &t_biquad, as_coeffs, 1, as_state, 0) ==
+                   FILTER_INVALID_ARG) &&
+                   (utl_initBiquad( &t_biquad, as_coeffs, 1, as_state, 16) ==
+                   FILTER_INVALID_ARG),
+                   "utl_initBiquad error returns");
+
+   UTL_TEST_CHECK( (utl_initMovAvg( &t_avg, NULL, 4) == FILTER_NULL_PTR) &&
+                   (utl_initMovAvg( &t_avg, as_state, 0) ==
+                   FILTER_INVALID_ARG),
+                   "utl_initMovAvg error returns");
+
+   /*------------------------------------------------------------------------*
+    * 16^4 is the largest gain allowed, 17^4 is past it.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( (utl_initCic( NULL, 2, 4) == FILTER_NULL_PTR) &&
+                   (utl_initCic( &t_cic, 0, 4) == FILTER_INVALID_ARG) &&
+                   (utl_initCic( &t_cic, UTL_FILTER_CIC_MAX_ORDER + 1, 4) ==
+                   FILTER_INVALID_ARG) &&
+                   (utl_initCic( &t_cic, 2, 0) == FILTER_INVALID_ARG) &&
+                   (utl_initCic( &t_cic, 4, 16) == FILTER_PASSED) &&
+                   (utl_initCic( &t_cic, 4, 17) == FILTER_INVALID_ARG),
+                   "utl_initCic error returns");
+
+}/*End testErrors*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+
+   testFir( 1, 0);
+   testFir( 2, 1);
+   testFir( 7, 3);
+   testFir( 32, 5);
+   testFir( TEST_MAX_TAPS, 6);
+
+   testBiquad( 1);
+   testBiquad( 2);
+   testBiquad( TEST_MAX_STAGES);
+
+   testMovAvg( 1);
+   testMovAvg( 3);
+   testMovAvg( 64);
+   testMovAvg( TEST_MAX_WINDOW);
+
+   testCic( 1, 8);
+   testCic( 2, 5);
+   testCic( 3, 16);
+   testCic( UTL_FILTER_CIC_MAX_ORDER, 16);
+
+   testErrors();
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
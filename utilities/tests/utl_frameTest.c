@@ -0,0 +1,397 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_frameTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of utl_frame, the framing shared with the Python
+ *               GUI. Random payloads, with runs of zeros and lengths on
+ *               either side of the 254 byte COBS block, are encoded and
+ *               compared byte for byte against a plain COBS reference, then
+ *               decoded back. The CRC is checked against the CRC-16/CCITT
+ *               check value, and damaged, truncated and oversized frames
+ *               must be refused with the right error.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include "utl_frame.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_MAX_PAYLOAD (1100)
+#define TEST_MAX_RAW     (TEST_MAX_PAYLOAD + UTL_FRAME_HDR_SIZE +\
+UTL_FRAME_CRC_SIZE)
+#define TEST_MAX_FRAME   (UTL_FRAME_MAX_ENCODED_SIZE( TEST_MAX_PAYLOAD))
+#define TEST_RANDOM      (2000)
+
+/*---------------------------------------------------------------------------*
+ * CRC-16/CCITT (init 0xFFFF) of "123456789".
+ *---------------------------------------------------------------------------*/
+#define TEST_CRC_CHECK   (0x29B1)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static uint16_t refRaw( uint8_t c_msgId,
+                        uint8_t c_version,
+                        uint8_t c_seq,
+                        const uint8_t *pc_payload,
+                        uint16_t s_size,
+                        uint8_t *pc_raw);
+static uint16_t refCobs( const uint8_t *pc_raw,
+                         uint16_t s_size,
+                         uint8_t *pc_out);
+static void testRandPayload( uint8_t *pc_payload,
+                             uint16_t s_size);
+static void testRoundTrip( uint16_t s_size);
+static void testCrc( void);
+static void testErrors( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static uint8_t gac_payload[TEST_MAX_PAYLOAD];
+static uint8_t gac_raw[TEST_MAX_RAW];
+static uint8_t gac_ref[TEST_MAX_FRAME];
+static uint8_t gac_frame[TEST_MAX_FRAME];
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The frame before stuffing, header, payload and little endian CRC.
+ *---------------------------------------------------------------------------*/
+static uint16_t refRaw( uint8_t c_msgId,
+                        uint8_t c_version,
+                        uint8_t c_seq,
+                        const uint8_t *pc_payload,
+                        uint16_t s_size,
+                        uint8_t *pc_raw)
+{
+   uint16_t s_crc;
+   uint16_t s_length = UTL_FRAME_HDR_SIZE + s_size;
+
+   pc_raw[0] = c_msgId;
+   pc_raw[1] = c_version;
+   pc_raw[2] = c_seq;
+   memcpy( &pc_raw[UTL_FRAME_HDR_SIZE], pc_payload, s_size);
+
+   s_crc = utl_crc16( 0xFFFF, pc_raw, s_length);
+   pc_raw[s_length]     = (uint8_t)(s_crc & 0xFF);
+   pc_raw[s_length + 1] = (uint8_t)(s_crc >> 8);
+
+   return s_length + UTL_FRAME_CRC_SIZE;
+
+}/*End refRaw*/
+
+/*---------------------------------------------------------------------------*
+ * Textbook COBS, one code byte per run of at most 254 non-zero bytes. No
+ * delimiters.
+ *---------------------------------------------------------------------------*/
+static uint16_t refCobs( const uint8_t *pc_raw,
+                         uint16_t s_size,
+                         uint8_t *pc_out)
+{
+   uint16_t s_code = 0;
+   uint16_t s_wr   = 1;
+   uint16_t s_index;
+   uint8_t c_code  = 1;
+
+   for( s_index = 0; s_index < s_size; s_index++)
+   {
+      if( pc_raw[s_index] != 0)
+      {
+         pc_out[s_wr++] = pc_raw[s_index];
+         c_code++;
+      }
+
+      if( (pc_raw[s_index] == 0) || (c_code == 0xFF))
+      {
+         pc_out[s_code] = c_code;
+         s_code = s_wr++;
+         c_code = 1;
+      }
+   }
+
+   pc_out[s_code] = c_code;
+
+   return s_wr;
+
+}/*End refCobs*/
+
+/*---------------------------------------------------------------------------*
+ * Mostly non-zero bytes with the odd run of zeros, so blocks of every
+ * length up to the maximum come up.
+ *---------------------------------------------------------------------------*/
+static void testRandPayload( uint8_t *pc_payload,
+                             uint16_t s_size)
+{
+   uint16_t s_index = 0;
+   uint16_t s_run;
+
+   while( s_index < s_size)
+   {
+      if( (utl_testRand() % 64) == 0)
+      {
+         s_run = (uint16_t)(1 + utl_testRand() % 8);
+         while( (s_run-- > 0) && (s_index < s_size))
+            pc_payload[s_index++] = 0;
+      }
+      else
+         pc_payload[s_index++] = (uint8_t)(1 + utl_testRand() % 255);
+   }
+
+}/*End testRandPayload*/
+
+static void testRoundTrip( uint16_t s_size)
+{
+   t_frameMsg t_msg;
+   uint8_t c_msgId   = (uint8_t)utl_testRand();
+   uint8_t c_version = (uint8_t)utl_testRand();
+   uint8_t c_seq     = (uint8_t)utl_testRand();
+   uint16_t s_raw;
+   uint16_t s_ref;
+   uint16_t s_index;
+   int16_t s_len;
+   t_frameError t_err;
+
+   s_raw = refRaw( c_msgId, c_version, c_seq, gac_payload, s_size, gac_raw);
+   s_ref = refCobs( gac_raw, s_raw, gac_ref);
+
+   s_len = utl_frameEncode( c_msgId,
+                            c_version,
+                            c_seq,
+                            gac_payload,
+                            s_size,
+                            gac_frame,
+                            sizeof( gac_frame));
+
+   UTL_TEST_CHECK( (s_len == s_ref + 2) && (s_len <=
+                   UTL_FRAME_MAX_ENCODED_SIZE( s_size)),
+                   "payload %u: encoded %d bytes, expected %u",
+                   s_size,
+                   s_len,
+                   s_ref + 2);
+   if( s_len != s_ref + 2)
+      return;
+
+   UTL_TEST_CHECK( (gac_frame[0] == UTL_FRAME_DELIM) && (gac_frame[s_len -
+                   1] == UTL_FRAME_DELIM) && (memcmp( &gac_frame[1],
+                   gac_ref, s_ref) == 0),
+                   "payload %u: frame differs from the COBS reference",
+                   s_size);
+
+   for( s_index = 1; s_index < s_len - 1; s_index++)
+   {
+      if( gac_frame[s_index] == UTL_FRAME_DELIM)
+      {
+         UTL_TEST_CHECK( false,
+                         "payload %u: delimiter inside the frame at %u",
+                         s_size,
+                         s_index);
+         break;
+      }
+   }
+
+   t_err = utl_frameDecode( &gac_frame[1], (uint16_t)(s_len - 2), &t_msg);
+   UTL_TEST_CHECK( (t_err == FRAME_PASSED) && (t_msg.c_msgId == c_msgId) &&
+                   (t_msg.c_version == c_version) && (t_msg.c_seq == c_seq)
+                   && (t_msg.s_size == s_size) && (memcmp( t_msg.pc_payload,
+                   gac_payload, s_size) == 0),
+                   "payload %u: round trip failed (%d)",
+                   s_size,
+                   t_err);
+
+}/*End testRoundTrip*/
+
+static void testCrc( void)
+{
+   const uint8_t ac_check[] = "123456789";
+   uint16_t s_crc;
+
+   s_crc = utl_crc16( 0xFFFF, ac_check, 9);
+   UTL_TEST_CHECK( s_crc == TEST_CRC_CHECK,
+                   "CRC of \"123456789\" is 0x%04X, expected 0x%04X",
+                   s_crc,
+                   TEST_CRC_CHECK);
+
+   /*------------------------------------------------------------------------*
+    * Running the CRC over the pieces gives the CRC of the whole.
+    *------------------------------------------------------------------------*/
+   s_crc = utl_crc16( utl_crc16( 0xFFFF, ac_check, 4), &ac_check[4], 5);
+   UTL_TEST_CHECK( s_crc == TEST_CRC_CHECK,
+                   "CRC in two pieces is 0x%04X",
+                   s_crc);
+
+}/*End testCrc*/
+
+static void testErrors( void)
+{
+   t_frameMsg t_msg;
+   uint16_t s_raw;
+   uint16_t s_ref;
+   uint16_t s_cut;
+   uint8_t c_byte;
+   int16_t s_len;
+   t_frameError t_err;
+
+   testRandPayload( gac_payload, 300);
+
+   /*------------------------------------------------------------------------*
+    * A flipped bit in either CRC byte, stuffed correctly so only the CRC
+    * check can catch it.
+    *------------------------------------------------------------------------*/
+   for( c_byte = 0; c_byte < UTL_FRAME_CRC_SIZE; c_byte++)
+   {
+      s_raw = refRaw( 1, 2, 3, gac_payload, 300, gac_raw);
+      gac_raw[s_raw - UTL_FRAME_CRC_SIZE + c_byte] ^= 0x10;
+      s_ref = refCobs( gac_raw, s_raw, gac_ref);
+
+      t_err = utl_frameDecode( gac_ref, s_ref, &t_msg);
+      UTL_TEST_CHECK( t_err == FRAME_CRC_ERROR,
+                      "flipped CRC byte %u decoded as %d",
+                      c_byte,
+                      t_err);
+   }
+
+   /*------------------------------------------------------------------------*
+    * Every truncation of a good frame is refused.
+    *------------------------------------------------------------------------*/
+   s_len = utl_frameEncode( 1,
+                            2,
+                            3,
+                            gac_payload,
+                            300,
+                            gac_ref,
+                            sizeof( gac_ref));
+   for( s_cut = 0; s_cut < (uint16_t)(s_len - 2); s_cut++)
+   {
+      memcpy( gac_frame, &gac_ref[1], s_cut);
+      t_err = utl_frameDecode( gac_frame, s_cut, &t_msg);
+      if( t_err == FRAME_PASSED)
+      {
+         UTL_TEST_CHECK( false,
+                         "frame cut to %u of %d bytes decoded",
+                         s_cut,
+                         s_len - 2);
+         break;
+      }
+   }
+
+   /*------------------------------------------------------------------------*
+    * Too short to hold a header and CRC, a code byte running past the end,
+    * and a delimiter inside the frame.
+    *------------------------------------------------------------------------*/
+   s_ref = refCobs( (const uint8_t *)"\x01\x02\x03\x04", 4, gac_ref);
+   UTL_TEST_CHECK( utl_frameDecode( gac_ref, s_ref, &t_msg) ==
+                   FRAME_INVALID_SIZE,
+                   "4 byte frame not refused as too short");
+   UTL_TEST_CHECK( utl_frameDecode( gac_ref, 0, &t_msg) ==
+                   FRAME_INVALID_SIZE,
+                   "empty frame not refused as too short");
+
+   memcpy( gac_frame, "\x09\x01\x02\x03\x04", 5);
+   UTL_TEST_CHECK( utl_frameDecode( gac_frame, 5, &t_msg) ==
+                   FRAME_DECODE_ERROR,
+                   "code byte past the end not refused");
+
+   memcpy( gac_frame, "\x03\x01\x02\x00\x03\x04\x05", 7);
+   UTL_TEST_CHECK( utl_frameDecode( gac_frame, 7, &t_msg) ==
+                   FRAME_DECODE_ERROR,
+                   "delimiter inside the frame not refused");
+
+   /*------------------------------------------------------------------------*
+    * The output has to hold the worst case encoding, one byte less is
+    * refused before anything is written.
+    *------------------------------------------------------------------------*/
+   memset( gac_frame, 0xA5, sizeof( gac_frame));
+   s_len = utl_frameEncode( 1,
+                            2,
+                            3,
+                            gac_payload,
+                            300,
+                            gac_frame,
+                            UTL_FRAME_MAX_ENCODED_SIZE( 300) - 1);
+   UTL_TEST_CHECK( (s_len == FRAME_INVALID_SIZE) && (gac_frame[0] == 0xA5),
+                   "encode into a short buffer returned %d",
+                   s_len);
+   UTL_TEST_CHECK( utl_frameEncode( 1, 2, 3, gac_payload, 300, gac_frame,
+                   UTL_FRAME_MAX_ENCODED_SIZE( 300)) > 0,
+                   "encode into a worst case buffer refused");
+
+   UTL_TEST_CHECK( (utl_frameEncode( 1, 2, 3, gac_payload, 1, NULL, 16) ==
+                   FRAME_NULL_PTR) && (utl_frameEncode( 1, 2, 3, NULL, 1,
+                   gac_frame, 16) == FRAME_NULL_PTR) && (utl_frameEncode( 1,
+                   2, 3, NULL, 0, gac_frame, 16) > 0) && (utl_frameDecode(
+                   NULL, 5, &t_msg) == FRAME_NULL_PTR) && (utl_frameDecode(
+                   gac_frame, 5, NULL) == FRAME_NULL_PTR),
+                   "NULL pointer checks");
+
+}/*End testErrors*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   /*------------------------------------------------------------------------*
+    * With the 5 bytes of header and CRC, 249 fills the first block exactly.
+    *------------------------------------------------------------------------*/
+   static const uint16_t as_sizes[] = {0, 1, 248, 249, 250, 251, 503, 504,
+                                       505, TEST_MAX_PAYLOAD};
+   uint16_t s_index;
+   uint16_t s_size;
+
+   testCrc();
+
+   for( s_index = 0; s_index < sizeof( as_sizes) / sizeof( uint16_t);
+   s_index++)
+   {
+      /*---------------------------------------------------------------------*
+       * All non-zero, so the blocks are as long as they get, then all zero.
+       *---------------------------------------------------------------------*/
+      memset( gac_payload, 0x5A, as_sizes[s_index]);
+      testRoundTrip( as_sizes[s_index]);
+      memset( gac_payload, 0x00, as_sizes[s_index]);
+      testRoundTrip( as_sizes[s_index]);
+   }
+
+   for( s_index = 0; s_index < TEST_RANDOM; s_index++)
+   {
+      s_size = (uint16_t)(utl_testRand() % (TEST_MAX_PAYLOAD + 1));
+      testRandPayload( gac_payload, s_size);
+      testRoundTrip( s_size);
+   }
+
+   testErrors();
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
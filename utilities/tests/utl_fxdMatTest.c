@@ -0,0 +1,272 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_fxdMatTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of the utl_fxdMat kernels, instantiated with the
+ *               shapes and Q formats drv_ins uses plus a few that take the
+ *               other unrolling paths. Every result is compared with the
+ *               exact product worked out in double and saturated to 16
+ *               bits. Each of the 'inner' products loses less than one unit
+ *               of 2^o when it is shifted down, and the final shift loses
+ *               less than one LSB, so the error must stay under
+ *               1 + inner*2^-(qa + qb - o - qRes) LSBs.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "utl_fxdMat.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_TRIALS   (2000)
+#define TEST_MAX_ELEM (81)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef void (*t_fxdKernel)( const int16_t *ps_a,
+                             const int16_t *ps_b,
+                             int16_t *ps_res);
+
+typedef struct
+{
+   const char *pc_name;
+   t_fxdKernel pf_kernel;
+   int8_t c_rows;
+   int8_t c_inner;
+   int8_t c_cols;
+   int8_t c_qa;
+   int8_t c_qb;
+   int8_t c_qRes;
+   int8_t c_o;
+
+   /*------------------------------------------------------------------------*
+    * ps_b is stored cols x inner.
+    *------------------------------------------------------------------------*/
+   bool b_transB;
+
+}t_fxdCase;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void testKernel( const t_fxdCase *pt_case);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The drv_ins kernels...
+ *---------------------------------------------------------------------------*/
+UTL_FXD_MAT_MULT( insMatMultPhiP, 9, 9, 9, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT_TRANS_B( insMatMultPhiPPhiT, 9, 9, 9, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT_TRANS_B( insMatMultPHT, 9, 3, 3, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT( insMatMultHPHT, 3, 3, 3, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT( insMatMultK, 9, 3, 3, 15, 10, 15, 0)
+UTL_FXD_MAT_MULT( insMatMultAttCorr, 3, 3, 1, 15, 15, 15, 1)
+UTL_FXD_MAT_MULT( insMatMultGyroCorr, 3, 3, 1, 15, 15, 15, 0)
+UTL_FXD_MAT_MULT( insMatMultKH, 9, 3, 3, 15, 15, 15, 0)
+UTL_FXD_MAT_MULT( insMatMultEyeMinusKHP, 9, 9, 9, 15, 15, 15, 2)
+UTL_FXD_MAT_MULT( insMatMultDcm, 3, 3, 3, 14, 14, 14, 0)
+
+/*---------------------------------------------------------------------------*
+ * ...and a single element, a kernel just over UTL_FXD_MAT_UNROLL_MAX, and
+ * mixed formats with headroom.
+ *---------------------------------------------------------------------------*/
+UTL_FXD_MAT_MULT( testMult1x1, 1, 1, 1, 15, 15, 15, 0)
+UTL_FXD_MAT_MULT( testMult4x2x4, 4, 2, 4, 12, 15, 12, 0)
+UTL_FXD_MAT_MULT_TRANS_B( testMultT2x7x3, 2, 7, 3, 13, 11, 9, 3)
+
+static const t_fxdCase gat_cases[] =
+{
+   {"insMatMultPhiP",        &insMatMultPhiP,        9, 9, 9, 15, 15, 15, 1,
+    false},
+   {"insMatMultPhiPPhiT",    &insMatMultPhiPPhiT,    9, 9, 9, 15, 15, 15, 1,
+    true},
+   {"insMatMultPHT",         &insMatMultPHT,         9, 3, 3, 15, 15, 15, 1,
+    true},
+   {"insMatMultHPHT",        &insMatMultHPHT,        3, 3, 3, 15, 15, 15, 1,
+    false},
+   {"insMatMultK",           &insMatMultK,           9, 3, 3, 15, 10, 15, 0,
+    false},
+   {"insMatMultAttCorr",     &insMatMultAttCorr,     3, 3, 1, 15, 15, 15, 1,
+    false},
+   {"insMatMultGyroCorr",    &insMatMultGyroCorr,    3, 3, 1, 15, 15, 15, 0,
+    false},
+   {"insMatMultKH",          &insMatMultKH,          9, 3, 3, 15, 15, 15, 0,
+    false},
+   {"insMatMultEyeMinusKHP", &insMatMultEyeMinusKHP, 9, 9, 9, 15, 15, 15, 2,
+    false},
+   {"insMatMultDcm",         &insMatMultDcm,         3, 3, 3, 14, 14, 14, 0,
+    false},
+   {"testMult1x1",           &testMult1x1,           1, 1, 1, 15, 15, 15, 0,
+    false},
+   {"testMult4x2x4",         &testMult4x2x4,         4, 2, 4, 12, 15, 12, 0,
+    false},
+   {"testMultT2x7x3",        &testMultT2x7x3,        2, 7, 3, 13, 11, 9, 3,
+    true}
+};
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The kernels leave it to the caller to keep the 32-bit accumulator from
+ * overflowing, so the inputs are limited to what 'inner' products of 2^-o
+ * can hold. Every fourth trial puts the inputs at that limit, where most
+ * results saturate.
+ *---------------------------------------------------------------------------*/
+static void testKernel( const t_fxdCase *pt_case)
+{
+   int16_t as_a[TEST_MAX_ELEM];
+   int16_t as_b[TEST_MAX_ELEM];
+   int16_t as_res[TEST_MAX_ELEM + 1];
+   int32_t i_limit;
+   int32_t i_index;
+   int32_t i_trial;
+   int32_t i_sizeA = pt_case->c_rows*pt_case->c_inner;
+   int32_t i_sizeB = pt_case->c_inner*pt_case->c_cols;
+   int8_t c_r;
+   int8_t c_c;
+   int8_t c_k;
+   int8_t c_shft;
+   double d_exact;
+   double d_err;
+   double d_worst = 0.0;
+   double d_bound;
+   bool b_saturated = false;
+   bool b_canSaturate;
+
+   c_shft  = pt_case->c_qa + pt_case->c_qb - pt_case->c_o - pt_case->c_qRes;
+   d_bound = 1.0 + pt_case->c_inner*ldexp( 1.0, -c_shft);
+
+   i_limit = (int32_t)sqrt( ldexp( 2147483647.0, pt_case->c_o) /
+   pt_case->c_inner);
+   if( i_limit > 32767)
+      i_limit = 32767;
+
+   b_canSaturate = (ldexp( (double)pt_case->c_inner*i_limit*i_limit,
+   -(c_shft + pt_case->c_o)) > 32767.0);
+
+   for( i_trial = 0; i_trial < TEST_TRIALS; i_trial++)
+   {
+      for( i_index = 0; i_index < i_sizeA; i_index++)
+      {
+         as_a[i_index] = (int16_t)((int32_t)(utl_testRand() % (2*i_limit +
+         1)) - i_limit);
+         if( (i_trial & 3) == 3)
+            as_a[i_index] = (as_a[i_index] < 0) ? -i_limit : i_limit;
+      }
+
+      for( i_index = 0; i_index < i_sizeB; i_index++)
+      {
+         as_b[i_index] = (int16_t)((int32_t)(utl_testRand() % (2*i_limit +
+         1)) - i_limit);
+         if( (i_trial & 3) == 3)
+            as_b[i_index] = (as_b[i_index] < 0) ? -i_limit : i_limit;
+      }
+
+      as_res[pt_case->c_rows*pt_case->c_cols] = 0x5A5A;
+
+      pt_case->pf_kernel( as_a, as_b, as_res);
+
+      for( c_r = 0; c_r < pt_case->c_rows; c_r++)
+      {
+         for( c_c = 0; c_c < pt_case->c_cols; c_c++)
+         {
+            d_exact = 0.0;
+            for( c_k = 0; c_k < pt_case->c_inner; c_k++)
+            {
+               if( pt_case->b_transB == true)
+                  d_exact += (double)as_a[c_r*pt_case->c_inner + c_k]*
+                  as_b[c_c*pt_case->c_inner + c_k];
+               else
+                  d_exact += (double)as_a[c_r*pt_case->c_inner + c_k]*
+                  as_b[c_k*pt_case->c_cols + c_c];
+            }
+
+            d_exact = ldexp( d_exact, -(c_shft + pt_case->c_o));
+
+            if( d_exact > 32767.0)
+            {
+               d_exact     = 32767.0;
+               b_saturated = true;
+            }
+            else if( d_exact < -32768.0)
+            {
+               d_exact     = -32768.0;
+               b_saturated = true;
+            }
+
+            d_err = fabs( as_res[c_r*pt_case->c_cols + c_c] - d_exact);
+            if( d_err > d_worst)
+               d_worst = d_err;
+         }
+      }
+
+      UTL_TEST_CHECK( as_res[pt_case->c_rows*pt_case->c_cols] == 0x5A5A,
+                      "%s wrote past its result",
+                      pt_case->pc_name);
+   }
+
+   /*------------------------------------------------------------------------*
+    * The bound is strict, reaching it means a rounding step went the wrong
+    * way.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_BOUND( pt_case->pc_name, d_worst, d_bound);
+   UTL_TEST_CHECK( d_worst < d_bound,
+                   "%s error reached the bound",
+                   pt_case->pc_name);
+
+   /*------------------------------------------------------------------------*
+    * Where the formats let a result pass 16 bits, the trials at the input
+    * limit get there.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( b_saturated == b_canSaturate,
+                   "%s saturated %d, expected %d",
+                   pt_case->pc_name,
+                   (int)b_saturated,
+                   (int)b_canSaturate);
+
+}/*End testKernel*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   uint8_t c_index;
+
+   for( c_index = 0; c_index < (sizeof( gat_cases) / sizeof( t_fxdCase));
+   c_index++)
+   {
+      testKernel( &gat_cases[c_index]);
+   }
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
@@ -0,0 +1,289 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_handleTableTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of utl_handleTable. Checks every error return of
+ *               insert and remove, that a removed slot can be reused, that
+ *               lookups outside the table return NULL, and runs a random
+ *               insert/remove sequence against a plain array.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "utl_handleTable.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_NUM_SLOTS (8)
+#define TEST_STEPS     (10000)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void testErrors( void);
+static void testReuse( void);
+static void testRandom( void);
+static void testGuard( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+UTL_HANDLE_TABLE_CREATE( gt_table, TEST_NUM_SLOTS);
+
+/*---------------------------------------------------------------------------*
+ * Stand-ins for the handles, only their addresses are used.
+ *---------------------------------------------------------------------------*/
+static int32_t gai_handles[TEST_NUM_SLOTS*2];
+
+/*---------------------------------------------------------------------------*
+ * Storage for a table that is one slot shorter than the array, the last
+ * entry is a guard that must never be returned.
+ *---------------------------------------------------------------------------*/
+static void *gapv_guardSlots[TEST_NUM_SLOTS + 1];
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void testErrors( void)
+{
+   uint16_t s_id;
+
+   /*------------------------------------------------------------------------*
+    * A new table is empty.
+    *------------------------------------------------------------------------*/
+   for( s_id = 0; s_id < TEST_NUM_SLOTS; s_id++)
+   {
+      UTL_TEST_CHECK( utl_getHandle( &gt_table, (uint8_t)s_id) == NULL,
+                      "slot %u not empty",
+                      s_id);
+   }
+
+   UTL_TEST_CHECK( utl_insertHandle( &gt_table, 0, NULL) ==
+                   HANDLE_TABLE_NULL_PTR,
+                   "NULL handle accepted");
+   UTL_TEST_CHECK( utl_getHandle( &gt_table, 0) == NULL,
+                   "NULL insert changed slot 0");
+
+   /*------------------------------------------------------------------------*
+    * The first ID past the end, and the largest ID, are refused and nothing
+    * is written.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_insertHandle( &gt_table,
+                                     TEST_NUM_SLOTS,
+                                     &gai_handles[0]) ==
+                   HANDLE_TABLE_INVALID_ID,
+                   "ID %u accepted",
+                   TEST_NUM_SLOTS);
+   UTL_TEST_CHECK( utl_insertHandle( &gt_table, 255, &gai_handles[0]) ==
+                   HANDLE_TABLE_INVALID_ID,
+                   "ID 255 accepted");
+   UTL_TEST_CHECK( gai_handles[0] == 0, "out of range insert wrote data");
+   UTL_TEST_CHECK( utl_removeHandle( &gt_table, TEST_NUM_SLOTS) ==
+                   HANDLE_TABLE_INVALID_ID,
+                   "remove of ID %u accepted",
+                   TEST_NUM_SLOTS);
+
+   /*------------------------------------------------------------------------*
+    * Lookups outside the table return NULL.
+    *------------------------------------------------------------------------*/
+   for( s_id = TEST_NUM_SLOTS; s_id < 256; s_id++)
+   {
+      UTL_TEST_CHECK( utl_getHandle( &gt_table, (uint8_t)s_id) == NULL,
+                      "lookup of ID %u not NULL",
+                      s_id);
+   }
+
+   /*------------------------------------------------------------------------*
+    * The last slot is valid, a second insert on it is refused and leaves the
+    * first handle in place.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_insertHandle( &gt_table,
+                                     TEST_NUM_SLOTS - 1,
+                                     &gai_handles[0]) ==
+                   HANDLE_TABLE_PASSED,
+                   "insert on the last slot failed");
+   UTL_TEST_CHECK( utl_insertHandle( &gt_table,
+                                     TEST_NUM_SLOTS - 1,
+                                     &gai_handles[1]) ==
+                   HANDLE_TABLE_SLOT_USED,
+                   "second insert on the last slot accepted");
+   UTL_TEST_CHECK( utl_getHandle( &gt_table, TEST_NUM_SLOTS - 1) ==
+                   &gai_handles[0],
+                   "second insert replaced the handle");
+   UTL_TEST_CHECK( utl_removeHandle( &gt_table, TEST_NUM_SLOTS - 1) ==
+                   HANDLE_TABLE_PASSED,
+                   "remove of the last slot failed");
+
+}/*End testErrors*/
+
+static void testReuse( void)
+{
+   uint16_t s_id;
+
+   for( s_id = 0; s_id < TEST_NUM_SLOTS; s_id++)
+   {
+      UTL_TEST_CHECK( utl_insertHandle( &gt_table,
+                                        (uint8_t)s_id,
+                                        &gai_handles[s_id]) ==
+                      HANDLE_TABLE_PASSED,
+                      "insert on slot %u failed",
+                      s_id);
+   }
+
+   /*------------------------------------------------------------------------*
+    * Removing one slot leaves its neighbours alone and frees it for a new
+    * handle.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_removeHandle( &gt_table, 3) == HANDLE_TABLE_PASSED,
+                   "remove of slot 3 failed");
+   UTL_TEST_CHECK( utl_getHandle( &gt_table, 3) == NULL,
+                   "slot 3 not cleared");
+   UTL_TEST_CHECK( utl_getHandle( &gt_table, 2) == &gai_handles[2] &&
+                   utl_getHandle( &gt_table, 4) == &gai_handles[4],
+                   "remove of slot 3 changed its neighbours");
+   UTL_TEST_CHECK( utl_insertHandle( &gt_table,
+                                     3,
+                                     &gai_handles[TEST_NUM_SLOTS]) ==
+                   HANDLE_TABLE_PASSED,
+                   "re-insert on slot 3 failed");
+   UTL_TEST_CHECK( utl_getHandle( &gt_table, 3) ==
+                   &gai_handles[TEST_NUM_SLOTS],
+                   "slot 3 doesn't hold the new handle");
+
+   /*------------------------------------------------------------------------*
+    * Removing an empty slot is harmless.
+    *------------------------------------------------------------------------*/
+   for( s_id = 0; s_id < TEST_NUM_SLOTS; s_id++)
+   {
+      utl_removeHandle( &gt_table, (uint8_t)s_id);
+      UTL_TEST_CHECK( utl_removeHandle( &gt_table, (uint8_t)s_id) ==
+                      HANDLE_TABLE_PASSED,
+                      "remove of empty slot %u failed",
+                      s_id);
+      UTL_TEST_CHECK( utl_getHandle( &gt_table, (uint8_t)s_id) == NULL,
+                      "slot %u not cleared",
+                      s_id);
+   }
+
+}/*End testReuse*/
+
+static void testRandom( void)
+{
+   void *apv_ref[TEST_NUM_SLOTS] = {NULL};
+   uint32_t i_step;
+   uint8_t c_id;
+   void *pv_handle;
+   t_handleTableError t_err;
+   t_handleTableError t_expect;
+
+   for( i_step = 0; i_step < TEST_STEPS; i_step++)
+   {
+      /*---------------------------------------------------------------------*
+       * Pick IDs a little past the end so the range check is hit as well.
+       *---------------------------------------------------------------------*/
+      c_id = (uint8_t)(utl_testRand() % (TEST_NUM_SLOTS + 2));
+
+      if( utl_testRand() & 1)
+      {
+         pv_handle = &gai_handles[utl_testRand() % (TEST_NUM_SLOTS*2)];
+         t_err     = utl_insertHandle( &gt_table, c_id, pv_handle);
+
+         if( c_id >= TEST_NUM_SLOTS)
+            t_expect = HANDLE_TABLE_INVALID_ID;
+         else if( apv_ref[c_id] != NULL)
+            t_expect = HANDLE_TABLE_SLOT_USED;
+         else
+         {
+            t_expect      = HANDLE_TABLE_PASSED;
+            apv_ref[c_id] = pv_handle;
+         }
+      }
+      else
+      {
+         t_err = utl_removeHandle( &gt_table, c_id);
+
+         if( c_id >= TEST_NUM_SLOTS)
+            t_expect = HANDLE_TABLE_INVALID_ID;
+         else
+         {
+            t_expect      = HANDLE_TABLE_PASSED;
+            apv_ref[c_id] = NULL;
+         }
+      }
+
+      UTL_TEST_CHECK( t_err == t_expect,
+                      "step %u: ID %u returned %d, expected %d",
+                      i_step,
+                      c_id,
+                      t_err,
+                      t_expect);
+
+      for( c_id = 0; c_id < TEST_NUM_SLOTS; c_id++)
+      {
+         UTL_TEST_CHECK( utl_getHandle( &gt_table, c_id) == apv_ref[c_id],
+                         "step %u: slot %u doesn't match",
+                         i_step,
+                         c_id);
+      }
+   }
+
+}/*End testRandom*/
+
+static void testGuard( void)
+{
+   t_handleTable t_table = {TEST_NUM_SLOTS, gapv_guardSlots};
+
+   gapv_guardSlots[TEST_NUM_SLOTS] = &gai_handles[0];
+
+   UTL_TEST_CHECK( utl_getHandle( &t_table, TEST_NUM_SLOTS) == NULL,
+                   "lookup of ID %u read past the table",
+                   TEST_NUM_SLOTS);
+   UTL_TEST_CHECK( utl_removeHandle( &t_table, TEST_NUM_SLOTS) ==
+                   HANDLE_TABLE_INVALID_ID,
+                   "remove of ID %u accepted",
+                   TEST_NUM_SLOTS);
+   UTL_TEST_CHECK( gapv_guardSlots[TEST_NUM_SLOTS] == &gai_handles[0],
+                   "remove of ID %u cleared the guard",
+                   TEST_NUM_SLOTS);
+
+}/*End testGuard*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   testErrors();
+   testReuse();
+   testRandom();
+   testGuard();
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
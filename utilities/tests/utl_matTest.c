@@ -0,0 +1,1315 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_matTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of the floating point matrix functions in
+ *               utl_math. Every result is checked against the same product
+ *               worked out in double. An element is allowed the usual
+ *               error bound of a float dot product, (n + 2)*eps times the
+ *               sum of |a*b| over its terms, and the worst ratio of error to
+ *               bound is reported for each function. The rank-1 updates are
+ *               also checked against the batch D'*D they replace in the
+ *               ellipsoid fit. The factorizations are checked the same way,
+ *               the factors multiplied back out against the original
+ *               matrix, and the solvers by their normwise backward error.
+ *               The eigensolver is held to its residual and orthogonality
+ *               and to the ordering and sign it promises.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include <float.h>
+#include "utl_math.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Largest dimension tried, enough to cover the four column blocks of the
+ * multiply kernel with every remainder.
+ *---------------------------------------------------------------------------*/
+#define TEST_MAX_DIM (13)
+#define TEST_MAX_ELEM (TEST_MAX_DIM*TEST_MAX_DIM)
+
+/*---------------------------------------------------------------------------*
+ * Written into outputs before a call, so elements a function shouldn't
+ * touch can be told apart.
+ *---------------------------------------------------------------------------*/
+#define TEST_SENTINEL (-12345.0f)
+
+/*---------------------------------------------------------------------------*
+ * Most rows folded into an accumulation.
+ *---------------------------------------------------------------------------*/
+#define TEST_MAX_ROWS (40)
+
+/*---------------------------------------------------------------------------*
+ * Largest system the solvers are tried on, utl_matInvF's limit.
+ *---------------------------------------------------------------------------*/
+#define TEST_MAX_SOLVE (9)
+#define TEST_SOLVE_ELEM (TEST_MAX_SOLVE*TEST_MAX_SOLVE)
+
+/*---------------------------------------------------------------------------*
+ * Random systems tried for each size.
+ *---------------------------------------------------------------------------*/
+#define TEST_SOLVE_TRIALS (200)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void randMat( float *pf_mat,
+                     int32_t i_numElements);
+static void fillMat( float *pf_mat,
+                     int32_t i_numElements,
+                     float f_value);
+static double elemError( float f_res,
+                         const float *pf_a,
+                         int32_t i_aStep,
+                         const float *pf_b,
+                         int32_t i_bStep,
+                         int32_t i_inner);
+static void testMult( double *pd_worst);
+static void testMultTransA( double *pd_worst);
+static void testSyrk( double *pd_worst);
+static void testAccumulate( double *pd_worst);
+static void testPack( void);
+static void randSpd( float *pf_mat,
+                     int32_t i_size);
+static void randEllipsoidDtd( float *pf_mat);
+static void randSymmetric( float *pf_mat,
+                           int32_t i_size);
+static double factorError( const double *pd_a,
+                           const double *pd_l,
+                           const double *pd_mid,
+                           const double *pd_r,
+                           int32_t i_size);
+static double solveError( const float *pf_mat,
+                          const float *pf_b,
+                          const float *pf_x,
+                          int32_t i_size);
+static void testChol( double *pd_factor,
+                      double *pd_solve);
+static void testLdlt( double *pd_factor,
+                      double *pd_solve);
+static void testLu( double *pd_factor,
+                    double *pd_solve);
+static void testInv( double *pd_worst);
+static void testEigs( double *pd_residual,
+                      double *pd_orthogonal);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void randMat( float *pf_mat,
+                     int32_t i_numElements)
+{
+   int32_t i_index;
+
+   for( i_index = 0; i_index < i_numElements; i_index++)
+      pf_mat[i_index] = (float)utl_testRandD( -4.0, 4.0);
+
+}/*End randMat*/
+
+static void fillMat( float *pf_mat,
+                     int32_t i_numElements,
+                     float f_value)
+{
+   int32_t i_index;
+
+   for( i_index = 0; i_index < i_numElements; i_index++)
+      pf_mat[i_index] = f_value;
+
+}/*End fillMat*/
+
+/*---------------------------------------------------------------------------*
+ * Error of one result element as a fraction of its bound. The dot product
+ * is a[0]*b[0] + a[step]*b[step] + ... over 'i_inner' terms.
+ *---------------------------------------------------------------------------*/
+static double elemError( float f_res,
+                         const float *pf_a,
+                         int32_t i_aStep,
+                         const float *pf_b,
+                         int32_t i_bStep,
+                         int32_t i_inner)
+{
+   double d_sum = 0.0;
+   double d_abs = 0.0;
+   int32_t i_k;
+
+   for( i_k = 0; i_k < i_inner; i_k++)
+   {
+      d_sum += (double)pf_a[i_k*i_aStep]*(double)pf_b[i_k*i_bStep];
+      d_abs += fabs( (double)pf_a[i_k*i_aStep]*(double)pf_b[i_k*i_bStep]);
+   }
+
+   if( d_abs == 0.0)
+      return (f_res == 0.0f) ? 0.0 : INFINITY;
+
+   return fabs( (double)f_res - d_sum) / ((i_inner + 2)*FLT_EPSILON*d_abs);
+
+}/*End elemError*/
+
+static void testMult( double *pd_worst)
+{
+   float af_a[TEST_MAX_ELEM];
+   float af_b[TEST_MAX_ELEM];
+   float af_res[TEST_MAX_ELEM + 1];
+   int32_t i_rows;
+   int32_t i_inner;
+   int32_t i_col;
+   int32_t i_r;
+   int32_t i_c;
+   double d_err;
+
+   for( i_rows = 1; i_rows <= TEST_MAX_DIM; i_rows++)
+   {
+      for( i_inner = 1; i_inner <= TEST_MAX_DIM; i_inner++)
+      {
+         for( i_col = 1; i_col <= TEST_MAX_DIM; i_col++)
+         {
+            randMat( af_a, i_rows*i_inner);
+            randMat( af_b, i_inner*i_col);
+            fillMat( af_res, TEST_MAX_ELEM + 1, TEST_SENTINEL);
+
+            UTL_TEST_CHECK( utl_matMultF( af_a, i_rows, i_inner, af_b,
+                            i_inner, i_col, af_res) == true,
+                            "%dx%d * %dx%d refused",
+                            (int)i_rows,
+                            (int)i_inner,
+                            (int)i_inner,
+                            (int)i_col);
+
+            for( i_r = 0; i_r < i_rows; i_r++)
+            {
+               for( i_c = 0; i_c < i_col; i_c++)
+               {
+                  d_err = elemError( af_res[i_r*i_col + i_c],
+                                     &af_a[i_r*i_inner],
+                                     1,
+                                     &af_b[i_c],
+                                     i_col,
+                                     i_inner);
+                  if( d_err > *pd_worst)
+                     *pd_worst = d_err;
+               }
+            }
+
+            UTL_TEST_CHECK( af_res[i_rows*i_col] == TEST_SENTINEL,
+                            "%dx%d result written past its end",
+                            (int)i_rows,
+                            (int)i_col);
+         }
+      }
+   }
+
+   /*------------------------------------------------------------------------*
+    * Inner dimensions that don't agree leave the result alone.
+    *------------------------------------------------------------------------*/
+   fillMat( af_res, TEST_MAX_ELEM, TEST_SENTINEL);
+   UTL_TEST_CHECK( (utl_matMultF( af_a, 3, 4, af_b, 3, 4, af_res) == false)
+                   && (af_res[0] == TEST_SENTINEL),
+                   "3x4 * 3x4 multiplied");
+
+}/*End testMult*/
+
+static void testMultTransA( double *pd_worst)
+{
+   float af_a[TEST_MAX_ELEM];
+   float af_b[TEST_MAX_ELEM];
+   float af_res[TEST_MAX_ELEM + 1];
+   int32_t i_rows;
+   int32_t i_colA;
+   int32_t i_colB;
+   int32_t i_r;
+   int32_t i_c;
+   double d_err;
+
+   for( i_rows = 1; i_rows <= TEST_MAX_DIM; i_rows++)
+   {
+      for( i_colA = 1; i_colA <= TEST_MAX_DIM; i_colA++)
+      {
+         for( i_colB = 1; i_colB <= TEST_MAX_DIM; i_colB++)
+         {
+            randMat( af_a, i_rows*i_colA);
+            randMat( af_b, i_rows*i_colB);
+            fillMat( af_res, TEST_MAX_ELEM + 1, TEST_SENTINEL);
+
+            UTL_TEST_CHECK( utl_matMultTransAF( af_a, i_rows, i_colA, af_b,
+                            i_rows, i_colB, af_res) == true,
+                            "%dx%d' * %dx%d refused",
+                            (int)i_rows,
+                            (int)i_colA,
+                            (int)i_rows,
+                            (int)i_colB);
+
+            /*---------------------------------------------------------------*
+             * Element (r,c) is column r of A dotted with column c of B.
+             *---------------------------------------------------------------*/
+            for( i_r = 0; i_r < i_colA; i_r++)
+            {
+               for( i_c = 0; i_c < i_colB; i_c++)
+               {
+                  d_err = elemError( af_res[i_r*i_colB + i_c],
+                                     &af_a[i_r],
+                                     i_colA,
+                                     &af_b[i_c],
+                                     i_colB,
+                                     i_rows);
+                  if( d_err > *pd_worst)
+                     *pd_worst = d_err;
+               }
+            }
+
+            UTL_TEST_CHECK( af_res[i_colA*i_colB] == TEST_SENTINEL,
+                            "%dx%d result written past its end",
+                            (int)i_colA,
+                            (int)i_colB);
+         }
+      }
+   }
+
+   fillMat( af_res, TEST_MAX_ELEM, TEST_SENTINEL);
+   UTL_TEST_CHECK( (utl_matMultTransAF( af_a, 3, 4, af_b, 4, 3, af_res) ==
+                   false) && (af_res[0] == TEST_SENTINEL),
+                   "3x4' * 4x3 multiplied");
+
+}/*End testMultTransA*/
+
+static void testSyrk( double *pd_worst)
+{
+   float af_a[TEST_MAX_ELEM];
+   float af_res[TEST_MAX_ELEM + 1];
+   int32_t i_rows;
+   int32_t i_col;
+   int32_t i_r;
+   int32_t i_c;
+   int32_t i_fill;
+   double d_err;
+
+   for( i_fill = 0; i_fill < 2; i_fill++)
+   {
+      for( i_rows = 1; i_rows <= TEST_MAX_DIM; i_rows++)
+      {
+         for( i_col = 1; i_col <= TEST_MAX_DIM; i_col++)
+         {
+            randMat( af_a, i_rows*i_col);
+            fillMat( af_res, TEST_MAX_ELEM + 1, TEST_SENTINEL);
+
+            utl_matSyrkF( af_a,
+                          i_rows,
+                          i_col,
+                          af_res,
+                          (bool)i_fill);
+
+            for( i_r = 0; i_r < i_col; i_r++)
+            {
+               for( i_c = i_r; i_c < i_col; i_c++)
+               {
+                  d_err = elemError( af_res[i_r*i_col + i_c],
+                                     &af_a[i_r],
+                                     i_col,
+                                     &af_a[i_c],
+                                     i_col,
+                                     i_rows);
+                  if( d_err > *pd_worst)
+                     *pd_worst = d_err;
+               }
+
+               /*------------------------------------------------------------*
+                * The lower triangle is an exact copy or left untouched.
+                *------------------------------------------------------------*/
+               for( i_c = 0; i_c < i_r; i_c++)
+               {
+                  UTL_TEST_CHECK( af_res[i_r*i_col + i_c] == (i_fill ?
+                                  af_res[i_c*i_col + i_r] : TEST_SENTINEL),
+                                  "%dx%d syrk lower (%d,%d) = %g, fill %d",
+                                  (int)i_rows,
+                                  (int)i_col,
+                                  (int)i_r,
+                                  (int)i_c,
+                                  af_res[i_r*i_col + i_c],
+                                  (int)i_fill);
+               }
+            }
+
+            UTL_TEST_CHECK( af_res[i_col*i_col] == TEST_SENTINEL,
+                            "%dx%d syrk written past its end",
+                            (int)i_col,
+                            (int)i_col);
+         }
+      }
+   }
+
+}/*End testSyrk*/
+
+/*---------------------------------------------------------------------------*
+ * Folds the rows of D in one at a time with utl_matSyrF and utl_matSprF,
+ * the way the ellipsoid fit builds D'*D one sample at a time, and compares
+ * with utl_matSyrkF on the whole of D. All three add the same products in
+ * the same order, so the streamed results are held to the batch one, not
+ * just to the reference.
+ *---------------------------------------------------------------------------*/
+static void testAccumulate( double *pd_worst)
+{
+   float af_d[TEST_MAX_ROWS*TEST_MAX_DIM];
+   float af_batch[TEST_MAX_ELEM];
+   float af_syr[TEST_MAX_ELEM + 1];
+   float af_spr[UTL_MATH_PACKED_SIZE( TEST_MAX_DIM) + 1];
+   float f_x;
+   float f_y;
+   float f_z;
+   int32_t i_rows;
+   int32_t i_col;
+   int32_t i_row;
+   int32_t i_r;
+   int32_t i_c;
+   bool b_exact;
+   double d_err;
+
+   for( i_col = 1; i_col <= TEST_MAX_DIM; i_col++)
+   {
+      for( i_rows = 1; i_rows <= TEST_MAX_ROWS; i_rows++)
+      {
+         /*------------------------------------------------------------------*
+          * Nine columns get the ellipsoid fit's rows, [x^2 y^2 z^2 2xy 2xz
+          * 2yz 2x 2y 2z] for a magnetometer reading on a skewed sphere.
+          *------------------------------------------------------------------*/
+         if( i_col == 9)
+         {
+            for( i_row = 0; i_row < i_rows; i_row++)
+            {
+               f_x = (float)utl_testRandD( -450.0, 550.0);
+               f_y = (float)utl_testRandD( -520.0, 480.0);
+               f_z = (float)utl_testRandD( -400.0, 600.0);
+
+               af_d[i_row*9 + 0] = f_x*f_x;
+               af_d[i_row*9 + 1] = f_y*f_y;
+               af_d[i_row*9 + 2] = f_z*f_z;
+               af_d[i_row*9 + 3] = 2*f_x*f_y;
+               af_d[i_row*9 + 4] = 2*f_x*f_z;
+               af_d[i_row*9 + 5] = 2*f_y*f_z;
+               af_d[i_row*9 + 6] = 2*f_x;
+               af_d[i_row*9 + 7] = 2*f_y;
+               af_d[i_row*9 + 8] = 2*f_z;
+            }
+         }
+         else
+            randMat( af_d, i_rows*i_col);
+
+         utl_matSyrkF( af_d, i_rows, i_col, af_batch, false);
+
+         fillMat( af_syr, i_col*i_col, 0.0f);
+         af_syr[i_col*i_col] = TEST_SENTINEL;
+
+         /*------------------------------------------------------------------*
+          * The lower triangle of the full matrix must be left alone.
+          *------------------------------------------------------------------*/
+         for( i_r = 1; i_r < i_col; i_r++)
+            for( i_c = 0; i_c < i_r; i_c++)
+               af_syr[i_r*i_col + i_c] = TEST_SENTINEL;
+
+         fillMat( af_spr, UTL_MATH_PACKED_SIZE( i_col), 0.0f);
+         af_spr[UTL_MATH_PACKED_SIZE( i_col)] = TEST_SENTINEL;
+
+         for( i_row = 0; i_row < i_rows; i_row++)
+         {
+            utl_matSyrF( &af_d[i_row*i_col], i_col, af_syr);
+            utl_matSprF( &af_d[i_row*i_col], i_col, af_spr);
+         }
+
+         b_exact = true;
+         for( i_r = 0; i_r < i_col; i_r++)
+         {
+            for( i_c = i_r; i_c < i_col; i_c++)
+            {
+               d_err = elemError( af_syr[i_r*i_col + i_c],
+                                  &af_d[i_r],
+                                  i_col,
+                                  &af_d[i_c],
+                                  i_col,
+                                  i_rows);
+               if( d_err > *pd_worst)
+                  *pd_worst = d_err;
+
+               /*------------------------------------------------------------*
+                * Packed (c,r) is the same sum as full (r,c).
+                *------------------------------------------------------------*/
+               if( (af_syr[i_r*i_col + i_c] != af_batch[i_r*i_col + i_c])
+                   || (af_spr[UTL_MATH_PACKED_IDX( i_c, i_r)] !=
+                   af_batch[i_r*i_col + i_c]))
+               {
+                  b_exact = false;
+               }
+            }
+
+            for( i_c = 0; i_c < i_r; i_c++)
+            {
+               if( af_syr[i_r*i_col + i_c] != TEST_SENTINEL)
+                  b_exact = false;
+            }
+         }
+
+         UTL_TEST_CHECK( b_exact == true,
+                         "%d rows of %d, streamed D'D differs from batch",
+                         (int)i_rows,
+                         (int)i_col);
+         UTL_TEST_CHECK( (af_syr[i_col*i_col] == TEST_SENTINEL) &&
+                         (af_spr[UTL_MATH_PACKED_SIZE( i_col)] ==
+                         TEST_SENTINEL),
+                         "%d rows of %d, written past the end",
+                         (int)i_rows,
+                         (int)i_col);
+      }
+   }
+
+}/*End testAccumulate*/
+
+/*---------------------------------------------------------------------------*
+ * Packing copies the lower triangle by rows, including in place.
+ *---------------------------------------------------------------------------*/
+static void testPack( void)
+{
+   float af_mat[TEST_MAX_ELEM];
+   float af_copy[TEST_MAX_ELEM];
+   float af_packed[UTL_MATH_PACKED_SIZE( TEST_MAX_DIM)];
+   int32_t i_size;
+   int32_t i_r;
+   int32_t i_c;
+   bool b_exact;
+
+   for( i_size = 1; i_size <= TEST_MAX_DIM; i_size++)
+   {
+      randMat( af_mat, i_size*i_size);
+      memcpy( (void *)af_copy, (void *)af_mat, i_size*i_size*sizeof(
+      float));
+
+      utl_matPackF( af_mat, i_size, af_packed);
+      utl_matPackF( af_mat, i_size, af_mat);
+
+      b_exact = true;
+      for( i_r = 0; i_r < i_size; i_r++)
+      {
+         for( i_c = 0; i_c <= i_r; i_c++)
+         {
+            if( (af_packed[UTL_MATH_PACKED_IDX( i_r, i_c)] !=
+                af_copy[i_r*i_size + i_c]) ||
+                (af_mat[UTL_MATH_PACKED_IDX( i_r, i_c)] !=
+                af_copy[i_r*i_size + i_c]))
+            {
+               b_exact = false;
+            }
+         }
+      }
+
+      UTL_TEST_CHECK( b_exact == true,
+                      "%dx%d packed wrong",
+                      (int)i_size,
+                      (int)i_size);
+   }
+
+}/*End testPack*/
+
+/*---------------------------------------------------------------------------*
+ * M'*M plus a little on the diagonal, with M scaled so the condition
+ * numbers run up to about 1e4.
+ *---------------------------------------------------------------------------*/
+static void randSpd( float *pf_mat,
+                     int32_t i_size)
+{
+   float af_m[TEST_SOLVE_ELEM];
+   int32_t i_index;
+
+   randMat( af_m, i_size*i_size);
+   for( i_index = 0; i_index < i_size*i_size; i_index++)
+      af_m[i_index] *= (float)pow( 10.0, utl_testRandD( -1.0, 1.0));
+
+   utl_matSyrkF( af_m, i_size, i_size, pf_mat, true);
+
+   for( i_index = 0; i_index < i_size; i_index++)
+      pf_mat[i_index*i_size + i_index] += 1.0e-2f;
+
+}/*End randSpd*/
+
+/*---------------------------------------------------------------------------*
+ * The 9x9 D'*D the ellipsoid fit solves, from 200 magnetometer readings.
+ *---------------------------------------------------------------------------*/
+static void randEllipsoidDtd( float *pf_mat)
+{
+   float af_d[9];
+   float f_x;
+   float f_y;
+   float f_z;
+   int32_t i_row;
+   int32_t i_c;
+
+   fillMat( pf_mat, 81, 0.0f);
+
+   for( i_row = 0; i_row < 200; i_row++)
+   {
+      f_x = (float)utl_testRandD( -450.0, 550.0);
+      f_y = (float)utl_testRandD( -520.0, 480.0);
+      f_z = (float)utl_testRandD( -400.0, 600.0);
+
+      af_d[0] = f_x*f_x;
+      af_d[1] = f_y*f_y;
+      af_d[2] = f_z*f_z;
+      af_d[3] = 2*f_x*f_y;
+      af_d[4] = 2*f_x*f_z;
+      af_d[5] = 2*f_y*f_z;
+      af_d[6] = 2*f_x;
+      af_d[7] = 2*f_y;
+      af_d[8] = 2*f_z;
+
+      utl_matSyrF( af_d, 9, pf_mat);
+   }
+
+   for( i_row = 1; i_row < 9; i_row++)
+      for( i_c = 0; i_c < i_row; i_c++)
+         pf_mat[i_row*9 + i_c] = pf_mat[i_c*9 + i_row];
+
+}/*End randEllipsoidDtd*/
+
+/*---------------------------------------------------------------------------*
+ * Symmetric and indefinite, the diagonal is large enough in magnitude that
+ * no leading minor comes close to singular.
+ *---------------------------------------------------------------------------*/
+static void randSymmetric( float *pf_mat,
+                           int32_t i_size)
+{
+   int32_t i_r;
+   int32_t i_c;
+
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
+      for( i_c = 0; i_c < i_r; i_c++)
+      {
+         pf_mat[i_r*i_size + i_c] = (float)utl_testRandD( -1.0, 1.0);
+         pf_mat[i_c*i_size + i_r] = pf_mat[i_r*i_size + i_c];
+      }
+
+      pf_mat[i_r*i_size + i_r] = (float)utl_testRandD( i_size, 2*i_size);
+      if( utl_testRand() & 1)
+         pf_mat[i_r*i_size + i_r] = -pf_mat[i_r*i_size + i_r];
+   }
+
+}/*End randSymmetric*/
+
+/*---------------------------------------------------------------------------*
+ * Error of L*Mid*R against A, element by element as a fraction of (n + 2)*
+ * eps times |L|*|Mid|*|R|. 'pd_mid' is diagonal, stored as a vector.
+ *---------------------------------------------------------------------------*/
+static double factorError( const double *pd_a,
+                           const double *pd_l,
+                           const double *pd_mid,
+                           const double *pd_r,
+                           int32_t i_size)
+{
+   double d_sum;
+   double d_abs;
+   double d_err;
+   double d_worst = 0.0;
+   int32_t i_r;
+   int32_t i_c;
+   int32_t i_k;
+
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
+      for( i_c = 0; i_c < i_size; i_c++)
+      {
+         d_sum = 0.0;
+         d_abs = 0.0;
+         for( i_k = 0; i_k < i_size; i_k++)
+         {
+            d_sum += pd_l[i_r*i_size + i_k]*pd_mid[i_k]*pd_r[i_k*i_size +
+            i_c];
+            d_abs += fabs( pd_l[i_r*i_size + i_k]*pd_mid[i_k]*pd_r[i_k*
+            i_size + i_c]);
+         }
+
+         d_err = fabs( pd_a[i_r*i_size + i_c] - d_sum);
+         if( d_err == 0.0)
+            continue;
+
+         d_err /= (i_size + 2)*FLT_EPSILON*d_abs;
+         if( d_err > d_worst)
+            d_worst = d_err;
+      }
+   }
+
+   return d_worst;
+
+}/*End factorError*/
+
+/*---------------------------------------------------------------------------*
+ * Normwise backward error of x, ||b - A*x|| / (||A||*||x|| + ||b||) in the
+ * infinity norm, as a multiple of n*eps. A backward stable solver keeps this
+ * a small constant however badly conditioned A is.
+ *---------------------------------------------------------------------------*/
+static double solveError( const float *pf_mat,
+                          const float *pf_b,
+                          const float *pf_x,
+                          int32_t i_size)
+{
+   double d_res = 0.0;
+   double d_normA = 0.0;
+   double d_normX = 0.0;
+   double d_normB = 0.0;
+   double d_sum;
+   double d_row;
+   int32_t i_r;
+   int32_t i_c;
+
+   for( i_r = 0; i_r < i_size; i_r++)
+   {
+      d_sum = pf_b[i_r];
+      d_row = 0.0;
+      for( i_c = 0; i_c < i_size; i_c++)
+      {
+         d_sum -= (double)pf_mat[i_r*i_size + i_c]*pf_x[i_c];
+         d_row += fabs( pf_mat[i_r*i_size + i_c]);
+      }
+
+      d_res   = fmax( d_res, fabs( d_sum));
+      d_normA = fmax( d_normA, d_row);
+      d_normX = fmax( d_normX, fabs( pf_x[i_r]));
+      d_normB = fmax( d_normB, fabs( pf_b[i_r]));
+   }
+
+   return d_res / ((d_normA*d_normX + d_normB)*i_size*FLT_EPSILON);
+
+}/*End solveError*/
+
+static void testChol( double *pd_factor,
+                      double *pd_solve)
+{
+   float af_a[TEST_SOLVE_ELEM];
+   float af_packed[UTL_MATH_PACKED_SIZE( TEST_MAX_SOLVE)];
+   float af_b[TEST_MAX_SOLVE];
+   float af_x[TEST_MAX_SOLVE];
+   double ad_a[TEST_SOLVE_ELEM];
+   double ad_l[TEST_SOLVE_ELEM];
+   double ad_lt[TEST_SOLVE_ELEM];
+   double ad_ones[TEST_MAX_SOLVE];
+   int32_t i_size;
+   int32_t i_trial;
+   int32_t i_r;
+   int32_t i_c;
+   bool b_passed;
+
+   for( i_r = 0; i_r < TEST_MAX_SOLVE; i_r++)
+      ad_ones[i_r] = 1.0;
+
+   for( i_size = 1; i_size <= TEST_MAX_SOLVE; i_size++)
+   {
+      for( i_trial = 0; i_trial < TEST_SOLVE_TRIALS; i_trial++)
+      {
+         if( (i_size == 9) && ((i_trial & 3) == 0))
+            randEllipsoidDtd( af_a);
+         else
+            randSpd( af_a, i_size);
+
+         randMat( af_b, i_size);
+
+         utl_matPackF( af_a, i_size, af_packed);
+         b_passed = utl_matCholF( af_packed, i_size);
+         UTL_TEST_CHECK( b_passed == true,
+                         "%dx%d positive definite matrix refused",
+                         (int)i_size,
+                         (int)i_size);
+         if( b_passed == false)
+            continue;
+
+         for( i_r = 0; i_r < i_size; i_r++)
+         {
+            for( i_c = 0; i_c < i_size; i_c++)
+            {
+               ad_a[i_r*i_size + i_c] = af_a[i_r*i_size + i_c];
+               ad_l[i_r*i_size + i_c] = (i_c <= i_r) ?
+               af_packed[UTL_MATH_PACKED_IDX( i_r, i_c)] : 0.0;
+               ad_lt[i_c*i_size + i_r] = ad_l[i_r*i_size + i_c];
+            }
+         }
+
+         *pd_factor = fmax( *pd_factor, factorError( ad_a,
+                                                     ad_l,
+                                                     ad_ones,
+                                                     ad_lt,
+                                                     i_size));
+
+         memcpy( (void *)af_x, (void *)af_b, i_size*sizeof( float));
+         utl_matCholSolveF( af_packed, i_size, af_x);
+         *pd_solve = fmax( *pd_solve, solveError( af_a,
+                                                  af_b,
+                                                  af_x,
+                                                  i_size));
+      }
+   }
+
+   /*------------------------------------------------------------------------*
+    * [1 2; 2 1] has eigenvalues 3 and -1.
+    *------------------------------------------------------------------------*/
+   af_packed[0] = 1.0f;
+   af_packed[1] = 2.0f;
+   af_packed[2] = 1.0f;
+   UTL_TEST_CHECK( utl_matCholF( af_packed, 2) == false,
+                   "indefinite matrix factored");
+
+}/*End testChol*/
+
+static void testLdlt( double *pd_factor,
+                      double *pd_solve)
+{
+   float af_a[TEST_SOLVE_ELEM];
+   float af_packed[UTL_MATH_PACKED_SIZE( TEST_MAX_SOLVE)];
+   float af_b[TEST_MAX_SOLVE];
+   float af_x[TEST_MAX_SOLVE];
+   double ad_a[TEST_SOLVE_ELEM];
+   double ad_l[TEST_SOLVE_ELEM];
+   double ad_lt[TEST_SOLVE_ELEM];
+   double ad_d[TEST_MAX_SOLVE];
+   int32_t i_size;
+   int32_t i_trial;
+   int32_t i_r;
+   int32_t i_c;
+   bool b_passed;
+
+   for( i_size = 1; i_size <= TEST_MAX_SOLVE; i_size++)
+   {
+      for( i_trial = 0; i_trial < TEST_SOLVE_TRIALS; i_trial++)
+      {
+         /*------------------------------------------------------------------*
+          * Half indefinite, half positive definite.
+          *------------------------------------------------------------------*/
+         if( i_trial & 1)
+            randSymmetric( af_a, i_size);
+         else
+            randSpd( af_a, i_size);
+
+         randMat( af_b, i_size);
+
+         utl_matPackF( af_a, i_size, af_packed);
+         b_passed = utl_matLdltF( af_packed, i_size);
+         UTL_TEST_CHECK( b_passed == true,
+                         "%dx%d symmetric matrix refused",
+                         (int)i_size,
+                         (int)i_size);
+         if( b_passed == false)
+            continue;
+
+         for( i_r = 0; i_r < i_size; i_r++)
+         {
+            ad_d[i_r] = af_packed[UTL_MATH_PACKED_IDX( i_r, i_r)];
+
+            for( i_c = 0; i_c < i_size; i_c++)
+            {
+               ad_a[i_r*i_size + i_c] = af_a[i_r*i_size + i_c];
+               if( i_c < i_r)
+                  ad_l[i_r*i_size + i_c] = af_packed[UTL_MATH_PACKED_IDX(
+                  i_r, i_c)];
+               else
+                  ad_l[i_r*i_size + i_c] = (i_c == i_r) ? 1.0 : 0.0;
+               ad_lt[i_c*i_size + i_r] = ad_l[i_r*i_size + i_c];
+            }
+         }
+
+         *pd_factor = fmax( *pd_factor, factorError( ad_a,
+                                                     ad_l,
+                                                     ad_d,
+                                                     ad_lt,
+                                                     i_size));
+
+         memcpy( (void *)af_x, (void *)af_b, i_size*sizeof( float));
+         utl_matLdltSolveF( af_packed, i_size, af_x);
+         *pd_solve = fmax( *pd_solve, solveError( af_a,
+                                                  af_b,
+                                                  af_x,
+                                                  i_size));
+      }
+   }
+
+   /*------------------------------------------------------------------------*
+    * [0 1; 1 0] is nonsingular but its first pivot is zero.
+    *------------------------------------------------------------------------*/
+   af_packed[0] = 0.0f;
+   af_packed[1] = 1.0f;
+   af_packed[2] = 0.0f;
+   UTL_TEST_CHECK( utl_matLdltF( af_packed, 2) == false,
+                   "zero pivot factored");
+
+}/*End testLdlt*/
+
+static void testLu( double *pd_factor,
+                    double *pd_solve)
+{
+   float af_a[TEST_SOLVE_ELEM];
+   float af_lu[TEST_SOLVE_ELEM];
+   float af_b[TEST_MAX_SOLVE];
+   float af_x[TEST_MAX_SOLVE];
+   double ad_pa[TEST_SOLVE_ELEM];
+   double ad_l[TEST_SOLVE_ELEM];
+   double ad_u[TEST_SOLVE_ELEM];
+   double ad_ones[TEST_MAX_SOLVE];
+   double d_temp;
+   int8_t ac_piv[TEST_MAX_SOLVE];
+   int32_t i_size;
+   int32_t i_trial;
+   int32_t i_r;
+   int32_t i_c;
+   bool b_passed;
+   bool b_pivOk;
+
+   for( i_r = 0; i_r < TEST_MAX_SOLVE; i_r++)
+      ad_ones[i_r] = 1.0;
+
+   for( i_size = 1; i_size <= TEST_MAX_SOLVE; i_size++)
+   {
+      for( i_trial = 0; i_trial < TEST_SOLVE_TRIALS; i_trial++)
+      {
+         randMat( af_a, i_size*i_size);
+         randMat( af_b, i_size);
+
+         memcpy( (void *)af_lu, (void *)af_a, i_size*i_size*sizeof( float));
+         b_passed = utl_matLuF( af_lu, i_size, ac_piv);
+         UTL_TEST_CHECK( b_passed == true,
+                         "%dx%d random matrix refused",
+                         (int)i_size,
+                         (int)i_size);
+         if( b_passed == false)
+            continue;
+
+         /*------------------------------------------------------------------*
+          * Apply the interchanges to A in the order they were made, and
+          * check partial pivoting kept every multiplier at most 1.
+          *------------------------------------------------------------------*/
+         b_pivOk = true;
+         for( i_r = 0; i_r < i_size*i_size; i_r++)
+            ad_pa[i_r] = af_a[i_r];
+
+         for( i_r = 0; i_r < i_size; i_r++)
+         {
+            if( (ac_piv[i_r] < i_r) || (ac_piv[i_r] >= i_size))
+            {
+               b_pivOk = false;
+               continue;
+            }
+
+            for( i_c = 0; i_c < i_size; i_c++)
+            {
+               d_temp = ad_pa[i_r*i_size + i_c];
+               ad_pa[i_r*i_size + i_c] = ad_pa[ac_piv[i_r]*i_size + i_c];
+               ad_pa[ac_piv[i_r]*i_size + i_c] = d_temp;
+            }
+         }
+
+         for( i_r = 0; i_r < i_size; i_r++)
+         {
+            for( i_c = 0; i_c < i_size; i_c++)
+            {
+               if( i_c < i_r)
+               {
+                  ad_l[i_r*i_size + i_c] = af_lu[i_r*i_size + i_c];
+                  ad_u[i_r*i_size + i_c] = 0.0;
+                  if( fabs( ad_l[i_r*i_size + i_c]) > 1.0)
+                     b_pivOk = false;
+               }
+               else
+               {
+                  ad_l[i_r*i_size + i_c] = (i_c == i_r) ? 1.0 : 0.0;
+                  ad_u[i_r*i_size + i_c] = af_lu[i_r*i_size + i_c];
+               }
+            }
+         }
+
+         UTL_TEST_CHECK( b_pivOk == true,
+                         "%dx%d pivots or multipliers out of range",
+                         (int)i_size,
+                         (int)i_size);
+
+         *pd_factor = fmax( *pd_factor, factorError( ad_pa,
+                                                     ad_l,
+                                                     ad_ones,
+                                                     ad_u,
+                                                     i_size));
+
+         memcpy( (void *)af_x, (void *)af_b, i_size*sizeof( float));
+         utl_matLuSolveF( af_lu, i_size, ac_piv, af_x);
+         *pd_solve = fmax( *pd_solve, solveError( af_a,
+                                                  af_b,
+                                                  af_x,
+                                                  i_size));
+      }
+   }
+
+   /*------------------------------------------------------------------------*
+    * A zero column can't be pivoted around.
+    *------------------------------------------------------------------------*/
+   randMat( af_lu, 9);
+   af_lu[1] = 0.0f;
+   af_lu[4] = 0.0f;
+   af_lu[7] = 0.0f;
+   UTL_TEST_CHECK( utl_matLuF( af_lu, 3, ac_piv) == false,
+                   "singular matrix factored");
+
+}/*End testLu*/
+
+/*---------------------------------------------------------------------------*
+ * ||A*inv(A) - I|| / (||A||*||inv(A)||) as a multiple of n*eps, in the
+ * infinity norm.
+ *---------------------------------------------------------------------------*/
+static void testInv( double *pd_worst)
+{
+   float af_a[(TEST_MAX_SOLVE + 1)*(TEST_MAX_SOLVE + 1)];
+   float af_copy[TEST_SOLVE_ELEM];
+   float af_inv[(TEST_MAX_SOLVE + 1)*(TEST_MAX_SOLVE + 1)];
+   double d_sum;
+   double d_res;
+   double d_row;
+   double d_normA;
+   double d_normInv;
+   int32_t i_size;
+   int32_t i_trial;
+   int32_t i_r;
+   int32_t i_c;
+   int32_t i_k;
+
+   for( i_size = 1; i_size <= TEST_MAX_SOLVE; i_size++)
+   {
+      for( i_trial = 0; i_trial < TEST_SOLVE_TRIALS; i_trial++)
+      {
+         randMat( af_a, i_size*i_size);
+         memcpy( (void *)af_copy, (void *)af_a, i_size*i_size*sizeof(
+         float));
+
+         UTL_TEST_CHECK( utl_matInvF( af_a, af_inv, i_size) == true,
+                         "%dx%d random matrix not inverted",
+                         (int)i_size,
+                         (int)i_size);
+         UTL_TEST_CHECK( memcmp( (void *)af_a, (void *)af_copy, i_size*
+                         i_size*sizeof( float)) == 0,
+                         "%dx%d input changed by the inverse",
+                         (int)i_size,
+                         (int)i_size);
+
+         d_res     = 0.0;
+         d_normA   = 0.0;
+         d_normInv = 0.0;
+         for( i_r = 0; i_r < i_size; i_r++)
+         {
+            d_row = 0.0;
+            for( i_c = 0; i_c < i_size; i_c++)
+            {
+               d_sum = (i_r == i_c) ? -1.0 : 0.0;
+               for( i_k = 0; i_k < i_size; i_k++)
+                  d_sum += (double)af_a[i_r*i_size + i_k]*af_inv[i_k*i_size +
+                  i_c];
+               d_row += fabs( d_sum);
+            }
+
+            d_res = fmax( d_res, d_row);
+
+            d_row = 0.0;
+            for( i_c = 0; i_c < i_size; i_c++)
+               d_row += fabs( af_a[i_r*i_size + i_c]);
+            d_normA = fmax( d_normA, d_row);
+
+            d_row = 0.0;
+            for( i_c = 0; i_c < i_size; i_c++)
+               d_row += fabs( af_inv[i_r*i_size + i_c]);
+            d_normInv = fmax( d_normInv, d_row);
+         }
+
+         *pd_worst = fmax( *pd_worst, d_res / (d_normA*d_normInv*i_size*
+         FLT_EPSILON));
+      }
+   }
+
+   /*------------------------------------------------------------------------*
+    * Larger than the internal scratch space, and singular.
+    *------------------------------------------------------------------------*/
+   randMat( af_a, (TEST_MAX_SOLVE + 1)*(TEST_MAX_SOLVE + 1));
+   UTL_TEST_CHECK( utl_matInvF( af_a, af_inv, TEST_MAX_SOLVE + 1) == false,
+                   "%dx%d inverted",
+                   TEST_MAX_SOLVE + 1,
+                   TEST_MAX_SOLVE + 1);
+
+   fillMat( af_a, 4, 1.0f);
+   af_a[1] = 0.0f;
+   af_a[3] = 0.0f;
+   UTL_TEST_CHECK( utl_matInvF( af_a, af_inv, 2) == false,
+                   "singular matrix inverted");
+
+}/*End testInv*/
+
+/*---------------------------------------------------------------------------*
+ * For A*V = V*diag(e), checks ||A*V - V*diag(e)|| / ||A|| and ||V'*V - I||
+ * as multiples of n*eps (max norm), plus the trace and Frobenius norm,
+ * which the eigenvalues have to reproduce.
+ *---------------------------------------------------------------------------*/
+static void testEigs( double *pd_residual,
+                      double *pd_orthogonal)
+{
+   float af_a[TEST_SOLVE_ELEM];
+   float af_work[TEST_SOLVE_ELEM];
+   float af_vect[TEST_SOLVE_ELEM];
+   float af_val[TEST_MAX_SOLVE];
+   float af_q[TEST_SOLVE_ELEM];
+   float af_temp[TEST_SOLVE_ELEM];
+   double d_sum;
+   double d_normA;
+   double d_res;
+   double d_orth;
+   double d_trace;
+   double d_frob;
+   int32_t i_size;
+   int32_t i_trial;
+   int32_t i_r;
+   int32_t i_c;
+   int32_t i_k;
+   bool b_order;
+
+   for( i_size = 1; i_size <= TEST_MAX_SOLVE; i_size++)
+   {
+      for( i_trial = 0; i_trial < TEST_SOLVE_TRIALS; i_trial++)
+      {
+         switch( i_trial & 3)
+         {
+            case 0:
+               randSymmetric( af_a, i_size);
+            break;
+
+            case 1:
+               randSpd( af_a, i_size);
+            break;
+
+            case 2:
+
+               /*------------------------------------------------------------*
+                * Q*diag*Q' with the eigenvalues drawn from {-1, 2}, so most
+                * of them repeat. Q is orthonormalized by Gram-Schmidt.
+                *------------------------------------------------------------*/
+               randMat( af_q, i_size*i_size);
+               for( i_c = 0; i_c < i_size; i_c++)
+               {
+                  for( i_k = 0; i_k < i_c; i_k++)
+                  {
+                     d_sum = 0.0;
+                     for( i_r = 0; i_r < i_size; i_r++)
+                        d_sum += (double)af_q[i_r*i_size + i_c]*af_q[i_r*
+                        i_size + i_k];
+                     for( i_r = 0; i_r < i_size; i_r++)
+                        af_q[i_r*i_size + i_c] -= (float)(d_sum*af_q[i_r*
+                        i_size + i_k]);
+                  }
+
+                  d_sum = 0.0;
+                  for( i_r = 0; i_r < i_size; i_r++)
+                     d_sum += (double)af_q[i_r*i_size + i_c]*af_q[i_r*i_size
+                     + i_c];
+                  for( i_r = 0; i_r < i_size; i_r++)
+                     af_q[i_r*i_size + i_c] /= (float)sqrt( d_sum);
+
+                  af_val[i_c] = (utl_testRand() & 1) ? 2.0f : -1.0f;
+               }
+
+               for( i_r = 0; i_r < i_size; i_r++)
+                  for( i_c = 0; i_c < i_size; i_c++)
+                     af_temp[i_r*i_size + i_c] = af_q[i_r*i_size + i_c]*
+                     af_val[i_c];
+
+               for( i_r = 0; i_r < i_size; i_r++)
+               {
+                  for( i_c = 0; i_c <= i_r; i_c++)
+                  {
+                     d_sum = 0.0;
+                     for( i_k = 0; i_k < i_size; i_k++)
+                        d_sum += (double)af_temp[i_r*i_size + i_k]*af_q[i_c*
+                        i_size + i_k];
+                     af_a[i_r*i_size + i_c] = (float)d_sum;
+                     af_a[i_c*i_size + i_r] = (float)d_sum;
+                  }
+               }
+            break;
+
+            default:
+
+               /*------------------------------------------------------------*
+                * Already diagonal, nothing to rotate.
+                *------------------------------------------------------------*/
+               fillMat( af_a, i_size*i_size, 0.0f);
+               for( i_r = 0; i_r < i_size; i_r++)
+                  af_a[i_r*i_size + i_r] = (float)utl_testRandD( -5.0, 5.0);
+            break;
+
+         }/*End switch( i_trial & 3)*/
+
+         memcpy( (void *)af_work, (void *)af_a, i_size*i_size*sizeof(
+         float));
+         UTL_TEST_CHECK( utl_matEigsF( af_work, i_size, af_val, af_vect) ==
+                         true,
+                         "%dx%d trial %d didn't converge",
+                         (int)i_size,
+                         (int)i_size,
+                         (int)i_trial);
+
+         d_normA = 0.0;
+         d_res   = 0.0;
+         d_orth  = 0.0;
+         d_trace = 0.0;
+         d_frob  = 0.0;
+         b_order = true;
+
+         for( i_r = 0; i_r < i_size; i_r++)
+         {
+            d_trace += af_a[i_r*i_size + i_r];
+            d_trace -= af_val[i_r];
+            d_frob  += (double)af_val[i_r]*af_val[i_r];
+
+            for( i_c = 0; i_c < i_size; i_c++)
+            {
+               d_normA = fmax( d_normA, fabs( af_a[i_r*i_size + i_c]));
+               d_frob -= (double)af_a[i_r*i_size + i_c]*af_a[i_r*i_size +
+               i_c];
+
+               d_sum = -(double)af_vect[i_r*i_size + i_c]*af_val[i_c];
+               for( i_k = 0; i_k < i_size; i_k++)
+                  d_sum += (double)af_a[i_r*i_size + i_k]*af_vect[i_k*i_size
+                  + i_c];
+               d_res = fmax( d_res, fabs( d_sum));
+
+               d_sum = (i_r == i_c) ? -1.0 : 0.0;
+               for( i_k = 0; i_k < i_size; i_k++)
+                  d_sum += (double)af_vect[i_k*i_size + i_r]*af_vect[i_k*
+                  i_size + i_c];
+               d_orth = fmax( d_orth, fabs( d_sum));
+            }
+
+            if( ((i_r > 0) && (af_val[i_r] < af_val[i_r - 1])) ||
+                (af_vect[i_r] < 0.0f))
+            {
+               b_order = false;
+            }
+         }
+
+         UTL_TEST_CHECK( b_order == true,
+                         "%dx%d trial %d not ascending or a vector starts "
+                         "negative",
+                         (int)i_size,
+                         (int)i_size,
+                         (int)i_trial);
+
+         /*------------------------------------------------------------------*
+          * The sums of the eigenvalues and their squares are the trace and
+          * the squared Frobenius norm.
+          *------------------------------------------------------------------*/
+         UTL_TEST_CHECK( (fabs( d_trace) <= 8*i_size*FLT_EPSILON*i_size*
+                         d_normA) && (fabs( d_frob) <= 8*i_size*FLT_EPSILON*
+                         i_size*i_size*d_normA*d_normA),
+                         "%dx%d trial %d trace off by %g, norm by %g",
+                         (int)i_size,
+                         (int)i_size,
+                         (int)i_trial,
+                         d_trace,
+                         d_frob);
+
+         if( d_normA > 0.0)
+            *pd_residual = fmax( *pd_residual, d_res / (d_normA*i_size*
+            FLT_EPSILON));
+         *pd_orthogonal = fmax( *pd_orthogonal, d_orth / (i_size*
+         FLT_EPSILON));
+      }
+   }
+
+}/*End testEigs*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   double d_worst;
+   double d_solve;
+
+   d_worst = 0.0;
+   testMult( &d_worst);
+   UTL_TEST_BOUND( "utl_matMultF", d_worst, 1.0);
+
+   d_worst = 0.0;
+   testMultTransA( &d_worst);
+   UTL_TEST_BOUND( "utl_matMultTransAF", d_worst, 1.0);
+
+   d_worst = 0.0;
+   testSyrk( &d_worst);
+   UTL_TEST_BOUND( "utl_matSyrkF", d_worst, 1.0);
+
+   d_worst = 0.0;
+   testAccumulate( &d_worst);
+   UTL_TEST_BOUND( "utl_matSyrF/utl_matSprF", d_worst, 1.0);
+
+   testPack();
+
+   /*------------------------------------------------------------------------*
+    * The factor bounds are the usual (n + 2)*eps*|L||D||R| ones. The solve
+    * bounds are a few n*eps, what the substitutions should stay within for
+    * any conditioning.
+    *------------------------------------------------------------------------*/
+   d_worst = 0.0;
+   d_solve = 0.0;
+   testChol( &d_worst, &d_solve);
+   UTL_TEST_BOUND( "utl_matCholF L*L'", d_worst, 1.0);
+   UTL_TEST_BOUND( "utl_matCholSolveF", d_solve, 4.0);
+
+   d_worst = 0.0;
+   d_solve = 0.0;
+   testLdlt( &d_worst, &d_solve);
+   UTL_TEST_BOUND( "utl_matLdltF L*D*L'", d_worst, 1.0);
+   UTL_TEST_BOUND( "utl_matLdltSolveF", d_solve, 4.0);
+
+   d_worst = 0.0;
+   d_solve = 0.0;
+   testLu( &d_worst, &d_solve);
+   UTL_TEST_BOUND( "utl_matLuF L*U", d_worst, 1.0);
+   UTL_TEST_BOUND( "utl_matLuSolveF", d_solve, 4.0);
+
+   d_worst = 0.0;
+   testInv( &d_worst);
+   UTL_TEST_BOUND( "utl_matInvF", d_worst, 4.0);
+
+   d_worst = 0.0;
+   d_solve = 0.0;
+   testEigs( &d_worst, &d_solve);
+   UTL_TEST_BOUND( "utl_matEigsF A*V - V*E", d_worst, 8.0);
+   UTL_TEST_BOUND( "utl_matEigsF V'*V - I", d_solve, 8.0);
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
@@ -0,0 +1,269 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_mathTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of the table based cos, log10 and alog10 against
+ *               libm. The bounds come from the _ERR defines written by
+ *               utlMathTables.py, so the test follows the ARB_MATH_* table
+ *               options the build is configured with. Over the range a
+ *               table covers directly, utl_math.c has to reach the error
+ *               the script found for it and not go past it. Outside that
+ *               range the bounds add what the mantissa/exponent split
+ *               costs.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include "utl_math.h"
+#include "utl_mathTables.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The _ERR defines are rounded up to 0.01 LSB.
+ *---------------------------------------------------------------------------*/
+#define TEST_ERR_ROUNDING (0.01)
+
+/*---------------------------------------------------------------------------*
+ * log10(2) in Q15 is 9864.15, utl_math.c uses 9864. Every power of two in
+ * the input or output moves the result by the difference.
+ *---------------------------------------------------------------------------*/
+#define TEST_LOG10_OF_2   (9864)
+#define TEST_LOG2_ERR     (0.151)
+
+/*---------------------------------------------------------------------------*
+ * utl_log10_32 truncates z when it shifts a large input down, z >= .5 so
+ * that is at most 32768*log10(1 + 1/16384) LSBs.
+ *---------------------------------------------------------------------------*/
+#define TEST_LOG10_Z_ERR  (0.87)
+
+/*---------------------------------------------------------------------------*
+ * The same difference moves the z of utl_alog10_32 by 9864.15/9864 per
+ * power of two, up to this many LSBs of a Q15 z.
+ *---------------------------------------------------------------------------*/
+#define TEST_ALOG10_Z_ERR (0.36)
+
+/*---------------------------------------------------------------------------*
+ * The largest alog10 input whose result fits in 32 bits.
+ *---------------------------------------------------------------------------*/
+#define TEST_ALOG10_MAX   (157800)
+#define TEST_ALOG10_MIN   (-147958)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void testTableErr( const char *pc_name,
+                          double d_worst,
+                          double d_tblErr);
+static void testCos( void);
+static void testLog10( void);
+static void testAlog10( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Over the inputs a table covers, the worst error has to be the one the
+ * script worked out, anything else means the C lookup and the script's
+ * copy of it no longer agree.
+ *---------------------------------------------------------------------------*/
+static void testTableErr( const char *pc_name,
+                          double d_worst,
+                          double d_tblErr)
+{
+
+   UTL_TEST_BOUND( pc_name, d_worst, d_tblErr);
+   UTL_TEST_CHECK( d_worst > (d_tblErr - TEST_ERR_ROUNDING),
+                   "%s error %g is below the generated %g",
+                   pc_name,
+                   d_worst,
+                   d_tblErr);
+
+}/*End testTableErr*/
+
+static void testCos( void)
+{
+   int32_t i_phase;
+   double d_exact;
+   double d_err;
+   double d_worst = 0.0;
+
+   for( i_phase = 0; i_phase < UTL_MATH_FXDPNT_TWO_PI_WRAP; i_phase++)
+   {
+      d_exact = 32768.0*cos( 2.0*M_PI*(double)i_phase /
+      (double)UTL_MATH_FXDPNT_TWO_PI_WRAP);
+      if( d_exact > 32767.0)
+         d_exact = 32767.0;
+
+      d_err = fabs( (double)utl_cos16_16( (uint16_t)i_phase) - d_exact);
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   testTableErr( "utl_cos16_16 (LSB)", d_worst, UTL_MATH_SINCOS_ERR);
+
+}/*End testCos*/
+
+static void testLog10( void)
+{
+   int64_t l_y;
+   int32_t i_m;
+   uint32_t i_temp;
+   double d_err;
+   double d_worst = 0.0;
+
+   /*------------------------------------------------------------------------*
+    * .5 <= z < 1 is looked up directly. z = 1 is only reached from a power
+    * of two below .5, 8192 is z = 1 with M = -2.
+    *------------------------------------------------------------------------*/
+   for( l_y = 16384; l_y < 32768; l_y++)
+   {
+      d_err = fabs( (double)utl_log10_32( (uint32_t)l_y) -
+      32768.0*log10( (double)l_y / 32768.0));
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   d_err = fabs( (double)(utl_log10_32( 8192) + 2*TEST_LOG10_OF_2));
+   if( d_err > d_worst)
+      d_worst = d_err;
+
+   testTableErr( "utl_log10_32 table (LSB)", d_worst, UTL_MATH_LOG10_ERR);
+
+   /*------------------------------------------------------------------------*
+    * The whole input range, in steps that keep the relative spacing about
+    * the same. The error is divided by its bound for the exponent M.
+    *------------------------------------------------------------------------*/
+   d_worst = 0.0;
+   for( l_y = 1; l_y <= 0xFFFFFFFFLL; l_y += 1 + (l_y >> 12))
+   {
+      i_m    = 0;
+      i_temp = (uint32_t)l_y;
+      while( i_temp > 32767)
+      {
+         i_m++;
+         i_temp = i_temp >> 1;
+      }
+
+      d_err = fabs( (double)utl_log10_32( (uint32_t)l_y) -
+      32768.0*log10( (double)l_y / 32768.0)) / (UTL_MATH_LOG10_ERR +
+      TEST_LOG2_ERR*(double)i_m + TEST_LOG10_Z_ERR);
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_log10_32 (x bound)", d_worst, 1.0);
+
+}/*End testLog10*/
+
+static void testAlog10( void)
+{
+   int32_t i_x;
+   int32_t i_m;
+   double d_exact;
+   double d_err;
+   double d_worst = 0.0;
+
+   /*------------------------------------------------------------------------*
+    * -log10(2) <= x <= 0 is looked up directly.
+    *------------------------------------------------------------------------*/
+   for( i_x = -TEST_LOG10_OF_2; i_x <= 0; i_x++)
+   {
+      d_err = fabs( (double)utl_alog10_32( i_x) -
+      32768.0*pow( 10.0, (double)i_x / 32768.0));
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   testTableErr( "utl_alog10_32 table (LSB)", d_worst, UTL_MATH_ALOG10_ERR);
+
+   /*------------------------------------------------------------------------*
+    * 0 < x <= log10(2) is 1/alog10(-x). The table entry is at least .5,
+    * so the division at most quadruples its error, plus the 32767/32768
+    * numerator and the truncation.
+    *------------------------------------------------------------------------*/
+   d_worst = 0.0;
+   for( i_x = 1; i_x <= TEST_LOG10_OF_2; i_x++)
+   {
+      d_err = fabs( (double)utl_alog10_32( i_x) -
+      32768.0*pow( 10.0, (double)i_x / 32768.0));
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_alog10_32 inverse (LSB)",
+                   d_worst,
+                   4.0*UTL_MATH_ALOG10_ERR + 3.0);
+
+   /*------------------------------------------------------------------------*
+    * Outside the table the result is scaled by 2^M, and so is the error,
+    * plus the truncation when M is negative.
+    *------------------------------------------------------------------------*/
+   d_worst = 0.0;
+   for( i_x = TEST_ALOG10_MIN; i_x <= TEST_ALOG10_MAX; i_x++)
+   {
+      if( (i_x >= -TEST_LOG10_OF_2) && (i_x <= TEST_LOG10_OF_2))
+         continue;
+
+      if( i_x > 0)
+         i_m = (i_x + TEST_LOG10_OF_2 - 1) / TEST_LOG10_OF_2;
+      else
+         i_m = -(-i_x / TEST_LOG10_OF_2);
+
+      d_exact = 32768.0*pow( 10.0, (double)i_x / 32768.0);
+      d_err   = fabs( (double)utl_alog10_32( i_x) - d_exact) /
+      (ldexp( UTL_MATH_ALOG10_ERR + TEST_ALOG10_Z_ERR*
+      fabs( (double)i_m), i_m) + 1.0);
+      if( d_err > d_worst)
+         d_worst = d_err;
+   }
+
+   UTL_TEST_BOUND( "utl_alog10_32 (x bound)", d_worst, 1.0);
+
+}/*End testAlog10*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+
+   testCos();
+   testLog10();
+   testAlog10();
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
@@ -0,0 +1,262 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_mulTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Bit exact test of the inline multiply primitives against
+ *               products worked out on 64-bit magnitudes. The operands are
+ *               every pairing of values built from the byte patterns the
+ *               8x8 hardware multiplies are most likely to get wrong, plus
+ *               random ones. UTL_MATH_MUL32_SPLIT is turned on so the four
+ *               product form of utl_mult32x32_32 is the one checked.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#define UTL_MATH_MUL32_SPLIT (1)
+#include "utl_math.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_TRIALS     (1000000)
+#define TEST_NUM_BYTES  (7)
+#define TEST_NUM_EDGE16 (TEST_NUM_BYTES*TEST_NUM_BYTES)
+#define TEST_NUM_HALVES (6)
+#define TEST_NUM_EDGE32 (TEST_NUM_HALVES*TEST_NUM_HALVES)
+
+/*---------------------------------------------------------------------------*
+ * Only the first few failures are printed, the count says how many more.
+ *---------------------------------------------------------------------------*/
+#define TEST_EXPECT( b, ...)                                                \
+do                                                                          \
+{                                                                           \
+   if( !(b))                                                                \
+   {                                                                        \
+      if( gi_fails < 10)                                                    \
+         UTL_TEST_CHECK( b, __VA_ARGS__);                                   \
+      gi_fails++;                                                           \
+   }                                                                        \
+}while( 0)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static int64_t testRound( int64_t l_product,
+                          int8_t c_n);
+static void testPair16( int16_t s_x1,
+                        int16_t s_x2);
+static void testPair32( int32_t i_x1,
+                        int32_t i_x2);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static const uint8_t gac_bytes[TEST_NUM_BYTES] =
+{
+   0x00, 0x01, 0x7F, 0x80, 0x81, 0xFE, 0xFF
+};
+
+static const uint16_t gas_halves[TEST_NUM_HALVES] =
+{
+   0x0000, 0x0001, 0x7FFF, 0x8000, 0x8001, 0xFFFF
+};
+
+/*---------------------------------------------------------------------------*
+ * Read through a volatile so utl_mult16x16_16 can't see the shift as a
+ * constant and take its FMULS form.
+ *---------------------------------------------------------------------------*/
+static volatile int8_t gc_q15 = 15;
+
+static int32_t gi_fails = 0;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Rounds the magnitude of a product to c_n fewer fractional bits, the way
+ * every multiply in utl_math.h does.
+ *---------------------------------------------------------------------------*/
+static int64_t testRound( int64_t l_product,
+                          int8_t c_n)
+{
+   uint64_t l_mag;
+
+   l_mag = (l_product < 0) ? (uint64_t)0 - (uint64_t)l_product :
+   (uint64_t)l_product;
+   l_mag = (l_mag + ((uint64_t)1 << (c_n - 1))) >> c_n;
+
+   return (l_product < 0) ? -(int64_t)l_mag : (int64_t)l_mag;
+
+}/*End testRound*/
+
+static void testPair16( int16_t s_x1,
+                        int16_t s_x2)
+{
+   int64_t l_product = (int64_t)s_x1*(int64_t)s_x2;
+   int32_t i_y = 0x5A5A5A5A;
+   int8_t c_n;
+
+   TEST_EXPECT( utl_muls16x16_32( s_x1, s_x2) == (int32_t)l_product,
+                "utl_muls16x16_32( %d, %d)",
+                s_x1,
+                s_x2);
+
+   /*------------------------------------------------------------------------*
+    * The product shifted up by one, -1*-1 wraps to the most negative value.
+    *------------------------------------------------------------------------*/
+   TEST_EXPECT( utl_fmuls16x16_32( s_x1, s_x2) ==
+                (int32_t)(uint32_t)((uint64_t)(l_product*2) & 0xFFFFFFFF),
+                "utl_fmuls16x16_32( %d, %d)",
+                s_x1,
+                s_x2);
+
+   TEST_EXPECT( utl_mulu16x16_32( (uint16_t)s_x1, (uint16_t)s_x2) ==
+                (uint32_t)((uint64_t)(uint16_t)s_x1*(uint64_t)(uint16_t)s_x2),
+                "utl_mulu16x16_32( %u, %u)",
+                (uint16_t)s_x1,
+                (uint16_t)s_x2);
+
+   /*------------------------------------------------------------------------*
+    * A literal 15 takes the FMULS form, the volatile one the MULS form.
+    *------------------------------------------------------------------------*/
+   TEST_EXPECT( utl_mult16x16_16( s_x1, s_x2, 15) ==
+                (int16_t)testRound( l_product, 15),
+                "utl_mult16x16_16( %d, %d, 15) FMULS",
+                s_x1,
+                s_x2);
+
+   TEST_EXPECT( utl_mult16x16_16( s_x1, s_x2, gc_q15) ==
+                (int16_t)testRound( l_product, 15),
+                "utl_mult16x16_16( %d, %d, 15) MULS",
+                s_x1,
+                s_x2);
+
+   for( c_n = 1; c_n < 16; c_n++)
+   {
+      TEST_EXPECT( utl_mult16x16_16( s_x1, s_x2, c_n) ==
+                   (int16_t)testRound( l_product, c_n),
+                   "utl_mult16x16_16( %d, %d, %d)",
+                   s_x1,
+                   s_x2,
+                   c_n);
+
+      TEST_EXPECT( utl_mult16x16_32( s_x1, s_x2, c_n) ==
+                   (int32_t)testRound( l_product, c_n),
+                   "utl_mult16x16_32( %d, %d, %d)",
+                   s_x1,
+                   s_x2,
+                   c_n);
+   }
+
+   /*------------------------------------------------------------------------*
+    * The accumulate truncates the magnitude instead of rounding it.
+    *------------------------------------------------------------------------*/
+   for( c_n = 0; c_n < 16; c_n++)
+   {
+      TEST_EXPECT( utl_mac16x16_32( s_x1, s_x2, i_y, c_n) ==
+                   (int32_t)(i_y + ((l_product < 0) ? -((-l_product) >> c_n) :
+                   (l_product >> c_n))),
+                   "utl_mac16x16_32( %d, %d, %d)",
+                   s_x1,
+                   s_x2,
+                   c_n);
+   }
+
+}/*End testPair16*/
+
+static void testPair32( int32_t i_x1,
+                        int32_t i_x2)
+{
+   int64_t l_product = (int64_t)i_x1*(int64_t)i_x2;
+   int8_t c_n;
+
+   /*------------------------------------------------------------------------*
+    * Results past 32 bits keep their low word in both forms.
+    *------------------------------------------------------------------------*/
+   for( c_n = 1; c_n < 32; c_n++)
+   {
+      TEST_EXPECT( utl_mult32x32_32( i_x1, i_x2, c_n) ==
+                   (int32_t)(uint32_t)((uint64_t)testRound( l_product, c_n) &
+                   0xFFFFFFFF),
+                   "utl_mult32x32_32( %ld, %ld, %d)",
+                   (long)i_x1,
+                   (long)i_x2,
+                   c_n);
+   }
+
+}/*End testPair32*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   int32_t i_trial;
+   int16_t s_i;
+   int16_t s_j;
+   int16_t as_edge16[TEST_NUM_EDGE16];
+   int32_t ai_edge32[TEST_NUM_EDGE32];
+
+   for( s_i = 0; s_i < TEST_NUM_EDGE16; s_i++)
+   {
+      as_edge16[s_i] = (int16_t)(((uint16_t)gac_bytes[s_i / TEST_NUM_BYTES]
+      << 8) | gac_bytes[s_i % TEST_NUM_BYTES]);
+   }
+
+   for( s_i = 0; s_i < TEST_NUM_EDGE32; s_i++)
+   {
+      ai_edge32[s_i] = (int32_t)(((uint32_t)gas_halves[s_i /
+      TEST_NUM_HALVES] << 16) | gas_halves[s_i % TEST_NUM_HALVES]);
+   }
+
+   for( s_i = 0; s_i < TEST_NUM_EDGE16; s_i++)
+   {
+      for( s_j = 0; s_j < TEST_NUM_EDGE16; s_j++)
+         testPair16( as_edge16[s_i], as_edge16[s_j]);
+   }
+
+   for( s_i = 0; s_i < TEST_NUM_EDGE32; s_i++)
+   {
+      for( s_j = 0; s_j < TEST_NUM_EDGE32; s_j++)
+         testPair32( ai_edge32[s_i], ai_edge32[s_j]);
+   }
+
+   for( i_trial = 0; i_trial < TEST_TRIALS; i_trial++)
+   {
+      testPair16( utl_testRand16(), utl_testRand16());
+      testPair32( (int32_t)utl_testRand(), (int32_t)utl_testRand());
+   }
+
+   UTL_TEST_CHECK( gi_fails == 0,
+                   "%ld products differ from the exact ones",
+                   (long)gi_fails);
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
@@ -0,0 +1,491 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_ringTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of utl_ring. Random sequences of byte, block and
+ *               span operations are run against utl_ring and a plain modulo
+ *               ring at the same time, and the data, levels and spans of the
+ *               two must agree after every step. The free-running indices
+ *               are started just below 65535 so they wrap during the run,
+ *               and the full and empty edges are checked explicitly.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include "utl_ring.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_MAX_RING (UTL_RING_MAX_SIZE)
+#define TEST_STEPS    (100000)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * The reference, a ring that keeps a separate count and wraps with '%'.
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   int8_t ac_data[TEST_MAX_RING];
+   uint32_t i_size;
+   uint32_t i_head;
+   uint32_t i_count;
+
+   /*------------------------------------------------------------------------*
+    * Bytes ever written, in 32 bits so it doesn't wrap with the ring's.
+    *------------------------------------------------------------------------*/
+   uint32_t i_total;
+
+}t_refRing;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void refWrite( t_refRing *pt_ref,
+                      int8_t c_byte);
+static int8_t refRead( t_refRing *pt_ref);
+static void checkLevels( t_ring *pt_ring,
+                         t_refRing *pt_ref,
+                         uint32_t i_step);
+static void testInitErrors( void);
+static void testEdges( uint16_t s_size);
+static void testRandom( uint16_t s_size,
+                        uint16_t s_startIndex,
+                        uint32_t i_steps);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static int8_t gac_storage[TEST_MAX_RING];
+static int8_t gac_block[2*TEST_MAX_RING];
+static t_refRing gt_ref;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void refWrite( t_refRing *pt_ref,
+                      int8_t c_byte)
+{
+   pt_ref->ac_data[(pt_ref->i_head + pt_ref->i_count) % pt_ref->i_size] =
+   c_byte;
+   pt_ref->i_count++;
+   pt_ref->i_total++;
+
+}/*End refWrite*/
+
+static int8_t refRead( t_refRing *pt_ref)
+{
+   int8_t c_byte = pt_ref->ac_data[pt_ref->i_head];
+
+   pt_ref->i_head = (pt_ref->i_head + 1) % pt_ref->i_size;
+   pt_ref->i_count--;
+
+   return c_byte;
+
+}/*End refRead*/
+
+static void checkLevels( t_ring *pt_ring,
+                         t_refRing *pt_ref,
+                         uint32_t i_step)
+{
+   UTL_TEST_CHECK( utl_ringGetFullLevel( pt_ring) == pt_ref->i_count,
+                   "step %u: full level %u, expected %u",
+                   i_step,
+                   utl_ringGetFullLevel( pt_ring),
+                   pt_ref->i_count);
+   UTL_TEST_CHECK( utl_ringGetEmptyLevel( pt_ring) == (pt_ref->i_size -
+                   pt_ref->i_count),
+                   "step %u: empty level %u, expected %u",
+                   i_step,
+                   utl_ringGetEmptyLevel( pt_ring),
+                   pt_ref->i_size - pt_ref->i_count);
+   UTL_TEST_CHECK( utl_ringIsEmpty( pt_ring) == (pt_ref->i_count == 0),
+                   "step %u: empty flag",
+                   i_step);
+   UTL_TEST_CHECK( utl_ringIsFull( pt_ring) == (pt_ref->i_count ==
+                   pt_ref->i_size),
+                   "step %u: full flag",
+                   i_step);
+
+}/*End checkLevels*/
+
+static void testInitErrors( void)
+{
+   t_ring t_ring;
+
+   UTL_TEST_CHECK( utl_ringInit( NULL, gac_storage, 16) == RING_NULL_PTR,
+                   "NULL ring accepted");
+   UTL_TEST_CHECK( utl_ringInit( &t_ring, NULL, 16) == RING_NULL_PTR,
+                   "NULL storage accepted");
+   UTL_TEST_CHECK( utl_ringInit( &t_ring, gac_storage, 0) ==
+                   RING_INVALID_SIZE,
+                   "size 0 accepted");
+   UTL_TEST_CHECK( utl_ringInit( &t_ring, gac_storage, 24) ==
+                   RING_INVALID_SIZE,
+                   "size 24 accepted");
+   UTL_TEST_CHECK( utl_ringInit( &t_ring, gac_storage, UTL_RING_MAX_SIZE + 1)
+                   == RING_INVALID_SIZE,
+                   "size %u accepted",
+                   UTL_RING_MAX_SIZE + 1);
+   UTL_TEST_CHECK( utl_ringInit( &t_ring, gac_storage, UTL_RING_MAX_SIZE) ==
+                   RING_PASSED,
+                   "size %u rejected",
+                   UTL_RING_MAX_SIZE);
+
+}/*End testInitErrors*/
+
+static void testEdges( uint16_t s_size)
+{
+   t_ring t_ring;
+   int8_t *pc_span;
+   uint16_t s_index;
+   uint16_t s_span;
+
+   utl_ringInit( &t_ring, gac_storage, s_size);
+
+   /*------------------------------------------------------------------------*
+    * Empty, nothing can be read.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_ringReadBlock( &t_ring, gac_block, s_size) == 0,
+                   "size %u: read from an empty ring",
+                   s_size);
+   UTL_TEST_CHECK( utl_ringPeekRead( &t_ring, &pc_span) == 0,
+                   "size %u: read span on an empty ring",
+                   s_size);
+
+   /*------------------------------------------------------------------------*
+    * Filled one byte at a time, the last write must be refused.
+    *------------------------------------------------------------------------*/
+   for( s_index = 0; s_index < s_size; s_index++)
+   {
+      UTL_TEST_CHECK( utl_ringWriteByte( &t_ring, (int8_t)s_index) == true,
+                      "size %u: write %u refused",
+                      s_size,
+                      s_index);
+   }
+
+   UTL_TEST_CHECK( utl_ringIsFull( &t_ring) == true,
+                   "size %u: not full",
+                   s_size);
+   UTL_TEST_CHECK( utl_ringWriteByte( &t_ring, 0) == false,
+                   "size %u: write to a full ring",
+                   s_size);
+   UTL_TEST_CHECK( utl_ringWriteBlock( &t_ring, gac_block, 1) == 0,
+                   "size %u: block write to a full ring",
+                   s_size);
+   UTL_TEST_CHECK( utl_ringPeekWrite( &t_ring, &pc_span) == 0,
+                   "size %u: write span on a full ring",
+                   s_size);
+
+   /*------------------------------------------------------------------------*
+    * A full ring that hasn't wrapped is one span.
+    *------------------------------------------------------------------------*/
+   s_span = utl_ringPeekRead( &t_ring, &pc_span);
+   UTL_TEST_CHECK( (s_span == s_size) && (pc_span == gac_storage),
+                   "size %u: read span %u on a full ring",
+                   s_size,
+                   s_span);
+
+   /*------------------------------------------------------------------------*
+    * Oversized block read is clamped to what is there.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_ringReadBlock( &t_ring, gac_block, s_size + 1) ==
+                   s_size,
+                   "size %u: block read not clamped",
+                   s_size);
+
+   for( s_index = 0; s_index < s_size; s_index++)
+   {
+      UTL_TEST_CHECK( gac_block[s_index] == (int8_t)s_index,
+                      "size %u: byte %u out of order",
+                      s_size,
+                      s_index);
+   }
+
+   UTL_TEST_CHECK( utl_ringIsEmpty( &t_ring) == true,
+                   "size %u: not empty after draining",
+                   s_size);
+
+   /*------------------------------------------------------------------------*
+    * Reset drops whatever is queued.
+    *------------------------------------------------------------------------*/
+   utl_ringWriteByte( &t_ring, 1);
+   utl_resetRing( &t_ring);
+   UTL_TEST_CHECK( utl_ringIsEmpty( &t_ring) == true,
+                   "size %u: not empty after reset",
+                   s_size);
+
+}/*End testEdges*/
+
+static void testRandom( uint16_t s_size,
+                        uint16_t s_startIndex,
+                        uint32_t i_steps)
+{
+   t_ring t_ring;
+   int8_t *pc_span;
+   uint32_t i_step;
+   uint32_t i_expect;
+   uint16_t s_req;
+   uint16_t s_got;
+   uint16_t s_index;
+   int8_t c_byte;
+   int i_failures = gi_testFailures;
+
+   utl_ringInit( &t_ring, gac_storage, s_size);
+
+   /*------------------------------------------------------------------------*
+    * Start both indices close to the top so they wrap during the run.
+    *------------------------------------------------------------------------*/
+   t_ring.s_wrIndex = s_startIndex;
+   t_ring.s_rdIndex = s_startIndex;
+
+   gt_ref.i_size  = s_size;
+   gt_ref.i_head  = s_startIndex % s_size;
+   gt_ref.i_count = 0;
+   gt_ref.i_total = 0;
+
+   for( i_step = 0; i_step < i_steps; i_step++)
+   {
+      /*---------------------------------------------------------------------*
+       * Requests are up to twice the ring size, so clamping is exercised.
+       *---------------------------------------------------------------------*/
+      s_req = (uint16_t)(utl_testRand() % (2*(uint32_t)s_size + 1));
+
+      switch( utl_testRand() % 7)
+      {
+         case 0:
+
+            c_byte = (int8_t)utl_testRand();
+            UTL_TEST_CHECK( utl_ringWriteByte( &t_ring, c_byte) ==
+                            (gt_ref.i_count < s_size),
+                            "step %u: write byte result",
+                            i_step);
+            if( gt_ref.i_count < s_size)
+               refWrite( &gt_ref, c_byte);
+
+         break;/*End case 0:*/
+
+         case 1:
+
+            if( gt_ref.i_count > 0)
+            {
+               c_byte = utl_ringReadByte( &t_ring);
+               UTL_TEST_CHECK( c_byte == refRead( &gt_ref),
+                               "step %u: read byte data",
+                               i_step);
+            }
+
+         break;/*End case 1:*/
+
+         case 2:
+
+            for( s_index = 0; s_index < s_req; s_index++)
+               gac_block[s_index] = (int8_t)utl_testRand();
+
+            i_expect = s_size - gt_ref.i_count;
+            if( i_expect > s_req)
+               i_expect = s_req;
+
+            s_got = utl_ringWriteBlock( &t_ring, gac_block, s_req);
+            UTL_TEST_CHECK( s_got == i_expect,
+                            "step %u: block write %u of %u, expected %u",
+                            i_step,
+                            s_got,
+                            s_req,
+                            i_expect);
+
+            for( s_index = 0; s_index < s_got; s_index++)
+               refWrite( &gt_ref, gac_block[s_index]);
+
+         break;/*End case 2:*/
+
+         case 3:
+
+            i_expect = gt_ref.i_count;
+            if( i_expect > s_req)
+               i_expect = s_req;
+
+            s_got = utl_ringReadBlock( &t_ring, gac_block, s_req);
+            UTL_TEST_CHECK( s_got == i_expect,
+                            "step %u: block read %u of %u, expected %u",
+                            i_step,
+                            s_got,
+                            s_req,
+                            i_expect);
+
+            for( s_index = 0; s_index < s_got; s_index++)
+            {
+               UTL_TEST_CHECK( gac_block[s_index] == refRead( &gt_ref),
+                               "step %u: block read data at %u",
+                               i_step,
+                               s_index);
+            }
+
+         break;/*End case 3:*/
+
+         case 4:
+
+            /*---------------------------------------------------------------*
+             * The span runs to the end of the storage or the first byte in
+             * use, whichever is closer.
+             *---------------------------------------------------------------*/
+            i_expect = s_size - ((gt_ref.i_head + gt_ref.i_count) % s_size);
+            if( i_expect > (s_size - gt_ref.i_count))
+               i_expect = s_size - gt_ref.i_count;
+
+            s_got = utl_ringPeekWrite( &t_ring, &pc_span);
+            UTL_TEST_CHECK( (s_got == i_expect) && (pc_span == &gac_storage[
+                            (gt_ref.i_head + gt_ref.i_count) % s_size]),
+                            "step %u: write span %u, expected %u",
+                            i_step,
+                            s_got,
+                            i_expect);
+
+            /*---------------------------------------------------------------*
+             * Commit part of it, as a DMA transfer that stopped early would.
+             *---------------------------------------------------------------*/
+            if( s_got > 0)
+            {
+               s_got = (uint16_t)(utl_testRand() % (s_got + 1));
+               for( s_index = 0; s_index < s_got; s_index++)
+               {
+                  pc_span[s_index] = (int8_t)utl_testRand();
+                  refWrite( &gt_ref, pc_span[s_index]);
+               }
+
+               utl_ringCommitWrite( &t_ring, s_got);
+            }
+
+         break;/*End case 4:*/
+
+         case 5:
+
+            i_expect = s_size - gt_ref.i_head;
+            if( i_expect > gt_ref.i_count)
+               i_expect = gt_ref.i_count;
+
+            s_got = utl_ringPeekRead( &t_ring, &pc_span);
+            UTL_TEST_CHECK( (s_got == i_expect) && (pc_span ==
+                            &gac_storage[gt_ref.i_head]),
+                            "step %u: read span %u, expected %u",
+                            i_step,
+                            s_got,
+                            i_expect);
+
+            if( s_got > 0)
+            {
+               s_got = (uint16_t)(utl_testRand() % (s_got + 1));
+               for( s_index = 0; s_index < s_got; s_index++)
+               {
+                  UTL_TEST_CHECK( pc_span[s_index] == refRead( &gt_ref),
+                                  "step %u: read span data at %u",
+                                  i_step,
+                                  s_index);
+               }
+
+               utl_ringCommitRead( &t_ring, s_got);
+            }
+
+         break;/*End case 5:*/
+
+         default:
+
+            /*---------------------------------------------------------------*
+             * Now and then drain or fill the ring completely, so runs of
+             * both edges show up no matter the size.
+             *---------------------------------------------------------------*/
+            if( utl_testRand() & 1)
+            {
+               while( gt_ref.i_count < s_size)
+               {
+                  c_byte = (int8_t)utl_testRand();
+                  utl_ringWriteByte( &t_ring, c_byte);
+                  refWrite( &gt_ref, c_byte);
+               }
+            }
+            else
+            {
+               while( gt_ref.i_count > 0)
+               {
+                  UTL_TEST_CHECK( utl_ringReadByte( &t_ring) ==
+                                  refRead( &gt_ref),
+                                  "step %u: drain data",
+                                  i_step);
+               }
+            }
+
+         break;/*End default:*/
+
+      }/*End switch( utl_testRand() % 7)*/
+
+      checkLevels( &t_ring, &gt_ref, i_step);
+
+      /*---------------------------------------------------------------------*
+       * Once the two disagree every later step would fail as well.
+       *---------------------------------------------------------------------*/
+      if( gi_testFailures > i_failures)
+         break;
+
+   }/*End for( i_step = 0; i_step < i_steps; i_step++)*/
+
+   UTL_TEST_CHECK( t_ring.s_wrIndex == (uint16_t)(s_startIndex +
+                   gt_ref.i_total),
+                   "size %u: write index %u after %u bytes",
+                   s_size,
+                   t_ring.s_wrIndex,
+                   gt_ref.i_total);
+
+   printf( "size %5u: %6u steps, %9u bytes, index wrapped %u times\n",
+           s_size,
+           i_step,
+           gt_ref.i_total,
+           (unsigned)(((uint32_t)s_startIndex + gt_ref.i_total) >> 16));
+
+}/*End testRandom*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   uint16_t s_size;
+
+   testInitErrors();
+
+   for( s_size = 1; s_size <= 1024; s_size <<= 1)
+   {
+      testEdges( s_size);
+      testRandom( s_size, 65535 - s_size/2, TEST_STEPS);
+   }
+
+   testEdges( TEST_MAX_RING);
+   testRandom( TEST_MAX_RING, 65000, TEST_STEPS/20);
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
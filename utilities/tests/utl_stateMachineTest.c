@@ -0,0 +1,600 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_stateMachineTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of utl_stateMachine. Every action appends to a
+ *               trace, which is compared against the order the exit, entry
+ *               and run actions must be called in. A fixed table checks the
+ *               documented cases (first entry, inherited transitions, run
+ *               action fallback, refused transitions, table validation),
+ *               then random walks over random hierarchies are checked
+ *               against a reference that works out the exit and entry
+ *               chains from each state's list of parents.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <string.h>
+#include "utl_stateMachine.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+#define TEST_MAX_TRACE  (64)
+#define TEST_RAND_STATES (16)
+#define TEST_RAND_TREES  (200)
+#define TEST_RAND_STEPS  (500)
+
+/*---------------------------------------------------------------------------*
+ * States of the fixed table.
+ *
+ *    A          B
+ *    +- A1      +- B1
+ *    +- A2
+ *       +- A2X
+ *---------------------------------------------------------------------------*/
+#define ST_A   (0)
+#define ST_A1  (1)
+#define ST_A2  (2)
+#define ST_A2X (3)
+#define ST_B   (4)
+#define ST_B1  (5)
+#define ST_NUM (6)
+
+/*---------------------------------------------------------------------------*
+ * Defines the run, entry and exit actions of state 'n', each records
+ * itself in the trace.
+ *---------------------------------------------------------------------------*/
+#define TEST_ACTIONS( n)                                                     \
+static void run##n( int32_t i_data, uint8_t c_state)                         \
+{                                                                            \
+   traceAdd( 'R', n, c_state, i_data);                                       \
+}                                                                            \
+static void entry##n( int32_t i_data, uint8_t c_state)                       \
+{                                                                            \
+   traceAdd( 'N', n, c_state, i_data);                                       \
+}                                                                            \
+static void exit##n( int32_t i_data, uint8_t c_state)                        \
+{                                                                            \
+   traceAdd( 'X', n, c_state, i_data);                                       \
+}
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+typedef struct
+{
+   char c_kind;     /*'R'un, e'N'try or e'X'it*/
+   uint8_t c_state; /*State the action belongs to*/
+   uint8_t c_arg;   /*State the action was passed*/
+   int32_t i_data;
+
+}t_traceEntry;
+
+typedef struct
+{
+   t_traceEntry at_entries[TEST_MAX_TRACE];
+   uint8_t c_length;
+
+}t_trace;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void traceAdd( char c_kind,
+                      uint8_t c_state,
+                      uint8_t c_arg,
+                      int32_t i_data);
+static void expectAdd( char c_kind,
+                       uint8_t c_state,
+                       uint8_t c_arg,
+                       int32_t i_data);
+static bool traceMatches( const char *pc_what);
+static void traceClear( void);
+static void testValidation( void);
+static void testFixedTable( void);
+static void testRandomWalks( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static t_trace gt_trace;
+static t_trace gt_expect;
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void traceAdd( char c_kind,
+                      uint8_t c_state,
+                      uint8_t c_arg,
+                      int32_t i_data)
+{
+   t_traceEntry t_entry = {c_kind, c_state, c_arg, i_data};
+
+   if( gt_trace.c_length < TEST_MAX_TRACE)
+      gt_trace.at_entries[gt_trace.c_length++] = t_entry;
+
+}/*End traceAdd*/
+
+static void expectAdd( char c_kind,
+                       uint8_t c_state,
+                       uint8_t c_arg,
+                       int32_t i_data)
+{
+   t_traceEntry t_entry = {c_kind, c_state, c_arg, i_data};
+
+   if( gt_expect.c_length < TEST_MAX_TRACE)
+      gt_expect.at_entries[gt_expect.c_length++] = t_entry;
+
+}/*End expectAdd*/
+
+static bool traceMatches( const char *pc_what)
+{
+   uint8_t c_index;
+   bool b_match = (gt_trace.c_length == gt_expect.c_length);
+
+   for( c_index = 0; b_match && (c_index < gt_trace.c_length); c_index++)
+   {
+      b_match = (gt_trace.at_entries[c_index].c_kind ==
+                gt_expect.at_entries[c_index].c_kind) &&
+                (gt_trace.at_entries[c_index].c_state ==
+                gt_expect.at_entries[c_index].c_state) &&
+                (gt_trace.at_entries[c_index].c_arg ==
+                gt_expect.at_entries[c_index].c_arg) &&
+                (gt_trace.at_entries[c_index].i_data ==
+                gt_expect.at_entries[c_index].i_data);
+   }
+
+   if( b_match == false)
+   {
+      printf( "%s\n  got:     ", pc_what);
+      for( c_index = 0; c_index < gt_trace.c_length; c_index++)
+      {
+         printf( "%c%u(%u) ",
+                 gt_trace.at_entries[c_index].c_kind,
+                 gt_trace.at_entries[c_index].c_state,
+                 gt_trace.at_entries[c_index].c_arg);
+      }
+
+      printf( "\n  expected: ");
+      for( c_index = 0; c_index < gt_expect.c_length; c_index++)
+      {
+         printf( "%c%u(%u) ",
+                 gt_expect.at_entries[c_index].c_kind,
+                 gt_expect.at_entries[c_index].c_state,
+                 gt_expect.at_entries[c_index].c_arg);
+      }
+
+      printf( "\n");
+   }
+
+   traceClear();
+
+   return b_match;
+
+}/*End traceMatches*/
+
+static void traceClear( void)
+{
+   gt_trace.c_length  = 0;
+   gt_expect.c_length = 0;
+
+}/*End traceClear*/
+
+TEST_ACTIONS( 0)
+TEST_ACTIONS( 1)
+TEST_ACTIONS( 2)
+TEST_ACTIONS( 3)
+TEST_ACTIONS( 4)
+TEST_ACTIONS( 5)
+TEST_ACTIONS( 6)
+TEST_ACTIONS( 7)
+TEST_ACTIONS( 8)
+TEST_ACTIONS( 9)
+TEST_ACTIONS( 10)
+TEST_ACTIONS( 11)
+TEST_ACTIONS( 12)
+TEST_ACTIONS( 13)
+TEST_ACTIONS( 14)
+TEST_ACTIONS( 15)
+
+static const t_stMnAction gapf_run[TEST_RAND_STATES] =
+{
+   run0, run1, run2, run3, run4, run5, run6, run7,
+   run8, run9, run10, run11, run12, run13, run14, run15
+};
+
+static const t_stMnAction gapf_entry[TEST_RAND_STATES] =
+{
+   entry0, entry1, entry2, entry3, entry4, entry5, entry6, entry7,
+   entry8, entry9, entry10, entry11, entry12, entry13, entry14, entry15
+};
+
+static const t_stMnAction gapf_exit[TEST_RAND_STATES] =
+{
+   exit0, exit1, exit2, exit3, exit4, exit5, exit6, exit7,
+   exit8, exit9, exit10, exit11, exit12, exit13, exit14, exit15
+};
+
+/*---------------------------------------------------------------------------*
+ * A1 has no run action of its own and no exit action. B1 has no
+ * transitions of its own, it can only use B's.
+ *---------------------------------------------------------------------------*/
+UTL_STMN_CREATE_TABLE( gat_fixedStates, ST_NUM) =
+{
+   [ST_A]   = UTL_STMN_STATE( &run0, &entry0, &exit0, UTL_STMN_NO_STATE,
+                              UTL_STMN_TRANS( ST_A1) |
+                              UTL_STMN_TRANS( ST_B1)),
+   [ST_A1]  = UTL_STMN_STATE( NULL, &entry1, NULL, ST_A,
+                              UTL_STMN_TRANS( ST_A2X)),
+   [ST_A2]  = UTL_STMN_STATE( &run2, &entry2, &exit2, ST_A,
+                              UTL_STMN_TRANS( ST_A2)),
+   [ST_A2X] = UTL_STMN_STATE( &run3, &entry3, &exit3, ST_A2,
+                              UTL_STMN_TRANS( ST_A2)),
+   [ST_B]   = UTL_STMN_STATE( &run4, &entry4, &exit4, UTL_STMN_NO_STATE,
+                              UTL_STMN_TRANS( ST_A)),
+   [ST_B1]  = UTL_STMN_STATE( &run5, &entry5, &exit5, ST_B, 0)
+};
+
+static void testValidation( void)
+{
+   t_stateMachine t_stMn;
+   t_stMnState at_states[UTL_STMN_MAX_DEPTH + 2];
+   uint8_t c_state;
+
+   UTL_TEST_CHECK( utl_stMnInit( NULL, gat_fixedStates, ST_NUM, ST_A) ==
+                   STMN_NULL_PTR,
+                   "NULL machine accepted");
+   UTL_TEST_CHECK( utl_stMnInit( &t_stMn, NULL, ST_NUM, ST_A) ==
+                   STMN_NULL_PTR,
+                   "NULL table accepted");
+   UTL_TEST_CHECK( utl_stMnInit( &t_stMn, gat_fixedStates, 0, 0) ==
+                   STMN_INVALID_STATE,
+                   "empty table accepted");
+   UTL_TEST_CHECK( utl_stMnInit( &t_stMn, gat_fixedStates, ST_NUM, ST_NUM) ==
+                   STMN_INVALID_STATE,
+                   "start state out of range accepted");
+
+   /*------------------------------------------------------------------------*
+    * A chain exactly UTL_STMN_MAX_DEPTH deep is fine, one more isn't.
+    *------------------------------------------------------------------------*/
+   memset( (void *)at_states, 0, sizeof( at_states));
+   at_states[0].c_parent = UTL_STMN_NO_STATE;
+   for( c_state = 1; c_state < (UTL_STMN_MAX_DEPTH + 2); c_state++)
+      at_states[c_state].c_parent = c_state - 1;
+
+   UTL_TEST_CHECK( utl_stMnInit( &t_stMn, at_states, UTL_STMN_MAX_DEPTH + 1,
+                   0) == STMN_PASSED,
+                   "nesting of depth %d refused",
+                   UTL_STMN_MAX_DEPTH);
+   UTL_TEST_CHECK( utl_stMnInit( &t_stMn, at_states, UTL_STMN_MAX_DEPTH + 2,
+                   0) == STMN_INVALID_STATE,
+                   "nesting of depth %d accepted",
+                   UTL_STMN_MAX_DEPTH + 1);
+
+   /*------------------------------------------------------------------------*
+    * A parent past the end of the table and a parent loop.
+    *------------------------------------------------------------------------*/
+   at_states[1].c_parent = UTL_STMN_MAX_DEPTH + 1;
+   UTL_TEST_CHECK( utl_stMnInit( &t_stMn, at_states, UTL_STMN_MAX_DEPTH + 1,
+                   0) == STMN_INVALID_STATE,
+                   "parent out of range accepted");
+
+   at_states[0].c_parent = 1;
+   at_states[1].c_parent = 0;
+   UTL_TEST_CHECK( utl_stMnInit( &t_stMn, at_states, 2, 0) ==
+                   STMN_INVALID_STATE,
+                   "parent loop accepted");
+
+   /*------------------------------------------------------------------------*
+    * A machine that failed validation refuses to run.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_stMnEngine( &t_stMn) == STMN_NULL_PTR,
+                   "engine ran a rejected table");
+   UTL_TEST_CHECK( utl_stMnChangeState( &t_stMn, 0, 0) == STMN_NULL_PTR,
+                   "change state on a rejected table");
+
+}/*End testValidation*/
+
+static void testFixedTable( void)
+{
+   t_stateMachine t_stMn;
+
+   traceClear();
+
+   UTL_TEST_CHECK( utl_stMnInit( &t_stMn, gat_fixedStates, ST_NUM, ST_A2X) ==
+                   STMN_PASSED,
+                   "fixed table refused");
+
+   /*------------------------------------------------------------------------*
+    * The first pass enters every level down to the start state.
+    *------------------------------------------------------------------------*/
+   utl_stMnEngine( &t_stMn);
+   expectAdd( 'N', ST_A, UTL_STMN_NO_STATE, 0);
+   expectAdd( 'N', ST_A2, UTL_STMN_NO_STATE, 0);
+   expectAdd( 'N', ST_A2X, UTL_STMN_NO_STATE, 0);
+   expectAdd( 'R', ST_A2X, UTL_STMN_NO_STATE, 0);
+   UTL_TEST_CHECK( traceMatches( "first entry"), "first entry");
+   UTL_TEST_CHECK( utl_stMnGetState( &t_stMn) == ST_A2X,
+                   "not in the start state");
+
+   /*------------------------------------------------------------------------*
+    * Staying put only runs the state, the previous state is itself.
+    *------------------------------------------------------------------------*/
+   utl_stMnEngine( &t_stMn);
+   expectAdd( 'R', ST_A2X, ST_A2X, 0);
+   UTL_TEST_CHECK( traceMatches( "no transition"), "no transition");
+
+   /*------------------------------------------------------------------------*
+    * A2X -> A1 is only allowed through A's mask. A2X and A2 are left, A
+    * stays active, and A1 falls back on A's run action.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_stMnChangeState( &t_stMn, ST_A1, 7) == STMN_PASSED,
+                   "inherited transition refused");
+   utl_stMnEngine( &t_stMn);
+   expectAdd( 'X', ST_A2X, ST_A1, 7);
+   expectAdd( 'X', ST_A2, ST_A1, 7);
+   expectAdd( 'N', ST_A1, ST_A2X, 7);
+   expectAdd( 'R', ST_A, ST_A2X, 7);
+   UTL_TEST_CHECK( traceMatches( "A2X -> A1"), "A2X -> A1");
+
+   /*------------------------------------------------------------------------*
+    * A1 -> A2 isn't in the mask of A1 or A.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_stMnChangeState( &t_stMn, ST_A2, 1) ==
+                   STMN_INVALID_TRANS,
+                   "A1 -> A2 accepted");
+   UTL_TEST_CHECK( utl_stMnChangeState( &t_stMn, ST_NUM, 1) ==
+                   STMN_INVALID_STATE,
+                   "state out of range accepted");
+   utl_stMnEngine( &t_stMn);
+   expectAdd( 'R', ST_A, ST_A1, 7);
+   UTL_TEST_CHECK( traceMatches( "refused transition"),
+                   "refused transition changed the state");
+
+   /*------------------------------------------------------------------------*
+    * Moving into a child doesn't leave the parent.
+    *------------------------------------------------------------------------*/
+   utl_stMnChangeState( &t_stMn, ST_A2X, 2);
+   utl_stMnEngine( &t_stMn);
+   expectAdd( 'N', ST_A2, ST_A1, 2);
+   expectAdd( 'N', ST_A2X, ST_A1, 2);
+   expectAdd( 'R', ST_A2X, ST_A1, 2);
+   UTL_TEST_CHECK( traceMatches( "A1 -> A2X"), "A1 -> A2X");
+
+   /*------------------------------------------------------------------------*
+    * Moving up to a parent only leaves the child, the parent isn't entered
+    * again.
+    *------------------------------------------------------------------------*/
+   utl_stMnChangeState( &t_stMn, ST_A2, 3);
+   utl_stMnEngine( &t_stMn);
+   expectAdd( 'X', ST_A2X, ST_A2, 3);
+   expectAdd( 'R', ST_A2, ST_A2X, 3);
+   UTL_TEST_CHECK( traceMatches( "A2X -> A2"), "A2X -> A2");
+
+   /*------------------------------------------------------------------------*
+    * Across the top: A2 -> B1 (through A) leaves A2 and A, enters B and B1.
+    *------------------------------------------------------------------------*/
+   utl_stMnChangeState( &t_stMn, ST_B1, 4);
+   utl_stMnEngine( &t_stMn);
+   expectAdd( 'X', ST_A2, ST_B1, 4);
+   expectAdd( 'X', ST_A, ST_B1, 4);
+   expectAdd( 'N', ST_B, ST_A2, 4);
+   expectAdd( 'N', ST_B1, ST_A2, 4);
+   expectAdd( 'R', ST_B1, ST_A2, 4);
+   UTL_TEST_CHECK( traceMatches( "A2 -> B1"), "A2 -> B1");
+
+   /*------------------------------------------------------------------------*
+    * B1 has no rules of its own, B's let it go back to A.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_CHECK( utl_stMnChangeState( &t_stMn, ST_A, 5) == STMN_PASSED,
+                   "B1 -> A refused");
+   UTL_TEST_CHECK( utl_stMnChangeState( &t_stMn, ST_A1, 5) ==
+                   STMN_INVALID_TRANS,
+                   "B1 -> A1 accepted");
+
+   traceClear();
+
+}/*End testFixedTable*/
+
+static void testRandomWalks( void)
+{
+   t_stMnState at_states[TEST_RAND_STATES];
+   uint8_t ac_fromPath[UTL_STMN_MAX_DEPTH + 1];
+   uint8_t ac_toPath[UTL_STMN_MAX_DEPTH + 1];
+   uint8_t ac_depth[TEST_RAND_STATES];
+   t_stateMachine t_stMn;
+   uint8_t c_numStates;
+   uint8_t c_state;
+   uint8_t c_curr;
+   uint8_t c_next;
+   uint8_t c_fromLen;
+   uint8_t c_toLen;
+   uint8_t c_common;
+   uint8_t c_index;
+   uint16_t s_tree;
+   uint16_t s_step;
+   uint32_t i_allowed;
+   int32_t i_data;
+   t_stmnError t_err;
+   bool b_ok = true;
+
+   for( s_tree = 0; (s_tree < TEST_RAND_TREES) && b_ok; s_tree++)
+   {
+      /*---------------------------------------------------------------------*
+       * Each state's parent is an earlier state or none, so the table is
+       * always a forest, kept within the nesting limit.
+       *---------------------------------------------------------------------*/
+      c_numStates = 2 + (uint8_t)(utl_testRand() % (TEST_RAND_STATES - 1));
+      for( c_state = 0; c_state < c_numStates; c_state++)
+      {
+         at_states[c_state].c_parent = UTL_STMN_NO_STATE;
+         ac_depth[c_state] = 0;
+         if( (c_state > 0) && (utl_testRand() % 3))
+         {
+            c_next = (uint8_t)(utl_testRand() % c_state);
+            if( ac_depth[c_next] < UTL_STMN_MAX_DEPTH)
+            {
+               at_states[c_state].c_parent = c_next;
+               ac_depth[c_state] = ac_depth[c_next] + 1;
+            }
+         }
+
+         at_states[c_state].pf_run   = (utl_testRand() % 4) ?
+                                       gapf_run[c_state] : NULL;
+         at_states[c_state].pf_entry = (utl_testRand() % 4) ?
+                                       gapf_entry[c_state] : NULL;
+         at_states[c_state].pf_exit  = (utl_testRand() % 4) ?
+                                       gapf_exit[c_state] : NULL;
+         at_states[c_state].i_transMask = utl_testRand() & utl_testRand();
+      }
+
+      c_curr = UTL_STMN_NO_STATE;
+      c_next = (uint8_t)(utl_testRand() % c_numStates);
+      utl_stMnInit( &t_stMn, at_states, c_numStates, c_next);
+      traceClear();
+      i_data = 0;
+
+      for( s_step = 0; (s_step < TEST_RAND_STEPS) && b_ok; s_step++)
+      {
+         /*------------------------------------------------------------------*
+          * The reference: the states from each end up to the top, what is
+          * in both stays active.
+          *------------------------------------------------------------------*/
+         c_fromLen = 0;
+         for( c_state = c_curr; c_state != UTL_STMN_NO_STATE; c_state =
+         at_states[c_state].c_parent)
+         {
+            ac_fromPath[c_fromLen++] = c_state;
+         }
+
+         c_toLen = 0;
+         for( c_state = c_next; c_state != UTL_STMN_NO_STATE; c_state =
+         at_states[c_state].c_parent)
+         {
+            ac_toPath[c_toLen++] = c_state;
+         }
+
+         c_common = 0;
+         while( (c_common < c_fromLen) && (c_common < c_toLen) &&
+                (ac_fromPath[c_fromLen - 1 - c_common] ==
+                ac_toPath[c_toLen - 1 - c_common]))
+         {
+            c_common++;
+         }
+
+         if( c_next != c_curr)
+         {
+            for( c_index = 0; c_index < (c_fromLen - c_common); c_index++)
+            {
+               c_state = ac_fromPath[c_index];
+               if( at_states[c_state].pf_exit != NULL)
+                  expectAdd( 'X', c_state, c_next, i_data);
+            }
+
+            for( c_index = c_toLen - c_common; c_index > 0; c_index--)
+            {
+               c_state = ac_toPath[c_index - 1];
+               if( at_states[c_state].pf_entry != NULL)
+                  expectAdd( 'N', c_state, c_curr, i_data);
+            }
+         }
+
+         for( c_index = 0; c_index < c_toLen; c_index++)
+         {
+            c_state = ac_toPath[c_index];
+            if( at_states[c_state].pf_run != NULL)
+            {
+               expectAdd( 'R', c_state, c_curr, i_data);
+               break;
+            }
+         }
+
+         utl_stMnEngine( &t_stMn);
+         b_ok = traceMatches( "random walk");
+         UTL_TEST_CHECK( b_ok,
+                         "tree %u step %u: %u -> %u",
+                         s_tree,
+                         s_step,
+                         c_curr,
+                         c_next);
+
+         c_curr = c_next;
+
+         /*------------------------------------------------------------------*
+          * Request a random state, it is allowed if any state from here to
+          * the top has it in its mask.
+          *------------------------------------------------------------------*/
+         c_next = (uint8_t)(utl_testRand() % c_numStates);
+         i_allowed = 0;
+         for( c_state = c_curr; c_state != UTL_STMN_NO_STATE; c_state =
+         at_states[c_state].c_parent)
+         {
+            i_allowed |= at_states[c_state].i_transMask;
+         }
+
+         t_err = utl_stMnChangeState( &t_stMn, c_next, s_step);
+         if( i_allowed & UTL_STMN_TRANS( c_next))
+         {
+            UTL_TEST_CHECK( t_err == STMN_PASSED,
+                            "tree %u step %u: %u -> %u refused",
+                            s_tree,
+                            s_step,
+                            c_curr,
+                            c_next);
+            i_data = s_step;
+         }
+         else
+         {
+            UTL_TEST_CHECK( t_err == STMN_INVALID_TRANS,
+                            "tree %u step %u: %u -> %u accepted",
+                            s_tree,
+                            s_step,
+                            c_curr,
+                            c_next);
+            c_next = c_curr;
+         }
+
+      }/*End for( s_step = 0; (s_step < TEST_RAND_STEPS) && b_ok; ...*/
+
+   }/*End for( s_tree = 0; (s_tree < TEST_RAND_TREES) && b_ok; ...*/
+
+   printf( "random walks: %u tables, %u steps each\n",
+           s_tree,
+           TEST_RAND_STEPS);
+
+}/*End testRandomWalks*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+   testValidation();
+   testFixedTable();
+   testRandomWalks();
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/
@@ -0,0 +1,133 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_test.h
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Checks shared by the host unit tests in this directory.
+ *               Every test is a standalone program, a failed check prints
+ *               where it failed and is counted, and 'UTL_TEST_RESULT'
+ *               turns the count into the exit status ctest looks at.
+ *               Error bound checks also print the worst error seen, so a
+ *               passing run still shows how much margin is left.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+#ifndef utl_test_h
+
+   /*------------------------------------------------------------------------*
+    * Global Defines
+    *------------------------------------------------------------------------*/
+   #define utl_test_h
+
+   /*------------------------------------------------------------------------*
+    * Counts a failure and reports it if 'b' is false, the remaining
+    * arguments are a printf style description.
+    *------------------------------------------------------------------------*/
+   #define UTL_TEST_CHECK( b, ...)                                           \
+   do                                                                        \
+   {                                                                         \
+      if( !(b))                                                              \
+      {                                                                      \
+         gi_testFailures++;                                                  \
+         printf( "%s:%d: check failed: ", __FILE__, __LINE__);               \
+         printf( __VA_ARGS__);                                               \
+         printf( "\n");                                                      \
+      }                                                                      \
+   }while( 0)
+
+   /*------------------------------------------------------------------------*
+    * Reports the worst error 'd_err' of the named check and counts a
+    * failure if it is above 'd_bound'.
+    *------------------------------------------------------------------------*/
+   #define UTL_TEST_BOUND( pc_name, d_err, d_bound)                          \
+   do                                                                        \
+   {                                                                         \
+      printf( "%-28s max err %12.6g (bound %g)%s\n",                         \
+              (pc_name),                                                     \
+              (double)(d_err),                                               \
+              (double)(d_bound),                                             \
+              ((d_err) <= (d_bound)) ? "" : "  FAILED");                     \
+      if( !((d_err) <= (d_bound)))                                           \
+         gi_testFailures++;                                                  \
+   }while( 0)
+
+   /*------------------------------------------------------------------------*
+    * Exit status of the test, 0 when every check passed.
+    *------------------------------------------------------------------------*/
+   #define UTL_TEST_RESULT()                                                 \
+   ((gi_testFailures == 0) ? (printf( "PASSED\n"), 0) :                      \
+   (printf( "%d check(s) FAILED\n", gi_testFailures), 1))
+
+   /*------------------------------------------------------------------------*
+    * Include Files
+    *------------------------------------------------------------------------*/
+   #include <stdio.h>
+   #include <stdint.h>
+   #include <math.h>
+
+   /*------------------------------------------------------------------------*
+    * Global Variables
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * Each test is a single file, so the count can live in the header.
+    *------------------------------------------------------------------------*/
+   static int gi_testFailures = 0;
+
+   static uint32_t gi_testSeed = 0x12345678;
+
+   /*------------------------------------------------------------------------*
+    * Global Inline functions
+    *------------------------------------------------------------------------*/
+
+   /*------------------------------------------------------------------------*
+    * xorshift32, the tests use their own generator so a failure reproduces
+    * the same way on every host.
+    *------------------------------------------------------------------------*/
+   static inline uint32_t __attribute__((always_inline)) \
+   utl_testRand( void)
+   {
+      gi_testSeed ^= gi_testSeed << 13;
+      gi_testSeed ^= gi_testSeed >> 17;
+      gi_testSeed ^= gi_testSeed << 5;
+
+      return gi_testSeed;
+
+   }/*End utl_testRand*/
+
+   /*------------------------------------------------------------------------*
+    * Uniform in [d_min, d_max).
+    *------------------------------------------------------------------------*/
+   static inline double __attribute__((always_inline)) \
+   utl_testRandD( double d_min,
+                  double d_max)
+   {
+      return d_min + (d_max - d_min)*((double)utl_testRand() / 4294967296.0);
+   }/*End utl_testRandD*/
+
+   /*------------------------------------------------------------------------*
+    * Uniform over the whole int16_t range.
+    *------------------------------------------------------------------------*/
+   static inline int16_t __attribute__((always_inline)) \
+   utl_testRand16( void)
+   {
+      return (int16_t)(utl_testRand() >> 16);
+   }/*End utl_testRand16*/
+
+#endif/*End #ifndef utl_test_h*/
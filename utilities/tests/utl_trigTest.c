@@ -0,0 +1,303 @@
+/*---------------------------------------------------------------------------*
+ * Copyright (C) 2011-2013 Ryan M. Murphy <ryan.m.murphy.77@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File Name   : utl_trigTest.c
+ *
+ * Project     : Arbitros
+ *               <https://code.google.com/p/arbitros/>
+ *
+ * Description : Host test of the table based sin, cos and atan2 functions.
+ *               The fused and array versions share their lookups with the
+ *               scalar functions and have to give the same bits for every
+ *               input. The scalar results are then checked against libm.
+ *               The cos table has 16 steps over 2*pi, so linear
+ *               interpolation alone can be out by h^2/8 of full scale.
+ *               atan2 divides by |den| + 1, which moves the ratio by up to
+ *               1/(|den| + 1) radians on top of its own table error.
+ *
+ * Last Update : Oct 18, 2013
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Include Files
+ *---------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "utl_math.h"
+#include "utl_test.h"
+
+/*---------------------------------------------------------------------------*
+ * Private Defines
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Odd so the array calls end part way through the phase range, one extra
+ * entry holds a sentinel.
+ *---------------------------------------------------------------------------*/
+#define TEST_BLOCK        (251)
+#define TEST_SENTINEL     (0x5A5A)
+#define TEST_ATAN2_TRIALS (200000)
+
+/*---------------------------------------------------------------------------*
+ * Table interpolation and rounding error of atan2 in LSBs, not counting the
+ * 1/(|den| + 1) bias.
+ *---------------------------------------------------------------------------*/
+#define TEST_ATAN2_TBL_ERR (8.0)
+
+/*---------------------------------------------------------------------------*
+ * Private Datatypes
+ *---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*
+ * Private Function Prototypes
+ *---------------------------------------------------------------------------*/
+static void testSinCos( void);
+static void testAtan2Pair( int16_t s_y,
+                           int16_t s_x,
+                           double *pd_worst);
+static void testAtan2( void);
+
+/*---------------------------------------------------------------------------*
+ * Private Global Variables
+ *---------------------------------------------------------------------------*/
+static uint16_t gas_phase[TEST_BLOCK];
+static int16_t gas_sin[TEST_BLOCK + 1];
+static int16_t gas_cos[TEST_BLOCK + 1];
+static int16_t gas_vSin[TEST_BLOCK + 1];
+static int16_t gas_vCos[TEST_BLOCK + 1];
+static int16_t gas_y[TEST_BLOCK];
+static int16_t gas_x[TEST_BLOCK];
+static int16_t gas_angle[TEST_BLOCK + 1];
+
+/*---------------------------------------------------------------------------*
+ * Private Function Definitions
+ *---------------------------------------------------------------------------*/
+static void testSinCos( void)
+{
+   int32_t i_phase;
+   int32_t i_start;
+   int16_t s_length;
+   int16_t s_index;
+   int16_t s_sin;
+   int16_t s_cos;
+   double d_angle;
+   double d_err;
+   double d_worstSin = 0.0;
+   double d_worstCos = 0.0;
+   double d_step     = 2.0*M_PI / 16.0;
+   int32_t i_mismatch = 0;
+
+   /*------------------------------------------------------------------------*
+    * Every phase, in blocks through the array functions.
+    *------------------------------------------------------------------------*/
+   for( i_start = 0; i_start < UTL_MATH_FXDPNT_TWO_PI_WRAP; i_start +=
+   TEST_BLOCK)
+   {
+      s_length = TEST_BLOCK;
+      if( (i_start + s_length) > UTL_MATH_FXDPNT_TWO_PI_WRAP)
+         s_length = (int16_t)(UTL_MATH_FXDPNT_TWO_PI_WRAP - i_start);
+
+      for( s_index = 0; s_index < s_length; s_index++)
+         gas_phase[s_index] = (uint16_t)(i_start + s_index);
+
+      gas_sin[s_length]  = TEST_SENTINEL;
+      gas_cos[s_length]  = TEST_SENTINEL;
+      gas_vSin[s_length] = TEST_SENTINEL;
+      gas_vCos[s_length] = TEST_SENTINEL;
+
+      utl_vSincos16_16( gas_phase, gas_sin, gas_cos, s_length);
+      utl_vSin16_16( gas_phase, gas_vSin, s_length);
+      utl_vCos16_16( gas_phase, gas_vCos, s_length);
+
+      UTL_TEST_CHECK( (gas_sin[s_length] == TEST_SENTINEL) &&
+                      (gas_cos[s_length] == TEST_SENTINEL) &&
+                      (gas_vSin[s_length] == TEST_SENTINEL) &&
+                      (gas_vCos[s_length] == TEST_SENTINEL),
+                      "array write past %d elements at phase %d",
+                      s_length,
+                      i_start);
+
+      for( s_index = 0; s_index < s_length; s_index++)
+      {
+         i_phase = i_start + s_index;
+         utl_sincos16_16( (uint16_t)i_phase, &s_sin, &s_cos);
+
+         if( (s_sin != utl_sin16_16( (uint16_t)i_phase)) ||
+             (s_cos != utl_cos16_16( (uint16_t)i_phase)) ||
+             (gas_sin[s_index] != s_sin) ||
+             (gas_cos[s_index] != s_cos) ||
+             (gas_vSin[s_index] != s_sin) ||
+             (gas_vCos[s_index] != s_cos))
+         {
+            if( i_mismatch == 0)
+            {
+               UTL_TEST_CHECK( false,
+                               "phase %d sin %d/%d/%d/%d cos %d/%d/%d/%d",
+                               i_phase,
+                               utl_sin16_16( (uint16_t)i_phase),
+                               s_sin,
+                               gas_sin[s_index],
+                               gas_vSin[s_index],
+                               utl_cos16_16( (uint16_t)i_phase),
+                               s_cos,
+                               gas_cos[s_index],
+                               gas_vCos[s_index]);
+            }
+            i_mismatch++;
+         }
+
+         d_angle = (double)i_phase*2.0*M_PI /
+         (double)UTL_MATH_FXDPNT_TWO_PI_WRAP;
+
+         d_err = fabs( (double)s_sin - sin( d_angle)*32768.0);
+         if( d_err > d_worstSin)
+            d_worstSin = d_err;
+
+         d_err = fabs( (double)s_cos - cos( d_angle)*32768.0);
+         if( d_err > d_worstCos)
+            d_worstCos = d_err;
+      }
+   }
+
+   UTL_TEST_CHECK( i_mismatch == 0,
+                   "%d phases differ between the sin/cos versions",
+                   i_mismatch);
+
+   /*------------------------------------------------------------------------*
+    * Interpolation error of a unit amplitude cosine plus two LSBs for the
+    * stored table entries and the interpolation shift.
+    *------------------------------------------------------------------------*/
+   UTL_TEST_BOUND( "utl_sin16_16 (LSB)",
+                   d_worstSin,
+                   d_step*d_step / 8.0*32768.0 + 2.0);
+   UTL_TEST_BOUND( "utl_cos16_16 (LSB)",
+                   d_worstCos,
+                   d_step*d_step / 8.0*32768.0 + 2.0);
+
+}/*End testSinCos*/
+
+static void testAtan2Pair( int16_t s_y,
+                           int16_t s_x,
+                           double *pd_worst)
+{
+   int32_t i_den;
+   double d_err;
+
+   /*------------------------------------------------------------------------*
+    * The angle wraps at +/-pi, an answer of pi for -pi is right.
+    *------------------------------------------------------------------------*/
+   d_err = (double)utl_atan2_16( s_y, s_x) - atan2( (double)s_y,
+   (double)s_x)*(double)UTL_MATH_FXDPNT_PI / M_PI;
+   d_err = fabs( remainder( d_err, 2.0*(double)UTL_MATH_FXDPNT_PI));
+
+   i_den = abs( (int32_t)s_x);
+   if( abs( (int32_t)s_y) > i_den)
+      i_den = abs( (int32_t)s_y);
+
+   d_err = d_err - (double)UTL_MATH_FXDPNT_PI / M_PI / (double)(i_den + 1);
+
+   if( d_err > *pd_worst)
+      *pd_worst = d_err;
+
+}/*End testAtan2Pair*/
+
+static void testAtan2( void)
+{
+   int32_t i_trial;
+   int32_t i_y;
+   int32_t i_x;
+   int16_t s_index;
+   int16_t s_shift;
+   double d_worst = 0.0;
+   int32_t i_mismatch = 0;
+
+   /*------------------------------------------------------------------------*
+    * A grid through the edges of every octant.
+    *------------------------------------------------------------------------*/
+   for( i_y = -32768; i_y <= 32767; i_y += 257)
+   {
+      for( i_x = -32768; i_x <= 32767; i_x += 263)
+      {
+         testAtan2Pair( (int16_t)i_y, (int16_t)i_x, &d_worst);
+         testAtan2Pair( (int16_t)i_y, (int16_t)i_y, &d_worst);
+         testAtan2Pair( (int16_t)i_y, 0, &d_worst);
+         testAtan2Pair( 0, (int16_t)i_x, &d_worst);
+      }
+   }
+
+   /*------------------------------------------------------------------------*
+    * Random pairs over every magnitude, also through utl_vAtan2_16.
+    *------------------------------------------------------------------------*/
+   for( i_trial = 0; i_trial < TEST_ATAN2_TRIALS; i_trial += TEST_BLOCK)
+   {
+      for( s_index = 0; s_index < TEST_BLOCK; s_index++)
+      {
+         s_shift = (int16_t)(utl_testRand() & 15);
+         gas_y[s_index] = (int16_t)(utl_testRand16() >> s_shift);
+         gas_x[s_index] = (int16_t)(utl_testRand16() >> s_shift);
+         if( (gas_y[s_index] == 0) && (gas_x[s_index] == 0))
+            gas_x[s_index] = 1;
+      }
+
+      gas_angle[TEST_BLOCK] = TEST_SENTINEL;
+      utl_vAtan2_16( gas_y, gas_x, gas_angle, TEST_BLOCK);
+      UTL_TEST_CHECK( gas_angle[TEST_BLOCK] == TEST_SENTINEL,
+                      "utl_vAtan2_16 wrote past %d elements",
+                      TEST_BLOCK);
+
+      for( s_index = 0; s_index < TEST_BLOCK; s_index++)
+      {
+         if( gas_angle[s_index] != utl_atan2_16( gas_y[s_index],
+             gas_x[s_index]))
+         {
+            if( i_mismatch == 0)
+            {
+               UTL_TEST_CHECK( false,
+                               "atan2(%d, %d) array %d scalar %d",
+                               gas_y[s_index],
+                               gas_x[s_index],
+                               gas_angle[s_index],
+                               utl_atan2_16( gas_y[s_index],
+                               gas_x[s_index]));
+            }
+            i_mismatch++;
+         }
+
+         testAtan2Pair( gas_y[s_index], gas_x[s_index], &d_worst);
+      }
+   }
+
+   UTL_TEST_CHECK( i_mismatch == 0,
+                   "%d pairs differ between utl_vAtan2_16 and utl_atan2_16",
+                   i_mismatch);
+
+   UTL_TEST_BOUND( "utl_atan2_16 (LSB past bias)",
+                   d_worst,
+                   TEST_ATAN2_TBL_ERR);
+
+}/*End testAtan2*/
+
+/*---------------------------------------------------------------------------*
+ * Public Function Definitions
+ *---------------------------------------------------------------------------*/
+int main( void)
+{
+
+   testSinCos();
+   testAtan2();
+
+   return UTL_TEST_RESULT();
+
+}/*End main*/